@@ -14,12 +14,17 @@
  */
 
 #include <iterator>
+#include <memory>
 #include <vector>
 
 #include <boost/dynamic_bitset.hpp>
 
 #include "tchecker/algorithms/covreach/stats.hh"
+#include "tchecker/algorithms/progress.hh"
 #include "tchecker/graph/subsumption_graph.hh"
+#include "tchecker/ta/independence.hh"
+#include "tchecker/ta/symmetry.hh"
+#include "tchecker/utils/counters.hh"
 #include "tchecker/waiting/factory.hh"
 
 namespace tchecker {
@@ -42,6 +47,36 @@ namespace covreach {
 */
 template <class TS, class GRAPH> class algorithm_t {
 public:
+  /*!
+   \brief Constructor
+   \post this algorithm explores all the transitions of the transition system
+   */
+  algorithm_t() : _independence(nullptr), _symmetry(nullptr), _progress(nullptr) {}
+
+  /*!
+   \brief Constructor
+   \param independence : static independence relation over the edges of the
+   system, nullptr to disable partial-order reduction
+   \param symmetry : symmetry classes of the system, nullptr to disable symmetry
+   reduction
+   \post this algorithm only explores the transitions in an ample set from the
+   nodes where independence yields one (see expand_next_nodes), and it
+   canonicalises every state w.r.t. symmetry before inserting it in the graph
+   (see canonicalize)
+   */
+  algorithm_t(std::shared_ptr<tchecker::ta::independence_t const> const & independence,
+              std::shared_ptr<tchecker::ta::symmetry_t const> const & symmetry = nullptr)
+      : _independence(independence), _symmetry(symmetry), _progress(nullptr)
+  {
+  }
+
+  /*!
+   \brief Set progress reports
+   \param progress : progress reports, nullptr to disable progress reports
+   \post run periodically reports its progress to progress
+   */
+  void set_progress(std::shared_ptr<tchecker::algorithms::progress_t> const & progress) { _progress = progress; }
+
   /*!
    \brief Build a covering reachability graph of a transition system from its
    initial states
@@ -59,6 +94,9 @@ public:
    The order in which the nodes of ts are visited depends on policy.
    \return Statistics on the run
    \note if labels is empty, the algorithm explores the entire state-space
+   \note if progress reports have been set (see set_progress), the number of
+   visited, stored and covered states, the size of the waiting container, and
+   the memory used by ts and graph are reported periodically
   */
   tchecker::algorithms::covreach::stats_t run(TS & ts, GRAPH & graph, boost::dynamic_bitset<> const & labels,
                                               enum tchecker::waiting::policy_t policy)
@@ -70,13 +108,20 @@ public:
     tchecker::algorithms::covreach::stats_t stats;
     std::vector<node_sptr_t> nodes, covered_nodes;
 
+    stats.por() = (_independence.get() != nullptr);
+    TCHECKER_COUNTERS_RESET();
     stats.set_start_time();
+    if (_progress.get() != nullptr)
+      _progress->start();
 
     expand_initial_nodes(ts, graph, nodes, stats);
 
 
-    for (node_sptr_t const & n : nodes)
+    for (node_sptr_t const & n : nodes) {
       waiting->insert(n);
+      if (_progress.get() != nullptr)
+        _progress->waiting_inserted(n.ptr(), true);
+    }
     nodes.clear();
 
     while (!waiting->empty()) {
@@ -87,6 +132,13 @@ public:
 
       ++stats.visited_states();
 
+      if (_progress.get() != nullptr) {
+        _progress->visit(node.ptr());
+        if (_progress->due())
+          _progress->report(stats.visited_states(), graph.nodes_count(), stats.covered_states(), waiting->size(),
+                            ts.memsize() + graph.memsize());
+      }
+
       if (ts.satisfies(node->state_ptr(), labels)) {
         stats.reachable() = true;
         break;
@@ -100,6 +152,8 @@ public:
 
       for (node_sptr_t const & next_node : nodes) {
         waiting->insert(next_node);
+        if (_progress.get() != nullptr)
+          _progress->waiting_inserted(next_node.ptr(), false);
         
         //we are doing forward simulation here! i.e. nodes in the graph that 
         //are covered by next_node are removed in the following three lines
@@ -108,8 +162,11 @@ public:
         //also note that we are removing nodes from the waiting set which are covered by
         //next_node
         remove_covered_nodes(graph, next_node, covered_nodes, stats);
-        for (node_sptr_t const & covered_node : covered_nodes)
+        for (node_sptr_t const & covered_node : covered_nodes) {
           waiting->remove(covered_node);
+          if (_progress.get() != nullptr)
+            _progress->waiting_removed(covered_node.ptr());
+        }
         covered_nodes.clear();
       }
       nodes.clear();
@@ -144,6 +201,7 @@ public:
 
     ts.initial(sst, tchecker::STATE_OK);
     for (auto && [status, s, t] : sst) {
+      canonicalize(s);
       typename GRAPH::node_sptr_t n = graph.add_node(s);
       if (graph.is_covered(n, covering_node)) {
         graph.remove_node(n);
@@ -167,27 +225,172 @@ public:
    For each successor node that is not maximal, a subsumption edge has been
    created from node to a covering node.
    All covered successor nodes have been counted in stats.
+   If partial-order reduction is enabled and node has an ample set with a
+   maximal successor, only the transitions in the ample set are explored (see
+   expand_ample_nodes)
    */
   void expand_next_nodes(typename GRAPH::node_sptr_t const & node, TS & ts, GRAPH & graph,
                          std::vector<typename GRAPH::node_sptr_t> & next_nodes, tchecker::algorithms::covreach::stats_t & stats)
   {
+    if (_independence.get() != nullptr && expand_ample_nodes(node, ts, graph, next_nodes, stats))
+      return;
+
     std::vector<typename TS::sst_t> sst;
-    typename GRAPH::node_sptr_t covering_node;
 
     ts.next(node->state_ptr(), sst, tchecker::STATE_OK);
-    for (auto && [status, s, t] : sst) {
-      typename GRAPH::node_sptr_t next_node = graph.add_node(s);
+    for (typename TS::sst_t & next_sst : sst)
+      add_next_node(node, next_sst, graph, next_nodes, stats);
+  }
 
+  /*!
+   \brief Create a successor node of a node
+   \param node : a node
+   \param next_sst : a successor (status, state, transition) of node
+   \param graph : a subsumption graph
+   \param next_nodes : nodes container
+   \param stats : statistics
+   \post A node has been created in graph for the state in next_sst, and an
+   actual edge from node to this node has been added to graph and the node has
+   been added to next_nodes if it is maximal. Otherwise, a subsumption edge has
+   been created from node to a covering node, and the covered node has been
+   counted in stats
+   */
+  void add_next_node(typename GRAPH::node_sptr_t const & node, typename TS::sst_t & next_sst, GRAPH & graph,
+                     std::vector<typename GRAPH::node_sptr_t> & next_nodes, tchecker::algorithms::covreach::stats_t & stats)
+  {
+    auto && [status, s, t] = next_sst;
+    typename GRAPH::node_sptr_t covering_node;
+
+    canonicalize(s);
+    typename GRAPH::node_sptr_t next_node = graph.add_node(s);
+
+    if (graph.is_covered(next_node, covering_node)) {
+      graph.add_edge(node, covering_node, tchecker::graph::subsumption::EDGE_SUBSUMPTION, *t);
+      graph.remove_node(next_node);
+      ++stats.covered_states();
+    }
+    else {
+      graph.add_edge(node, next_node, tchecker::graph::subsumption::EDGE_ACTUAL, *t);
+      next_nodes.push_back(next_node);
+    }
+  }
+
+  /*!
+   \brief Create successor nodes of a node along an ample set
+   \param node : a node
+   \param ts : a transition system
+   \param graph : a subsumption graph
+   \param next_nodes : nodes container
+   \param stats : statistics
+   \pre partial-order reduction is enabled
+   \post if the tuple of locations in node has an ample process (see
+   tchecker::ta::independence_t::ample_process) that does not own all the
+   outgoing edges of node, then node has been expanded: if at least one
+   successor of node along the outgoing edges of this process is maximal in
+   graph, then nodes and edges have been created as in expand_next_nodes for
+   the successors along the outgoing edges of the ample process only. Otherwise,
+   nodes and edges have been created as in expand_next_nodes for all the
+   successors of node, and the successors along the edges of the ample process
+   have not been computed twice. If node has no such ample process, graph is
+   unchanged.
+   \return true if node has been expanded, false otherwise
+   \note requiring a maximal successor is the cycle proviso: it guarantees that
+   no transition is ignored forever along a cycle of covered nodes
+   */
+  bool expand_ample_nodes(typename GRAPH::node_sptr_t const & node, TS & ts, GRAPH & graph,
+                          std::vector<typename GRAPH::node_sptr_t> & next_nodes, tchecker::algorithms::covreach::stats_t & stats)
+  {
+    tchecker::process_id_t pid = _independence->ample_process(node->state().vloc());
+    if (pid == tchecker::ta::independence_t::NO_PROCESS)
+      return false;
+
+    // ample edges are asynchronous, hence the only edge in their vedge
+    auto is_ample = [pid](auto && out_edge) {
+      auto edge_it = out_edge.begin();
+      return (*edge_it)->pid() == pid;
+    };
+
+    auto out_edges = ts.outgoing_edges(node->state_ptr());
+    unsigned long pruned = 0;
+    for (auto && out_edge : out_edges)
+      if (!is_ample(out_edge))
+        ++pruned;
+
+    if (pruned == 0)
+      return false;
+
+    // successors along ample edges, and their number for each ample edge
+    std::vector<typename TS::sst_t> sst, ample_sst;
+    std::vector<std::size_t> ample_count;
+
+    for (auto && out_edge : out_edges) {
+      if (!is_ample(out_edge))
+        continue;
+      ts.next(node->state_ptr(), out_edge, sst);
+      std::size_t const count = ample_sst.size();
+      for (auto && [status, s, t] : sst)
+        if (status == tchecker::STATE_OK)
+          ample_sst.push_back(std::make_tuple(status, s, t));
+      ample_count.push_back(ample_sst.size() - count);
+      sst.clear();
+    }
+
+    std::vector<typename GRAPH::node_sptr_t> ample_nodes;
+    std::vector<bool> covered;
+    typename GRAPH::node_sptr_t covering_node;
+    bool maximal = false;
+
+    for (auto && [status, s, t] : ample_sst) {
+      canonicalize(s);
+      typename GRAPH::node_sptr_t next_node = graph.add_node(s);
       if (graph.is_covered(next_node, covering_node)) {
-        graph.add_edge(node, covering_node, tchecker::graph::subsumption::EDGE_SUBSUMPTION, *t);
         graph.remove_node(next_node);
-        ++stats.covered_states();
+        ample_nodes.push_back(covering_node);
+        covered.push_back(true);
       }
       else {
-        graph.add_edge(node, next_node, tchecker::graph::subsumption::EDGE_ACTUAL, *t);
-        next_nodes.push_back(next_node);
+        ample_nodes.push_back(next_node);
+        covered.push_back(false);
+        maximal = true;
+      }
+    }
+
+    if (maximal) {
+      for (std::size_t i = 0; i < ample_sst.size(); ++i) {
+        if (covered[i]) {
+          graph.add_edge(node, ample_nodes[i], tchecker::graph::subsumption::EDGE_SUBSUMPTION, *std::get<2>(ample_sst[i]));
+          ++stats.covered_states();
+        }
+        else {
+          graph.add_edge(node, ample_nodes[i], tchecker::graph::subsumption::EDGE_ACTUAL, *std::get<2>(ample_sst[i]));
+          next_nodes.push_back(ample_nodes[i]);
+        }
       }
+
+      ++stats.ample_states();
+      stats.pruned_transitions() += pruned;
+      return true;
     }
+
+    // cycle proviso: full expansion, in the order of the outgoing edges. All the
+    // successors along ample edges are covered, and they are not recomputed
+    std::size_t i = 0, e = 0;
+    for (auto && out_edge : out_edges) {
+      if (is_ample(out_edge)) {
+        for (std::size_t k = 0; k < ample_count[e]; ++k, ++i) {
+          graph.add_edge(node, ample_nodes[i], tchecker::graph::subsumption::EDGE_SUBSUMPTION, *std::get<2>(ample_sst[i]));
+          ++stats.covered_states();
+        }
+        ++e;
+        continue;
+      }
+      ts.next(node->state_ptr(), out_edge, sst);
+      for (typename TS::sst_t & next_sst : sst)
+        if (std::get<0>(next_sst) == tchecker::STATE_OK)
+          add_next_node(node, next_sst, graph, next_nodes, stats);
+      sst.clear();
+    }
+    return true;
   }
 
   /*!
@@ -217,6 +420,26 @@ public:
       ++stats.covered_states();
     }
   }
+
+  /*!
+   \brief Canonicalise a state w.r.t. symmetry
+   \param s : a state
+   \post if symmetry reduction is enabled, the processes of each symmetry class
+   have been sorted in s (see tchecker::ta::symmetry_t::canonicalize), s is
+   unchanged otherwise
+   \note the transition that yields s is not modified, hence it may refer to
+   processes that have been permuted in s
+   */
+  void canonicalize(typename TS::state_t const & s)
+  {
+    if (_symmetry.get() != nullptr)
+      _symmetry->canonicalize(*s->vloc_ptr(), s->zone_ptr()->dbm(), s->zone().dim());
+  }
+
+private:
+  std::shared_ptr<tchecker::ta::independence_t const> _independence; /*!< Independence relation (nullptr: no reduction) */
+  std::shared_ptr<tchecker::ta::symmetry_t const> _symmetry;         /*!< Symmetry classes (nullptr: no reduction) */
+  std::shared_ptr<tchecker::algorithms::progress_t> _progress;       /*!< Progress reports (nullptr: no report) */
 };
 
 } // end of namespace covreach
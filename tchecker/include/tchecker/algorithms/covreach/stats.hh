@@ -83,18 +83,59 @@ public:
   */
   bool reachable() const;
 
+  /*!
+   \brief Accessor
+   \return A reference to the partial-order reduction flag
+  */
+  bool & por();
+
+  /*!
+   \brief Accessor
+   \return true if partial-order reduction is enabled, false otherwise
+  */
+  bool por() const;
+
+  /*!
+   \brief Accessor
+   \return A reference to the number of states expanded with an ample set
+  */
+  unsigned long & ample_states();
+
+  /*!
+   \brief Accessor
+   \return the number of states expanded with an ample set
+  */
+  unsigned long ample_states() const;
+
+  /*!
+   \brief Accessor
+   \return A reference to the number of transitions pruned by partial-order reduction
+  */
+  unsigned long & pruned_transitions();
+
+  /*!
+   \brief Accessor
+   \return the number of transitions pruned by partial-order reduction
+  */
+  unsigned long pruned_transitions() const;
+
   /*!
    \brief Extract statistics as attributes (key, value)
    \param m : attributes map
-   \post every statistics has been added to m
+   \post every statistics has been added to m. Partial-order reduction statistics
+   are only added when partial-order reduction is enabled. The counters of the
+   last run (see tchecker/utils/counters.hh) are added when counters are enabled
   */
   void attributes(std::map<std::string, std::string> & m) const;
 
 private:
-  unsigned long _visited_states; /*!< Number of visited states */
-  unsigned long _covered_states; /*!< Number of covered states */
-  unsigned long _stored_states;  /*!< Number of stored states */
-  bool _reachable;               /*!< Reachability of satisfying state */
+  unsigned long _visited_states;     /*!< Number of visited states */
+  unsigned long _covered_states;     /*!< Number of covered states */
+  unsigned long _stored_states;      /*!< Number of stored states */
+  bool _reachable;                   /*!< Reachability of satisfying state */
+  bool _por;                         /*!< Partial-order reduction flag */
+  unsigned long _ample_states;       /*!< Number of states expanded with an ample set */
+  unsigned long _pruned_transitions; /*!< Number of transitions pruned by partial-order reduction */
 };
 
 } // end of namespace covreach
@@ -0,0 +1,130 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_ALGORITHMS_PROGRESS_HH
+#define TCHECKER_ALGORITHMS_PROGRESS_HH
+
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <unordered_map>
+
+/*!
+ \file progress.hh
+ \brief Periodic progress reports of reachability algorithms
+ */
+
+namespace tchecker {
+
+namespace algorithms {
+
+/*!
+ \class progress_t
+ \brief Periodic progress reports of reachability algorithms
+ \note Reports are output as single lines:
+ PROGRESS ELAPSED_SECONDS=... VISITED_STATES=... STORED_STATES=...
+ COVERED_STATES=... WAITING_STATES=... STATES_PER_SECOND=... MEMORY_BYTES=...
+ DEPTH=... MAX_DEPTH=...
+ where STATES_PER_SECOND is the number of visited states per second since the
+ previous report, MEMORY_BYTES is the memory used by the states, transitions,
+ nodes and edges allocated by the algorithm, and DEPTH is the depth (i.e. the
+ number of transitions from an initial state) of the last visited node
+ \note progress_t tracks the depth of waiting nodes. Its memory usage is
+ proportional to the size of the waiting container
+ */
+class progress_t {
+public:
+  /*!
+   \brief Constructor
+   \param os : output stream
+   \param period : number of seconds between two reports
+   \pre period > 0
+   \throw std::invalid_argument : if period <= 0
+   \note os must remain valid as long as this object is used
+   */
+  progress_t(std::ostream & os, double period);
+
+  /*!
+   \brief Start reporting
+   \post the time of the start of the run and of the last report have been set
+   to now, and all tracked nodes have been forgotten
+   */
+  void start();
+
+  /*!
+   \brief Record a node inserted in the waiting container
+   \param node : a node
+   \param initial : true if node is an initial node, false if it is a successor
+   of the last visited node
+   \post the depth of node has been recorded
+   */
+  void waiting_inserted(void const * node, bool initial);
+
+  /*!
+   \brief Record a node removed from the waiting container without being visited
+   \param node : a node
+   \post the depth of node has been forgotten
+   */
+  void waiting_removed(void const * node);
+
+  /*!
+   \brief Record a visited node
+   \param node : a node removed first from the waiting container
+   \post the current depth is the depth of node, and the depth of node has been
+   forgotten
+   */
+  void visit(void const * node);
+
+  /*!
+   \brief Check if a report is due
+   \return true if period seconds have elapsed since the last report, false
+   otherwise
+   \note the clock is only read once every few calls, hence this method can be
+   called for every visited node
+   */
+  inline bool due()
+  {
+    if (++_calls % CALLS_PER_CLOCK_READ != 0)
+      return false;
+    return std::chrono::steady_clock::now() >= _next_report;
+  }
+
+  /*!
+   \brief Output a report
+   \param visited : number of visited states
+   \param stored : number of stored states
+   \param covered : number of covered states
+   \param waiting : number of waiting states
+   \param memsize : memory used by the run (bytes)
+   \post a report line has been output to the output stream, and the next report
+   is due in period seconds
+   */
+  void report(unsigned long visited, unsigned long stored, unsigned long covered, std::size_t waiting, std::size_t memsize);
+
+private:
+  /*!
+   \brief Number of calls to due() between two reads of the clock
+   */
+  static unsigned long const CALLS_PER_CLOCK_READ = 256;
+
+  std::ostream & _os;                                               /*!< Output stream */
+  std::chrono::duration<double> const _period;                      /*!< Time between two reports */
+  std::chrono::time_point<std::chrono::steady_clock> _start_time;   /*!< Start time of the run */
+  std::chrono::time_point<std::chrono::steady_clock> _last_report;  /*!< Time of the last report */
+  std::chrono::time_point<std::chrono::steady_clock> _next_report;  /*!< Time of the next report */
+  unsigned long _calls;                                             /*!< Number of calls to due() */
+  unsigned long _last_visited;                                      /*!< Number of visited states at last report */
+  std::unordered_map<void const *, unsigned long> _waiting_depth;   /*!< Depth of waiting nodes */
+  unsigned long _depth;                                             /*!< Depth of the last visited node */
+  unsigned long _max_depth;                                         /*!< Maximal depth of visited nodes */
+};
+
+} // end of namespace algorithms
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_ALGORITHMS_PROGRESS_HH
@@ -12,6 +12,7 @@
 
 #include <boost/dynamic_bitset.hpp>
 
+#include "tchecker/algorithms/progress.hh"
 #include "tchecker/algorithms/reach/stats.hh"
 #include "tchecker/basictypes.hh"
 #include "tchecker/waiting/factory.hh"
@@ -38,6 +39,13 @@ namespace reach {
  */
 template <class TS, class GRAPH> class algorithm_t {
 public:
+  /*!
+   \brief Set progress reports
+   \param progress : progress reports, nullptr to disable progress reports
+   \post run periodically reports its progress to progress
+   */
+  void set_progress(std::shared_ptr<tchecker::algorithms::progress_t> const & progress) { _progress = progress; }
+
   /*!
    \brief Build a reachability graph of a transition system from its initial
    states
@@ -52,6 +60,9 @@ public:
    on policy.
    \return statistics on the run
    \note if labels is empty, graph is the full reachability graph of ts
+   \note if progress reports have been set (see set_progress), the number of
+   visited and stored states, the size of the waiting container, and the memory
+   used by ts and graph are reported periodically
    */
   tchecker::algorithms::reach::stats_t run(TS & ts, GRAPH & graph, boost::dynamic_bitset<> const & labels,
                                            enum tchecker::waiting::policy_t policy)
@@ -63,13 +74,18 @@ public:
     tchecker::algorithms::reach::stats_t stats;
 
     stats.set_start_time();
+    if (_progress.get() != nullptr)
+      _progress->start();
 
     std::vector<typename TS::sst_t> sst;
     ts.initial(sst, tchecker::STATE_OK);
     for (auto && [status, s, t] : sst) {
       auto && [is_new_node, initial_node] = graph.add_node(s);
-      if (is_new_node)
+      if (is_new_node) {
         waiting->insert(initial_node);
+        if (_progress.get() != nullptr)
+          _progress->waiting_inserted(initial_node.ptr(), true);
+      }
     }
 
     run_from_waiting(ts, graph, labels, *waiting, stats);
@@ -101,6 +117,8 @@ public:
     tchecker::algorithms::reach::stats_t stats;
 
     stats.set_start_time();
+    if (_progress.get() != nullptr)
+      _progress->start();
     run_from_waiting(ts, graph, labels, waiting, stats);
     stats.set_end_time();
 
@@ -123,6 +141,7 @@ private:
   visited depends on the policy implemented by waiting.
   The number of visited nodes and reachability of a satisfying node have been
   set in stats.
+  \note the nodes in waiting are counted as stored nodes in progress reports
   */
   void run_from_waiting(TS & ts, GRAPH & graph, boost::dynamic_bitset<> const & labels,
                         tchecker::waiting::waiting_t<typename GRAPH::node_sptr_t> & waiting,
@@ -131,6 +150,7 @@ private:
     using node_sptr_t = typename GRAPH::node_sptr_t;
 
     std::vector<typename TS::sst_t> sst;
+    unsigned long stored_states = waiting.size();
 
     while (!waiting.empty()) {
       node_sptr_t node = waiting.first();
@@ -138,6 +158,12 @@ private:
 
       ++stats.visited_states();
 
+      if (_progress.get() != nullptr) {
+        _progress->visit(node.ptr());
+        if (_progress->due())
+          _progress->report(stats.visited_states(), stored_states, 0, waiting.size(), ts.memsize() + graph.memsize());
+      }
+
       if (ts.satisfies(node->state_ptr(), labels)) {
         stats.reachable() = true;
         break;
@@ -146,8 +172,12 @@ private:
       ts.next(node->state_ptr(), sst, tchecker::STATE_OK);
       for (auto && [status, s, t] : sst) {
         auto && [is_new_node, next_node] = graph.add_node(s);
-        if (is_new_node)
+        if (is_new_node) {
           waiting.insert(next_node);
+          ++stored_states;
+          if (_progress.get() != nullptr)
+            _progress->waiting_inserted(next_node.ptr(), false);
+        }
         graph.add_edge(node, next_node, *t);
       }
       sst.clear();
@@ -155,6 +185,8 @@ private:
 
     waiting.clear();
   }
+
+  std::shared_ptr<tchecker::algorithms::progress_t> _progress; /*!< Progress reports (nullptr: no report) */
 };
 
 } // end of namespace reach
@@ -0,0 +1,176 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_CLOCKBOUNDS_CACHE_HH
+#define TCHECKER_CLOCKBOUNDS_CACHE_HH
+
+#include <cstdint>
+#include <map>
+#include <string>
+
+#include "tchecker/clockbounds/clockbounds.hh"
+#include "tchecker/ta/system.hh"
+
+/*!
+ \file cache.hh
+ \brief On-disk cache of clock bounds and reduced A-maps
+ */
+
+namespace tchecker {
+
+namespace clockbounds {
+
+/*!
+ \brief Content hash (64-bit FNV-1a)
+ \param s : a string
+ \return hash of the bytes in s
+ \note the hash does not depend on the platform nor on the execution, hence it
+ can be used to identify files across runs
+ */
+std::uint64_t content_hash(std::string const & s);
+
+/*!
+ \class cache_t
+ \brief Directory of precomputed clock bounds and reduced A-maps
+
+ Entries are keyed by the content hash of a model file: one file per model and
+ per kind of table (clock bounds, reduced A-map, ECA reduced A-map) in the cache
+ directory. Entries are stored in a compact binary format: a header (magic
+ number, byte order, format version, kind of table, model hash, and number of
+ locations, clocks and edges of the system) followed by the tables.
+
+ An entry is only loaded if its header matches the format version and the
+ system, and if it is complete. Otherwise, loading fails, and the caller is
+ expected to recompute the tables (and to store them again). Entries are written
+ to a temporary file which is then renamed, hence concurrent runs never read a
+ partially written entry.
+ \note reduced A-maps over systems with clock arrays are not cached
+ */
+class cache_t {
+public:
+  /*!
+   \brief Version of the binary format
+   \note should be incremented each time the format, or the semantics of cached
+   tables, is modified
+   */
+  static std::uint32_t const FORMAT_VERSION = 1;
+
+  /*!
+   \brief Constructor
+   \param dir : cache directory
+   \param model : contents of the model file
+   \post this cache stores entries for model in directory dir
+   \note dir is created when the first entry is stored
+   */
+  cache_t(std::string const & dir, std::string const & model);
+
+  /*!
+   \brief Accessor
+   \return cache directory
+   */
+  inline std::string const & dir() const { return _dir; }
+
+  /*!
+   \brief Accessor
+   \return content hash of the model
+   */
+  inline std::uint64_t key() const { return _key; }
+
+  /*!
+   \brief Load clock bounds
+   \param system : a system of timed processes
+   \return the clock bounds of system stored in this cache, nullptr if there is
+   no such entry, or if the entry does not match system or this version
+   \note the returned pointer must be deleted by the caller
+   */
+  tchecker::clockbounds::clockbounds_t * load_clockbounds(tchecker::ta::system_t const & system) const;
+
+  /*!
+   \brief Store clock bounds
+   \param system : a system of timed processes
+   \param clockbounds : clock bounds of system
+   \post clockbounds has been stored in this cache
+   \return true if clockbounds has been stored, false otherwise
+   */
+  bool store_clockbounds(tchecker::ta::system_t const & system,
+                         tchecker::clockbounds::clockbounds_t const & clockbounds) const;
+
+  /*!
+   \brief Load reduced A-map
+   \param system : a system of timed processes
+   \return the reduced A-map of system stored in this cache, nullptr if there is
+   no such entry, or if the entry does not match system or this version
+   \note the returned pointer must be deleted by the caller
+   */
+  tchecker::amap::a_map_t * load_amap(tchecker::ta::system_t const & system) const;
+
+  /*!
+   \brief Store reduced A-map
+   \param system : a system of timed processes
+   \param amap : reduced A-map of system
+   \post amap has been stored in this cache
+   \return true if amap has been stored, false otherwise (in particular if system
+   has clock arrays)
+   */
+  bool store_amap(tchecker::ta::system_t const & system, tchecker::amap::a_map_t const & amap) const;
+
+  /*!
+   \brief Load ECA reduced A-map
+   \param system : a system of timed processes
+   \return the ECA reduced A-map of system stored in this cache, nullptr if there
+   is no such entry, or if the entry does not match system or this version
+   \note the returned pointer must be deleted by the caller
+   */
+  tchecker::eca_amap_gen2::eca_a_map_t * load_eca_amap(tchecker::ta::system_t const & system) const;
+
+  /*!
+   \brief Store ECA reduced A-map
+   \param system : a system of timed processes
+   \param amap : ECA reduced A-map of system
+   \post amap has been stored in this cache
+   \return true if amap has been stored, false otherwise (in particular if system
+   has clock arrays)
+   */
+  bool store_eca_amap(tchecker::ta::system_t const & system, tchecker::eca_amap_gen2::eca_a_map_t const & amap) const;
+
+  /*!
+   \brief Accessor
+   \param m : map (attribute, value)
+   \post attributes of this cache have been added to m: number of entries that
+   have been loaded (hits), not found or rejected (misses), and stored
+   */
+  void attributes(std::map<std::string, std::string> & m) const;
+
+  /*!
+   \brief Kinds of cached tables
+   */
+  enum kind_t : std::uint32_t {
+    KIND_CLOCKBOUNDS = 1, /*!< Clock bounds */
+    KIND_AMAP = 2,        /*!< Reduced A-map */
+    KIND_ECA_AMAP = 3,    /*!< ECA reduced A-map */
+  };
+
+  /*!
+   \brief Accessor
+   \param kind : kind of table
+   \return path to the entry of kind in this cache
+   */
+  std::string path(enum kind_t kind) const;
+
+private:
+  std::string _dir;                 /*!< Cache directory */
+  std::uint64_t _key;               /*!< Content hash of the model */
+  mutable unsigned long _hits;      /*!< Number of loaded entries */
+  mutable unsigned long _misses;    /*!< Number of entries not found or rejected */
+  mutable unsigned long _stores;    /*!< Number of stored entries */
+};
+
+} // end of namespace clockbounds
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_CLOCKBOUNDS_CACHE_HH
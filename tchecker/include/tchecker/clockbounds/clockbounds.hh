@@ -10,7 +10,12 @@
 
 #include <cstdint>
 #include <iostream>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <unordered_map>
 #include <vector>
 
 #include "tchecker/basictypes.hh"
@@ -873,6 +878,103 @@ private:
   std::shared_ptr<tchecker::clockbounds::local_m_map_t> _local_m;     /*!< Local M map */
 };
 
+/*!
+ \class local_lu_table_t
+ \brief Memoised local LU maps of tuples of locations
+ \note The local LU maps of a tuple of locations (see
+ tchecker::clockbounds::local_lu_map_t::bounds) are computed on the first query
+ for this tuple, and stored in an arena of blocks of maps. Later queries for the
+ same tuple are answered from the arena without recomputation. Maps in the arena
+ are never moved, and they are deallocated with the table
+ \note Not thread-safe: a table must not be queried from several threads
+ */
+class local_lu_table_t {
+public:
+  /*!
+   \brief Constructor
+   \param local_lu : local LU map
+   \note this keeps a shared pointer on local_lu
+   */
+  local_lu_table_t(std::shared_ptr<tchecker::clockbounds::local_lu_map_t const> const & local_lu);
+
+  /*!
+   \brief Copy constructor (deleted)
+   */
+  local_lu_table_t(tchecker::clockbounds::local_lu_table_t const &) = delete;
+
+  /*!
+   \brief Move constructor (deleted)
+   */
+  local_lu_table_t(tchecker::clockbounds::local_lu_table_t &&) = delete;
+
+  /*!
+   \brief Destructor
+   \post all the maps in this table have been deallocated
+   */
+  ~local_lu_table_t();
+
+  /*!
+   \brief Assignment operator (deleted)
+   */
+  tchecker::clockbounds::local_lu_table_t & operator=(tchecker::clockbounds::local_lu_table_t const &) = delete;
+
+  /*!
+   \brief Move-assignment operator (deleted)
+   */
+  tchecker::clockbounds::local_lu_table_t & operator=(tchecker::clockbounds::local_lu_table_t &&) = delete;
+
+  /*!
+   \brief Accessor
+   \param vloc : tuple of location identifiers
+   \param L : clock lower-bound map
+   \param U : clock upper-bound map
+   \pre see tchecker::clockbounds::local_lu_map_t::bounds
+   \post L and U point to the local lower-bound and local upper-bound maps for
+   vloc, which are computed and stored in this table if vloc has not been queried
+   before. L and U are valid as long as this table is alive
+   */
+  void bounds(tchecker::vloc_t const & vloc, tchecker::clockbounds::map_t const *& L,
+              tchecker::clockbounds::map_t const *& U);
+
+  /*!
+   \brief Accessor
+   \return Number of tuples of locations in this table
+   */
+  inline std::size_t size() const { return _entries.size(); }
+
+private:
+  /*!
+   \brief Entry of the table
+   */
+  struct entry_t {
+    std::size_t vloc_offset;            /*!< Offset of the tuple of locations in _vlocs */
+    tchecker::clockbounds::map_t * L; /*!< Local lower-bound map */
+    tchecker::clockbounds::map_t * U; /*!< Local upper-bound map */
+  };
+
+  /*!
+   \brief Check if an entry is a tuple of locations
+   \param entry : an entry
+   \param vloc : tuple of location identifiers
+   \return true if entry is the entry of vloc, false otherwise
+   */
+  bool is_entry(tchecker::clockbounds::local_lu_table_t::entry_t const & entry, tchecker::vloc_t const & vloc) const;
+
+  /*!
+   \brief Allocate a map in the arena
+   \return a clock bound map with as many clocks as the local LU map
+   */
+  tchecker::clockbounds::map_t * allocate_map();
+
+  std::shared_ptr<tchecker::clockbounds::local_lu_map_t const> _local_lu; /*!< Local LU map */
+  std::vector<tchecker::loc_id_t> _vlocs;                                 /*!< Tuples of locations of the entries */
+  std::vector<tchecker::clockbounds::local_lu_table_t::entry_t> _entries; /*!< Entries */
+  std::unordered_multimap<std::size_t, std::size_t> _index;              /*!< Hash of tuple -> entry */
+  std::vector<char *> _blocks;                                            /*!< Blocks of the arena */
+  std::size_t _block_used;                                                /*!< Maps used in the last block */
+  std::size_t _last;                                                      /*!< Last entry queried */
+};
+
 } // namespace clockbounds
 
 namespace amap {
@@ -886,6 +988,215 @@ namespace amap {
 //  */
 // std::ostream & operator<<(std::ostream & os, tchecker::clockbounds::map_t const & map);
 
+/*!
+ \class constraint_factory_t
+ \brief Factory of interned atomic clock constraints
+
+ The factory keeps a single instance of each atomic constraint x#c and x-y#c
+ (identified by its clocks, its operator and its bound). Hence two constraints
+ obtained from the same factory are semantically equal if and only if they are
+ the same object. Interned constraints are owned by the factory, and they are
+ deallocated with it.
+ \note the constraints in reduced A-maps are interned in the factory of the map
+ \note interning is thread-safe
+ */
+class constraint_factory_t {
+public:
+  /*!
+   \brief Constructor
+   \post this factory is empty
+   */
+  constraint_factory_t() = default;
+
+  /*!
+   \brief Copy constructor (deleted)
+   */
+  constraint_factory_t(tchecker::amap::constraint_factory_t const &) = delete;
+
+  /*!
+   \brief Move constructor (deleted)
+   */
+  constraint_factory_t(tchecker::amap::constraint_factory_t &&) = delete;
+
+  /*!
+   \brief Destructor
+   \post all interned constraints have been deallocated
+   */
+  ~constraint_factory_t();
+
+  /*!
+   \brief Assignment operator (deleted)
+   */
+  tchecker::amap::constraint_factory_t & operator=(tchecker::amap::constraint_factory_t const &) = delete;
+
+  /*!
+   \brief Move-assignment operator (deleted)
+   */
+  tchecker::amap::constraint_factory_t & operator=(tchecker::amap::constraint_factory_t &&) = delete;
+
+  /*!
+   \brief Interned non-diagonal constraint
+   \param clock : a clock
+   \param op : operator
+   \param bound : bound
+   \return the instance of clock op bound in this factory (allocated if needed)
+   */
+  tchecker::typed_simple_clkconstr_expression_t const * simple(tchecker::typed_lvalue_expression_t const & clock,
+                                                               tchecker::binary_operator_t op, tchecker::integer_t bound);
+
+  /*!
+   \brief Interned diagonal constraint
+   \param x : first clock
+   \param y : second clock
+   \param op : operator
+   \param bound : bound
+   \return the instance of x - y op bound in this factory (allocated if needed)
+   */
+  tchecker::typed_diagonal_clkconstr_expression_t const * diagonal(tchecker::typed_lvalue_expression_t const & x,
+                                                                   tchecker::typed_lvalue_expression_t const & y,
+                                                                   tchecker::binary_operator_t op, tchecker::integer_t bound);
+
+  /*!
+   \brief Intern a non-diagonal constraint
+   \param expr : a non-diagonal constraint
+   \return the instance of expr in this factory (allocated if needed)
+   \note expr is not owned by this factory
+   */
+  tchecker::typed_simple_clkconstr_expression_t const * intern(tchecker::typed_simple_clkconstr_expression_t const & expr);
+
+  /*!
+   \brief Intern a diagonal constraint
+   \param expr : a diagonal constraint
+   \return the instance of expr in this factory (allocated if needed)
+   \note expr is not owned by this factory
+   */
+  tchecker::typed_diagonal_clkconstr_expression_t const *
+  intern(tchecker::typed_diagonal_clkconstr_expression_t const & expr);
+
+  /*!
+   \brief Accessor
+   \return number of interned constraints
+   */
+  inline std::size_t size() const
+  {
+    std::lock_guard<std::mutex> lock{_mutex};
+    return _simple.size() + _diagonal.size();
+  }
+
+private:
+  /*!
+   \brief Type of keys of non-diagonal constraints: (x, operator, bound)
+   */
+  using simple_key_t = std::tuple<tchecker::clock_id_t, tchecker::binary_operator_t, tchecker::integer_t>;
+
+  /*!
+   \brief Type of keys of diagonal constraints: (x, y, operator, bound)
+   */
+  using diagonal_key_t =
+      std::tuple<tchecker::clock_id_t, tchecker::clock_id_t, tchecker::binary_operator_t, tchecker::integer_t>;
+
+  /*!
+   \brief Hash function on keys
+   */
+  struct key_hash_t {
+    std::size_t operator()(simple_key_t const & k) const;
+    std::size_t operator()(diagonal_key_t const & k) const;
+  };
+
+  std::unordered_map<simple_key_t, tchecker::typed_simple_clkconstr_expression_t const *, key_hash_t>
+      _simple; /*!< Interned non-diagonal constraints */
+  std::unordered_map<diagonal_key_t, tchecker::typed_diagonal_clkconstr_expression_t const *, key_hash_t>
+      _diagonal;              /*!< Interned diagonal constraints */
+  mutable std::mutex _mutex;  /*!< Lock on interned constraints */
+};
+
+/*!
+ \class fixpoint_stats_t
+ \brief Statistics on the fixpoint computation of a reduced A-map
+ */
+class fixpoint_stats_t {
+public:
+  /*!
+   \brief Constructor
+   */
+  fixpoint_stats_t();
+
+  /*!
+   \brief Accessor
+   \return A reference to the number of iterations (i.e. edges taken from the worklist)
+   */
+  unsigned long & iterations();
+
+  /*!
+   \brief Accessor
+   \return the number of iterations (i.e. edges taken from the worklist)
+   */
+  unsigned long iterations() const;
+
+  /*!
+   \brief Accessor
+   \return A reference to the number of constraints propagated along an edge
+   */
+  unsigned long & propagations();
+
+  /*!
+   \brief Accessor
+   \return the number of constraints propagated along an edge
+   */
+  unsigned long propagations() const;
+
+  /*!
+   \brief Accessor
+   \return A reference to the running time of the fixpoint computation (in seconds)
+   */
+  double & running_time();
+
+  /*!
+   \brief Accessor
+   \return the running time of the fixpoint computation (in seconds)
+   */
+  double running_time() const;
+
+  /*!
+   \brief Accessor
+   \return A reference to the number of strongly connected components of the
+   location graph
+   */
+  unsigned long & sccs();
+
+  /*!
+   \brief Accessor
+   \return the number of strongly connected components of the location graph
+   */
+  unsigned long sccs() const;
+
+  /*!
+   \brief Accessor
+   \return A reference to the number of threads used by the fixpoint computation
+   */
+  unsigned int & threads();
+
+  /*!
+   \brief Accessor
+   \return the number of threads used by the fixpoint computation
+   */
+  unsigned int threads() const;
+
+  /*!
+   \brief Extract statistics as attributes (key, value)
+   \param m : attributes map
+   \post every statistics has been added to m
+   */
+  void attributes(std::map<std::string, std::string> & m) const;
+
+private:
+  unsigned long _iterations;   /*!< Number of iterations */
+  unsigned long _propagations; /*!< Number of propagated constraints */
+  double _running_time;        /*!< Running time in seconds */
+  unsigned long _sccs;         /*!< Number of strongly connected components */
+  unsigned int _threads;       /*!< Number of threads */
+};
+
 /*!
  \class a_map_t
  \brief Map from system locations to reduced A-maps
@@ -1004,12 +1315,43 @@ public:
   */
   void bounds(tchecker::vloc_t const & vloc, std::vector<tchecker::typed_diagonal_clkconstr_expression_t const *> & G, std::vector<tchecker::typed_simple_clkconstr_expression_t const *> & Gdf) const;
 
+  /*!
+   \brief Accessor
+   \return statistics on the computation of this map
+   */
+  inline tchecker::amap::fixpoint_stats_t & fixpoint_stats() { return _fixpoint_stats; }
+
+  /*!
+   \brief Accessor
+   \return statistics on the computation of this map
+   */
+  inline tchecker::amap::fixpoint_stats_t const & fixpoint_stats() const { return _fixpoint_stats; }
+
+  /*!
+   \brief Accessor
+   \return factory of the constraints in this map
+   \note the factory is shared with the copies of this map
+   */
+  inline tchecker::amap::constraint_factory_t & factory() const { return *_factory; }
+
 private:
   tchecker::loc_id_t _loc_nb;                     /*!< Number of system locations */
   std::vector<std::vector<tchecker::typed_diagonal_clkconstr_expression_t const *>> _G;   /*!< vector containing diagonal constraints of reduced A-map */
   std::vector<std::vector<tchecker::typed_simple_clkconstr_expression_t const *>> _Gdf;   /*!< vector containing non-diagonal constraints of reduced A-map */
+  tchecker::amap::fixpoint_stats_t _fixpoint_stats;                                      /*!< Statistics on the fixpoint computation */
+  std::shared_ptr<tchecker::amap::constraint_factory_t> _factory;                        /*!< Factory of interned constraints */
 };
 
+/*!
+ \brief Accessor
+ \param map : a map
+ \return maximal absolute value of the constants in the constraints of map (0 if
+ map has no constraint)
+ \note constants that cannot be evaluated are accounted as
+ tchecker::clockbounds::MAX_BOUND
+ */
+tchecker::integer_t max_constant(tchecker::amap::a_map_t const & map);
+
 /*!
  \brief Output operator
  \param os : output stream
@@ -1142,12 +1484,43 @@ public:
   */
   void bounds(tchecker::vloc_t const & vloc, std::vector<tchecker::typed_diagonal_clkconstr_expression_t const *> & G, std::vector<tchecker::typed_simple_clkconstr_expression_t const *> & Gdf) const;
 
+  /*!
+   \brief Accessor
+   \return statistics on the computation of this map
+   */
+  inline tchecker::amap::fixpoint_stats_t & fixpoint_stats() { return _fixpoint_stats; }
+
+  /*!
+   \brief Accessor
+   \return statistics on the computation of this map
+   */
+  inline tchecker::amap::fixpoint_stats_t const & fixpoint_stats() const { return _fixpoint_stats; }
+
+  /*!
+   \brief Accessor
+   \return factory of the constraints in this map
+   \note the factory is shared with the copies of this map
+   */
+  inline tchecker::amap::constraint_factory_t & factory() const { return *_factory; }
+
 private:
   tchecker::loc_id_t _loc_nb;                     /*!< Number of system locations */
   std::vector<std::vector<tchecker::typed_diagonal_clkconstr_expression_t const *>> _G;   /*!< vector containing diagonal constraints of reduced A-map */
   std::vector<std::vector<tchecker::typed_simple_clkconstr_expression_t const *>> _Gdf;   /*!< vector containing non-diagonal constraints of reduced A-map */
+  tchecker::amap::fixpoint_stats_t _fixpoint_stats;                                      /*!< Statistics on the fixpoint computation */
+  std::shared_ptr<tchecker::amap::constraint_factory_t> _factory;                        /*!< Factory of interned constraints */
 };
 
+/*!
+ \brief Accessor
+ \param map : a map
+ \return maximal absolute value of the constants in the constraints of map (0 if
+ map has no constraint)
+ \note constants that cannot be evaluated are accounted as
+ tchecker::clockbounds::MAX_BOUND
+ */
+tchecker::integer_t max_constant(tchecker::eca_amap_gen2::eca_a_map_t const & map);
+
 /*!
  \brief Output operator
  \param os : output stream
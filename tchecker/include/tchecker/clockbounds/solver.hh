@@ -9,7 +9,11 @@
 #define TCHECKER_CLOCKBOUNDS_SOLVER_HH
 
 #include <algorithm>
+#include <cstdint>
 #include <functional>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include "tchecker/clockbounds/clockbounds.hh"
 #include "tchecker/dbm/dbm.hh"
@@ -376,6 +380,120 @@ namespace amap {
                    tchecker::typed_statement_t const & up,
                    tchecker::typed_expression_t * & pre);
 
+  /*!
+  \class constraint_index_t
+  \brief Index of the atomic constraints of a location in a reduced A-map
+
+  Gdf keeps at most one constraint for each clock x and each direction (upper
+  bounds x<c, x<=c, or lower bounds x>c, x>=c): the dominant one, with the
+  greatest constant (and x<=c dominates x<c, x>c dominates x>=c). When infinite
+  bounds are distinguished (see tchecker::eca_amap_gen2), a constraint with bound
+  tchecker::dbm::INF_VALUE or tchecker::dbm::MINUS_INF_VALUE is only compared to
+  constraints with the same operator and the same bound. G keeps every diagonal
+  constraint at most once.
+
+  The index maps each clock and direction to the position and the value of the
+  dominant constraint in Gdf, and it records the diagonal constraints in G. Hence
+  dominance checks and insertions take constant time. A dominated constraint is
+  replaced in place in Gdf, so the order of the other constraints is preserved.
+
+  The constraints added to G and Gdf are interned in a factory (see
+  tchecker::amap::constraint_factory_t): G and Gdf only contain instances owned
+  by the factory, which may be compared by address.
+  \note G and Gdf should only be modified through the index
+  */
+  class constraint_index_t {
+  public:
+    /*!
+    \brief Constructor
+    \param infinite_bounds : true if infinite bounds should be distinguished
+    \param factory : factory of interned constraints
+    \post this index is empty
+    \note this keeps a reference on factory
+    */
+    constraint_index_t(bool infinite_bounds, tchecker::amap::constraint_factory_t & factory);
+
+    /*!
+    \brief Accessor
+    \return factory of the constraints in this index
+    */
+    inline tchecker::amap::constraint_factory_t & factory() const { return *_factory; }
+
+    /*!
+    \brief Build the index of existing constraints
+    \param G   : set of diagonal constraints
+    \param Gdf : set of non-diagonal constraints
+    \post the constraints in G and Gdf have been replaced by their instances in
+    the factory, and this indexes G and Gdf
+    */
+    void build(std::vector<tchecker::typed_diagonal_clkconstr_expression_t const *> & G,
+               std::vector<tchecker::typed_simple_clkconstr_expression_t const *> & Gdf);
+
+    /*!
+    \brief Clear
+    \post this index is empty
+    */
+    void clear();
+
+    /*!
+    \brief Add a diagonal constraint
+    \param G    : set of diagonal constraints indexed by this
+    \param expr : a diagonal constraint x-y#c with # in <, <=, >=, >
+    \post the instance of expr in the factory has been added to G unless it was
+    present already
+    \return true if G has been modified, false otherwise
+    */
+    bool add(std::vector<tchecker::typed_diagonal_clkconstr_expression_t const *> & G,
+             tchecker::typed_diagonal_clkconstr_expression_t const & expr);
+
+    /*!
+    \brief Add a non-diagonal constraint
+    \param Gdf  : set of non-diagonal constraints indexed by this
+    \param expr : a non-diagonal constraint x#c with # in <, <=, >=, >
+    \post the instance of expr in the factory has been added to Gdf unless a
+    constraint in Gdf dominates expr. The constraint dominated by expr (if any)
+    has been replaced by the instance of expr
+    \return true if Gdf has been modified, false otherwise
+    */
+    bool add(std::vector<tchecker::typed_simple_clkconstr_expression_t const *> & Gdf,
+             tchecker::typed_simple_clkconstr_expression_t const & expr);
+
+  private:
+    /*!
+    \brief Type of dominant constraints
+    */
+    struct dominant_t {
+      std::size_t position;               /*!< Position in Gdf */
+      tchecker::integer_t bound;          /*!< Bound of the constraint */
+      tchecker::binary_operator_t op;     /*!< Operator of the constraint */
+    };
+
+    /*!
+    \brief Key of a non-diagonal constraint
+    \param x  : clock
+    \param op : operator
+    \param bound : bound
+    \return the key of the slot of x#bound in Gdf
+    */
+    std::uint64_t key(tchecker::clock_id_t x, tchecker::binary_operator_t op, tchecker::integer_t bound) const;
+
+    bool _infinite_bounds;                                                    /*!< Infinite bounds are distinguished */
+    tchecker::amap::constraint_factory_t * _factory;                          /*!< Factory of interned constraints */
+    std::unordered_map<std::uint64_t, dominant_t> _Gdf_index;                 /*!< Dominant constraints in Gdf */
+    std::unordered_set<tchecker::typed_diagonal_clkconstr_expression_t const *> _G_index; /*!< Constraints in G */
+  };
+
+  /*!
+  \brief Add atomic constraints from a constraint to appropriate G, Gdf
+  \param g     : a constraint
+  \param G     : set of diagonal constraints
+  \param Gdf   : set of non-diagonal constraints
+  \param index : index of G and Gdf
+  \post All atomic constraints from the constraint g is added to G and Gdf, and to index
+  */
+  void add_constraint(tchecker::typed_expression_t const & g, std::vector<tchecker::typed_diagonal_clkconstr_expression_t const *> & G, 
+  std::vector<tchecker::typed_simple_clkconstr_expression_t const *> & Gdf, tchecker::amap::constraint_index_t & index);
+
   /*!
   \brief Add atomic constraints from a constraint to appropriate G, Gdf
   \param g   : a constraint
@@ -391,19 +509,24 @@ namespace amap {
   \brief Computes reduced A-map from a system of timed processes
   \param system : a system of timed processes
   \param amap   : clock bound maps
+  \param threads : number of threads
   \pre amap is empty with the same number of locations as system
   \return true if system has computable reduced A-map and the reduced A-map has been
   filled, false otherwise
   \post if system has a solution, then amap has been filled with the computed reduced A-map, otherwise, amap is empty
+  \note the strongly connected components of the location graph of system are
+  solved in reverse topological order, and up to threads independent components
+  are solved concurrently
   */
-  bool compute_amap(tchecker::ta::system_t const & system, tchecker::amap::a_map_t & amap);
+  bool compute_amap(tchecker::ta::system_t const & system, tchecker::amap::a_map_t & amap, unsigned int threads = 1);
 
   /*!
   \brief Allocates and computes reduced A-map from a system A of timed processes
   \param system : a system of timed processes
+  \param threads : number of threads
   \return reduced A-map for system, nullptr if the fixpoint computation failed
   */
-  tchecker::amap::a_map_t * compute_amap(tchecker::ta::system_t const & system);
+  tchecker::amap::a_map_t * compute_amap(tchecker::ta::system_t const & system, unsigned int threads = 1);
 
 } // end of namespace amap
 
@@ -505,23 +628,61 @@ namespace eca_amap_gen2 {
   std::vector<tchecker::typed_simple_clkconstr_expression_t const *> & Gdf,
   const std::vector<int> & prophecy_clock_ids);
 
+  /*!
+  \brief Add atomic constraints from a constraint to appropriate G, Gdf
+  \param g     : a constraint
+  \param G     : set of diagonal constraints
+  \param Gdf   : set of non-diagonal constraints
+  \param prophecy_clock_ids : identifiers of prophecy clocks
+  \param index : index of G and Gdf (that distinguishes infinite bounds)
+  \post All atomic constraints from the constraint g is added to G and Gdf, and
+  to index, except non-diagonal constraints on prophecy clocks
+  */
+  void add_constraint(tchecker::typed_expression_t const & g, 
+  std::vector<tchecker::typed_diagonal_clkconstr_expression_t const *> & G, 
+  std::vector<tchecker::typed_simple_clkconstr_expression_t const *> & Gdf,
+  const std::vector<int> & prophecy_clock_ids,
+  tchecker::amap::constraint_index_t & index);
+
   /*!
   \brief Computes reduced A-map from a system of timed processes
   \param system : a system of timed processes
   \param amap   : clock bound maps
+  \param threads : number of threads
   \pre amap is empty with the same number of locations as system
   \return true if system has computable reduced A-map and the reduced A-map has been
   filled, false otherwise
   \post if system has a solution, then amap has been filled with the computed reduced A-map, otherwise, amap is empty
+  \note the strongly connected components of the location graph of system are
+  solved in reverse topological order, and up to threads independent components
+  are solved concurrently
   */
-  bool compute_eca_amap(tchecker::ta::system_t const & system, tchecker::eca_amap_gen2::eca_a_map_t & amap);
+  bool compute_eca_amap(tchecker::ta::system_t const & system, tchecker::eca_amap_gen2::eca_a_map_t & amap, unsigned int threads = 1);
 
   /*!
   \brief Allocates and computes reduced A-map from a system A of timed processes
   \param system : a system of timed processes
+  \param threads : number of threads
   \return reduced A-map for system, nullptr if the fixpoint computation failed
   */
-  tchecker::eca_amap_gen2::eca_a_map_t * compute_eca_amap(tchecker::ta::system_t const & system);
+  tchecker::eca_amap_gen2::eca_a_map_t * compute_eca_amap(tchecker::ta::system_t const & system, unsigned int threads = 1);
+
+  /*!
+  \brief Allocates and computes local LU clock bounds from a reduced A-map
+  \param system : a system of timed processes
+  \param amap : reduced A-map for system
+  \return local LU map L, U such that for every location l and every normal or
+  history clock x that does not appear in a diagonal constraint of G[l], L[l](x)
+  (resp. U[l](x)) is the maximal finite constant in a lower-bound (resp.
+  upper-bound) constraint on x in Gdf[l]. L[l](x) and U[l](x) are
+  tchecker::clockbounds::MAX_BOUND for all other clocks, in particular for
+  prophecy clocks and for history clocks compared to infinity in Gdf[l]
+  \note the returned map is suitable for tchecker::dbm::eca_extra_lu_plus: the
+  constraints on clocks with bound tchecker::clockbounds::MAX_BOUND are never
+  abstracted
+  */
+  tchecker::clockbounds::local_lu_map_t * compute_local_lu_map(tchecker::ta::system_t const & system,
+                                                               tchecker::eca_amap_gen2::eca_a_map_t const & amap);
 
 } // end of namespace eca_amap_gen2
 
@@ -0,0 +1,147 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_DBM_CLOSURE_HH
+#define TCHECKER_DBM_CLOSURE_HH
+
+#include "tchecker/basictypes.hh"
+#include "tchecker/dbm/db.hh"
+
+/*!
+ \file closure.hh
+ \brief Row kernels of the Floyd-Warshall closure of DBMs, and of the aLU
+ simulation check
+ \note The closure kernels compute the same difference bounds as the scalar
+ loops over tchecker::dbm::sum and tchecker::dbm::eca_sum in the same order,
+ hence they yield bit-identical DBMs and throw on the same overflows. Vectorised kernels
+ are selected at runtime according to the instruction sets supported by the
+ processor: AVX2 (32-bit and 64-bit difference bounds) and SSE4.1 (32-bit
+ difference bounds). The scalar kernel is used otherwise
+ */
+
+namespace tchecker {
+
+namespace dbm {
+
+/*!
+ \brief Kernels of the closure of DBMs
+ */
+enum closure_kernel_t {
+  CLOSURE_SCALAR = 0, /*!< Scalar kernel */
+  CLOSURE_SSE41,      /*!< SSE4.1 kernel */
+  CLOSURE_AVX2,       /*!< AVX2 kernel */
+};
+
+/*!
+ \brief Accessor
+ \return the kernel used by tighten_row and eca_tighten_row
+ */
+enum tchecker::dbm::closure_kernel_t closure_kernel();
+
+/*!
+ \brief Accessor
+ \param kernel : a kernel
+ \return true if kernel is supported by the processor and by the type of
+ difference bounds, false otherwise
+ */
+bool closure_kernel_supported(enum tchecker::dbm::closure_kernel_t kernel);
+
+/*!
+ \brief Select the kernel used by tighten_row and eca_tighten_row
+ \param kernel : a kernel
+ \pre closure_kernel_supported(kernel)
+ \post kernel is used by tighten_row and eca_tighten_row
+ \throw std::invalid_argument : if kernel is not supported
+ \note the fastest supported kernel is selected by default. This function is
+ not thread-safe: it is meant for tests and benchmarks
+ */
+void set_closure_kernel(enum tchecker::dbm::closure_kernel_t kernel);
+
+/*!
+ \brief Accessor
+ \param kernel : a kernel
+ \return name of kernel
+ */
+char const * closure_kernel_name(enum tchecker::dbm::closure_kernel_t kernel);
+
+/*!
+ \brief Tighten a row of a DBM through a clock
+ \param dbm : a DBM
+ \param dim : dimension of dbm
+ \param i : a row
+ \param k : a clock
+ \param begin : first column
+ \param end : past-the-end column
+ \pre dbm is a dim*dim array of difference bounds, i < dim, k < dim and
+ begin <= end <= dim
+ \post for j from begin to end-1 (in this order), the difference bound in (i,j)
+ is the minimum of its value and tchecker::dbm::sum of the bounds in (i,k) and
+ (k,j)
+ \throw std::invalid_argument : if a sum cannot be represented (see
+ tchecker::dbm::sum)
+ */
+void tighten_row(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::clock_id_t i, tchecker::clock_id_t k,
+                 tchecker::clock_id_t begin, tchecker::clock_id_t end);
+
+/*!
+ \brief Tighten a row of an ECA DBM through a clock
+ \param dbm : a DBM
+ \param dim : dimension of dbm
+ \param i : a row
+ \param k : a clock
+ \param begin : first column
+ \param end : past-the-end column
+ \pre dbm is a dim*dim array of difference bounds, i < dim, k < dim and
+ begin <= end <= dim
+ \post for j from begin to end-1 (in this order), the difference bound in (i,j)
+ is the minimum of its value and tchecker::dbm::eca_sum of the bounds in (i,k)
+ and (k,j)
+ \throw std::invalid_argument : if a sum cannot be represented (see
+ tchecker::dbm::eca_sum)
+ */
+void eca_tighten_row(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::clock_id_t i, tchecker::clock_id_t k,
+                     tchecker::clock_id_t begin, tchecker::clock_id_t end);
+
+/*!
+ \brief Status of the search for a witness of non-inclusion in a row
+ */
+enum alu_row_status_t {
+  ALU_ROW_NO_WITNESS = 0, /*!< No witness in the row */
+  ALU_ROW_WITNESS,        /*!< The row has a witness */
+  ALU_ROW_OVERFLOW,       /*!< A sum cannot be represented */
+};
+
+/*!
+ \brief Search a row for a witness of non-inclusion in the aLU abstraction
+ \param row1 : row y of a DBM dbm1
+ \param row2 : row y of a DBM dbm2
+ \param lt_minus_ly : difference bound (<,-L(y))
+ \param thresholds : difference bounds, one per column
+ \param begin : first column
+ \param end : past-the-end column
+ \pre row1, row2 and thresholds have at least end entries, and lt_minus_ly is
+ not tchecker::dbm::LT_INFINITY
+ \return ALU_ROW_WITNESS if there is a column x in [begin,end) such that
+ row2[x] < row1[x] and tchecker::dbm::sum(row2[x], lt_minus_ly) < thresholds[x],
+ ALU_ROW_OVERFLOW if no such column has been found before a column x with
+ row2[x] < row1[x] where the sum cannot be represented, and ALU_ROW_NO_WITNESS
+ otherwise
+ \note the columns are scanned by blocks of the width of the kernel selected by
+ tchecker::dbm::set_closure_kernel (the AVX2 kernel, or the scalar kernel). This
+ function does not throw: the caller is expected to check inclusion with scalar
+ sums on ALU_ROW_OVERFLOW
+ */
+enum tchecker::dbm::alu_row_status_t alu_row_witness(tchecker::dbm::db_t const * row1, tchecker::dbm::db_t const * row2,
+                                                     tchecker::dbm::db_t lt_minus_ly,
+                                                     tchecker::dbm::db_t const * thresholds, tchecker::clock_id_t begin,
+                                                     tchecker::clock_id_t end);
+
+} // end of namespace dbm
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_DBM_CLOSURE_HH
@@ -0,0 +1,125 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_DBM_COMPACT_HH
+#define TCHECKER_DBM_COMPACT_HH
+
+#include <cstdint>
+
+#include "tchecker/basictypes.hh"
+#include "tchecker/dbm/db.hh"
+
+/*!
+ \file compact.hh
+ \brief Compact storage of DBMs with 16-bit difference bounds
+ \note Compact difference bounds use the same encoding as tchecker::dbm::db_t
+ on 16 bits: the least-significant bit stores the comparator, and the other bits
+ store the value. Infinite bounds are encoded by dedicated sentinels. The
+ encoding preserves the ordering on difference bounds. Compact DBMs are meant
+ for storage only: they are widened to DBMs of tchecker::dbm::db_t before any
+ computation
+ */
+
+namespace tchecker {
+
+namespace dbm {
+
+/*!
+ \brief Type of compact difference bounds
+ */
+using compact_db_t = std::int16_t;
+
+tchecker::dbm::compact_db_t const COMPACT_INF_VALUE = INT16_MAX >> 1;               /*!< Infinity value */
+tchecker::dbm::compact_db_t const COMPACT_MAX_VALUE = COMPACT_INF_VALUE - 1;        /*!< Maximum value */
+tchecker::dbm::compact_db_t const COMPACT_MINUS_INF_VALUE = (INT16_MIN >> 1) + 1;   /*!< Minus infinity value */
+tchecker::dbm::compact_db_t const COMPACT_MIN_VALUE = COMPACT_MINUS_INF_VALUE + 1;  /*!< Minimum value */
+
+tchecker::dbm::compact_db_t const COMPACT_LT_INFINITY =
+    (COMPACT_INF_VALUE * 2) | tchecker::dbm::LT; /*!< <inf */
+tchecker::dbm::compact_db_t const COMPACT_LE_INFINITY =
+    (COMPACT_INF_VALUE * 2) | tchecker::dbm::LE; /*!< <=inf */
+tchecker::dbm::compact_db_t const COMPACT_LT_MINUS_INFINITY =
+    (COMPACT_MINUS_INF_VALUE * 2) | tchecker::dbm::LT; /*!< <-inf */
+tchecker::dbm::compact_db_t const COMPACT_LE_MINUS_INFINITY =
+    (COMPACT_MINUS_INF_VALUE * 2) | tchecker::dbm::LE; /*!< <=-inf */
+
+/*!
+ \brief Compaction of a difference bound
+ \param db : a difference bound
+ \param cdb : a compact difference bound
+ \post cdb is the compact encoding of db if db is infinite (i.e. an encoding of
+ infinity or of minus infinity), or if the value of db is between
+ COMPACT_MIN_VALUE and COMPACT_MAX_VALUE. cdb is unspecified otherwise
+ \return true if db has a compact encoding, false otherwise
+ */
+inline bool compact(tchecker::dbm::db_t db, tchecker::dbm::compact_db_t & cdb)
+{
+  tchecker::integer_t const value = (db >> 1);
+  if (value >= tchecker::dbm::INF_VALUE) {
+    cdb = static_cast<tchecker::dbm::compact_db_t>(COMPACT_LT_INFINITY | (db & 1));
+    return (value == tchecker::dbm::INF_VALUE);
+  }
+  if (value <= tchecker::dbm::MINUS_INF_VALUE) {
+    cdb = static_cast<tchecker::dbm::compact_db_t>(COMPACT_LT_MINUS_INFINITY | (db & 1));
+    return (value == tchecker::dbm::MINUS_INF_VALUE);
+  }
+  cdb = static_cast<tchecker::dbm::compact_db_t>(db);
+  return (value >= tchecker::dbm::COMPACT_MIN_VALUE) && (value <= tchecker::dbm::COMPACT_MAX_VALUE);
+}
+
+/*!
+ \brief Widening of a compact difference bound
+ \param cdb : a compact difference bound
+ \return the difference bound encoded by cdb
+ */
+inline tchecker::dbm::db_t widen(tchecker::dbm::compact_db_t cdb)
+{
+  if (cdb >= COMPACT_LT_INFINITY)
+    return (tchecker::dbm::LT_INFINITY | (cdb & 1));
+  if (cdb <= COMPACT_LE_MINUS_INFINITY)
+    return (((tchecker::dbm::MINUS_INF_VALUE) * 2) | (cdb & 1));
+  return static_cast<tchecker::dbm::db_t>(cdb);
+}
+
+/*!
+ \brief Compaction of a DBM
+ \param cdbm : a compact DBM
+ \param dbm : a DBM
+ \param dim : dimension of cdbm and dbm
+ \pre cdbm and dbm are dim*dim arrays of difference bounds
+ \post cdbm is the compact encoding of dbm if compaction succeeded, cdbm is
+ unspecified otherwise
+ \return true if every difference bound in dbm has a compact encoding (see
+ tchecker::dbm::compact), false otherwise
+ */
+bool compact(tchecker::dbm::compact_db_t * cdbm, tchecker::dbm::db_t const * dbm, tchecker::clock_id_t dim);
+
+/*!
+ \brief Check if a DBM has a compact encoding
+ \param dbm : a DBM
+ \param dim : dimension of dbm
+ \pre dbm is a dim*dim array of difference bounds
+ \return true if every difference bound in dbm has a compact encoding (see
+ tchecker::dbm::compact), false otherwise
+ */
+bool is_compactable(tchecker::dbm::db_t const * dbm, tchecker::clock_id_t dim);
+
+/*!
+ \brief Widening of a compact DBM
+ \param dbm : a DBM
+ \param cdbm : a compact DBM
+ \param dim : dimension of dbm and cdbm
+ \pre dbm and cdbm are dim*dim arrays of difference bounds
+ \post dbm is the DBM encoded by cdbm
+ */
+void widen(tchecker::dbm::db_t * dbm, tchecker::dbm::compact_db_t const * cdbm, tchecker::clock_id_t dim);
+
+} // end of namespace dbm
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_DBM_COMPACT_HH
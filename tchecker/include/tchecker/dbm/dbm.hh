@@ -124,6 +124,51 @@ void empty(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim);
  */
 void eca_zero(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, const std::unordered_set<int> &history_clock_ids, const std::unordered_set<int> &prophecy_clock_ids, const std::unordered_set<int> &normal_clock_ids);
 
+/*!
+ \struct clock_layout_t
+ \brief Ranges of DBM indices of ECA clocks grouped by kind
+ \note Index 0 is the reference clock and index 1 is the "tmp" clock. Normal
+ clocks have indices in [normal_begin, history_begin), history clocks have
+ indices in [history_begin, prophecy_begin) and prophecy clocks have indices in
+ [prophecy_begin, end) where end is the dimension of DBMs. ECA operations can
+ then be implemented as loops over ranges instead of lookups in sets of indices
+ */
+struct clock_layout_t {
+  tchecker::clock_id_t normal_begin;   /*!< First index of normal clocks */
+  tchecker::clock_id_t history_begin;  /*!< First index of history clocks */
+  tchecker::clock_id_t prophecy_begin; /*!< First index of prophecy clocks */
+  tchecker::clock_id_t end;            /*!< Dimension of DBMs */
+};
+
+/*!
+ \brief Compute the layout of ECA clocks
+ \param dim : dimension of DBMs
+ \param history_clock_ids : indices of history clocks
+ \param prophecy_clock_ids : indices of prophecy clocks
+ \param normal_clock_ids : indices of normal clocks
+ \param layout : a clock layout
+ \post layout describes the indices of clocks if every index in [2,dim) is the
+ index of exactly one clock in history_clock_ids, prophecy_clock_ids and
+ normal_clock_ids, and clocks are grouped as described in clock_layout_t.
+ Otherwise, layout is unchanged
+ \return true if clocks are grouped by kind, false otherwise
+ */
+bool eca_clock_layout(tchecker::clock_id_t dim, const std::unordered_set<int> &history_clock_ids,
+                      const std::unordered_set<int> &prophecy_clock_ids, const std::unordered_set<int> &normal_clock_ids,
+                      tchecker::dbm::clock_layout_t & layout);
+
+/*!
+ \brief Initial zone in ECA (see eca_zero above)
+ \param dbm : a DBM
+ \param dim : dimension of dbm
+ \param layout : layout of clocks in dbm
+ \pre dbm is not nullptr (checked by assertion)
+ dbm is a dim*dim array of difference bounds
+ layout.end == dim (checked by assertion)
+ \post same as eca_zero with the sets of clocks given by layout
+ */
+void eca_zero(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::dbm::clock_layout_t const & layout);
+
 
 
 /*!
@@ -204,6 +249,19 @@ bool eca_is_final_dbm(tchecker::dbm::db_t const * dbm, tchecker::clock_id_t dim,
                         const std::unordered_set<int> &prophecy_clock_ids, 
                         const std::unordered_set<int> &normal_clock_ids);
 
+/*!
+ \brief Final zone predicate (see eca_is_final_dbm above)
+ \param dbm : a DBM
+ \param dim : dimension of dbm
+ \param layout : layout of clocks in dbm
+ \pre dbm is not nullptr (checked by assertion)
+ dbm is a dim*dim array of difference bounds
+ layout.end == dim (checked by assertion)
+ \return true if every prophecy clock is released in dbm, false otherwise
+ */
+bool eca_is_final_dbm(tchecker::dbm::db_t const * dbm, tchecker::clock_id_t dim,
+                      tchecker::dbm::clock_layout_t const & layout);
+
 /*!
  \brief Universality predicate
  \param dbm : a DBM
@@ -284,6 +342,20 @@ enum tchecker::dbm::status_t eca_tighten(tchecker::dbm::db_t * dbm, tchecker::cl
               const std::unordered_set<int> &prophecy_clock_ids, 
               const std::unordered_set<int> &normal_clock_ids);
 
+/*!
+ \brief ECA tightness (see eca_tighten above)
+ \param dbm : a DBM
+ \param dim : dimension of dbm
+ \pre dbm is not nullptr (checked by assertion)
+ dbm is a dim*dim array of difference bounds
+ dim >= 1 (checked by assertion)
+ \post dbm is tight if it is not empty.
+ if dbm is empty, then the difference bound in (0,0) is less-than <=0 (tchecker::dbm::is_empty_0() returns true)
+ \return EMPTY if dbm is empty, NON_EMPTY otherwise
+ \note the kinds of clocks are not needed to tighten dbm
+ */
+enum tchecker::dbm::status_t eca_tighten(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim);
+
 /*!
  \brief Tighten a DBM
  \param dbm : a DBM
@@ -690,6 +762,19 @@ void eca_open_up(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim,
                   const std::unordered_set<int> &prophecy_clock_ids, 
                   const std::unordered_set<int> &normal_clock_ids);
 
+/*!
+ \brief ECA open up (see eca_open_up above)
+ \param dbm : a dbm
+ \param dim : dimension of dbm
+ \param layout : layout of clocks in dbm
+ \pre dbm is not nullptr (checked by assertion)
+ dbm is a dim*dim array of difference bounds
+ dbm is tight
+ layout.end == dim (checked by assertion)
+ \post same as eca_open_up with the sets of clocks given by layout
+ */
+void eca_open_up(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::dbm::clock_layout_t const & layout);
+
 /*!
  \brief Release a prophecy clock with index
  \param dbm : a dbm
@@ -732,6 +817,71 @@ void eca_release(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim,tchecker::c
                 const std::unordered_set<int> &history_clock_ids,
                 const std::unordered_set<int> &prophecy_clock_ids, 
                 const std::unordered_set<int> &normal_clock_ids);
+
+/*!
+ \brief Unbound a history clock with index
+ \param dbm : a dbm
+ \param dim : dimension of dbm
+ \param history_clock_id : index of a history clock in dbm
+ \param history_clock_ids : a vector of integer values of id of history clocks
+ \param prophecy_clock_ids : a vector of integer values of id of prophecy clocks
+ \param normal_clock_ids : a vector of integer values of id of normal clocks
+ \pre dbm is not nullptr (checked by assertion)
+ dbm is a dim*dim array of difference bounds
+ dbm is consistent (checked by assertion)
+ dbm is tight (checked by assertion)
+ dim >= 1 (checked by assertion).
+ 
+ \post all constraints on the history clock have been removed from dbm: it may
+ take any value in [0, inf] (including undefined), and the other clocks are
+ unchanged
+ dbm is tight and consistent
+ */
+void eca_unbound_history(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::clock_id_t history_clock_id,
+                const std::unordered_set<int> &history_clock_ids,
+                const std::unordered_set<int> &prophecy_clock_ids, 
+                const std::unordered_set<int> &normal_clock_ids);
+
+/*!
+ \brief Projection of a DBM on a subset of its clocks
+ \param dbm : a dbm
+ \param dim : dimension of dbm
+ \param index : DBM indices of the kept clocks
+ \param pdim : number of kept clocks (dimension of pdbm)
+ \param pdbm : a dbm
+ \pre dbm and pdbm are not nullptr (checked by assertion)
+ dbm is a dim*dim array of difference bounds
+ pdbm is a pdim*pdim array of difference bounds
+ index is an array of pdim increasing DBM indices smaller than dim, with
+ index[0]=0 (reference clock) and index[1]=1 ("tmp" clock)
+ \post pdbm(i,j) = dbm(index[i],index[j]) for all 0 <= i,j < pdim
+ */
+void project(tchecker::dbm::db_t const * dbm, tchecker::clock_id_t dim, tchecker::clock_id_t const * index,
+             tchecker::clock_id_t pdim, tchecker::dbm::db_t * pdbm);
+
+/*!
+ \brief Expansion of a projected DBM over unbounded history clocks
+ \param dbm : a dbm
+ \param dim : dimension of dbm
+ \param pdbm : a dbm
+ \param index : DBM indices of the clocks of pdbm in dbm
+ \param pdim : dimension of pdbm
+ \pre dbm and pdbm are not nullptr (checked by assertion)
+ dbm is a dim*dim array of difference bounds
+ pdbm is a pdim*pdim array of difference bounds, tight and consistent
+ index is an array of pdim increasing DBM indices smaller than dim, with
+ index[0]=0 and index[1]=1
+ every clock of dbm which is not in index is a history clock that has been
+ unbounded by eca_unbound_history
+ \post dbm(index[i],index[j]) = pdbm(i,j) for all 0 <= i,j < pdim, and
+ dbm(index[i],h) = pdbm(i,0) for every i >= 2 and every clock h that is not in
+ index. Other entries are unchanged: the clocks that are not in index are still
+ unbounded, and dbm is tight and consistent
+ \note this takes time O(pdim*dim) while the clocks that are not in index do not
+ take part to the operations applied to pdbm
+ */
+void eca_expand(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::dbm::db_t const * pdbm,
+                tchecker::clock_id_t const * index, tchecker::clock_id_t pdim);
                 
 
 /*!
@@ -865,6 +1015,33 @@ void extra_lu(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::int
 void extra_lu_plus(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::integer_t const * l,
                    tchecker::integer_t const * u);
 
+/*!
+ \brief ExtraLU+ extrapolation of ECA DBMs
+ \param dbm : a dbm
+ \param dim : dimension of dbm
+ \param l : clock lower bounds for clocks 1 to dim-1 (l[0] is the bound for clock 1 and so on)
+ \param u : clock upper bounds for clocks 1 to dim-1 (u[0] is the bound for clock 1 and so on)
+ \pre dbm is not nullptr (checked by assertion)
+ dbm is a dim*dim array of difference bounds
+ dbm is consistent
+ dbm is tight (checked by assertion)
+ dim >= 1 (checked by assertion)
+ l and u are arrays of size dim-1
+ l[i], u[i] < tchecker::dbm::INF_VALUE for all i>=0 (checked by assertion)
+ \post extrapolation ExtraLU+ has been applied to the finite difference bounds
+ of dbm w.r.t. clock bounds l and u, and dbm has been tightened with
+ tchecker::dbm::eca_tighten. The bounds <inf, <=inf and <=-inf are left
+ unchanged, as well as the rows and columns of clocks that may be undefined
+ (i.e. DBM(x,0) or DBM(0,x) is <=inf), and of clocks x with l[x-1] and u[x-1]
+ equal to tchecker::dbm::MAX_VALUE: extrapolation does not change which history
+ and prophecy clocks are (possibly) undefined
+ \note set l[i]/u[i] to -tchecker::dbm::INF_VALUE if clock i has no lower/upper
+ bound, and both to tchecker::dbm::MAX_VALUE if the constraints on clock i shall
+ be kept unchanged (e.g. prophecy clocks)
+ */
+void eca_extra_lu_plus(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::integer_t const * l,
+                       tchecker::integer_t const * u);
+
 /*!
  \brief Checks inclusion w.r.t. abstraction aLU
  \param dbm1 : a first dbm
@@ -883,6 +1060,8 @@ void extra_lu_plus(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker
  \return true if dbm1 <= aLU(dbm2), false otherwise (see "Better abstractions for timed automata", Herbreteau, Srivathsan
  and Walukiewicz. Inf. Comput., 2016)
  \note set l[i]/u[i] to -tchecker::dbm::INF_VALUE if clock i has no lower/upper bound
+ \note rows are scanned with the kernel selected by tchecker::dbm::set_closure_kernel (see
+ tchecker::dbm::alu_row_witness)
  */
 bool is_alu_le(tchecker::dbm::db_t const * dbm1, tchecker::dbm::db_t const * dbm2, tchecker::clock_id_t dim,
                tchecker::integer_t const * l, tchecker::integer_t const * u);
@@ -0,0 +1,99 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_DBM_REDUCED_HH
+#define TCHECKER_DBM_REDUCED_HH
+
+#include <cstdint>
+#include <vector>
+
+#include "tchecker/basictypes.hh"
+#include "tchecker/dbm/db.hh"
+
+/*!
+ \file reduced.hh
+ \brief Reduced storage of DBMs as lists of constraints
+ \note A reduced DBM is a list of constraints (i.e. DBM entries) from which the
+ DBM is recovered by expansion. Tight DBMs with finite bounds and < infinity
+ only are reduced to their minimal constraint graph, following K. G. Larsen,
+ F. Larsson, P. Pettersson, W. Yi: "Efficient Verification of Real-Time
+ Systems: Compact Data Structure and State-Space Reduction", RTSS 1997. Other
+ DBMs (e.g. ECA DBMs with <= infinity bounds) are reduced to their bounded
+ entries. Reduced DBMs are meant for storage only: they are expanded to DBMs
+ before any computation
+ */
+
+namespace tchecker {
+
+namespace dbm {
+
+/*!
+ \brief Kind of reduction
+ */
+enum reduction_t {
+  REDUCTION_MINIMAL_GRAPH, /*!< Minimal constraint graph: expansion computes the tightening of the constraints */
+  REDUCTION_SPARSE,        /*!< Bounded entries: expansion fills the other entries with the unbounded bound */
+};
+
+/*!
+ \brief Constraint of a reduced DBM
+ */
+struct reduced_constraint_t {
+  std::uint32_t index;     /*!< Index i*dim+j of the constraint xi-xj # c in the DBM */
+  tchecker::dbm::db_t db;  /*!< Difference bound # c */
+};
+
+/*!
+ \brief Header of a reduced DBM
+ */
+struct reduced_header_t {
+  std::uint32_t count;                        /*!< Number of constraints */
+  enum tchecker::dbm::reduction_t reduction;  /*!< Kind of reduction */
+  tchecker::dbm::db_t unbounded;              /*!< Bound of the entries that are not constraints */
+};
+
+/*!
+ \brief Reduction of a DBM
+ \param dbm : a DBM
+ \param dim : dimension of dbm
+ \param header : header of the reduced DBM
+ \param constraints : constraints of the reduced DBM
+ \pre dbm is a dim*dim array of difference bounds, dim*dim fits in 32 bits
+ \post header and constraints are a reduced DBM that expands to dbm (see
+ tchecker::dbm::expand). constraints are sorted by increasing index.
+ header.reduction is tchecker::dbm::REDUCTION_MINIMAL_GRAPH if dbm is tight,
+ non-empty, and all its bounds are finite or < infinity, and constraints is the
+ minimal constraint graph of dbm. Otherwise, header.reduction is
+ tchecker::dbm::REDUCTION_SPARSE, header.unbounded is <= infinity if dbm has
+ some <= infinity bound and < infinity otherwise, and constraints are the
+ diagonal entries of dbm that differ from <= 0 and the other entries of dbm that
+ differ from header.unbounded
+ \note the minimal constraint graph is checked by expansion, which costs a
+ tightening of dbm
+ */
+void reduce(tchecker::dbm::db_t const * dbm, tchecker::clock_id_t dim, tchecker::dbm::reduced_header_t & header,
+            std::vector<tchecker::dbm::reduced_constraint_t> & constraints);
+
+/*!
+ \brief Expansion of a reduced DBM
+ \param dbm : a DBM
+ \param dim : dimension of dbm
+ \param header : header of a reduced DBM
+ \param constraints : constraints of a reduced DBM
+ \pre dbm is a dim*dim array of difference bounds, constraints has
+ header.count constraints, and (header, constraints) has been computed by
+ tchecker::dbm::reduce from a DBM of dimension dim
+ \post dbm is the DBM that has been reduced to header and constraints
+ */
+void expand(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::dbm::reduced_header_t const & header,
+            tchecker::dbm::reduced_constraint_t const * constraints);
+
+} // end of namespace dbm
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_DBM_REDUCED_HH
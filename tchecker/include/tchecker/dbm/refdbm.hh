@@ -337,6 +337,8 @@ bool is_am_le(tchecker::dbm::db_t const * rdbm1, tchecker::dbm::db_t const * rdb
  aLU(sync(local_time_elapse(rdbm2))), false otherwise
  \note set l[i]/u[i] to tchecker::clockbounds::NO_BOUND if clock i has no
  lower/upper bound
+ \note rows are scanned with the kernel selected by
+ tchecker::dbm::set_closure_kernel (see tchecker::dbm::alu_row_witness)
  */
 bool is_sync_alu_le(tchecker::dbm::db_t const * rdbm1, tchecker::dbm::db_t const * rdbm2,
                     tchecker::reference_clock_variables_t const & r, tchecker::integer_t const * l,
@@ -363,6 +365,28 @@ bool is_sync_alu_le(tchecker::dbm::db_t const * rdbm1, tchecker::dbm::db_t const
 bool is_sync_am_le(tchecker::dbm::db_t const * rdbm1, tchecker::dbm::db_t const * rdbm2,
                    tchecker::reference_clock_variables_t const & r, tchecker::integer_t const * m);
 
+/*!
+ \brief Checks G-simulation over synchronized valuations
+ \param rdbm1 : a first dbm
+ \param rdbm2 : a second dbm
+ \param r : reference clocks for rdbm1 and rdbm2
+ \param G : a set of diagonal constraints over system clocks
+ \param Gdf : a set of non-diagonal constraints over system clocks
+ \pre rdbm1 and rdbm2 are not nullptr (checked by assertion)
+ rdbm1 and rdbm2 are r.size()*r.size() arrays of difference bounds
+ rdbm1 and rdbm2 are consistent (checked by assertion)
+ rdbm1 and rdbm2 are positive (checked by assertion)
+ rdbm1 and rdbm2 are tight (checked by assertion)
+ \return true if sync(local_time_elapse(rdbm1)) <=_(G U Gdf)
+ sync(local_time_elapse(rdbm2)), false otherwise
+ \note the synchronized zones are translated to DBMs over system clocks (see
+ tchecker::refdbm::to_dbm) and compared with tchecker::dbm::is_g_le
+ */
+bool is_sync_g_le(tchecker::dbm::db_t const * rdbm1, tchecker::dbm::db_t const * rdbm2,
+                  tchecker::reference_clock_variables_t const & r,
+                  std::vector<tchecker::typed_diagonal_clkconstr_expression_t const *> & G,
+                  std::vector<tchecker::typed_simple_clkconstr_expression_t const *> const & Gdf);
+
 /*!
  \brief Hash function on DBMs with reference clocks
  \param rdbm : a DBM
@@ -522,10 +546,40 @@ enum tchecker::dbm::status_t bound_spread(tchecker::dbm::db_t * rdbm, tchecker::
  (tchecker::refdbm::is_empty_0() returns true)
  \return tchecker::dbm::EMPTY is the spread-bounded dbm is empty,
  tchecker::dbm::NON_EMPTY otherwise
+ \note rdbm is only tightened w.r.t. the reference clocks involved in a
+ difference bound that has been decreased
  */
 enum tchecker::dbm::status_t bound_spread(tchecker::dbm::db_t * rdbm, tchecker::reference_clock_variables_t const & r,
                                           tchecker::integer_t spread, boost::dynamic_bitset<> const & ref_clocks);
 
+/*!
+ \brief Bound the spread between reference clocks after some reference clocks
+ have been opened up
+ \param rdbm : a DBM
+ \param r : reference clocks for rdbm
+ \param spread : expected spread between reference clocks
+ \param opened : reference clocks opened up since the spread has been bounded
+ \pre rdbm is not nullptr (checked by assertion)
+ rdbm is a r.size()*r.size() array of difference bounds
+ rdbm is consistent (checked by assertion)
+ rdbm is tight (checked by assertion)
+ the size of opened is the number of reference clocks in r (checked by
+ assertion)
+ the difference t - t' between reference clocks t and t' is bounded by spread
+ for all t' not in opened (e.g. rdbm has been obtained from a spread-bounded DBM
+ by opening up the reference clocks in opened, then by operations that do not
+ relax constraints)
+ \post same as tchecker::refdbm::bound_spread(rdbm, r, spread)
+ \return tchecker::dbm::EMPTY is the spread-bounded dbm is empty,
+ tchecker::dbm::NON_EMPTY otherwise
+ \note only the columns of rdbm of reference clocks in opened are bounded, and
+ the other reference clocks are only used to tighten these columns. This is
+ cheaper than tchecker::refdbm::bound_spread when few reference clocks have been
+ opened up, e.g. after an asynchronous step
+ */
+enum tchecker::dbm::status_t incremental_bound_spread(tchecker::dbm::db_t * rdbm, tchecker::reference_clock_variables_t const & r,
+                                                      tchecker::integer_t spread, boost::dynamic_bitset<> const & opened);
+
 /*!
  \brief Reset a clock to its reference clock
  \param rdbm : a DBM
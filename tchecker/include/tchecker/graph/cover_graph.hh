@@ -12,6 +12,7 @@
 #include <vector>
 #include <iostream>
 
+#include "tchecker/utils/counters.hh"
 #include "tchecker/utils/iterator.hh"
 
 /*!
@@ -261,6 +262,7 @@ public:
    */
   bool is_covered(NODE_PTR const & n, NODE_PTR & covering_node) const
   {
+    TCHECKER_TIME(TIMER_IS_COVERED);
     tchecker::graph::cover::node_position_t position_in_table = compute_position_in_table(n);
     return is_covered(n, _nodes[position_in_table], covering_node);
   }
@@ -275,6 +277,7 @@ public:
    */
   template <class INSERTER> void covered_nodes(NODE_PTR const & n, INSERTER & ins) const
   {
+    TCHECKER_TIME(TIMER_COVERED_NODES);
     tchecker::graph::cover::node_position_t position_in_table = compute_position_in_table(n);
     covered_nodes(n, _nodes[position_in_table], ins);
   }
@@ -389,8 +392,11 @@ private:
    */
   bool is_covered(NODE_PTR const & n, nodes_container_t const & c, NODE_PTR & covering_node) const
   {
+    TCHECKER_COUNT(COVERING_CHECKS);
     for (NODE_PTR const & node : c) {
+      TCHECKER_COUNT(BUCKET_NODES_SCANNED);
       if ((n != node) && _node_le(n, node)) {
+        TCHECKER_COUNT(COVERING_CHECKS_SUCCEEDED);
         covering_node = node;
         return true;
       }
@@ -409,6 +415,8 @@ private:
    */
   template <class INSERTER> void covered_nodes(NODE_PTR const & n, nodes_container_t const & c, INSERTER & ins) const
   {
+    TCHECKER_COUNT(COVERED_NODES_CHECKS);
+    TCHECKER_COUNT_N(BUCKET_NODES_SCANNED, c.size());
     for (NODE_PTR const & node : c)
       if ((node != n) && _node_le(node, n))
         ins = node;
@@ -255,6 +255,12 @@ public:
     _edge_pool.destruct_all();
   }
 
+  /*!
+   \brief Accessor
+   \return Memory used by the nodes and edges of this graph (bytes)
+   */
+  std::size_t memsize() const { return _node_pool.memsize() + _edge_pool.memsize(); }
+
   /*!
   \brief Add a node
   \param args : arguments to a constructor of type NODE
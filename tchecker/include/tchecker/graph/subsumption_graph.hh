@@ -460,6 +460,12 @@ public:
    */
   std::size_t nodes_count() const { return _cover_graph.size(); }
 
+  /*!
+   \brief Accessor
+   \return Memory used by the nodes and edges of this graph (bytes)
+   */
+  std::size_t memsize() const { return _node_pool.memsize() + _edge_pool.memsize(); }
+
   /*!
    \brief Type of iterator on nodes
   */
@@ -169,7 +169,9 @@ using outgoing_edges_value_t = tchecker::ta::outgoing_edges_value_t;
  edges)
  \pre the source location in edges match the locations in vloc.
  No process has more than one edge in edges.
- The pid of every process in edges is less than the size of vloc
+ The pid of every process in edges is less than the size of vloc.
+ The spread of zone is bounded by spread (e.g. zone has been computed by
+ initial or next with the same spread)
  \post the locations in vloc have been updated to target locations of the
  processes involved in edges, and they have been left unchanged for the other
  processes.
@@ -422,6 +424,13 @@ public:
    */
   tchecker::ta::system_t const & system() const;
 
+  /*!
+   \brief Accessor
+   \return Memory used by the states and transitions allocated by this transition
+   system (bytes)
+   */
+  std::size_t memsize() const;
+
 private:
   std::shared_ptr<tchecker::ta::system_t const> _system;              /*!< System of timed processes */
   std::shared_ptr<tchecker::reference_clock_variables_t const> _r;    /*!< Reference clock variables */
@@ -156,6 +156,20 @@ bool operator<=(tchecker::refzg::state_t const & s1, tchecker::refzg::state_t co
 bool sync_alu_le(tchecker::refzg::state_t const & s1, tchecker::refzg::state_t const & s2,
                  tchecker::clockbounds::map_t const & l, tchecker::clockbounds::map_t const & u);
 
+/*!
+ \brief Sync G-simulation check
+ \param s1 : state
+ \param s2 : state
+ \param G : a vector of diagonal constraints
+ \param Gdf : a vector of non-diagonal constraints
+ \return true if s1 and s2 have the same tuple of locations and integer
+ variables valuation, and the synchronized zone in s1 is G-simulated by the
+ synchronized zone in s2, false otherwise
+*/
+bool sync_g_le(tchecker::refzg::state_t const & s1, tchecker::refzg::state_t const & s2,
+               std::vector<tchecker::typed_diagonal_clkconstr_expression_t const *> & G,
+               std::vector<tchecker::typed_simple_clkconstr_expression_t const *> const & Gdf);
+
 /*!
  \brief Hash
  \param s : state
@@ -10,6 +10,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "tchecker/basictypes.hh"
 #include "tchecker/clockbounds/clockbounds.hh"
@@ -134,6 +135,21 @@ public:
   bool sync_alu_le(tchecker::refzg::zone_t const & zone, tchecker::clockbounds::map_t const & l,
                    tchecker::clockbounds::map_t const & u) const;
 
+  /*!
+   \brief Checks G-simulation over synchronized valuations
+   \param zone : a zone
+   \param G : a vector of diagonal constraints
+   \param Gdf : a vector of non-diagonal constraints
+   \return true if sync(this zone) is (G U Gdf)-simulated by sync(zone), false
+   otherwise
+   \pre G and Gdf are constraints over system clocks
+   \note Two zones that do not share the same reference clocks are seen as
+   not simulated even if their reference clocks are identical
+   */
+  bool sync_g_le(tchecker::refzg::zone_t const & zone,
+                 std::vector<tchecker::typed_diagonal_clkconstr_expression_t const *> & G,
+                 std::vector<tchecker::typed_simple_clkconstr_expression_t const *> const & Gdf) const;
+
   /*!
    \brief Lexical ordering
    \param zone : a zone
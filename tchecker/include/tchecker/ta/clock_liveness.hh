@@ -0,0 +1,236 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_TA_CLOCK_LIVENESS_HH
+#define TCHECKER_TA_CLOCK_LIVENESS_HH
+
+#include <limits>
+#include <map>
+#include <memory>
+#include <unordered_set>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include "tchecker/basictypes.hh"
+#include "tchecker/dbm/dbm.hh"
+#include "tchecker/syncprod/vloc.hh"
+#include "tchecker/ta/system.hh"
+#include "tchecker/variables/clocks.hh"
+
+/*!
+ \file clock_liveness.hh
+ \brief Static liveness analysis of clocks in a system of timed processes
+ */
+
+namespace tchecker {
+
+namespace ta {
+
+/*!
+ \class clock_projection_t
+ \brief Map from the clocks of a dimension-reduced DBM to the clocks of a system
+
+ A projection keeps the reference clock, the "tmp" clock, and a subset of the
+ flattened clocks of a system, in increasing order. It is used to apply the zone
+ operations to DBMs restricted to the clocks that matter in a transition, the
+ other clocks being unbounded history clocks (see clock_liveness_t).
+*/
+class clock_projection_t {
+public:
+  /*!
+   \brief Value of position() for clocks that are not kept
+   */
+  static tchecker::clock_id_t const NO_POSITION = std::numeric_limits<tchecker::clock_id_t>::max();
+
+  /*!
+   \brief Constructor
+   \param system : a system of timed processes
+   \param clocks : set of clock identifiers
+   \pre clocks has size the number of flattened clocks in system
+   \post this projection keeps the reference clock, the "tmp" clock (clock 0) and
+   the clocks in clocks
+   */
+  clock_projection_t(tchecker::ta::system_t const & system, boost::dynamic_bitset<> const & clocks);
+
+  /*!
+   \brief Accessor
+   \return dimension of projected DBMs
+   */
+  inline tchecker::clock_id_t dim() const { return static_cast<tchecker::clock_id_t>(_index.size()); }
+
+  /*!
+   \brief Accessor
+   \return map from the indices of projected DBMs to the indices of full DBMs
+   (increasing, 0 and 1 first)
+   */
+  inline std::vector<tchecker::clock_id_t> const & index() const { return _index; }
+
+  /*!
+   \brief Accessor
+   \param i : index in a full DBM
+   \pre i is smaller than the dimension of full DBMs (checked by assertion)
+   \return index of i in projected DBMs, NO_POSITION if i is not kept
+   */
+  tchecker::clock_id_t position(tchecker::clock_id_t i) const;
+
+  /*!
+   \brief Translate a clock constraint
+   \param c : a clock constraint
+   \pre the clocks of c are kept by this projection (checked by assertion)
+   \return c over the clock identifiers of projected DBMs
+   */
+  tchecker::clock_constraint_t project(tchecker::clock_constraint_t const & c) const;
+
+  /*!
+   \brief Translate a clock reset
+   \param r : a clock reset
+   \pre the clocks of r are kept by this projection (checked by assertion)
+   \return r over the clock identifiers of projected DBMs
+   */
+  tchecker::clock_reset_t project(tchecker::clock_reset_t const & r) const;
+
+  /*!
+   \brief Accessors
+   \return indices of history/prophecy/normal clocks in projected DBMs
+   */
+  inline std::unordered_set<int> const & history_clock_ids() const { return _history_clock_ids; }
+  inline std::unordered_set<int> const & prophecy_clock_ids() const { return _prophecy_clock_ids; }
+  inline std::unordered_set<int> const & normal_clock_ids() const { return _normal_clock_ids; }
+
+  /*!
+   \brief Accessor
+   \return layout of clocks in projected DBMs, nullptr if clocks are not grouped
+   by kind (see tchecker::dbm::clock_layout_t)
+   */
+  inline tchecker::dbm::clock_layout_t const * clock_layout() const
+  {
+    return (_grouped_clocks ? &_clock_layout : nullptr);
+  }
+
+private:
+  /*!
+   \brief Translate a clock identifier
+   \param id : clock identifier
+   \return identifier of id in projected DBMs (tchecker::REFCLOCK_ID is kept)
+   */
+  tchecker::clock_id_t project(tchecker::clock_id_t id) const;
+
+  std::vector<tchecker::clock_id_t> _index;      /*!< Map : projected index -> index */
+  std::vector<tchecker::clock_id_t> _position;   /*!< Map : index -> projected index */
+  std::unordered_set<int> _history_clock_ids;    /*!< Projected indices of history clocks */
+  std::unordered_set<int> _prophecy_clock_ids;   /*!< Projected indices of prophecy clocks */
+  std::unordered_set<int> _normal_clock_ids;     /*!< Projected indices of normal clocks */
+  tchecker::dbm::clock_layout_t _clock_layout;   /*!< Layout of clocks in projected DBMs */
+  bool _grouped_clocks;                          /*!< _clock_layout is valid */
+};
+
+/*!
+ \class clock_liveness_t
+ \brief Live clocks in the locations of a system of timed processes
+
+ A clock is live in a location of a process if the process may read the clock
+ (in a guard, in the right-hand side of a statement, or in an invariant) from
+ this location before it writes it (reset or release). Live clocks are computed
+ by a backward fixpoint over the edges of each process.
+
+ A clock is inactive in a tuple of locations if it is live in none of the
+ locations: every process that will ever read the clock first writes it, hence
+ its current value has no influence on the future behaviour of the system.
+
+ Only history clocks are reported as inactive. Prophecy clocks are implicitly
+ read by time elapse (which keeps them non-positive) and by the acceptance
+ condition on zones, hence they are always considered live. The "tmp" clock
+ that is used as a separator in GTA programs is ignored.
+*/
+class clock_liveness_t {
+public:
+  /*!
+   \brief Constructor
+   \param system : a system of timed processes
+   \post live clocks have been computed for all locations in system
+   \note this keeps a reference on system
+   */
+  clock_liveness_t(tchecker::ta::system_t const & system);
+
+  /*!
+   \brief Copy constructor
+   */
+  clock_liveness_t(tchecker::ta::clock_liveness_t const &) = default;
+
+  /*!
+   \brief Move constructor
+   */
+  clock_liveness_t(tchecker::ta::clock_liveness_t &&) = default;
+
+  /*!
+   \brief Destructor
+   */
+  ~clock_liveness_t() = default;
+
+  /*!
+   \brief Assignment operator (deleted)
+   */
+  tchecker::ta::clock_liveness_t & operator=(tchecker::ta::clock_liveness_t const &) = delete;
+
+  /*!
+   \brief Move-assignment operator (deleted)
+   */
+  tchecker::ta::clock_liveness_t & operator=(tchecker::ta::clock_liveness_t &&) = delete;
+
+  /*!
+   \brief Accessor
+   \param id : location identifier
+   \pre id is a location identifier (checked by assertion)
+   \return set of clock identifiers that are live in location id
+   */
+  boost::dynamic_bitset<> const & live_clocks(tchecker::loc_id_t id) const;
+
+  /*!
+   \brief Compute inactive clocks
+   \param vloc : tuple of locations
+   \param inactive : a bitset
+   \post inactive has been resized to the number of clocks, and it contains
+   exactly the history clocks that are live in no location of vloc
+   */
+  void inactive_clocks(tchecker::vloc_t const & vloc, boost::dynamic_bitset<> & inactive) const;
+
+  /*!
+   \brief Accessor
+   \return true if every history clock is live in every location, false
+   otherwise
+   */
+  inline bool trivial() const { return _trivial; }
+
+  /*!
+   \brief Accessor
+   \param clocks : set of clock identifiers
+   \return the projection that keeps clocks (see clock_projection_t)
+   \note projections are memoised: the same projection is shared by all the
+   callers with the same set of clocks. This is not thread-safe
+   */
+  std::shared_ptr<tchecker::ta::clock_projection_t const> projection(boost::dynamic_bitset<> const & clocks) const;
+
+private:
+  /*!
+   \brief Compute live clocks of all locations
+   */
+  void compute_live_clocks();
+
+  tchecker::ta::system_t const & _system;      /*!< System of timed processes */
+  std::vector<boost::dynamic_bitset<>> _live;  /*!< Map : location ID -> live clocks */
+  boost::dynamic_bitset<> _history_clocks;     /*!< History clocks */
+  bool _trivial;                               /*!< No inactive history clock */
+  mutable std::map<boost::dynamic_bitset<>, std::shared_ptr<tchecker::ta::clock_projection_t const>>
+      _projections;                            /*!< Memoised projections */
+};
+
+} // end of namespace ta
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_TA_CLOCK_LIVENESS_HH
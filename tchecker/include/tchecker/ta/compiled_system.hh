@@ -0,0 +1,74 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_TA_COMPILED_SYSTEM_HH
+#define TCHECKER_TA_COMPILED_SYSTEM_HH
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+#include "tchecker/ta/system.hh"
+
+/*!
+ \file compiled_system.hh
+ \brief Binary files of compiled systems of timed processes
+ */
+
+namespace tchecker {
+
+namespace ta {
+
+/*!
+ \brief Version of the format of compiled systems
+ \note should be incremented each time the format, the typed expressions and
+ statements, or the bytecode, is modified
+ */
+std::uint32_t const COMPILED_SYSTEM_VERSION = 1;
+
+/*!
+ \brief Write a compiled system
+ \param os : output stream
+ \param system : a system of timed processes
+ \post system has been written to os in binary format: a header (magic number,
+ byte order and format version), the processes, variables, events, locations,
+ edges and synchronizations of system with their attributes, the kinds of clocks,
+ and the typed invariants, guards and statements of system along with their
+ bytecode
+ \note os should be opened in binary mode
+ \throw std::runtime_error : if writing to os fails
+ */
+void write_compiled_system(std::ostream & os, tchecker::ta::system_t const & system);
+
+/*!
+ \brief Write a compiled system to a file
+ \param filename : name of a file
+ \param system : a system of timed processes
+ \post system has been written to filename (see write_compiled_system above)
+ \throw std::runtime_error : if filename cannot be written
+ */
+void write_compiled_system(std::string const & filename, tchecker::ta::system_t const & system);
+
+/*!
+ \brief Load a compiled system
+ \param filename : name of a file written by write_compiled_system
+ \return the system of timed processes stored in filename
+ \note the file is memory-mapped. The system is built from the typed
+ expressions, statements and bytecode in filename: the attributes of the system
+ are neither parsed nor typechecked, nor compiled again
+ \note the returned pointer must be deleted by the caller
+ \throw std::runtime_error : if filename cannot be read, if it is not a compiled
+ system, if it has been written with another version of the format, or if it is
+ truncated or corrupted
+ */
+tchecker::ta::system_t * load_compiled_system(std::string const & filename);
+
+} // end of namespace ta
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_TA_COMPILED_SYSTEM_HH
@@ -0,0 +1,168 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_TA_INDEPENDENCE_HH
+#define TCHECKER_TA_INDEPENDENCE_HH
+
+#include <limits>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include "tchecker/basictypes.hh"
+#include "tchecker/syncprod/vloc.hh"
+#include "tchecker/ta/system.hh"
+
+/*!
+ \file independence.hh
+ \brief Static independence analysis of the edges of a system of timed processes,
+ and ample sets for partial-order reduction
+ */
+
+namespace tchecker {
+
+namespace ta {
+
+/*!
+ \class independence_t
+ \brief Static independence relation over the edges of a system of timed processes
+
+ For every edge, the analysis records the integer variables and the clocks that
+ are read (guard, right-hand sides of the statement, target invariant) and
+ written (left-hand sides of the statement) by the edge, and whether the edge is
+ asynchronous (i.e. its event does not appear in any synchronization vector).
+
+ Two edges are independent if they belong to distinct processes, they are both
+ asynchronous, and none of them writes an integer variable or a clock that is
+ read or written by the other one.
+
+ Independence w.r.t. variables is not sufficient to commute edges in a timed
+ setting, since time elapse is global. A location is an ample location if all
+ its outgoing edges are asynchronous, clock-free (the "tmp" prophecy clock that
+ is used as a separator in GTA programs is ignored), lead to a location that
+ is neither urgent nor committed, has no clock in its invariant and carries the
+ same labels, and do not share (written) integer variables with any other
+ process. Firing such an edge first commutes with every run of the other
+ processes and preserves reachability of location labels.
+*/
+class independence_t {
+public:
+  /*!
+   \brief Constructor
+   \param system : a system of timed processes
+   \post the independence relation over the edges of system has been computed
+   \note this keeps a reference on system
+   */
+  independence_t(tchecker::ta::system_t const & system);
+
+  /*!
+   \brief Copy constructor
+   */
+  independence_t(tchecker::ta::independence_t const &) = default;
+
+  /*!
+   \brief Move constructor
+   */
+  independence_t(tchecker::ta::independence_t &&) = default;
+
+  /*!
+   \brief Destructor
+   */
+  ~independence_t() = default;
+
+  /*!
+   \brief Assignment operator (deleted)
+   */
+  tchecker::ta::independence_t & operator=(tchecker::ta::independence_t const &) = delete;
+
+  /*!
+   \brief Move-assignment operator (deleted)
+   */
+  tchecker::ta::independence_t & operator=(tchecker::ta::independence_t &&) = delete;
+
+  /*!
+   \brief Value returned when no process provides an ample set
+   */
+  static constexpr tchecker::process_id_t const NO_PROCESS = std::numeric_limits<tchecker::process_id_t>::max();
+
+  /*!
+   \brief Accessor
+   \param id : edge identifier
+   \pre id is an edge identifier (checked by assertion)
+   \return true if edge id is asynchronous, false otherwise
+   */
+  bool is_asynchronous(tchecker::edge_id_t id) const;
+
+  /*!
+   \brief Accessor
+   \param id : edge identifier
+   \pre id is an edge identifier (checked by assertion)
+   \return true if edge id neither reads nor writes any clock, false otherwise
+   */
+  bool is_clock_free(tchecker::edge_id_t id) const;
+
+  /*!
+   \brief Static independence check
+   \param id1 : edge identifier
+   \param id2 : edge identifier
+   \pre id1 and id2 are edge identifiers (checked by assertion)
+   \return true if edges id1 and id2 are independent, false otherwise
+   */
+  bool independent(tchecker::edge_id_t id1, tchecker::edge_id_t id2) const;
+
+  /*!
+   \brief Accessor
+   \param id : location identifier
+   \pre id is a location identifier (checked by assertion)
+   \return true if location id is an ample location, false otherwise
+   */
+  bool is_ample_location(tchecker::loc_id_t id) const;
+
+  /*!
+   \brief Selection of an ample process
+   \param vloc : tuple of locations
+   \return the identifier of the process in vloc with an ample location and the
+   smallest number of outgoing edges (smallest identifier first), NO_PROCESS if
+   vloc has a committed location or no ample location
+   */
+  tchecker::process_id_t ample_process(tchecker::vloc_t const & vloc) const;
+
+  /*!
+   \brief Accessor
+   \return number of ample locations in the system
+   */
+  tchecker::loc_id_t ample_locations_count() const;
+
+private:
+  /*!
+   \brief Compute read and written variables of edges and processes
+   */
+  void compute_variables();
+
+  /*!
+   \brief Compute ample locations
+   \pre compute_variables() has been called
+   */
+  void compute_ample_locations();
+
+  tchecker::ta::system_t const & _system;                 /*!< System of timed processes */
+  std::vector<boost::dynamic_bitset<>> _edge_read_intvars;  /*!< Map : edge ID -> read integer variables */
+  std::vector<boost::dynamic_bitset<>> _edge_write_intvars; /*!< Map : edge ID -> written integer variables */
+  std::vector<boost::dynamic_bitset<>> _edge_read_clocks;   /*!< Map : edge ID -> read clocks */
+  std::vector<boost::dynamic_bitset<>> _edge_write_clocks;  /*!< Map : edge ID -> written clocks */
+  std::vector<boost::dynamic_bitset<>> _proc_read_intvars;  /*!< Map : process ID -> read integer variables */
+  std::vector<boost::dynamic_bitset<>> _proc_write_intvars; /*!< Map : process ID -> written integer variables */
+  boost::dynamic_bitset<> _asynchronous;                    /*!< Asynchronous edges */
+  boost::dynamic_bitset<> _ample;                           /*!< Ample locations */
+  std::vector<std::size_t> _out_degree;                     /*!< Map : location ID -> number of outgoing edges */
+};
+
+} // end of namespace ta
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_TA_INDEPENDENCE_HH
@@ -0,0 +1,162 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_TA_SYMMETRY_HH
+#define TCHECKER_TA_SYMMETRY_HH
+
+#include <string>
+#include <vector>
+
+#include "tchecker/basictypes.hh"
+#include "tchecker/dbm/db.hh"
+#include "tchecker/syncprod/vloc.hh"
+#include "tchecker/ta/system.hh"
+
+/*!
+ \file symmetry.hh
+ \brief Detection of identical processes and canonicalisation of states
+ */
+
+namespace tchecker {
+
+namespace ta {
+
+/*!
+ \class symmetry_t
+ \brief Symmetry classes of a system of timed processes
+
+ Two processes are symmetric if they are identical up to a renaming of their
+ local clocks (i.e. clocks that are not accessed by any other process): same
+ number of locations with same flags (initial, committed, urgent), same labels
+ and same invariants, and same edges (in declaration order) with same source and
+ target locations, same events, same guards and same statements. Moreover, the
+ set of synchronizations should be invariant w.r.t. swapping the two processes.
+ Integer variables are not renamed, hence they must be accessed the same way by
+ symmetric processes.
+
+ The processes of a symmetry class can be permuted in a state without changing
+ the set of reachable location labels. States are canonicalised by sorting the
+ processes of each class w.r.t. their location and the row/column of their local
+ clocks in the DBM, and by permuting the DBM accordingly.
+*/
+class symmetry_t {
+public:
+  /*!
+   \brief Constructor
+   \param system : a system of timed processes
+   \post the symmetry classes of system have been computed
+   \note this keeps a reference on system
+   */
+  symmetry_t(tchecker::ta::system_t const & system);
+
+  /*!
+   \brief Copy constructor
+   */
+  symmetry_t(tchecker::ta::symmetry_t const &) = default;
+
+  /*!
+   \brief Move constructor
+   */
+  symmetry_t(tchecker::ta::symmetry_t &&) = default;
+
+  /*!
+   \brief Destructor
+   */
+  ~symmetry_t() = default;
+
+  /*!
+   \brief Assignment operator (deleted)
+   */
+  tchecker::ta::symmetry_t & operator=(tchecker::ta::symmetry_t const &) = delete;
+
+  /*!
+   \brief Move-assignment operator (deleted)
+   */
+  tchecker::ta::symmetry_t & operator=(tchecker::ta::symmetry_t &&) = delete;
+
+  /*!
+   \brief Accessor
+   \return symmetry classes with at least two processes (process identifiers in
+   increasing order)
+   */
+  inline std::vector<std::vector<tchecker::process_id_t>> const & classes() const { return _classes; }
+
+  /*!
+   \brief Accessor
+   \return true if the system has no pair of symmetric processes, false otherwise
+   */
+  inline bool trivial() const { return _classes.empty(); }
+
+  /*!
+   \brief Canonicalisation
+   \param vloc : tuple of locations
+   \param dbm : a DBM
+   \param dim : dimension of dbm
+   \pre dbm is a dim*dim DBM over the flattened clocks of the system (plus the
+   reference clock 0)
+   \post the processes of each symmetry class have been permuted in vloc, and the
+   local clocks of permuted processes have been permuted in dbm accordingly, in
+   such a way that the processes in each class are sorted w.r.t. their location
+   and their local clocks bounds
+   \return true if vloc and dbm have been modified, false otherwise
+   */
+  bool canonicalize(tchecker::vloc_t & vloc, tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim) const;
+
+private:
+  /*!
+   \brief Compute the signature of a process
+   \param pid : process identifier
+   \return the textual representation of process pid where the local clocks are
+   renamed according to their rank in _local_clocks[pid]
+   */
+  std::string signature(tchecker::process_id_t pid) const;
+
+  /*!
+   \brief Check that synchronizations are invariant w.r.t. swapping two processes
+   \param pid1 : process identifier
+   \param pid2 : process identifier
+   \return true if swapping pid1 and pid2 maps every synchronization to a
+   synchronization, false otherwise
+   */
+  bool swappable_synchronizations(tchecker::process_id_t pid1, tchecker::process_id_t pid2) const;
+
+  /*!
+   \brief Compute local clocks and locations of processes
+   */
+  void compute_processes();
+
+  /*!
+   \brief Compute symmetry classes
+   \pre compute_processes() has been called
+   */
+  void compute_classes();
+
+  /*!
+   \brief Compare two processes of a symmetry class in a state
+   \param vloc : tuple of locations
+   \param dbm : a DBM
+   \param dim : dimension of dbm
+   \param pid1 : process identifier
+   \param pid2 : process identifier
+   \return <0 if pid1 is smaller than pid2 in vloc and dbm, 0 if they are equal
+   and >0 otherwise
+   */
+  int compare(tchecker::vloc_t const & vloc, tchecker::dbm::db_t const * dbm, tchecker::clock_id_t dim,
+              tchecker::process_id_t pid1, tchecker::process_id_t pid2) const;
+
+  tchecker::ta::system_t const & _system;                              /*!< System of timed processes */
+  std::vector<std::vector<tchecker::clock_id_t>> _local_clocks;        /*!< Map : process ID -> local clocks */
+  std::vector<std::vector<tchecker::loc_id_t>> _locations;             /*!< Map : process ID -> locations */
+  std::vector<std::size_t> _loc_rank;                                  /*!< Map : location ID -> rank in its process */
+  std::vector<std::vector<tchecker::process_id_t>> _classes;           /*!< Non-trivial symmetry classes */
+};
+
+} // end of namespace ta
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_TA_SYMMETRY_HH
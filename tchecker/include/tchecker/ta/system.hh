@@ -15,6 +15,7 @@
 #include <boost/dynamic_bitset/dynamic_bitset.hpp>
 
 #include "tchecker/basictypes.hh"
+#include "tchecker/dbm/dbm.hh"
 #include "tchecker/expression/typed_expression.hh"
 #include "tchecker/parsing/declaration.hh"
 #include "tchecker/statement/typed_statement.hh"
@@ -39,6 +40,22 @@ namespace ta {
  */
 class system_t : private tchecker::syncprod::system_t {
 public:
+  /*!
+   \brief Typed and compiled expression
+   */
+  struct compiled_expression_t {
+    std::shared_ptr<tchecker::typed_expression_t> _typed_expr; /*!< Typed expression */
+    std::shared_ptr<tchecker::bytecode_t> _compiled_expr;      /*!< Compiled expression */
+  };
+
+  /*!
+   \brief Typed and compiled statement
+   */
+  struct compiled_statement_t {
+    std::shared_ptr<tchecker::typed_statement_t> _typed_stmt; /*!< Typed statement */
+    std::shared_ptr<tchecker::bytecode_t> _compiled_stmt;     /*!< Compiled statement */
+  };
+
   /*!
    \brief Constructor
    \param sysdecl : system declaration
@@ -61,6 +78,24 @@ public:
    */
   system_t(tchecker::syncprod::system_t const & system);
 
+  /*!
+   \brief Constructor from precompiled invariants, guards and statements
+   \param system : system of processes
+   \param invariants : map location identifier -> typed and compiled invariant
+   \param guards : map edge identifier -> typed and compiled guard
+   \param statements : map edge identifier -> typed and compiled statement
+   \pre the typed expressions and statements have been obtained by typechecking
+   the attributes of system, and the bytecodes have been compiled from them (see
+   tchecker::ta::load_compiled_system)
+   \post this is a system of timed processes built from system with the given
+   invariants, guards and statements, which are neither parsed, nor typechecked,
+   nor compiled again
+   \throw std::invalid_argument : if the sizes of invariants, guards or statements
+   do not match system, or if some expression, statement or bytecode is missing
+   */
+  system_t(tchecker::system::system_t const & system, std::vector<compiled_expression_t> const & invariants,
+           std::vector<compiled_expression_t> const & guards, std::vector<compiled_statement_t> const & statements);
+
   /*!
    \brief Copy constructor
    */
@@ -116,6 +151,17 @@ public:
   std::unordered_set<int> history_clock_id_map;
   std::unordered_set<int> prophecy_clock_id_map;
   std::unordered_set<int> normal_clock_id_map;
+
+  /*!
+   \brief Accessor
+   \return layout of clocks in DBMs if the indices of normal, history and
+   prophecy clocks form contiguous ranges (see tchecker::dbm::clock_layout_t),
+   nullptr otherwise
+   */
+  inline tchecker::dbm::clock_layout_t const * clock_layout() const
+  {
+    return (_grouped_clocks ? &_clock_layout : nullptr);
+  }
   
   // std::unordered_set<int> &history_clock_id_map;
   // std::unordered_set<int> &prophecy_clock_id_map;
@@ -250,20 +296,13 @@ public:
 
 private:
   /*!
-   \brief Typed and compiled expression
-   */
-  struct compiled_expression_t {
-    std::shared_ptr<tchecker::typed_expression_t> _typed_expr; /*!< Typed expression */
-    std::shared_ptr<tchecker::bytecode_t> _compiled_expr;      /*!< Compiled expression */
-  };
-
-  /*!
-   \brief Typed and compiled statement
+   \brief Compute the sets of history, prophecy and normal clocks, and the layout
+   of clocks in DBMs
+   \post history_clock_id_map, prophecy_clock_id_map, normal_clock_id_map and
+   clock_layout() have been computed from history_clock_ids, prophecy_clock_ids
+   and normal_clock_ids
    */
-  struct compiled_statement_t {
-    std::shared_ptr<tchecker::typed_statement_t> _typed_stmt; /*!< Typed statement */
-    std::shared_ptr<tchecker::bytecode_t> _compiled_stmt;     /*!< Compiled statement */
-  };
+  void compute_clock_kinds();
 
   /*!
    \brief Compute data from syncprod::system_t
@@ -319,6 +358,8 @@ private:
   std::vector<compiled_expression_t> _guards;     /*!< Map : edge identifier -> guard */
   std::vector<compiled_statement_t> _statements;  /*!< Map : edge identifier -> statement */
   boost::dynamic_bitset<> _urgent;                /*!< Urgent locations */
+  tchecker::dbm::clock_layout_t _clock_layout;    /*!< Layout of clocks in DBMs */
+  bool _grouped_clocks{false};                    /*!< _clock_layout is valid */
 };
 
 } // end of namespace ta
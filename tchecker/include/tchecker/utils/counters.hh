@@ -0,0 +1,235 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_COUNTERS_HH
+#define TCHECKER_COUNTERS_HH
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <string>
+
+#include "tchecker/basictypes.hh"
+
+/*!
+ \file counters.hh
+ \brief Counters and sampled timers on the hot path of reachability algorithms
+ \note Counting is enabled by CMake option TCK_ENABLE_COUNTERS. The
+ TCHECKER_COUNT* and TCHECKER_TIME macros below expand to nothing otherwise, so
+ counters do not cost anything unless they are enabled
+ */
+
+namespace tchecker {
+
+namespace counters {
+
+/*!
+ \brief Counters
+ */
+enum counter_t {
+  COVERING_CHECKS = 0,       /*!< Number of checks whether a node is covered */
+  COVERING_CHECKS_SUCCEEDED, /*!< Number of checks that found a covering node */
+  COVERED_NODES_CHECKS,      /*!< Number of searches for the nodes covered by a node */
+  BUCKET_NODES_SCANNED,      /*!< Number of nodes compared by these checks and searches */
+  GSIM_SPLITS,               /*!< Number of splits w.r.t. a diagonal constraint in G-simulation checks */
+  ECA_TIGHTEN_CALLS,         /*!< Number of ECA tightenings of DBMs */
+  DBM_DIMENSION,             /*!< Maximal dimension of DBMs in computed states */
+  ZONE_EXPANSIONS,           /*!< Number of expansions of compact and reduced zones to scratch DBMs */
+  COUNTERS_COUNT,            /*!< Number of counters (not a counter) */
+};
+
+/*!
+ \brief Sampled timers
+ */
+enum timer_t {
+  TIMER_NEXT = 0,          /*!< Computation of successor states */
+  TIMER_IS_COVERED,        /*!< Checks whether a node is covered */
+  TIMER_COVERED_NODES,     /*!< Searches for the nodes covered by a node */
+  TIMER_ZONE_EXPANSION,    /*!< Expansions of compact and reduced zones to scratch DBMs */
+  TIMERS_COUNT,            /*!< Number of timers (not a timer) */
+};
+
+/*!
+ \brief Number of statuses of states counted by count_status
+ */
+unsigned int const STATUSES_COUNT = 14;
+
+/*!
+ \brief Sampling period of timers: one in TIMER_SAMPLING_PERIOD calls is timed
+ */
+unsigned long const TIMER_SAMPLING_PERIOD = 64;
+
+/*!
+ \brief Storage of counters and timers
+ \note counters are atomic so that instrumented functions can be called from
+ several threads. Relaxed increments are enough for statistics
+ */
+struct storage_t {
+  std::atomic<unsigned long> counters[tchecker::counters::COUNTERS_COUNT];    /*!< Counters */
+  std::atomic<unsigned long> statuses[tchecker::counters::STATUSES_COUNT];    /*!< Computed states per status */
+  std::atomic<unsigned long> timer_calls[tchecker::counters::TIMERS_COUNT];   /*!< Calls per timer */
+  std::atomic<unsigned long> timer_samples[tchecker::counters::TIMERS_COUNT]; /*!< Timed calls per timer */
+  std::atomic<unsigned long long> timer_nanoseconds[tchecker::counters::TIMERS_COUNT]; /*!< Time of timed calls */
+};
+
+/*!
+ \brief Global storage of counters and timers
+ */
+extern tchecker::counters::storage_t storage;
+
+/*!
+ \brief Increment a counter
+ \param c : a counter
+ \param n : increment
+ \post c has been incremented by n
+ */
+inline void increment(enum tchecker::counters::counter_t c, unsigned long n = 1)
+{
+  tchecker::counters::storage.counters[c].fetch_add(n, std::memory_order_relaxed);
+}
+
+/*!
+ \brief Update a counter with a maximum
+ \param c : a counter
+ \param n : a value
+ \post c is the maximum of its former value and n
+ */
+inline void maximize(enum tchecker::counters::counter_t c, unsigned long n)
+{
+  unsigned long current = tchecker::counters::storage.counters[c].load(std::memory_order_relaxed);
+  while (current < n && !tchecker::counters::storage.counters[c].compare_exchange_weak(current, n, std::memory_order_relaxed))
+    ;
+}
+
+/*!
+ \brief Count the status of a computed state
+ \param status : a status of state (see tchecker/basictypes.hh)
+ \post the counter of status has been incremented
+ */
+void count_status(tchecker::state_status_t status);
+
+/*!
+ \class sampled_timer_t
+ \brief Timer of one call in TIMER_SAMPLING_PERIOD, from construction to
+ destruction
+ */
+class sampled_timer_t {
+public:
+  /*!
+   \brief Constructor
+   \param timer : a timer
+   \post the call has been counted, and it is timed if it is sampled
+   */
+  explicit sampled_timer_t(enum tchecker::counters::timer_t timer)
+      : _timer(timer),
+        _sampled(tchecker::counters::storage.timer_calls[timer].fetch_add(1, std::memory_order_relaxed) %
+                     tchecker::counters::TIMER_SAMPLING_PERIOD ==
+                 0)
+  {
+    if (_sampled)
+      _start = std::chrono::steady_clock::now();
+  }
+
+  /*!
+   \brief Copy constructor (deleted)
+   */
+  sampled_timer_t(tchecker::counters::sampled_timer_t const &) = delete;
+
+  /*!
+   \brief Destructor
+   \post the duration of the call has been added to the timer if the call is
+   sampled
+   */
+  ~sampled_timer_t()
+  {
+    if (!_sampled)
+      return;
+    auto const duration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - _start);
+    tchecker::counters::storage.timer_samples[_timer].fetch_add(1, std::memory_order_relaxed);
+    tchecker::counters::storage.timer_nanoseconds[_timer].fetch_add(duration.count(), std::memory_order_relaxed);
+  }
+
+  /*!
+   \brief Assignment operator (deleted)
+   */
+  tchecker::counters::sampled_timer_t & operator=(tchecker::counters::sampled_timer_t const &) = delete;
+
+private:
+  enum tchecker::counters::timer_t const _timer;              /*!< Timer */
+  bool const _sampled;                                        /*!< Sampled call flag */
+  std::chrono::time_point<std::chrono::steady_clock> _start; /*!< Start time of sampled call */
+};
+
+/*!
+ \brief Reset all counters and timers
+ \post all counters and timers are 0
+ */
+void reset();
+
+/*!
+ \brief Extract counters and timers as attributes (key, value)
+ \param m : attributes map
+ \post every counter, every status of computed states that has been counted
+ (SUCCESSORS_<STATUS>), and the number of calls (TIMER_<NAME>_CALLS) and
+ estimated time in seconds (TIMER_<NAME>_SECONDS, extrapolated from the sampled
+ calls) of every timer have been added to m
+ */
+void attributes(std::map<std::string, std::string> & m);
+
+} // end of namespace counters
+
+} // end of namespace tchecker
+
+#if defined(TCHECKER_ENABLE_COUNTERS)
+
+#define TCHECKER_COUNTERS_CAT_IMPL(x, y) x##y
+#define TCHECKER_COUNTERS_CAT(x, y) TCHECKER_COUNTERS_CAT_IMPL(x, y)
+
+/*!
+ \brief Increment counter c (a tchecker::counters::counter_t without namespace)
+ */
+#define TCHECKER_COUNT(c) tchecker::counters::increment(tchecker::counters::c)
+
+/*!
+ \brief Increment counter c by n
+ */
+#define TCHECKER_COUNT_N(c, n) tchecker::counters::increment(tchecker::counters::c, (n))
+
+/*!
+ \brief Update counter c with maximum n
+ */
+#define TCHECKER_COUNT_MAX(c, n) tchecker::counters::maximize(tchecker::counters::c, (n))
+
+/*!
+ \brief Count state status s
+ */
+#define TCHECKER_COUNT_STATUS(s) tchecker::counters::count_status(s)
+
+/*!
+ \brief Time the end of the enclosing scope with sampled timer t (a
+ tchecker::counters::timer_t without namespace)
+ */
+#define TCHECKER_TIME(t)                                                                                                    \
+  tchecker::counters::sampled_timer_t TCHECKER_COUNTERS_CAT(tchecker_sampled_timer_, __LINE__) { tchecker::counters::t }
+
+/*!
+ \brief Reset counters
+ */
+#define TCHECKER_COUNTERS_RESET() tchecker::counters::reset()
+
+#else
+
+#define TCHECKER_COUNT(c)
+#define TCHECKER_COUNT_N(c, n)
+#define TCHECKER_COUNT_MAX(c, n)
+#define TCHECKER_COUNT_STATUS(s)
+#define TCHECKER_TIME(t)
+#define TCHECKER_COUNTERS_RESET()
+
+#endif // TCHECKER_ENABLE_COUNTERS
+
+#endif // TCHECKER_COUNTERS_HH
@@ -282,6 +282,12 @@ public:
    */
   inline constexpr std::size_t memsize() const { return (_blocks_count * _block_size); }
 
+  /*!
+   \brief Accessor
+   \return Size of chunks (i.e. memory allocated per object)
+   */
+  inline constexpr std::size_t chunk_size() const { return _alloc_size; }
+
 protected:
   /*!
    \brief Accessor to next chunk
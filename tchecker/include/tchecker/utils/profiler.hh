@@ -0,0 +1,137 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_PROFILER_HH
+#define TCHECKER_PROFILER_HH
+
+#include <chrono>
+#include <ctime>
+#include <map>
+#include <string>
+#include <vector>
+
+/*!
+ \file profiler.hh
+ \brief Profiling of the phases of a run
+ */
+
+namespace tchecker {
+
+/*!
+ \brief Accessor
+ \return the peak resident set size of the current process in kilobytes, 0 if
+ it is not available
+ */
+long peak_memory_kb();
+
+/*!
+ \class profiler_t
+ \brief Wall time, CPU time and memory of the successive phases of a run
+ (parsing, construction of the system, computation of clock bounds, exploration,
+ etc)
+ \note the memory of a phase is the growth of the peak resident set size during
+ the phase: a phase that allocates memory freed by a previous phase has no
+ growth. Hence, this is a lower bound on the memory used by the phase
+ */
+class profiler_t {
+public:
+  /*!
+   \class phase_t
+   \brief Measure of a phase: from construction to destruction
+   */
+  class phase_t {
+  public:
+    /*!
+     \brief Constructor
+     \param profiler : a profiler
+     \param name : name of the phase
+     \post the phase has started, and the peak memory at start has been
+     measured. Nothing is measured if profiler is nullptr
+     */
+    phase_t(tchecker::profiler_t * profiler, std::string const & name);
+
+    /*!
+     \brief Copy constructor (deleted)
+     */
+    phase_t(tchecker::profiler_t::phase_t const &) = delete;
+
+    /*!
+     \brief Move constructor (deleted)
+     */
+    phase_t(tchecker::profiler_t::phase_t &&) = delete;
+
+    /*!
+     \brief Destructor
+     \post the phase has been stopped (see stop)
+     */
+    ~phase_t();
+
+    /*!
+     \brief Assignment operator (deleted)
+     */
+    tchecker::profiler_t::phase_t & operator=(tchecker::profiler_t::phase_t const &) = delete;
+
+    /*!
+     \brief Move-assignment operator (deleted)
+     */
+    tchecker::profiler_t::phase_t & operator=(tchecker::profiler_t::phase_t &&) = delete;
+
+    /*!
+     \brief Stop the phase
+     \post the phase has been recorded in the profiler, unless it has already
+     been stopped
+     */
+    void stop();
+
+  private:
+    tchecker::profiler_t * _profiler;                                /*!< Profiler (nullptr once stopped) */
+    std::string const _name;                                         /*!< Name of the phase */
+    std::chrono::time_point<std::chrono::steady_clock> _start_time; /*!< Wall time at start */
+    std::clock_t _start_cpu_time;                                    /*!< CPU time at start */
+    long _start_peak_memory_kb;                                      /*!< Peak memory at start (kilobytes) */
+  };
+
+  /*!
+   \brief Record a phase
+   \param name : name of the phase
+   \param time : wall time of the phase (seconds)
+   \param cpu_time : CPU time of the phase (seconds)
+   \param peak_memory_growth_kb : growth of the peak memory during the phase
+   (kilobytes)
+   \post the phase has been recorded. If a phase with the same name has already
+   been recorded, time, cpu_time and peak_memory_growth_kb are added to it
+   */
+  void record(std::string const & name, double time, double cpu_time, long peak_memory_growth_kb);
+
+  /*!
+   \brief Extract statistics as attributes (key, value)
+   \param m : attributes map
+   \post for each recorded phase NAME, TIME_NAME (wall time in seconds),
+   CPU_TIME_NAME (CPU time in seconds) and MEMORY_PEAK_GROWTH_NAME (growth of
+   the peak memory during the phase, in kilobytes) have been added to m, as well
+   as MEMORY_PEAK (current peak memory in kilobytes)
+   \note CPU time accounts for all the threads of the process
+   */
+  void attributes(std::map<std::string, std::string> & m) const;
+
+private:
+  /*!
+   \brief Recorded phase
+   */
+  struct record_t {
+    std::string _name;            /*!< Name of the phase */
+    double _time;                 /*!< Wall time (seconds) */
+    double _cpu_time;             /*!< CPU time (seconds) */
+    long _peak_memory_growth_kb;  /*!< Growth of the peak memory during the phase (kilobytes) */
+  };
+
+  std::vector<record_t> _records; /*!< Recorded phases (in order) */
+};
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_PROFILER_HH
@@ -123,6 +123,26 @@ std::ostream & output(std::ostream & os, tchecker::bytecode_t const * bytecode);
  */
 std::size_t output_instruction(std::ostream & os, tchecker::bytecode_t const * bytecode);
 
+/*!
+ \brief Size of bytecode
+ \param bytecode : sequence of bytecode intructions
+ \pre bytecode is null-terminated (i.e. RET terminated), and well-formed
+ (i.e. instructions have the expected parameters)
+ \return the number of tchecker::bytecode_t in the sequence of instructions from
+ bytecode to null (included)
+ */
+std::size_t bytecode_size(tchecker::bytecode_t const * bytecode);
+
+/*!
+ \brief Check bytecode
+ \param bytecode : array of bytecode
+ \param size : size of bytecode
+ \return true if bytecode[0..size-1] is a sequence of valid instructions with
+ their parameters, that ends with the first (and only) null instruction (i.e.
+ RET), false otherwise
+ */
+bool is_bytecode(tchecker::bytecode_t const * bytecode, std::size_t size);
+
 // Virtual machine (VM)
 
 /*!
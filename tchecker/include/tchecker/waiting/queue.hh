@@ -39,6 +39,12 @@ public:
    */
   virtual inline bool empty() { return _dq.empty(); }
 
+  /*!
+   \brief Accessor
+   \return number of elements in the queue
+   */
+  virtual inline std::size_t size() { return _dq.size(); }
+
   /*!
    \brief Clear the container
    \post this container is empty
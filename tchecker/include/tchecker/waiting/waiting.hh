@@ -9,6 +9,7 @@
 #define TCHECKER_WAITING_HH
 
 #include <cassert>
+#include <cstddef>
 
 /*!
  \file waiting.hh
@@ -45,6 +46,14 @@ public:
    */
   virtual bool empty() = 0;
 
+  /*!
+   \brief Accessor
+   \return number of elements in the container
+   \note this method is not marked const to allow implementations that update
+   the container (see tchecker::waiting::fast_remove_waiting_t)
+   */
+  virtual std::size_t size() = 0;
+
   /*!
    \brief Clear the container
    \post this container is empty
@@ -166,6 +175,19 @@ public:
     return _w.empty();
   }
 
+  /*!
+   \brief Accessor
+   \return number of elements in the container
+   \note elements that have been removed (see remove) but not yet dropped from
+   the underlying container are counted, hence the returned value is an upper
+   bound on the number of waiting elements
+   */
+  virtual std::size_t size()
+  {
+    remove_non_waiting_first();
+    return _w.size();
+  }
+
   /*!
    \brief Clear the container
    \post this container is empty
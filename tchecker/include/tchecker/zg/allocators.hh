@@ -8,7 +8,13 @@
 #ifndef TCHECKER_ZG_ALLOCATORS_HH
 #define TCHECKER_ZG_ALLOCATORS_HH
 
+#include <algorithm>
+#include <map>
+#include <memory>
 #include <type_traits>
+#include <vector>
+
+#include "tchecker/dbm/reduced.hh"
 
 #include "tchecker/ta/allocators.hh"
 #include "tchecker/zg/state.hh"
@@ -67,7 +73,10 @@ public:
       : tchecker::ta::details::state_pool_allocator_t<STATE>(state_alloc_nb, vloc_alloc_nb, vloc_capacity, intval_alloc_nb,
                                                              intval_capacity),
         _zone_dimension(zone_dimension),
-        _zone_pool(zone_alloc_nb, tchecker::allocation_size_t<tchecker::zg::shared_zone_t>::alloc_size(_zone_dimension))
+        _zone_pool(zone_alloc_nb, tchecker::allocation_size_t<tchecker::zg::shared_zone_t>::alloc_size(_zone_dimension)),
+        _compact_zone_pool(zone_alloc_nb, tchecker::allocation_size_t<tchecker::zg::shared_zone_t>::alloc_size(
+                                              _zone_dimension, tchecker::zg::ZONE_COMPACT)),
+        _zone_alloc_nb(zone_alloc_nb)
   {
   }
 
@@ -118,6 +127,83 @@ public:
     return tchecker::zg::details::state_pool_allocator_t<STATE>::construct_from_state(s);
   }
 
+  /*!
+   \brief Compact the zone of a state
+   \param p : pointer to state
+   \pre p has been constructed by this allocator
+   \pre p is not nullptr
+   \post the zone in p has been replaced by a compact copy if it has a compact
+   encoding (see tchecker::zg::is_compactable) and if p is the only pointer to
+   its zone. p is unchanged otherwise
+   \return true if the zone in p is compact, false otherwise
+   */
+  bool compact(tchecker::intrusive_shared_ptr_t<STATE> & p)
+  {
+    tchecker::intrusive_shared_ptr_t<tchecker::zg::shared_zone_t> & zone_ptr = p->zone_ptr();
+
+    if (zone_ptr->is_compact())
+      return true;
+    if (zone_ptr->refcount() != 1 || !tchecker::zg::is_compactable(*zone_ptr))
+      return false;
+
+    tchecker::intrusive_shared_ptr_t<tchecker::zg::shared_zone_t> full_zone_ptr = zone_ptr;
+    zone_ptr = _compact_zone_pool.construct(*full_zone_ptr, tchecker::zg::ZONE_COMPACT);
+    _zone_pool.destruct(full_zone_ptr);
+    return true;
+  }
+
+  /*!
+   \brief Reduce the zone of a state
+   \param p : pointer to state
+   \pre p has been constructed by this allocator
+   \pre p is not nullptr
+   \post the zone in p has been replaced by a reduced copy (see
+   tchecker::dbm::reduce) if it is full, if p is the only pointer to its zone,
+   and if the reduced copy takes less memory than the zone. p is unchanged
+   otherwise
+   \return true if the zone in p is reduced, false otherwise
+   \note reduced zones are allocated from pools of increasing capacities of
+   constraints, which are created on demand
+   */
+  bool reduce(tchecker::intrusive_shared_ptr_t<STATE> & p)
+  {
+    thread_local std::vector<tchecker::dbm::reduced_constraint_t> constraints;
+
+    tchecker::intrusive_shared_ptr_t<tchecker::zg::shared_zone_t> & zone_ptr = p->zone_ptr();
+
+    if (zone_ptr->is_reduced())
+      return true;
+    if (zone_ptr->refcount() != 1 || !zone_ptr->is_full())
+      return false;
+
+    tchecker::dbm::reduced_header_t header;
+    tchecker::dbm::reduce(zone_ptr->dbm(), static_cast<tchecker::clock_id_t>(_zone_dimension), header, constraints);
+    std::size_t const capacity = reduced_capacity(header.count);
+    if (reduced_zone_alloc_size(capacity) >= _zone_pool.chunk_size())
+      return false;
+
+    tchecker::intrusive_shared_ptr_t<tchecker::zg::shared_zone_t> full_zone_ptr = zone_ptr;
+    zone_ptr = reduced_zone_pool(capacity).construct(static_cast<tchecker::clock_id_t>(_zone_dimension), header,
+                                                     static_cast<tchecker::dbm::reduced_constraint_t const *>(constraints.data()));
+    _zone_pool.destruct(full_zone_ptr);
+    return true;
+  }
+
+  /*!
+   \brief Accessor
+   \param zone : a zone
+   \pre zone has been allocated by this allocator
+   \return Memory allocated for zone (bytes)
+   */
+  std::size_t zone_memsize(tchecker::zg::zone_t const & zone) const
+  {
+    if (zone.is_compact())
+      return _compact_zone_pool.chunk_size();
+    if (zone.is_reduced())
+      return reduced_zone_alloc_size(reduced_capacity(zone.reduced_count()));
+    return _zone_pool.chunk_size();
+  }
+
   /*!
    \brief Destruct state
    \param p : pointer to state
@@ -138,7 +224,12 @@ public:
     if (!tchecker::ta::details::state_pool_allocator_t<STATE>::destruct(p))
       return false;
 
-    _zone_pool.destruct(zone_ptr);
+    if (zone_ptr->is_compact())
+      _compact_zone_pool.destruct(zone_ptr);
+    else if (zone_ptr->is_reduced())
+      reduced_zone_pool(reduced_capacity(zone_ptr->reduced_count())).destruct(zone_ptr);
+    else
+      _zone_pool.destruct(zone_ptr);
 
     return true;
   }
@@ -151,6 +242,9 @@ public:
   {
     tchecker::ta::details::state_pool_allocator_t<STATE>::collect();
     _zone_pool.collect();
+    _compact_zone_pool.collect();
+    for (auto && [capacity, pool] : _reduced_zone_pools)
+      pool->collect();
   }
 
   /*!
@@ -164,13 +258,23 @@ public:
   {
     tchecker::ta::details::state_pool_allocator_t<STATE>::destruct_all();
     _zone_pool.destruct_all();
+    _compact_zone_pool.destruct_all();
+    for (auto && [capacity, pool] : _reduced_zone_pools)
+      pool->destruct_all();
   }
 
   /*!
    \brief Accessor
    \return Memory used by this state allocator
    */
-  std::size_t memsize() const { return tchecker::ta::details::state_pool_allocator_t<STATE>::memsize() + _zone_pool.memsize(); }
+  std::size_t memsize() const
+  {
+    std::size_t size = tchecker::ta::details::state_pool_allocator_t<STATE>::memsize() + _zone_pool.memsize() +
+                       _compact_zone_pool.memsize();
+    for (auto && [capacity, pool] : _reduced_zone_pools)
+      size += pool->memsize();
+    return size;
+  }
 
 protected:
   /*!
@@ -185,8 +289,52 @@ protected:
                                                                                       args...);
   }
 
-  std::size_t _zone_dimension;                              /*!< Dimension of allocated zones */
-  tchecker::pool_t<tchecker::zg::shared_zone_t> _zone_pool; /*!< Pool of zones */
+  /*!
+   \brief Capacity of reduced zones
+   \param count : number of constraints
+   \return the least capacity of reduced zones that is at least count. Capacities
+   are multiples of 4 that grow by a quarter at least, hence reduced zones waste
+   at most a fifth of their memory
+   */
+  static std::size_t reduced_capacity(std::size_t count)
+  {
+    std::size_t capacity = 4;
+    while (capacity < count)
+      capacity += std::max<std::size_t>(4, (capacity / 16) * 4);
+    return capacity;
+  }
+
+  /*!
+   \brief Accessor
+   \param capacity : capacity of reduced zones
+   \return Allocation size of shared reduced zones with capacity constraints
+   */
+  std::size_t reduced_zone_alloc_size(std::size_t capacity) const
+  {
+    return _zone_pool.chunk_size() - tchecker::allocation_size_t<tchecker::zg::zone_t>::alloc_size(
+                                         static_cast<tchecker::clock_id_t>(_zone_dimension)) +
+           tchecker::allocation_size_t<tchecker::zg::zone_t>::reduced_alloc_size(capacity);
+  }
+
+  /*!
+   \brief Accessor
+   \param capacity : capacity of reduced zones
+   \return Pool of reduced zones with capacity constraints, created if needed
+   */
+  tchecker::pool_t<tchecker::zg::shared_zone_t> & reduced_zone_pool(std::size_t capacity)
+  {
+    std::unique_ptr<tchecker::pool_t<tchecker::zg::shared_zone_t>> & pool = _reduced_zone_pools[capacity];
+    if (pool.get() == nullptr)
+      pool.reset(new tchecker::pool_t<tchecker::zg::shared_zone_t>(_zone_alloc_nb, reduced_zone_alloc_size(capacity)));
+    return *pool;
+  }
+
+  std::size_t _zone_dimension;                                      /*!< Dimension of allocated zones */
+  tchecker::pool_t<tchecker::zg::shared_zone_t> _zone_pool;         /*!< Pool of zones */
+  tchecker::pool_t<tchecker::zg::shared_zone_t> _compact_zone_pool; /*!< Pool of compact zones */
+  std::size_t _zone_alloc_nb;                                       /*!< Number of zones allocated in one block */
+  std::map<std::size_t, std::unique_ptr<tchecker::pool_t<tchecker::zg::shared_zone_t>>>
+      _reduced_zone_pools; /*!< Pools of reduced zones (indexed by capacity) */
 };
 
 /*!
@@ -257,6 +257,33 @@ public:
   virtual void extrapolate(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::vloc_t const & vloc);
 };
 
+/*!
+ \class local_eca_extra_lu_plus_t
+ \brief ExtraLU+ zone extrapolation of ECA zones with local LU clock bounds
+ \note meant for clock bounds computed from a reduced A-map (see
+ tchecker::eca_amap_gen2::compute_local_lu_map)
+ */
+class local_eca_extra_lu_plus_t final : public tchecker::zg::details::local_lu_extrapolation_t {
+public:
+  using tchecker::zg::details::local_lu_extrapolation_t::local_lu_extrapolation_t;
+
+  /*!
+  \brief Destructor
+  */
+  virtual ~local_eca_extra_lu_plus_t() = default;
+
+  /*!
+  \brief Zone extrapolation
+  \param dbm : a dbm
+  \param dim : dimension of dbm
+  \param vloc : a tuple of locations
+  \pre dim is 1 plus the number of clocks in the local LU clock bounds map (checked by assertion)
+  \post ExtraLU+ has been applied to dbm with local LU clock bounds in vloc
+  (see tchecker::dbm::eca_extra_lu_plus)
+ */
+  virtual void extrapolate(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::vloc_t const & vloc);
+};
+
 namespace details {
 
 /*!
@@ -458,6 +485,7 @@ enum extrapolation_type_t {
   EXTRA_M_LOCAL,        /*!< see tchecker::zg::local_extra_m_t */
   EXTRA_M_PLUS_GLOBAL,  /*!< see tchecker::zg::global_extra_m_plus_t */
   EXTRA_M_PLUS_LOCAL,   /*!< see tchecker::zg::local_extra_m_plus_t */
+  EXTRA_LU_PLUS_LOCAL_ECA, /*!< see tchecker::zg::local_eca_extra_lu_plus_t */
 };
 
 /*!
@@ -485,6 +513,21 @@ tchecker::zg::extrapolation_t * extrapolation_factory(enum extrapolation_type_t
 tchecker::zg::extrapolation_t * extrapolation_factory(enum extrapolation_type_t extrapolation_type,
                                                       tchecker::clockbounds::clockbounds_t const & clock_bounds);
 
+/*!
+ \brief Zone extrapolation factory
+ \param extrapolation_type : type of extrapolation
+ \param system : system of timed processes
+ \param amap : reduced A-map for system
+ \return a zone extrapolation of type extrapolation_type using clock bounds
+ computed from amap (see tchecker::eca_amap_gen2::compute_local_lu_map)
+ \note the returned extrapolation must be deallocated by the caller
+ \throw std::invalid_argument : if extrapolation_type is neither
+ tchecker::zg::NO_EXTRAPOLATION nor tchecker::zg::EXTRA_LU_PLUS_LOCAL_ECA
+ */
+tchecker::zg::extrapolation_t * extrapolation_factory(enum extrapolation_type_t extrapolation_type,
+                                                      tchecker::ta::system_t const & system,
+                                                      tchecker::eca_amap_gen2::eca_a_map_t const & amap);
+
 } // end of namespace zg
 
 } // end of namespace tchecker
@@ -8,8 +8,11 @@
 #ifndef TCHECKER_ZG_SEMANTICS_HH
 #define TCHECKER_ZG_SEMANTICS_HH
 
+#include <boost/dynamic_bitset.hpp>
+
 #include "tchecker/basictypes.hh"
 #include "tchecker/dbm/db.hh"
+#include "tchecker/dbm/dbm.hh"
 #include "tchecker/variables/clocks.hh"
 #include <unordered_set>
 
@@ -39,6 +42,8 @@ public:
   \param dim : dimension of dbm
   \param delay_allowed : true if delay is allowed in initial state
   \param invariant : invariant
+  \param layout : layout of clocks in dbm, nullptr if clocks are not grouped by
+  kind (see tchecker::dbm::clock_layout_t)
   \post dbm is the initial zone w.r.t. delay_allowed and invariant
   \return STATE_OK if the resulting dbm is not empty, other values if the
   resulting dbm is empty (see details in implementations)
@@ -47,7 +52,8 @@ public:
                                            tchecker::clock_constraint_container_t const & invariant,
                                                       const std::unordered_set<int> & history_clock_ids,
                                                       const std::unordered_set<int> & prophecy_clock_ids,
-                                                      const std::unordered_set<int> & normal_clock_ids) = 0;
+                                                      const std::unordered_set<int> & normal_clock_ids,
+                                                      tchecker::dbm::clock_layout_t const * layout) = 0;
 
   
   /*!
@@ -60,6 +66,8 @@ public:
   \param clkreset : transition reset
   \param tgt_delay_allowed : true if delay allowed in target state
   \param tgt_invariant : invariant in target state
+  \param layout : layout of clocks in dbm, nullptr if clocks are not grouped by
+  kind (see tchecker::dbm::clock_layout_t)
   \post dbm has been updated to its strongest postcondition w.r.t. src_delay_allowed,
   src_invariant, guard, clkreset, tgt_delay_allowed and tgt_invariant
   \return STATE_OK if the resulting dbm is not empty, other values if the resulting
@@ -72,22 +80,42 @@ public:
                                         tchecker::clock_constraint_container_t const & tgt_invariant,
                                         const std::unordered_set<int> & history_clock_ids,
                                         const std::unordered_set<int> & prophecy_clock_ids,
-                                        const std::unordered_set<int> & normal_clock_ids) = 0;
+                                        const std::unordered_set<int> & normal_clock_ids,
+                                        tchecker::dbm::clock_layout_t const * layout) = 0;
   
   /*!
   \brief Determine if current zone can be a final zone
   \param dbm : a DBM
   \param dim : dimension of dbm
+  \param layout : layout of clocks in dbm, nullptr if clocks are not grouped by
+  kind (see tchecker::dbm::clock_layout_t)
   \return TRUE if and only if zone given by dbm is a final zone
    */
   virtual bool is_final_dbm(tchecker::dbm::db_t const * dbm, tchecker::clock_id_t dim,
                                         const std::unordered_set<int> & history_clock_ids,
                                         const std::unordered_set<int> & prophecy_clock_ids,
-                                        const std::unordered_set<int> & normal_clock_ids)
+                                        const std::unordered_set<int> & normal_clock_ids,
+                                        tchecker::dbm::clock_layout_t const * layout)
                                         {
                                           return true;
                                         }
 
+  /*!
+  \brief Normalise inactive clocks
+  \param dbm : a DBM
+  \param dim : dimension of dbm
+  \param inactive_clocks : set of clock identifiers that are not read before
+  they are written in the future
+  \post dbm is unchanged (the values of inactive clocks are kept)
+   */
+  virtual void normalize(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim,
+                         boost::dynamic_bitset<> const & inactive_clocks,
+                         const std::unordered_set<int> & history_clock_ids,
+                         const std::unordered_set<int> & prophecy_clock_ids,
+                         const std::unordered_set<int> & normal_clock_ids)
+                         {
+                         }
+
 };
 
 /*!
@@ -117,7 +145,8 @@ public:
                                            tchecker::clock_constraint_container_t const & invariant,
                                                       const std::unordered_set<int> & history_clock_ids,
                                                       const std::unordered_set<int> & prophecy_clock_ids,
-                                                      const std::unordered_set<int> & normal_clock_ids);
+                                                      const std::unordered_set<int> & normal_clock_ids,
+                                                      tchecker::dbm::clock_layout_t const * layout);
 
 
   /*!
@@ -147,7 +176,8 @@ public:
                                         tchecker::clock_constraint_container_t const & tgt_invariant,
                                         const std::unordered_set<int> & history_clock_ids,
                                         const std::unordered_set<int> & prophecy_clock_ids,
-                                        const std::unordered_set<int> & normal_clock_ids);
+                                        const std::unordered_set<int> & normal_clock_ids,
+                                        tchecker::dbm::clock_layout_t const * layout);
 
   /*!
   \brief Determine if current zone can be a final zone
@@ -158,7 +188,8 @@ public:
   virtual bool is_final_dbm(tchecker::dbm::db_t const * dbm, tchecker::clock_id_t dim,
                                         const std::unordered_set<int> & history_clock_ids,
                                         const std::unordered_set<int> & prophecy_clock_ids,
-                                        const std::unordered_set<int> & normal_clock_ids);
+                                        const std::unordered_set<int> & normal_clock_ids,
+                                        tchecker::dbm::clock_layout_t const * layout);
 };
 
 /*!
@@ -190,7 +221,8 @@ public:
                                            tchecker::clock_constraint_container_t const & invariant,
                                                       const std::unordered_set<int> & history_clock_ids,
                                                       const std::unordered_set<int> & prophecy_clock_ids,
-                                                      const std::unordered_set<int> & normal_clock_ids);
+                                                      const std::unordered_set<int> & normal_clock_ids,
+                                                      tchecker::dbm::clock_layout_t const * layout);
 
   /*!
   \brief Compute next zone
@@ -219,7 +251,8 @@ public:
                                         tchecker::clock_constraint_container_t const & tgt_invariant,
                                         const std::unordered_set<int> & history_clock_ids,
                                         const std::unordered_set<int> & prophecy_clock_ids,
-                                        const std::unordered_set<int> & normal_clock_ids);
+                                        const std::unordered_set<int> & normal_clock_ids,
+                                        tchecker::dbm::clock_layout_t const * layout);
   
   /*!
   \brief Determine if current zone can be a final zone
@@ -230,7 +263,8 @@ public:
   virtual bool is_final_dbm(tchecker::dbm::db_t const * dbm, tchecker::clock_id_t dim,
                                         const std::unordered_set<int> & history_clock_ids,
                                         const std::unordered_set<int> & prophecy_clock_ids,
-                                        const std::unordered_set<int> & normal_clock_ids);
+                                        const std::unordered_set<int> & normal_clock_ids,
+                                        tchecker::dbm::clock_layout_t const * layout);
 };
 
 
@@ -266,7 +300,8 @@ public:
                                             tchecker::clock_constraint_container_t const & invariant,
                                             const std::unordered_set<int> & history_clock_ids,
                                             const std::unordered_set<int> & prophecy_clock_ids,
-                                            const std::unordered_set<int> & normal_clock_ids);
+                                            const std::unordered_set<int> & normal_clock_ids,
+                                            tchecker::dbm::clock_layout_t const * layout);
 
   /*!
   \brief Compute next zone
@@ -296,8 +331,8 @@ public:
                                         tchecker::clock_constraint_container_t const & tgt_invariant,
                                         const std::unordered_set<int> & history_clock_ids,
                                         const std::unordered_set<int> & prophecy_clock_ids,
-                                        const std::unordered_set<int> & normal_clock_ids
-                                        );
+                                        const std::unordered_set<int> & normal_clock_ids,
+                                        tchecker::dbm::clock_layout_t const * layout);
 
 /*!
   \brief Determine if current zone can be a final zone
@@ -308,7 +343,24 @@ public:
   virtual bool is_final_dbm(tchecker::dbm::db_t const * dbm, tchecker::clock_id_t dim,
                                         const std::unordered_set<int> & history_clock_ids,
                                         const std::unordered_set<int> & prophecy_clock_ids,
-                                        const std::unordered_set<int> & normal_clock_ids);
+                                        const std::unordered_set<int> & normal_clock_ids,
+                                        tchecker::dbm::clock_layout_t const * layout);
+
+  /*!
+  \brief Normalise inactive clocks
+  \param dbm : a DBM
+  \param dim : dimension of dbm
+  \param inactive_clocks : set of clock identifiers that are not read before
+  they are written in the future
+  \post every inactive history clock has been unbounded in dbm (see
+  tchecker::dbm::eca_unbound_history), so that zones that only differ on
+  inactive clocks become equal. Other clocks are unchanged
+   */
+  virtual void normalize(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim,
+                         boost::dynamic_bitset<> const & inactive_clocks,
+                         const std::unordered_set<int> & history_clock_ids,
+                         const std::unordered_set<int> & prophecy_clock_ids,
+                         const std::unordered_set<int> & normal_clock_ids);
 
 };
 
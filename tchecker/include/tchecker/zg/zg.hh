@@ -14,6 +14,7 @@
 #include "tchecker/clockbounds/clockbounds.hh"
 #include "tchecker/syncprod/vedge.hh"
 #include "tchecker/syncprod/vloc.hh"
+#include "tchecker/ta/clock_liveness.hh"
 #include "tchecker/ta/system.hh"
 #include "tchecker/ta/ta.hh"
 #include "tchecker/utils/shared_objects.hh"
@@ -71,6 +72,7 @@ using initial_value_t = tchecker::ta::initial_value_t;
  \param semantics : a zone semantics
  \param extrapolation : an extrapolation
  \param initial_range : range of initial state valuations
+ \param liveness : live clocks (nullptr if inactive clocks are not normalised)
  \pre the size of vloc and vedge is equal to the size of initial_range.
  initial_range has been obtained from system.
  initial_range yields the initial locations of all the processes ordered by increasing process identifier
@@ -79,7 +81,8 @@ using initial_value_t = tchecker::ta::initial_value_t;
  vedge has been initialized to an empty tuple of edges.
  clock constraints from initial_range invariant have been aded to invariant
  zone has been initialized to the initial set of clock valuations according to
- semantics and extrapolation.
+ semantics and extrapolation, and inactive clocks in vloc w.r.t. liveness have
+ been normalised (if liveness is not nullptr).
  \return tchecker::STATE_OK if initialization succeeded,
  tchecker::STATE_INTVARS_SRC_INVARIANT_VIOLATED if the initial valuation of integer
  variables does not satisfy invariant
@@ -93,7 +96,8 @@ tchecker::state_status_t initial(tchecker::ta::system_t const & system,
                                  tchecker::intrusive_shared_ptr_t<tchecker::shared_vedge_t> const & vedge,
                                  tchecker::clock_constraint_container_t & invariant, tchecker::zg::semantics_t & semantics,
                                  tchecker::zg::extrapolation_t & extrapolation,
-                                 tchecker::zg::initial_value_t const & initial_range);
+                                 tchecker::zg::initial_value_t const & initial_range,
+                                 tchecker::ta::clock_liveness_t const * liveness = nullptr);
 
 /*!
  \brief Compute initial state and transition
@@ -103,6 +107,7 @@ tchecker::state_status_t initial(tchecker::ta::system_t const & system,
  \param semantics : a zone semantics
  \param extrapolation : an extrapolation
  \param v : initial iterator value
+ \param liveness : live clocks (nullptr if inactive clocks are not normalised)
  \post s has been initialized from v, and t is an empty transition
  \return tchecker::STATE_OK if initialization of s and t succeeded, see
  tchecker::zg::initial for returned values when initialization fails
@@ -110,10 +115,11 @@ tchecker::state_status_t initial(tchecker::ta::system_t const & system,
 */
 inline tchecker::state_status_t initial(tchecker::ta::system_t const & system, tchecker::zg::state_t & s,
                                         tchecker::zg::transition_t & t, tchecker::zg::semantics_t & semantics,
-                                        tchecker::zg::extrapolation_t & extrapolation, tchecker::zg::initial_value_t const & v)
+                                        tchecker::zg::extrapolation_t & extrapolation, tchecker::zg::initial_value_t const & v,
+                                        tchecker::ta::clock_liveness_t const * liveness = nullptr)
 {
   return tchecker::zg::initial(system, s.vloc_ptr(), s.intval_ptr(), s.zone_ptr(), t.vedge_ptr(), t.src_invariant_container(),
-                               semantics, extrapolation, v);
+                               semantics, extrapolation, v, liveness);
 }
 
 /*!
@@ -160,6 +166,7 @@ using outgoing_edges_value_t = tchecker::ta::outgoing_edges_value_t;
  \param semantics : a zone semantics
  \param extrapolation : an extrapolation
  \param edges : tuple of edge from vloc (range of synchronized/asynchronous edges)
+ \param liveness : live clocks (nullptr if inactive clocks are not normalised)
  \pre the source location in edges match the locations in vloc.
  No process has more than one edge in edges.
  The pid of every process in edges is less than the size of vloc
@@ -175,7 +182,9 @@ using outgoing_edges_value_t = tchecker::ta::outgoing_edges_value_t;
  Clock constraints from the invariants in the updated vloc have been pushed
  into tgt_invariant.
  The zone has been updated according to semantics and extrapolation from
- src_invariant, guard, reset, tgt_invariant (and delay)
+ src_invariant, guard, reset, tgt_invariant (and delay), and inactive clocks in
+ the updated vloc w.r.t. liveness have been normalised (if liveness is not
+ nullptr)
  \return tchecker::STATE_OK if state computation succeeded,
  tchecker::STATE_INCOMPATIBLE_EDGE if the source locations in edges do not match
  vloc,
@@ -210,7 +219,8 @@ tchecker::state_status_t next(tchecker::ta::system_t const & system,
                               tchecker::clock_constraint_container_t & guard, tchecker::clock_reset_container_t & reset,
                               tchecker::clock_constraint_container_t & tgt_invariant, tchecker::zg::semantics_t & semantics,
                               tchecker::zg::extrapolation_t & extrapolation,
-                              tchecker::zg::outgoing_edges_value_t const & edges);
+                              tchecker::zg::outgoing_edges_value_t const & edges,
+                              tchecker::ta::clock_liveness_t const * liveness = nullptr);
 
 /*!
  \brief Compute next state and transition
@@ -220,6 +230,7 @@ tchecker::state_status_t next(tchecker::ta::system_t const & system,
  \param semantics : a zone semantics
  \param extrapolation : an extrapolation
  \param v : outgoing edge value
+ \param liveness : live clocks (nullptr if inactive clocks are not normalised)
  \post s have been updated from v according to semantics and extrapolation, and
  t is the set of edges in v
  \return status of state s after update (see tchecker::zg::next)
@@ -228,10 +239,12 @@ tchecker::state_status_t next(tchecker::ta::system_t const & system,
 inline tchecker::state_status_t next(tchecker::ta::system_t const & system, tchecker::zg::state_t & s,
                                      tchecker::zg::transition_t & t, tchecker::zg::semantics_t & semantics,
                                      tchecker::zg::extrapolation_t & extrapolation,
-                                     tchecker::zg::outgoing_edges_value_t const & v)
+                                     tchecker::zg::outgoing_edges_value_t const & v,
+                                     tchecker::ta::clock_liveness_t const * liveness = nullptr)
 {
   return tchecker::zg::next(system, s.vloc_ptr(), s.intval_ptr(), s.zone_ptr(), t.vedge_ptr(), t.src_invariant_container(),
-                            t.guard_container(), t.reset_container(), t.tgt_invariant_container(), semantics, extrapolation, v);
+                            t.guard_container(), t.reset_container(), t.tgt_invariant_container(), semantics, extrapolation, v,
+                            liveness);
 }
 
 /*!
@@ -265,6 +278,66 @@ void attributes(tchecker::ta::system_t const & system, tchecker::zg::state_t con
 void attributes(tchecker::ta::system_t const & system, tchecker::zg::transition_t const & t,
                 std::map<std::string, std::string> & m);
 
+/*!
+ \brief Name of a storage of zones
+ \param storage : storage of zones
+ \return "full", "compact" or "reduced"
+ */
+std::string to_string(enum tchecker::zg::zone_storage_t storage);
+
+/*!
+ \class zone_storage_stats_t
+ \brief Statistics on the storage of the zones of computed states
+ */
+class zone_storage_stats_t {
+public:
+  /*!
+   \brief Constructor
+   \post all statistics are 0
+   */
+  zone_storage_stats_t();
+
+  /*!
+   \brief Count a stored zone
+   \param storage : storage of the zone
+   \param bytes : memory allocated for the zone
+   \param full_bytes : memory allocated for the zone if it was full
+   \post the zone has been counted
+   */
+  void count(enum tchecker::zg::zone_storage_t storage, std::size_t bytes, std::size_t full_bytes);
+
+  /*!
+   \brief Accessor
+   \param storage : storage of zones
+   \return number of stored zones with storage
+   */
+  unsigned long zones(enum tchecker::zg::zone_storage_t storage) const;
+
+  /*!
+   \brief Accessor
+   \return memory allocated for stored zones (bytes)
+   */
+  unsigned long long bytes() const;
+
+  /*!
+   \brief Accessor
+   \return memory that stored zones would take if they were full (bytes)
+   */
+  unsigned long long full_bytes() const;
+
+  /*!
+   \brief Extract statistics as attributes (key, value)
+   \param m : attributes map
+   \post every statistics has been added to m
+   */
+  void attributes(std::map<std::string, std::string> & m) const;
+
+private:
+  unsigned long _zones[3];         /*!< Number of stored zones (indexed by storage) */
+  unsigned long long _bytes;       /*!< Memory allocated for stored zones */
+  unsigned long long _full_bytes;  /*!< Memory for stored zones if they were full */
+};
+
 /*!
  \class zg_t
  \brief Zone graph of a timed automaton
@@ -280,10 +353,12 @@ public:
    \param semantics : a zone semantics
    \param extrapolation : a zone extrapolation
    \param block_size : number of objects allocated in a block
+   \param liveness : live clocks (nullptr if inactive clocks are not normalised)
    \note all states and transitions are pool allocated and deallocated automatically
    */
   zg_t(std::shared_ptr<tchecker::ta::system_t const> const & system, std::unique_ptr<tchecker::zg::semantics_t> && semantics,
-       std::unique_ptr<tchecker::zg::extrapolation_t> && extrapolation, std::size_t block_size);
+       std::unique_ptr<tchecker::zg::extrapolation_t> && extrapolation, std::size_t block_size,
+       std::shared_ptr<tchecker::ta::clock_liveness_t const> const & liveness = nullptr);
 
   /*!
    \brief Copy constructor (deleted)
@@ -405,12 +480,60 @@ public:
    */
   tchecker::ta::system_t const & system() const;
 
+  /*!
+   \brief Accessor
+   \return Memory used by the states and transitions allocated by this transition
+   system (bytes)
+   */
+  std::size_t memsize() const;
+
+  /*!
+   \brief Set storage of zones
+   \param storage : storage of zones
+   \post the zones of the states computed by initial() and next() are stored
+   w.r.t. storage (see tchecker::zg::zone_t) when possible, and full otherwise:
+   compact zones require a compact encoding, and reduced zones require to take
+   less memory than full zones. All zones are full if storage is
+   tchecker::zg::ZONE_FULL (default)
+   \note compact and reduced zones cannot be modified in place: they should not
+   be used if the states computed by initial() and next() are modified afterwards
+   (e.g. by symmetry reduction)
+   \note reduced zones trade time for memory: they are expanded, i.e. tightened,
+   each time they are used
+   */
+  void set_zone_storage(enum tchecker::zg::zone_storage_t storage);
+
+  /*!
+   \brief Accessor
+   \return storage of zones
+   */
+  enum tchecker::zg::zone_storage_t zone_storage() const;
+
+  /*!
+   \brief Accessor
+   \return statistics on the storage of the zones of the states computed by
+   initial() and next()
+   */
+  tchecker::zg::zone_storage_stats_t const & zone_storage_stats() const;
+
 private:
+  /*!
+   \brief Store the zone of a state
+   \param status : status of state s
+   \param s : a state
+   \post if status is tchecker::STATE_OK, the zone of s has been stored w.r.t.
+   the storage of zones when possible, and it has been counted in the statistics
+   */
+  void store(tchecker::state_status_t status, tchecker::zg::state_sptr_t & s);
+
   std::shared_ptr<tchecker::ta::system_t const> _system;           /*!< System of timed processes */
   std::unique_ptr<tchecker::zg::semantics_t> _semantics;           /*!< Zone semantics */
   std::unique_ptr<tchecker::zg::extrapolation_t> _extrapolation;   /*!< Zone extrapolation */
   tchecker::zg::state_pool_allocator_t _state_allocator;           /*!< Pool allocator of states */
   tchecker::zg::transition_pool_allocator_t _transition_allocator; /*! Pool allocator of transitions */
+  std::shared_ptr<tchecker::ta::clock_liveness_t const> _liveness; /*!< Live clocks (nullptr if not used) */
+  enum tchecker::zg::zone_storage_t _zone_storage;                 /*!< Storage of zones */
+  tchecker::zg::zone_storage_stats_t _zone_storage_stats;          /*!< Statistics on the storage of zones */
 };
 
 /*!
@@ -419,6 +542,7 @@ private:
  \param semantics_type : type of zone semantics
  \param extrapolation_type : type of zone extrapolation
  \param block_size : number of objects allocated in a block
+ \param liveness : live clocks (nullptr if inactive clocks are not normalised)
  \return a zone graph over system with zone semantics and zone extrapolation
  defined from semantics_type and extrapolation_type, and allocation of
  block_size objects at a time, nullptr if clock bounds cannot be inferred from
@@ -426,7 +550,8 @@ private:
  */
 tchecker::zg::zg_t * factory(std::shared_ptr<tchecker::ta::system_t const> const & system,
                              enum tchecker::zg::semantics_type_t semantics_type,
-                             enum tchecker::zg::extrapolation_type_t extrapolation_type, std::size_t block_size);
+                             enum tchecker::zg::extrapolation_type_t extrapolation_type, std::size_t block_size,
+                             std::shared_ptr<tchecker::ta::clock_liveness_t const> const & liveness = nullptr);
 
 /*!
  \brief Factory of zone graphs
@@ -444,6 +569,45 @@ tchecker::zg::zg_t * factory(std::shared_ptr<tchecker::ta::system_t const> const
                              enum tchecker::zg::extrapolation_type_t extrapolation_type,
                              tchecker::clockbounds::clockbounds_t const & clock_bounds, std::size_t block_size);
 
+/*!
+ \brief Factory of zone graphs
+ \param system : system of timed processes
+ \param semantics_type : type of zone semantics
+ \param extrapolation_type : type of zone extrapolation
+ \param amap : reduced A-map for system
+ \param block_size : number of objects allocated in a block
+ \param liveness : live clocks (nullptr if inactive clocks are not normalised)
+ \return a zone graph over system with zone semantics and zone extrapolation
+ defined from semantics_type, extrapolation_type and amap (see
+ tchecker::zg::extrapolation_factory), and allocation of block_size objects at a
+ time
+ \throw std::invalid_argument : if extrapolation_type is neither
+ tchecker::zg::NO_EXTRAPOLATION nor tchecker::zg::EXTRA_LU_PLUS_LOCAL_ECA
+ */
+tchecker::zg::zg_t * factory(std::shared_ptr<tchecker::ta::system_t const> const & system,
+                             enum tchecker::zg::semantics_type_t semantics_type,
+                             enum tchecker::zg::extrapolation_type_t extrapolation_type,
+                             tchecker::eca_amap_gen2::eca_a_map_t const & amap, std::size_t block_size,
+                             std::shared_ptr<tchecker::ta::clock_liveness_t const> const & liveness = nullptr);
+
+/*!
+ \brief Check if compact zones are worthwhile w.r.t. a maximal constant
+ \param max_constant : maximal constant in the clock constraints of a system
+ \return true if max_constant is small enough for the extrapolated zones of the
+ system to have a compact encoding (see tchecker::zg::zone_t), false otherwise
+ \note this is a heuristic: zones that have no compact encoding are stored as
+ full zones (see tchecker::zg::zg_t::set_zone_storage)
+ */
+bool compact_zones_allowed(tchecker::integer_t max_constant);
+
+/*!
+ \brief Check if compact zones are worthwhile for a system
+ \param system : system of timed processes
+ \return true if clock bounds can be inferred from system and the maximal
+ clock bound is allowed by tchecker::zg::compact_zones_allowed, false otherwise
+ */
+bool compact_zones_allowed(tchecker::ta::system_t const & system);
+
 } // end of namespace zg
 
 } // end of namespace tchecker
@@ -8,11 +8,14 @@
 #ifndef TCHECKER_ZG_ZONE_HH
 #define TCHECKER_ZG_ZONE_HH
 
+#include <cassert>
 #include <string>
 
 #include "tchecker/basictypes.hh"
 #include "tchecker/clockbounds/clockbounds.hh"
+#include "tchecker/dbm/compact.hh"
 #include "tchecker/dbm/dbm.hh"
+#include "tchecker/dbm/reduced.hh"
 #include "tchecker/utils/allocation_size.hh"
 #include "tchecker/variables/clocks.hh"
 
@@ -25,19 +28,37 @@ namespace tchecker {
 
 namespace zg {
 
+/*!
+ \brief Storage of zones
+ */
+enum zone_storage_t {
+  ZONE_FULL,    /*!< DBM of tchecker::dbm::db_t */
+  ZONE_COMPACT, /*!< Compact DBM of tchecker::dbm::compact_db_t (see tchecker/dbm/compact.hh) */
+  ZONE_REDUCED, /*!< Reduced DBM, i.e. list of constraints (see tchecker/dbm/reduced.hh) */
+};
+
 /*!
  \class zone_t
  \brief DBM implementation of zones
+ \note Zones are either full, compact or reduced. Full zones store a DBM of
+ tchecker::dbm::db_t that can be modified through method dbm(). Compact zones
+ store a DBM of 16-bit difference bounds (see tchecker/dbm/compact.hh), and
+ reduced zones store a list of constraints (see tchecker/dbm/reduced.hh). Compact
+ and reduced zones cannot be modified. The other methods accept all kinds of
+ zones: compact and reduced zones are expanded to a scratch DBM when needed. The
+ last expansion in each scratch DBM is kept, so repeated checks on the same zone
+ only expand it once
  */
 class zone_t {
 public:
   /*!
    \brief Assignment operator
    \param zone : a DBM zone
-   \pre this and zone have the same dimension
+   \pre this and zone have the same dimension, this is full
    \post this is a copy of zone
    \return this after assignment
-   \throw std::invalid_argument : if this and zone do not have the same dimension
+   \throw std::invalid_argument : if this and zone do not have the same dimension,
+   or if this is not full
    */
   tchecker::zg::zone_t & operator=(tchecker::zg::zone_t const & zone);
 
@@ -145,6 +166,41 @@ public:
    */
   inline std::size_t dim() const { return _dim; }
 
+  /*!
+   \brief Accessor
+   \return true if this zone is compact, false otherwise
+   */
+  inline bool is_compact() const { return _storage == tchecker::zg::ZONE_COMPACT; }
+
+  /*!
+   \brief Accessor
+   \return true if this zone is reduced, false otherwise
+   */
+  inline bool is_reduced() const { return _storage == tchecker::zg::ZONE_REDUCED; }
+
+  /*!
+   \brief Accessor
+   \return true if this zone is full, false otherwise
+   */
+  inline bool is_full() const { return _storage == tchecker::zg::ZONE_FULL; }
+
+  /*!
+   \brief Accessor
+   \return storage of this zone
+   */
+  inline enum tchecker::zg::zone_storage_t storage() const { return _storage; }
+
+  /*!
+   \brief Accessor
+   \pre this zone is reduced (checked by assertion)
+   \return number of constraints in this reduced zone
+   */
+  inline std::size_t reduced_count() const
+  {
+    assert(is_reduced());
+    return reduced_header_ptr()->count;
+  }
+
   /*!
    \brief Output
    \param os : output stream
@@ -157,6 +213,7 @@ public:
 
   /*!
    \brief Accessor
+   \pre this zone is full (checked by assertion)
    \return internal DBM of size dim()*dim()
    \note Modifications to the returned DBM should ensure tightness or emptiness of the zone, following the convention defined
    in file tchecker/dbm/dbm.hh. It is thus strongly suggested to use the function defined in that file to modify the returned
@@ -166,6 +223,7 @@ public:
 
   /*!
    \brief Accessor
+   \pre this zone is full (checked by assertion)
    \return internal DBM of size dim()*dim()
    */
   tchecker::dbm::db_t const * dbm() const;
@@ -216,6 +274,35 @@ protected:
    */
   zone_t(tchecker::zg::zone_t const & zone);
 
+  /*!
+   \brief Copy constructor
+   \param zone : a zone
+   \param storage : storage of this zone
+   \pre this has been allocated with the same dimension as zone and with
+   storage (see tchecker::allocation_size_t<tchecker::zg::zone_t>). If storage
+   is tchecker::zg::ZONE_COMPACT, then the DBM of zone has a compact encoding
+   (see tchecker::zg::is_compactable)
+   \post this is a copy of zone stored w.r.t. storage
+   \throw std::invalid_argument : if storage is tchecker::zg::ZONE_COMPACT and zone
+   has no compact encoding, or if storage is tchecker::zg::ZONE_REDUCED (see the
+   constructor of reduced zones below)
+   */
+  zone_t(tchecker::zg::zone_t const & zone, enum tchecker::zg::zone_storage_t storage);
+
+  /*!
+   \brief Constructor of reduced zones
+   \param dim : dimension
+   \param header : header of a reduced DBM
+   \param constraints : constraints of a reduced DBM
+   \pre this has been allocated with size at least
+   tchecker::allocation_size_t<tchecker::zg::zone_t>::reduced_alloc_size(header.count),
+   (header, constraints) is the reduction of a DBM of dimension dim (see
+   tchecker::dbm::reduce)
+   \post this is a reduced zone that stores header and constraints
+   */
+  zone_t(tchecker::clock_id_t dim, tchecker::dbm::reduced_header_t const & header,
+         tchecker::dbm::reduced_constraint_t const * constraints);
+
   /*!
    \brief Move constructor
    \note deleted (move construction is the same as copy construction)
@@ -236,6 +323,43 @@ protected:
     return static_cast<tchecker::dbm::db_t *>(static_cast<void *>(const_cast<tchecker::zg::zone_t *>(this) + 1));
   }
 
+  /*!
+   \brief Accessor
+   \return pointer to compact DBM
+   */
+  constexpr tchecker::dbm::compact_db_t * compact_dbm_ptr() const
+  {
+    return static_cast<tchecker::dbm::compact_db_t *>(static_cast<void *>(const_cast<tchecker::zg::zone_t *>(this) + 1));
+  }
+
+  /*!
+   \brief Accessor
+   \return pointer to the header of the reduced DBM
+   */
+  constexpr tchecker::dbm::reduced_header_t * reduced_header_ptr() const
+  {
+    return static_cast<tchecker::dbm::reduced_header_t *>(static_cast<void *>(const_cast<tchecker::zg::zone_t *>(this) + 1));
+  }
+
+  /*!
+   \brief Accessor
+   \return pointer to the constraints of the reduced DBM
+   */
+  constexpr tchecker::dbm::reduced_constraint_t * reduced_constraints_ptr() const
+  {
+    return static_cast<tchecker::dbm::reduced_constraint_t *>(static_cast<void *>(reduced_header_ptr() + 1));
+  }
+
+  /*!
+   \brief Accessor
+   \param scratch : index of a scratch DBM (0 or 1)
+   \return internal DBM of this zone if it is full, or scratch DBM number scratch
+   filled with the expansion of this zone if it is compact or reduced
+   \note the scratch DBM is overwritten by the next call with the same scratch
+   index on another zone in the same thread
+   */
+  tchecker::dbm::db_t const * full_dbm(unsigned int scratch) const;
+
   /*!
    \brief Accessor
    \param i : clock ID
@@ -244,9 +368,18 @@ protected:
    */
   constexpr tchecker::dbm::db_t dbm(tchecker::clock_id_t i, tchecker::clock_id_t j) const { return dbm_ptr()[i * _dim + j]; }
 
-  tchecker::clock_id_t _dim; /*!< Dimension of DBM */
+  tchecker::clock_id_t _dim;                      /*!< Dimension of DBM */
+  enum tchecker::zg::zone_storage_t _storage;     /*!< Storage of DBM */
 };
 
+/*!
+ \brief Check if a zone has a compact encoding
+ \param zone : a zone
+ \return true if zone is compact, or if zone is full and its DBM has a compact
+ encoding (see tchecker::dbm::is_compactable), false otherwise
+ */
+bool is_compactable(tchecker::zg::zone_t const & zone);
+
 /*!
  \brief Boost compatible hash function on zones
  \param zone : a zone
@@ -282,6 +415,32 @@ public:
     return (sizeof(tchecker::zg::zone_t) + dim * dim * sizeof(tchecker::dbm::db_t));
   }
 
+  /*!
+   \brief Accessor
+   \param dim : dimension
+   \param storage : storage of zones
+   \return Allocation size for objects of type tchecker::zg::zone_t
+   with dimension dim and storage
+   */
+  static constexpr std::size_t alloc_size(tchecker::clock_id_t dim, enum tchecker::zg::zone_storage_t storage)
+  {
+    return (storage == tchecker::zg::ZONE_COMPACT
+                ? sizeof(tchecker::zg::zone_t) + dim * dim * sizeof(tchecker::dbm::compact_db_t)
+                : allocation_size_t<tchecker::zg::zone_t>::alloc_size(dim));
+  }
+
+  /*!
+   \brief Accessor
+   \param count : number of constraints
+   \return Allocation size for reduced objects of type tchecker::zg::zone_t
+   with count constraints
+   */
+  static constexpr std::size_t reduced_alloc_size(std::size_t count)
+  {
+    return (sizeof(tchecker::zg::zone_t) + sizeof(tchecker::dbm::reduced_header_t) +
+            count * sizeof(tchecker::dbm::reduced_constraint_t));
+  }
+
   /*!
    \brief Accessor
    \param dim : dimension
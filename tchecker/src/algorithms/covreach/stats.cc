@@ -8,13 +8,17 @@
 #include <sstream>
 
 #include "tchecker/algorithms/covreach/stats.hh"
+#include "tchecker/utils/counters.hh"
 
 namespace tchecker {
 
 namespace algorithms {
 namespace covreach {
 
-stats_t::stats_t() : _visited_states(0), _covered_states(0), _reachable(false) {}
+stats_t::stats_t()
+    : _visited_states(0), _covered_states(0), _reachable(false), _por(false), _ample_states(0), _pruned_transitions(0)
+{
+}
 
 unsigned long & stats_t::visited_states() { return _visited_states; }
 
@@ -32,6 +36,18 @@ bool & stats_t::reachable() { return _reachable; }
 
 bool stats_t::reachable() const { return _reachable; }
 
+bool & stats_t::por() { return _por; }
+
+bool stats_t::por() const { return _por; }
+
+unsigned long & stats_t::ample_states() { return _ample_states; }
+
+unsigned long stats_t::ample_states() const { return _ample_states; }
+
+unsigned long & stats_t::pruned_transitions() { return _pruned_transitions; }
+
+unsigned long stats_t::pruned_transitions() const { return _pruned_transitions; }
+
 void stats_t::attributes(std::map<std::string, std::string> & m) const
 {
   tchecker::algorithms::stats_t::attributes(m);
@@ -52,6 +68,20 @@ void stats_t::attributes(std::map<std::string, std::string> & m) const
   sstream.str("");
   sstream << std::boolalpha << _reachable;
   m["REACHABLE"] = sstream.str();
+
+  if (_por) {
+    sstream.str("");
+    sstream << _ample_states;
+    m["POR_AMPLE_STATES"] = sstream.str();
+
+    sstream.str("");
+    sstream << _pruned_transitions;
+    m["POR_PRUNED_TRANSITIONS"] = sstream.str();
+  }
+
+#if defined(TCHECKER_ENABLE_COUNTERS)
+  tchecker::counters::attributes(m);
+#endif
 }
 
 } // end of namespace covreach
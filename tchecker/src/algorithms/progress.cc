@@ -0,0 +1,71 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "tchecker/algorithms/progress.hh"
+
+namespace tchecker {
+
+namespace algorithms {
+
+progress_t::progress_t(std::ostream & os, double period)
+    : _os(os), _period(period), _calls(0), _last_visited(0), _depth(0), _max_depth(0)
+{
+  if (period <= 0)
+    throw std::invalid_argument("Progress period should be positive");
+  start();
+}
+
+void progress_t::start()
+{
+  _start_time = std::chrono::steady_clock::now();
+  _last_report = _start_time;
+  _next_report = _start_time + std::chrono::duration_cast<std::chrono::steady_clock::duration>(_period);
+  _calls = 0;
+  _last_visited = 0;
+  _waiting_depth.clear();
+  _depth = 0;
+  _max_depth = 0;
+}
+
+void progress_t::waiting_inserted(void const * node, bool initial) { _waiting_depth[node] = (initial ? 0 : _depth + 1); }
+
+void progress_t::waiting_removed(void const * node) { _waiting_depth.erase(node); }
+
+void progress_t::visit(void const * node)
+{
+  auto it = _waiting_depth.find(node);
+  if (it == _waiting_depth.end())
+    return;
+  _depth = it->second;
+  _max_depth = std::max(_max_depth, _depth);
+  _waiting_depth.erase(it);
+}
+
+void progress_t::report(unsigned long visited, unsigned long stored, unsigned long covered, std::size_t waiting,
+                        std::size_t memsize)
+{
+  std::chrono::time_point<std::chrono::steady_clock> const now = std::chrono::steady_clock::now();
+  std::chrono::duration<double> const elapsed = now - _start_time;
+  std::chrono::duration<double> const since_last_report = now - _last_report;
+  double const states_per_second =
+      (since_last_report.count() > 0 ? (visited - _last_visited) / since_last_report.count() : 0.0);
+
+  _os << "PROGRESS ELAPSED_SECONDS=" << elapsed.count() << " VISITED_STATES=" << visited << " STORED_STATES=" << stored
+      << " COVERED_STATES=" << covered << " WAITING_STATES=" << waiting << " STATES_PER_SECOND=" << states_per_second
+      << " MEMORY_BYTES=" << memsize << " DEPTH=" << _depth << " MAX_DEPTH=" << _max_depth << std::endl;
+
+  _last_report = now;
+  _last_visited = visited;
+  _next_report = now + std::chrono::duration_cast<std::chrono::steady_clock::duration>(_period);
+}
+
+} // end of namespace algorithms
+
+} // end of namespace tchecker
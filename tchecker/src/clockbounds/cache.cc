@@ -0,0 +1,445 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <vector>
+
+#include <unistd.h>
+
+#include "tchecker/clockbounds/cache.hh"
+#include "tchecker/expression/static_analysis.hh"
+
+namespace tchecker {
+
+namespace clockbounds {
+
+std::uint64_t content_hash(std::string const & s)
+{
+  std::uint64_t h = 0xcbf29ce484222325ULL;
+  for (char c : s) {
+    h ^= static_cast<unsigned char>(c);
+    h *= 0x100000001b3ULL;
+  }
+  return h;
+}
+
+/* Binary format */
+
+static std::uint32_t const MAGIC = 0x424b4354;      /*!< "TCKB" */
+static std::uint32_t const ENDIANNESS = 0x01020304; /*!< Detects entries written on another architecture */
+static std::uint32_t const END = 0x21444e45;        /*!< "END!" */
+
+/*!
+ \brief Write a value
+ \param os : output stream
+ \param v : value
+ \post the bytes of v have been written to os
+ */
+template <class T> static void write(std::ostream & os, T v) { os.write(reinterpret_cast<char const *>(&v), sizeof(v)); }
+
+/*!
+ \brief Read a value
+ \param is : input stream
+ \param v : value
+ \post sizeof(v) bytes have been read from is into v
+ \return true if the bytes have been read, false otherwise
+ */
+template <class T> static bool read(std::istream & is, T & v)
+{
+  is.read(reinterpret_cast<char *>(&v), sizeof(v));
+  return static_cast<bool>(is);
+}
+
+/*!
+ \brief Write the header of an entry
+ \param os : output stream
+ \param kind : kind of table
+ \param key : content hash of the model
+ \param system : a system of timed processes
+ \post the header of the entry of kind for system has been written to os
+ */
+static void write_header(std::ostream & os, enum tchecker::clockbounds::cache_t::kind_t kind, std::uint64_t key,
+                         tchecker::ta::system_t const & system)
+{
+  write<std::uint32_t>(os, MAGIC);
+  write<std::uint32_t>(os, ENDIANNESS);
+  write<std::uint32_t>(os, tchecker::clockbounds::cache_t::FORMAT_VERSION);
+  write<std::uint32_t>(os, kind);
+  write<std::uint64_t>(os, key);
+  write<std::uint32_t>(os, system.locations_count());
+  write<std::uint32_t>(os, system.clocks_count(tchecker::VK_FLATTENED));
+  write<std::uint32_t>(os, system.edges_count());
+}
+
+/*!
+ \brief Check the header of an entry
+ \param is : input stream
+ \param kind : kind of table
+ \param key : content hash of the model
+ \param system : a system of timed processes
+ \return true if the header read from is matches kind, key, system and the
+ current format version, false otherwise
+ */
+static bool check_header(std::istream & is, enum tchecker::clockbounds::cache_t::kind_t kind, std::uint64_t key,
+                         tchecker::ta::system_t const & system)
+{
+  std::uint32_t magic, endianness, version, k, locations, clocks, edges;
+  std::uint64_t h;
+  if (!read(is, magic) || !read(is, endianness) || !read(is, version) || !read(is, k) || !read(is, h) ||
+      !read(is, locations) || !read(is, clocks) || !read(is, edges))
+    return false;
+  return magic == MAGIC && endianness == ENDIANNESS && version == tchecker::clockbounds::cache_t::FORMAT_VERSION &&
+         k == kind && h == key && locations == system.locations_count() &&
+         clocks == system.clocks_count(tchecker::VK_FLATTENED) && edges == system.edges_count();
+}
+
+/*!
+ \brief Store an entry
+ \param dir : cache directory
+ \param path : path to the entry
+ \param write_tables : writes the entry (header and tables) to an output stream
+ \post the entry has been written to a temporary file in dir, then renamed to
+ path
+ \return true if the entry has been stored, false otherwise
+ */
+template <class WRITER> static bool store_entry(std::string const & dir, std::string const & path, WRITER && write_tables)
+{
+  std::error_code ec;
+  std::filesystem::create_directories(dir, ec);
+  if (ec)
+    return false;
+
+  std::string const tmp = path + "." + std::to_string(::getpid()) + ".tmp";
+  {
+    std::ofstream ofs{tmp, std::ios::binary | std::ios::trunc};
+    if (!ofs)
+      return false;
+    write_tables(ofs);
+    write<std::uint32_t>(ofs, END);
+    ofs.flush();
+    if (!ofs) {
+      ofs.close();
+      std::remove(tmp.c_str());
+      return false;
+    }
+  }
+
+  if (std::rename(tmp.c_str(), path.c_str()) != 0) {
+    std::remove(tmp.c_str());
+    return false;
+  }
+  return true;
+}
+
+/*!
+ \brief Load an entry
+ \param path : path to the entry
+ \param read_tables : reads the entry (header and tables) from an input stream,
+ returns false on mismatch
+ \return true if the entry has been read and it is complete, false otherwise
+ */
+template <class READER> static bool load_entry(std::string const & path, READER && read_tables)
+{
+  std::ifstream ifs{path, std::ios::binary};
+  if (!ifs)
+    return false;
+  std::uint32_t end;
+  if (!read_tables(ifs) || !read(ifs, end) || end != END)
+    return false;
+  return ifs.peek() == std::char_traits<char>::eof();
+}
+
+/* Clock bounds */
+
+/*!
+ \brief Write a clock bound map
+ \param os : output stream
+ \param map : clock bound map
+ \post all the bounds in map have been written to os
+ */
+static void write_map(std::ostream & os, tchecker::clockbounds::map_t const & map)
+{
+  for (tchecker::clock_id_t i = 0; i < map.capacity(); ++i)
+    write<std::int32_t>(os, map[i]);
+}
+
+/*!
+ \brief Read a clock bound map
+ \param is : input stream
+ \param map : clock bound map
+ \post all the bounds in map have been read from is
+ \return true if the bounds have been read, false otherwise
+ */
+static bool read_map(std::istream & is, tchecker::clockbounds::map_t & map)
+{
+  std::int32_t b;
+  for (tchecker::clock_id_t i = 0; i < map.capacity(); ++i) {
+    if (!read(is, b))
+      return false;
+    map[i] = b;
+  }
+  return true;
+}
+
+/* A-maps */
+
+/*!
+ \brief Write reduced A-maps
+ \param os : output stream
+ \param amap : reduced A-maps
+ \post the constraints in amap have been written to os: for each location, the
+ number of diagonal constraints and the constraints (x, y, operator, bound),
+ then the number of non-diagonal constraints and the constraints (x, operator,
+ bound)
+ */
+template <class AMAP> static void write_amap(std::ostream & os, AMAP const & amap)
+{
+  for (tchecker::loc_id_t id = 0; id < amap.loc_number(); ++id) {
+    write<std::uint32_t>(os, amap.G(id).size());
+    for (tchecker::typed_diagonal_clkconstr_expression_t const * c : amap.G(id)) {
+      write<std::uint32_t>(os, tchecker::extract_lvalue_variable_ids(c->first_clock()).begin());
+      write<std::uint32_t>(os, tchecker::extract_lvalue_variable_ids(c->second_clock()).begin());
+      write<std::uint8_t>(os, c->binary_operator());
+      write<std::int64_t>(os, tchecker::const_evaluate(c->bound()));
+    }
+    write<std::uint32_t>(os, amap.Gdf(id).size());
+    for (tchecker::typed_simple_clkconstr_expression_t const * c : amap.Gdf(id)) {
+      write<std::uint32_t>(os, tchecker::extract_lvalue_variable_ids(c->clock()).begin());
+      write<std::uint8_t>(os, c->binary_operator());
+      write<std::int64_t>(os, tchecker::const_evaluate(c->bound()));
+    }
+  }
+}
+
+/*!
+ \brief Read an atomic constraint
+ \param is : input stream
+ \param op : operator
+ \param bound : bound
+ \post op and bound have been read from is
+ \return true if op is a comparison operator in a clock constraint and bound is
+ an integer, false otherwise
+ */
+static bool read_op_bound(std::istream & is, tchecker::binary_operator_t & op, tchecker::integer_t & bound)
+{
+  std::uint8_t o;
+  std::int64_t b;
+  if (!read(is, o) || !read(is, b))
+    return false;
+  op = static_cast<tchecker::binary_operator_t>(o);
+  if (op != tchecker::EXPR_OP_LT && op != tchecker::EXPR_OP_LE && op != tchecker::EXPR_OP_GE && op != tchecker::EXPR_OP_GT)
+    return false;
+  if (b < std::numeric_limits<tchecker::integer_t>::min() || b > std::numeric_limits<tchecker::integer_t>::max())
+    return false;
+  bound = static_cast<tchecker::integer_t>(b);
+  return true;
+}
+
+/*!
+ \brief Read reduced A-maps
+ \param is : input stream
+ \param system : a system of timed processes
+ \param amap : reduced A-maps
+ \pre amap has one entry per location in system
+ \post the constraints in is have been interned in the factory of amap and added
+ to amap
+ \return true if the constraints have been read and they are constraints over
+ the clocks of system, false otherwise
+ */
+template <class AMAP> static bool read_amap(std::istream & is, tchecker::ta::system_t const & system, AMAP & amap)
+{
+  tchecker::clock_id_t const clocks_count = system.clocks_count(tchecker::VK_FLATTENED);
+  std::vector<std::unique_ptr<tchecker::typed_var_expression_t>> clocks;
+  for (tchecker::clock_id_t x = 0; x < clocks_count; ++x)
+    clocks.emplace_back(
+        new tchecker::typed_var_expression_t{tchecker::EXPR_TYPE_CLKVAR, system.clock_name(x), x, 1});
+
+  std::uint32_t size, x, y;
+  tchecker::binary_operator_t op;
+  tchecker::integer_t bound;
+  for (tchecker::loc_id_t id = 0; id < amap.loc_number(); ++id) {
+    if (!read(is, size))
+      return false;
+    for (std::uint32_t i = 0; i < size; ++i) {
+      if (!read(is, x) || !read(is, y) || !read_op_bound(is, op, bound) || x >= clocks_count || y >= clocks_count)
+        return false;
+      amap.G(id).push_back(amap.factory().diagonal(*clocks[x], *clocks[y], op, bound));
+    }
+    if (!read(is, size))
+      return false;
+    for (std::uint32_t i = 0; i < size; ++i) {
+      if (!read(is, x) || !read_op_bound(is, op, bound) || x >= clocks_count)
+        return false;
+      amap.Gdf(id).push_back(amap.factory().simple(*clocks[x], op, bound));
+    }
+  }
+  return true;
+}
+
+/*!
+ \brief Check if the reduced A-maps of a system can be cached
+ \param system : a system of timed processes
+ \return true if system has no clock array, false otherwise
+ */
+static bool cacheable_amap(tchecker::ta::system_t const & system)
+{
+  return system.clocks_count(tchecker::VK_DECLARED) == system.clocks_count(tchecker::VK_FLATTENED);
+}
+
+/* cache_t */
+
+cache_t::cache_t(std::string const & dir, std::string const & model)
+    : _dir(dir), _key(tchecker::clockbounds::content_hash(model)), _hits(0), _misses(0), _stores(0)
+{
+}
+
+std::string cache_t::path(enum tchecker::clockbounds::cache_t::kind_t kind) const
+{
+  static char const * const extensions[] = {"", ".bounds", ".amap", ".eca-amap"};
+  std::stringstream ss;
+  ss << std::hex;
+  ss.width(16);
+  ss.fill('0');
+  ss << _key;
+  return (std::filesystem::path{_dir} / (ss.str() + extensions[kind])).string();
+}
+
+tchecker::clockbounds::clockbounds_t * cache_t::load_clockbounds(tchecker::ta::system_t const & system) const
+{
+  tchecker::loc_id_t const loc_nb = system.locations_count();
+  std::unique_ptr<tchecker::clockbounds::clockbounds_t> clockbounds{
+      new tchecker::clockbounds::clockbounds_t{loc_nb, system.clocks_count(tchecker::VK_FLATTENED)}};
+
+  bool const loaded = load_entry(path(KIND_CLOCKBOUNDS), [&](std::istream & is) {
+    if (!check_header(is, KIND_CLOCKBOUNDS, _key, system))
+      return false;
+    if (!read_map(is, clockbounds->global_lu_map()->L()) || !read_map(is, clockbounds->global_lu_map()->U()))
+      return false;
+    for (tchecker::loc_id_t id = 0; id < loc_nb; ++id)
+      if (!read_map(is, clockbounds->local_lu_map()->L(id)) || !read_map(is, clockbounds->local_lu_map()->U(id)))
+        return false;
+    if (!read_map(is, clockbounds->global_m_map()->M()))
+      return false;
+    for (tchecker::loc_id_t id = 0; id < loc_nb; ++id)
+      if (!read_map(is, clockbounds->local_m_map()->M(id)))
+        return false;
+    return true;
+  });
+
+  if (!loaded) {
+    ++_misses;
+    return nullptr;
+  }
+  ++_hits;
+  return clockbounds.release();
+}
+
+bool cache_t::store_clockbounds(tchecker::ta::system_t const & system,
+                                tchecker::clockbounds::clockbounds_t const & clockbounds) const
+{
+  tchecker::loc_id_t const loc_nb = system.locations_count();
+  if (clockbounds.clock_number() != system.clocks_count(tchecker::VK_FLATTENED) ||
+      clockbounds.local_lu_map()->loc_number() != loc_nb)
+    return false;
+
+  bool const stored = store_entry(_dir, path(KIND_CLOCKBOUNDS), [&](std::ostream & os) {
+    write_header(os, KIND_CLOCKBOUNDS, _key, system);
+    write_map(os, clockbounds.global_lu_map()->L());
+    write_map(os, clockbounds.global_lu_map()->U());
+    for (tchecker::loc_id_t id = 0; id < loc_nb; ++id) {
+      write_map(os, clockbounds.local_lu_map()->L(id));
+      write_map(os, clockbounds.local_lu_map()->U(id));
+    }
+    write_map(os, clockbounds.global_m_map()->M());
+    for (tchecker::loc_id_t id = 0; id < loc_nb; ++id)
+      write_map(os, clockbounds.local_m_map()->M(id));
+  });
+
+  if (stored)
+    ++_stores;
+  return stored;
+}
+
+tchecker::amap::a_map_t * cache_t::load_amap(tchecker::ta::system_t const & system) const
+{
+  std::unique_ptr<tchecker::amap::a_map_t> amap{new tchecker::amap::a_map_t{system.locations_count()}};
+
+  bool const loaded = cacheable_amap(system) && load_entry(path(KIND_AMAP), [&](std::istream & is) {
+                        return check_header(is, KIND_AMAP, _key, system) && read_amap(is, system, *amap);
+                      });
+
+  if (!loaded) {
+    ++_misses;
+    return nullptr;
+  }
+  ++_hits;
+  return amap.release();
+}
+
+bool cache_t::store_amap(tchecker::ta::system_t const & system, tchecker::amap::a_map_t const & amap) const
+{
+  if (!cacheable_amap(system) || amap.loc_number() != system.locations_count())
+    return false;
+
+  bool const stored = store_entry(_dir, path(KIND_AMAP), [&](std::ostream & os) {
+    write_header(os, KIND_AMAP, _key, system);
+    write_amap(os, amap);
+  });
+
+  if (stored)
+    ++_stores;
+  return stored;
+}
+
+tchecker::eca_amap_gen2::eca_a_map_t * cache_t::load_eca_amap(tchecker::ta::system_t const & system) const
+{
+  std::unique_ptr<tchecker::eca_amap_gen2::eca_a_map_t> amap{
+      new tchecker::eca_amap_gen2::eca_a_map_t{system.locations_count()}};
+
+  bool const loaded = cacheable_amap(system) && load_entry(path(KIND_ECA_AMAP), [&](std::istream & is) {
+                        return check_header(is, KIND_ECA_AMAP, _key, system) && read_amap(is, system, *amap);
+                      });
+
+  if (!loaded) {
+    ++_misses;
+    return nullptr;
+  }
+  ++_hits;
+  return amap.release();
+}
+
+bool cache_t::store_eca_amap(tchecker::ta::system_t const & system,
+                             tchecker::eca_amap_gen2::eca_a_map_t const & amap) const
+{
+  if (!cacheable_amap(system) || amap.loc_number() != system.locations_count())
+    return false;
+
+  bool const stored = store_entry(_dir, path(KIND_ECA_AMAP), [&](std::ostream & os) {
+    write_header(os, KIND_ECA_AMAP, _key, system);
+    write_amap(os, amap);
+  });
+
+  if (stored)
+    ++_stores;
+  return stored;
+}
+
+void cache_t::attributes(std::map<std::string, std::string> & m) const
+{
+  m["CACHE_HITS"] = std::to_string(_hits);
+  m["CACHE_MISSES"] = std::to_string(_misses);
+  m["CACHE_STORES"] = std::to_string(_stores);
+}
+
+} // end of namespace clockbounds
+
+} // end of namespace tchecker
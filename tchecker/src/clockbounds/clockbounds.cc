@@ -5,11 +5,17 @@
  *
  */
 
+#include <algorithm>
 #include <cassert>
+#include <cstdlib>
+#include <sstream>
 #include <tuple>
 
+#include <boost/functional/hash.hpp>
+
 #include "tchecker/basictypes.hh"
 #include "tchecker/clockbounds/clockbounds.hh"
+#include "tchecker/expression/static_analysis.hh"
 #include "tchecker/utils/iterator.hh"
 
 namespace tchecker {
@@ -574,25 +580,229 @@ std::shared_ptr<tchecker::clockbounds::local_m_map_t const> clockbounds_t::local
 
 std::shared_ptr<tchecker::clockbounds::local_m_map_t> clockbounds_t::local_m_map() { return _local_m; }
 
+/* local_lu_table_t */
+
+/*!
+ \brief Number of maps in a block of the arena of tchecker::clockbounds::local_lu_table_t
+ */
+static std::size_t const LU_TABLE_BLOCK_MAPS = 512;
+
+local_lu_table_t::local_lu_table_t(std::shared_ptr<tchecker::clockbounds::local_lu_map_t const> const & local_lu)
+    : _local_lu(local_lu), _block_used(LU_TABLE_BLOCK_MAPS), _last(0)
+{
+}
+
+local_lu_table_t::~local_lu_table_t()
+{
+  for (tchecker::clockbounds::local_lu_table_t::entry_t const & entry : _entries) {
+    tchecker::clockbounds::map_t::destruct(entry.L);
+    tchecker::clockbounds::map_t::destruct(entry.U);
+  }
+  for (char * block : _blocks)
+    delete[] block;
+}
+
+void local_lu_table_t::bounds(tchecker::vloc_t const & vloc, tchecker::clockbounds::map_t const *& L,
+                              tchecker::clockbounds::map_t const *& U)
+{
+  // Covering checks scan buckets of nodes with same tuple of locations
+  if (_last < _entries.size() && is_entry(_entries[_last], vloc)) {
+    L = _entries[_last].L;
+    U = _entries[_last].U;
+    return;
+  }
+
+  std::size_t const h = boost::hash_range(vloc.begin(), vloc.end());
+  auto range = _index.equal_range(h);
+  for (auto it = range.first; it != range.second; ++it)
+    if (is_entry(_entries[it->second], vloc)) {
+      _last = it->second;
+      L = _entries[_last].L;
+      U = _entries[_last].U;
+      return;
+    }
+
+  tchecker::clockbounds::local_lu_table_t::entry_t entry{_vlocs.size(), allocate_map(), allocate_map()};
+  _vlocs.insert(_vlocs.end(), vloc.begin(), vloc.end());
+  _local_lu->bounds(vloc, *entry.L, *entry.U);
+  _last = _entries.size();
+  _entries.push_back(entry);
+  _index.emplace(h, _last);
+  L = entry.L;
+  U = entry.U;
+}
+
+bool local_lu_table_t::is_entry(tchecker::clockbounds::local_lu_table_t::entry_t const & entry,
+                                tchecker::vloc_t const & vloc) const
+{
+  // Tuples of locations in a system have the same size
+  return std::equal(vloc.begin(), vloc.end(), _vlocs.begin() + entry.vloc_offset);
+}
+
+tchecker::clockbounds::map_t * local_lu_table_t::allocate_map()
+{
+  tchecker::clock_id_t const clock_nb = _local_lu->clock_number();
+  std::size_t const map_size = tchecker::allocation_size_t<tchecker::clockbounds::map_t>::alloc_size(clock_nb);
+  // Keep maps aligned in blocks
+  std::size_t const stride = (map_size + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) * alignof(std::max_align_t);
+
+  if (_block_used == LU_TABLE_BLOCK_MAPS) {
+    _blocks.push_back(new char[LU_TABLE_BLOCK_MAPS * stride]);
+    _block_used = 0;
+  }
+
+  void * ptr = _blocks.back() + _block_used * stride;
+  ++_block_used;
+  tchecker::clockbounds::map_t::construct(ptr, std::make_tuple(clock_nb), std::make_tuple(0));
+  tchecker::clockbounds::map_t * map = reinterpret_cast<tchecker::clockbounds::map_t *>(ptr);
+  tchecker::clockbounds::clear(*map);
+  return map;
+}
+
 } // namespace clockbounds
 
 namespace amap {
 
+/* constraint_factory_t */
+
+constraint_factory_t::~constraint_factory_t()
+{
+  for (auto && [key, expr] : _simple)
+    delete expr;
+  for (auto && [key, expr] : _diagonal)
+    delete expr;
+}
+
+tchecker::typed_simple_clkconstr_expression_t const *
+constraint_factory_t::simple(tchecker::typed_lvalue_expression_t const & clock, tchecker::binary_operator_t op,
+                             tchecker::integer_t bound)
+{
+  simple_key_t const key{tchecker::extract_lvalue_variable_ids(clock).begin(), op, bound};
+  std::lock_guard<std::mutex> lock{_mutex};
+  auto it = _simple.find(key);
+  if (it != _simple.end())
+    return it->second;
+
+  tchecker::typed_simple_clkconstr_expression_t const * expr = new tchecker::typed_simple_clkconstr_expression_t(
+      tchecker::EXPR_TYPE_CLKCONSTR_SIMPLE, op, dynamic_cast<tchecker::typed_expression_t *>(clock.clone()),
+      new tchecker::typed_int_expression_t(tchecker::EXPR_TYPE_INTTERM, bound));
+  _simple.emplace(key, expr);
+  return expr;
+}
+
+tchecker::typed_diagonal_clkconstr_expression_t const *
+constraint_factory_t::diagonal(tchecker::typed_lvalue_expression_t const & x, tchecker::typed_lvalue_expression_t const & y,
+                               tchecker::binary_operator_t op, tchecker::integer_t bound)
+{
+  diagonal_key_t const key{tchecker::extract_lvalue_variable_ids(x).begin(), tchecker::extract_lvalue_variable_ids(y).begin(),
+                           op, bound};
+  std::lock_guard<std::mutex> lock{_mutex};
+  auto it = _diagonal.find(key);
+  if (it != _diagonal.end())
+    return it->second;
+
+  tchecker::typed_expression_t * x_minus_y = new tchecker::typed_binary_expression_t(
+      tchecker::EXPR_TYPE_CLKDIFF, tchecker::EXPR_OP_MINUS, dynamic_cast<tchecker::typed_expression_t *>(x.clone()),
+      dynamic_cast<tchecker::typed_expression_t *>(y.clone()));
+  tchecker::typed_diagonal_clkconstr_expression_t const * expr = new tchecker::typed_diagonal_clkconstr_expression_t(
+      tchecker::EXPR_TYPE_CLKCONSTR_DIAGONAL, op, x_minus_y,
+      new tchecker::typed_int_expression_t(tchecker::EXPR_TYPE_INTTERM, bound));
+  _diagonal.emplace(key, expr);
+  return expr;
+}
+
+tchecker::typed_simple_clkconstr_expression_t const *
+constraint_factory_t::intern(tchecker::typed_simple_clkconstr_expression_t const & expr)
+{
+  return simple(expr.clock(), expr.binary_operator(), tchecker::const_evaluate(expr.bound()));
+}
+
+tchecker::typed_diagonal_clkconstr_expression_t const *
+constraint_factory_t::intern(tchecker::typed_diagonal_clkconstr_expression_t const & expr)
+{
+  return diagonal(expr.first_clock(), expr.second_clock(), expr.binary_operator(), tchecker::const_evaluate(expr.bound()));
+}
+
+std::size_t constraint_factory_t::key_hash_t::operator()(simple_key_t const & k) const
+{
+  std::size_t h = std::hash<tchecker::clock_id_t>{}(std::get<0>(k));
+  boost::hash_combine(h, static_cast<int>(std::get<1>(k)));
+  boost::hash_combine(h, std::get<2>(k));
+  return h;
+}
+
+std::size_t constraint_factory_t::key_hash_t::operator()(diagonal_key_t const & k) const
+{
+  std::size_t h = std::hash<tchecker::clock_id_t>{}(std::get<0>(k));
+  boost::hash_combine(h, std::get<1>(k));
+  boost::hash_combine(h, static_cast<int>(std::get<2>(k)));
+  boost::hash_combine(h, std::get<3>(k));
+  return h;
+}
+
+/* fixpoint_stats_t */
+
+fixpoint_stats_t::fixpoint_stats_t() : _iterations(0), _propagations(0), _running_time(0.0), _sccs(0), _threads(1) {}
+
+unsigned long & fixpoint_stats_t::iterations() { return _iterations; }
+
+unsigned long fixpoint_stats_t::iterations() const { return _iterations; }
+
+unsigned long & fixpoint_stats_t::propagations() { return _propagations; }
+
+unsigned long fixpoint_stats_t::propagations() const { return _propagations; }
+
+double & fixpoint_stats_t::running_time() { return _running_time; }
+
+double fixpoint_stats_t::running_time() const { return _running_time; }
+
+unsigned long & fixpoint_stats_t::sccs() { return _sccs; }
+
+unsigned long fixpoint_stats_t::sccs() const { return _sccs; }
+
+unsigned int & fixpoint_stats_t::threads() { return _threads; }
+
+unsigned int fixpoint_stats_t::threads() const { return _threads; }
+
+void fixpoint_stats_t::attributes(std::map<std::string, std::string> & m) const
+{
+  std::stringstream sstream;
+
+  sstream << _iterations;
+  m["AMAP_FIXPOINT_ITERATIONS"] = sstream.str();
+
+  sstream.str("");
+  sstream << _propagations;
+  m["AMAP_FIXPOINT_PROPAGATIONS"] = sstream.str();
+
+  sstream.str("");
+  sstream << _running_time;
+  m["AMAP_FIXPOINT_TIME_SECONDS"] = sstream.str();
+
+  sstream.str("");
+  sstream << _sccs;
+  m["AMAP_FIXPOINT_SCCS"] = sstream.str();
+
+  sstream.str("");
+  sstream << _threads;
+  m["AMAP_FIXPOINT_THREADS"] = sstream.str();
+}
+
 /* a_map_t */
 
 a_map_t::a_map_t(tchecker::loc_id_t loc_nb)
-    : _loc_nb(0), _G(), _Gdf()
+    : _loc_nb(0), _G(), _Gdf(), _factory(std::make_shared<tchecker::amap::constraint_factory_t>())
 {
   resize(loc_nb);
 }
 
 a_map_t::a_map_t(tchecker::amap::a_map_t const & m)
-    : _loc_nb(m._loc_nb), _G(m._G), _Gdf(m._Gdf)
+    : _loc_nb(m._loc_nb), _G(m._G), _Gdf(m._Gdf), _fixpoint_stats(m._fixpoint_stats), _factory(m._factory)
 {
 }
 
 a_map_t::a_map_t(tchecker::amap::a_map_t && m)
-    : _loc_nb(m._loc_nb), _G(std::move(m._G)), _Gdf(std::move(m._Gdf))
+    : _loc_nb(m._loc_nb), _G(std::move(m._G)), _Gdf(std::move(m._Gdf)), _fixpoint_stats(m._fixpoint_stats), _factory(m._factory)
 {
   m._loc_nb = 0;
 }
@@ -607,6 +817,8 @@ tchecker::amap::a_map_t & a_map_t::operator=(tchecker::amap::a_map_t const & m)
     _loc_nb = m._loc_nb;
     _G = m._G;
     _Gdf = m._Gdf;
+    _fixpoint_stats = m._fixpoint_stats;
+    _factory = m._factory;
   }
   return *this;
 }
@@ -619,6 +831,8 @@ tchecker::amap::a_map_t & a_map_t::operator=(tchecker::amap::a_map_t && m)
     _loc_nb = std::move(m._loc_nb);
     _G = std::move(m._G);
     _Gdf = std::move(m._Gdf);
+    _fixpoint_stats = m._fixpoint_stats;
+    _factory = m._factory;
 
     m._loc_nb = 0;
     m._G.clear();
@@ -696,6 +910,18 @@ void a_map_t::bounds(tchecker::vloc_t const & vloc, std::vector<tchecker::typed_
   }
 }
 
+tchecker::integer_t max_constant(tchecker::amap::a_map_t const & map)
+{
+  tchecker::integer_t max = 0;
+  for (tchecker::loc_id_t l = 0; l < map.loc_number(); ++l) {
+    for (auto const & diag : map.G(l))
+      max = std::max(max, std::abs(tchecker::const_evaluate(diag->bound(), tchecker::clockbounds::MAX_BOUND)));
+    for (auto const & nondiag : map.Gdf(l))
+      max = std::max(max, std::abs(tchecker::const_evaluate(nondiag->bound(), tchecker::clockbounds::MAX_BOUND)));
+  }
+  return max;
+}
+
 std::ostream & operator<<(std::ostream & os, tchecker::amap::a_map_t const & map)
 {
   tchecker::loc_id_t loc_nb = map.loc_number();
@@ -723,18 +949,18 @@ namespace eca_amap_gen2 {
 /* a_map_t */
 
 eca_a_map_t::eca_a_map_t(tchecker::loc_id_t loc_nb)
-    : _loc_nb(0), _G(), _Gdf()
+    : _loc_nb(0), _G(), _Gdf(), _factory(std::make_shared<tchecker::amap::constraint_factory_t>())
 {
   resize(loc_nb);
 }
 
 eca_a_map_t::eca_a_map_t(tchecker::eca_amap_gen2::eca_a_map_t const & m)
-    : _loc_nb(m._loc_nb), _G(m._G), _Gdf(m._Gdf)
+    : _loc_nb(m._loc_nb), _G(m._G), _Gdf(m._Gdf), _fixpoint_stats(m._fixpoint_stats), _factory(m._factory)
 {
 }
 
 eca_a_map_t::eca_a_map_t(tchecker::eca_amap_gen2::eca_a_map_t && m)
-    : _loc_nb(m._loc_nb), _G(std::move(m._G)), _Gdf(std::move(m._Gdf))
+    : _loc_nb(m._loc_nb), _G(std::move(m._G)), _Gdf(std::move(m._Gdf)), _fixpoint_stats(m._fixpoint_stats), _factory(m._factory)
 {
   m._loc_nb = 0;
 }
@@ -749,6 +975,8 @@ tchecker::eca_amap_gen2::eca_a_map_t & eca_a_map_t::operator=(tchecker::eca_amap
     _loc_nb = m._loc_nb;
     _G = m._G;
     _Gdf = m._Gdf;
+    _fixpoint_stats = m._fixpoint_stats;
+    _factory = m._factory;
   }
   return *this;
 }
@@ -761,6 +989,8 @@ tchecker::eca_amap_gen2::eca_a_map_t & eca_a_map_t::operator=(tchecker::eca_amap
     _loc_nb = std::move(m._loc_nb);
     _G = std::move(m._G);
     _Gdf = std::move(m._Gdf);
+    _fixpoint_stats = m._fixpoint_stats;
+    _factory = m._factory;
 
     m._loc_nb = 0;
     m._G.clear();
@@ -838,6 +1068,18 @@ void eca_a_map_t::bounds(tchecker::vloc_t const & vloc, std::vector<tchecker::ty
   }
 }
 
+tchecker::integer_t max_constant(tchecker::eca_amap_gen2::eca_a_map_t const & map)
+{
+  tchecker::integer_t max = 0;
+  for (tchecker::loc_id_t l = 0; l < map.loc_number(); ++l) {
+    for (auto const & diag : map.G(l))
+      max = std::max(max, std::abs(tchecker::const_evaluate(diag->bound(), tchecker::clockbounds::MAX_BOUND)));
+    for (auto const & nondiag : map.Gdf(l))
+      max = std::max(max, std::abs(tchecker::const_evaluate(nondiag->bound(), tchecker::clockbounds::MAX_BOUND)));
+  }
+  return max;
+}
+
 std::ostream & operator<<(std::ostream & os, tchecker::eca_amap_gen2::eca_a_map_t const & map)
 {
   tchecker::loc_id_t loc_nb = map.loc_number();
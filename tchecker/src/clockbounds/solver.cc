@@ -6,8 +6,17 @@
  */
 
 #include <cassert>
+#include <chrono>
+#include <condition_variable>
 #include <cstring>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <thread>
 #include <unordered_set>
+#include <vector>
 
 #include "tchecker/clockbounds/solver.hh"
 #include "tchecker/expression/static_analysis.hh"
@@ -762,17 +771,115 @@ namespace amap {
 
 
 
+  /*!
+  \brief Accessor
+  \return factory of the constraints added by the add_constraint functions that
+  do not take an index
+  \note the factory lives until the end of the program
+  */
+  static tchecker::amap::constraint_factory_t & default_factory()
+  {
+    static tchecker::amap::constraint_factory_t factory;
+    return factory;
+  }
+
+  /* constraint_index_t */
+
+  constraint_index_t::constraint_index_t(bool infinite_bounds, tchecker::amap::constraint_factory_t & factory)
+      : _infinite_bounds(infinite_bounds), _factory(&factory)
+  {
+  }
+
+  void constraint_index_t::build(std::vector<tchecker::typed_diagonal_clkconstr_expression_t const *> & G,
+                                 std::vector<tchecker::typed_simple_clkconstr_expression_t const *> & Gdf)
+  {
+    clear();
+
+    for (tchecker::typed_diagonal_clkconstr_expression_t const *& diag : G) {
+      diag = _factory->intern(*diag);
+      _G_index.insert(diag);
+    }
+
+    for (std::size_t i = 0; i < Gdf.size(); ++i) {
+      Gdf[i] = _factory->intern(*Gdf[i]);
+      tchecker::clock_id_t const x = tchecker::extract_lvalue_variable_ids(Gdf[i]->clock()).begin();
+      tchecker::binary_operator_t const op = Gdf[i]->binary_operator();
+      tchecker::integer_t const bound = tchecker::const_evaluate(Gdf[i]->bound());
+      _Gdf_index[key(x, op, bound)] = dominant_t{i, bound, op};
+    }
+  }
+
+  void constraint_index_t::clear()
+  {
+    _Gdf_index.clear();
+    _G_index.clear();
+  }
+
+  bool constraint_index_t::add(std::vector<tchecker::typed_diagonal_clkconstr_expression_t const *> & G,
+                               tchecker::typed_diagonal_clkconstr_expression_t const & expr)
+  {
+    tchecker::typed_diagonal_clkconstr_expression_t const * diag = _factory->intern(expr);
+    if (!_G_index.insert(diag).second)
+      return false;
+    G.push_back(diag);
+    return true;
+  }
+
+  bool constraint_index_t::add(std::vector<tchecker::typed_simple_clkconstr_expression_t const *> & Gdf,
+                               tchecker::typed_simple_clkconstr_expression_t const & expr)
+  {
+    tchecker::clock_id_t const x = tchecker::extract_lvalue_variable_ids(expr.clock()).begin();
+    tchecker::binary_operator_t const op = expr.binary_operator();
+    tchecker::integer_t const bound = tchecker::const_evaluate(expr.bound());
+
+    auto it = _Gdf_index.find(key(x, op, bound));
+    if (it == _Gdf_index.end()) {
+      _Gdf_index.emplace(key(x, op, bound), dominant_t{Gdf.size(), bound, op});
+      Gdf.push_back(_factory->simple(expr.clock(), op, bound));
+      return true;
+    }
+
+    // if Gdf contains expr' with expr' >= expr, do not add
+    dominant_t & dominant = it->second;
+    if (dominant.bound > bound ||
+        (dominant.bound == bound && (dominant.op == op || (dominant.op == EXPR_OP_LE && op == EXPR_OP_LT) ||
+                                     (dominant.op == EXPR_OP_GT && op == EXPR_OP_GE))))
+      return false;
+
+    // otherwise expr' < expr: replace expr' by expr
+    assert(dominant.position < Gdf.size());
+    Gdf[dominant.position] = _factory->simple(expr.clock(), op, bound);
+    dominant.bound = bound;
+    dominant.op = op;
+    return true;
+  }
+
+  std::uint64_t constraint_index_t::key(tchecker::clock_id_t x, tchecker::binary_operator_t op,
+                                        tchecker::integer_t bound) const
+  {
+    // slot: 0 for finite bounds (compared by direction), 1 for INF_VALUE, 2 for
+    // MINUS_INF_VALUE (compared by operator)
+    std::uint64_t slot = 0, dir = (op == EXPR_OP_LT || op == EXPR_OP_LE ? 0 : 1);
+    if (_infinite_bounds && (bound == tchecker::dbm::INF_VALUE || bound == tchecker::dbm::MINUS_INF_VALUE)) {
+      slot = (bound == tchecker::dbm::INF_VALUE ? 1 : 2);
+      dir = static_cast<std::uint64_t>(op);
+    }
+    return (static_cast<std::uint64_t>(x) << 16) | (slot << 8) | dir;
+  }
+
   class amap_updater_t : public tchecker::typed_expression_visitor_t,
                          public tchecker::typed_statement_visitor_t 
   {
     public:
       /*!
       \brief Constructor
-      \param G   : a set of diagonal constraints
-      \param Gdf : a set of non-diagonal constraints
+      \param G     : a set of diagonal constraints
+      \param Gdf   : a set of non-diagonal constraints
+      \param index : index of G and Gdf
       */
-      amap_updater_t(std::vector<tchecker::typed_diagonal_clkconstr_expression_t const *> & G, std::vector<tchecker::typed_simple_clkconstr_expression_t const *> & Gdf)
-      : _G(G), _Gdf(Gdf)
+      amap_updater_t(std::vector<tchecker::typed_diagonal_clkconstr_expression_t const *> & G, std::vector<tchecker::typed_simple_clkconstr_expression_t const *> & Gdf,
+                     tchecker::amap::constraint_index_t & index)
+      : _G(G), _Gdf(Gdf), _index(index)
       {
       }
 
@@ -782,7 +889,7 @@ namespace amap {
       \post this is a copy of updater
       */
       amap_updater_t(tchecker::amap::amap_updater_t const & updater)
-          : _G(updater._G), _Gdf(updater._Gdf)
+          : _G(updater._G), _Gdf(updater._Gdf), _index(updater._index)
       {
       }
 
@@ -813,6 +920,7 @@ namespace amap {
         if (this != &updater) {
           _G = updater._G;
           _Gdf = updater._Gdf;
+          _index = updater._index;
         }
         return *this;
       }
@@ -828,6 +936,7 @@ namespace amap {
         if (this != &updater) {
           _G = std::move(updater._G);
           _Gdf = std::move(updater._Gdf);
+          _index = std::move(updater._index);
         }
         return *this;
       }
@@ -860,49 +969,14 @@ namespace amap {
         // if expr is x == c, add x <= c, x >= c
         if (expr.binary_operator() == EXPR_OP_EQ)
         {
-          tchecker::typed_expression_t * left = dynamic_cast<tchecker::typed_expression_t *>(expr.left_operand().clone());
-
-          tchecker::typed_simple_clkconstr_expression_t * le_expr, * ge_expr;
-
-          le_expr = new tchecker::typed_simple_clkconstr_expression_t(EXPR_TYPE_CLKCONSTR_SIMPLE, EXPR_OP_LE, left, new tchecker::typed_int_expression_t(EXPR_TYPE_INTTERM, expr_bound));
-          ge_expr = new tchecker::typed_simple_clkconstr_expression_t(EXPR_TYPE_CLKCONSTR_SIMPLE, EXPR_OP_GE, left, new tchecker::typed_int_expression_t(EXPR_TYPE_INTTERM, expr_bound));
-
-          add_constraint(*le_expr, _G, _Gdf);
-          add_constraint(*ge_expr, _G, _Gdf);
+          tchecker::amap::constraint_factory_t & factory = _index.factory();
+          add_constraint(*factory.simple(expr.clock(), EXPR_OP_LE, expr_bound), _G, _Gdf, _index);
+          add_constraint(*factory.simple(expr.clock(), EXPR_OP_GE, expr_bound), _G, _Gdf, _index);
           return;
         }
 
-        // extracting details of expr
-        tchecker::clock_id_t expr_x;
-        expr_x = tchecker::extract_lvalue_variable_ids(expr.clock()).begin();
-        tchecker::binary_operator_t expr_op = expr.binary_operator();
-
-
-        if(_Gdf.size()>0){
-          // if _G contains expr' with expr' >= expr, do not add
-          if(tchecker::eca_amap_gen2::is_G_greater(_Gdf,expr_x,expr_op, expr_bound))
-            return;
-
-          // if _G contains expr' with expr' < expr, remove expr'
-          tchecker::eca_amap_gen2::is_G_lesser(_Gdf,expr_x,expr_op, expr_bound);
-        }
-
-        // // if _G contains expr' with expr' >= expr, do not add (TODO)
-        // for (tchecker::typed_simple_clkconstr_expression_t const * nondiag : _Gdf)
-        // {
-        //   if (tchecker::extract_lvalue_variable_ids(nondiag->clock()).begin() == expr_x &&
-        //      ( (tchecker::const_evaluate(nondiag->bound()) > expr_bound) ||
-        //        ( (tchecker::const_evaluate(nondiag->bound()) == expr_bound) &&
-        //           (nondiag->binary_operator() == expr_op ||
-        //           (nondiag->binary_operator() == EXPR_OP_LT && expr_op == EXPR_OP_LE))
-        //        ) 
-        //      ) 
-        //     )
-        //     return;
-        // }
-
-        // std::cout << "adding " << expr << std::endl;
-        _Gdf.push_back(&expr);
+        // if _Gdf contains expr' with expr' >= expr, do not add, otherwise expr replaces expr' < expr
+        _index.add(_Gdf, expr);
       }
 
       /*!
@@ -916,34 +990,14 @@ namespace amap {
         // if expr is x-y == c, add x-y <= c, x-y >= c
         if (expr.binary_operator() == EXPR_OP_EQ)
         {
-          tchecker::typed_expression_t * left = dynamic_cast<tchecker::typed_expression_t *>(expr.left_operand().clone());
-
-          tchecker::typed_diagonal_clkconstr_expression_t * le_expr, * ge_expr;
-
-          le_expr = new tchecker::typed_diagonal_clkconstr_expression_t(EXPR_TYPE_CLKCONSTR_DIAGONAL, EXPR_OP_LE, left, new tchecker::typed_int_expression_t(EXPR_TYPE_INTTERM, expr_bound));
-          ge_expr = new tchecker::typed_diagonal_clkconstr_expression_t(EXPR_TYPE_CLKCONSTR_DIAGONAL, EXPR_OP_GE, left, new tchecker::typed_int_expression_t(EXPR_TYPE_INTTERM, expr_bound));
-
-          add_constraint(*le_expr, _G, _Gdf);
-          add_constraint(*ge_expr, _G, _Gdf);
+          tchecker::amap::constraint_factory_t & factory = _index.factory();
+          add_constraint(*factory.diagonal(expr.first_clock(), expr.second_clock(), EXPR_OP_LE, expr_bound), _G, _Gdf, _index);
+          add_constraint(*factory.diagonal(expr.first_clock(), expr.second_clock(), EXPR_OP_GE, expr_bound), _G, _Gdf, _index);
           return;
         }
 
-        // extracting details of expr
-        tchecker::clock_id_t expr_x, expr_y;
-        expr_x = tchecker::extract_lvalue_variable_ids(expr.first_clock()).begin();
-        expr_y = tchecker::extract_lvalue_variable_ids(expr.second_clock()).begin();
-        tchecker::binary_operator_t expr_op = expr.binary_operator();
-
         // if expr is already present in _G, do not add
-        for (tchecker::typed_diagonal_clkconstr_expression_t const * diag : _G)
-        {
-          if (tchecker::extract_lvalue_variable_ids(diag->first_clock()).begin() == expr_x &&
-              tchecker::extract_lvalue_variable_ids(diag->second_clock()).begin() == expr_y &&
-              diag->binary_operator() == expr_op &&
-              tchecker::const_evaluate(diag->bound()) == expr_bound)
-            return;
-        }
-        _G.push_back(&expr);
+        _index.add(_G, expr);
       }
 
       // Other visitors on expressions
@@ -1000,12 +1054,7 @@ namespace amap {
         if (value >= 0) return;
 
         // add the constraint x>=c to _Gdf
-        tchecker::typed_var_expression_t const * stmt_x = dynamic_cast<tchecker::typed_var_expression_t const *>(& stmt.lclock());
-        assert(stmt_x != nullptr);
-
-        tchecker::typed_simple_clkconstr_expression_t const * x_ge_c = new tchecker::typed_simple_clkconstr_expression_t(EXPR_TYPE_CLKCONSTR_SIMPLE, EXPR_OP_GE, new tchecker::typed_var_expression_t(EXPR_TYPE_CLKVAR, stmt_x->name(), stmt_x->id(), stmt_x->size()), new tchecker::typed_int_expression_t(EXPR_TYPE_INTTERM, -value));
-
-        tchecker::amap::add_constraint(*x_ge_c, _G, _Gdf);
+        tchecker::amap::add_constraint(*_index.factory().simple(stmt.lclock(), EXPR_OP_GE, -value), _G, _Gdf, _index);
       }
 
       // Other visitors on statements
@@ -1019,15 +1068,24 @@ namespace amap {
     protected:
       std::vector<tchecker::typed_diagonal_clkconstr_expression_t const *> & _G;
       std::vector<tchecker::typed_simple_clkconstr_expression_t const *> & _Gdf;
+      tchecker::amap::constraint_index_t & _index;
   };
 
   void add_constraint(tchecker::typed_expression_t const & g, std::vector<tchecker::typed_diagonal_clkconstr_expression_t const *> & G, 
-  std::vector<tchecker::typed_simple_clkconstr_expression_t const *> & Gdf)
+  std::vector<tchecker::typed_simple_clkconstr_expression_t const *> & Gdf, tchecker::amap::constraint_index_t & index)
   {
-    tchecker::amap::amap_updater_t updater(G, Gdf);
+    tchecker::amap::amap_updater_t updater(G, Gdf, index);
     g.visit(updater);
   }
 
+  void add_constraint(tchecker::typed_expression_t const & g, std::vector<tchecker::typed_diagonal_clkconstr_expression_t const *> & G, 
+  std::vector<tchecker::typed_simple_clkconstr_expression_t const *> & Gdf)
+  {
+    tchecker::amap::constraint_index_t index{false, tchecker::amap::default_factory()};
+    index.build(G, Gdf);
+    tchecker::amap::add_constraint(g, G, Gdf, index);
+  }
+
   class update_extractor_t : public tchecker::typed_statement_visitor_t
   {
     public:
@@ -1655,6 +1713,7 @@ namespace amap {
                             tchecker::typed_statement_t const & up, 
                             std::vector<tchecker::typed_diagonal_clkconstr_expression_t const *> & G,
                             std::vector<tchecker::typed_simple_clkconstr_expression_t const *> & Gdf,
+                            tchecker::amap::constraint_index_t & index,
                             tchecker::integer_t const & cutoff_bound,
                             bool & stabilized)
   {
@@ -1673,7 +1732,8 @@ namespace amap {
     // if (extract_constant(*pre) > cutoff_bound)
     //   throw std::runtime_error("this algorithm cannot check reachability in this input automaton: non-terminating fixpoint computation");
     
-    tchecker::amap::add_constraint(*pre, G, Gdf);
+    tchecker::amap::add_constraint(*pre, G, Gdf, index);
+    delete pre; // the constraints in pre have been interned
   }
 
   tchecker::integer_t find_cutoff_bound(tchecker::ta::system_t const & system)
@@ -1716,96 +1776,350 @@ namespace amap {
     return cutoff_bound;
   }
 
+  /*!
+  \brief Strongly connected components of the location graph of a system
+  */
+  struct sccs_t {
+    std::vector<std::vector<tchecker::loc_id_t>> locations;  /*!< Map : SCC -> locations */
+    std::vector<std::size_t> scc;                            /*!< Map : location -> SCC */
+    std::vector<std::vector<std::size_t>> predecessors;      /*!< Map : SCC -> predecessor SCCs */
+    std::vector<std::size_t> successors_count;               /*!< Map : SCC -> number of successor SCCs */
+  };
+
+  /*!
+  \brief Compute the strongly connected components of the location graph of a system
+  \param system : a system of timed processes
+  \return the SCCs of the graph with the locations of system as vertices and the
+  edges of system as edges, in reverse topological order (i.e. every SCC comes
+  after all the SCCs reachable from it)
+  \note this is Tarjan's algorithm, with an explicit stack
+  */
+  static tchecker::amap::sccs_t location_sccs(tchecker::ta::system_t const & system)
+  {
+    std::size_t const UNDEFINED = std::numeric_limits<std::size_t>::max();
+    std::size_t const locations_count = system.locations_count();
+
+    std::vector<std::vector<tchecker::loc_id_t>> successors(locations_count);
+    for (tchecker::system::edge_const_shared_ptr_t const & edge : system.edges())
+      successors[edge->src()].push_back(edge->tgt());
+
+    tchecker::amap::sccs_t sccs;
+    sccs.scc.assign(locations_count, UNDEFINED);
+
+    std::vector<std::size_t> index(locations_count, UNDEFINED), lowlink(locations_count, 0);
+    std::vector<bool> on_stack(locations_count, false);
+    std::vector<tchecker::loc_id_t> stack;
+    std::vector<std::pair<tchecker::loc_id_t, std::size_t>> calls; // (location, next successor)
+    std::size_t counter = 0;
+
+    for (tchecker::loc_id_t root = 0; root < locations_count; ++root) {
+      if (index[root] != UNDEFINED)
+        continue;
+
+      index[root] = lowlink[root] = counter++;
+      stack.push_back(root);
+      on_stack[root] = true;
+      calls.emplace_back(root, 0);
+
+      while (!calls.empty()) {
+        tchecker::loc_id_t const l = calls.back().first;
+        std::size_t const next = calls.back().second;
+
+        if (next < successors[l].size()) {
+          ++calls.back().second;
+          tchecker::loc_id_t const succ = successors[l][next];
+          if (index[succ] == UNDEFINED) {
+            index[succ] = lowlink[succ] = counter++;
+            stack.push_back(succ);
+            on_stack[succ] = true;
+            calls.emplace_back(succ, 0);
+          }
+          else if (on_stack[succ])
+            lowlink[l] = std::min(lowlink[l], index[succ]);
+          continue;
+        }
+
+        // l is the root of an SCC: pop it from the stack
+        if (lowlink[l] == index[l]) {
+          std::size_t const id = sccs.locations.size();
+          sccs.locations.emplace_back();
+          tchecker::loc_id_t top;
+          do {
+            top = stack.back();
+            stack.pop_back();
+            on_stack[top] = false;
+            sccs.scc[top] = id;
+            sccs.locations[id].push_back(top);
+          } while (top != l);
+        }
+
+        calls.pop_back();
+        if (!calls.empty())
+          lowlink[calls.back().first] = std::min(lowlink[calls.back().first], lowlink[l]);
+      }
+    }
+
+    // edges between SCCs
+    std::vector<std::pair<std::size_t, std::size_t>> scc_edges;
+    for (tchecker::system::edge_const_shared_ptr_t const & edge : system.edges())
+      if (sccs.scc[edge->src()] != sccs.scc[edge->tgt()])
+        scc_edges.emplace_back(sccs.scc[edge->src()], sccs.scc[edge->tgt()]);
+    std::sort(scc_edges.begin(), scc_edges.end());
+    scc_edges.erase(std::unique(scc_edges.begin(), scc_edges.end()), scc_edges.end());
+
+    sccs.predecessors.resize(sccs.locations.size());
+    sccs.successors_count.assign(sccs.locations.size(), 0);
+    for (auto && [src, tgt] : scc_edges) {
+      sccs.predecessors[tgt].push_back(src);
+      ++sccs.successors_count[src];
+    }
+
+    return sccs;
+  }
+
+  /*!
+  \brief Compute the edges of a system inside each SCC of its location graph
+  \param system : a system of timed processes
+  \param sccs : SCCs of the location graph of system
+  \return map : location identifier -> identifiers of the edges with that location
+  as target, and a source location in the same SCC
+  */
+  static std::vector<std::vector<tchecker::edge_id_t>> internal_incoming_edges(tchecker::ta::system_t const & system,
+                                                                                tchecker::amap::sccs_t const & sccs)
+  {
+    std::vector<std::vector<tchecker::edge_id_t>> incoming(system.locations_count());
+    for (tchecker::system::edge_const_shared_ptr_t const & edge : system.edges())
+      if (sccs.scc[edge->src()] == sccs.scc[edge->tgt()])
+        incoming[edge->tgt()].push_back(edge->id());
+    return incoming;
+  }
+
+  /*!
+  \brief Compute the edges of a system that leave each location
+  \param system : a system of timed processes
+  \return map : location identifier -> identifiers of the edges with that location as source
+  */
+  static std::vector<std::vector<tchecker::edge_id_t>> outgoing_edges(tchecker::ta::system_t const & system)
+  {
+    std::vector<std::vector<tchecker::edge_id_t>> outgoing(system.locations_count());
+    for (tchecker::system::edge_const_shared_ptr_t const & edge : system.edges())
+      outgoing[edge->src()].push_back(edge->id());
+    return outgoing;
+  }
+
+  /*!
+  \brief Solve the SCCs of a location graph in reverse topological order
+  \param sccs : SCCs of a location graph
+  \param threads : number of threads
+  \param solve : function that solves an SCC
+  \post solve has been called on every SCC, after it has been called on all the
+  successors of that SCC. With more than one thread, independent SCCs are solved
+  concurrently
+  \throw any exception thrown by solve (the other SCCs may not be solved then)
+  */
+  static void solve_sccs(tchecker::amap::sccs_t const & sccs, unsigned int threads,
+                         std::function<void(std::size_t)> const & solve)
+  {
+    std::size_t const sccs_count = sccs.locations.size();
+
+    if (threads <= 1 || sccs_count <= 1) {
+      for (std::size_t id = 0; id < sccs_count; ++id)
+        solve(id);
+      return;
+    }
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<std::size_t> pending(sccs.successors_count);
+    std::deque<std::size_t> ready;
+    std::size_t solved = 0;
+    std::exception_ptr error = nullptr;
+
+    for (std::size_t id = 0; id < sccs_count; ++id)
+      if (pending[id] == 0)
+        ready.push_back(id);
+
+    auto worker = [&]() {
+      std::unique_lock<std::mutex> lock{mutex};
+      while (true) {
+        cv.wait(lock, [&]() { return !ready.empty() || solved == sccs_count || error != nullptr; });
+        if (ready.empty() || error != nullptr)
+          return;
+
+        std::size_t const id = ready.front();
+        ready.pop_front();
+        lock.unlock();
+
+        try {
+          solve(id);
+        }
+        catch (...) {
+          lock.lock();
+          error = std::current_exception();
+          cv.notify_all();
+          return;
+        }
+
+        lock.lock();
+        ++solved;
+        for (std::size_t pred : sccs.predecessors[id])
+          if (--pending[pred] == 0)
+            ready.push_back(pred);
+        cv.notify_all();
+      }
+    };
+
+    std::vector<std::thread> workers;
+    for (unsigned int i = 0; i < std::min<std::size_t>(threads, sccs_count); ++i)
+      workers.emplace_back(worker);
+    for (std::thread & t : workers)
+      t.join();
+
+    if (error != nullptr)
+      std::rethrow_exception(error);
+  }
+
+  // Worklist algorithm: an edge is (re-)processed only when G or Gdf of its
+  // target location has changed, and it only propagates the constraints of its
+  // target that have not been propagated along it yet. Constraints that are
+  // removed from G or Gdf are never deallocated, hence they are identified by
+  // their address.
+  // Constraints only flow backward along edges, hence the SCCs of the location
+  // graph are solved in reverse topological order: when an SCC is solved, the
+  // constraints of its successors are final. Each SCC has its own worklist, and
+  // independent SCCs (e.g. in distinct processes) are solved concurrently
   bool find_fixpoint(tchecker::ta::system_t const & system,
-                     tchecker::amap::a_map_t & amap)
+                     tchecker::amap::a_map_t & amap,
+                     std::vector<tchecker::amap::constraint_index_t> & index,
+                     unsigned int threads)
   {
-    bool stabilized = false;
+    std::chrono::time_point<std::chrono::steady_clock> const start_time = std::chrono::steady_clock::now();
+    tchecker::amap::fixpoint_stats_t & stats = amap.fixpoint_stats();
     tchecker::integer_t cutoff_bound = find_cutoff_bound(system);
 
-    while (!stabilized)
-    {
-      stabilized = true;
-      // for every edge of the automaton
-      for (tchecker::system::edge_const_shared_ptr_t const & edge : system.edges())
+    tchecker::amap::sccs_t const sccs = tchecker::amap::location_sccs(system);
+    std::vector<std::vector<tchecker::edge_id_t>> const incoming = tchecker::amap::internal_incoming_edges(system, sccs);
+    std::vector<std::vector<tchecker::edge_id_t>> const outgoing = tchecker::amap::outgoing_edges(system);
+    std::vector<std::unordered_set<void const *>> propagated(system.edges_count());
+    std::vector<char> queued(system.edges_count(), 0); // not std::vector<bool>: accessed concurrently
+    std::mutex stats_mutex;
+
+    auto solve = [&](std::size_t scc) {
+      unsigned long iterations = 0, propagations = 0;
+
+      std::deque<tchecker::edge_id_t> waiting;
+      for (tchecker::loc_id_t loc : sccs.locations[scc])
+        for (tchecker::edge_id_t id : outgoing[loc]) {
+          queued[id] = 1;
+          waiting.push_back(id);
+        }
+
+      std::vector<tchecker::typed_diagonal_clkconstr_expression_t const *> G_before, G_loop;
+      std::vector<tchecker::typed_simple_clkconstr_expression_t const *> Gdf_before, Gdf_loop;
+      tchecker::amap::constraint_index_t index_loop{false, amap.factory()};
+
+      while (!waiting.empty())
       {
-        size_t G_size_before = amap.G(edge->src()).size();
-        size_t Gdf_size_before = amap.Gdf(edge->src()).size();
+        tchecker::edge_id_t const id = waiting.front();
+        waiting.pop_front();
+        queued[id] = 0;
+        ++iterations;
 
-        tchecker::typed_expression_t const & guard = system.guard(edge->id());
-        tchecker::typed_statement_t const & up = system.statement(edge->id());
-        // std::cout << "ani:-232123453 " << up.to_string() << " " << up.type() << std::endl;
-        std::vector<tchecker::typed_diagonal_clkconstr_expression_t const *> *G = nullptr;
-        std::vector<tchecker::typed_simple_clkconstr_expression_t const *> *Gdf = nullptr;
+        tchecker::system::edge_const_shared_ptr_t const edge = system.edge(id);
+        G_before = amap.G(edge->src());
+        Gdf_before = amap.Gdf(edge->src());
 
-        if (edge->src() != edge->tgt())
-        {
-          G = &amap.G(edge->src());
-          Gdf = &amap.Gdf(edge->src());
-        }
-        else
-        {
-          G = new std::vector<tchecker::typed_diagonal_clkconstr_expression_t const *>();
-          Gdf = new std::vector<tchecker::typed_simple_clkconstr_expression_t const *>();
-        }
+        tchecker::typed_expression_t const & guard = system.guard(id);
+        tchecker::typed_statement_t const & up = system.statement(id);
+
+        // constraints propagated along a self-loop are first collected, then added
+        // to G[src], Gdf[src] (which are also G[tgt], Gdf[tgt])
+        bool const self_loop = (edge->src() == edge->tgt());
+        std::vector<tchecker::typed_diagonal_clkconstr_expression_t const *> & G = (self_loop ? G_loop : amap.G(edge->src()));
+        std::vector<tchecker::typed_simple_clkconstr_expression_t const *> & Gdf = (self_loop ? Gdf_loop : amap.Gdf(edge->src()));
+        tchecker::amap::constraint_index_t & src_index = (self_loop ? index_loop : index[edge->src()]);
 
         bool wrong_stabilized = true;
 
-        // propagate every diagonal constraint from G[tgt] to G[src]
+        // propagate every new diagonal constraint from G[tgt] to G[src]
         for (tchecker::typed_diagonal_clkconstr_expression_t const * diag : amap.G(edge->tgt()))
-          propagate_constraint<tchecker::typed_diagonal_clkconstr_expression_t>(diag, guard, up, *G, *Gdf, cutoff_bound, wrong_stabilized);
+          if (propagated[id].insert(diag).second) {
+            propagate_constraint<tchecker::typed_diagonal_clkconstr_expression_t>(diag, guard, up, G, Gdf, src_index, cutoff_bound, wrong_stabilized);
+            ++propagations;
+          }
 
-        // propagate every non-diagonal constraint from Gdf[tgt] to G[src]
+        // propagate every new non-diagonal constraint from Gdf[tgt] to G[src]
         for (tchecker::typed_simple_clkconstr_expression_t const * nondiag : amap.Gdf(edge->tgt()))
-        {
-          propagate_constraint<tchecker::typed_simple_clkconstr_expression_t>(nondiag, guard, up, *G, *Gdf, cutoff_bound, wrong_stabilized);
-        }
+          if (propagated[id].insert(nondiag).second) {
+            propagate_constraint<tchecker::typed_simple_clkconstr_expression_t>(nondiag, guard, up, G, Gdf, src_index, cutoff_bound, wrong_stabilized);
+            ++propagations;
+          }
 
-        if (edge->src() == edge->tgt())
+        if (self_loop)
         {
-          for (auto & diag : *G)
-            tchecker::amap::add_constraint(*diag, amap.G(edge->src()), amap.Gdf(edge->src()));
-          
-          G->clear();
-          
-          for (auto & nondiag : *Gdf)
-            tchecker::amap::add_constraint(*nondiag, amap.G(edge->src()), amap.Gdf(edge->src()));
-          
-          Gdf->clear();
+          for (auto & diag : G_loop)
+            tchecker::amap::add_constraint(*diag, amap.G(edge->src()), amap.Gdf(edge->src()), index[edge->src()]);
+          G_loop.clear();
+
+          for (auto & nondiag : Gdf_loop)
+            tchecker::amap::add_constraint(*nondiag, amap.G(edge->src()), amap.Gdf(edge->src()), index[edge->src()]);
+          Gdf_loop.clear();
+          index_loop.clear();
         }
 
-        if (amap.G(edge->src()).size() != G_size_before ||
-            amap.Gdf(edge->src()).size() != Gdf_size_before)
-          stabilized = false;
+        // NB: subsumption may replace a constraint in Gdf[src] without changing its size
+        if (amap.G(edge->src()) != G_before || amap.Gdf(edge->src()) != Gdf_before)
+          for (tchecker::edge_id_t in : incoming[edge->src()])
+            if (!queued[in]) {
+              queued[in] = 1;
+              waiting.push_back(in);
+            }
       }
-    }
+
+      std::lock_guard<std::mutex> lock{stats_mutex};
+      stats.iterations() += iterations;
+      stats.propagations() += propagations;
+    };
+
+    tchecker::amap::solve_sccs(sccs, threads, solve);
+
+    stats.sccs() = sccs.locations.size();
+    stats.threads() = std::max(threads, 1u);
+    std::chrono::duration<double> const duration = std::chrono::steady_clock::now() - start_time;
+    stats.running_time() = duration.count();
     return true;
   }
 
-  bool compute_amap(tchecker::ta::system_t const & system, tchecker::amap::a_map_t & amap)
+  bool compute_amap(tchecker::ta::system_t const & system, tchecker::amap::a_map_t & amap, unsigned int threads)
   {
+    std::vector<tchecker::amap::constraint_index_t> index(system.locations_count(),
+                                                          tchecker::amap::constraint_index_t{false, amap.factory()});
+
     // add atomic constraints in invariants to G[loc]
     for (tchecker::system::loc_const_shared_ptr_t const & loc : system.locations())
       tchecker::amap::add_constraint(system.invariant(loc->id()), 
                                      amap.G(loc->id()), 
-                                     amap.Gdf(loc->id()));
+                                     amap.Gdf(loc->id()),
+                                     index[loc->id()]);
 
     // add atomic constraints of guards to G[src], Gdf[src]
     // add constraint for updates x := -c + x to Gdf[src]
     for (tchecker::system::edge_const_shared_ptr_t const & edge : system.edges())
       tchecker::amap::add_constraint(system.guard(edge->id()),
                                      amap.G(edge->src()), 
-                                     amap.Gdf(edge->src()));
+                                     amap.Gdf(edge->src()),
+                                     index[edge->src()]);
     
     // compute fixpoint
-    return find_fixpoint(system, amap);
+    return find_fixpoint(system, amap, index, threads);
   }
 
-  tchecker::amap::a_map_t * compute_amap(tchecker::ta::system_t const & system)
+  tchecker::amap::a_map_t * compute_amap(tchecker::ta::system_t const & system, unsigned int threads)
   {
     tchecker::amap::a_map_t * amap =
         new tchecker::amap::a_map_t{system.locations_count()};
 
-    if (tchecker::amap::compute_amap(system, *amap))
+    if (tchecker::amap::compute_amap(system, *amap, threads))
     {
       // std::cout << *amap << std::endl;
       return amap;
@@ -2465,13 +2779,16 @@ namespace eca_amap_gen2 {
     public:
       /*!
       \brief Constructor
-      \param G   : a set of diagonal constraints
-      \param Gdf : a set of non-diagonal constraints
+      \param G     : a set of diagonal constraints
+      \param Gdf   : a set of non-diagonal constraints
+      \param prophecy_clock_ids : identifiers of prophecy clocks
+      \param index : index of G and Gdf
       */
       amap_updater_t(std::vector<tchecker::typed_diagonal_clkconstr_expression_t const *> & G, 
                       std::vector<tchecker::typed_simple_clkconstr_expression_t const *> & Gdf,
-                      std::vector<int> prophecy_clock_ids)
-      : _G(G), _Gdf(Gdf), _prophecy_clock_ids(prophecy_clock_ids)
+                      std::vector<int> prophecy_clock_ids,
+                      tchecker::amap::constraint_index_t & index)
+      : _G(G), _Gdf(Gdf), _prophecy_clock_ids(prophecy_clock_ids), _index(index)
       {
       }
 
@@ -2481,7 +2798,7 @@ namespace eca_amap_gen2 {
       \post this is a copy of updater
       */
       amap_updater_t(tchecker::eca_amap_gen2::amap_updater_t const & updater)
-          : _G(updater._G), _Gdf(updater._Gdf), _prophecy_clock_ids(updater._prophecy_clock_ids)
+          : _G(updater._G), _Gdf(updater._Gdf), _prophecy_clock_ids(updater._prophecy_clock_ids), _index(updater._index)
       {
       }
 
@@ -2513,6 +2830,7 @@ namespace eca_amap_gen2 {
           _G = updater._G;
           _Gdf = updater._Gdf;
           _prophecy_clock_ids = updater._prophecy_clock_ids;
+          _index = updater._index;
         }
         return *this;
       }
@@ -2529,6 +2847,7 @@ namespace eca_amap_gen2 {
           _G = std::move(updater._G);
           _Gdf = std::move(updater._Gdf);
           _prophecy_clock_ids = std::move(updater._prophecy_clock_ids);
+          _index = std::move(updater._index);
         }
         return *this;
       }
@@ -2563,7 +2882,6 @@ namespace eca_amap_gen2 {
         // extracting details of expr
         tchecker::clock_id_t expr_x;
         expr_x = tchecker::extract_lvalue_variable_ids(expr.clock()).begin();
-        tchecker::binary_operator_t expr_op = expr.binary_operator();
         
         auto iter = std::find(_prophecy_clock_ids.begin(), _prophecy_clock_ids.end(), (int)(expr_x));
         if (iter!=_prophecy_clock_ids.end()) return; //if this is a prophecy clock then return because strongest prophecy clock bounds already present in G-sim
@@ -2572,30 +2890,15 @@ namespace eca_amap_gen2 {
         // if expr is x == c, add x <= c, x >= c
         if (expr.binary_operator() == EXPR_OP_EQ)
         {
-          tchecker::typed_expression_t * left = dynamic_cast<tchecker::typed_expression_t *>(expr.left_operand().clone());
-
-          tchecker::typed_simple_clkconstr_expression_t * le_expr, * ge_expr;
-
-          le_expr = new tchecker::typed_simple_clkconstr_expression_t(EXPR_TYPE_CLKCONSTR_SIMPLE, EXPR_OP_LE, left, new tchecker::typed_int_expression_t(EXPR_TYPE_INTTERM, expr_bound));
-          ge_expr = new tchecker::typed_simple_clkconstr_expression_t(EXPR_TYPE_CLKCONSTR_SIMPLE, EXPR_OP_GE, left, new tchecker::typed_int_expression_t(EXPR_TYPE_INTTERM, expr_bound));
-
-          add_constraint(*le_expr, _G, _Gdf, _prophecy_clock_ids);
-          add_constraint(*ge_expr, _G, _Gdf, _prophecy_clock_ids);
+          tchecker::amap::constraint_factory_t & factory = _index.factory();
+          add_constraint(*factory.simple(expr.clock(), EXPR_OP_LE, expr_bound), _G, _Gdf, _prophecy_clock_ids, _index);
+          add_constraint(*factory.simple(expr.clock(), EXPR_OP_GE, expr_bound), _G, _Gdf, _prophecy_clock_ids, _index);
           return;
         }
 
-        // std::cout << "_Gdf size: " << _Gdf.size() << std::endl;
-        if(_Gdf.size()>0){
-          // if _G contains expr' with expr' >= expr, do not add
-          if(tchecker::eca_amap_gen2::is_G_greater_inf(_Gdf,expr_x,expr_op, expr_bound))
-            return;
-
-          // if _G contains expr' with expr' < expr, remove expr'
-          tchecker::eca_amap_gen2::is_G_lesser_inf(_Gdf,expr_x,expr_op, expr_bound);
-        }
-
-        // std::cout << "adding " << expr << std::endl;
-        _Gdf.push_back(&expr);
+        // if _Gdf contains expr' with expr' >= expr, do not add, otherwise expr replaces expr' < expr
+        // (infinite bounds are only compared to the same bound with the same operator)
+        _index.add(_Gdf, expr);
       }
 
       /*!
@@ -2610,34 +2913,14 @@ namespace eca_amap_gen2 {
         // if expr is x-y == c, add x-y <= c, x-y >= c
         if (expr.binary_operator() == EXPR_OP_EQ)
         {
-          tchecker::typed_expression_t * left = dynamic_cast<tchecker::typed_expression_t *>(expr.left_operand().clone());
-
-          tchecker::typed_diagonal_clkconstr_expression_t * le_expr, * ge_expr;
-
-          le_expr = new tchecker::typed_diagonal_clkconstr_expression_t(EXPR_TYPE_CLKCONSTR_DIAGONAL, EXPR_OP_LE, left, new tchecker::typed_int_expression_t(EXPR_TYPE_INTTERM, expr_bound));
-          ge_expr = new tchecker::typed_diagonal_clkconstr_expression_t(EXPR_TYPE_CLKCONSTR_DIAGONAL, EXPR_OP_GE, left, new tchecker::typed_int_expression_t(EXPR_TYPE_INTTERM, expr_bound));
-
-          add_constraint(*le_expr, _G, _Gdf, _prophecy_clock_ids);
-          add_constraint(*ge_expr, _G, _Gdf, _prophecy_clock_ids);
+          tchecker::amap::constraint_factory_t & factory = _index.factory();
+          add_constraint(*factory.diagonal(expr.first_clock(), expr.second_clock(), EXPR_OP_LE, expr_bound), _G, _Gdf, _prophecy_clock_ids, _index);
+          add_constraint(*factory.diagonal(expr.first_clock(), expr.second_clock(), EXPR_OP_GE, expr_bound), _G, _Gdf, _prophecy_clock_ids, _index);
           return;
         }
 
-        // extracting details of expr
-        tchecker::clock_id_t expr_x, expr_y;
-        expr_x = tchecker::extract_lvalue_variable_ids(expr.first_clock()).begin();
-        expr_y = tchecker::extract_lvalue_variable_ids(expr.second_clock()).begin();
-        tchecker::binary_operator_t expr_op = expr.binary_operator();
-
         // if expr is already present in _G, do not add
-        for (tchecker::typed_diagonal_clkconstr_expression_t const * diag : _G)
-        {
-          if (tchecker::extract_lvalue_variable_ids(diag->first_clock()).begin() == expr_x &&
-              tchecker::extract_lvalue_variable_ids(diag->second_clock()).begin() == expr_y &&
-              diag->binary_operator() == expr_op &&
-              tchecker::const_evaluate(diag->bound()) == expr_bound)
-            return;
-        }
-        _G.push_back(&expr);
+        _index.add(_G, expr);
       }
 
       // Other visitors on expressions
@@ -2704,7 +2987,7 @@ namespace eca_amap_gen2 {
 
         tchecker::typed_simple_clkconstr_expression_t const * x_ge_c = new tchecker::typed_simple_clkconstr_expression_t(EXPR_TYPE_CLKCONSTR_SIMPLE, EXPR_OP_GE, new tchecker::typed_var_expression_t(EXPR_TYPE_CLKVAR, stmt_x->name(), stmt_x->id(), stmt_x->size()), new tchecker::typed_int_expression_t(EXPR_TYPE_INTTERM, -value));
 
-        tchecker::eca_amap_gen2::add_constraint(*x_ge_c, _G, _Gdf, _prophecy_clock_ids);
+        tchecker::eca_amap_gen2::add_constraint(*x_ge_c, _G, _Gdf, _prophecy_clock_ids, _index);
         */
       }
 
@@ -2720,17 +3003,29 @@ namespace eca_amap_gen2 {
       std::vector<tchecker::typed_diagonal_clkconstr_expression_t const *> & _G;
       std::vector<tchecker::typed_simple_clkconstr_expression_t const *> & _Gdf;
       std::vector<int> _prophecy_clock_ids;
+      tchecker::amap::constraint_index_t & _index;
   };
 
   void add_constraint(tchecker::typed_expression_t const & g, 
   std::vector<tchecker::typed_diagonal_clkconstr_expression_t const *> & G, 
   std::vector<tchecker::typed_simple_clkconstr_expression_t const *> & Gdf,
-  const std::vector<int> &prophecy_clock_ids)
+  const std::vector<int> &prophecy_clock_ids,
+  tchecker::amap::constraint_index_t & index)
   {
-    tchecker::eca_amap_gen2::amap_updater_t updater(G, Gdf, prophecy_clock_ids);
+    tchecker::eca_amap_gen2::amap_updater_t updater(G, Gdf, prophecy_clock_ids, index);
     g.visit(updater);
   }
 
+  void add_constraint(tchecker::typed_expression_t const & g, 
+  std::vector<tchecker::typed_diagonal_clkconstr_expression_t const *> & G, 
+  std::vector<tchecker::typed_simple_clkconstr_expression_t const *> & Gdf,
+  const std::vector<int> &prophecy_clock_ids)
+  {
+    tchecker::amap::constraint_index_t index{true, tchecker::amap::default_factory()};
+    index.build(G, Gdf);
+    tchecker::eca_amap_gen2::add_constraint(g, G, Gdf, prophecy_clock_ids, index);
+  }
+
 
 
   
@@ -2962,7 +3257,8 @@ namespace eca_amap_gen2 {
                    tchecker::typed_statement_t const & up,
                    std::vector<tchecker::typed_diagonal_clkconstr_expression_t const *> & G, 
                    std::vector<tchecker::typed_simple_clkconstr_expression_t const *> & Gdf,
-                   std::vector<int> prophecy_clocks)
+                   std::vector<int> const & prophecy_clocks,
+                   tchecker::amap::constraint_index_t & index)
   {
     
     // std::cout << "ani:::::;-111: " << up.to_string() << std::endl;
@@ -3089,7 +3385,8 @@ namespace eca_amap_gen2 {
       //G.append(pre)
       if(pre!=nullptr){
         // std::cout << "ani:adding constraint: " << pre->to_string() << std::endl;
-        tchecker::eca_amap_gen2::add_constraint(*pre,  G,  Gdf, prophecy_clocks);
+        tchecker::eca_amap_gen2::add_constraint(*pre,  G,  Gdf, prophecy_clocks, index);
+        delete pre; // the constraints in pre have been interned
       }
       // if(pre->type()==tchecker::expression_type_t::EXPR_TYPE_CLKCONSTR_SIMPLE){
         
@@ -3113,7 +3410,8 @@ namespace eca_amap_gen2 {
                             tchecker::typed_statement_t const & up, 
                             std::vector<tchecker::typed_diagonal_clkconstr_expression_t const *> & G,
                             std::vector<tchecker::typed_simple_clkconstr_expression_t const *> & Gdf,
-                            std::vector<int> prophecy_clocks)
+                            std::vector<int> const & prophecy_clocks,
+                            tchecker::amap::constraint_index_t & index)
   {
     assert( (phi->type() == EXPR_TYPE_CLKCONSTR_SIMPLE) || 
             (phi->type() == EXPR_TYPE_CLKCONSTR_DIAGONAL) );
@@ -3129,91 +3427,123 @@ namespace eca_amap_gen2 {
     // if (extract_constant(*pre) > cutoff_bound)
     //   throw std::runtime_error("this algorithm cannot check reachability in this input automaton: non-terminating fixpoint computation");
     
-    tchecker::eca_amap_gen2::add_constraint(*pre, G, Gdf, prophecy_clocks);
+    tchecker::eca_amap_gen2::add_constraint(*pre, G, Gdf, prophecy_clocks, index);
+    delete pre; // the constraints in pre have been interned
   }
 
 
+  // Same SCC-based worklist algorithm as tchecker::amap::find_fixpoint
   bool find_fixpoint(tchecker::ta::system_t const & system,
-                     tchecker::eca_amap_gen2::eca_a_map_t & amap)
+                     tchecker::eca_amap_gen2::eca_a_map_t & amap,
+                     std::vector<tchecker::amap::constraint_index_t> & index,
+                     unsigned int threads)
   {
-    bool stabilized = false;
-    // tchecker::integer_t cutoff_bound = find_cutoff_bound(system);
+    std::chrono::time_point<std::chrono::steady_clock> const start_time = std::chrono::steady_clock::now();
+    tchecker::amap::fixpoint_stats_t & stats = amap.fixpoint_stats();
+
+    tchecker::amap::sccs_t const sccs = tchecker::amap::location_sccs(system);
+    std::vector<std::vector<tchecker::edge_id_t>> const incoming = tchecker::amap::internal_incoming_edges(system, sccs);
+    std::vector<std::vector<tchecker::edge_id_t>> const outgoing = tchecker::amap::outgoing_edges(system);
+    std::vector<std::unordered_set<void const *>> propagated(system.edges_count());
+    std::vector<char> queued(system.edges_count(), 0); // not std::vector<bool>: accessed concurrently
+    std::mutex stats_mutex;
+
+    auto solve = [&](std::size_t scc) {
+      unsigned long iterations = 0, propagations = 0;
+
+      std::deque<tchecker::edge_id_t> waiting;
+      for (tchecker::loc_id_t loc : sccs.locations[scc])
+        for (tchecker::edge_id_t id : outgoing[loc]) {
+          queued[id] = 1;
+          waiting.push_back(id);
+        }
 
-    while (!stabilized)
-    {
-      stabilized = true;
-      // for every edge of the automaton
-      for (tchecker::system::edge_const_shared_ptr_t const & edge : system.edges())
-      {
-        size_t G_size_before = amap.G(edge->src()).size();
-        size_t Gdf_size_before = amap.Gdf(edge->src()).size();
+      std::vector<tchecker::typed_diagonal_clkconstr_expression_t const *> G_before, G_loop;
+      std::vector<tchecker::typed_simple_clkconstr_expression_t const *> Gdf_before, Gdf_loop;
+      tchecker::amap::constraint_index_t index_loop{true, amap.factory()};
 
-        tchecker::typed_expression_t const & guard = system.guard(edge->id());
-        tchecker::typed_statement_t const & up = system.statement(edge->id());
-        // std::cout << "ani:-301 updates: " << up.to_string() << " " << up.type() << std::endl;   //updates is the set/list of all updates and not a single update/ ofc the list may be empty or contain a single update
+      while (!waiting.empty())
+      {
+        tchecker::edge_id_t const id = waiting.front();
+        waiting.pop_front();
+        queued[id] = 0;
+        ++iterations;
 
-        std::vector<tchecker::typed_diagonal_clkconstr_expression_t const *> *G = nullptr;
-        std::vector<tchecker::typed_simple_clkconstr_expression_t const *> *Gdf = nullptr;
+        tchecker::system::edge_const_shared_ptr_t const edge = system.edge(id);
+        G_before = amap.G(edge->src());
+        Gdf_before = amap.Gdf(edge->src());
 
-        if (edge->src() != edge->tgt())
-        {
-          G = &amap.G(edge->src());
-          Gdf = &amap.Gdf(edge->src());
-        }
-        else
-        {
-          G = new std::vector<tchecker::typed_diagonal_clkconstr_expression_t const *>();
-          Gdf = new std::vector<tchecker::typed_simple_clkconstr_expression_t const *>();
-        }
+        tchecker::typed_expression_t const & guard = system.guard(id);
+        tchecker::typed_statement_t const & up = system.statement(id);
 
+        // constraints propagated along a self-loop are first collected, then added
+        // to G[src], Gdf[src] (which are also G[tgt], Gdf[tgt])
+        bool const self_loop = (edge->src() == edge->tgt());
+        std::vector<tchecker::typed_diagonal_clkconstr_expression_t const *> & G = (self_loop ? G_loop : amap.G(edge->src()));
+        std::vector<tchecker::typed_simple_clkconstr_expression_t const *> & Gdf = (self_loop ? Gdf_loop : amap.Gdf(edge->src()));
+        tchecker::amap::constraint_index_t & src_index = (self_loop ? index_loop : index[edge->src()]);
 
-        // propagate every diagonal constraint from G[tgt] to G[src]
+        // propagate every new diagonal constraint from G[tgt] to G[src]
         for (tchecker::typed_diagonal_clkconstr_expression_t const * diag : amap.G(edge->tgt()))
-          propagate_constraint<tchecker::typed_diagonal_clkconstr_expression_t>(diag, guard, up, *G, *Gdf, system.prophecy_clock_ids);
+          if (propagated[id].insert(diag).second) {
+            propagate_constraint<tchecker::typed_diagonal_clkconstr_expression_t>(diag, guard, up, G, Gdf, system.prophecy_clock_ids, src_index);
+            ++propagations;
+          }
 
-        // propagate every non-diagonal constraint from Gdf[tgt] to G[src]
+        // propagate every new non-diagonal constraint from Gdf[tgt] to G[src]
         for (tchecker::typed_simple_clkconstr_expression_t const * nondiag : amap.Gdf(edge->tgt()))
-        {
-          propagate_constraint<tchecker::typed_simple_clkconstr_expression_t>(nondiag, guard, up, *G, *Gdf, system.prophecy_clock_ids);
-        }
+          if (propagated[id].insert(nondiag).second) {
+            propagate_constraint<tchecker::typed_simple_clkconstr_expression_t>(nondiag, guard, up, G, Gdf, system.prophecy_clock_ids, src_index);
+            ++propagations;
+          }
 
-        if (edge->src() == edge->tgt())
+        if (self_loop)
         {
-          for (auto & diag : *G)
-            tchecker::eca_amap_gen2::add_constraint(*diag, amap.G(edge->src()), amap.Gdf(edge->src()), system.prophecy_clock_ids);
-          
-          G->clear();
-          
-          for (auto & nondiag : *Gdf)
-            tchecker::eca_amap_gen2::add_constraint(*nondiag, amap.G(edge->src()), amap.Gdf(edge->src()),system.prophecy_clock_ids);
-          
-          Gdf->clear();
+          for (auto & diag : G_loop)
+            tchecker::eca_amap_gen2::add_constraint(*diag, amap.G(edge->src()), amap.Gdf(edge->src()), system.prophecy_clock_ids, index[edge->src()]);
+          G_loop.clear();
+
+          for (auto & nondiag : Gdf_loop)
+            tchecker::eca_amap_gen2::add_constraint(*nondiag, amap.G(edge->src()), amap.Gdf(edge->src()), system.prophecy_clock_ids, index[edge->src()]);
+          Gdf_loop.clear();
+          index_loop.clear();
         }
 
-        if (amap.G(edge->src()).size() != G_size_before ||
-            amap.Gdf(edge->src()).size() != Gdf_size_before)
-          stabilized = false;
+        // NB: subsumption may replace a constraint in Gdf[src] without changing its size
+        if (amap.G(edge->src()) != G_before || amap.Gdf(edge->src()) != Gdf_before)
+          for (tchecker::edge_id_t in : incoming[edge->src()])
+            if (!queued[in]) {
+              queued[in] = 1;
+              waiting.push_back(in);
+            }
       }
-    }
 
+      std::lock_guard<std::mutex> lock{stats_mutex};
+      stats.iterations() += iterations;
+      stats.propagations() += propagations;
+    };
 
+    tchecker::amap::solve_sccs(sccs, threads, solve);
+
+    stats.sccs() = sccs.locations.size();
+    stats.threads() = std::max(threads, 1u);
+    std::chrono::duration<double> const duration = std::chrono::steady_clock::now() - start_time;
+    stats.running_time() = duration.count();
     return true;
   }
 
-  bool compute_eca_amap(tchecker::ta::system_t const & system, tchecker::eca_amap_gen2::eca_a_map_t & amap)
+  bool compute_eca_amap(tchecker::ta::system_t const & system, tchecker::eca_amap_gen2::eca_a_map_t & amap,
+                        unsigned int threads)
   {
     //add prophecy clock <=0 and prophecy clock >=0 constraints in Gmap
+    //(the same two instances are shared by all locations)
     for(auto i:system.prophecy_clock_ids){
+      tchecker::typed_var_expression_t const clock_var(EXPR_TYPE_CLKVAR, system.clock_name(i), i, 1);
+      tchecker::typed_simple_clkconstr_expression_t const *prop_le_0 = amap.factory().simple(clock_var, EXPR_OP_LE, 0);
+      tchecker::typed_simple_clkconstr_expression_t const *prop_ge_0 = amap.factory().simple(clock_var, EXPR_OP_GE, 0);
       for (tchecker::system::loc_const_shared_ptr_t const & loc : system.locations()){
-        std::string clk_name = system.clock_name(i);
-        tchecker::typed_expression_t *new_clock_var = new tchecker::typed_var_expression_t(EXPR_TYPE_CLKVAR, clk_name, i, 1);
-        tchecker::typed_simple_clkconstr_expression_t const *prop_le_0 = new tchecker::typed_simple_clkconstr_expression_t(EXPR_TYPE_CLKCONSTR_SIMPLE, EXPR_OP_LE, new_clock_var, new tchecker::typed_int_expression_t(EXPR_TYPE_INTTERM, 0));
         amap.Gdf(loc->id()).push_back(prop_le_0);
-        
-        new_clock_var = new tchecker::typed_var_expression_t(EXPR_TYPE_CLKVAR, clk_name, i, 1);
-        tchecker::typed_simple_clkconstr_expression_t const *prop_ge_0 = new tchecker::typed_simple_clkconstr_expression_t(EXPR_TYPE_CLKCONSTR_SIMPLE, EXPR_OP_GE, new_clock_var, new tchecker::typed_int_expression_t(EXPR_TYPE_INTTERM, 0));
         amap.Gdf(loc->id()).push_back(prop_ge_0);
-        
       }
     }
 
@@ -3238,11 +3568,18 @@ namespace eca_amap_gen2 {
     // amap.Gdf(0).push_back(prop_ge_02);
     
 
+    // index of G[loc], Gdf[loc] (including prophecy clock constraints)
+    std::vector<tchecker::amap::constraint_index_t> index(system.locations_count(),
+                                                          tchecker::amap::constraint_index_t{true, amap.factory()});
+    for (tchecker::system::loc_const_shared_ptr_t const & loc : system.locations())
+      index[loc->id()].build(amap.G(loc->id()), amap.Gdf(loc->id()));
+
     // add atomic constraints in invariants to G[loc]
     for (tchecker::system::loc_const_shared_ptr_t const & loc : system.locations())
       tchecker::eca_amap_gen2::add_constraint(system.invariant(loc->id()), 
                                      amap.G(loc->id()), 
-                                     amap.Gdf(loc->id()), system.prophecy_clock_ids);
+                                     amap.Gdf(loc->id()), system.prophecy_clock_ids,
+                                     index[loc->id()]);
 
     
     // add atomic constraints of guards to G[src], Gdf[src]
@@ -3251,12 +3588,13 @@ namespace eca_amap_gen2 {
                                                      system.statement(edge->id()),
                                                      amap.G(edge->src()),
                                                      amap.Gdf(edge->src()),
-                                                     system.prophecy_clock_ids);
+                                                     system.prophecy_clock_ids,
+                                                     index[edge->src()]);
     }
     
 
     // compute fixpoint    
-    bool fix_point = find_fixpoint(system, amap);
+    bool fix_point = find_fixpoint(system, amap, index, threads);
 
     for (tchecker::system::loc_const_shared_ptr_t const & loc : system.locations()){
       
@@ -3280,12 +3618,12 @@ namespace eca_amap_gen2 {
   }
   
   // this is the topmost function that computes the amap for a GTA
-  tchecker::eca_amap_gen2::eca_a_map_t * compute_eca_amap(tchecker::ta::system_t const & system)
+  tchecker::eca_amap_gen2::eca_a_map_t * compute_eca_amap(tchecker::ta::system_t const & system, unsigned int threads)
   {
     tchecker::eca_amap_gen2::eca_a_map_t * amap =
         new tchecker::eca_amap_gen2::eca_a_map_t{system.locations_count()};
 
-    if (tchecker::eca_amap_gen2::compute_eca_amap(system, *amap))
+    if (tchecker::eca_amap_gen2::compute_eca_amap(system, *amap, threads))
     {
       // std::cout << "\nPrinting Amap:\n";
       // std::cout << *amap << std::endl;
@@ -3296,6 +3634,67 @@ namespace eca_amap_gen2 {
     return nullptr;
   }
 
+  tchecker::clockbounds::local_lu_map_t * compute_local_lu_map(tchecker::ta::system_t const & system,
+                                                               tchecker::eca_amap_gen2::eca_a_map_t const & amap)
+  {
+    tchecker::clock_id_t const clock_nb = system.clocks_count(tchecker::VK_FLATTENED);
+    tchecker::clockbounds::local_lu_map_t * lu_map = new tchecker::clockbounds::local_lu_map_t{amap.loc_number(), clock_nb};
+
+    // only normal and history clocks are abstracted (DBM index of clock id is id+1)
+    std::vector<bool> abstracted(clock_nb, false);
+    for (tchecker::clock_id_t id = 0; id < clock_nb; ++id)
+      abstracted[id] = (system.normal_clock_id_map.find(id + 1) != system.normal_clock_id_map.end() ||
+                        system.history_clock_id_map.find(id + 1) != system.history_clock_id_map.end());
+
+    for (tchecker::loc_id_t l = 0; l < amap.loc_number(); ++l) {
+      tchecker::clockbounds::map_t & L = lu_map->L(l);
+      tchecker::clockbounds::map_t & U = lu_map->U(l);
+
+      for (tchecker::typed_simple_clkconstr_expression_t const * c : amap.Gdf(l)) {
+        tchecker::clock_id_t const x = tchecker::extract_lvalue_variable_ids(c->clock()).begin();
+        tchecker::integer_t const bound = tchecker::const_evaluate(c->bound(), tchecker::clockbounds::MAX_BOUND);
+        if (bound == tchecker::dbm::INF_VALUE || bound == tchecker::dbm::MINUS_INF_VALUE) {
+          tchecker::clockbounds::update(L, x, tchecker::clockbounds::MAX_BOUND);
+          tchecker::clockbounds::update(U, x, tchecker::clockbounds::MAX_BOUND);
+          continue;
+        }
+        switch (c->binary_operator()) {
+        case tchecker::EXPR_OP_LE:
+        case tchecker::EXPR_OP_LT:
+          tchecker::clockbounds::update(U, x, bound);
+          break;
+        case tchecker::EXPR_OP_GE:
+        case tchecker::EXPR_OP_GT:
+          tchecker::clockbounds::update(L, x, bound);
+          break;
+        case tchecker::EXPR_OP_EQ:
+          tchecker::clockbounds::update(L, x, bound);
+          tchecker::clockbounds::update(U, x, bound);
+          break;
+        default:
+          tchecker::clockbounds::update(L, x, tchecker::clockbounds::MAX_BOUND);
+          tchecker::clockbounds::update(U, x, tchecker::clockbounds::MAX_BOUND);
+          break;
+        }
+      }
+
+      for (tchecker::typed_diagonal_clkconstr_expression_t const * c : amap.G(l))
+        for (tchecker::clock_id_t x : {tchecker::extract_lvalue_variable_ids(c->first_clock()).begin(),
+                                       tchecker::extract_lvalue_variable_ids(c->second_clock()).begin()}) {
+          tchecker::clockbounds::update(L, x, tchecker::clockbounds::MAX_BOUND);
+          tchecker::clockbounds::update(U, x, tchecker::clockbounds::MAX_BOUND);
+        }
+
+      for (tchecker::clock_id_t x = 0; x < clock_nb; ++x)
+        if (!abstracted[x]) {
+          tchecker::clockbounds::update(L, x, tchecker::clockbounds::MAX_BOUND);
+          tchecker::clockbounds::update(U, x, tchecker::clockbounds::MAX_BOUND);
+        }
+    }
+
+    return lu_map;
+  }
+
 } // end of namespace eca_amap_gen2
 
 
@@ -0,0 +1,734 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <getopt.h>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include "tchecker/clockbounds/clockbounds.hh"
+#include "tchecker/dbm/closure.hh"
+#include "tchecker/dbm/dbm.hh"
+#include "tchecker/dbm/refdbm.hh"
+#include "tchecker/expression/typed_expression.hh"
+#include "tchecker/utils/log.hh"
+
+/*!
+ \file dbm-bench.cc
+ \brief Micro-benchmarks of DBM operations
+ */
+
+static struct option long_options[] = {{"help", no_argument, 0, 'h'},
+                                       {"clocks", required_argument, 0, 'c'},
+                                       {"diagonals", required_argument, 0, 'd'},
+                                       {"dbms", required_argument, 0, 'n'},
+                                       {"operations", required_argument, 0, 'o'},
+                                       {"seconds", required_argument, 0, 't'},
+                                       {0, 0, 0, 0}};
+
+static char * const options = (char *)"hc:d:n:o:t:";
+
+/*!
+ \brief Names of measured operations
+ */
+static std::vector<std::string> const operation_names = {
+    "TIGHTEN",     "HASH",          "IS_LE",       "IS_ALU_LE",          "IS_G_LE",   "IS_ECA_G_LE",
+    "ECA_TIGHTEN", "ECA_CONSTRAIN", "ECA_OPEN_UP", "ECA_OPEN_UP_LAYOUT", "ECA_RESET", "ECA_RELEASE",
+    "REF_STEP"};
+
+/*!
+ \brief Spread of zones with reference clocks
+ */
+static tchecker::integer_t const REF_SPREAD = 10;
+
+void usage(char * progname)
+{
+  std::cerr << "Usage: " << progname << " [options] [dim...]" << std::endl;
+  std::cerr << "   -h          help" << std::endl;
+  std::cerr << "   -c H:P:N    ratio of history, prophecy and normal clocks in ECA zones (repeatable," << std::endl;
+  std::cerr << "               default: 1:1:1 and 1:1:0)" << std::endl;
+  std::cerr << "   -d N        number of diagonal constraints in G-simulation (default: 2)" << std::endl;
+  std::cerr << "   -n N        number of random DBMs per dimension (default: 64)" << std::endl;
+  std::cerr << "   -o OPS      comma-separated list of measured operations (default: all)" << std::endl;
+  std::cerr << "   -t SECONDS  minimal measured time per operation and dimension (default: 0.2)" << std::endl;
+  std::cerr << "measures DBM operations with every closure kernel supported by the processor:" << std::endl;
+  std::cerr << "  ";
+  for (std::string const & name : operation_names)
+    std::cerr << " " << name;
+  std::cerr << std::endl;
+  std::cerr << "dimensions default to 5 10 20 50 100 200 300" << std::endl;
+  std::cerr << "outputs one line per operation, kernel, clocks and dimension:" << std::endl;
+  std::cerr << "   OPERATION KERNEL CLOCKS DIM NS_PER_OP OPS_PER_SECOND" << std::endl;
+  std::cerr << "where CLOCKS is standard for standard zones, random for random ECA DBMs, H:P:N for ECA zones, and"
+            << std::endl;
+  std::cerr << "ref:K for zones with K=max(DIM/4,2) reference clocks (REF_STEP: step of 1 or 2 processes, i.e." << std::endl;
+  std::cerr << "open up and synchronization of their reference clocks, spread bounded by " << REF_SPREAD << "," << std::endl;
+  std::cerr << "and synchronizability check)" << std::endl;
+}
+
+/*!
+ \brief Ratio of clock kinds in ECA zones
+ */
+struct clock_mix_t {
+  unsigned int history;  /*!< Weight of history clocks */
+  unsigned int prophecy; /*!< Weight of prophecy clocks */
+  unsigned int normal;   /*!< Weight of normal clocks */
+  std::string name;      /*!< Name H:P:N of the mix */
+};
+
+/*!
+ \brief Parse a mix of clocks
+ \param s : a string H:P:N
+ \return the mix with weights H, P and N
+ \throw std::runtime_error : if s is not a valid mix
+ */
+static clock_mix_t parse_clock_mix(std::string const & s)
+{
+  std::istringstream is(s);
+  clock_mix_t mix{0, 0, 0, s};
+  char sep1 = 0, sep2 = 0;
+  is >> mix.history >> sep1 >> mix.prophecy >> sep2 >> mix.normal;
+  if (is.fail() || !is.eof() || sep1 != ':' || sep2 != ':' || mix.history + mix.prophecy + mix.normal == 0)
+    throw std::runtime_error("Invalid clock mix: " + s);
+  return mix;
+}
+
+static bool help = false;
+static std::vector<clock_mix_t> clock_mixes;
+static std::size_t diagonals_count = 2;
+static std::size_t dbms_count = 64;
+static std::set<std::string> selected_operations;
+static double min_seconds = 0.2;
+
+int parse_command_line(int argc, char * argv[])
+{
+  while (true) {
+    int long_option_index = -1;
+    int c = getopt_long(argc, argv, options, long_options, &long_option_index);
+
+    if (c == -1)
+      break;
+
+    if (c == ':')
+      throw std::runtime_error("Missing option parameter");
+    else if (c == '?')
+      throw std::runtime_error("Unknown command-line option");
+
+    switch (c) {
+    case 'h':
+      help = true;
+      break;
+    case 'c':
+      clock_mixes.push_back(parse_clock_mix(optarg));
+      break;
+    case 'd': {
+      char * end = nullptr;
+      diagonals_count = std::strtoul(optarg, &end, 10);
+      if (end == optarg || *end != '\0')
+        throw std::runtime_error("Invalid number of diagonal constraints: " + std::string(optarg));
+      break;
+    }
+    case 'n':
+      dbms_count = std::strtoul(optarg, nullptr, 10);
+      if (dbms_count == 0)
+        throw std::runtime_error("Invalid number of DBMs: " + std::string(optarg));
+      break;
+    case 'o': {
+      std::istringstream is(optarg);
+      std::string name;
+      while (std::getline(is, name, ',')) {
+        if (std::find(operation_names.begin(), operation_names.end(), name) == operation_names.end())
+          throw std::runtime_error("Unknown operation: " + name);
+        selected_operations.insert(name);
+      }
+      break;
+    }
+    case 't':
+      min_seconds = std::strtod(optarg, nullptr);
+      if (min_seconds <= 0)
+        throw std::runtime_error("Invalid time: " + std::string(optarg));
+      break;
+    default:
+      throw std::runtime_error("This should never be executed");
+      break;
+    }
+  }
+
+  return optind;
+}
+
+/*!
+ \brief Checks if an operation is measured
+ \param name : name of an operation
+ \return true if operation name has been selected on the command line, or if
+ no operation has been selected
+ */
+static bool selected(std::string const & name)
+{
+  return selected_operations.empty() || selected_operations.find(name) != selected_operations.end();
+}
+
+/*!
+ \brief Generate random non-empty DBMs
+ \param dbms : container of DBMs
+ \param count : number of DBMs
+ \param dim : dimension
+ \param eca : true for ECA DBMs, false otherwise
+ \param gen : random generator
+ \post dbms contains count non-tight DBMs of dimension dim that contain a common
+ random valuation. Unbounded entries are LE_INFINITY in ECA DBMs, LT_INFINITY
+ otherwise
+ */
+static void random_dbms(std::vector<tchecker::dbm::db_t> & dbms, std::size_t count, tchecker::clock_id_t dim, bool eca,
+                        std::mt19937 & gen)
+{
+  std::uniform_int_distribution<tchecker::integer_t> value(0, 100), slack(0, 20), unbounded(0, 3);
+  std::vector<tchecker::integer_t> v(dim);
+
+  dbms.resize(count * dim * dim);
+  for (std::size_t n = 0; n < count; ++n) {
+    tchecker::dbm::db_t * dbm = dbms.data() + n * dim * dim;
+    v[0] = 0;
+    for (tchecker::clock_id_t i = 1; i < dim; ++i)
+      v[i] = value(gen);
+    for (tchecker::clock_id_t i = 0; i < dim; ++i)
+      for (tchecker::clock_id_t j = 0; j < dim; ++j) {
+        if (i == j)
+          dbm[i * dim + j] = tchecker::dbm::LE_ZERO;
+        else if (unbounded(gen) == 0)
+          dbm[i * dim + j] = (eca ? tchecker::dbm::LE_INFINITY : tchecker::dbm::LT_INFINITY);
+        else
+          dbm[i * dim + j] = tchecker::dbm::db(tchecker::dbm::LE, v[i] - v[j] + slack(gen));
+      }
+  }
+}
+
+/*!
+ \brief Compute zones from random DBMs
+ \param zones : container of zones
+ \param up_zones : container of zones
+ \param dbms : DBMs computed by random_dbms (standard DBMs)
+ \param dim : dimension
+ \post zones contains the tight and positive DBMs obtained from dbms, and
+ up_zones contains the open up of zones (hence each DBM in zones is included in
+ the corresponding DBM in up_zones)
+ */
+static void standard_zones(std::vector<tchecker::dbm::db_t> & zones, std::vector<tchecker::dbm::db_t> & up_zones,
+                           std::vector<tchecker::dbm::db_t> const & dbms, tchecker::clock_id_t dim)
+{
+  std::size_t const size = dim * dim;
+  zones = dbms;
+  up_zones.resize(dbms.size());
+  for (std::size_t n = 0; n < dbms.size() / size; ++n) {
+    tchecker::dbm::db_t * dbm = zones.data() + n * size;
+    for (tchecker::clock_id_t i = 1; i < dim; ++i)
+      dbm[i] = std::min(dbm[i], tchecker::dbm::LE_ZERO);
+    tchecker::dbm::tighten(dbm, dim);
+    std::memcpy(up_zones.data() + n * size, dbm, size * sizeof(tchecker::dbm::db_t));
+    tchecker::dbm::open_up(up_zones.data() + n * size, dim);
+  }
+}
+
+/*!
+ \brief Clocks of ECA zones
+ \note history, prophecy and normal clocks have indices in [2,dim) grouped as
+ described by layout
+ */
+struct eca_clocks_t {
+  std::unordered_set<int> history;                      /*!< Indices of history clocks */
+  std::unordered_set<int> prophecy;                     /*!< Indices of prophecy clocks */
+  std::unordered_set<int> normal;                       /*!< Indices of normal clocks */
+  std::unordered_set<tchecker::integer_t> g_history;    /*!< Indices of history clocks (for G-simulation) */
+  std::unordered_set<tchecker::integer_t> g_prophecy;   /*!< Indices of prophecy clocks (for G-simulation) */
+  std::unordered_set<tchecker::integer_t> g_normal;     /*!< Indices of normal clocks (for G-simulation) */
+  tchecker::dbm::clock_layout_t layout;                 /*!< Layout of clocks */
+};
+
+/*!
+ \brief Compute the clocks of ECA zones
+ \param clocks : ECA clocks
+ \param dim : dimension
+ \param mix : mix of clocks
+ \post clocks has dim-2 clocks of each kind in proportion to the weights in mix
+ */
+static void eca_clocks(eca_clocks_t & clocks, tchecker::clock_id_t dim, clock_mix_t const & mix)
+{
+  unsigned int const total = mix.history + mix.prophecy + mix.normal;
+  tchecker::clock_id_t const k = dim - 2;
+  tchecker::clock_id_t history_count = k * mix.history / total;
+  tchecker::clock_id_t prophecy_count = k * mix.prophecy / total;
+  tchecker::clock_id_t normal_count = (mix.normal == 0 ? 0 : k - history_count - prophecy_count);
+  tchecker::clock_id_t const rest = k - history_count - prophecy_count - normal_count;
+  if (mix.history > 0)
+    history_count += rest;
+  else
+    prophecy_count += rest;
+
+  clocks = eca_clocks_t{};
+  for (tchecker::clock_id_t i = 2; i < dim; ++i) {
+    if (i < 2 + normal_count) {
+      clocks.normal.insert(i);
+      clocks.g_normal.insert(i);
+    }
+    else if (i < 2 + normal_count + history_count) {
+      clocks.history.insert(i);
+      clocks.g_history.insert(i);
+    }
+    else {
+      clocks.prophecy.insert(i);
+      clocks.g_prophecy.insert(i);
+    }
+  }
+  if (!tchecker::dbm::eca_clock_layout(dim, clocks.history, clocks.prophecy, clocks.normal, clocks.layout))
+    throw std::runtime_error("Unexpected layout of ECA clocks");
+}
+
+/*!
+ \brief Clock constraint x - y # value
+ */
+struct constraint_t {
+  tchecker::clock_id_t x;            /*!< First clock */
+  tchecker::clock_id_t y;            /*!< Second clock */
+  tchecker::dbm::comparator_t cmp;   /*!< Comparator */
+  tchecker::integer_t value;         /*!< Value */
+};
+
+/*!
+ \brief Generate a random guard in ECA
+ \param clocks : ECA clocks
+ \param x : index of a clock in clocks
+ \param gen : random generator
+ \return a random lower or upper bound on x, i.e. x # c or x # -c for prophecy
+ clocks
+ */
+static constraint_t random_eca_guard(eca_clocks_t const & clocks, tchecker::clock_id_t x, std::mt19937 & gen)
+{
+  std::uniform_int_distribution<tchecker::integer_t> bound(0, 100), coin(0, 1);
+  tchecker::dbm::comparator_t const cmp = (coin(gen) == 0 ? tchecker::dbm::LE : tchecker::dbm::LT);
+  tchecker::integer_t const c = bound(gen);
+  bool const prophecy = (clocks.prophecy.find(x) != clocks.prophecy.end());
+  if (coin(gen) == 0)
+    return (prophecy ? constraint_t{x, 0, cmp, -c} : constraint_t{x, 0, cmp, c});
+  return (prophecy ? constraint_t{0, x, cmp, c} : constraint_t{0, x, cmp, -c});
+}
+
+/*!
+ \brief Random ECA zones and arguments of ECA operations
+ */
+struct eca_zones_t {
+  std::string name;                              /*!< Name of the mix of clocks */
+  eca_clocks_t clocks;                           /*!< Clocks */
+  std::vector<tchecker::dbm::db_t> zones;        /*!< Reachable zones */
+  std::vector<tchecker::dbm::db_t> subzones;     /*!< Zones included in zones */
+  std::vector<constraint_t> guards;              /*!< One guard per zone */
+  std::vector<tchecker::clock_id_t> resets;      /*!< One history or normal clock per zone (if any) */
+  std::vector<tchecker::clock_id_t> releases;    /*!< One prophecy clock per zone (if any) */
+  std::vector<tchecker::typed_diagonal_clkconstr_expression_t const *> G;  /*!< Diagonal constraints */
+  std::vector<tchecker::typed_simple_clkconstr_expression_t const *> Gdf;  /*!< Non-diagonal constraints */
+};
+
+/*!
+ \brief Generate random ECA zones
+ \param eca : ECA zones with clocks
+ \param count : number of zones
+ \param dim : dimension
+ \param gen : random generator
+ \post eca.zones contains count zones of dimension dim reached by random walks
+ (guards, resets and releases followed by open up) from the initial zone,
+ eca.guards contains a random guard for each zone, eca.subzones contains each
+ zone intersected with its guard (or the zone itself if the intersection is
+ empty), eca.resets and eca.releases contain a random resettable (history or
+ normal) clock and a random prophecy clock for each zone (if any)
+ */
+static void random_eca_zones(eca_zones_t & eca, std::size_t count, tchecker::clock_id_t dim, std::mt19937 & gen)
+{
+  std::size_t const size = dim * dim;
+  eca_clocks_t const & clocks = eca.clocks;
+  std::vector<tchecker::clock_id_t> resettable, prophecy;
+  for (tchecker::clock_id_t x = 2; x < dim; ++x)
+    (clocks.prophecy.find(x) != clocks.prophecy.end() ? prophecy : resettable).push_back(x);
+
+  std::uniform_int_distribution<tchecker::clock_id_t> clock(2, std::max(dim, static_cast<tchecker::clock_id_t>(3)) - 1);
+  std::uniform_int_distribution<int> coin(0, 1);
+  std::vector<tchecker::dbm::db_t> backup(size);
+
+  eca.zones.resize(count * size);
+  eca.subzones.resize(count * size);
+  eca.guards.clear();
+  eca.resets.clear();
+  eca.releases.clear();
+  for (std::size_t n = 0; n < count; ++n) {
+    tchecker::dbm::db_t * dbm = eca.zones.data() + n * size;
+    tchecker::dbm::eca_zero(dbm, dim, clocks.layout);
+    tchecker::dbm::eca_open_up(dbm, dim, clocks.layout);
+    for (tchecker::clock_id_t step = 0; dim > 2 && step < std::min(dim, static_cast<tchecker::clock_id_t>(64)); ++step) {
+      tchecker::clock_id_t const x = clock(gen);
+      constraint_t const g = random_eca_guard(clocks, x, gen);
+      std::memcpy(backup.data(), dbm, size * sizeof(tchecker::dbm::db_t));
+      if (tchecker::dbm::eca_constrain(dbm, dim, g.x, g.y, g.cmp, g.value, clocks.history, clocks.prophecy,
+                                       clocks.normal) == tchecker::dbm::EMPTY) {
+        std::memcpy(dbm, backup.data(), size * sizeof(tchecker::dbm::db_t));
+        continue;
+      }
+      if (clocks.prophecy.find(x) != clocks.prophecy.end())
+        tchecker::dbm::eca_release(dbm, dim, x, clocks.history, clocks.prophecy, clocks.normal);
+      else if (coin(gen) == 0)
+        tchecker::dbm::eca_reset(dbm, dim, x, clocks.history, clocks.prophecy, clocks.normal);
+      tchecker::dbm::eca_open_up(dbm, dim, clocks.layout);
+    }
+
+    tchecker::dbm::db_t * subzone = eca.subzones.data() + n * size;
+    std::memcpy(subzone, dbm, size * sizeof(tchecker::dbm::db_t));
+    constraint_t const g = (dim > 2 ? random_eca_guard(clocks, clock(gen), gen)
+                                    : constraint_t{0, 0, tchecker::dbm::LE, 0});
+    eca.guards.push_back(g);
+    if (tchecker::dbm::eca_constrain(subzone, dim, g.x, g.y, g.cmp, g.value, clocks.history, clocks.prophecy,
+                                     clocks.normal) == tchecker::dbm::EMPTY)
+      std::memcpy(subzone, dbm, size * sizeof(tchecker::dbm::db_t));
+
+    if (!resettable.empty())
+      eca.resets.push_back(resettable[gen() % resettable.size()]);
+    if (!prophecy.empty())
+      eca.releases.push_back(prophecy[gen() % prophecy.size()]);
+  }
+}
+
+/*!
+ \brief Generate random constraints for G-simulation
+ \param G : diagonal constraints
+ \param Gdf : non-diagonal constraints
+ \param factory : factory of constraints
+ \param clocks : clock variables
+ \param first : first clock
+ \param gen : random generator
+ \post G contains diagonals_count random diagonal constraints over
+ clocks[first..] (if there are at least 2 such clocks), and Gdf contains a random lower bound and a
+ random upper bound, each with probability 1/2, for each clock in clocks[first..]
+ */
+static void random_g(std::vector<tchecker::typed_diagonal_clkconstr_expression_t const *> & G,
+                     std::vector<tchecker::typed_simple_clkconstr_expression_t const *> & Gdf,
+                     tchecker::amap::constraint_factory_t & factory,
+                     std::vector<std::unique_ptr<tchecker::typed_var_expression_t>> const & clocks, std::size_t first,
+                     std::mt19937 & gen)
+{
+  std::uniform_int_distribution<tchecker::integer_t> bound(0, 100), diagonal_bound(-50, 50);
+  std::uniform_int_distribution<int> coin(0, 1);
+
+  G.clear();
+  Gdf.clear();
+  for (std::size_t x = first; x < clocks.size(); ++x) {
+    if (coin(gen) == 0)
+      Gdf.push_back(factory.simple(*clocks[x], (coin(gen) == 0 ? tchecker::EXPR_OP_LE : tchecker::EXPR_OP_LT), bound(gen)));
+    if (coin(gen) == 0)
+      Gdf.push_back(factory.simple(*clocks[x], (coin(gen) == 0 ? tchecker::EXPR_OP_GE : tchecker::EXPR_OP_GT), bound(gen)));
+  }
+  if (clocks.size() < first + 2)
+    return;
+  std::uniform_int_distribution<std::size_t> clock(first, clocks.size() - 1);
+  while (G.size() < diagonals_count) {
+    std::size_t const x = clock(gen), y = clock(gen);
+    if (x != y)
+      G.push_back(factory.diagonal(*clocks[x], *clocks[y], (coin(gen) == 0 ? tchecker::EXPR_OP_LE : tchecker::EXPR_OP_LT),
+                                   diagonal_bound(gen)));
+  }
+}
+
+/*!
+ \brief Zones with reference clocks
+ */
+struct ref_zones_t {
+  std::unique_ptr<tchecker::reference_clock_variables_t> r; /*!< Reference clocks */
+  std::vector<tchecker::dbm::db_t> zones;                   /*!< Spread-bounded zones */
+  std::vector<boost::dynamic_bitset<>> sync;                /*!< Reference clocks of the step from each zone */
+  std::string name;                                         /*!< Name ref:K, K reference clocks */
+};
+
+/*!
+ \brief Generate random zones with reference clocks
+ \param ref : zones with reference clocks
+ \param count : number of zones
+ \param dim : dimension
+ \param gen : random generator
+ \post ref has max(dim/4,2) reference clocks (one per process), and dim minus
+ that many offset clocks spread over the processes. ref.zones contains count
+ zones reached by letting time elapse asynchronously from zero, bounding the
+ value of each clock, and bounding the spread by REF_SPREAD. ref.sync contains
+ the reference clocks of one or two processes for each zone, alternately
+ */
+static void random_ref_zones(ref_zones_t & ref, std::size_t count, tchecker::clock_id_t dim, std::mt19937 & gen)
+{
+  tchecker::clock_id_t const refcount = std::max<tchecker::clock_id_t>(dim / 4, 2);
+  std::vector<std::string> refclocks;
+  for (tchecker::clock_id_t t = 0; t < refcount; ++t)
+    refclocks.push_back("$" + std::to_string(t));
+  ref.r.reset(new tchecker::reference_clock_variables_t(refclocks));
+  for (tchecker::clock_id_t x = refcount; x < dim; ++x)
+    ref.r->declare("x" + std::to_string(x), refclocks[x % refcount]);
+  ref.name = "ref:" + std::to_string(refcount);
+
+  tchecker::reference_clock_variables_t const & r = *ref.r;
+  std::uniform_int_distribution<tchecker::integer_t> value(0, 50);
+  std::uniform_int_distribution<tchecker::clock_id_t> process(0, refcount - 1);
+
+  boost::dynamic_bitset<> delay_allowed(refcount);
+  delay_allowed.set();
+  ref.zones.resize(count * dim * dim);
+  ref.sync.assign(count, boost::dynamic_bitset<>(refcount));
+  for (std::size_t n = 0; n < count; ++n) {
+    tchecker::dbm::db_t * rdbm = ref.zones.data() + n * dim * dim;
+    tchecker::refdbm::zero(rdbm, r);
+    tchecker::refdbm::asynchronous_open_up(rdbm, r, delay_allowed);
+    for (tchecker::clock_id_t x = refcount; x < dim; ++x)
+      tchecker::refdbm::constrain(rdbm, r, r.refmap()[x], x, tchecker::dbm::LE, value(gen));
+    tchecker::refdbm::bound_spread(rdbm, r, REF_SPREAD);
+
+    ref.sync[n].set(process(gen));
+    if (n % 2 == 1)
+      ref.sync[n].set(process(gen));
+  }
+}
+
+/*!
+ \brief Sink for the results of measured operations
+ */
+static volatile std::size_t sink = 0;
+
+/*!
+ \brief Measure an operation
+ \param dbms : DBMs
+ \param dim : dimension of DBMs
+ \param operation : operation, called with a copy of the n-th DBM in dbms and n
+ \return average time (in nanoseconds) of operation on a copy of a DBM in dbms,
+ excluding the time to copy
+ */
+template <class OPERATION>
+static double measure(std::vector<tchecker::dbm::db_t> const & dbms, tchecker::clock_id_t dim, OPERATION && operation)
+{
+  std::size_t const size = dim * dim;
+  std::size_t const count = dbms.size() / size;
+  std::vector<tchecker::dbm::db_t> work(size);
+
+  auto run = [&](std::size_t rounds, bool apply) {
+    std::size_t result = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t r = 0; r < rounds; ++r)
+      for (std::size_t n = 0; n < count; ++n) {
+        std::memcpy(work.data(), dbms.data() + n * size, size * sizeof(tchecker::dbm::db_t));
+        if (apply)
+          result += static_cast<std::size_t>(operation(work.data(), n));
+      }
+    double const time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    sink = result;
+    return time;
+  };
+
+  std::size_t rounds = 1;
+  double time = run(rounds, true);
+  while (time < min_seconds) {
+    rounds *= 2;
+    time = run(rounds, true);
+  }
+  double const copy_time = run(rounds, false);
+
+  return std::max(time - copy_time, 0.0) * 1e9 / static_cast<double>(rounds * count);
+}
+
+/*!
+ \brief Output a measure
+ \param operation : name of operation
+ \param kernel : closure kernel
+ \param clocks : kind of clocks
+ \param dim : dimension
+ \param ns : time (in nanoseconds) per operation
+ \post a line OPERATION KERNEL CLOCKS DIM NS_PER_OP OPS_PER_SECOND has been
+ output to std::cout (OPS_PER_SECOND is 0 if ns is 0)
+ */
+static void report(std::string const & operation, enum tchecker::dbm::closure_kernel_t kernel, std::string const & clocks,
+                   tchecker::clock_id_t dim, double ns)
+{
+  std::cout << operation << " " << tchecker::dbm::closure_kernel_name(kernel) << " " << clocks << " " << dim << " " << ns
+            << " " << (ns > 0 ? 1e9 / ns : 0) << std::endl;
+}
+
+int main(int argc, char * argv[])
+{
+  try {
+    int optindex = parse_command_line(argc, argv);
+
+    if (help) {
+      usage(argv[0]);
+      return EXIT_SUCCESS;
+    }
+
+    std::vector<tchecker::clock_id_t> dims;
+    for (int i = optindex; i < argc; ++i) {
+      unsigned long dim = std::strtoul(argv[i], nullptr, 10);
+      if (dim < 2)
+        throw std::runtime_error("Invalid dimension: " + std::string(argv[i]));
+      dims.push_back(static_cast<tchecker::clock_id_t>(dim));
+    }
+    if (dims.empty())
+      dims = {5, 10, 20, 50, 100, 200, 300};
+
+    if (clock_mixes.empty())
+      clock_mixes = {parse_clock_mix("1:1:1"), parse_clock_mix("1:1:0")};
+
+    enum tchecker::dbm::closure_kernel_t const kernels[] = {tchecker::dbm::CLOSURE_SCALAR, tchecker::dbm::CLOSURE_SSE41,
+                                                            tchecker::dbm::CLOSURE_AVX2};
+    std::mt19937 gen(0);
+    std::vector<tchecker::dbm::db_t> dbms, eca_dbms, zones, up_zones;
+
+    for (tchecker::clock_id_t dim : dims) {
+      std::size_t const size = dim * dim;
+      random_dbms(dbms, dbms_count, dim, false, gen);
+      random_dbms(eca_dbms, dbms_count, dim, true, gen);
+      standard_zones(zones, up_zones, dbms, dim);
+
+      // Clock bounds for aLU, and clock variables for G-simulation (clock x is DBM index x+1)
+      std::uniform_int_distribution<tchecker::integer_t> bound(0, 100);
+      std::vector<tchecker::integer_t> l(dim - 1), u(dim - 1);
+      for (tchecker::clock_id_t x = 0; x < dim - 1; ++x) {
+        l[x] = (gen() % 4 == 0 ? -tchecker::dbm::INF_VALUE : bound(gen));
+        u[x] = (gen() % 4 == 0 ? -tchecker::dbm::INF_VALUE : bound(gen));
+      }
+
+      std::vector<std::unique_ptr<tchecker::typed_var_expression_t>> clocks;
+      for (tchecker::clock_id_t x = 0; x < dim - 1; ++x)
+        clocks.emplace_back(
+            new tchecker::typed_var_expression_t{tchecker::EXPR_TYPE_CLKVAR, "x" + std::to_string(x), x, 1});
+      tchecker::amap::constraint_factory_t factory;
+      std::vector<tchecker::typed_diagonal_clkconstr_expression_t const *> G;
+      std::vector<tchecker::typed_simple_clkconstr_expression_t const *> Gdf;
+      random_g(G, Gdf, factory, clocks, 0, gen);
+
+      // ECA zones (the tmp clock, DBM index 1, is not constrained by G-simulation)
+      std::vector<eca_zones_t> ecas(clock_mixes.size());
+      for (std::size_t i = 0; i < clock_mixes.size(); ++i) {
+        ecas[i].name = clock_mixes[i].name;
+        eca_clocks(ecas[i].clocks, dim, clock_mixes[i]);
+        random_eca_zones(ecas[i], dbms_count, dim, gen);
+        random_g(ecas[i].G, ecas[i].Gdf, factory, clocks, 1, gen);
+      }
+
+      // Zones with reference clocks
+      ref_zones_t ref;
+      random_ref_zones(ref, dbms_count, dim, gen);
+
+      for (enum tchecker::dbm::closure_kernel_t kernel : kernels) {
+        if (!tchecker::dbm::closure_kernel_supported(kernel))
+          continue;
+        tchecker::dbm::set_closure_kernel(kernel);
+
+        // Steps in zones with reference clocks do not depend on the closure kernel
+        if (selected("REF_STEP") && kernel == tchecker::dbm::CLOSURE_SCALAR)
+          report("REF_STEP", kernel, ref.name, dim, measure(ref.zones, dim, [&](tchecker::dbm::db_t * rdbm, std::size_t n) {
+                   tchecker::refdbm::asynchronous_open_up(rdbm, *ref.r, ref.sync[n]);
+                   if (tchecker::refdbm::synchronize(rdbm, *ref.r, ref.sync[n]) == tchecker::dbm::EMPTY)
+                     return false;
+                   if (tchecker::refdbm::incremental_bound_spread(rdbm, *ref.r, REF_SPREAD, ref.sync[n]) ==
+                       tchecker::dbm::EMPTY)
+                     return false;
+                   return tchecker::refdbm::is_synchronizable(rdbm, *ref.r);
+                 }));
+
+        if (selected("TIGHTEN"))
+          report("TIGHTEN", kernel, "standard", dim, measure(dbms, dim, [&](tchecker::dbm::db_t * dbm, std::size_t) {
+                   return tchecker::dbm::tighten(dbm, dim);
+                 }));
+
+        if (selected("HASH"))
+          report("HASH", kernel, "standard", dim, measure(zones, dim, [&](tchecker::dbm::db_t * dbm, std::size_t) {
+                   return tchecker::dbm::hash(dbm, dim);
+                 }));
+
+        if (selected("IS_LE"))
+          report("IS_LE", kernel, "standard", dim, measure(zones, dim, [&](tchecker::dbm::db_t * dbm, std::size_t n) {
+                   return tchecker::dbm::is_le(dbm, up_zones.data() + n * size, dim);
+                 }));
+
+        if (selected("IS_ALU_LE"))
+          report("IS_ALU_LE", kernel, "standard", dim, measure(zones, dim, [&](tchecker::dbm::db_t * dbm, std::size_t n) {
+                   return tchecker::dbm::is_alu_le(dbm, up_zones.data() + n * size, dim, l.data(), u.data());
+                 }));
+
+        if (selected("IS_G_LE"))
+          report("IS_G_LE", kernel, "standard", dim, measure(zones, dim, [&](tchecker::dbm::db_t * dbm, std::size_t n) {
+                   return tchecker::dbm::is_g_le(dbm, up_zones.data() + n * size, dim, G, Gdf);
+                 }));
+
+        if (selected("ECA_TIGHTEN"))
+          report("ECA_TIGHTEN", kernel, "random", dim, measure(eca_dbms, dim, [&](tchecker::dbm::db_t * dbm, std::size_t) {
+                   return tchecker::dbm::eca_tighten(dbm, dim);
+                 }));
+
+        for (eca_zones_t & eca : ecas) {
+          eca_clocks_t const & c = eca.clocks;
+
+          if (selected("IS_ECA_G_LE"))
+            report("IS_ECA_G_LE", kernel, eca.name, dim,
+                   measure(eca.subzones, dim, [&](tchecker::dbm::db_t * dbm, std::size_t n) {
+                     return tchecker::dbm::is_eca_g_le(dbm, eca.zones.data() + n * size, dim, eca.G, eca.Gdf,
+                                                       c.g_history, c.g_prophecy, c.g_normal);
+                   }));
+
+          if (selected("ECA_CONSTRAIN"))
+            report("ECA_CONSTRAIN", kernel, eca.name, dim,
+                   measure(eca.zones, dim, [&](tchecker::dbm::db_t * dbm, std::size_t n) {
+                     constraint_t const & g = eca.guards[n];
+                     return tchecker::dbm::eca_constrain(dbm, dim, g.x, g.y, g.cmp, g.value, c.history, c.prophecy,
+                                                         c.normal);
+                   }));
+
+          if (selected("ECA_OPEN_UP"))
+            report("ECA_OPEN_UP", kernel, eca.name, dim,
+                   measure(eca.subzones, dim, [&](tchecker::dbm::db_t * dbm, std::size_t) {
+                     tchecker::dbm::eca_open_up(dbm, dim, c.history, c.prophecy, c.normal);
+                     return 0;
+                   }));
+
+          if (selected("ECA_OPEN_UP_LAYOUT"))
+            report("ECA_OPEN_UP_LAYOUT", kernel, eca.name, dim,
+                   measure(eca.subzones, dim, [&](tchecker::dbm::db_t * dbm, std::size_t) {
+                     tchecker::dbm::eca_open_up(dbm, dim, c.layout);
+                     return 0;
+                   }));
+
+          if (selected("ECA_RESET") && !eca.resets.empty())
+            report("ECA_RESET", kernel, eca.name, dim,
+                   measure(eca.zones, dim, [&](tchecker::dbm::db_t * dbm, std::size_t n) {
+                     tchecker::dbm::eca_reset(dbm, dim, eca.resets[n], c.history, c.prophecy, c.normal);
+                     return 0;
+                   }));
+
+          if (selected("ECA_RELEASE") && !eca.releases.empty())
+            report("ECA_RELEASE", kernel, eca.name, dim,
+                   measure(eca.zones, dim, [&](tchecker::dbm::db_t * dbm, std::size_t n) {
+                     tchecker::dbm::eca_release(dbm, dim, eca.releases[n], c.history, c.prophecy, c.normal);
+                     return 0;
+                   }));
+        }
+      }
+    }
+  }
+  catch (std::exception & e) {
+    std::cerr << tchecker::log_error << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,405 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <stdexcept>
+#include <string>
+
+#include "tchecker/dbm/closure.hh"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && ((INTEGER_T_SIZE == 32) || (INTEGER_T_SIZE == 64))
+#define TCHECKER_DBM_CLOSURE_X86
+#include <immintrin.h>
+#endif
+
+namespace tchecker {
+
+namespace dbm {
+
+#define DBM(i, j) dbm[(i)*dim + (j)]
+
+/*!
+ \brief Scalar kernel
+ \param row_i : row to tighten
+ \param row_k : row of the intermediate clock k
+ \param k : intermediate clock
+ \param begin : first column
+ \param end : past-the-end column
+ \post for j from begin to end-1, row_i[j] is the minimum of row_i[j] and the
+ sum of row_i[k] and row_k[j] (tchecker::dbm::eca_sum if ECA is true,
+ tchecker::dbm::sum otherwise)
+ \note row_i and row_k may be the same row. row_i[k] is read for every column,
+ as it may be updated when j == k
+ */
+template <bool ECA>
+static void tighten_row_scalar(tchecker::dbm::db_t * row_i, tchecker::dbm::db_t const * row_k, tchecker::clock_id_t k,
+                               tchecker::clock_id_t begin, tchecker::clock_id_t end)
+{
+  for (tchecker::clock_id_t j = begin; j < end; ++j)
+    row_i[j] = tchecker::dbm::min((ECA ? tchecker::dbm::eca_sum(row_i[k], row_k[j]) : tchecker::dbm::sum(row_i[k], row_k[j])),
+                                  row_i[j]);
+}
+
+/*
+ Vectorised kernels compute the sum of difference bounds a and b as
+ (a + b) - ((a | b) & 1), which is the encoding of the sum of values with
+ comparator LE if both a and b are LE and LT otherwise (see
+ tchecker::dbm::sum). Lanes where b is an infinity sentinel (LT_INFINITY for
+ sum, LT_INFINITY, LE_INFINITY and LE_MINUS_INFINITY for eca_sum) yield b.
+ Unless DBM_UNSAFE is defined, the kernels detect lanes where the sum is not
+ representable (overflow of a + b or value out of [MINUS_INF_VALUE,INF_VALUE])
+ and run the scalar kernel on the corresponding block, that throws the same
+ exception at the same column.
+ The vectorised kernels require a = row_i[k] to be constant along the row: the
+ caller checks that row_i and row_k differ, that a is not an infinity sentinel,
+ and that (k,k) is <=0 if k is in the range of columns.
+ */
+
+#if defined(TCHECKER_DBM_CLOSURE_X86)
+
+#if (INTEGER_T_SIZE == 32)
+
+__attribute__((target("avx2"))) static inline __m256i avx2_set1(tchecker::dbm::db_t x) { return _mm256_set1_epi32(x); }
+__attribute__((target("avx2"))) static inline __m256i avx2_add(__m256i x, __m256i y) { return _mm256_add_epi32(x, y); }
+__attribute__((target("avx2"))) static inline __m256i avx2_sub(__m256i x, __m256i y) { return _mm256_sub_epi32(x, y); }
+__attribute__((target("avx2"))) static inline __m256i avx2_cmpeq(__m256i x, __m256i y) { return _mm256_cmpeq_epi32(x, y); }
+__attribute__((target("avx2"))) static inline __m256i avx2_cmpgt(__m256i x, __m256i y) { return _mm256_cmpgt_epi32(x, y); }
+__attribute__((target("avx2"))) static inline __m256i avx2_min(__m256i x, __m256i y) { return _mm256_min_epi32(x, y); }
+
+#elif (INTEGER_T_SIZE == 64)
+
+__attribute__((target("avx2"))) static inline __m256i avx2_set1(tchecker::dbm::db_t x) { return _mm256_set1_epi64x(x); }
+__attribute__((target("avx2"))) static inline __m256i avx2_add(__m256i x, __m256i y) { return _mm256_add_epi64(x, y); }
+__attribute__((target("avx2"))) static inline __m256i avx2_sub(__m256i x, __m256i y) { return _mm256_sub_epi64(x, y); }
+__attribute__((target("avx2"))) static inline __m256i avx2_cmpeq(__m256i x, __m256i y) { return _mm256_cmpeq_epi64(x, y); }
+__attribute__((target("avx2"))) static inline __m256i avx2_cmpgt(__m256i x, __m256i y) { return _mm256_cmpgt_epi64(x, y); }
+__attribute__((target("avx2"))) static inline __m256i avx2_min(__m256i x, __m256i y)
+{
+  return _mm256_blendv_epi8(x, y, _mm256_cmpgt_epi64(x, y));
+}
+
+#endif
+
+/*!
+ \brief AVX2 kernel (see tighten_row_scalar)
+ */
+template <bool ECA>
+__attribute__((target("avx2"))) static void tighten_row_avx2(tchecker::dbm::db_t * row_i, tchecker::dbm::db_t const * row_k,
+                                                             tchecker::clock_id_t k, tchecker::clock_id_t begin,
+                                                             tchecker::clock_id_t end)
+{
+  tchecker::clock_id_t const width = sizeof(__m256i) / sizeof(tchecker::dbm::db_t);
+  __m256i const a = avx2_set1(row_i[k]);
+  __m256i const one = avx2_set1(1);
+  __m256i const lt_infinity = avx2_set1(tchecker::dbm::LT_INFINITY);
+  __m256i const le_infinity = avx2_set1(tchecker::dbm::LE_INFINITY);
+  __m256i const le_minus_infinity = avx2_set1(tchecker::dbm::LE_MINUS_INFINITY);
+#if !defined(DBM_UNSAFE)
+  __m256i const zero = _mm256_setzero_si256();
+  __m256i const lowest = avx2_set1(tchecker::dbm::LE_MINUS_INFINITY - 1);
+#endif
+
+  tchecker::clock_id_t j = begin;
+  for (; j + width <= end; j += width) {
+    __m256i const b = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(row_k + j));
+    __m256i const d = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(row_i + j));
+
+    __m256i const t = avx2_add(a, b);
+    __m256i s = avx2_sub(t, _mm256_and_si256(_mm256_or_si256(a, b), one));
+
+    __m256i special = avx2_cmpeq(b, lt_infinity);
+    if (ECA)
+      special = _mm256_or_si256(special, _mm256_or_si256(avx2_cmpeq(b, le_infinity), avx2_cmpeq(b, le_minus_infinity)));
+
+#if !defined(DBM_UNSAFE)
+    __m256i overflow = avx2_cmpgt(zero, _mm256_and_si256(_mm256_xor_si256(a, t), _mm256_xor_si256(b, t)));
+    overflow = _mm256_or_si256(overflow, _mm256_or_si256(avx2_cmpgt(lowest, s), avx2_cmpgt(s, le_infinity)));
+    overflow = _mm256_andnot_si256(special, overflow);
+    if (!_mm256_testz_si256(overflow, overflow)) {
+      tighten_row_scalar<ECA>(row_i, row_k, k, j, j + width);
+      continue;
+    }
+#endif
+
+    s = _mm256_blendv_epi8(s, b, special);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(row_i + j), avx2_min(s, d));
+  }
+
+  tighten_row_scalar<ECA>(row_i, row_k, k, j, end);
+}
+
+#if (INTEGER_T_SIZE == 32)
+
+/*!
+ \brief SSE4.1 kernel (see tighten_row_scalar)
+ \note 32-bit difference bounds only: comparison of 64-bit integers requires
+ SSE4.2
+ */
+template <bool ECA>
+__attribute__((target("sse4.1"))) static void tighten_row_sse41(tchecker::dbm::db_t * row_i, tchecker::dbm::db_t const * row_k,
+                                                                tchecker::clock_id_t k, tchecker::clock_id_t begin,
+                                                                tchecker::clock_id_t end)
+{
+  tchecker::clock_id_t const width = sizeof(__m128i) / sizeof(tchecker::dbm::db_t);
+  __m128i const a = _mm_set1_epi32(row_i[k]);
+  __m128i const one = _mm_set1_epi32(1);
+  __m128i const lt_infinity = _mm_set1_epi32(tchecker::dbm::LT_INFINITY);
+  __m128i const le_infinity = _mm_set1_epi32(tchecker::dbm::LE_INFINITY);
+  __m128i const le_minus_infinity = _mm_set1_epi32(tchecker::dbm::LE_MINUS_INFINITY);
+#if !defined(DBM_UNSAFE)
+  __m128i const zero = _mm_setzero_si128();
+  __m128i const lowest = _mm_set1_epi32(tchecker::dbm::LE_MINUS_INFINITY - 1);
+#endif
+
+  tchecker::clock_id_t j = begin;
+  for (; j + width <= end; j += width) {
+    __m128i const b = _mm_loadu_si128(reinterpret_cast<__m128i const *>(row_k + j));
+    __m128i const d = _mm_loadu_si128(reinterpret_cast<__m128i const *>(row_i + j));
+
+    __m128i const t = _mm_add_epi32(a, b);
+    __m128i s = _mm_sub_epi32(t, _mm_and_si128(_mm_or_si128(a, b), one));
+
+    __m128i special = _mm_cmpeq_epi32(b, lt_infinity);
+    if (ECA)
+      special = _mm_or_si128(special, _mm_or_si128(_mm_cmpeq_epi32(b, le_infinity), _mm_cmpeq_epi32(b, le_minus_infinity)));
+
+#if !defined(DBM_UNSAFE)
+    __m128i overflow = _mm_cmpgt_epi32(zero, _mm_and_si128(_mm_xor_si128(a, t), _mm_xor_si128(b, t)));
+    overflow = _mm_or_si128(overflow, _mm_or_si128(_mm_cmpgt_epi32(lowest, s), _mm_cmpgt_epi32(s, le_infinity)));
+    overflow = _mm_andnot_si128(special, overflow);
+    if (!_mm_testz_si128(overflow, overflow)) {
+      tighten_row_scalar<ECA>(row_i, row_k, k, j, j + width);
+      continue;
+    }
+#endif
+
+    s = _mm_blendv_epi8(s, b, special);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(row_i + j), _mm_min_epi32(s, d));
+  }
+
+  tighten_row_scalar<ECA>(row_i, row_k, k, j, end);
+}
+
+#endif // INTEGER_T_SIZE == 32
+
+#endif // TCHECKER_DBM_CLOSURE_X86
+
+/*!
+ \brief Scalar kernel (see tchecker::dbm::alu_row_witness)
+ */
+static enum tchecker::dbm::alu_row_status_t alu_row_witness_scalar(tchecker::dbm::db_t const * row1,
+                                                                   tchecker::dbm::db_t const * row2,
+                                                                   tchecker::dbm::db_t lt_minus_ly,
+                                                                   tchecker::dbm::db_t const * thresholds,
+                                                                   tchecker::clock_id_t begin, tchecker::clock_id_t end)
+{
+  try {
+    for (tchecker::clock_id_t x = begin; x < end; ++x)
+      if (row2[x] < row1[x] && tchecker::dbm::sum(row2[x], lt_minus_ly) < thresholds[x])
+        return tchecker::dbm::ALU_ROW_WITNESS;
+  }
+  catch (std::invalid_argument const &) {
+    return tchecker::dbm::ALU_ROW_OVERFLOW;
+  }
+  return tchecker::dbm::ALU_ROW_NO_WITNESS;
+}
+
+#if defined(TCHECKER_DBM_CLOSURE_X86)
+
+/*!
+ \brief AVX2 kernel (see tchecker::dbm::alu_row_witness)
+ \note sums are computed as in tighten_row_avx2, with row2[x] as the varying
+ operand
+ */
+__attribute__((target("avx2"))) static enum tchecker::dbm::alu_row_status_t
+alu_row_witness_avx2(tchecker::dbm::db_t const * row1, tchecker::dbm::db_t const * row2, tchecker::dbm::db_t lt_minus_ly,
+                     tchecker::dbm::db_t const * thresholds, tchecker::clock_id_t begin, tchecker::clock_id_t end)
+{
+  tchecker::clock_id_t const width = sizeof(__m256i) / sizeof(tchecker::dbm::db_t);
+  __m256i const a = avx2_set1(lt_minus_ly);
+  __m256i const one = avx2_set1(1);
+  __m256i const lt_infinity = avx2_set1(tchecker::dbm::LT_INFINITY);
+#if !defined(DBM_UNSAFE)
+  __m256i const zero = _mm256_setzero_si256();
+  __m256i const lowest = avx2_set1(tchecker::dbm::LE_MINUS_INFINITY - 1);
+  __m256i const le_infinity = avx2_set1(tchecker::dbm::LE_INFINITY);
+#endif
+
+  tchecker::clock_id_t x = begin;
+  for (; x + width <= end; x += width) {
+    __m256i const d1 = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(row1 + x));
+    __m256i const b = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(row2 + x));
+    __m256i const smaller = avx2_cmpgt(d1, b);
+    if (_mm256_testz_si256(smaller, smaller))
+      continue;
+
+    __m256i const t = avx2_add(a, b);
+    __m256i s = avx2_sub(t, _mm256_and_si256(_mm256_or_si256(a, b), one));
+    __m256i const special = avx2_cmpeq(b, lt_infinity);
+
+#if !defined(DBM_UNSAFE)
+    __m256i overflow = avx2_cmpgt(zero, _mm256_and_si256(_mm256_xor_si256(a, t), _mm256_xor_si256(b, t)));
+    overflow = _mm256_or_si256(overflow, _mm256_or_si256(avx2_cmpgt(lowest, s), avx2_cmpgt(s, le_infinity)));
+    overflow = _mm256_and_si256(_mm256_andnot_si256(special, overflow), smaller);
+    if (!_mm256_testz_si256(overflow, overflow))
+      return alu_row_witness_scalar(row1, row2, lt_minus_ly, thresholds, x, x + width);
+#endif
+
+    s = _mm256_blendv_epi8(s, b, special);
+    __m256i const threshold = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(thresholds + x));
+    __m256i const witness = _mm256_and_si256(smaller, avx2_cmpgt(threshold, s));
+    if (!_mm256_testz_si256(witness, witness))
+      return tchecker::dbm::ALU_ROW_WITNESS;
+  }
+
+  return alu_row_witness_scalar(row1, row2, lt_minus_ly, thresholds, x, end);
+}
+
+#endif // TCHECKER_DBM_CLOSURE_X86
+
+/*!
+ \brief Detect the fastest supported kernel
+ \return the fastest kernel supported by the processor
+ */
+static enum tchecker::dbm::closure_kernel_t fastest_closure_kernel()
+{
+  if (tchecker::dbm::closure_kernel_supported(tchecker::dbm::CLOSURE_AVX2))
+    return tchecker::dbm::CLOSURE_AVX2;
+  if (tchecker::dbm::closure_kernel_supported(tchecker::dbm::CLOSURE_SSE41))
+    return tchecker::dbm::CLOSURE_SSE41;
+  return tchecker::dbm::CLOSURE_SCALAR;
+}
+
+/*!
+ \brief Selected kernel
+ \note zero-initialised to CLOSURE_SCALAR before dynamic initialisation
+ */
+static enum tchecker::dbm::closure_kernel_t selected_kernel = fastest_closure_kernel();
+
+enum tchecker::dbm::closure_kernel_t closure_kernel() { return selected_kernel; }
+
+bool closure_kernel_supported(enum tchecker::dbm::closure_kernel_t kernel)
+{
+#if defined(TCHECKER_DBM_CLOSURE_X86)
+  __builtin_cpu_init(); // may be called during static initialisation
+#endif
+  switch (kernel) {
+  case tchecker::dbm::CLOSURE_SCALAR:
+    return true;
+#if defined(TCHECKER_DBM_CLOSURE_X86)
+  case tchecker::dbm::CLOSURE_AVX2:
+    return __builtin_cpu_supports("avx2");
+#if (INTEGER_T_SIZE == 32)
+  case tchecker::dbm::CLOSURE_SSE41:
+    return __builtin_cpu_supports("sse4.1");
+#endif
+#endif
+  default:
+    return false;
+  }
+}
+
+void set_closure_kernel(enum tchecker::dbm::closure_kernel_t kernel)
+{
+  if (!tchecker::dbm::closure_kernel_supported(kernel))
+    throw std::invalid_argument(std::string("Unsupported closure kernel: ") + tchecker::dbm::closure_kernel_name(kernel));
+  selected_kernel = kernel;
+}
+
+char const * closure_kernel_name(enum tchecker::dbm::closure_kernel_t kernel)
+{
+  switch (kernel) {
+  case tchecker::dbm::CLOSURE_SCALAR:
+    return "scalar";
+  case tchecker::dbm::CLOSURE_SSE41:
+    return "sse4.1";
+  case tchecker::dbm::CLOSURE_AVX2:
+    return "avx2";
+  default:
+    return "unknown";
+  }
+}
+
+/*!
+ \brief Dispatch a row to the selected kernel
+ \param dbm : a DBM
+ \param dim : dimension of dbm
+ \param i : a row
+ \param k : a clock
+ \param begin : first column
+ \param end : past-the-end column
+ \param vectorisable : true if (i,k) is not an infinity sentinel of the sum
+ \post see tighten_row and eca_tighten_row
+ */
+template <bool ECA>
+static inline void dispatch_row(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::clock_id_t i,
+                                tchecker::clock_id_t k, tchecker::clock_id_t begin, tchecker::clock_id_t end,
+                                bool vectorisable)
+{
+  tchecker::dbm::db_t * row_i = &DBM(i, 0);
+  tchecker::dbm::db_t const * row_k = &DBM(k, 0);
+
+  // (i,k) is constant along the row
+  vectorisable = vectorisable && (i != k) && ((k < begin) || (k >= end) || (DBM(k, k) == tchecker::dbm::LE_ZERO));
+
+#if defined(TCHECKER_DBM_CLOSURE_X86)
+  // rows shorter than a vector are left to the scalar kernel
+  if (vectorisable) {
+    switch (selected_kernel) {
+    case tchecker::dbm::CLOSURE_AVX2:
+      if (end - begin < sizeof(__m256i) / sizeof(tchecker::dbm::db_t))
+        break;
+      tighten_row_avx2<ECA>(row_i, row_k, k, begin, end);
+      return;
+#if (INTEGER_T_SIZE == 32)
+    case tchecker::dbm::CLOSURE_SSE41:
+      if (end - begin < sizeof(__m128i) / sizeof(tchecker::dbm::db_t))
+        break;
+      tighten_row_sse41<ECA>(row_i, row_k, k, begin, end);
+      return;
+#endif
+    default:
+      break;
+    }
+  }
+#else
+  (void)vectorisable;
+#endif
+
+  tighten_row_scalar<ECA>(row_i, row_k, k, begin, end);
+}
+
+void tighten_row(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::clock_id_t i, tchecker::clock_id_t k,
+                 tchecker::clock_id_t begin, tchecker::clock_id_t end)
+{
+  tchecker::dbm::db_t const a = DBM(i, k);
+  dispatch_row<false>(dbm, dim, i, k, begin, end, a != tchecker::dbm::LT_INFINITY);
+}
+
+void eca_tighten_row(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::clock_id_t i, tchecker::clock_id_t k,
+                     tchecker::clock_id_t begin, tchecker::clock_id_t end)
+{
+  tchecker::dbm::db_t const a = DBM(i, k);
+  dispatch_row<true>(dbm, dim, i, k, begin, end,
+                     (a != tchecker::dbm::LT_INFINITY) && (a != tchecker::dbm::LE_INFINITY) &&
+                         (a != tchecker::dbm::LE_MINUS_INFINITY));
+}
+
+enum tchecker::dbm::alu_row_status_t alu_row_witness(tchecker::dbm::db_t const * row1, tchecker::dbm::db_t const * row2,
+                                                     tchecker::dbm::db_t lt_minus_ly,
+                                                     tchecker::dbm::db_t const * thresholds, tchecker::clock_id_t begin,
+                                                     tchecker::clock_id_t end)
+{
+#if defined(TCHECKER_DBM_CLOSURE_X86)
+  if (selected_kernel == tchecker::dbm::CLOSURE_AVX2 && end - begin >= sizeof(__m256i) / sizeof(tchecker::dbm::db_t))
+    return alu_row_witness_avx2(row1, row2, lt_minus_ly, thresholds, begin, end);
+#endif
+  return alu_row_witness_scalar(row1, row2, lt_minus_ly, thresholds, begin, end);
+}
+
+} // end of namespace dbm
+
+} // end of namespace tchecker
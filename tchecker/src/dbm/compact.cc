@@ -0,0 +1,42 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include "tchecker/dbm/compact.hh"
+
+namespace tchecker {
+
+namespace dbm {
+
+bool compact(tchecker::dbm::compact_db_t * cdbm, tchecker::dbm::db_t const * dbm, tchecker::clock_id_t dim)
+{
+  std::size_t const size = static_cast<std::size_t>(dim) * dim;
+  bool compactable = true;
+  for (std::size_t k = 0; k < size; ++k)
+    compactable &= tchecker::dbm::compact(dbm[k], cdbm[k]);
+  return compactable;
+}
+
+bool is_compactable(tchecker::dbm::db_t const * dbm, tchecker::clock_id_t dim)
+{
+  std::size_t const size = static_cast<std::size_t>(dim) * dim;
+  tchecker::dbm::compact_db_t cdb;
+  for (std::size_t k = 0; k < size; ++k)
+    if (!tchecker::dbm::compact(dbm[k], cdb))
+      return false;
+  return true;
+}
+
+void widen(tchecker::dbm::db_t * dbm, tchecker::dbm::compact_db_t const * cdbm, tchecker::clock_id_t dim)
+{
+  std::size_t const size = static_cast<std::size_t>(dim) * dim;
+  for (std::size_t k = 0; k < size; ++k)
+    dbm[k] = tchecker::dbm::widen(cdbm[k]);
+}
+
+} // end of namespace dbm
+
+} // end of namespace tchecker
@@ -5,7 +5,10 @@
  *
  */
 
+#include <algorithm>
 #include <cassert>
+#include <limits>
+#include <vector>
 
 #if BOOST_VERSION <= 106600
 #include <boost/functional/hash.hpp>
@@ -13,7 +16,9 @@
 #include <boost/container_hash/hash.hpp>
 #endif
 
+#include "tchecker/dbm/closure.hh"
 #include "tchecker/dbm/dbm.hh"
+#include "tchecker/utils/counters.hh"
 #include "tchecker/utils/ordering.hh"
 #include "tchecker/expression/static_analysis.hh"
 
@@ -229,6 +234,81 @@ void eca_zero(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim,
 }
 
 
+bool eca_clock_layout(tchecker::clock_id_t dim, const std::unordered_set<int> &history_clock_ids,
+                      const std::unordered_set<int> &prophecy_clock_ids, const std::unordered_set<int> &normal_clock_ids,
+                      tchecker::dbm::clock_layout_t & layout)
+{
+  if (dim < 2 || history_clock_ids.size() + prophecy_clock_ids.size() + normal_clock_ids.size() != dim - 2)
+    return false;
+
+  // kind of index i: 0 for normal, 1 for history, 2 for prophecy clocks
+  auto kind = [&](tchecker::clock_id_t i) -> int {
+    if (normal_clock_ids.find(i) != normal_clock_ids.end())
+      return 0;
+    if (history_clock_ids.find(i) != history_clock_ids.end())
+      return 1;
+    if (prophecy_clock_ids.find(i) != prophecy_clock_ids.end())
+      return 2;
+    return -1;
+  };
+
+  tchecker::clock_id_t begin[4] = {2, 0, 0, dim};
+  int current = 0;
+  for (tchecker::clock_id_t i = 2; i < dim; ++i) {
+    int k = kind(i);
+    if (k < current)
+      return false;
+    for (; current < k; ++current)
+      begin[current + 1] = i;
+  }
+  for (; current < 2; ++current)
+    begin[current + 1] = dim;
+
+  layout.normal_begin = begin[0];
+  layout.history_begin = begin[1];
+  layout.prophecy_begin = begin[2];
+  layout.end = begin[3];
+  return true;
+}
+
+void eca_zero(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::dbm::clock_layout_t const & layout)
+{
+  assert(dbm != nullptr);
+  assert(layout.end == dim);
+
+  tchecker::clock_id_t const n = layout.normal_begin, h = layout.history_begin, p = layout.prophecy_begin;
+
+  // bounds x_i - x_j for i,j in {0, normal, history, prophecy} (row i, column j)
+  DBM(0, 0) = tchecker::dbm::LE_ZERO;
+  std::fill(dbm + n, dbm + h, tchecker::dbm::LE_ZERO);
+  std::fill(dbm + h, dbm + p, tchecker::dbm::LE_MINUS_INFINITY);
+  std::fill(dbm + p, dbm + dim, tchecker::dbm::LE_INFINITY);
+
+  for (tchecker::clock_id_t i = n; i < h; ++i) {
+    tchecker::dbm::db_t * row = dbm + i * dim;
+    row[0] = tchecker::dbm::LE_ZERO;
+    std::fill(row + n, row + h, tchecker::dbm::LE_ZERO);
+    std::fill(row + h, row + p, tchecker::dbm::LE_MINUS_INFINITY);
+    std::fill(row + p, row + dim, tchecker::dbm::LE_INFINITY);
+  }
+
+  for (tchecker::clock_id_t i = h; i < p; ++i) {
+    tchecker::dbm::db_t * row = dbm + i * dim;
+    row[0] = tchecker::dbm::LE_INFINITY;
+    std::fill(row + n, row + dim, tchecker::dbm::LE_INFINITY);
+  }
+
+  for (tchecker::clock_id_t i = p; i < dim; ++i) {
+    tchecker::dbm::db_t * row = dbm + i * dim;
+    row[0] = tchecker::dbm::LE_ZERO;
+    std::fill(row + n, row + h, tchecker::dbm::LE_ZERO);
+    std::fill(row + h, row + p, tchecker::dbm::LE_MINUS_INFINITY);
+    std::fill(row + p, row + dim, tchecker::dbm::LE_INFINITY);
+  }
+
+  assert(tchecker::dbm::eca_is_tight(dbm, dim));
+}
+
 bool is_consistent(tchecker::dbm::db_t const * dbm, tchecker::clock_id_t dim)
 {
   assert(dbm != nullptr);
@@ -302,6 +382,18 @@ bool eca_is_final_dbm(tchecker::dbm::db_t const * dbm, tchecker::clock_id_t dim,
   return true;
 }
 
+bool eca_is_final_dbm(tchecker::dbm::db_t const * dbm, tchecker::clock_id_t dim,
+                      tchecker::dbm::clock_layout_t const & layout)
+{
+  assert(dbm != nullptr);
+  assert(layout.end == dim);
+
+  bool released = true;
+  for (tchecker::clock_id_t i = layout.prophecy_begin; i < dim; ++i)
+    released &= (DBM(0, i) == tchecker::dbm::LE_INFINITY);
+  return released;
+}
+
 bool is_universal(tchecker::dbm::db_t const * dbm, tchecker::clock_id_t dim)
 {
   assert(dbm != nullptr);
@@ -384,8 +476,7 @@ enum tchecker::dbm::status_t tighten(tchecker::dbm::db_t * dbm, tchecker::clock_
     for (tchecker::clock_id_t i = 0; i < dim; ++i) {
       if ((i == k) || (DBM(i, k) == tchecker::dbm::LT_INFINITY)) // optimization
         continue;
-      for (tchecker::clock_id_t j = 0; j < dim; ++j)
-        DBM(i, j) = tchecker::dbm::min(tchecker::dbm::sum(DBM(i, k), DBM(k, j)), DBM(i, j));
+      tchecker::dbm::tighten_row(dbm, dim, i, k, 0, dim);
       if (DBM(i, i) < tchecker::dbm::LE_ZERO) {
         DBM(0, 0) = tchecker::dbm::LT_ZERO;
         return tchecker::dbm::EMPTY;
@@ -419,9 +510,7 @@ enum tchecker::dbm::status_t eca_tighten2(tchecker::dbm::db_t * dbm, tchecker::c
     for (tchecker::clock_id_t k = 0; k < dim; ++k) {
       if ((i == k) || (DBM(i, k) == tchecker::dbm::LE_INFINITY)) // optimization
         continue;
-      for (tchecker::clock_id_t j = 0; j < dim; ++j){
-        DBM(i, j) = tchecker::dbm::min(tchecker::dbm::eca_sum(DBM(i, k), DBM(k, j)), DBM(i, j));
-      }
+      tchecker::dbm::eca_tighten_row(dbm, dim, i, k, 0, dim);
       
       if (DBM(i, i) < tchecker::dbm::LE_ZERO) {
         DBM(0, 0) = tchecker::dbm::LT_ZERO;
@@ -443,18 +532,28 @@ enum tchecker::dbm::status_t eca_tighten(tchecker::dbm::db_t * dbm, tchecker::cl
               const std::unordered_set<int> &history_clock_ids,
               const std::unordered_set<int> &prophecy_clock_ids, 
               const std::unordered_set<int> &normal_clock_ids)
+{
+  if (tchecker::dbm::eca_tighten(dbm, dim) == tchecker::dbm::EMPTY)
+    return tchecker::dbm::EMPTY;
+
+  assert(tchecker::dbm::eca_is_consistent(dbm, dim, history_clock_ids,
+                                        prophecy_clock_ids, 
+                                        normal_clock_ids));
+  return tchecker::dbm::NON_EMPTY;
+}
+
+enum tchecker::dbm::status_t eca_tighten(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim)
 {
   assert(dbm != nullptr);
   assert(dim >= 1);
+  TCHECKER_COUNT(ECA_TIGHTEN_CALLS);
   //since clock with index 1 is the tmp clock
 
   for(tchecker::clock_id_t k = 2;k<dim;++k){
 
     if(DBM(0,k) == tchecker::dbm::LE_INFINITY) continue;
 
-    for (tchecker::clock_id_t j = 2; j < dim; ++j){
-      DBM(0, j) = tchecker::dbm::min(tchecker::dbm::eca_sum(DBM(0, k), DBM(k, j)), DBM(0, j));
-    }
+    tchecker::dbm::eca_tighten_row(dbm, dim, 0, k, 2, dim);
 
     DBM(0, 0) = tchecker::dbm::min(tchecker::dbm::eca_sum(DBM(0, k), DBM(k, 0)), DBM(0, 0));
 
@@ -469,9 +568,7 @@ enum tchecker::dbm::status_t eca_tighten(tchecker::dbm::db_t * dbm, tchecker::cl
     
     if(DBM(i,0) == tchecker::dbm::LE_INFINITY) continue;
     
-    for (tchecker::clock_id_t j = 2; j < dim; ++j){
-      DBM(i, j) = tchecker::dbm::min(tchecker::dbm::eca_sum(DBM(i, 0), DBM(0, j)), DBM(i, j));
-    }
+    tchecker::dbm::eca_tighten_row(dbm, dim, i, 0, 2, dim);
     
     DBM(i, 0) = tchecker::dbm::min(tchecker::dbm::eca_sum(DBM(i, 0), DBM(0, 0)), DBM(i, 0));//not required i think ani:-101 optimization possible
     
@@ -497,9 +594,7 @@ enum tchecker::dbm::status_t eca_tighten(tchecker::dbm::db_t * dbm, tchecker::cl
     for (tchecker::clock_id_t k = 2; k < dim; ++k) {
       if ((i == k) || (DBM(i, k) == tchecker::dbm::LE_INFINITY)) // optimization
         continue;
-      for (tchecker::clock_id_t j = 2; j < dim; ++j){
-        DBM(i, j) = tchecker::dbm::min(tchecker::dbm::eca_sum(DBM(i, k), DBM(k, j)), DBM(i, j));
-      }
+      tchecker::dbm::eca_tighten_row(dbm, dim, i, k, 2, dim);
       
       if (DBM(i, i) < tchecker::dbm::LE_ZERO) {
         DBM(0, 0) = tchecker::dbm::LT_ZERO;
@@ -509,9 +604,6 @@ enum tchecker::dbm::status_t eca_tighten(tchecker::dbm::db_t * dbm, tchecker::cl
   }
   
   
-  assert(tchecker::dbm::eca_is_consistent(dbm, dim, history_clock_ids,
-                                        prophecy_clock_ids, 
-                                        normal_clock_ids));
   assert(tchecker::dbm::eca_is_tight(dbm, dim));
 
   return tchecker::dbm::NON_EMPTY;
@@ -536,8 +628,7 @@ enum tchecker::dbm::status_t tighten(tchecker::dbm::db_t * dbm, tchecker::clock_
     }
 
     // tighten i->j w.r.t. i->y->j
-    for (tchecker::clock_id_t j = 0; j < dim; ++j)
-      DBM(i, j) = tchecker::dbm::min(DBM(i, j), tchecker::dbm::sum(DBM(i, y), DBM(y, j)));
+    tchecker::dbm::tighten_row(dbm, dim, i, y, 0, dim);
 
     if (DBM(i, i) < tchecker::dbm::LE_ZERO) {
       DBM(0, 0) = tchecker::dbm::LT_ZERO;
@@ -554,6 +645,7 @@ enum tchecker::dbm::status_t eca_tighten(tchecker::dbm::db_t * dbm, tchecker::cl
 {
   assert(dbm != nullptr);
   assert(dim >= 1);
+  TCHECKER_COUNT(ECA_TIGHTEN_CALLS);
   // assert(dim%2 == 1);
   
   // std::cout << "ani:541 before tightning \n";
@@ -573,8 +665,7 @@ enum tchecker::dbm::status_t eca_tighten(tchecker::dbm::db_t * dbm, tchecker::cl
   DBM(0, 0) = tchecker::dbm::min(DBM(0, 0), tchecker::dbm::eca_sum(DBM(0, y), DBM(y, 0)));
 
   // tighten 0->j w.r.t. 0->y->j
-  for (tchecker::clock_id_t j = 2; j < dim; ++j)
-    DBM(0, j) = tchecker::dbm::min(DBM(0, j), tchecker::dbm::eca_sum(DBM(0, y), DBM(y, j)));
+  tchecker::dbm::eca_tighten_row(dbm, dim, 0, y, 2, dim);
 
   if (DBM(0, 0) < tchecker::dbm::LE_ZERO) {
     DBM(0, 0) = tchecker::dbm::LT_ZERO;
@@ -593,8 +684,7 @@ enum tchecker::dbm::status_t eca_tighten(tchecker::dbm::db_t * dbm, tchecker::cl
     DBM(i, 0) = tchecker::dbm::min(DBM(i, 0), tchecker::dbm::eca_sum(DBM(i, y), DBM(y, 0)));
 
     // tighten i->j w.r.t. i->y->j
-    for (tchecker::clock_id_t j = 2; j < dim; ++j)
-      DBM(i, j) = tchecker::dbm::min(DBM(i, j), tchecker::dbm::eca_sum(DBM(i, y), DBM(y, j)));
+    tchecker::dbm::eca_tighten_row(dbm, dim, i, y, 2, dim);
 
     if (DBM(i, i) < tchecker::dbm::LE_ZERO) {
       DBM(0, 0) = tchecker::dbm::LT_ZERO;
@@ -1038,6 +1128,29 @@ void eca_open_up(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim,
 }
 
 
+void eca_open_up(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::dbm::clock_layout_t const & layout)
+{
+  assert(dbm != nullptr);
+  assert(layout.end == dim);
+  assert(tchecker::dbm::eca_is_tight(dbm, dim));
+
+  for (tchecker::clock_id_t i = layout.normal_begin; i < layout.history_begin; ++i)
+    DBM(i, 0) = tchecker::dbm::LT_INFINITY;
+
+  // <=inf (undefined) is kept
+  for (tchecker::clock_id_t i = layout.history_begin; i < layout.prophecy_begin; ++i)
+    DBM(i, 0) = tchecker::dbm::max(DBM(i, 0), tchecker::dbm::LT_INFINITY);
+
+  // <=-inf (undefined) is kept
+  for (tchecker::clock_id_t i = layout.prophecy_begin; i < dim; ++i)
+    DBM(i, 0) = (DBM(i, 0) == tchecker::dbm::LE_MINUS_INFINITY ? tchecker::dbm::LE_MINUS_INFINITY : tchecker::dbm::LE_ZERO);
+
+  if (layout.history_begin < dim)
+    tchecker::dbm::eca_tighten(dbm, dim);
+
+  assert(tchecker::dbm::eca_is_tight(dbm, dim));
+}
+
 void eca_release_caller(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim,
                 tchecker::clock_id_t prophecy_clock_id,
                 const std::unordered_set<int> &history_clock_ids,
@@ -1087,6 +1200,74 @@ void eca_release(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim,
   assert(tchecker::dbm::eca_is_tight(dbm, dim));
 }
 
+void eca_unbound_history(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::clock_id_t history_clock_id,
+                const std::unordered_set<int> &history_clock_ids,
+                const std::unordered_set<int> &prophecy_clock_ids, 
+                const std::unordered_set<int> &normal_clock_ids)
+{
+  assert(dbm != nullptr);
+  assert(dim >= 1);
+  assert(history_clock_ids.find(history_clock_id) != history_clock_ids.end());
+
+  assert(tchecker::dbm::eca_is_consistent(dbm, dim, history_clock_ids, prophecy_clock_ids, normal_clock_ids));
+  assert(tchecker::dbm::eca_is_tight(dbm, dim));
+
+  // history clock in [0,inf]: x-y<=inf and y-x<=y-0 for every clock y
+  DBM(history_clock_id,0) = tchecker::dbm::LE_INFINITY;
+  DBM(0,history_clock_id) = tchecker::dbm::LE_ZERO;
+
+  for(tchecker::clock_id_t i=2;i<dim;i++){
+    DBM(history_clock_id,i) = tchecker::dbm::LE_INFINITY;
+    DBM(i,history_clock_id) = DBM(i,0);
+  }
+
+  DBM(history_clock_id,history_clock_id) = tchecker::dbm::LE_INFINITY;
+
+  assert(tchecker::dbm::eca_is_consistent(dbm, dim, history_clock_ids, prophecy_clock_ids, normal_clock_ids));
+  assert(tchecker::dbm::eca_is_tight(dbm, dim));
+}
+
+void project(tchecker::dbm::db_t const * dbm, tchecker::clock_id_t dim, tchecker::clock_id_t const * index,
+             tchecker::clock_id_t pdim, tchecker::dbm::db_t * pdbm)
+{
+  assert(dbm != nullptr);
+  assert(pdbm != nullptr);
+  assert(pdim >= 2);
+  assert(pdim <= dim);
+  assert(index[0] == 0);
+  assert(index[1] == 1);
+
+  for (tchecker::clock_id_t i = 0; i < pdim; ++i) {
+    tchecker::dbm::db_t const * row = dbm + index[i] * dim;
+    tchecker::dbm::db_t * prow = pdbm + i * pdim;
+    for (tchecker::clock_id_t j = 0; j < pdim; ++j)
+      prow[j] = row[index[j]];
+  }
+}
+
+void eca_expand(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::dbm::db_t const * pdbm,
+                tchecker::clock_id_t const * index, tchecker::clock_id_t pdim)
+{
+  assert(dbm != nullptr);
+  assert(pdbm != nullptr);
+  assert(pdim >= 2);
+  assert(pdim <= dim);
+  assert(index[0] == 0);
+  assert(index[1] == 1);
+
+  for (tchecker::clock_id_t i = 0; i < pdim; ++i) {
+    tchecker::dbm::db_t * row = dbm + index[i] * dim;
+    tchecker::dbm::db_t const * prow = pdbm + i * pdim;
+    tchecker::clock_id_t k = 0; // index[k] is the next kept clock
+    for (tchecker::clock_id_t j = 0; j < dim; ++j) {
+      if (k < pdim && index[k] == j)
+        row[j] = prow[k++];
+      else if (i >= 2)
+        row[j] = prow[0]; // j is unbounded: x_i - x_j <= x_i - 0
+    }
+  }
+}
+
 
 
 
@@ -1440,8 +1621,119 @@ void extra_lu_plus(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker
   assert(tchecker::dbm::is_tight(dbm, dim));
 }
 
-bool is_alu_le(tchecker::dbm::db_t const * dbm1, tchecker::dbm::db_t const * dbm2, tchecker::clock_id_t dim,
-               tchecker::integer_t const * l, tchecker::integer_t const * u)
+/*!
+ \brief Accessor
+ \param db : a difference bound
+ \return true if db is neither <inf, <=inf nor <=-inf, false otherwise
+ */
+static inline bool eca_is_finite(tchecker::dbm::db_t db)
+{
+  return (db != tchecker::dbm::LT_INFINITY) && (db != tchecker::dbm::LE_INFINITY) &&
+         (db != tchecker::dbm::LE_MINUS_INFINITY);
+}
+
+/*!
+ \brief Accessor
+ \param dbm : a DBM
+ \param dim : dimension of dbm
+ \param k : a clock
+ \pre dbm is a dim*dim array of difference bounds and 0 < k < dim
+ \return true if some valuation in dbm may assign an infinite value to clock k
+ (i.e. DBM(k,0) or DBM(0,k) is <=inf), false otherwise
+ */
+static inline bool eca_may_be_infinite(tchecker::dbm::db_t const * dbm, tchecker::clock_id_t dim, tchecker::clock_id_t k)
+{
+  return (DBM(k, 0) == tchecker::dbm::LE_INFINITY) || (DBM(0, k) == tchecker::dbm::LE_INFINITY);
+}
+
+/*!
+ \brief Accessor
+ \param dbm : a DBM
+ \param dim : dimension of dbm
+ \param l : clock lower bounds for clocks 1 to dim-1
+ \param u : clock upper bounds for clocks 1 to dim-1
+ \param k : a clock
+ \pre dbm is a dim*dim array of difference bounds and 0 < k < dim
+ \return true if the difference bounds on clock k shall not be modified by
+ tchecker::dbm::eca_extra_lu_plus, false otherwise
+ */
+static inline bool eca_is_kept(tchecker::dbm::db_t const * dbm, tchecker::clock_id_t dim, tchecker::integer_t const * l,
+                               tchecker::integer_t const * u, tchecker::clock_id_t k)
+{
+  return (L(k) == tchecker::dbm::MAX_VALUE && U(k) == tchecker::dbm::MAX_VALUE) || eca_may_be_infinite(dbm, dim, k);
+}
+
+void eca_extra_lu_plus(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::integer_t const * l,
+                       tchecker::integer_t const * u)
+{
+  assert(dbm != nullptr);
+  assert(dim >= 1);
+  assert(tchecker::dbm::eca_is_tight(dbm, dim));
+
+  bool modified = false;
+
+  // same cases as extra_lu_plus, restricted to finite difference bounds:
+  // the bounds <inf, <=inf and <=-inf that encode (un)defined history and
+  // prophecy clocks are left unchanged, and so are the bounds in the rows and
+  // columns of the clocks that may be undefined, or that have maximal bounds
+  // (see eca_is_kept). Hence extrapolation never changes which clocks are
+  // (possibly) undefined
+
+  // i > 0, all cases except the 4th apply
+  for (tchecker::clock_id_t i = 1; i < dim; ++i) {
+    tchecker::integer_t Li = L(i);
+    assert(Li < tchecker::dbm::INF_VALUE);
+    assert(U(i) < tchecker::dbm::INF_VALUE);
+
+    if (eca_is_kept(dbm, dim, l, u, i))
+      continue;
+
+    bool const row_unbounded =
+        eca_is_finite(DBM(0, i)) && (-tchecker::dbm::value(DBM(0, i)) > Li); // 2nd case
+
+    for (tchecker::clock_id_t j = 0; j < dim; ++j) {
+      if (i == j)
+        continue;
+      if (!eca_is_finite(DBM(i, j)) || (j > 0 && eca_is_kept(dbm, dim, l, u, j)))
+        continue;
+
+      assert(L(j) < tchecker::dbm::INF_VALUE);
+      tchecker::integer_t Uj = U(j);
+      assert(Uj < tchecker::dbm::INF_VALUE);
+
+      if (row_unbounded || tchecker::dbm::value(DBM(i, j)) > Li ||
+          (eca_is_finite(DBM(0, j)) && -tchecker::dbm::value(DBM(0, j)) > Uj)) {
+        DBM(i, j) = tchecker::dbm::LT_INFINITY;
+        modified = true;
+      }
+    }
+  }
+
+  // i = 0, only the 4th case apply
+  for (tchecker::clock_id_t j = 1; j < dim; ++j) {
+    tchecker::integer_t Uj = U(j);
+    assert(Uj < tchecker::dbm::INF_VALUE);
+
+    if (!eca_is_finite(DBM(0, j)) || DBM(0, j) == tchecker::dbm::LE_ZERO || eca_is_kept(dbm, dim, l, u, j))
+      continue;
+
+    if (-tchecker::dbm::value(DBM(0, j)) > Uj) {
+      DBM(0, j) = (Uj == -tchecker::dbm::INF_VALUE ? tchecker::dbm::LE_ZERO : tchecker::dbm::db(tchecker::dbm::LT, -Uj));
+      modified = true;
+    }
+  }
+
+  if (modified)
+    tchecker::dbm::eca_tighten(dbm, dim);
+
+  assert(tchecker::dbm::eca_is_tight(dbm, dim));
+}
+
+/*!
+ \brief Scalar aLU check (see tchecker::dbm::is_alu_le)
+ */
+static bool is_alu_le_scalar(tchecker::dbm::db_t const * dbm1, tchecker::dbm::db_t const * dbm2, tchecker::clock_id_t dim,
+                             tchecker::integer_t const * l, tchecker::integer_t const * u)
 {
   assert(dbm1 != nullptr);
   assert(dbm2 != nullptr);
@@ -1490,6 +1782,72 @@ bool is_alu_le(tchecker::dbm::db_t const * dbm1, tchecker::dbm::db_t const * dbm
   return true;
 }
 
+bool is_alu_le(tchecker::dbm::db_t const * dbm1, tchecker::dbm::db_t const * dbm2, tchecker::clock_id_t dim,
+               tchecker::integer_t const * l, tchecker::integer_t const * u)
+{
+  if (tchecker::dbm::closure_kernel() == tchecker::dbm::CLOSURE_SCALAR)
+    return is_alu_le_scalar(dbm1, dbm2, dim, l, u);
+
+  assert(dbm1 != nullptr);
+  assert(dbm2 != nullptr);
+  assert(dim >= 1);
+  assert(tchecker::dbm::is_consistent(dbm1, dim));
+  assert(tchecker::dbm::is_consistent(dbm2, dim));
+  assert(tchecker::dbm::is_positive(dbm1, dim));
+  assert(tchecker::dbm::is_positive(dbm2, dim));
+  assert(tchecker::dbm::is_tight(dbm1, dim));
+  assert(tchecker::dbm::is_tight(dbm2, dim));
+
+  // Same conditions as is_alu_le_scalar, checked row by row: the 1st condition
+  // only depends on x, hence it is encoded in thresholds[x] which is dbm1[0x] if
+  // it holds, and a bound smaller than any sum otherwise
+  static thread_local std::vector<tchecker::dbm::db_t> thresholds;
+  thresholds.resize(dim);
+
+  tchecker::clock_id_t first = dim, last = 0;
+  for (tchecker::clock_id_t x = 0; x < dim; ++x) {
+    tchecker::integer_t Ux = U(x);
+    assert(Ux < tchecker::dbm::INF_VALUE);
+    if (Ux == -tchecker::dbm::INF_VALUE || DBM1(0, x) < tchecker::dbm::db(tchecker::dbm::LE, -Ux))
+      thresholds[x] = std::numeric_limits<tchecker::dbm::db_t>::min();
+    else {
+      thresholds[x] = DBM1(0, x);
+      first = std::min(first, x);
+      last = x + 1;
+    }
+  }
+
+  if (first == dim)
+    return true;
+
+  for (tchecker::clock_id_t y = 0; y < dim; ++y) {
+    tchecker::integer_t Ly = L(y);
+    assert(Ly < tchecker::dbm::INF_VALUE);
+    if (Ly == -tchecker::dbm::INF_VALUE)
+      continue;
+
+    tchecker::dbm::db_t const lt_minus_ly = tchecker::dbm::db(tchecker::dbm::LT, -Ly);
+    tchecker::dbm::db_t const * row1 = &DBM1(y, 0);
+    tchecker::dbm::db_t const * row2 = &DBM2(y, 0);
+    // Columns in [first,last) except y
+    tchecker::clock_id_t const ranges[2][2] = {{first, std::min(y, last)}, {std::max(first, y + 1), last}};
+    for (auto const & range : ranges) {
+      if (range[0] >= range[1])
+        continue;
+      enum tchecker::dbm::alu_row_status_t status =
+          tchecker::dbm::alu_row_witness(row1, row2, lt_minus_ly, thresholds.data(), range[0], range[1]);
+      if (status == tchecker::dbm::ALU_ROW_WITNESS)
+        return false;
+      // Sums that cannot be represented are reported (and thrown) as in the
+      // scalar check
+      if (status == tchecker::dbm::ALU_ROW_OVERFLOW)
+        return is_alu_le_scalar(dbm1, dbm2, dim, l, u);
+    }
+  }
+
+  return true;
+}
+
 bool is_am_le(tchecker::dbm::db_t const * dbm1, tchecker::dbm::db_t const * dbm2, tchecker::clock_id_t dim,
               tchecker::integer_t const * m)
 {
@@ -1612,6 +1970,7 @@ bool is_g_le_star(tchecker::dbm::db_t const * dbm1, tchecker::dbm::db_t const *
   tchecker::typed_diagonal_clkconstr_expression_t const * phi = G.back();
   assert(phi != nullptr);
   G.pop_back(); // phi will be pushed back before exiting this function
+  TCHECKER_COUNT(GSIM_SPLITS);
 
   // creating negation of phi
   tchecker::integer_t bound = tchecker::const_evaluate(phi->bound());
@@ -1879,6 +2238,7 @@ bool is_eca_g_le_star(tchecker::dbm::db_t const * dbm1,
   tchecker::typed_diagonal_clkconstr_expression_t const * phi = G.back();
   assert(phi != nullptr);
   G.pop_back(); // phi will be pushed back before exiting this function
+  TCHECKER_COUNT(GSIM_SPLITS);
 
   // creating negation of phi
   tchecker::integer_t bound = tchecker::const_evaluate(phi->bound());
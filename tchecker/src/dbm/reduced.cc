@@ -0,0 +1,188 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+
+#include "tchecker/dbm/dbm.hh"
+#include "tchecker/dbm/reduced.hh"
+
+namespace tchecker {
+
+namespace dbm {
+
+/*!
+ \brief Check if a DBM can be reduced to its minimal constraint graph
+ \param dbm : a DBM
+ \param dim : dimension of dbm
+ \pre dbm is a dim*dim array of difference bounds
+ \return true if dbm is non-empty, every bound in dbm is < infinity or finite,
+ and the sum of dim finite bounds in dbm can be represented (hence tightening
+ never overflows), false otherwise
+ \note dbm may not be tight
+ */
+static bool is_minimal_graph_reducible(tchecker::dbm::db_t const * dbm, tchecker::clock_id_t dim)
+{
+  std::size_t const size = static_cast<std::size_t>(dim) * dim;
+  tchecker::integer_t const max_value = (tchecker::dbm::INF_VALUE - 1) / static_cast<tchecker::integer_t>(dim);
+  for (std::size_t k = 0; k < size; ++k) {
+    tchecker::dbm::db_t const db = dbm[k];
+    if (db == tchecker::dbm::LT_INFINITY)
+      continue;
+    tchecker::integer_t const value = (db >> 1);
+    if (value > max_value || value < -max_value)
+      return false;
+  }
+  return !tchecker::dbm::is_empty_0(dbm, dim);
+}
+
+/*!
+ \brief Minimal constraint graph of a DBM
+ \param dbm : a DBM
+ \param dim : dimension of dbm
+ \param constraints : constraints
+ \pre dbm is a dim*dim tight and non-empty DBM that satisfies
+ is_minimal_graph_reducible
+ \post constraints is the minimal constraint graph of dbm: the clocks are
+ partitioned into classes of clocks with zero cycles, each class is represented
+ by its least clock, and constraints consists in a cycle through the clocks in
+ each class, and the non-redundant constraints between representatives
+ */
+static void minimal_graph(tchecker::dbm::db_t const * dbm, tchecker::clock_id_t dim,
+                          std::vector<tchecker::dbm::reduced_constraint_t> & constraints)
+{
+  auto index = [dim](tchecker::clock_id_t i, tchecker::clock_id_t j) { return static_cast<std::uint32_t>(i * dim + j); };
+
+  // Zero-cycle classes and cycles within classes
+  std::vector<tchecker::clock_id_t> rep(dim), last(dim);
+  std::vector<tchecker::clock_id_t> reps;
+  for (tchecker::clock_id_t i = 0; i < dim; ++i) {
+    rep[i] = i;
+    for (tchecker::clock_id_t j = 0; j < i; ++j)
+      if (rep[j] == j && tchecker::dbm::sum(dbm[i * dim + j], dbm[j * dim + i]) == tchecker::dbm::LE_ZERO) {
+        rep[i] = j;
+        break;
+      }
+    if (rep[i] == i) {
+      reps.push_back(i);
+      last[i] = i;
+    }
+    else {
+      tchecker::clock_id_t const prev = last[rep[i]];
+      constraints.push_back({index(prev, i), dbm[prev * dim + i]});
+      last[rep[i]] = i;
+    }
+  }
+  for (tchecker::clock_id_t r : reps)
+    if (last[r] != r)
+      constraints.push_back({index(last[r], r), dbm[last[r] * dim + r]});
+
+  // Non-redundant constraints between representatives
+  for (tchecker::clock_id_t i : reps)
+    for (tchecker::clock_id_t j : reps) {
+      if (i == j)
+        continue;
+      tchecker::dbm::db_t const db = dbm[i * dim + j];
+      if (db == tchecker::dbm::LT_INFINITY)
+        continue;
+      bool redundant = false;
+      for (tchecker::clock_id_t k : reps) {
+        if (k == i || k == j)
+          continue;
+        if (tchecker::dbm::sum(dbm[i * dim + k], dbm[k * dim + j]) <= db) {
+          redundant = true;
+          break;
+        }
+      }
+      if (!redundant)
+        constraints.push_back({index(i, j), db});
+    }
+}
+
+/*!
+ \brief Sparse reduction of a DBM
+ \param dbm : a DBM
+ \param dim : dimension of dbm
+ \param header : header
+ \param constraints : constraints
+ \pre dbm is a dim*dim array of difference bounds
+ \post header and constraints are the sparse reduction of dbm (see
+ tchecker::dbm::reduce)
+ */
+static void sparse(tchecker::dbm::db_t const * dbm, tchecker::clock_id_t dim, tchecker::dbm::reduced_header_t & header,
+                   std::vector<tchecker::dbm::reduced_constraint_t> & constraints)
+{
+  std::size_t const size = static_cast<std::size_t>(dim) * dim;
+
+  header.reduction = tchecker::dbm::REDUCTION_SPARSE;
+  header.unbounded = tchecker::dbm::LT_INFINITY;
+  for (std::size_t k = 0; k < size; ++k)
+    if (dbm[k] == tchecker::dbm::LE_INFINITY) {
+      header.unbounded = tchecker::dbm::LE_INFINITY;
+      break;
+    }
+
+  constraints.clear();
+  for (tchecker::clock_id_t i = 0; i < dim; ++i)
+    for (tchecker::clock_id_t j = 0; j < dim; ++j) {
+      tchecker::dbm::db_t const db = dbm[i * dim + j];
+      if (db != (i == j ? tchecker::dbm::LE_ZERO : header.unbounded))
+        constraints.push_back({static_cast<std::uint32_t>(i * dim + j), db});
+    }
+  header.count = static_cast<std::uint32_t>(constraints.size());
+}
+
+void reduce(tchecker::dbm::db_t const * dbm, tchecker::clock_id_t dim, tchecker::dbm::reduced_header_t & header,
+            std::vector<tchecker::dbm::reduced_constraint_t> & constraints)
+{
+  assert(dbm != nullptr);
+  assert(dim >= 1);
+
+  constraints.clear();
+
+  if (tchecker::dbm::is_minimal_graph_reducible(dbm, dim)) {
+    tchecker::dbm::minimal_graph(dbm, dim, constraints);
+    std::sort(constraints.begin(), constraints.end(),
+              [](tchecker::dbm::reduced_constraint_t const & c1, tchecker::dbm::reduced_constraint_t const & c2) {
+                return c1.index < c2.index;
+              });
+    header.count = static_cast<std::uint32_t>(constraints.size());
+    header.reduction = tchecker::dbm::REDUCTION_MINIMAL_GRAPH;
+    header.unbounded = tchecker::dbm::LT_INFINITY;
+
+    // The minimal constraint graph is only correct if dbm is tight
+    thread_local std::vector<tchecker::dbm::db_t> check;
+    check.resize(static_cast<std::size_t>(dim) * dim);
+    tchecker::dbm::expand(check.data(), dim, header, constraints.data());
+    if (std::equal(check.begin(), check.end(), dbm))
+      return;
+  }
+
+  tchecker::dbm::sparse(dbm, dim, header, constraints);
+}
+
+void expand(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::dbm::reduced_header_t const & header,
+            tchecker::dbm::reduced_constraint_t const * constraints)
+{
+  assert(dbm != nullptr);
+  assert(dim >= 1);
+
+  std::size_t const size = static_cast<std::size_t>(dim) * dim;
+  std::fill(dbm, dbm + size, header.unbounded);
+  for (tchecker::clock_id_t i = 0; i < dim; ++i)
+    dbm[i * dim + i] = tchecker::dbm::LE_ZERO;
+  for (std::uint32_t k = 0; k < header.count; ++k)
+    dbm[constraints[k].index] = constraints[k].db;
+
+  if (header.reduction == tchecker::dbm::REDUCTION_MINIMAL_GRAPH)
+    tchecker::dbm::tighten(dbm, dim);
+}
+
+} // end of namespace dbm
+
+} // end of namespace tchecker
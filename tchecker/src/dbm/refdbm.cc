@@ -5,10 +5,12 @@
  *
  */
 
+#include <algorithm>
 #include <limits>
 #include <vector>
 
 #include "tchecker/clockbounds/clockbounds.hh"
+#include "tchecker/dbm/closure.hh"
 #include "tchecker/dbm/db.hh"
 #include "tchecker/dbm/refdbm.hh"
 #include "tchecker/utils/ordering.hh"
@@ -302,9 +304,12 @@ bool is_am_le(tchecker::dbm::db_t const * rdbm1, tchecker::dbm::db_t const * rdb
   return is_alu_le(rdbm1, rdbm2, r, m, m);
 }
 
-bool is_sync_alu_le(tchecker::dbm::db_t const * rdbm1, tchecker::dbm::db_t const * rdbm2,
-                    tchecker::reference_clock_variables_t const & r, tchecker::integer_t const * l,
-                    tchecker::integer_t const * u)
+/*!
+ \brief Scalar aLU check (see tchecker::refdbm::is_sync_alu_le)
+ */
+static bool is_sync_alu_le_scalar(tchecker::dbm::db_t const * rdbm1, tchecker::dbm::db_t const * rdbm2,
+                                  tchecker::reference_clock_variables_t const & r, tchecker::integer_t const * l,
+                                  tchecker::integer_t const * u)
 {
   assert(rdbm1 != nullptr);
   assert(rdbm2 != nullptr);
@@ -382,12 +387,152 @@ bool is_sync_alu_le(tchecker::dbm::db_t const * rdbm1, tchecker::dbm::db_t const
   return true;
 }
 
+bool is_sync_alu_le(tchecker::dbm::db_t const * rdbm1, tchecker::dbm::db_t const * rdbm2,
+                    tchecker::reference_clock_variables_t const & r, tchecker::integer_t const * l,
+                    tchecker::integer_t const * u)
+{
+  if (tchecker::dbm::closure_kernel() == tchecker::dbm::CLOSURE_SCALAR)
+    return is_sync_alu_le_scalar(rdbm1, rdbm2, r, l, u);
+
+  assert(rdbm1 != nullptr);
+  assert(rdbm2 != nullptr);
+  assert(tchecker::refdbm::is_consistent(rdbm1, r));
+  assert(tchecker::refdbm::is_consistent(rdbm2, r));
+  assert(tchecker::refdbm::is_positive(rdbm1, r));
+  assert(tchecker::refdbm::is_positive(rdbm2, r));
+  assert(tchecker::refdbm::is_tight(rdbm1, r));
+  assert(tchecker::refdbm::is_tight(rdbm2, r));
+
+  std::size_t const rdim = r.size();
+  std::size_t const refcount = r.refcount();
+
+  // Same conditions as is_sync_alu_le_scalar, the second case being checked
+  // row by row: thresholds[x] is min_tx1 if min_tx1 >= (<= -U(x)), and a bound
+  // smaller than any sum otherwise
+  static thread_local std::vector<tchecker::dbm::db_t> thresholds;
+  thresholds.resize(rdim);
+
+  tchecker::clock_id_t first = rdim, last = refcount;
+  for (tchecker::clock_id_t x = refcount; x < rdim; ++x) {
+    thresholds[x] = std::numeric_limits<tchecker::dbm::db_t>::min();
+
+    tchecker::integer_t Ux = U(x);
+    assert(Ux < tchecker::dbm::INF_VALUE);
+    if (Ux == -tchecker::dbm::INF_VALUE)
+      continue;
+
+    tchecker::dbm::db_t min_tx1 = RDBM1(0, x);
+    tchecker::dbm::db_t min_tx2 = RDBM2(0, x);
+    for (tchecker::clock_id_t t = 1; t < refcount; ++t) {
+      min_tx1 = tchecker::dbm::min(min_tx1, RDBM1(t, x));
+      min_tx2 = tchecker::dbm::min(min_tx2, RDBM2(t, x));
+    }
+
+    if (min_tx1 < tchecker::dbm::db(tchecker::dbm::LE, -Ux))
+      continue;
+
+    if (min_tx2 < min_tx1)
+      return false;
+
+    thresholds[x] = min_tx1;
+    first = std::min(first, x);
+    last = x + 1;
+  }
+
+  if (first == rdim)
+    return true;
+
+  for (tchecker::clock_id_t y = refcount; y < rdim; ++y) {
+    tchecker::integer_t Ly = L(y);
+    assert(Ly < tchecker::dbm::INF_VALUE);
+    if (Ly == -tchecker::dbm::INF_VALUE)
+      continue;
+
+    tchecker::dbm::db_t const lt_minus_ly = tchecker::dbm::db(tchecker::dbm::LT, -Ly);
+    tchecker::dbm::db_t const * row1 = &RDBM1(y, 0);
+    tchecker::dbm::db_t const * row2 = &RDBM2(y, 0);
+
+    // Columns in [first,last) except y
+    tchecker::clock_id_t const ranges[2][2] = {{first, std::min(y, last)}, {std::max(first, y + 1), last}};
+    for (auto const & range : ranges) {
+      if (range[0] >= range[1])
+        continue;
+      enum tchecker::dbm::alu_row_status_t status =
+          tchecker::dbm::alu_row_witness(row1, row2, lt_minus_ly, thresholds.data(), range[0], range[1]);
+      if (status == tchecker::dbm::ALU_ROW_WITNESS)
+        return false;
+      // Sums that cannot be represented are reported (and thrown) as in the
+      // scalar check
+      if (status == tchecker::dbm::ALU_ROW_OVERFLOW)
+        return is_sync_alu_le_scalar(rdbm1, rdbm2, r, l, u);
+    }
+  }
+
+  return true;
+}
+
 bool is_sync_am_le(tchecker::dbm::db_t const * rdbm1, tchecker::dbm::db_t const * rdbm2,
                    tchecker::reference_clock_variables_t const & r, tchecker::integer_t const * m)
 {
   return tchecker::refdbm::is_sync_alu_le(rdbm1, rdbm2, r, m, m);
 }
 
+/*!
+ \brief Translation of the synchronized local time-elapse of a DBM to a DBM
+ over system clocks
+ \param rdbm : a DBM
+ \param r : reference clocks for rdbm
+ \param dbm : a DBM
+ \param dim : dimension of dbm
+ \pre rdbm is a consistent and tight r.size()*r.size() DBM, dbm is a dim*dim
+ DBM, and dim == r.size() - r.refcount() + 1
+ \post dbm is sync(local_time_elapse(rdbm)) over system clocks if it is not
+ empty
+ \return false if sync(local_time_elapse(rdbm)) is empty, true otherwise
+ */
+static bool sync_local_time_elapse_to_dbm(tchecker::dbm::db_t const * rdbm, tchecker::reference_clock_variables_t const & r,
+                                          tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim)
+{
+  std::size_t const rdim = r.size();
+
+  static thread_local std::vector<tchecker::dbm::db_t> elapsed;
+  elapsed.assign(rdbm, rdbm + rdim * rdim);
+
+  tchecker::refdbm::asynchronous_open_up(elapsed.data(), r);
+  if (tchecker::refdbm::synchronize(elapsed.data(), r) == tchecker::dbm::EMPTY)
+    return false;
+  tchecker::refdbm::to_dbm(elapsed.data(), r, dbm, dim);
+  return true;
+}
+
+bool is_sync_g_le(tchecker::dbm::db_t const * rdbm1, tchecker::dbm::db_t const * rdbm2,
+                  tchecker::reference_clock_variables_t const & r,
+                  std::vector<tchecker::typed_diagonal_clkconstr_expression_t const *> & G,
+                  std::vector<tchecker::typed_simple_clkconstr_expression_t const *> const & Gdf)
+{
+  assert(rdbm1 != nullptr);
+  assert(rdbm2 != nullptr);
+  assert(tchecker::refdbm::is_consistent(rdbm1, r));
+  assert(tchecker::refdbm::is_consistent(rdbm2, r));
+  assert(tchecker::refdbm::is_positive(rdbm1, r));
+  assert(tchecker::refdbm::is_positive(rdbm2, r));
+  assert(tchecker::refdbm::is_tight(rdbm1, r));
+  assert(tchecker::refdbm::is_tight(rdbm2, r));
+
+  tchecker::clock_id_t const dim = static_cast<tchecker::clock_id_t>(r.size() - r.refcount() + 1);
+
+  static thread_local std::vector<tchecker::dbm::db_t> dbm1, dbm2;
+  dbm1.resize(dim * dim);
+  dbm2.resize(dim * dim);
+
+  if (!sync_local_time_elapse_to_dbm(rdbm1, r, dbm1.data(), dim))
+    return true;
+  if (!sync_local_time_elapse_to_dbm(rdbm2, r, dbm2.data(), dim))
+    return false;
+
+  return tchecker::dbm::is_g_le(dbm1.data(), dbm2.data(), dim, G, Gdf);
+}
+
 std::size_t hash(tchecker::dbm::db_t const * rdbm, tchecker::reference_clock_variables_t const & r)
 {
   assert(rdbm != nullptr);
@@ -441,7 +586,8 @@ tchecker::integer_t const UNBOUNDED_SPREAD = std::numeric_limits<tchecker::integ
 enum tchecker::dbm::status_t bound_spread(tchecker::dbm::db_t * rdbm, tchecker::reference_clock_variables_t const & r,
                                           tchecker::integer_t spread)
 {
-  boost::dynamic_bitset<> ref_clocks{r.refcount()};
+  static thread_local boost::dynamic_bitset<> ref_clocks;
+  ref_clocks.resize(r.refcount());
   ref_clocks.set();
   return tchecker::refdbm::bound_spread(rdbm, r, spread, ref_clocks);
 }
@@ -461,17 +607,28 @@ enum tchecker::dbm::status_t bound_spread(tchecker::dbm::db_t * rdbm, tchecker::
 
   tchecker::clock_id_t const rdim = r.size();
 
+  // Only the reference clocks with a decreased difference bound are pivots:
+  // rdbm is tight, hence paths that do not go through a decreased difference
+  // bound are not shorter than the bounds in rdbm. After an asynchronous step,
+  // this is usually the reference clocks that have been opened up
+  static thread_local boost::dynamic_bitset<> pivots;
+  pivots.resize(r.refcount());
+  pivots.reset();
+
   for (auto t1 = ref_clocks.find_first(); t1 != ref_clocks.npos; t1 = ref_clocks.find_next(t1)) {
     assert(t1 < r.refcount());
     for (auto t2 = ref_clocks.find_first(); t2 != ref_clocks.npos; t2 = ref_clocks.find_next(t2)) {
       assert(t2 < r.refcount());
-      RDBM(t1, t2) = tchecker::dbm::min(RDBM(t1, t2), le_spread);
+      if (t1 == t2 || RDBM(t1, t2) <= le_spread)
+        continue;
+      RDBM(t1, t2) = le_spread;
+      pivots.set(t1);
+      pivots.set(t2);
     }
-    RDBM(t1, t1) = tchecker::dbm::LE_ZERO;
   }
 
-  // Optimized tightening: Floyd-Warshall algorithm w.r.t. reference clocks in ref_clocks
-  for (auto t = ref_clocks.find_first(); t != ref_clocks.npos; t = ref_clocks.find_next(t)) {
+  // Optimized tightening: Floyd-Warshall algorithm w.r.t. pivot reference clocks
+  for (auto t = pivots.find_first(); t != pivots.npos; t = pivots.find_next(t)) {
     assert(t < r.refcount());
 
     for (tchecker::clock_id_t x = 0; x < rdim; ++x) {
@@ -498,6 +655,91 @@ enum tchecker::dbm::status_t bound_spread(tchecker::dbm::db_t * rdbm, tchecker::
   return tchecker::dbm::NON_EMPTY;
 }
 
+enum tchecker::dbm::status_t incremental_bound_spread(tchecker::dbm::db_t * rdbm, tchecker::reference_clock_variables_t const & r,
+                                                      tchecker::integer_t spread, boost::dynamic_bitset<> const & opened)
+{
+  assert(rdbm != nullptr);
+  assert(tchecker::refdbm::is_consistent(rdbm, r));
+  assert(tchecker::refdbm::is_tight(rdbm, r));
+  assert(r.refcount() == opened.size());
+
+  if (spread == tchecker::refdbm::UNBOUNDED_SPREAD)
+    return tchecker::dbm::NON_EMPTY;
+
+  tchecker::dbm::db_t const le_spread = tchecker::dbm::db(tchecker::dbm::LE, spread);
+
+  tchecker::clock_id_t const rdim = r.size();
+  tchecker::clock_id_t const refcount = r.refcount();
+
+  // Only differences t1 - t with t in opened can exceed spread. The columns
+  // with a decreased difference bound are collected in changed
+  static thread_local boost::dynamic_bitset<> changed;
+  changed.resize(refcount);
+  changed.reset();
+
+  for (auto t = opened.find_first(); t != opened.npos; t = opened.find_next(t)) {
+    for (tchecker::clock_id_t t1 = 0; t1 < refcount; ++t1) {
+      assert(t1 == t || opened[t1] || RDBM(t, t1) <= le_spread);
+      if (t1 == t || RDBM(t1, t) <= le_spread)
+        continue;
+      RDBM(t1, t) = le_spread;
+      changed.set(t);
+    }
+  }
+
+  if (changed.none())
+    return tchecker::dbm::NON_EMPTY;
+
+  // Floyd-Warshall algorithm w.r.t. reference clocks. As only columns in
+  // changed have been modified, the other reference clocks u only need to be
+  // pivots for the columns in changed: rdbm[x,u] is unchanged, hence
+  // rdbm[x,u] + rdbm[u,y] >= rdbm[x,y] for every other column y
+  for (tchecker::clock_id_t u = 0; u < refcount; ++u) {
+    if (changed[u])
+      continue;
+
+    for (tchecker::clock_id_t x = 0; x < rdim; ++x) {
+      if (x == u || RDBM(x, u) == tchecker::dbm::LT_INFINITY)
+        continue; // optimization
+
+      for (auto t = changed.find_first(); t != changed.npos; t = changed.find_next(t))
+        if (RDBM(u, t) != tchecker::dbm::LT_INFINITY)
+          RDBM(x, t) = tchecker::dbm::min(tchecker::dbm::sum(RDBM(x, u), RDBM(u, t)), RDBM(x, t));
+    }
+  }
+
+  for (auto t = changed.find_first(); t != changed.npos; t = changed.find_next(t)) {
+    if (RDBM(t, t) < tchecker::dbm::LE_ZERO) {
+      RDBM(0, 0) = tchecker::dbm::LT_ZERO;
+      return tchecker::dbm::EMPTY;
+    }
+  }
+
+  for (auto t = changed.find_first(); t != changed.npos; t = changed.find_next(t)) {
+    for (tchecker::clock_id_t x = 0; x < rdim; ++x) {
+      if (x == t || RDBM(x, t) == tchecker::dbm::LT_INFINITY)
+        continue; // optimization
+
+      for (tchecker::clock_id_t y = 0; y < rdim; ++y) {
+        if (y == t || RDBM(t, y) == tchecker::dbm::LT_INFINITY)
+          continue; // optimization
+
+        RDBM(x, y) = tchecker::dbm::min(tchecker::dbm::sum(RDBM(x, t), RDBM(t, y)), RDBM(x, y));
+      }
+
+      if (RDBM(x, x) < tchecker::dbm::LE_ZERO) {
+        RDBM(0, 0) = tchecker::dbm::LT_ZERO;
+        return tchecker::dbm::EMPTY;
+      }
+    }
+  }
+
+  assert(tchecker::refdbm::is_consistent(rdbm, r));
+  assert(tchecker::refdbm::is_tight(rdbm, r));
+
+  return tchecker::dbm::NON_EMPTY;
+}
+
 void reset_to_reference_clock(tchecker::dbm::db_t * rdbm, tchecker::reference_clock_variables_t const & r,
                               tchecker::clock_id_t x)
 {
@@ -566,19 +808,16 @@ void asynchronous_open_up(tchecker::dbm::db_t * rdbm, tchecker::reference_clock_
                           boost::dynamic_bitset<> const & delay_allowed)
 {
   tchecker::clock_id_t const rdim = r.size();
-  tchecker::clock_id_t const refcount = r.refcount();
 
   assert(rdbm != nullptr);
   assert(tchecker::refdbm::is_consistent(rdbm, r));
   assert(tchecker::refdbm::is_tight(rdbm, r));
-  assert(refcount == delay_allowed.size());
+  assert(r.refcount() == delay_allowed.size());
 
   // x - t < inf for all x and t s.t. delay is allowed for t (including x being
-  // another reference clocks)
-  for (tchecker::clock_id_t t = 0; t < refcount; ++t) {
-    if (!delay_allowed[t])
-      continue;
-
+  // another reference clocks). Only the columns of these reference clocks are
+  // modified
+  for (auto t = delay_allowed.find_first(); t != delay_allowed.npos; t = delay_allowed.find_next(t)) {
     for (tchecker::clock_id_t x = 0; x < rdim; ++x)
       RDBM(x, t) = tchecker::dbm::LT_INFINITY;
     RDBM(t, t) = tchecker::dbm::LE_ZERO;
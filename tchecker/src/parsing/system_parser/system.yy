@@ -20,11 +20,13 @@
 
 
 %code requires {
+  #include <algorithm>
   #include <cstdlib>
   #include <iostream>
   #include <sstream>
   #include <limits>
   #include <string>
+  #include <unordered_map>
   #include <vector>
   
   #include <boost/algorithm/string.hpp>
@@ -54,17 +56,63 @@
   // Error detection
   static unsigned int old_error_count;
 
+  /*!
+   \class name_set_t
+   \brief Sequence of names with constant-time membership queries
+   \note the sets of clocks and variables below grow with the size of the
+   model, and they are queried for every clock and variable in every guard and
+   statement. Searching them linearly made parsing quadratic in the size of the
+   model
+   */
+  class name_set_t {
+  public:
+    using const_iterator = std::vector<std::string>::const_iterator;
+
+    void push_back(std::string const & name)
+    {
+      _names.push_back(name);
+      ++_counts[name];
+    }
+
+    bool contains(std::string const & name) const { return _counts.find(name) != _counts.end(); }
+
+    // Removes one occurrence of name, if any
+    void erase(std::string const & name)
+    {
+      auto it = _counts.find(name);
+      if (it == _counts.end())
+        return;
+      _names.erase(std::find(_names.begin(), _names.end(), name));
+      if (--it->second == 0)
+        _counts.erase(it);
+    }
+
+    void clear()
+    {
+      _names.clear();
+      _counts.clear();
+    }
+
+    std::size_t size() const { return _names.size(); }
+    const_iterator begin() const { return _names.begin(); }
+    const_iterator end() const { return _names.end(); }
+
+  private:
+    std::vector<std::string> _names;
+    std::unordered_map<std::string, std::size_t> _counts;
+  };
+
   //ani:-100
-  std::vector<std::string> prophecy_clocks_parser(0); //maintain the set of all prophecy clocks defined (superset of timers and event prophecy clocks)
-  std::vector<std::string> history_clocks_parser(0); //maintain the set of all history clocks defined (superset of normal and event history clocks)
-  std::vector<std::string> timer_clocks_parser(0); //maintain the set of all timers defined (subset of prophecy clocks)
-  std::vector<std::string> event_history_clocks(0); //maintain the set of all event history clocks (subset of history clocks)
-  std::vector<std::string> event_prophecy_clocks(0); //maintain the set of all prophecy clocks (subset of prophecy clocks)
+  name_set_t prophecy_clocks_parser; //maintain the set of all prophecy clocks defined (superset of timers and event prophecy clocks)
+  name_set_t history_clocks_parser; //maintain the set of all history clocks defined (superset of normal and event history clocks)
+  name_set_t timer_clocks_parser; //maintain the set of all timers defined (subset of prophecy clocks)
+  name_set_t event_history_clocks; //maintain the set of all event history clocks (subset of history clocks)
+  name_set_t event_prophecy_clocks; //maintain the set of all prophecy clocks (subset of prophecy clocks)
   
   
-  std::vector<std::string> good_prophecy_clocks(0); //maintain a set of all prophecy clocks which are always checked for prophecy <=-inf or ==-inf or >=0 or ==0 before release operation
+  name_set_t good_prophecy_clocks; //maintain a set of all prophecy clocks which are always checked for prophecy <=-inf or ==-inf or >=0 or ==0 before release operation
   
-  std::vector<std::string> prophecy_clocks_verify(0); //maintain the set of prophecy clocks which appear in a prophecy-prophecy guard
+  name_set_t prophecy_clocks_verify; //maintain the set of prophecy clocks which appear in a prophecy-prophecy guard
 
   bool continue_successor_comp = false; //variable stores whether finiteness is not guaranteed
 
@@ -80,7 +128,7 @@
   //where clks are checked either for <=-inf or for >=0 in their corresponding guard numbers
   //both tmp_single_prop_guards and tmp_prop_guards are equal
 
-  std::vector<std::string> parser_integer_vars(0); //this list will maintain the integer variables defined in input file
+  name_set_t parser_integer_vars; //this list will maintain the integer variables defined in input file
 }
 
 %initial-action {
@@ -88,9 +136,19 @@
   @$.begin.filename = @$.end.filename = &const_cast<std::string &>(filename);
   
   old_error_count = tchecker::log_error_count();
-  
-  
 
+  // Forget the declarations of the previously parsed system
+  prophecy_clocks_parser.clear();
+  history_clocks_parser.clear();
+  timer_clocks_parser.clear();
+  event_history_clocks.clear();
+  event_prophecy_clocks.clear();
+  good_prophecy_clocks.clear();
+  prophecy_clocks_verify.clear();
+  parser_integer_vars.clear();
+  tmp_single_prop_guards.clear();
+  tmp_prop_guards.clear();
+  continue_successor_comp = false;
 };
 
 
@@ -299,7 +357,7 @@ TOK_CLOCK ":" uinteger ":" TOK_ID attr_list "\n"
      to switch between guards and release/reset operations alternately.
   */
   //is the flag clock defined? if not define it!
-  bool is_tmp_clk_defined = ((std::find(prophecy_clocks_parser.begin(), prophecy_clocks_parser.end(), "tmp")!=prophecy_clocks_parser.end()) && (prophecy_clocks_parser.size()!=0));
+  bool is_tmp_clk_defined = (prophecy_clocks_parser.contains("tmp") && (prophecy_clocks_parser.size()!=0));
   if(!is_tmp_clk_defined){
     //declare tmp clock
     auto const * dtmp = system_declaration->get_clock_declaration("tmp");
@@ -355,7 +413,7 @@ TOK_CLOCK ":" uinteger ":" TOK_ID attr_list "\n"
 | TOK_CLOCK ":" TOK_DEC_HISTORY_CLOCK ":" TOK_ID attr_list"\n"
 { 
 
-  bool is_tmp_clk_defined = ((std::find(prophecy_clocks_parser.begin(), prophecy_clocks_parser.end(), "tmp")!=prophecy_clocks_parser.end()) && (prophecy_clocks_parser.size()!=0));
+  bool is_tmp_clk_defined = (prophecy_clocks_parser.contains("tmp") && (prophecy_clocks_parser.size()!=0));
   if(!is_tmp_clk_defined){
     //declare tmp clock
     auto const * dtmp = system_declaration->get_clock_declaration("tmp");
@@ -409,7 +467,7 @@ TOK_CLOCK ":" uinteger ":" TOK_ID attr_list "\n"
 | TOK_CLOCK ":" TOK_DEC_TIMER ":" TOK_ID attr_list"\n"
 { 
 
-  bool is_tmp_clk_defined = ((std::find(prophecy_clocks_parser.begin(), prophecy_clocks_parser.end(), "tmp")!=prophecy_clocks_parser.end()) && (prophecy_clocks_parser.size()!=0));
+  bool is_tmp_clk_defined = (prophecy_clocks_parser.contains("tmp") && (prophecy_clocks_parser.size()!=0));
   if(!is_tmp_clk_defined){
     //declare tmp clock
     auto const * dtmp = system_declaration->get_clock_declaration("tmp");
@@ -467,7 +525,7 @@ TOK_CLOCK ":" uinteger ":" TOK_ID attr_list "\n"
 | TOK_CLOCK ":" TOK_DEC_NORMAL_CLOCK ":" TOK_ID attr_list"\n"
 {
 
-  bool is_tmp_clk_defined = ((std::find(prophecy_clocks_parser.begin(), prophecy_clocks_parser.end(), "tmp")!=prophecy_clocks_parser.end()) && (prophecy_clocks_parser.size()!=0));
+  bool is_tmp_clk_defined = (prophecy_clocks_parser.contains("tmp") && (prophecy_clocks_parser.size()!=0));
   if(!is_tmp_clk_defined){
     //declare tmp clock
     auto const * dtmp = system_declaration->get_clock_declaration("tmp");
@@ -541,8 +599,8 @@ TOK_CLOCK ":" uinteger ":" TOK_ID attr_list "\n"
             //ani:-100
             //this will get called when attr_list is empty
             //if event clocks are defined for the event then add a guard of event prophecy clock=0 and do for prophecy clocks before and add a do for history clock after
-            bool is_prop_def = (std::find(event_prophecy_clocks.begin(), event_prophecy_clocks.end(), std::string($9)+"_p")!=event_prophecy_clocks.end());
-            bool is_hist_def = (std::find(event_history_clocks.begin(), event_history_clocks.end(), std::string($9)+"_h")!=event_history_clocks.end());
+            bool is_prop_def = event_prophecy_clocks.contains(std::string($9)+"_p");
+            bool is_hist_def = event_history_clocks.contains(std::string($9)+"_h");
 
             if(is_prop_def){
               //prophecy_clock is defined
@@ -615,15 +673,12 @@ TOK_CLOCK ":" uinteger ":" TOK_ID attr_list "\n"
       //iterating through do operations
       while($11[1][tmp_do_ptr]!="tmp" && tmp_do_ptr<$11[1].size()){
 
-        bool is_prop = std::find(prophecy_clocks_parser.begin(), prophecy_clocks_parser.end(), $11[1][tmp_do_ptr])!=prophecy_clocks_parser.end();
+        bool is_prop = prophecy_clocks_parser.contains($11[1][tmp_do_ptr]);
         bool is_finite = std::find(all_prop_checked.begin(), all_prop_checked.end(), $11[1][tmp_do_ptr])!=all_prop_checked.end();
 
         if(is_prop==1 && is_finite==0){ //if the prophecy clock is released without checking for <=-inf or ==-inf or >=0 or ==0
                                         //then it is not a good prophecy clock
-          auto is_good_iter = std::find(good_prophecy_clocks.begin(), good_prophecy_clocks.end(), $11[1][tmp_do_ptr]);
-          if(is_good_iter!=good_prophecy_clocks.end()){
-            good_prophecy_clocks.erase(is_good_iter);
-          }
+          good_prophecy_clocks.erase($11[1][tmp_do_ptr]);
         }
         tmp_do_ptr++;
       }
@@ -639,7 +694,7 @@ TOK_CLOCK ":" uinteger ":" TOK_ID attr_list "\n"
     //if prophecy_clocks_verify is not a subseteq of good prophecy clocks then finiteness not guranteed!!!!
     for(auto i:prophecy_clocks_verify){
       
-      bool is_finite = (std::find(good_prophecy_clocks.begin(), good_prophecy_clocks.end(), i)!=good_prophecy_clocks.end());
+      bool is_finite = good_prophecy_clocks.contains(i);
       
       if(is_finite==0){   //there is a clock i which is in prophecy_clocks_verify but not in good_prophecy_clocks
                           //that is there is a diagonal constraint corresponding to it in one of the edges but it is
@@ -661,8 +716,8 @@ TOK_CLOCK ":" uinteger ":" TOK_ID attr_list "\n"
 
 
   //for event clocks
-  bool is_prop_def = (std::find(event_prophecy_clocks.begin(), event_prophecy_clocks.end(), std::string($9)+"_p")!=event_prophecy_clocks.end());
-  bool is_hist_def = (std::find(event_history_clocks.begin(), event_history_clocks.end(), std::string($9)+"_h")!=event_history_clocks.end());
+  bool is_prop_def = event_prophecy_clocks.contains(std::string($9)+"_p");
+  bool is_hist_def = event_history_clocks.contains(std::string($9)+"_h");
   //if the prophecy clock is defined for this event then add a statement prophecy clock ==0 && tmp<=0 in the front of
   //all elements of the vector $11[0]
   //and the statement prophecy clock, tmp=0 in front of the do operation $11[1]
@@ -753,7 +808,7 @@ TOK_CLOCK ":" uinteger ":" TOK_ID attr_list "\n"
                   std::getline(int_var_string, int_var_id, '=');
                   // std::cout << "ANI: " << $11[1][j] << " " << int_var_id << std::endl;
                   if($11[1][j].find('=')!=std::string::npos && 
-                  std::find(parser_integer_vars.begin(),parser_integer_vars.end(),int_var_id)!=parser_integer_vars.end()){
+                  parser_integer_vars.contains(int_var_id)){
                     all_reset_release_clocks = all_reset_release_clocks + $11[1][j] + ";";  
                   }
                   
@@ -824,7 +879,7 @@ TOK_CLOCK ":" uinteger ":" TOK_ID attr_list "\n"
 //bool:bool
 | TOK_EVENT ":" TOK_ID ":" uinteger ":" uinteger attr_list "\n"
 {
-  bool is_tmp_clk_defined = ((std::find(prophecy_clocks_parser.begin(), prophecy_clocks_parser.end(), "tmp")!=prophecy_clocks_parser.end()) && (prophecy_clocks_parser.size()!=0));
+  bool is_tmp_clk_defined = (prophecy_clocks_parser.contains("tmp") && (prophecy_clocks_parser.size()!=0));
   if(!is_tmp_clk_defined){
     //declare tmp clock
     auto const * dtmp = system_declaration->get_clock_declaration("tmp");
@@ -1068,7 +1123,7 @@ program_do2: TOK_PROG_DO eca_release_reset TOK_SEMICOLON program_guard2
   bool add_final_tmp_do = 0; //useful for timers/ if there is a timer assignment in last do operation, then need to add a release operation in this do and another guard and its corresponding empty do operation
   
   for(unsigned int iter_rel_clks=0;iter_rel_clks<$2.size();iter_rel_clks++){
-    bool is_clk_timer = (std::find(timer_clocks_parser.begin(), timer_clocks_parser.end(), $2[iter_rel_clks])!=timer_clocks_parser.end());
+    bool is_clk_timer = timer_clocks_parser.contains($2[iter_rel_clks]);
     if(is_clk_timer){
       //this is a timer
  
@@ -1168,9 +1223,9 @@ non_empty_reset_release: TOK_ID TOK_COMMA non_empty_reset_release
 
 | TOK_ID TOK_EQUAL int_term TOK_COMMA non_empty_reset_release {
   // std::cout << "ANI:MATCHED HERE1 " << $1 << " = " << $3 << std::endl;; 
-  auto iter_int = std::find(parser_integer_vars.begin(),parser_integer_vars.end(),$1);
+  bool const is_int = parser_integer_vars.contains($1);
   
-  if(iter_int==parser_integer_vars.end()){
+  if(!is_int){
     try{
       std::cerr << tchecker::log_error << @$ << " do assignment failed " << $1 << " not an integer variable" << std::endl;
     }
@@ -1181,7 +1236,7 @@ non_empty_reset_release: TOK_ID TOK_COMMA non_empty_reset_release
   else{
     // std::cout << "ANI: " << $1 << " " << $3 << std::endl; 
     std::vector<std::string> v;
-    if (iter_int!=parser_integer_vars.end()){
+    if (is_int){
       v.push_back($1+"="+$3);
     }
     for(auto res_rel:$5)
@@ -1192,9 +1247,9 @@ non_empty_reset_release: TOK_ID TOK_COMMA non_empty_reset_release
 
 | TOK_ID TOK_EQUAL int_term {
   // std::cout << "ANI:MATCHED HERE1 " << $1 << " = " << $3 << std::endl;; 
-  auto iter_int = std::find(parser_integer_vars.begin(),parser_integer_vars.end(),$1);
+  bool const is_int = parser_integer_vars.contains($1);
   
-  if(iter_int==parser_integer_vars.end()){
+  if(!is_int){
     try{
       std::cerr << tchecker::log_error << @$ << " do assignment failed " << $1 << " not an integer variable" << std::endl;
     }
@@ -1205,7 +1260,7 @@ non_empty_reset_release: TOK_ID TOK_COMMA non_empty_reset_release
   else{
     // std::cout << "ANI: " << $1 << " " << $3 << std::endl; 
     std::vector<std::string> v;
-    if (iter_int!=parser_integer_vars.end()){
+    if (is_int){
       v.push_back($1+"="+$3);
     }
     $$ = v;
@@ -1214,10 +1269,10 @@ non_empty_reset_release: TOK_ID TOK_COMMA non_empty_reset_release
 
 | TOK_ID TOK_EQUAL TOK_TEXT TOK_COMMA non_empty_reset_release
 { 
-  auto iter = std::find(timer_clocks_parser.begin(),timer_clocks_parser.end(),$1);
-  auto iter_int = std::find(parser_integer_vars.begin(),parser_integer_vars.end(),$1);
-  // std::cout << "ani: -211 " << (iter==timer_clocks_parser.end()) << " " << $1 << " " << $3 << std::endl;
-  if(iter==timer_clocks_parser.end() && iter_int==parser_integer_vars.end()){
+  bool const is_timer = timer_clocks_parser.contains($1);
+  bool const is_int = parser_integer_vars.contains($1);
+  // std::cout << "ani: -211 " << (!is_timer) << " " << $1 << " " << $3 << std::endl;
+  if(!is_timer && !is_int){
     try{
       std::cerr << tchecker::log_error << @$ << " do assignment failed, clock " << $1 << " not a timer nor an integer variable" << std::endl;
     }
@@ -1231,7 +1286,7 @@ non_empty_reset_release: TOK_ID TOK_COMMA non_empty_reset_release
     int value_assign = std::stoi($3);
     // value_assign = -1*value_assign; assuming timers are assigned negative values only
     // std::cout << "ani: -090 " << value_assign << std::endl;
-    if (iter_int!=parser_integer_vars.end()){
+    if (is_int){
       v.push_back($1+"="+std::to_string(value_assign));
     }
     else{
@@ -1250,9 +1305,9 @@ non_empty_reset_release: TOK_ID TOK_COMMA non_empty_reset_release
 
 | TOK_ID TOK_EQUAL TOK_TEXT
 { 
-  auto iter = std::find(timer_clocks_parser.begin(),timer_clocks_parser.end(),$1);
-  auto iter_int = std::find(parser_integer_vars.begin(),parser_integer_vars.end(),$1);
-  if(iter==timer_clocks_parser.end() && iter_int==parser_integer_vars.end()){
+  bool const is_timer = timer_clocks_parser.contains($1);
+  bool const is_int = parser_integer_vars.contains($1);
+  if(!is_timer && !is_int){
     try{
       std::cerr << tchecker::log_error << @$ << " do assignment failed, clock " << $1 << " not a timer nor an integer variable" << std::endl;
     }
@@ -1266,7 +1321,7 @@ non_empty_reset_release: TOK_ID TOK_COMMA non_empty_reset_release
     int value_assign = std::stoi($3);
     // value_assign = -1*value_assign;
     
-    if(iter==timer_clocks_parser.end()){
+    if(!is_timer){
       v.push_back($1+"="+std::to_string(value_assign));
     }
     else{
@@ -1321,7 +1376,7 @@ eca_single_guard2: TOK_ID TOK_LE TOK_TEXT {
   $$ = guard;
 
   //finiteness check if prophecy clock is checked <=-inf
-  bool is_prop = (std::find(prophecy_clocks_parser.begin(), prophecy_clocks_parser.end(), $1)!=prophecy_clocks_parser.end());
+  bool is_prop = prophecy_clocks_parser.contains($1);
   bool is_minus_inf = (std::stoi($3)==tchecker::dbm::MINUS_INF_VALUE);
   if(is_prop==1 && is_minus_inf==1){
     bool is_already = (std::find(tmp_single_prop_guards.begin(), tmp_single_prop_guards.end(), $1)!=tmp_single_prop_guards.end());
@@ -1349,7 +1404,7 @@ eca_single_guard2: TOK_ID TOK_LE TOK_TEXT {
   $$ = guard;
 
   //finiteness check if the prophecy clock is checked for >=0
-  bool is_prop = (std::find(prophecy_clocks_parser.begin(), prophecy_clocks_parser.end(), $1)!=prophecy_clocks_parser.end());
+  bool is_prop = prophecy_clocks_parser.contains($1);
   bool is_zero = (std::stoi($3)==0);
   if(is_prop==1 && is_zero==1){
     bool is_already = (std::find(tmp_single_prop_guards.begin(), tmp_single_prop_guards.end(), $1)!=tmp_single_prop_guards.end());
@@ -1375,7 +1430,7 @@ eca_single_guard2: TOK_ID TOK_LE TOK_TEXT {
   $$ = guard;
 
   //for finiteness check if prophecy clock is checked for ==-inf or ==0
-  bool is_prop = (std::find(prophecy_clocks_parser.begin(), prophecy_clocks_parser.end(), $1)!=prophecy_clocks_parser.end());
+  bool is_prop = prophecy_clocks_parser.contains($1);
   bool is_minus_inf = (std::stoi($3)==tchecker::dbm::MINUS_INF_VALUE);
   bool is_zero = (std::stoi($3)==0);
   
@@ -1396,13 +1451,13 @@ eca_single_guard2: TOK_ID TOK_LE TOK_TEXT {
   $$ = guard;
 
   //required for finiteness check
-  bool is_prop1 = (std::find(prophecy_clocks_parser.begin(), prophecy_clocks_parser.end(), $1)!=prophecy_clocks_parser.end());
-  bool is_prop2 = (std::find(prophecy_clocks_parser.begin(), prophecy_clocks_parser.end(), $3)!=prophecy_clocks_parser.end());
+  bool is_prop1 = prophecy_clocks_parser.contains($1);
+  bool is_prop2 = prophecy_clocks_parser.contains($3);
   if(is_prop1==1 && is_prop2==1){
-    bool is_prop3 = (std::find(prophecy_clocks_verify.begin(), prophecy_clocks_verify.end(), $1)!=prophecy_clocks_verify.end());
+    bool is_prop3 = prophecy_clocks_verify.contains($1);
     if(is_prop3==0)
       prophecy_clocks_verify.push_back($1);
-    bool is_prop4 = (std::find(prophecy_clocks_verify.begin(), prophecy_clocks_verify.end(), $3)!=prophecy_clocks_verify.end());
+    bool is_prop4 = prophecy_clocks_verify.contains($3);
     if(is_prop4==0)
       prophecy_clocks_verify.push_back($3);
   }
@@ -1417,27 +1472,27 @@ eca_single_guard2: TOK_ID TOK_LE TOK_TEXT {
   $$ = guard;
 
   //required for finiteness check
-  bool is_prop1 = (std::find(prophecy_clocks_parser.begin(), prophecy_clocks_parser.end(), $1)!=prophecy_clocks_parser.end());
-  bool is_prop2 = (std::find(prophecy_clocks_parser.begin(), prophecy_clocks_parser.end(), $3)!=prophecy_clocks_parser.end());
+  bool is_prop1 = prophecy_clocks_parser.contains($1);
+  bool is_prop2 = prophecy_clocks_parser.contains($3);
   if(is_prop1==1 && is_prop2==1){
-    bool is_prop3 = (std::find(prophecy_clocks_verify.begin(), prophecy_clocks_verify.end(), $1)!=prophecy_clocks_verify.end());
+    bool is_prop3 = prophecy_clocks_verify.contains($1);
     if(is_prop3==0)
       prophecy_clocks_verify.push_back($1);
-    bool is_prop4 = (std::find(prophecy_clocks_verify.begin(), prophecy_clocks_verify.end(), $3)!=prophecy_clocks_verify.end());
+    bool is_prop4 = prophecy_clocks_verify.contains($3);
     if(is_prop4==0)
       prophecy_clocks_verify.push_back($3);
   }
 }
 | TOK_ID TOK_MINUS TOK_ID TOK_GE TOK_TEXT {
-  auto is_prop1 = std::find(prophecy_clocks_parser.begin(), prophecy_clocks_parser.end(), $1);
-  auto is_hist1 = std::find(history_clocks_parser.begin(), history_clocks_parser.end(), $1);
+  bool const is_prop1 = prophecy_clocks_parser.contains($1);
+  bool const is_hist1 = history_clocks_parser.contains($1);
   
-  auto is_prop2 = std::find(prophecy_clocks_parser.begin(), prophecy_clocks_parser.end(), $3);
-  auto is_hist2 = std::find(history_clocks_parser.begin(), history_clocks_parser.end(), $3);
+  bool const is_prop2 = prophecy_clocks_parser.contains($3);
+  bool const is_hist2 = history_clocks_parser.contains($3);
   
   std::vector<std::string> guards;
 
-  if(is_prop1!=prophecy_clocks_parser.end() && is_prop2!=prophecy_clocks_parser.end()){
+  if(is_prop1 && is_prop2){
     //prophecy1-prophecy2 >= number  iff prophecy2-prophecy1 <= -number or prophecy2==prophecy1==-inf
     
     if($5[0]=='-'){
@@ -1461,7 +1516,7 @@ eca_single_guard2: TOK_ID TOK_LE TOK_TEXT {
     guards.push_back(guard2);
     
   }
-  if(is_hist1!=history_clocks_parser.end() && is_prop2!=prophecy_clocks_parser.end()){
+  if(is_hist1 && is_prop2){
     //history-prophecy >= number iff prophecy-history <= -number
 
     if($5[0]=='-'){
@@ -1480,7 +1535,7 @@ eca_single_guard2: TOK_ID TOK_LE TOK_TEXT {
     guards.push_back(guard);
   
   }
-  if(is_prop1!=prophecy_clocks_parser.end() && is_hist2!=history_clocks_parser.end()){
+  if(is_prop1 && is_hist2){
     //prophecy - history >= number iff history - prophecy <= -number
 
     if($5[0]=='-'){
@@ -1499,7 +1554,7 @@ eca_single_guard2: TOK_ID TOK_LE TOK_TEXT {
     guards.push_back(guard);
 
   }
-  if(is_hist1!=history_clocks_parser.end() && is_hist2!=history_clocks_parser.end()){
+  if(is_hist1 && is_hist2){
     //histroy1 - history2 >= number iff history2-history1<=-number or history1==history2==INF
     if($5[0]=='-'){
       $5[0] = ' ';
@@ -1525,27 +1580,27 @@ eca_single_guard2: TOK_ID TOK_LE TOK_TEXT {
   $$=guards;
 
   //required for finiteness check
-  bool is_prop5 = (std::find(prophecy_clocks_parser.begin(), prophecy_clocks_parser.end(), $1)!=prophecy_clocks_parser.end());
-  bool is_prop6 = (std::find(prophecy_clocks_parser.begin(), prophecy_clocks_parser.end(), $3)!=prophecy_clocks_parser.end());
+  bool is_prop5 = prophecy_clocks_parser.contains($1);
+  bool is_prop6 = prophecy_clocks_parser.contains($3);
   if(is_prop5==1 && is_prop6==1){
-    bool is_prop7 = (std::find(prophecy_clocks_verify.begin(), prophecy_clocks_verify.end(), $1)!=prophecy_clocks_verify.end());
+    bool is_prop7 = prophecy_clocks_verify.contains($1);
     if(is_prop7==0)
       prophecy_clocks_verify.push_back($1);
-    bool is_prop8 = (std::find(prophecy_clocks_verify.begin(), prophecy_clocks_verify.end(), $3)!=prophecy_clocks_verify.end());
+    bool is_prop8 = prophecy_clocks_verify.contains($3);
     if(is_prop8==0)
       prophecy_clocks_verify.push_back($3);
   }
 }
 | TOK_ID TOK_MINUS TOK_ID TOK_GT TOK_TEXT {
-  auto is_prop1 = std::find(prophecy_clocks_parser.begin(), prophecy_clocks_parser.end(), $1);
-  auto is_hist1 = std::find(history_clocks_parser.begin(), history_clocks_parser.end(), $1);
+  bool const is_prop1 = prophecy_clocks_parser.contains($1);
+  bool const is_hist1 = history_clocks_parser.contains($1);
   
-  auto is_prop2 = std::find(prophecy_clocks_parser.begin(), prophecy_clocks_parser.end(), $3);
-  auto is_hist2 = std::find(history_clocks_parser.begin(), history_clocks_parser.end(), $3);
+  bool const is_prop2 = prophecy_clocks_parser.contains($3);
+  bool const is_hist2 = history_clocks_parser.contains($3);
   
   std::vector<std::string> guards;
 
-  if(is_prop1!=prophecy_clocks_parser.end() && is_prop2!=prophecy_clocks_parser.end()){
+  if(is_prop1 && is_prop2){
     //prophecy1-prophecy2 >= number  iff prophecy2-prophecy1 <= -number or prophecy2==prophecy1==-inf
     
     if($5[0]=='-'){
@@ -1569,7 +1624,7 @@ eca_single_guard2: TOK_ID TOK_LE TOK_TEXT {
     guards.push_back(guard2);
     
   }
-  if(is_hist1!=history_clocks_parser.end() && is_prop2!=prophecy_clocks_parser.end()){
+  if(is_hist1 && is_prop2){
     //history-prophecy >= number iff prophecy-history <= -number
 
     if($5[0]=='-'){
@@ -1588,7 +1643,7 @@ eca_single_guard2: TOK_ID TOK_LE TOK_TEXT {
     guards.push_back(guard);
   
   }
-  if(is_prop1!=prophecy_clocks_parser.end() && is_hist2!=history_clocks_parser.end()){
+  if(is_prop1 && is_hist2){
     //prophecy - history >= number iff history - prophecy <= -number
 
     if($5[0]=='-'){
@@ -1607,7 +1662,7 @@ eca_single_guard2: TOK_ID TOK_LE TOK_TEXT {
     guards.push_back(guard);
 
   }
-  if(is_hist1!=history_clocks_parser.end() && is_hist2!=history_clocks_parser.end()){
+  if(is_hist1 && is_hist2){
     //histroy1 - history2 >= number iff history2-history1<=-number or history1==history2==INF
     if($5[0]=='-'){
       $5[0] = ' ';
@@ -1634,27 +1689,27 @@ eca_single_guard2: TOK_ID TOK_LE TOK_TEXT {
 
 
     //required for finiteness check
-  bool is_prop5 = (std::find(prophecy_clocks_parser.begin(), prophecy_clocks_parser.end(), $1)!=prophecy_clocks_parser.end());
-  bool is_prop6 = (std::find(prophecy_clocks_parser.begin(), prophecy_clocks_parser.end(), $3)!=prophecy_clocks_parser.end());
+  bool is_prop5 = prophecy_clocks_parser.contains($1);
+  bool is_prop6 = prophecy_clocks_parser.contains($3);
   if(is_prop5==1 && is_prop6==1){
-    bool is_prop7 = (std::find(prophecy_clocks_verify.begin(), prophecy_clocks_verify.end(), $1)!=prophecy_clocks_verify.end());
+    bool is_prop7 = prophecy_clocks_verify.contains($1);
     if(is_prop7==0)
       prophecy_clocks_verify.push_back($1);
-    bool is_prop8 = (std::find(prophecy_clocks_verify.begin(), prophecy_clocks_verify.end(), $3)!=prophecy_clocks_verify.end());
+    bool is_prop8 = prophecy_clocks_verify.contains($3);
     if(is_prop8==0)
       prophecy_clocks_verify.push_back($3);
   }
 }
 | TOK_ID TOK_MINUS TOK_ID TOK_EQ TOK_TEXT {
-  auto is_prop1 = std::find(prophecy_clocks_parser.begin(), prophecy_clocks_parser.end(), $1);
-  auto is_hist1 = std::find(history_clocks_parser.begin(), history_clocks_parser.end(), $1);
+  bool const is_prop1 = prophecy_clocks_parser.contains($1);
+  bool const is_hist1 = history_clocks_parser.contains($1);
   
-  auto is_prop2 = std::find(prophecy_clocks_parser.begin(), prophecy_clocks_parser.end(), $3);
-  auto is_hist2 = std::find(history_clocks_parser.begin(), history_clocks_parser.end(), $3);
+  bool const is_prop2 = prophecy_clocks_parser.contains($3);
+  bool const is_hist2 = history_clocks_parser.contains($3);
   
   std::vector<std::string> guards;
 
-  if(is_prop1!=prophecy_clocks_parser.end() && is_prop2!=prophecy_clocks_parser.end()){
+  if(is_prop1 && is_prop2){
     //prophecy1-prophecy2 == number  iff prophecy1-prophecy2 <= number and prophecy1-prophecy2>=number
     
     //iff prophecy1-prophecy2 <= number and (prophecy2-prophecy1<=-number or prophecy2==prophecy1==-inf)
@@ -1687,7 +1742,7 @@ eca_single_guard2: TOK_ID TOK_LE TOK_TEXT {
     guards.push_back(guard2);
     
   }
-  if(is_hist1!=history_clocks_parser.end() && is_prop2!=prophecy_clocks_parser.end()){
+  if(is_hist1 && is_prop2){
     //history-prophecy == number iff history-prophecy >= number && history-prophecy <= number
     //iff prophecy-history <= -number && history-prophecy <= number
     
@@ -1708,7 +1763,7 @@ eca_single_guard2: TOK_ID TOK_LE TOK_TEXT {
     guards.push_back(guard);
   
   }
-  if(is_prop1!=prophecy_clocks_parser.end() && is_hist2!=history_clocks_parser.end()){
+  if(is_prop1 && is_hist2){
     //prophecy - history == number iff prophecy - history >= number && prophecy - history <= number
     // iff history - prophecy <= number && prophecy - history <= number
     
@@ -1730,7 +1785,7 @@ eca_single_guard2: TOK_ID TOK_LE TOK_TEXT {
     guards.push_back(guard);
 
   }
-  if(is_hist1!=history_clocks_parser.end() && is_hist2!=history_clocks_parser.end()){
+  if(is_hist1 && is_hist2){
     //histroy1 - history2 == number iff history1-history2<=number && history1-history2>=number
     // iff history1-history2<=number && (history2-history1<=-number or history2 == history1 == inf)
     
@@ -1761,13 +1816,13 @@ eca_single_guard2: TOK_ID TOK_LE TOK_TEXT {
 
 
   //required for finiteness check
-  bool is_prop5 = (std::find(prophecy_clocks_parser.begin(), prophecy_clocks_parser.end(), $1)!=prophecy_clocks_parser.end());
-  bool is_prop6 = (std::find(prophecy_clocks_parser.begin(), prophecy_clocks_parser.end(), $3)!=prophecy_clocks_parser.end());
+  bool is_prop5 = prophecy_clocks_parser.contains($1);
+  bool is_prop6 = prophecy_clocks_parser.contains($3);
   if(is_prop5==1 && is_prop6==1){
-    bool is_prop7 = (std::find(prophecy_clocks_verify.begin(), prophecy_clocks_verify.end(), $1)!=prophecy_clocks_verify.end());
+    bool is_prop7 = prophecy_clocks_verify.contains($1);
     if(is_prop7==0)
       prophecy_clocks_verify.push_back($1);
-    bool is_prop8 = (std::find(prophecy_clocks_verify.begin(), prophecy_clocks_verify.end(), $3)!=prophecy_clocks_verify.end());
+    bool is_prop8 = prophecy_clocks_verify.contains($3);
     if(is_prop8==0)
       prophecy_clocks_verify.push_back($3);
   }
@@ -1828,7 +1883,7 @@ int_term: int_term TOK_PLUS int_term{
   $$ = "-" + $2;
 }
 | TOK_ID {
-  if (std::find(parser_integer_vars.begin(), parser_integer_vars.end(), $1)!=parser_integer_vars.end())
+  if (parser_integer_vars.contains($1))
     $$ = $1;
   else{
     std::cerr << tchecker::log_error << @1 << " " << $1 << " is not an integer variable" << std::endl;
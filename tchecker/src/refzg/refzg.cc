@@ -12,6 +12,7 @@
 #include "tchecker/dbm/db.hh"
 #include "tchecker/dbm/refdbm.hh"
 #include "tchecker/refzg/refzg.hh"
+#include "tchecker/utils/counters.hh"
 #include "tchecker/variables/static_analysis.hh"
 
 namespace tchecker {
@@ -78,7 +79,11 @@ tchecker::state_status_t next(tchecker::ta::system_t const & system,
   if (status != tchecker::STATE_OK)
     return status;
 
-  if (tchecker::refdbm::bound_spread(rdbm, *r, spread) == tchecker::dbm::EMPTY)
+  // The spread was bounded in the source zone, and only the reference clocks
+  // allowed to delay in the source or in the target have been opened up by
+  // semantics (depending on the semantics)
+  if (tchecker::refdbm::incremental_bound_spread(rdbm, *r, spread, src_delay_allowed | tgt_delay_allowed) ==
+      tchecker::dbm::EMPTY)
     return tchecker::STATE_CLOCKS_EMPTY_SPREAD;
 
   if (!tchecker::refdbm::is_synchronizable(rdbm, *r))
@@ -140,9 +145,12 @@ tchecker::refzg::outgoing_edges_range_t refzg_t::outgoing_edges(tchecker::refzg:
 void refzg_t::next(tchecker::refzg::const_state_sptr_t const & s, tchecker::refzg::outgoing_edges_value_t const & out_edge,
                    std::vector<sst_t> & v)
 {
+  TCHECKER_TIME(TIMER_NEXT);
   tchecker::refzg::state_sptr_t nexts = _state_allocator.clone(*s);
   tchecker::refzg::transition_sptr_t t = _transition_allocator.construct();
   tchecker::state_status_t status = tchecker::refzg::next(*_system, *nexts, *t, *_semantics, _spread, out_edge);
+  TCHECKER_COUNT_STATUS(status);
+  TCHECKER_COUNT_MAX(DBM_DIMENSION, nexts->zone().dim());
   v.push_back(std::make_tuple(status, nexts, t));
 }
 
@@ -163,6 +171,8 @@ void refzg_t::attributes(tchecker::refzg::const_transition_sptr_t const & t, std
 
 tchecker::ta::system_t const & refzg_t::system() const { return *_system; }
 
+std::size_t refzg_t::memsize() const { return _state_allocator.memsize() + _transition_allocator.memsize(); }
+
 /* factory */
 
 // Factory of reference clock variables
@@ -58,6 +58,13 @@ bool sync_alu_le(tchecker::refzg::state_t const & s1, tchecker::refzg::state_t c
   return tchecker::ta::operator==(s1, s2) && s1.zone().sync_alu_le(s2.zone(), l, u);
 }
 
+bool sync_g_le(tchecker::refzg::state_t const & s1, tchecker::refzg::state_t const & s2,
+               std::vector<tchecker::typed_diagonal_clkconstr_expression_t const *> & G,
+               std::vector<tchecker::typed_simple_clkconstr_expression_t const *> const & Gdf)
+{
+  return tchecker::ta::operator==(s1, s2) && s1.zone().sync_g_le(s2.zone(), G, Gdf);
+}
+
 int lexical_cmp(tchecker::refzg::state_t const & s1, tchecker::refzg::state_t const & s2)
 {
   int ta_cmp = tchecker::ta::lexical_cmp(s1, s2);
@@ -62,6 +62,13 @@ bool zone_t::sync_alu_le(tchecker::refzg::zone_t const & zone, tchecker::clockbo
          tchecker::refdbm::is_sync_alu_le(dbm_ptr(), zone.dbm_ptr(), *_ref_clocks, l.ptr(), u.ptr());
 }
 
+bool zone_t::sync_g_le(tchecker::refzg::zone_t const & zone,
+                       std::vector<tchecker::typed_diagonal_clkconstr_expression_t const *> & G,
+                       std::vector<tchecker::typed_simple_clkconstr_expression_t const *> const & Gdf) const
+{
+  return (_ref_clocks == zone._ref_clocks) && tchecker::refdbm::is_sync_g_le(dbm_ptr(), zone.dbm_ptr(), *_ref_clocks, G, Gdf);
+}
+
 int zone_t::lexical_cmp(tchecker::refzg::zone_t const & zone) const
 {
   return tchecker::refdbm::lexical_cmp(dbm_ptr(), *_ref_clocks, zone.dbm_ptr(), *zone._ref_clocks);
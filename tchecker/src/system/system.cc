@@ -5,6 +5,7 @@
  *
  */
 
+#include <algorithm>
 #include <limits>
 #include <vector>
 
@@ -32,11 +33,30 @@ public:
 
   /*!
    \brief Build system from inner declarations
+   \note clocks are declared first, grouped by kind: the "tmp" clock, then normal
+   clocks, then history clocks, then prophecy clocks (each group in declaration
+   order), so that each kind of clocks has a contiguous range of identifiers
+   (see tchecker::dbm::clock_layout_t). Other declarations are visited in order
    */
   virtual void visit(tchecker::parsing::system_declaration_t const & d)
   {
+    std::vector<tchecker::parsing::clock_declaration_t const *> clocks;
+    for (tchecker::parsing::declaration_t const * decl : d.declarations()) {
+      auto const * clock_decl = dynamic_cast<tchecker::parsing::clock_declaration_t const *>(decl);
+      if (clock_decl != nullptr)
+        clocks.push_back(clock_decl);
+    }
+
+    std::stable_sort(clocks.begin(), clocks.end(),
+                     [](tchecker::parsing::clock_declaration_t const * d1, tchecker::parsing::clock_declaration_t const * d2) {
+                       return clock_rank(*d1) < clock_rank(*d2);
+                     });
+    for (tchecker::parsing::clock_declaration_t const * clock_decl : clocks)
+      clock_decl->visit(*this);
+
     for (tchecker::parsing::declaration_t const * decl : d.declarations())
-      decl->visit(*this);
+      if (dynamic_cast<tchecker::parsing::clock_declaration_t const *>(decl) == nullptr)
+        decl->visit(*this);
   }
 
   /*!
@@ -137,6 +157,24 @@ public:
   }
 
 private:
+  /*!
+   \brief Rank of a clock declaration in the layout of clocks
+   \param d : a clock declaration
+   \return 0 for the "tmp" clock, 1 for normal clocks (types 0 and 3), 2 for
+   history clocks (type 1) and 3 for prophecy clocks (type 2)
+   */
+  static int clock_rank(tchecker::parsing::clock_declaration_t const & d)
+  {
+    switch (d.clock_type()) {
+    case 1:
+      return 2;
+    case 2:
+      return (d.name() == "tmp" ? 0 : 3);
+    default:
+      return 1;
+    }
+  }
+
   tchecker::system::system_t & _system; /*!< System to build */
 };
 
@@ -0,0 +1,167 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <cassert>
+#include <unordered_set>
+
+#include "tchecker/expression/static_analysis.hh"
+#include "tchecker/statement/static_analysis.hh"
+#include "tchecker/ta/clock_liveness.hh"
+
+namespace tchecker {
+
+namespace ta {
+
+/* clock_projection_t */
+
+tchecker::clock_id_t const clock_projection_t::NO_POSITION;
+
+clock_projection_t::clock_projection_t(tchecker::ta::system_t const & system, boost::dynamic_bitset<> const & clocks)
+{
+  tchecker::clock_id_t const dim = system.clocks_count(tchecker::VK_FLATTENED) + 1;
+  assert(clocks.size() + 1 == dim);
+
+  _position.assign(dim, NO_POSITION);
+  for (tchecker::clock_id_t i = 0; i < dim; ++i) {
+    if (i >= 2 && !clocks[i - 1])
+      continue;
+    tchecker::clock_id_t const p = static_cast<tchecker::clock_id_t>(_index.size());
+    _position[i] = p;
+    _index.push_back(i);
+    if (system.history_clock_id_map.find(i) != system.history_clock_id_map.end())
+      _history_clock_ids.insert(p);
+    else if (system.prophecy_clock_id_map.find(i) != system.prophecy_clock_id_map.end())
+      _prophecy_clock_ids.insert(p);
+    else if (system.normal_clock_id_map.find(i) != system.normal_clock_id_map.end())
+      _normal_clock_ids.insert(p);
+  }
+
+  // the projection of grouped clocks is grouped
+  _grouped_clocks = (system.clock_layout() != nullptr) &&
+                    tchecker::dbm::eca_clock_layout(this->dim(), _history_clock_ids, _prophecy_clock_ids,
+                                                    _normal_clock_ids, _clock_layout);
+}
+
+tchecker::clock_id_t clock_projection_t::position(tchecker::clock_id_t i) const
+{
+  assert(i < _position.size());
+  return _position[i];
+}
+
+tchecker::clock_id_t clock_projection_t::project(tchecker::clock_id_t id) const
+{
+  if (id == tchecker::REFCLOCK_ID)
+    return id;
+  assert(position(id + 1) != NO_POSITION);
+  return position(id + 1) - 1;
+}
+
+tchecker::clock_constraint_t clock_projection_t::project(tchecker::clock_constraint_t const & c) const
+{
+  return tchecker::clock_constraint_t{project(c.id1()), project(c.id2()), c.comparator(), c.value()};
+}
+
+tchecker::clock_reset_t clock_projection_t::project(tchecker::clock_reset_t const & r) const
+{
+  return tchecker::clock_reset_t{project(r.left_id()), project(r.right_id()), r.value()};
+}
+
+/* clock_liveness_t */
+
+clock_liveness_t::clock_liveness_t(tchecker::ta::system_t const & system) : _system(system), _trivial(true)
+{
+  compute_live_clocks();
+}
+
+boost::dynamic_bitset<> const & clock_liveness_t::live_clocks(tchecker::loc_id_t id) const
+{
+  assert(id < _live.size());
+  return _live[id];
+}
+
+void clock_liveness_t::inactive_clocks(tchecker::vloc_t const & vloc, boost::dynamic_bitset<> & inactive) const
+{
+  inactive = _history_clocks;
+  for (tchecker::loc_id_t id : vloc)
+    inactive -= _live[id];
+}
+
+std::shared_ptr<tchecker::ta::clock_projection_t const>
+clock_liveness_t::projection(boost::dynamic_bitset<> const & clocks) const
+{
+  auto it = _projections.find(clocks);
+  if (it != _projections.end())
+    return it->second;
+  std::shared_ptr<tchecker::ta::clock_projection_t const> p{new tchecker::ta::clock_projection_t{_system, clocks}};
+  _projections.emplace(clocks, p);
+  return p;
+}
+
+void clock_liveness_t::compute_live_clocks()
+{
+  tchecker::clock_id_t const clocks_count = _system.clocks_count(tchecker::VK_FLATTENED);
+  tchecker::edge_id_t const edges_count = _system.edges_count();
+
+  _live.assign(_system.locations_count(), boost::dynamic_bitset<>(clocks_count));
+  _history_clocks.resize(clocks_count);
+  for (int i : _system.history_clock_id_map)
+    _history_clocks.set(i - 1); // DBM index -> clock ID
+
+  std::vector<boost::dynamic_bitset<>> read(edges_count, boost::dynamic_bitset<>(clocks_count));
+  std::vector<boost::dynamic_bitset<>> written(edges_count, boost::dynamic_bitset<>(clocks_count));
+  std::unordered_set<tchecker::clock_id_t> clocks;
+  std::unordered_set<tchecker::intvar_id_t> intvars;
+
+  for (tchecker::system::loc_const_shared_ptr_t const & loc : _system.locations()) {
+    tchecker::extract_variables(_system.invariant(loc->id()), clocks, intvars);
+    for (tchecker::clock_id_t x : clocks)
+      _live[loc->id()].set(x);
+    clocks.clear();
+    intvars.clear();
+  }
+
+  for (tchecker::system::edge_const_shared_ptr_t const & edge : _system.edges()) {
+    tchecker::edge_id_t const id = edge->id();
+
+    tchecker::extract_variables(_system.guard(id), clocks, intvars);
+    tchecker::extract_read_variables(_system.statement(id), clocks, intvars);
+    for (tchecker::clock_id_t x : clocks)
+      read[id].set(x);
+    clocks.clear();
+    intvars.clear();
+
+    tchecker::extract_written_variables(_system.statement(id), clocks, intvars);
+    for (tchecker::clock_id_t x : clocks)
+      written[id].set(x);
+    clocks.clear();
+    intvars.clear();
+  }
+
+  // Backward fixpoint: live(src) includes read(e) and live(tgt) \ written(e)
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    for (tchecker::system::edge_const_shared_ptr_t const & edge : _system.edges()) {
+      boost::dynamic_bitset<> live = _live[edge->tgt()] - written[edge->id()];
+      live |= read[edge->id()];
+      if (!live.is_subset_of(_live[edge->src()])) {
+        _live[edge->src()] |= live;
+        changed = true;
+      }
+    }
+  }
+
+  for (boost::dynamic_bitset<> const & live : _live)
+    if (!_history_clocks.is_subset_of(live)) {
+      _trivial = false;
+      break;
+    }
+}
+
+} // end of namespace ta
+
+} // end of namespace tchecker
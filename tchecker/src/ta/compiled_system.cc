@@ -0,0 +1,919 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "tchecker/ta/compiled_system.hh"
+#include "tchecker/vm/vm.hh"
+
+namespace tchecker {
+
+namespace ta {
+
+/* Binary format */
+
+static std::uint32_t const MAGIC = 0x434b4354;      /*!< "TCKC" */
+static std::uint32_t const ENDIANNESS = 0x01020304; /*!< Detects files written on another architecture */
+static std::uint32_t const END = 0x21444e45;        /*!< "END!" */
+
+/*!
+ \brief Tags of typed expressions
+ */
+enum expression_tag_t : std::uint8_t {
+  EXPR_TAG_INT = 1,
+  EXPR_TAG_VAR,
+  EXPR_TAG_BOUNDED_VAR,
+  EXPR_TAG_ARRAY,
+  EXPR_TAG_PAR,
+  EXPR_TAG_BINARY,
+  EXPR_TAG_UNARY,
+  EXPR_TAG_SIMPLE_CLKCONSTR,
+  EXPR_TAG_DIAGONAL_CLKCONSTR,
+  EXPR_TAG_ITE,
+};
+
+/*!
+ \brief Tags of typed statements
+ */
+enum statement_tag_t : std::uint8_t {
+  STMT_TAG_NOP = 1,
+  STMT_TAG_ASSIGN,
+  STMT_TAG_INT_TO_CLOCK,
+  STMT_TAG_CLOCK_TO_CLOCK,
+  STMT_TAG_SUM_TO_CLOCK,
+  STMT_TAG_SEQUENCE,
+  STMT_TAG_IF,
+  STMT_TAG_WHILE,
+  STMT_TAG_LOCAL_VAR,
+  STMT_TAG_LOCAL_ARRAY,
+};
+
+/* Writer */
+
+/*!
+ \brief Write a value
+ \param os : output stream
+ \param v : value
+ \post the bytes of v have been written to os
+ */
+template <class T> static void write(std::ostream & os, T v) { os.write(reinterpret_cast<char const *>(&v), sizeof(v)); }
+
+/*!
+ \brief Write a string
+ \param os : output stream
+ \param s : string
+ \post the length of s followed by the characters in s have been written to os
+ */
+static void write_string(std::ostream & os, std::string const & s)
+{
+  write<std::uint32_t>(os, static_cast<std::uint32_t>(s.size()));
+  os.write(s.data(), s.size());
+}
+
+/*!
+ \brief Write attributes
+ \param os : output stream
+ \param attr : attributes
+ \post the number of attributes in attr followed by the (key, value) pairs in
+ attr have been written to os
+ */
+static void write_attributes(std::ostream & os, tchecker::system::attributes_t const & attr)
+{
+  auto range = attr.attributes();
+  std::uint32_t count = 0;
+  for (auto it = range.begin(); it != range.end(); ++it)
+    ++count;
+  write<std::uint32_t>(os, count);
+  for (auto && [key, value] : range) {
+    write_string(os, key);
+    write_string(os, value);
+  }
+}
+
+/*!
+ \brief Write bytecode
+ \param os : output stream
+ \param bytecode : bytecode
+ \pre bytecode is RET-terminated
+ \post the length of bytecode followed by its instructions have been written to
+ os
+ */
+static void write_bytecode(std::ostream & os, tchecker::bytecode_t const * bytecode)
+{
+  std::size_t const size = tchecker::bytecode_size(bytecode);
+  write<std::uint32_t>(os, static_cast<std::uint32_t>(size));
+  os.write(reinterpret_cast<char const *>(bytecode), size * sizeof(*bytecode));
+}
+
+/*!
+ \brief Write a vector of integers
+ \param os : output stream
+ \param v : vector
+ \post the size of v followed by the integers in v have been written to os
+ */
+static void write_ints(std::ostream & os, std::vector<int> const & v)
+{
+  write<std::uint32_t>(os, static_cast<std::uint32_t>(v.size()));
+  for (int i : v)
+    write<std::int32_t>(os, i);
+}
+
+/*!
+ \brief Write a vector of strings
+ \param os : output stream
+ \param v : vector
+ \post the size of v followed by the strings in v have been written to os
+ */
+static void write_strings(std::ostream & os, std::vector<std::string> const & v)
+{
+  write<std::uint32_t>(os, static_cast<std::uint32_t>(v.size()));
+  for (std::string const & s : v)
+    write_string(os, s);
+}
+
+/*!
+ \class expression_writer_t
+ \brief Writes typed expressions to an output stream: a tag and a type, followed
+ by the fields and the sub-expressions of each expression
+ */
+class expression_writer_t : public tchecker::typed_expression_visitor_t {
+public:
+  /*!
+   \brief Constructor
+   \param os : output stream
+   */
+  expression_writer_t(std::ostream & os) : _os(os) {}
+
+  virtual void visit(tchecker::typed_int_expression_t const & expr)
+  {
+    header(EXPR_TAG_INT, expr);
+    write<std::int64_t>(_os, expr.value());
+  }
+
+  virtual void visit(tchecker::typed_var_expression_t const & expr)
+  {
+    header(EXPR_TAG_VAR, expr);
+    variable(expr);
+  }
+
+  virtual void visit(tchecker::typed_bounded_var_expression_t const & expr)
+  {
+    header(EXPR_TAG_BOUNDED_VAR, expr);
+    variable(expr);
+    write<std::int64_t>(_os, expr.min());
+    write<std::int64_t>(_os, expr.max());
+  }
+
+  virtual void visit(tchecker::typed_array_expression_t const & expr)
+  {
+    header(EXPR_TAG_ARRAY, expr);
+    expr.variable().visit(*this);
+    expr.offset().visit(*this);
+  }
+
+  virtual void visit(tchecker::typed_par_expression_t const & expr)
+  {
+    header(EXPR_TAG_PAR, expr);
+    expr.expr().visit(*this);
+  }
+
+  virtual void visit(tchecker::typed_binary_expression_t const & expr)
+  {
+    binary(EXPR_TAG_BINARY, expr);
+  }
+
+  virtual void visit(tchecker::typed_unary_expression_t const & expr)
+  {
+    header(EXPR_TAG_UNARY, expr);
+    write<std::uint8_t>(_os, expr.unary_operator());
+    expr.operand().visit(*this);
+  }
+
+  virtual void visit(tchecker::typed_simple_clkconstr_expression_t const & expr)
+  {
+    binary(EXPR_TAG_SIMPLE_CLKCONSTR, expr);
+  }
+
+  virtual void visit(tchecker::typed_diagonal_clkconstr_expression_t const & expr)
+  {
+    binary(EXPR_TAG_DIAGONAL_CLKCONSTR, expr);
+  }
+
+  virtual void visit(tchecker::typed_ite_expression_t const & expr)
+  {
+    header(EXPR_TAG_ITE, expr);
+    expr.condition().visit(*this);
+    expr.then_value().visit(*this);
+    expr.else_value().visit(*this);
+  }
+
+private:
+  void header(enum expression_tag_t tag, tchecker::typed_expression_t const & expr)
+  {
+    write<std::uint8_t>(_os, tag);
+    write<std::uint8_t>(_os, expr.type());
+  }
+
+  void variable(tchecker::typed_var_expression_t const & expr)
+  {
+    write_string(_os, expr.name());
+    write<std::uint32_t>(_os, expr.id());
+    write<std::uint32_t>(_os, expr.size());
+  }
+
+  void binary(enum expression_tag_t tag, tchecker::typed_binary_expression_t const & expr)
+  {
+    header(tag, expr);
+    write<std::uint8_t>(_os, expr.binary_operator());
+    expr.left_operand().visit(*this);
+    expr.right_operand().visit(*this);
+  }
+
+  std::ostream & _os; /*!< Output stream */
+};
+
+/*!
+ \class statement_writer_t
+ \brief Writes typed statements to an output stream: a tag and a type, followed
+ by the expressions and the sub-statements of each statement
+ */
+class statement_writer_t : public tchecker::typed_statement_visitor_t {
+public:
+  /*!
+   \brief Constructor
+   \param os : output stream
+   */
+  statement_writer_t(std::ostream & os) : _os(os), _expr_writer(os) {}
+
+  virtual void visit(tchecker::typed_nop_statement_t const & stmt) { header(STMT_TAG_NOP, stmt); }
+
+  virtual void visit(tchecker::typed_assign_statement_t const & stmt) { assign(STMT_TAG_ASSIGN, stmt); }
+
+  virtual void visit(tchecker::typed_int_to_clock_assign_statement_t const & stmt)
+  {
+    assign(STMT_TAG_INT_TO_CLOCK, stmt);
+  }
+
+  virtual void visit(tchecker::typed_clock_to_clock_assign_statement_t const & stmt)
+  {
+    assign(STMT_TAG_CLOCK_TO_CLOCK, stmt);
+  }
+
+  virtual void visit(tchecker::typed_sum_to_clock_assign_statement_t const & stmt)
+  {
+    assign(STMT_TAG_SUM_TO_CLOCK, stmt);
+  }
+
+  virtual void visit(tchecker::typed_sequence_statement_t const & stmt)
+  {
+    header(STMT_TAG_SEQUENCE, stmt);
+    stmt.first().visit(*this);
+    stmt.second().visit(*this);
+  }
+
+  virtual void visit(tchecker::typed_if_statement_t const & stmt)
+  {
+    header(STMT_TAG_IF, stmt);
+    stmt.condition().visit(_expr_writer);
+    stmt.then_stmt().visit(*this);
+    stmt.else_stmt().visit(*this);
+  }
+
+  virtual void visit(tchecker::typed_while_statement_t const & stmt)
+  {
+    header(STMT_TAG_WHILE, stmt);
+    stmt.condition().visit(_expr_writer);
+    stmt.statement().visit(*this);
+  }
+
+  virtual void visit(tchecker::typed_local_var_statement_t const & stmt)
+  {
+    header(STMT_TAG_LOCAL_VAR, stmt);
+    stmt.variable().visit(_expr_writer);
+    stmt.initial_value().visit(_expr_writer);
+  }
+
+  virtual void visit(tchecker::typed_local_array_statement_t const & stmt)
+  {
+    header(STMT_TAG_LOCAL_ARRAY, stmt);
+    stmt.variable().visit(_expr_writer);
+    stmt.size().visit(_expr_writer);
+  }
+
+private:
+  void header(enum statement_tag_t tag, tchecker::typed_statement_t const & stmt)
+  {
+    write<std::uint8_t>(_os, tag);
+    write<std::uint8_t>(_os, stmt.type());
+  }
+
+  void assign(enum statement_tag_t tag, tchecker::typed_assign_statement_t const & stmt)
+  {
+    header(tag, stmt);
+    stmt.lvalue().visit(_expr_writer);
+    stmt.rvalue().visit(_expr_writer);
+  }
+
+  std::ostream & _os;                 /*!< Output stream */
+  expression_writer_t _expr_writer;   /*!< Writer of expressions */
+};
+
+void write_compiled_system(std::ostream & os, tchecker::ta::system_t const & system)
+{
+  tchecker::system::system_t const & s = system.as_system_system();
+
+  write<std::uint32_t>(os, MAGIC);
+  write<std::uint32_t>(os, ENDIANNESS);
+  write<std::uint32_t>(os, tchecker::ta::COMPILED_SYSTEM_VERSION);
+  write<std::uint32_t>(os, sizeof(tchecker::integer_t));
+
+  write_string(os, s.name());
+  write_attributes(os, s.attributes());
+
+  // Clocks (declared) and kinds of clocks
+  write<std::uint32_t>(os, s.clocks_count(tchecker::VK_DECLARED));
+  for (tchecker::clock_id_t id = 0; id < s.clocks_count(tchecker::VK_DECLARED); ++id) {
+    write_string(os, s.clock_name(id));
+    write<std::uint32_t>(os, s.clock_variables().info(id).size());
+    write_attributes(os, s.clock_attributes(id));
+  }
+  write_ints(os, s.history_clock_ids);
+  write_strings(os, s.history_clock_events);
+  write_ints(os, s.prophecy_clock_ids);
+  write_strings(os, s.prophecy_clock_events);
+  write_ints(os, s.normal_clock_ids);
+
+  // Bounded integer variables (declared)
+  write<std::uint32_t>(os, s.intvars_count(tchecker::VK_DECLARED));
+  for (tchecker::intvar_id_t id = 0; id < s.intvars_count(tchecker::VK_DECLARED); ++id) {
+    tchecker::intvar_info_t const & info = s.integer_variables().info(id);
+    write_string(os, s.intvar_name(id));
+    write<std::uint32_t>(os, info.size());
+    write<std::int64_t>(os, info.min());
+    write<std::int64_t>(os, info.max());
+    write<std::int64_t>(os, info.initial_value());
+    write_attributes(os, s.intvar_attributes(id));
+  }
+
+  // Events, processes, locations, edges and synchronizations
+  write<std::uint32_t>(os, s.events_count());
+  for (tchecker::event_id_t id = 0; id < s.events_count(); ++id) {
+    write_string(os, s.event_name(id));
+    write_attributes(os, s.event_attributes(id));
+  }
+
+  write<std::uint32_t>(os, s.processes_count());
+  for (tchecker::process_id_t id = 0; id < s.processes_count(); ++id) {
+    write_string(os, s.process_name(id));
+    write_attributes(os, s.process_attributes(id));
+  }
+
+  write<std::uint32_t>(os, s.locations_count());
+  for (tchecker::loc_id_t id = 0; id < s.locations_count(); ++id) {
+    tchecker::system::loc_const_shared_ptr_t const & loc = s.location(id);
+    write<std::uint32_t>(os, loc->pid());
+    write_string(os, loc->name());
+    write_attributes(os, loc->attributes());
+  }
+
+  write<std::uint32_t>(os, s.edges_count());
+  for (tchecker::edge_id_t id = 0; id < s.edges_count(); ++id) {
+    tchecker::system::edge_const_shared_ptr_t const & edge = s.edge(id);
+    write<std::uint32_t>(os, edge->pid());
+    write<std::uint32_t>(os, edge->src());
+    write<std::uint32_t>(os, edge->tgt());
+    write<std::uint32_t>(os, edge->event_id());
+    write_attributes(os, edge->attributes());
+  }
+
+  write<std::uint32_t>(os, s.synchronizations_count());
+  for (tchecker::sync_id_t id = 0; id < s.synchronizations_count(); ++id) {
+    tchecker::system::synchronization_t const & sync = s.synchronization(id);
+    auto constraints = sync.synchronization_constraints();
+    write<std::uint32_t>(os, static_cast<std::uint32_t>(std::distance(constraints.begin(), constraints.end())));
+    for (tchecker::system::sync_constraint_t const & c : constraints) {
+      write<std::uint32_t>(os, c.pid());
+      write<std::uint32_t>(os, c.event_id());
+      write<std::uint8_t>(os, c.strength());
+    }
+    write_attributes(os, sync.attributes());
+  }
+
+  // Typed and compiled invariants, guards and statements
+  expression_writer_t expr_writer{os};
+  statement_writer_t stmt_writer{os};
+
+  for (tchecker::loc_id_t id = 0; id < system.locations_count(); ++id) {
+    system.invariant(id).visit(expr_writer);
+    write_bytecode(os, system.invariant_bytecode(id));
+  }
+
+  for (tchecker::edge_id_t id = 0; id < system.edges_count(); ++id) {
+    system.guard(id).visit(expr_writer);
+    write_bytecode(os, system.guard_bytecode(id));
+    system.statement(id).visit(stmt_writer);
+    write_bytecode(os, system.statement_bytecode(id));
+  }
+
+  write<std::uint32_t>(os, END);
+
+  if (!os)
+    throw std::runtime_error("Failed to write compiled system");
+}
+
+void write_compiled_system(std::string const & filename, tchecker::ta::system_t const & system)
+{
+  std::ofstream ofs{filename, std::ios::binary | std::ios::trunc};
+  if (!ofs)
+    throw std::runtime_error("Cannot open file " + filename + " for writing");
+  write_compiled_system(ofs, system);
+  ofs.flush();
+  if (!ofs)
+    throw std::runtime_error("Failed to write compiled system to " + filename);
+}
+
+/* Loader */
+
+/*!
+ \class mapped_file_t
+ \brief Read-only memory mapping of a file
+ */
+class mapped_file_t {
+public:
+  /*!
+   \brief Constructor
+   \param filename : name of a file
+   \post filename has been mapped in memory
+   \throw std::runtime_error : if filename cannot be mapped
+   */
+  mapped_file_t(std::string const & filename) : _data(nullptr), _size(0)
+  {
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+      throw std::runtime_error("Cannot open file " + filename);
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+      ::close(fd);
+      throw std::runtime_error("Cannot stat file " + filename);
+    }
+    _size = static_cast<std::size_t>(st.st_size);
+
+    if (_size > 0) {
+      void * p = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (p == MAP_FAILED) {
+        ::close(fd);
+        throw std::runtime_error("Cannot map file " + filename);
+      }
+      _data = static_cast<char const *>(p);
+    }
+    ::close(fd);
+  }
+
+  mapped_file_t(mapped_file_t const &) = delete;
+
+  mapped_file_t & operator=(mapped_file_t const &) = delete;
+
+  /*!
+   \brief Destructor
+   \post the mapping has been released
+   */
+  ~mapped_file_t()
+  {
+    if (_data != nullptr)
+      ::munmap(const_cast<char *>(_data), _size);
+  }
+
+  inline char const * begin() const { return _data; }
+
+  inline char const * end() const { return _data + _size; }
+
+private:
+  char const * _data; /*!< Mapped bytes */
+  std::size_t _size;  /*!< Size of the file */
+};
+
+/*!
+ \class reader_t
+ \brief Bounds-checked reader of a compiled system
+ \note all read functions throw std::runtime_error on truncated or invalid input
+ */
+class reader_t {
+public:
+  /*!
+   \brief Constructor
+   \param begin : pointer to first byte
+   \param end : past-the-end pointer
+   */
+  reader_t(char const * begin, char const * end) : _p(begin), _end(end) {}
+
+  /*!
+   \brief Accessor
+   \return true if all bytes have been read, false otherwise
+   */
+  inline bool at_end() const { return _p == _end; }
+
+  template <class T> T read()
+  {
+    T v;
+    require(sizeof(v));
+    std::memcpy(&v, _p, sizeof(v));
+    _p += sizeof(v);
+    return v;
+  }
+
+  std::string read_string()
+  {
+    std::uint32_t const size = read<std::uint32_t>();
+    require(size);
+    std::string s{_p, size};
+    _p += size;
+    return s;
+  }
+
+  tchecker::system::attributes_t read_attributes()
+  {
+    tchecker::system::attributes_t attr;
+    std::uint32_t const count = read<std::uint32_t>();
+    for (std::uint32_t i = 0; i < count; ++i) {
+      std::string key = read_string();
+      std::string value = read_string();
+      attr.add_attribute(key, value);
+    }
+    return attr;
+  }
+
+  std::vector<int> read_ints()
+  {
+    std::uint32_t const size = read<std::uint32_t>();
+    require(static_cast<std::size_t>(size) * sizeof(std::int32_t));
+    std::vector<int> v(size);
+    for (int & i : v)
+      i = read<std::int32_t>();
+    return v;
+  }
+
+  std::vector<std::string> read_strings()
+  {
+    std::uint32_t const size = read<std::uint32_t>();
+    std::vector<std::string> v;
+    for (std::uint32_t i = 0; i < size; ++i)
+      v.push_back(read_string());
+    return v;
+  }
+
+  tchecker::integer_t read_integer()
+  {
+    std::int64_t const v = read<std::int64_t>();
+    if (v < std::numeric_limits<tchecker::integer_t>::min() || v > std::numeric_limits<tchecker::integer_t>::max())
+      invalid("integer out of range");
+    return static_cast<tchecker::integer_t>(v);
+  }
+
+  std::shared_ptr<tchecker::bytecode_t> read_bytecode()
+  {
+    std::uint32_t const size = read<std::uint32_t>();
+    require(static_cast<std::size_t>(size) * sizeof(tchecker::bytecode_t));
+    std::shared_ptr<tchecker::bytecode_t> bytecode{new tchecker::bytecode_t[size],
+                                                   std::default_delete<tchecker::bytecode_t[]>()};
+    std::memcpy(bytecode.get(), _p, size * sizeof(tchecker::bytecode_t));
+    _p += size * sizeof(tchecker::bytecode_t);
+    if (!tchecker::is_bytecode(bytecode.get(), size))
+      invalid("corrupted bytecode");
+    return bytecode;
+  }
+
+  tchecker::typed_expression_t * read_expression()
+  {
+    std::uint8_t const tag = read<std::uint8_t>();
+    enum tchecker::expression_type_t const type = read_expression_type();
+
+    switch (tag) {
+    case EXPR_TAG_INT:
+      return new tchecker::typed_int_expression_t{type, read_integer()};
+    case EXPR_TAG_VAR: {
+      std::string name = read_string();
+      tchecker::variable_id_t const id = read<std::uint32_t>();
+      tchecker::variable_size_t const size = read<std::uint32_t>();
+      return new tchecker::typed_var_expression_t{type, name, id, size};
+    }
+    case EXPR_TAG_BOUNDED_VAR: {
+      std::string name = read_string();
+      tchecker::variable_id_t const id = read<std::uint32_t>();
+      tchecker::variable_size_t const size = read<std::uint32_t>();
+      tchecker::integer_t const min = read_integer();
+      tchecker::integer_t const max = read_integer();
+      return new tchecker::typed_bounded_var_expression_t{type, name, id, size, min, max};
+    }
+    case EXPR_TAG_ARRAY: {
+      std::unique_ptr<tchecker::typed_var_expression_t> variable{read_var_expression()};
+      std::unique_ptr<tchecker::typed_expression_t> offset{read_expression()};
+      auto * expr = new tchecker::typed_array_expression_t{type, variable.get(), offset.get()};
+      variable.release();
+      offset.release();
+      return expr;
+    }
+    case EXPR_TAG_PAR: {
+      std::unique_ptr<tchecker::typed_expression_t> e{read_expression()};
+      auto * expr = new tchecker::typed_par_expression_t{type, e.get()};
+      e.release();
+      return expr;
+    }
+    case EXPR_TAG_BINARY:
+    case EXPR_TAG_SIMPLE_CLKCONSTR:
+    case EXPR_TAG_DIAGONAL_CLKCONSTR: {
+      enum tchecker::binary_operator_t const op = read_binary_operator();
+      std::unique_ptr<tchecker::typed_expression_t> left{read_expression()};
+      std::unique_ptr<tchecker::typed_expression_t> right{read_expression()};
+      tchecker::typed_expression_t * expr = nullptr;
+      if (tag == EXPR_TAG_BINARY)
+        expr = new tchecker::typed_binary_expression_t{type, op, left.get(), right.get()};
+      else if (tag == EXPR_TAG_SIMPLE_CLKCONSTR)
+        expr = new tchecker::typed_simple_clkconstr_expression_t{type, op, left.get(), right.get()};
+      else
+        expr = new tchecker::typed_diagonal_clkconstr_expression_t{type, op, left.get(), right.get()};
+      left.release();
+      right.release();
+      return expr;
+    }
+    case EXPR_TAG_UNARY: {
+      std::uint8_t const op = read<std::uint8_t>();
+      if (op > tchecker::EXPR_OP_LNOT)
+        invalid("unknown unary operator");
+      std::unique_ptr<tchecker::typed_expression_t> operand{read_expression()};
+      auto * expr =
+          new tchecker::typed_unary_expression_t{type, static_cast<enum tchecker::unary_operator_t>(op), operand.get()};
+      operand.release();
+      return expr;
+    }
+    case EXPR_TAG_ITE: {
+      std::unique_ptr<tchecker::typed_expression_t> cond{read_expression()};
+      std::unique_ptr<tchecker::typed_expression_t> then_value{read_expression()};
+      std::unique_ptr<tchecker::typed_expression_t> else_value{read_expression()};
+      auto * expr = new tchecker::typed_ite_expression_t{type, cond.get(), then_value.get(), else_value.get()};
+      cond.release();
+      then_value.release();
+      else_value.release();
+      return expr;
+    }
+    default:
+      invalid("unknown expression");
+    }
+  }
+
+  tchecker::typed_statement_t * read_statement()
+  {
+    std::uint8_t const tag = read<std::uint8_t>();
+    std::uint8_t const t = read<std::uint8_t>();
+    if (t > tchecker::STMT_TYPE_LOCAL_ARRAY)
+      invalid("unknown statement type");
+    enum tchecker::statement_type_t const type = static_cast<enum tchecker::statement_type_t>(t);
+
+    switch (tag) {
+    case STMT_TAG_NOP:
+      return new tchecker::typed_nop_statement_t{type};
+    case STMT_TAG_ASSIGN:
+    case STMT_TAG_INT_TO_CLOCK:
+    case STMT_TAG_SUM_TO_CLOCK: {
+      std::unique_ptr<tchecker::typed_lvalue_expression_t> lvalue{read_lvalue_expression()};
+      std::unique_ptr<tchecker::typed_expression_t> rvalue{read_expression()};
+      tchecker::typed_statement_t * stmt = nullptr;
+      if (tag == STMT_TAG_ASSIGN)
+        stmt = new tchecker::typed_assign_statement_t{type, lvalue.get(), rvalue.get()};
+      else if (tag == STMT_TAG_INT_TO_CLOCK)
+        stmt = new tchecker::typed_int_to_clock_assign_statement_t{type, lvalue.get(), rvalue.get()};
+      else
+        stmt = new tchecker::typed_sum_to_clock_assign_statement_t{type, lvalue.get(), rvalue.get()};
+      lvalue.release();
+      rvalue.release();
+      return stmt;
+    }
+    case STMT_TAG_CLOCK_TO_CLOCK: {
+      std::unique_ptr<tchecker::typed_lvalue_expression_t> lvalue{read_lvalue_expression()};
+      std::unique_ptr<tchecker::typed_lvalue_expression_t> rvalue{read_lvalue_expression()};
+      auto * stmt = new tchecker::typed_clock_to_clock_assign_statement_t{type, lvalue.get(), rvalue.get()};
+      lvalue.release();
+      rvalue.release();
+      return stmt;
+    }
+    case STMT_TAG_SEQUENCE: {
+      std::unique_ptr<tchecker::typed_statement_t> first{read_statement()};
+      std::unique_ptr<tchecker::typed_statement_t> second{read_statement()};
+      auto * stmt = new tchecker::typed_sequence_statement_t{type, first.get(), second.get()};
+      first.release();
+      second.release();
+      return stmt;
+    }
+    case STMT_TAG_IF: {
+      std::unique_ptr<tchecker::typed_expression_t> cond{read_expression()};
+      std::unique_ptr<tchecker::typed_statement_t> then_stmt{read_statement()};
+      std::unique_ptr<tchecker::typed_statement_t> else_stmt{read_statement()};
+      auto * stmt = new tchecker::typed_if_statement_t{type, cond.get(), then_stmt.get(), else_stmt.get()};
+      cond.release();
+      then_stmt.release();
+      else_stmt.release();
+      return stmt;
+    }
+    case STMT_TAG_WHILE: {
+      std::unique_ptr<tchecker::typed_expression_t> cond{read_expression()};
+      std::unique_ptr<tchecker::typed_statement_t> body{read_statement()};
+      auto * stmt = new tchecker::typed_while_statement_t{type, cond.get(), body.get()};
+      cond.release();
+      body.release();
+      return stmt;
+    }
+    case STMT_TAG_LOCAL_VAR:
+    case STMT_TAG_LOCAL_ARRAY: {
+      std::unique_ptr<tchecker::typed_var_expression_t> variable{read_var_expression()};
+      std::unique_ptr<tchecker::typed_expression_t> e{read_expression()};
+      tchecker::typed_statement_t * stmt = nullptr;
+      if (tag == STMT_TAG_LOCAL_VAR)
+        stmt = new tchecker::typed_local_var_statement_t{type, variable.get(), e.get()};
+      else
+        stmt = new tchecker::typed_local_array_statement_t{type, variable.get(), e.get()};
+      variable.release();
+      e.release();
+      return stmt;
+    }
+    default:
+      invalid("unknown statement");
+    }
+  }
+
+  [[noreturn]] void invalid(std::string const & what) const
+  {
+    throw std::runtime_error("Invalid compiled system: " + what);
+  }
+
+private:
+  void require(std::size_t n) const
+  {
+    if (static_cast<std::size_t>(_end - _p) < n)
+      invalid("truncated file");
+  }
+
+  enum tchecker::expression_type_t read_expression_type()
+  {
+    std::uint8_t const t = read<std::uint8_t>();
+    if (t > tchecker::EXPR_TYPE_CONJUNCTIVE_FORMULA)
+      invalid("unknown expression type");
+    return static_cast<enum tchecker::expression_type_t>(t);
+  }
+
+  enum tchecker::binary_operator_t read_binary_operator()
+  {
+    std::uint8_t const op = read<std::uint8_t>();
+    if (op > tchecker::EXPR_OP_MOD)
+      invalid("unknown binary operator");
+    return static_cast<enum tchecker::binary_operator_t>(op);
+  }
+
+  tchecker::typed_lvalue_expression_t * read_lvalue_expression()
+  {
+    std::unique_ptr<tchecker::typed_expression_t> expr{read_expression()};
+    auto * lvalue = dynamic_cast<tchecker::typed_lvalue_expression_t *>(expr.get());
+    if (lvalue == nullptr)
+      invalid("expected lvalue expression");
+    expr.release();
+    return lvalue;
+  }
+
+  tchecker::typed_var_expression_t * read_var_expression()
+  {
+    std::unique_ptr<tchecker::typed_expression_t> expr{read_expression()};
+    auto * var = dynamic_cast<tchecker::typed_var_expression_t *>(expr.get());
+    if (var == nullptr)
+      invalid("expected variable expression");
+    expr.release();
+    return var;
+  }
+
+  char const * _p;   /*!< Next byte to read */
+  char const * _end; /*!< Past-the-end byte */
+};
+
+tchecker::ta::system_t * load_compiled_system(std::string const & filename)
+{
+  mapped_file_t file{filename};
+  reader_t r{file.begin(), file.end()};
+
+  if (r.read<std::uint32_t>() != MAGIC)
+    r.invalid("not a compiled system");
+  if (r.read<std::uint32_t>() != ENDIANNESS)
+    r.invalid("written on an architecture with another byte order");
+  if (r.read<std::uint32_t>() != tchecker::ta::COMPILED_SYSTEM_VERSION)
+    r.invalid("written with another version of the format");
+  if (r.read<std::uint32_t>() != sizeof(tchecker::integer_t))
+    r.invalid("written with another size of integers");
+
+  try {
+    std::string name = r.read_string();
+    tchecker::system::system_t s{name, r.read_attributes()};
+
+    std::uint32_t const clocks_count = r.read<std::uint32_t>();
+    for (std::uint32_t i = 0; i < clocks_count; ++i) {
+      std::string clock_name = r.read_string();
+      tchecker::clock_id_t const size = r.read<std::uint32_t>();
+      s.add_clock(clock_name, size, r.read_attributes());
+    }
+    s.history_clock_ids = r.read_ints();
+    s.history_clock_events = r.read_strings();
+    s.prophecy_clock_ids = r.read_ints();
+    s.prophecy_clock_events = r.read_strings();
+    s.normal_clock_ids = r.read_ints();
+
+    std::uint32_t const intvars_count = r.read<std::uint32_t>();
+    for (std::uint32_t i = 0; i < intvars_count; ++i) {
+      std::string intvar_name = r.read_string();
+      tchecker::intvar_id_t const size = r.read<std::uint32_t>();
+      tchecker::integer_t const min = r.read_integer();
+      tchecker::integer_t const max = r.read_integer();
+      tchecker::integer_t const init = r.read_integer();
+      s.add_intvar(intvar_name, size, min, max, init, r.read_attributes());
+    }
+
+    std::uint32_t const events_count = r.read<std::uint32_t>();
+    for (std::uint32_t i = 0; i < events_count; ++i) {
+      std::string event_name = r.read_string();
+      s.add_event(event_name, r.read_attributes());
+    }
+
+    std::uint32_t const processes_count = r.read<std::uint32_t>();
+    for (std::uint32_t i = 0; i < processes_count; ++i) {
+      std::string process_name = r.read_string();
+      s.add_process(process_name, r.read_attributes());
+    }
+
+    std::uint32_t const locations_count = r.read<std::uint32_t>();
+    for (std::uint32_t i = 0; i < locations_count; ++i) {
+      tchecker::process_id_t const pid = r.read<std::uint32_t>();
+      std::string loc_name = r.read_string();
+      s.add_location(pid, loc_name, r.read_attributes());
+    }
+
+    std::uint32_t const edges_count = r.read<std::uint32_t>();
+    for (std::uint32_t i = 0; i < edges_count; ++i) {
+      tchecker::process_id_t const pid = r.read<std::uint32_t>();
+      tchecker::loc_id_t const src = r.read<std::uint32_t>();
+      tchecker::loc_id_t const tgt = r.read<std::uint32_t>();
+      tchecker::event_id_t const event_id = r.read<std::uint32_t>();
+      s.add_edge(pid, src, tgt, event_id, r.read_attributes());
+    }
+
+    std::uint32_t const syncs_count = r.read<std::uint32_t>();
+    for (std::uint32_t i = 0; i < syncs_count; ++i) {
+      std::vector<tchecker::system::sync_constraint_t> constraints;
+      std::uint32_t const constraints_count = r.read<std::uint32_t>();
+      for (std::uint32_t j = 0; j < constraints_count; ++j) {
+        tchecker::process_id_t const pid = r.read<std::uint32_t>();
+        tchecker::event_id_t const event_id = r.read<std::uint32_t>();
+        std::uint8_t const strength = r.read<std::uint8_t>();
+        if (strength > tchecker::SYNC_STRONG)
+          r.invalid("unknown synchronization strength");
+        constraints.emplace_back(pid, event_id, static_cast<enum tchecker::sync_strength_t>(strength));
+      }
+      s.add_synchronization(constraints, r.read_attributes());
+    }
+
+    std::vector<tchecker::ta::system_t::compiled_expression_t> invariants(locations_count);
+    for (std::uint32_t i = 0; i < locations_count; ++i) {
+      invariants[i]._typed_expr = std::shared_ptr<tchecker::typed_expression_t>(r.read_expression());
+      invariants[i]._compiled_expr = r.read_bytecode();
+    }
+
+    std::vector<tchecker::ta::system_t::compiled_expression_t> guards(edges_count);
+    std::vector<tchecker::ta::system_t::compiled_statement_t> statements(edges_count);
+    for (std::uint32_t i = 0; i < edges_count; ++i) {
+      guards[i]._typed_expr = std::shared_ptr<tchecker::typed_expression_t>(r.read_expression());
+      guards[i]._compiled_expr = r.read_bytecode();
+      statements[i]._typed_stmt = std::shared_ptr<tchecker::typed_statement_t>(r.read_statement());
+      statements[i]._compiled_stmt = r.read_bytecode();
+    }
+
+    if (r.read<std::uint32_t>() != END || !r.at_end())
+      r.invalid("corrupted file");
+
+    return new tchecker::ta::system_t{s, invariants, guards, statements};
+  }
+  catch (std::invalid_argument const & e) {
+    r.invalid(e.what());
+  }
+}
+
+} // end of namespace ta
+
+} // end of namespace tchecker
@@ -0,0 +1,202 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <cassert>
+#include <unordered_set>
+
+#include "tchecker/expression/static_analysis.hh"
+#include "tchecker/statement/static_analysis.hh"
+#include "tchecker/ta/independence.hh"
+
+namespace tchecker {
+
+namespace ta {
+
+/*!
+ \brief Add variable IDs to a bitset
+ \param ids : variable IDs
+ \param bitset : a bitset
+ \post every ID in ids has been set in bitset
+ */
+template <class ID> static void add_ids(std::unordered_set<ID> const & ids, boost::dynamic_bitset<> & bitset)
+{
+  for (ID id : ids)
+    bitset.set(id);
+}
+
+independence_t::independence_t(tchecker::ta::system_t const & system) : _system(system)
+{
+  compute_variables();
+  compute_ample_locations();
+}
+
+bool independence_t::is_asynchronous(tchecker::edge_id_t id) const
+{
+  assert(id < _asynchronous.size());
+  return _asynchronous[id];
+}
+
+bool independence_t::is_clock_free(tchecker::edge_id_t id) const
+{
+  assert(id < _edge_read_clocks.size());
+  return _edge_read_clocks[id].none() && _edge_write_clocks[id].none();
+}
+
+bool independence_t::independent(tchecker::edge_id_t id1, tchecker::edge_id_t id2) const
+{
+  assert(_system.is_edge(id1));
+  assert(_system.is_edge(id2));
+
+  if (_system.edge(id1)->pid() == _system.edge(id2)->pid())
+    return false;
+
+  if (!_asynchronous[id1] || !_asynchronous[id2])
+    return false;
+
+  if (_edge_write_intvars[id1].intersects(_edge_read_intvars[id2] | _edge_write_intvars[id2]))
+    return false;
+  if (_edge_write_intvars[id2].intersects(_edge_read_intvars[id1]))
+    return false;
+
+  if (_edge_write_clocks[id1].intersects(_edge_read_clocks[id2] | _edge_write_clocks[id2]))
+    return false;
+  if (_edge_write_clocks[id2].intersects(_edge_read_clocks[id1]))
+    return false;
+
+  return true;
+}
+
+bool independence_t::is_ample_location(tchecker::loc_id_t id) const
+{
+  assert(id < _ample.size());
+  return _ample[id];
+}
+
+tchecker::process_id_t independence_t::ample_process(tchecker::vloc_t const & vloc) const
+{
+  tchecker::process_id_t pid = NO_PROCESS;
+  std::size_t degree = 0;
+
+  for (tchecker::loc_id_t loc_id : vloc)
+    if (_system.is_committed(loc_id))
+      return NO_PROCESS;
+
+  for (tchecker::loc_id_t loc_id : vloc)
+    if (_ample[loc_id] && (pid == NO_PROCESS || _out_degree[loc_id] < degree)) {
+      pid = _system.location(loc_id)->pid();
+      degree = _out_degree[loc_id];
+    }
+
+  return pid;
+}
+
+tchecker::loc_id_t independence_t::ample_locations_count() const { return _ample.count(); }
+
+void independence_t::compute_variables()
+{
+  tchecker::edge_id_t const edges_count = _system.edges_count();
+  tchecker::process_id_t const processes_count = _system.processes_count();
+  tchecker::intvar_id_t const intvars_count = _system.intvars_count(tchecker::VK_FLATTENED);
+  tchecker::clock_id_t const clocks_count = _system.clocks_count(tchecker::VK_FLATTENED);
+
+  _edge_read_intvars.assign(edges_count, boost::dynamic_bitset<>(intvars_count));
+  _edge_write_intvars.assign(edges_count, boost::dynamic_bitset<>(intvars_count));
+  _edge_read_clocks.assign(edges_count, boost::dynamic_bitset<>(clocks_count));
+  _edge_write_clocks.assign(edges_count, boost::dynamic_bitset<>(clocks_count));
+  _proc_read_intvars.assign(processes_count, boost::dynamic_bitset<>(intvars_count));
+  _proc_write_intvars.assign(processes_count, boost::dynamic_bitset<>(intvars_count));
+  _asynchronous.resize(edges_count);
+
+  std::unordered_set<tchecker::clock_id_t> clocks;
+  std::unordered_set<tchecker::intvar_id_t> intvars;
+
+  // Invariants are read by every process that may stay in a location
+  for (tchecker::system::loc_const_shared_ptr_t const & loc : _system.locations()) {
+    tchecker::extract_variables(_system.invariant(loc->id()), clocks, intvars);
+    add_ids(intvars, _proc_read_intvars[loc->pid()]);
+    clocks.clear();
+    intvars.clear();
+  }
+
+  for (tchecker::system::edge_const_shared_ptr_t const & edge : _system.edges()) {
+    tchecker::edge_id_t const id = edge->id();
+
+    _asynchronous[id] = _system.is_asynchronous(*edge);
+
+    tchecker::extract_variables(_system.guard(id), clocks, intvars);
+    tchecker::extract_read_variables(_system.statement(id), clocks, intvars);
+    tchecker::extract_variables(_system.invariant(edge->tgt()), clocks, intvars);
+    add_ids(clocks, _edge_read_clocks[id]);
+    add_ids(intvars, _edge_read_intvars[id]);
+    clocks.clear();
+    intvars.clear();
+
+    tchecker::extract_written_variables(_system.statement(id), clocks, intvars);
+    add_ids(clocks, _edge_write_clocks[id]);
+    add_ids(intvars, _edge_write_intvars[id]);
+    clocks.clear();
+    intvars.clear();
+
+    _proc_read_intvars[edge->pid()] |= _edge_read_intvars[id];
+    _proc_write_intvars[edge->pid()] |= _edge_write_intvars[id];
+  }
+
+  // The "tmp" prophecy clock only separates provided/do blocks in GTA programs
+  if (_system.is_clock("tmp")) {
+    tchecker::clock_id_t const tmp = _system.clock_id("tmp");
+    for (tchecker::edge_id_t id = 0; id < edges_count; ++id) {
+      _edge_read_clocks[id].reset(tmp);
+      _edge_write_clocks[id].reset(tmp);
+    }
+  }
+}
+
+void independence_t::compute_ample_locations()
+{
+  tchecker::loc_id_t const locations_count = _system.locations_count();
+  tchecker::process_id_t const processes_count = _system.processes_count();
+
+  _ample.resize(locations_count);
+  _out_degree.assign(locations_count, 0);
+
+  for (tchecker::system::loc_const_shared_ptr_t const & loc : _system.locations()) {
+    tchecker::loc_id_t const id = loc->id();
+
+    if (_system.is_committed(id) || _system.is_urgent(id))
+      continue;
+
+    bool ample = true;
+    for (tchecker::system::edge_const_shared_ptr_t const & edge : _system.outgoing_edges(id)) {
+      ++_out_degree[id];
+
+      tchecker::edge_id_t const eid = edge->id();
+      tchecker::loc_id_t const tgt = edge->tgt();
+
+      if (!_asynchronous[eid] || !is_clock_free(eid) || _system.is_committed(tgt) || _system.is_urgent(tgt) ||
+          _system.labels(tgt) != _system.labels(id)) {
+        ample = false;
+        continue;
+      }
+
+      boost::dynamic_bitset<> const accessed = _edge_read_intvars[eid] | _edge_write_intvars[eid];
+      for (tchecker::process_id_t pid = 0; pid < processes_count; ++pid) {
+        if (pid == loc->pid())
+          continue;
+        if (accessed.intersects(_proc_write_intvars[pid]) || _edge_write_intvars[eid].intersects(_proc_read_intvars[pid])) {
+          ample = false;
+          break;
+        }
+      }
+    }
+
+    _ample[id] = ample && (_out_degree[id] > 0);
+  }
+}
+
+} // end of namespace ta
+
+} // end of namespace tchecker
@@ -0,0 +1,255 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <cctype>
+#include <set>
+#include <sstream>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "tchecker/expression/static_analysis.hh"
+#include "tchecker/statement/static_analysis.hh"
+#include "tchecker/ta/symmetry.hh"
+
+namespace tchecker {
+
+namespace ta {
+
+/*!
+ \brief Rename identifiers in a string
+ \param s : a string
+ \param renaming : map from identifiers to identifiers
+ \return s where every identifier in the domain of renaming has been replaced by
+ its image
+ */
+static std::string rename(std::string const & s, std::unordered_map<std::string, std::string> const & renaming)
+{
+  std::string result;
+  std::size_t i = 0;
+  while (i < s.size()) {
+    if (std::isalpha(static_cast<unsigned char>(s[i])) || s[i] == '_') {
+      std::size_t j = i;
+      while (j < s.size() && (std::isalnum(static_cast<unsigned char>(s[j])) || s[j] == '_'))
+        ++j;
+      std::string const id = s.substr(i, j - i);
+      auto it = renaming.find(id);
+      result += (it == renaming.end() ? id : it->second);
+      i = j;
+    }
+    else
+      result += s[i++];
+  }
+  return result;
+}
+
+symmetry_t::symmetry_t(tchecker::ta::system_t const & system) : _system(system)
+{
+  compute_processes();
+  compute_classes();
+}
+
+bool symmetry_t::canonicalize(tchecker::vloc_t & vloc, tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim) const
+{
+  std::vector<tchecker::clock_id_t> perm;
+  std::vector<tchecker::loc_id_t> locs;
+  std::vector<tchecker::process_id_t> order;
+  bool modified = false;
+
+  for (std::vector<tchecker::process_id_t> const & cls : _classes) {
+    order = cls;
+    std::stable_sort(order.begin(), order.end(), [&](tchecker::process_id_t pid1, tchecker::process_id_t pid2) {
+      return compare(vloc, dbm, dim, pid1, pid2) < 0;
+    });
+    if (order == cls)
+      continue;
+
+    if (!modified) {
+      perm.resize(dim);
+      for (tchecker::clock_id_t i = 0; i < dim; ++i)
+        perm[i] = i;
+      modified = true;
+    }
+
+    // process order[i] is moved to position cls[i]
+    locs.clear();
+    for (std::size_t i = 0; i < cls.size(); ++i)
+      locs.push_back(_locations[cls[i]][_loc_rank[vloc[order[i]]]]);
+    for (std::size_t i = 0; i < cls.size(); ++i) {
+      vloc[cls[i]] = locs[i];
+      std::vector<tchecker::clock_id_t> const & src_clocks = _local_clocks[order[i]];
+      std::vector<tchecker::clock_id_t> const & tgt_clocks = _local_clocks[cls[i]];
+      for (std::size_t k = 0; k < src_clocks.size(); ++k)
+        perm[src_clocks[k] + 1] = tgt_clocks[k] + 1;
+    }
+  }
+
+  if (!modified)
+    return false;
+
+  std::vector<tchecker::dbm::db_t> copy(dbm, dbm + dim * dim);
+  for (tchecker::clock_id_t i = 0; i < dim; ++i)
+    for (tchecker::clock_id_t j = 0; j < dim; ++j)
+      dbm[perm[i] * dim + perm[j]] = copy[i * dim + j];
+
+  return true;
+}
+
+int symmetry_t::compare(tchecker::vloc_t const & vloc, tchecker::dbm::db_t const * dbm, tchecker::clock_id_t dim,
+                        tchecker::process_id_t pid1, tchecker::process_id_t pid2) const
+{
+  std::size_t const rank1 = _loc_rank[vloc[pid1]], rank2 = _loc_rank[vloc[pid2]];
+  if (rank1 != rank2)
+    return (rank1 < rank2 ? -1 : 1);
+
+  std::vector<tchecker::clock_id_t> const & clocks1 = _local_clocks[pid1];
+  std::vector<tchecker::clock_id_t> const & clocks2 = _local_clocks[pid2];
+  assert(clocks1.size() == clocks2.size());
+
+  for (std::size_t k = 0; k < clocks1.size(); ++k) {
+    tchecker::clock_id_t const x1 = clocks1[k] + 1, x2 = clocks2[k] + 1;
+    assert(x1 < dim);
+    assert(x2 < dim);
+    if (dbm[x1] != dbm[x2]) // row of reference clock
+      return (dbm[x1] < dbm[x2] ? -1 : 1);
+    if (dbm[x1 * dim] != dbm[x2 * dim]) // column of reference clock
+      return (dbm[x1 * dim] < dbm[x2 * dim] ? -1 : 1);
+  }
+
+  return 0;
+}
+
+void symmetry_t::compute_processes()
+{
+  tchecker::process_id_t const processes_count = _system.processes_count();
+  tchecker::clock_id_t const clocks_count = _system.clocks_count(tchecker::VK_FLATTENED);
+
+  _local_clocks.assign(processes_count, std::vector<tchecker::clock_id_t>{});
+  _locations.assign(processes_count, std::vector<tchecker::loc_id_t>{});
+  _loc_rank.assign(_system.locations_count(), 0);
+
+  for (tchecker::system::loc_const_shared_ptr_t const & loc : _system.locations()) {
+    _loc_rank[loc->id()] = _locations[loc->pid()].size();
+    _locations[loc->pid()].push_back(loc->id());
+  }
+
+  // Processes accessing each clock
+  std::vector<std::set<tchecker::process_id_t>> accessors(clocks_count);
+  std::unordered_set<tchecker::clock_id_t> clocks;
+  std::unordered_set<tchecker::intvar_id_t> intvars;
+
+  for (tchecker::system::loc_const_shared_ptr_t const & loc : _system.locations()) {
+    tchecker::extract_variables(_system.invariant(loc->id()), clocks, intvars);
+    for (tchecker::clock_id_t x : clocks)
+      accessors[x].insert(loc->pid());
+    clocks.clear();
+    intvars.clear();
+  }
+
+  for (tchecker::system::edge_const_shared_ptr_t const & edge : _system.edges()) {
+    tchecker::extract_variables(_system.guard(edge->id()), clocks, intvars);
+    tchecker::extract_read_variables(_system.statement(edge->id()), clocks, intvars);
+    tchecker::extract_written_variables(_system.statement(edge->id()), clocks, intvars);
+    for (tchecker::clock_id_t x : clocks)
+      accessors[x].insert(edge->pid());
+    clocks.clear();
+    intvars.clear();
+  }
+
+  for (tchecker::clock_id_t x = 0; x < clocks_count; ++x)
+    if (accessors[x].size() == 1)
+      _local_clocks[*accessors[x].begin()].push_back(x);
+}
+
+std::string symmetry_t::signature(tchecker::process_id_t pid) const
+{
+  std::unordered_map<std::string, std::string> renaming;
+  std::stringstream ss;
+
+  for (std::size_t k = 0; k < _local_clocks[pid].size(); ++k) {
+    tchecker::clock_id_t const x = _local_clocks[pid][k];
+    renaming[_system.clock_name(x)] = "#" + std::to_string(k);
+    if (_system.history_clock_id_map.find(x + 1) != _system.history_clock_id_map.end())
+      ss << "H";
+    else if (_system.prophecy_clock_id_map.find(x + 1) != _system.prophecy_clock_id_map.end())
+      ss << "P";
+    else
+      ss << "N";
+  }
+  ss << "\n";
+
+  for (tchecker::loc_id_t id : _locations[pid])
+    ss << "L" << _system.is_initial_location(id) << _system.is_committed(id) << _system.is_urgent(id) << ":"
+       << _system.labels(id) << ":" << rename(_system.invariant(id).to_string(), renaming) << "\n";
+
+  for (tchecker::system::edge_const_shared_ptr_t const & edge : _system.edges()) {
+    if (edge->pid() != pid)
+      continue;
+    ss << "E" << _loc_rank[edge->src()] << ":" << _loc_rank[edge->tgt()] << ":" << _system.event_name(edge->event_id())
+       << ":" << rename(_system.guard(edge->id()).to_string(), renaming) << ":"
+       << rename(_system.statement(edge->id()).to_string(), renaming) << "\n";
+  }
+
+  return ss.str();
+}
+
+bool symmetry_t::swappable_synchronizations(tchecker::process_id_t pid1, tchecker::process_id_t pid2) const
+{
+  using constraint_t = std::tuple<tchecker::process_id_t, tchecker::event_id_t, int>;
+
+  auto swap = [&](tchecker::process_id_t pid) { return (pid == pid1 ? pid2 : (pid == pid2 ? pid1 : pid)); };
+
+  std::set<std::vector<constraint_t>> syncs, swapped_syncs;
+  for (tchecker::system::synchronization_t const & sync : _system.synchronizations()) {
+    std::vector<constraint_t> v, swapped_v;
+    for (tchecker::system::sync_constraint_t const & c : sync.synchronization_constraints()) {
+      v.push_back(std::make_tuple(c.pid(), c.event_id(), static_cast<int>(c.strength())));
+      swapped_v.push_back(std::make_tuple(swap(c.pid()), c.event_id(), static_cast<int>(c.strength())));
+    }
+    std::sort(v.begin(), v.end());
+    std::sort(swapped_v.begin(), swapped_v.end());
+    syncs.insert(v);
+    swapped_syncs.insert(swapped_v);
+  }
+
+  return syncs == swapped_syncs;
+}
+
+void symmetry_t::compute_classes()
+{
+  _classes.clear();
+
+  // local clocks are renamed one by one: clock arrays are not supported
+  if (_system.clocks_count(tchecker::VK_DECLARED) != _system.clocks_count(tchecker::VK_FLATTENED))
+    return;
+
+  tchecker::process_id_t const processes_count = _system.processes_count();
+
+  std::vector<std::string> signatures;
+  for (tchecker::process_id_t pid = 0; pid < processes_count; ++pid)
+    signatures.push_back(signature(pid));
+
+  std::vector<bool> done(processes_count, false);
+  for (tchecker::process_id_t pid = 0; pid < processes_count; ++pid) {
+    if (done[pid])
+      continue;
+    std::vector<tchecker::process_id_t> cls{pid};
+    for (tchecker::process_id_t other = pid + 1; other < processes_count; ++other)
+      if (!done[other] && signatures[other] == signatures[pid] && swappable_synchronizations(pid, other)) {
+        cls.push_back(other);
+        done[other] = true;
+      }
+    if (cls.size() > 1)
+      _classes.push_back(cls);
+  }
+}
+
+} // end of namespace ta
+
+} // end of namespace tchecker
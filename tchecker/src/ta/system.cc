@@ -32,7 +32,54 @@ namespace ta {
 system_t::system_t(tchecker::parsing::system_declaration_t const & sysdecl) : tchecker::syncprod::system_t(sysdecl)
 {
   compute_from_syncprod_system();
-  
+  compute_clock_kinds();
+}
+
+system_t::system_t(tchecker::system::system_t const & system) : tchecker::syncprod::system_t(system)
+{
+  compute_from_syncprod_system();
+  compute_clock_kinds();
+}
+
+system_t::system_t(tchecker::syncprod::system_t const & system) : tchecker::syncprod::system_t(system)
+{
+  compute_from_syncprod_system();
+  compute_clock_kinds();
+}
+
+system_t::system_t(tchecker::system::system_t const & system, std::vector<compiled_expression_t> const & invariants,
+                   std::vector<compiled_expression_t> const & guards, std::vector<compiled_statement_t> const & statements)
+    : tchecker::syncprod::system_t(system), _invariants(invariants), _guards(guards), _statements(statements)
+{
+  tchecker::loc_id_t const locations_count = this->locations_count();
+  tchecker::edge_id_t const edges_count = this->edges_count();
+
+  if (_invariants.size() != locations_count || _guards.size() != edges_count || _statements.size() != edges_count)
+    throw std::invalid_argument("Precompiled invariants, guards or statements do not match the system");
+
+  for (compiled_expression_t const & e : _invariants)
+    if (e._typed_expr == nullptr || e._compiled_expr == nullptr)
+      throw std::invalid_argument("Missing precompiled invariant");
+  for (compiled_expression_t const & e : _guards)
+    if (e._typed_expr == nullptr || e._compiled_expr == nullptr)
+      throw std::invalid_argument("Missing precompiled guard");
+  for (compiled_statement_t const & s : _statements)
+    if (s._typed_stmt == nullptr || s._compiled_stmt == nullptr)
+      throw std::invalid_argument("Missing precompiled statement");
+
+  _urgent.resize(locations_count);
+  for (tchecker::loc_id_t id = 0; id < locations_count; ++id)
+    set_urgent(id, tchecker::syncprod::system_t::location(id)->attributes().values("urgent"));
+
+  compute_clock_kinds();
+}
+
+void system_t::compute_clock_kinds()
+{
+  history_clock_id_map.clear();
+  prophecy_clock_id_map.clear();
+  normal_clock_id_map.clear();
+
   for(auto i:this->history_clock_ids){
     this->history_clock_id_map.insert(i+1);
   }
@@ -44,22 +91,16 @@ system_t::system_t(tchecker::parsing::system_declaration_t const & sysdecl) : tc
     this->normal_clock_id_map.insert(i+1);
     this->history_clock_id_map.erase(i+1); //make normal clocks and history clocks disjoint!!
   }
-}
-
-system_t::system_t(tchecker::system::system_t const & system) : tchecker::syncprod::system_t(system)
-{
-  compute_from_syncprod_system();
-}
 
-system_t::system_t(tchecker::syncprod::system_t const & system) : tchecker::syncprod::system_t(system)
-{
-  compute_from_syncprod_system();
+  _grouped_clocks = tchecker::dbm::eca_clock_layout(clocks_count(tchecker::VK_FLATTENED) + 1, history_clock_id_map,
+                                                    prophecy_clock_id_map, normal_clock_id_map, _clock_layout);
 }
 
 system_t::system_t(tchecker::ta::system_t const & system)
     : tchecker::syncprod::system_t(system.as_syncprod_system()), _vm(system._vm)
 {
   compute_from_syncprod_system();
+  compute_clock_kinds();
 }
 
 tchecker::ta::system_t & system_t::operator=(tchecker::ta::system_t const & system)
@@ -68,6 +109,7 @@ tchecker::ta::system_t & system_t::operator=(tchecker::ta::system_t const & syst
     tchecker::syncprod::system_t::operator=(system);
     _vm = system._vm;
     compute_from_syncprod_system();
+    compute_clock_kinds();
   }
   return *this;
 }
@@ -139,16 +181,6 @@ void system_t::compute_from_syncprod_system()
   for (tchecker::edge_id_t id = 0; id < edges_count; ++id) {
     auto const & attr = tchecker::syncprod::system_t::edge(id)->attributes();
 
-    for(auto tmp:attr.values("provided")){
-
-      std::string context = "In process " + tchecker::syncprod::system_t::process_name(edge(id)->pid()) + ", edge from " +
-                        tchecker::syncprod::system_t::location(edge(id)->src())->name() + " to " +
-                        tchecker::syncprod::system_t::location(edge(id)->tgt())->name() + " with event " +
-                        tchecker::syncprod::system_t::event_name(edge(id)->event_id()) + ", provided";
-      
-      tchecker::expression_t * value_expr = tchecker::parsing::parse_expression(context, tmp.second);
-
-    }
     set_guards(id, attr.values("provided"));
     set_statements(id, attr.values("do"));
   }
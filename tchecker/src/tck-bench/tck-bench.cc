@@ -0,0 +1,793 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <getopt.h>
+#include <iostream>
+#include <map>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+
+#include "tchecker/utils/log.hh"
+
+/*!
+ \file tck-bench.cc
+ \brief Benchmarks of tck-reach over a matrix of models, algorithms, search
+ orders and numbers of threads, with comparison to a baseline
+ */
+
+static struct option long_options[] = {{"algorithms", required_argument, 0, 'a'},
+                                       {"baseline", required_argument, 0, 'b'},
+                                       {"option", required_argument, 0, 'e'},
+                                       {"format", required_argument, 0, 'f'},
+                                       {"help", no_argument, 0, 'h'},
+                                       {"threads", required_argument, 0, 'j'},
+                                       {"output", required_argument, 0, 'o'},
+                                       {"runs", required_argument, 0, 'r'},
+                                       {"search-orders", required_argument, 0, 's'},
+                                       {"time-threshold", required_argument, 0, 'T'},
+                                       {"memory-threshold", required_argument, 0, 'M'},
+                                       {"min-seconds", required_argument, 0, 0},
+                                       {"tck-gen", required_argument, 0, 0},
+                                       {"tck-reach", required_argument, 0, 0},
+                                       {"timeout", required_argument, 0, 0},
+                                       {0, 0, 0, 0}};
+
+static char * const options = (char *)"a:b:e:f:hj:o:r:s:M:T:";
+
+void usage(char * progname)
+{
+  std::cerr << "Usage: " << progname << " [options] model..." << std::endl;
+  std::cerr << "   -a a1,a2,...     tck-reach algorithms (default: gta_gsim)" << std::endl;
+  std::cerr << "   -b file          baseline: output (CSV or JSON) of a previous run" << std::endl;
+  std::cerr << "   -e option        additional tck-reach option (repeatable, e.g. -e --zone-storage -e reduced)"
+            << std::endl;
+  std::cerr << "   -f csv|json      output format (default: csv)" << std::endl;
+  std::cerr << "   -h               help" << std::endl;
+  std::cerr << "   -j n1,n2,...     numbers of threads for reduced A-maps (gsim, gta_gsim, gta_reach and concur19_gsim"
+            << " only, default: 1)"
+            << std::endl;
+  std::cerr << "   -o file          output file (default: standard output)" << std::endl;
+  std::cerr << "   -r N             runs per configuration, the fastest one is reported (default: 1)" << std::endl;
+  std::cerr << "   -s o1,o2,...     search orders (default: bfs)" << std::endl;
+  std::cerr << "   -M PERCENT       tolerated increase of peak memory w.r.t. baseline (default: 10)" << std::endl;
+  std::cerr << "   -T PERCENT       tolerated increase of wall time w.r.t. baseline (default: 10)" << std::endl;
+  std::cerr << "   --min-seconds S  increases of wall time below S seconds are not regressions (default: 0.1)"
+            << std::endl;
+  std::cerr << "   --tck-gen PATH   tck-gen executable (default: $TCK_GEN, or tck-gen in PATH)" << std::endl;
+  std::cerr << "   --tck-reach PATH tck-reach executable (default: $TCK_REACH, or tck-reach in PATH)" << std::endl;
+  std::cerr << "   --timeout S      CPU time limit of each run in seconds (default: none)" << std::endl;
+  std::cerr << "a model is a TChecker file, a directory (all its .txt and .tck files), or a generator" << std::endl;
+  std::cerr << "script.sh:arg1:arg2:... (the model is the output of script.sh arg1 arg2 ...), or a generated" << std::endl;
+  std::cerr << "model tck-gen:family:param1:... (the model is the output of tck-gen family param1 ...)" << std::endl;
+  std::cerr << "searched labels are read from a line # labels=l1:l2:... in the model" << std::endl;
+  std::cerr << "outputs one record per run with keys MODEL ALGORITHM SEARCH_ORDER THREADS OPTIONS STATUS" << std::endl;
+  std::cerr << "WALL_TIME_SECONDS PEAK_MEMORY_KB and the statistics output by tck-reach" << std::endl;
+  std::cerr << "regressions w.r.t. the baseline are reported on standard error, and the exit status is 2" << std::endl;
+}
+
+static std::vector<std::string> algorithms{"gta_gsim"};
+static std::string baseline_file = "";
+static std::vector<std::string> extra_options;
+static bool json = false;
+static bool help = false;
+static std::vector<std::string> threads{"1"};
+static std::string output_file = "";
+static unsigned long runs = 1;
+static std::vector<std::string> search_orders{"bfs"};
+static double memory_threshold = 10.0;
+static double time_threshold = 10.0;
+static double min_seconds = 0.1;
+static std::string tck_gen = "";
+static std::string tck_reach = "";
+static unsigned long timeout = 0;
+
+/*!
+ \brief Split a comma-separated list
+ \param s : a string
+ \return the non-empty elements of s separated by commas
+ */
+static std::vector<std::string> split_list(std::string const & s)
+{
+  std::vector<std::string> v;
+  std::istringstream is(s);
+  std::string e;
+  while (std::getline(is, e, ','))
+    if (!e.empty())
+      v.push_back(e);
+  if (v.empty())
+    throw std::runtime_error("Empty list: " + s);
+  return v;
+}
+
+/*!
+ \brief Parse a non-negative number
+ \param s : a string
+ \param what : description of the number
+ \return the number in s
+ \throw std::runtime_error : if s is not a non-negative number
+ */
+static double parse_number(char const * s, std::string const & what)
+{
+  char * end = nullptr;
+  double const d = std::strtod(s, &end);
+  if (end == s || *end != '\0' || d < 0)
+    throw std::runtime_error("Invalid " + what + ": " + std::string(s));
+  return d;
+}
+
+int parse_command_line(int argc, char * argv[])
+{
+  while (true) {
+    int long_option_index = -1;
+    int c = getopt_long(argc, argv, options, long_options, &long_option_index);
+
+    if (c == -1)
+      break;
+
+    if (c == ':')
+      throw std::runtime_error("Missing option parameter");
+    else if (c == '?')
+      throw std::runtime_error("Unknown command-line option");
+
+    if (c != 0) {
+      switch (c) {
+      case 'a':
+        algorithms = split_list(optarg);
+        break;
+      case 'b':
+        baseline_file = optarg;
+        break;
+      case 'e':
+        extra_options.push_back(optarg);
+        break;
+      case 'f':
+        if (strcmp(optarg, "csv") == 0)
+          json = false;
+        else if (strcmp(optarg, "json") == 0)
+          json = true;
+        else
+          throw std::runtime_error("Unknown output format: " + std::string(optarg));
+        break;
+      case 'h':
+        help = true;
+        break;
+      case 'j':
+        threads = split_list(optarg);
+        break;
+      case 'o':
+        output_file = optarg;
+        break;
+      case 'r':
+        runs = static_cast<unsigned long>(parse_number(optarg, "number of runs"));
+        if (runs == 0)
+          throw std::runtime_error("Invalid number of runs: " + std::string(optarg));
+        break;
+      case 's':
+        search_orders = split_list(optarg);
+        break;
+      case 'M':
+        memory_threshold = parse_number(optarg, "memory threshold");
+        break;
+      case 'T':
+        time_threshold = parse_number(optarg, "time threshold");
+        break;
+      default:
+        throw std::runtime_error("This should never be executed");
+        break;
+      }
+    }
+    else {
+      if (strcmp(long_options[long_option_index].name, "min-seconds") == 0)
+        min_seconds = parse_number(optarg, "time");
+      else if (strcmp(long_options[long_option_index].name, "tck-gen") == 0)
+        tck_gen = optarg;
+      else if (strcmp(long_options[long_option_index].name, "tck-reach") == 0)
+        tck_reach = optarg;
+      else if (strcmp(long_options[long_option_index].name, "timeout") == 0)
+        timeout = static_cast<unsigned long>(parse_number(optarg, "timeout"));
+      else
+        throw std::runtime_error("This should never be executed");
+    }
+  }
+
+  return optind;
+}
+
+/*!
+ \brief Model to benchmark
+ */
+struct model_t {
+  std::string name; /*!< Name of the model */
+  std::string path; /*!< Path to the model file */
+};
+
+/*!
+ \brief Execution of a command
+ */
+struct execution_t {
+  std::string status;  /*!< ok, error or timeout */
+  std::string output;  /*!< Standard output */
+  double wall_time;    /*!< Wall time in seconds */
+  long peak_memory_kb; /*!< Peak memory in kilobytes */
+};
+
+/*!
+ \brief Execute a command
+ \param args : command and arguments
+ \param cpu_limit : CPU time limit in seconds (0 for no limit)
+ \return the execution of args, with standard error discarded
+ \throw std::runtime_error : if the command cannot be started
+ */
+static execution_t execute(std::vector<std::string> const & args, unsigned long cpu_limit)
+{
+  int fds[2];
+  if (pipe(fds) != 0)
+    throw std::runtime_error("Cannot create pipe: " + std::string(std::strerror(errno)));
+
+  auto start = std::chrono::steady_clock::now();
+  pid_t const pid = fork();
+  if (pid < 0)
+    throw std::runtime_error("Cannot fork: " + std::string(std::strerror(errno)));
+
+  if (pid == 0) {
+    close(fds[0]);
+    dup2(fds[1], STDOUT_FILENO);
+    close(fds[1]);
+    int const null = open("/dev/null", O_WRONLY);
+    if (null >= 0)
+      dup2(null, STDERR_FILENO);
+    if (cpu_limit > 0) {
+      struct rlimit limit {static_cast<rlim_t>(cpu_limit), static_cast<rlim_t>(cpu_limit + 1)};
+      setrlimit(RLIMIT_CPU, &limit);
+    }
+    std::vector<char *> argv;
+    for (std::string const & arg : args)
+      argv.push_back(const_cast<char *>(arg.c_str()));
+    argv.push_back(nullptr);
+    execvp(argv[0], argv.data());
+    _exit(127);
+  }
+
+  close(fds[1]);
+  execution_t execution;
+  char buffer[4096];
+  ssize_t n;
+  while ((n = read(fds[0], buffer, sizeof(buffer))) != 0) {
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n < 0)
+      break;
+    execution.output.append(buffer, static_cast<std::size_t>(n));
+  }
+  close(fds[0]);
+
+  int status = 0;
+  struct rusage usage;
+  while (wait4(pid, &status, 0, &usage) < 0)
+    if (errno != EINTR)
+      throw std::runtime_error("Cannot wait for " + args[0] + ": " + std::string(std::strerror(errno)));
+  execution.wall_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+#if defined(__APPLE__)
+  execution.peak_memory_kb = usage.ru_maxrss / 1024; // bytes on macOS
+#else
+  execution.peak_memory_kb = usage.ru_maxrss;
+#endif
+
+  if (WIFSIGNALED(status) && (WTERMSIG(status) == SIGXCPU || WTERMSIG(status) == SIGKILL))
+    execution.status = "timeout";
+  else if (WIFEXITED(status) && WEXITSTATUS(status) == 127)
+    throw std::runtime_error("Cannot execute " + args[0]);
+  else if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+    execution.status = "error";
+  else
+    execution.status = "ok";
+  return execution;
+}
+
+/*!
+ \brief Collect models
+ \param spec : a file, a directory, a generator script.sh:arg1:arg2:..., or a
+ generated model tck-gen:family:param1:...
+ \param tmp_dir : directory for generated models
+ \param models : models
+ \post the models described by spec have been added to models
+ \throw std::runtime_error : if spec does not describe any model
+ */
+static void collect_models(std::string const & spec, std::filesystem::path const & tmp_dir, std::vector<model_t> & models)
+{
+  std::size_t const sh = spec.find(".sh");
+  bool const script = (sh != std::string::npos && (sh + 3 == spec.size() || spec[sh + 3] == ':'));
+  bool const generated = (spec.compare(0, 8, "tck-gen:") == 0);
+  if (script || generated) {
+    std::size_t const prefix = (script ? sh + 3 : 7);
+    std::vector<std::string> args{(script ? spec.substr(0, prefix) : tck_gen)};
+    std::istringstream is(spec.substr(std::min(prefix + 1, spec.size())));
+    std::string arg;
+    while (std::getline(is, arg, ':'))
+      args.push_back(arg);
+    if (generated && args.size() < 2)
+      throw std::runtime_error("Missing family: " + spec);
+    std::string name = (script ? std::filesystem::path(args[0]).stem().string() : args[1]);
+    for (std::size_t i = (script ? 1 : 2); i < args.size(); ++i)
+      name += "_" + args[i];
+
+    execution_t const execution = execute(args, 0);
+    if (execution.status != "ok")
+      throw std::runtime_error("Generator failed: " + spec);
+    std::filesystem::path const path = tmp_dir / (name + ".txt");
+    std::ofstream ofs(path);
+    ofs << execution.output;
+    models.push_back(model_t{name, path.string()});
+    return;
+  }
+
+  if (std::filesystem::is_directory(spec)) {
+    std::vector<std::filesystem::path> files;
+    for (auto const & entry : std::filesystem::directory_iterator(spec))
+      if (entry.is_regular_file() && (entry.path().extension() == ".txt" || entry.path().extension() == ".tck"))
+        files.push_back(entry.path());
+    std::sort(files.begin(), files.end());
+    for (std::filesystem::path const & file : files)
+      models.push_back(model_t{file.stem().string(), file.string()});
+    return;
+  }
+
+  if (!std::filesystem::is_regular_file(spec))
+    throw std::runtime_error("No such model: " + spec);
+  models.push_back(model_t{std::filesystem::path(spec).stem().string(), spec});
+}
+
+/*!
+ \brief Searched labels of a model
+ \param path : path to a model
+ \return the comma-separated list of labels from the first line # labels=l1:l2:...
+ in path, empty if none (as in test/tck-reach.sh)
+ */
+static std::string model_labels(std::string const & path)
+{
+  static std::regex const labels_regex("^# *labels *= *([a-zA-Z0-9_:]*) *$");
+  std::ifstream ifs(path);
+  std::string line;
+  std::smatch match;
+  while (std::getline(ifs, line))
+    if (std::regex_match(line, match, labels_regex)) {
+      std::string labels = match[1].str();
+      std::replace(labels.begin(), labels.end(), ':', ',');
+      return labels;
+    }
+  return "";
+}
+
+/*!
+ \brief Record of a benchmark (key, value)
+ */
+using record_t = std::map<std::string, std::string>;
+
+/*!
+ \brief Keys that identify a configuration, followed by measures
+ */
+static std::vector<std::string> const configuration_keys{"MODEL", "ALGORITHM", "SEARCH_ORDER", "THREADS", "OPTIONS"};
+static std::vector<std::string> const measure_keys{"STATUS", "WALL_TIME_SECONDS", "PEAK_MEMORY_KB"};
+
+/*!
+ \brief Run a configuration
+ \param model : a model
+ \param algorithm : an algorithm
+ \param search_order : a search order
+ \param thread_count : number of threads, empty if not applicable
+ \return the record of the fastest run of tck-reach on model with algorithm,
+ search_order, thread_count and extra options
+ */
+static record_t run_configuration(model_t const & model, std::string const & algorithm, std::string const & search_order,
+                                  std::string const & thread_count)
+{
+  std::vector<std::string> args{tck_reach, "-a", algorithm, "-s", search_order};
+  if (!thread_count.empty()) {
+    args.push_back("--amap-threads");
+    args.push_back(thread_count);
+  }
+  std::string const labels = model_labels(model.path);
+  if (!labels.empty()) {
+    args.push_back("-l");
+    args.push_back(labels);
+  }
+  args.insert(args.end(), extra_options.begin(), extra_options.end());
+  args.push_back(model.path);
+
+  execution_t best;
+  for (unsigned long r = 0; r < runs; ++r) {
+    execution_t execution = execute(args, timeout);
+    if (r == 0 || (execution.status == "ok" && (best.status != "ok" || execution.wall_time < best.wall_time)))
+      best = std::move(execution);
+  }
+
+  std::string options;
+  for (std::string const & option : extra_options)
+    options += (options.empty() ? "" : " ") + option;
+
+  record_t record{{"MODEL", model.name},
+                  {"ALGORITHM", algorithm},
+                  {"SEARCH_ORDER", search_order},
+                  {"THREADS", (thread_count.empty() ? "-" : thread_count)},
+                  {"OPTIONS", options},
+                  {"STATUS", best.status},
+                  {"WALL_TIME_SECONDS", std::to_string(best.wall_time)},
+                  {"PEAK_MEMORY_KB", std::to_string(best.peak_memory_kb)}};
+
+  // tck-reach outputs one "KEY value" line per statistic
+  std::istringstream is(best.output);
+  std::string line;
+  while (std::getline(is, line)) {
+    std::size_t const space = line.find(' ');
+    if (space == 0 || space == std::string::npos)
+      continue;
+    record.emplace(line.substr(0, space), line.substr(space + 1));
+  }
+  return record;
+}
+
+/*!
+ \brief Keys of records
+ \param records : records
+ \return configuration_keys, measure_keys, then the other keys in records in
+ lexicographic order
+ */
+static std::vector<std::string> record_keys(std::vector<record_t> const & records)
+{
+  std::vector<std::string> keys{configuration_keys};
+  keys.insert(keys.end(), measure_keys.begin(), measure_keys.end());
+  std::size_t const fixed = keys.size();
+  for (record_t const & record : records)
+    for (auto && [key, value] : record)
+      if (std::find(keys.begin(), keys.end(), key) == keys.end())
+        keys.push_back(key);
+  std::sort(keys.begin() + fixed, keys.end());
+  return keys;
+}
+
+/*!
+ \brief Output a CSV field
+ \param os : output stream
+ \param field : a field
+ \post field has been output to os, between double quotes if it contains a
+ comma, a double quote or a new line
+ */
+static void output_csv_field(std::ostream & os, std::string const & field)
+{
+  if (field.find_first_of(",\"\n") == std::string::npos) {
+    os << field;
+    return;
+  }
+  os << '"';
+  for (char c : field) {
+    if (c == '"')
+      os << '"';
+    os << c;
+  }
+  os << '"';
+}
+
+/*!
+ \brief Output a JSON string
+ \param os : output stream
+ \param str : a string
+ \post str has been output to os between double quotes, with special characters
+ escaped
+ */
+static void output_json_string(std::ostream & os, std::string const & str)
+{
+  os << '"';
+  for (char c : str) {
+    if (c == '"' || c == '\\')
+      os << '\\' << c;
+    else if (c == '\n')
+      os << "\\n";
+    else if (c == '\t')
+      os << "\\t";
+    else
+      os << c;
+  }
+  os << '"';
+}
+
+/*!
+ \brief Output records
+ \param os : output stream
+ \param records : records
+ \post records have been output to os as CSV with a header line, or as a JSON
+ array of objects if json is set
+ */
+static void output_records(std::ostream & os, std::vector<record_t> const & records)
+{
+  std::vector<std::string> const keys = record_keys(records);
+
+  if (!json) {
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+      os << (i == 0 ? "" : ",");
+      output_csv_field(os, keys[i]);
+    }
+    os << std::endl;
+    for (record_t const & record : records) {
+      for (std::size_t i = 0; i < keys.size(); ++i) {
+        os << (i == 0 ? "" : ",");
+        auto it = record.find(keys[i]);
+        if (it != record.end())
+          output_csv_field(os, it->second);
+      }
+      os << std::endl;
+    }
+    return;
+  }
+
+  os << "[";
+  for (std::size_t r = 0; r < records.size(); ++r) {
+    os << (r == 0 ? "" : ",") << std::endl << "  {";
+    bool first = true;
+    for (std::string const & key : keys) {
+      auto it = records[r].find(key);
+      if (it == records[r].end())
+        continue;
+      os << (first ? "" : ", ");
+      output_json_string(os, key);
+      os << ": ";
+      output_json_string(os, it->second);
+      first = false;
+    }
+    os << "}";
+  }
+  os << std::endl << "]" << std::endl;
+}
+
+/*!
+ \brief Parse a CSV line
+ \param line : a line
+ \return the fields in line (see output_csv_field)
+ */
+static std::vector<std::string> parse_csv_line(std::string const & line)
+{
+  std::vector<std::string> fields(1);
+  bool quoted = false;
+  for (std::size_t i = 0; i < line.size(); ++i) {
+    char const c = line[i];
+    if (quoted) {
+      if (c == '"' && i + 1 < line.size() && line[i + 1] == '"')
+        fields.back() += line[++i];
+      else if (c == '"')
+        quoted = false;
+      else
+        fields.back() += c;
+    }
+    else if (c == '"')
+      quoted = true;
+    else if (c == ',')
+      fields.emplace_back();
+    else
+      fields.back() += c;
+  }
+  return fields;
+}
+
+/*!
+ \brief Read records
+ \param filename : a file output by output_records
+ \return the records in filename
+ \throw std::runtime_error : if filename cannot be read
+ */
+static std::vector<record_t> read_records(std::string const & filename)
+{
+  std::ifstream ifs(filename);
+  if (!ifs.good())
+    throw std::runtime_error("Cannot read baseline " + filename);
+
+  std::vector<record_t> records;
+  ifs >> std::ws;
+  if (ifs.peek() == '[') {
+    boost::property_tree::ptree tree;
+    try {
+      boost::property_tree::read_json(ifs, tree);
+    }
+    catch (boost::property_tree::json_parser_error const & e) {
+      throw std::runtime_error("Invalid baseline " + filename + ": " + e.what());
+    }
+    for (auto && [unused, object] : tree) {
+      record_t record;
+      for (auto && [key, value] : object)
+        record[key] = value.data();
+      records.push_back(record);
+    }
+    return records;
+  }
+
+  std::string line;
+  if (!std::getline(ifs, line))
+    return records;
+  std::vector<std::string> const keys = parse_csv_line(line);
+  while (std::getline(ifs, line)) {
+    std::vector<std::string> const fields = parse_csv_line(line);
+    record_t record;
+    for (std::size_t i = 0; i < keys.size() && i < fields.size(); ++i)
+      if (!fields[i].empty())
+        record[keys[i]] = fields[i];
+    records.push_back(record);
+  }
+  return records;
+}
+
+/*!
+ \brief Value of a key in a record
+ \param record : a record
+ \param key : a key
+ \return the value of key in record, empty if none
+ */
+static std::string value(record_t const & record, std::string const & key)
+{
+  auto it = record.find(key);
+  return (it == record.end() ? "" : it->second);
+}
+
+/*!
+ \brief Configuration of a record
+ \param record : a record
+ \return the values of configuration_keys in record
+ \note missing keys and empty values are the same configuration, since empty
+ fields are not stored when a CSV baseline is read (e.g. empty OPTIONS)
+ */
+static std::string configuration(record_t const & record)
+{
+  std::string c;
+  for (std::size_t i = 0; i < configuration_keys.size(); ++i)
+    c += (i == 0 ? "" : " ") + value(record, configuration_keys[i]);
+  return c;
+}
+
+/*!
+ \brief Compare records to a baseline
+ \param records : records
+ \param baseline : baseline records
+ \return number of regressions of records w.r.t. baseline
+ \post every regression has been reported on standard error: a successful run
+ that fails, a different reachability result, an increase of wall time by more
+ than time_threshold percent (and min_seconds seconds), or an increase of peak
+ memory by more than memory_threshold percent
+ */
+static std::size_t compare(std::vector<record_t> const & records, std::vector<record_t> const & baseline)
+{
+  std::map<std::string, record_t const *> base;
+  for (record_t const & record : baseline)
+    base[configuration(record)] = &record;
+
+  std::size_t regressions = 0;
+  auto regression = [&](std::string const & c, std::string const & what) {
+    std::cerr << tchecker::log_error << "regression: " << c << ": " << what << std::endl;
+    ++regressions;
+  };
+
+  for (record_t const & record : records) {
+    std::string const c = configuration(record);
+    auto it = base.find(c);
+    if (it == base.end()) {
+      std::cerr << tchecker::log_warning << "no baseline for " << c << std::endl;
+      continue;
+    }
+    record_t const & b = *it->second;
+
+    if (value(b, "STATUS") == "ok" && value(record, "STATUS") != "ok") {
+      regression(c, "status ok -> " + value(record, "STATUS"));
+      continue;
+    }
+    if (value(b, "STATUS") != "ok" || value(record, "STATUS") != "ok")
+      continue;
+
+    if (value(b, "REACHABLE") != value(record, "REACHABLE"))
+      regression(c, "REACHABLE " + value(b, "REACHABLE") + " -> " + value(record, "REACHABLE"));
+
+    double const time = std::strtod(value(record, "WALL_TIME_SECONDS").c_str(), nullptr);
+    double const base_time = std::strtod(value(b, "WALL_TIME_SECONDS").c_str(), nullptr);
+    if (time > base_time * (1 + time_threshold / 100) && time - base_time >= min_seconds)
+      regression(c, "WALL_TIME_SECONDS " + value(b, "WALL_TIME_SECONDS") + " -> " + value(record, "WALL_TIME_SECONDS"));
+
+    double const memory = std::strtod(value(record, "PEAK_MEMORY_KB").c_str(), nullptr);
+    double const base_memory = std::strtod(value(b, "PEAK_MEMORY_KB").c_str(), nullptr);
+    if (memory > base_memory * (1 + memory_threshold / 100))
+      regression(c, "PEAK_MEMORY_KB " + value(b, "PEAK_MEMORY_KB") + " -> " + value(record, "PEAK_MEMORY_KB"));
+  }
+  return regressions;
+}
+
+int main(int argc, char * argv[])
+{
+  std::filesystem::path tmp_dir;
+  try {
+    int optindex = parse_command_line(argc, argv);
+
+    if (help) {
+      usage(argv[0]);
+      return EXIT_SUCCESS;
+    }
+
+    if (optindex == argc)
+      throw std::runtime_error("No model");
+
+    if (tck_gen.empty()) {
+      char const * env = std::getenv("TCK_GEN");
+      tck_gen = (env != nullptr && *env != '\0' ? env : "tck-gen");
+    }
+
+    if (tck_reach.empty()) {
+      char const * env = std::getenv("TCK_REACH");
+      tck_reach = (env != nullptr && *env != '\0' ? env : "tck-reach");
+    }
+
+    std::string tmp_template = (std::filesystem::temp_directory_path() / "tck-bench.XXXXXX").string();
+    if (mkdtemp(tmp_template.data()) == nullptr)
+      throw std::runtime_error("Cannot create temporary directory: " + std::string(std::strerror(errno)));
+    tmp_dir = tmp_template;
+
+    std::vector<model_t> models;
+    for (int i = optindex; i < argc; ++i)
+      collect_models(argv[i], tmp_dir, models);
+
+    std::vector<record_t> records;
+    for (model_t const & model : models)
+      for (std::string const & algorithm : algorithms)
+        for (std::string const & search_order : search_orders) {
+          bool const threaded = (algorithm == "gsim" || algorithm == "gta_gsim" || algorithm == "gta_reach" ||
+                                 algorithm == "concur19_gsim");
+          for (std::size_t t = 0; t < (threaded ? threads.size() : 1); ++t) {
+            record_t record = run_configuration(model, algorithm, search_order, (threaded ? threads[t] : ""));
+            std::cerr << configuration(record) << ": " << record["STATUS"] << " " << record["WALL_TIME_SECONDS"] << "s "
+                      << record["PEAK_MEMORY_KB"] << "KB" << std::endl;
+            records.push_back(std::move(record));
+          }
+        }
+
+    if (output_file.empty())
+      output_records(std::cout, records);
+    else {
+      std::ofstream ofs(output_file);
+      if (!ofs.good())
+        throw std::runtime_error("Cannot write " + output_file);
+      output_records(ofs, records);
+    }
+
+    std::filesystem::remove_all(tmp_dir);
+
+    if (!baseline_file.empty()) {
+      std::size_t const regressions = compare(records, read_records(baseline_file));
+      if (regressions > 0) {
+        std::cerr << regressions << " regression(s) w.r.t. " << baseline_file << std::endl;
+        return 2;
+      }
+    }
+  }
+  catch (std::exception & e) {
+    if (!tmp_dir.empty())
+      std::filesystem::remove_all(tmp_dir);
+    std::cerr << tchecker::log_error << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
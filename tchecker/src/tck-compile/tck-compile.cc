@@ -0,0 +1,206 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <getopt.h>
+#include <iterator>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "tchecker/parsing/parsing.hh"
+#include "tchecker/ta/compiled_system.hh"
+#include "tchecker/ta/system.hh"
+#include "tchecker/utils/log.hh"
+
+/*!
+ \file tck-compile.cc
+ \brief Compilation of systems of timed processes to binary files
+ */
+
+static struct option long_options[] = {{"output", required_argument, 0, 'o'},
+                                       {"help", no_argument, 0, 'h'},
+                                       {"bench", required_argument, 0, 0},
+                                       {0, 0, 0, 0}};
+
+static char * const options = (char *)"ho:";
+
+void usage(char * progname)
+{
+  std::cerr << "Usage: " << progname << " [options] [file]" << std::endl;
+  std::cerr << "   -o file     output file (compiled model)" << std::endl;
+  std::cerr << "   -h          help" << std::endl;
+  std::cerr << "   --bench N   measure parsing throughput, and compare the time to load file and the compiled model (N loads each)"
+            << std::endl;
+  std::cerr << "reads from standard input if file is not provided" << std::endl;
+  std::cerr << "compiled models can be analysed with tck-reach --compiled" << std::endl;
+}
+
+static bool help = false;
+static std::string output_file = "";
+static unsigned long bench = 0;
+
+int parse_command_line(int argc, char * argv[])
+{
+  while (true) {
+    int long_option_index = -1;
+    int c = getopt_long(argc, argv, options, long_options, &long_option_index);
+
+    if (c == -1)
+      break;
+
+    if (c == ':')
+      throw std::runtime_error("Missing option parameter");
+    else if (c == '?')
+      throw std::runtime_error("Unknown command-line option");
+
+    switch (c) {
+    case 'h':
+      help = true;
+      break;
+    case 'o':
+      if (strcmp(optarg, "") == 0)
+        throw std::invalid_argument("Invalid empty output file name");
+      output_file = optarg;
+      break;
+    case 0:
+      if (strcmp(long_options[long_option_index].name, "bench") == 0) {
+        bench = std::strtoul(optarg, nullptr, 10);
+        if (bench == 0)
+          throw std::runtime_error("Invalid number of loads: " + std::string(optarg));
+      }
+      else
+        throw std::runtime_error("I should never be executed");
+      break;
+    default:
+      throw std::runtime_error("I should never be executed");
+      break;
+    }
+  }
+
+  return optind;
+}
+
+/*!
+ \brief Load system from a file
+ \param filename : file name
+ \return The system of timed processes declared in filename, nullptr if an
+ error occurred
+ \post all errors have been reported to std::cerr
+*/
+tchecker::ta::system_t * load_system(std::string const & filename)
+{
+  std::unique_ptr<tchecker::parsing::system_declaration_t> sysdecl;
+  try {
+    sysdecl.reset(tchecker::parsing::parse_system_declaration(filename));
+    if (sysdecl != nullptr && tchecker::log_error_count() == 0)
+      return new tchecker::ta::system_t{*sysdecl};
+  }
+  catch (std::exception const & e) {
+    std::cerr << tchecker::log_error << e.what() << std::endl;
+  }
+  tchecker::log_output_count(std::cout);
+  return nullptr;
+}
+
+/*!
+ \brief Benchmark loading of a system
+ \param filename : file name of a system declaration
+ \param compiled_filename : file name of the compiled system
+ \param n : number of loads
+ \post the average time (in seconds) to parse filename, the parsing throughput
+ (in megabytes and in declarations per second), and the average time to load the
+ system from filename (parsing, typechecking and compilation) and from
+ compiled_filename have been output to std::cout
+*/
+void do_bench(std::string const & filename, std::string const & compiled_filename, unsigned long n)
+{
+  using clock_t = std::chrono::steady_clock;
+
+  std::size_t declarations = 0;
+  clock_t::time_point start = clock_t::now();
+  for (unsigned long i = 0; i < n; ++i) {
+    std::unique_ptr<tchecker::parsing::system_declaration_t> sysdecl{tchecker::parsing::parse_system_declaration(filename)};
+    if (sysdecl == nullptr)
+      throw std::runtime_error("Failed to parse " + filename);
+    auto range = sysdecl->declarations();
+    declarations = std::distance(range.begin(), range.end());
+  }
+  std::chrono::duration<double> const parse_time = clock_t::now() - start;
+  double const megabytes = std::filesystem::file_size(filename) / (1024.0 * 1024.0);
+
+  start = clock_t::now();
+  for (unsigned long i = 0; i < n; ++i) {
+    std::unique_ptr<tchecker::ta::system_t> system{load_system(filename)};
+    if (system == nullptr)
+      throw std::runtime_error("Failed to load " + filename);
+  }
+  std::chrono::duration<double> const text_time = clock_t::now() - start;
+
+  start = clock_t::now();
+  for (unsigned long i = 0; i < n; ++i) {
+    std::unique_ptr<tchecker::ta::system_t> system{tchecker::ta::load_compiled_system(compiled_filename)};
+  }
+  std::chrono::duration<double> const compiled_time = clock_t::now() - start;
+
+  std::cout << "LOADS " << n << std::endl;
+  std::cout << "DECLARATIONS " << declarations << std::endl;
+  std::cout << "PARSE_TIME " << parse_time.count() / n << std::endl;
+  std::cout << "PARSE_MB_PER_S " << megabytes * n / parse_time.count() << std::endl;
+  std::cout << "PARSE_DECLARATIONS_PER_S " << declarations * n / parse_time.count() << std::endl;
+  std::cout << "TEXT_LOAD_TIME " << text_time.count() / n << std::endl;
+  std::cout << "COMPILED_LOAD_TIME " << compiled_time.count() / n << std::endl;
+}
+
+/*!
+ \brief Main function
+*/
+int main(int argc, char * argv[])
+{
+  try {
+    int optindex = parse_command_line(argc, argv);
+
+    if (argc - optindex > 1) {
+      std::cerr << "Too many input files" << std::endl;
+      usage(argv[0]);
+      return EXIT_FAILURE;
+    }
+
+    if (help) {
+      usage(argv[0]);
+      return EXIT_SUCCESS;
+    }
+
+    if (output_file == "") {
+      std::cerr << "Missing output file" << std::endl;
+      usage(argv[0]);
+      return EXIT_FAILURE;
+    }
+
+    std::string input_file = (optindex == argc ? "" : argv[optindex]);
+
+    if (bench > 0 && input_file == "")
+      throw std::runtime_error("Benchmarking requires an input file");
+
+    std::unique_ptr<tchecker::ta::system_t> system{load_system(input_file)};
+    if (system == nullptr)
+      return EXIT_FAILURE;
+
+    tchecker::ta::write_compiled_system(output_file, *system);
+
+    if (bench > 0)
+      do_bench(input_file, output_file, bench);
+  }
+  catch (std::exception & e) {
+    std::cerr << tchecker::log_error << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,747 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <getopt.h>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "tchecker/utils/log.hh"
+
+/*!
+ \file tck-gen.cc
+ \brief Generator of parametric families of models (toyECA, Fischer, CSMA/CD,
+ FDDI, ABP, dining philosophers) in the TChecker system declaration format
+ */
+
+static struct option long_options[] = {{"diagonals", required_argument, 0, 'd'},
+                                       {"help", no_argument, 0, 'h'},
+                                       {"output", required_argument, 0, 'o'},
+                                       {0, 0, 0, 0}};
+
+static char * const options = (char *)"d:ho:";
+
+void usage(char * progname)
+{
+  std::cerr << "Usage: " << progname << " [options] family [parameters]" << std::endl;
+  std::cerr << "   -d DENSITY  fraction of edges with an additional diagonal guard, in [0,1] (default: 0)"
+            << std::endl;
+  std::cerr << "   -h          help" << std::endl;
+  std::cerr << "   -o file     output file (default: standard output)" << std::endl;
+  std::cerr << "families (parameters in brackets are optional):" << std::endl;
+  std::cerr << "   toyeca BOUND EVENTS                          toyECA_BOUND_EVENTS" << std::endl;
+  std::cerr << "   fischer PROCESSES [K=10] [event|normal]      Fischer's protocol with event (history) or normal clocks"
+            << std::endl;
+  std::cerr << "   csmacd STATIONS [BUS=STATIONS] [LAMBDA=808] [SIGMA=26]" << std::endl;
+  std::cerr << "                                                CSMA/CD with an event-clock property (CSMACD-bounded)"
+            << std::endl;
+  std::cerr << "   fddi STATIONS [TTRT=50*STATIONS] [SA=20]     FDDI token ring" << std::endl;
+  std::cerr << "   abp [PROPERTY=1] [TIMEOUT=3]                 alternating bit protocol with property 1 or 2"
+            << std::endl;
+  std::cerr << "   dining PHILOSOPHERS [ACQ=3] [EAT=10] [prophecy|normal]" << std::endl;
+  std::cerr << "                                                dining philosophers, eating deadline with prophecy or"
+            << std::endl;
+  std::cerr << "                                                normal clocks" << std::endl;
+  std::cerr << "default parameters give the models in examples_gta (e.g. toyeca 1000 100, fischer 10 10 normal," << std::endl;
+  std::cerr << "csmacd 1 4, fddi 10, abp 2, dining 6 3 10 normal)" << std::endl;
+  std::cerr << "diagonal guards x-y<=c are over the history and normal clocks of the model, with c its main constant"
+            << std::endl;
+}
+
+static double density = 0.0;
+static bool help = false;
+static std::string output_file = "";
+
+int parse_command_line(int argc, char * argv[])
+{
+  while (true) {
+    int long_option_index = -1;
+    int c = getopt_long(argc, argv, options, long_options, &long_option_index);
+
+    if (c == -1)
+      break;
+
+    if (c == ':')
+      throw std::runtime_error("Missing option parameter");
+    else if (c == '?')
+      throw std::runtime_error("Unknown command-line option");
+
+    switch (c) {
+    case 'd': {
+      char * end = nullptr;
+      density = std::strtod(optarg, &end);
+      if (end == optarg || *end != '\0' || density < 0.0 || density > 1.0)
+        throw std::runtime_error("Invalid density of diagonal guards: " + std::string(optarg));
+      break;
+    }
+    case 'h':
+      help = true;
+      break;
+    case 'o':
+      if (strcmp(optarg, "") == 0)
+        throw std::invalid_argument("Invalid empty output file name");
+      output_file = optarg;
+      break;
+    default:
+      throw std::runtime_error("I should never be executed");
+      break;
+    }
+  }
+
+  return optind;
+}
+
+/*!
+ \class model_writer_t
+ \brief Output of a model in the TChecker system declaration format, with
+ diagonal guards spread over its edges
+ */
+class model_writer_t {
+public:
+  /*!
+   \brief Constructor
+   \param os : output stream
+   \param density : fraction of edges with an additional diagonal guard
+   \pre 0 <= density <= 1
+   */
+  model_writer_t(std::ostream & os, double density) : _os(os), _density(density), _edges(0), _diagonals(0) {}
+
+  /*!
+   \brief Accessor
+   \return output stream
+   */
+  inline std::ostream & os() { return _os; }
+
+  /*!
+   \brief Set the clocks of diagonal guards
+   \param clocks : clocks
+   \param bound : bound of diagonal guards
+   \post diagonal guards are x-y<=bound for consecutive clocks x and y in
+   clocks (cyclically)
+   \note the clocks must not be prophecy clocks (see the check of finite
+   successor computation in the parser)
+   */
+  void diagonal_clocks(std::vector<std::string> const & clocks, long bound)
+  {
+    _clocks = clocks;
+    _bound = bound;
+  }
+
+  /*!
+   \brief Output an edge
+   \param process : process name
+   \param src : source location
+   \param tgt : target location
+   \param event : event
+   \param guard : guard (empty if none)
+   \param update : update (empty if none)
+   \post the edge has been output with guard and update. A diagonal guard has
+   been added to guard if the edge is selected by the density: diagonal guards
+   are spread evenly over the edges
+   */
+  void edge(std::string const & process, std::string const & src, std::string const & tgt, std::string const & event,
+            std::string guard = "", std::string const & update = "")
+  {
+    double const before = std::floor(_edges * _density), after = std::floor((_edges + 1) * _density);
+    ++_edges;
+    if (_clocks.size() >= 2 && after > before) {
+      std::string const diagonal = _clocks[_diagonals % _clocks.size()] + "-" +
+                                   _clocks[(_diagonals + 1) % _clocks.size()] + "<=" + std::to_string(_bound);
+      guard = (guard.empty() ? diagonal : guard + "&&" + diagonal);
+      ++_diagonals;
+    }
+
+    _os << "edge:" << process << ":" << src << ":" << tgt << ":" << event << "{{";
+    if (!guard.empty() && update.empty())
+      _os << "provided:" << guard << ";";
+    else if (!update.empty())
+      _os << "provided:" << guard << (guard.empty() ? "" : " ") << ";" << (guard.empty() ? "" : " ") << "do:" << update
+          << ";";
+    _os << "}}" << std::endl;
+  }
+
+private:
+  std::ostream & _os;               /*!< Output stream */
+  double _density;                  /*!< Fraction of edges with a diagonal guard */
+  std::vector<std::string> _clocks; /*!< Clocks of diagonal guards */
+  long _bound;                      /*!< Bound of diagonal guards */
+  std::size_t _edges;               /*!< Number of output edges */
+  std::size_t _diagonals;           /*!< Number of output diagonal guards */
+};
+
+/*!
+ \brief Parameters of a family
+ */
+using parameters_t = std::vector<std::string>;
+
+/*!
+ \brief Integer parameter
+ \param params : parameters
+ \param i : index of the parameter
+ \param name : name of the parameter
+ \param default_value : default value (0 if the parameter is mandatory)
+ \return the i-th parameter in params, default_value if params has no i-th
+ parameter
+ \throw std::invalid_argument : if the parameter is not a positive integer, or
+ if it is mandatory and missing
+ */
+static long integer_parameter(parameters_t const & params, std::size_t i, std::string const & name, long default_value = 0)
+{
+  if (i >= params.size()) {
+    if (default_value == 0)
+      throw std::invalid_argument("Missing parameter " + name);
+    return default_value;
+  }
+  char * end = nullptr;
+  long const value = std::strtol(params[i].c_str(), &end, 10);
+  if (end == params[i].c_str() || *end != '\0' || value <= 0)
+    throw std::invalid_argument("Invalid parameter " + name + ": " + params[i]);
+  return value;
+}
+
+/*!
+ \brief Choice parameter
+ \param params : parameters
+ \param i : index of the parameter
+ \param name : name of the parameter
+ \param choices : allowed values, the first one is the default value
+ \return the i-th parameter in params, choices[0] if params has no i-th parameter
+ \throw std::invalid_argument : if the parameter is not in choices
+ */
+static std::string choice_parameter(parameters_t const & params, std::size_t i, std::string const & name,
+                                    std::vector<std::string> const & choices)
+{
+  if (i >= params.size())
+    return choices[0];
+  for (std::string const & choice : choices)
+    if (params[i] == choice)
+      return choice;
+  throw std::invalid_argument("Invalid parameter " + name + ": " + params[i]);
+}
+
+/*!
+ \brief Check the number of parameters
+ \param params : parameters
+ \param max : maximal number of parameters
+ \throw std::invalid_argument : if params has more than max parameters
+ */
+static void check_parameters(parameters_t const & params, std::size_t max)
+{
+  if (params.size() > max)
+    throw std::invalid_argument("Too many parameters: " + params[max] + "...");
+}
+
+/*!
+ \brief Labels line
+ \param prefix : prefix of labels
+ \param n : number of labels
+ \return #labels=prefix1:...:prefixn
+ */
+static std::string labels(std::string const & prefix, long n)
+{
+  std::string s = "#labels=";
+  for (long i = 1; i <= n; ++i)
+    s += (i == 1 ? "" : ":") + prefix + std::to_string(i);
+  return s;
+}
+
+/*!
+ \brief Generator of toyECA models
+ \param w : model writer
+ \param params : BOUND EVENTS
+ \post the model toyECA_BOUND_EVENTS has been output to w: event a is followed
+ by events b and c1..cEVENTS that occur at least BOUND time units later
+ */
+static void toyeca(model_writer_t & w, parameters_t const & params)
+{
+  check_parameters(params, 2);
+  long const bound = integer_parameter(params, 0, "BOUND");
+  long const events = integer_parameter(params, 1, "EVENTS");
+  std::ostream & os = w.os();
+
+  std::vector<std::string> clocks{"a_h", "b_h"};
+  for (long i = 1; i <= events; ++i)
+    clocks.push_back("c" + std::to_string(i) + "_h");
+  w.diagonal_clocks(clocks, bound);
+
+  os << "system:exp_example_" << bound << "_" << events << std::endl << std::endl;
+  os << "event:a:1:1" << std::endl << "event:b:1:1" << std::endl << std::endl;
+  for (long i = 1; i <= events; ++i)
+    os << "event:c" << i << ":1:1" << std::endl;
+  os << std::endl;
+
+  os << "process:P" << std::endl;
+  os << "location:P:l0{initial:}" << std::endl << "location:P:l1{}" << std::endl << "location:P:l2{}" << std::endl;
+  os << std::endl;
+
+  w.edge("P", "l0", "l1", "a");
+  w.edge("P", "l1", "l1", "a", "a_h==1&&b_p<=-" + std::to_string(bound));
+  for (long i = 1; i <= events; ++i) {
+    std::string const c = "c" + std::to_string(i);
+    w.edge("P", "l1", "l1", c, "a_h==1&&" + c + "_p<=-" + std::to_string(bound));
+  }
+  w.edge("P", "l1", "l2", "b");
+}
+
+/*!
+ \brief Generator of Fischer's protocol
+ \param w : model writer
+ \param params : PROCESSES [K] [event|normal]
+ \post Fischer's mutual exclusion protocol with PROCESSES processes and delay K
+ has been output to w. With event clocks, the delays are measured by the history
+ clocks of events reqi and seti of process i instead of a normal clock xi
+ */
+static void fischer(model_writer_t & w, parameters_t const & params)
+{
+  check_parameters(params, 3);
+  long const n = integer_parameter(params, 0, "PROCESSES");
+  std::string const k = std::to_string(integer_parameter(params, 1, "K", 10));
+  bool const eca = (choice_parameter(params, 2, "clocks", {"event", "normal"}) == "event");
+  std::ostream & os = w.os();
+
+  std::vector<std::string> clocks;
+  for (long i = 1; i <= n; ++i) {
+    std::string const s = std::to_string(i);
+    if (eca) {
+      clocks.push_back("req" + s + "_h");
+      clocks.push_back("set" + s + "_h");
+    }
+    else
+      clocks.push_back("x" + s);
+  }
+  w.diagonal_clocks(clocks, std::stol(k));
+
+  os << labels("cs", n) << std::endl;
+  os << "system:fischer" << (eca ? "_eca_" : "_") << n << "_" << k << std::endl << std::endl;
+  os << "event:tau" << std::endl;
+  if (eca)
+    for (long i = 1; i <= n; ++i)
+      os << "event:req" << i << ":1:0" << std::endl << "event:set" << i << ":1:0" << std::endl;
+  os << std::endl << "int:1:0:" << n << ":0:id" << std::endl;
+
+  for (long i = 1; i <= n; ++i) {
+    std::string const s = std::to_string(i), p = "P" + s;
+    std::string const req = (eca ? "req" + s : "tau"), set = (eca ? "set" + s : "tau");
+    std::string const req_clock = (eca ? "req" + s + "_h" : "x" + s), set_clock = (eca ? "set" + s + "_h" : "x" + s);
+    std::string const reset = (eca ? "" : "x" + s);
+
+    os << std::endl << "# Process " << i << std::endl;
+    os << "process:" << p << std::endl;
+    if (!eca)
+      os << "clock:normal:x" << i << std::endl;
+    os << "location:" << p << ":A{initial:}" << std::endl;
+    os << "location:" << p << ":req{invariant:" << req_clock << "<=" << k << "}" << std::endl;
+    os << "location:" << p << ":wait{}" << std::endl;
+    os << "location:" << p << ":cs{labels:cs" << i << "}" << std::endl << std::endl;
+
+    w.edge(p, "A", "req", req, "id==0", reset);
+    w.edge(p, "req", "wait", set, req_clock + "<=" + k, (eca ? "" : reset + ",") + "id=" + s);
+    w.edge(p, "wait", "req", req, "id==0", reset);
+    w.edge(p, "wait", "cs", "tau", set_clock + ">" + k + "&&id==" + s);
+    w.edge(p, "cs", "A", "tau", "", "id");
+  }
+}
+
+/*!
+ \brief Generator of the CSMA/CD protocol
+ \param w : model writer
+ \param params : STATIONS [BUS] [LAMBDA] [SIGMA]
+ \post the CSMA/CD protocol with STATIONS stations on a bus for BUS stations,
+ with transmission time LAMBDA and propagation time SIGMA, has been output to w.
+ Property process P observes the collisions (event a, with history and prophecy
+ clocks) and the transmissions (event b, with a prophecy clock) of Station1
+ \throw std::invalid_argument : if STATIONS > BUS
+ */
+static void csmacd(model_writer_t & w, parameters_t const & params)
+{
+  check_parameters(params, 4);
+  long const n = integer_parameter(params, 0, "STATIONS");
+  long const bus = integer_parameter(params, 1, "BUS", n);
+  std::string const lambda = std::to_string(integer_parameter(params, 2, "LAMBDA", 808));
+  long const sigma = integer_parameter(params, 3, "SIGMA", 26);
+  std::string const s = std::to_string(sigma), s2 = std::to_string(2 * sigma);
+  std::ostream & os = w.os();
+
+  if (n > bus)
+    throw std::invalid_argument("More stations than the bus can handle");
+
+  std::vector<std::string> clocks{"a_h", "y"};
+  for (long i = 1; i <= n; ++i)
+    clocks.push_back("x" + std::to_string(i));
+  w.diagonal_clocks(clocks, sigma);
+
+  os << "system:csmacd_" << bus << "_" << lambda << "_" << s << std::endl << std::endl;
+  for (char const * event : {"tau", "begin", "busy", "end", "cd"})
+    os << "event:" << event << std::endl;
+  for (long i = 1; i <= bus; ++i)
+    os << "event:cd" << i << std::endl;
+  os << std::endl << "event:a:1:1" << std::endl << "event:b:0:1" << std::endl << std::endl;
+
+  os << "process:P" << std::endl;
+  os << "location:P:l0{initial:}" << std::endl << "location:P:l1{labels: green}" << std::endl << std::endl;
+  w.edge("P", "l0", "l0", "a");
+  w.edge("P", "l0", "l0", "b");
+  w.edge("P", "l0", "l1", "a", "a_p>-INF && b_p < -30");
+  w.edge("P", "l1", "l1", "a");
+  w.edge("P", "l1", "l1", "b");
+
+  os << std::endl << "# Bus" << std::endl;
+  os << "process:Bus" << std::endl;
+  os << "int:1:1:" << bus + 1 << ":1:j" << std::endl;
+  os << "clock:normal:y" << std::endl;
+  os << "location:Bus:Idle{initial:}" << std::endl;
+  os << "location:Bus:Active{}" << std::endl;
+  os << "location:Bus:Collision{invariant:y<" << s << "}" << std::endl;
+  os << "location:Bus:Loop{committed:}" << std::endl;
+  w.edge("Bus", "Idle", "Active", "begin", "", "y");
+  w.edge("Bus", "Active", "Collision", "begin", "y<" + s, "y");
+  w.edge("Bus", "Active", "Active", "busy", "y>=" + s);
+  w.edge("Bus", "Active", "Idle", "end", "", "y");
+  w.edge("Bus", "Collision", "Loop", "tau", "y<" + s, "j=1");
+  w.edge("Bus", "Loop", "Idle", "tau", "j==" + std::to_string(bus + 1) + " &&y<" + s, "y,j=1");
+  for (long i = 1; i <= bus; ++i)
+    w.edge("Bus", "Loop", "Loop", "cd" + std::to_string(i), "j==" + std::to_string(i), "j=j+1");
+
+  for (long i = 1; i <= n; ++i) {
+    std::string const x = "x" + std::to_string(i), p = "Station" + std::to_string(i);
+    os << std::endl << "# Station " << i << std::endl;
+    os << "process:" << p << std::endl;
+    os << "clock:normal:" << x << std::endl;
+    os << "location:" << p << ":Wait{initial:}" << std::endl;
+    os << "location:" << p << ":Start{invariant:" << x << "<=" << lambda << "}" << std::endl;
+    os << "location:" << p << ":Retry{invariant:" << x << "<" << s2 << "}" << std::endl;
+    w.edge(p, "Wait", "Start", "begin", "", x);
+    w.edge(p, "Wait", "Retry", "busy", "", x);
+    w.edge(p, "Wait", "Wait", "cd", "", x);
+    w.edge(p, "Wait", "Retry", "cd", "", x);
+    w.edge(p, "Start", "Wait", "end", x + "==" + lambda, x);
+    w.edge(p, "Start", "Retry", "cd", x + "<" + s, x);
+    w.edge(p, "Retry", "Start", "begin", x + "<" + s2, x);
+    w.edge(p, "Retry", "Retry", "busy", x + "<" + s2, x);
+    w.edge(p, "Retry", "Retry", "cd", x + "<" + s2, x);
+    os << "sync:Bus@begin:" << p << "@begin" << std::endl;
+    os << "sync:Bus@busy:" << p << "@busy" << std::endl;
+    os << "sync:Bus@cd" << i << ":" << p << "@cd" << std::endl;
+    os << "sync:Bus@end:" << p << "@end" << std::endl;
+  }
+
+  os << std::endl << "sync:Station1@cd:P@a" << std::endl << "sync:Station1@begin:P@b" << std::endl;
+}
+
+/*!
+ \brief Generator of the FDDI protocol
+ \param w : model writer
+ \param params : STATIONS [TTRT] [SA]
+ \post the FDDI token ring protocol with STATIONS stations, target token
+ rotation time TTRT and synchronous allocation SA has been output to w
+ */
+static void fddi(model_writer_t & w, parameters_t const & params)
+{
+  check_parameters(params, 3);
+  long const n = integer_parameter(params, 0, "STATIONS");
+  std::string const ttrt = std::to_string(integer_parameter(params, 1, "TTRT", 50 * n));
+  std::string const sa = std::to_string(integer_parameter(params, 2, "SA", 20));
+  std::string const async = std::to_string(std::stol(ttrt) + std::stol(sa));
+  std::ostream & os = w.os();
+
+  std::vector<std::string> clocks;
+  for (long i = 1; i <= n; ++i)
+    for (char const * c : {"trt", "xA", "xB"})
+      clocks.push_back(c + std::to_string(i));
+  w.diagonal_clocks(clocks, std::stol(ttrt));
+
+  os << "# Model of the FDDI protocol inspired from:" << std::endl;
+  os << "# The tool Kronos, C. Daws, A. Oliveiro, S. Tripakis and S. Yovine," << std::endl;
+  os << "# Hybrid Systems III, 1996" << std::endl << std::endl;
+  os << "system:fddi_" << n << "_" << ttrt << "_" << sa << "_0" << std::endl << std::endl;
+  os << "event:tau" << std::endl << "event:TT" << std::endl << "event:RT" << std::endl;
+  for (long i = 1; i <= n; ++i)
+    os << "event:TT" << i << std::endl << "event:RT" << i << std::endl;
+
+  for (long i = 1; i <= n; ++i) {
+    std::string const s = std::to_string(i), p = "P" + s;
+    std::string const trt = "trt" + s, xa = "xA" + s, xb = "xB" + s;
+    os << std::endl << "# Process " << i << std::endl;
+    os << "process:" << p << std::endl;
+    os << "clock:normal:" << trt << std::endl << "clock:normal:" << xa << std::endl << "clock:normal:" << xb << std::endl;
+    os << "location:" << p << ":q0{initial:}" << std::endl;
+    os << "location:" << p << ":q1{invariant: " << trt << "<=" << sa << "}" << std::endl;
+    os << "location:" << p << ":q2{invariant: " << trt << "<=" << sa << "}" << std::endl;
+    os << "location:" << p << ":q3{invariant: " << xa << "<=" << async << "}" << std::endl;
+    os << "location:" << p << ":q4{}" << std::endl;
+    os << "location:" << p << ":q5{invariant: " << trt << "<=" << sa << "}" << std::endl;
+    os << "location:" << p << ":q6{invariant: " << trt << "<=" << sa << "}" << std::endl;
+    os << "location:" << p << ":q7{invariant: " << xb << "<=" << async << "}" << std::endl << std::endl;
+    w.edge(p, "q0", "q1", "TT", " " + trt + ">=" + ttrt, " " + trt + "," + xb);
+    w.edge(p, "q0", "q2", "TT", " " + trt + "<" + ttrt, " " + trt + "," + xb);
+    w.edge(p, "q1", "q4", "RT", " " + trt + "==" + sa);
+    w.edge(p, "q2", "q3", "tau", " " + trt + "==" + sa);
+    w.edge(p, "q3", "q4", "RT");
+    w.edge(p, "q4", "q5", "TT", " " + trt + ">=" + ttrt, " " + trt + "," + xa);
+    w.edge(p, "q4", "q6", "TT", " " + trt + "<" + ttrt, " " + trt + "," + xa);
+    w.edge(p, "q5", "q0", "RT", " " + trt + "==" + sa);
+    w.edge(p, "q6", "q7", "tau", " " + trt + "==" + sa);
+    w.edge(p, "q7", "q0", "RT");
+  }
+
+  os << std::endl << "# Ring" << std::endl;
+  os << "process:R" << std::endl << "clock:normal:t" << std::endl;
+  for (long i = 1; i <= n; ++i) {
+    os << "location:R:q" << i << "{" << (i == 1 ? "initial: : " : "") << "invariant: t<=0}" << std::endl;
+    os << "location:R:r" << i << "{}" << std::endl;
+  }
+  os << std::endl;
+  for (long i = 1; i <= n; ++i) {
+    std::string const s = std::to_string(i);
+    w.edge("R", "q" + s, "r" + s, "TT" + s, " t==0");
+    w.edge("R", "r" + s, "q" + std::to_string(i % n + 1), "RT" + s, "", " t");
+  }
+
+  os << std::endl << "# Synchronizations" << std::endl;
+  for (long i = 1; i <= n; ++i)
+    os << "sync:P" << i << "@TT:R@TT" << i << std::endl << "sync:P" << i << "@RT:R@RT" << i << std::endl;
+}
+
+/*!
+ \brief Generator of the alternating bit protocol
+ \param w : model writer
+ \param params : [PROPERTY] [TIMEOUT]
+ \post the alternating bit protocol with retransmission timeout TIMEOUT (timer
+ clock t) and property process prop1 or prop2 has been output to w
+ */
+static void abp(model_writer_t & w, parameters_t const & params)
+{
+  check_parameters(params, 2);
+  long const property = integer_parameter(params, 0, "PROPERTY", 1);
+  std::string const timeout = std::to_string(integer_parameter(params, 1, "TIMEOUT", 3));
+  std::ostream & os = w.os();
+
+  if (property > 2)
+    throw std::invalid_argument("Invalid parameter PROPERTY: " + std::to_string(property));
+
+  std::string const prop = "prop" + std::to_string(property);
+  std::string const e = "p" + std::to_string(property);
+  std::vector<std::string> const observed = (property == 1 ? std::vector<std::string>{"send0", "send1", "ack0"}
+                                                           : std::vector<std::string>{"send0", "ack0"});
+  std::vector<std::string> clocks;
+  for (std::string const & o : observed)
+    clocks.push_back(e + o + "_h");
+  w.diagonal_clocks(clocks, std::stol(timeout));
+
+  os << "system:alt_bit" << std::endl << std::endl;
+  for (std::string const & o : observed)
+    os << "event:" << e << o << ":1:1" << std::endl;
+  os << std::endl;
+  for (char const * event : {"send0", "send1", "ack0", "ack1", "rpkt0", "rpkt1", "rack0", "rack1", "lost"})
+    os << "event:" << event << std::endl;
+  os << std::endl << "clock:timer:t" << std::endl;
+
+  // The timer is checked (t==-INF) after being released: these edges have a
+  // program of two blocks and no diagonal guard
+  os << std::endl << "process:sender" << std::endl;
+  for (char const * l : {"s0", "s1", "s2", "s3"})
+    os << "location:sender:" << l << (l == std::string("s0") ? "{initial:}" : "{}") << std::endl;
+  os << std::endl;
+  for (int bit = 0; bit <= 1; ++bit) {
+    std::string const b = std::to_string(bit), nb = std::to_string(1 - bit);
+    std::string const idle = "s" + std::to_string(2 * bit), sending = "s" + std::to_string(2 * bit + 1);
+    std::string const next = "s" + std::to_string(2 * (1 - bit));
+    w.edge("sender", idle, idle, "ack" + nb);
+    w.edge("sender", idle, idle, "ack" + b);
+    w.edge("sender", idle, sending, "send" + b, "t==-INF", "t=-" + timeout);
+    w.edge("sender", sending, sending, "ack" + nb);
+    w.edge("sender", sending, sending, "send" + b, "t==0", "t=-" + timeout);
+    os << "edge:sender:" << sending << ":" << next << ":ack" << b << "{{provided:; do:t; provided:t==-INF;}}"
+       << std::endl;
+  }
+
+  os << std::endl << "process:receiver" << std::endl;
+  os << "location:receiver:r0{initial:}" << std::endl << "location:receiver:r1{}" << std::endl
+     << "location:receiver:r2{}" << std::endl
+     << std::endl;
+  w.edge("receiver", "r0", "r1", "rpkt0");
+  w.edge("receiver", "r1", "r0", "rack0");
+  w.edge("receiver", "r0", "r2", "rpkt1");
+  w.edge("receiver", "r2", "r0", "rack1");
+  w.edge("receiver", "r1", "r1", "rack0");
+  w.edge("receiver", "r2", "r2", "rack1");
+
+  os << std::endl << "process:channel" << std::endl;
+  os << "location:channel:l0{initial:}" << std::endl;
+  for (int l = 1; l <= 4; ++l)
+    os << "location:channel:l" << l << "{}" << std::endl;
+  os << std::endl;
+  std::vector<std::pair<std::string, std::string>> const messages{
+      {"send0", "rpkt0"}, {"send1", "rpkt1"}, {"rack0", "ack0"}, {"rack1", "ack1"}};
+  for (std::size_t m = 0; m < messages.size(); ++m) {
+    std::string const l = "l" + std::to_string(m + 1);
+    w.edge("channel", "l0", l, messages[m].first);
+    w.edge("channel", l, "l0", "lost");
+    w.edge("channel", l, "l0", messages[m].second);
+  }
+
+  os << std::endl << "process:fair" << std::endl;
+  os << "location:fair:f0{initial:}" << std::endl << "location:fair:f1{}" << std::endl << "location:fair:f2{}" << std::endl
+     << std::endl;
+  for (char const * event : {"send0", "send1", "ack0", "ack1", "rpkt0", "rpkt1", "rack0", "rack1"})
+    w.edge("fair", "f0", "f0", event);
+  w.edge("fair", "f0", "f1", "lost");
+  for (int f = 1; f <= 2; ++f) {
+    std::string const l = "f" + std::to_string(f);
+    for (char const * event : {"send0", "send1", "rack0", "rack1"})
+      w.edge("fair", l, l, event);
+    for (char const * event : {"ack0", "ack1", "rpkt0", "rpkt1"})
+      w.edge("fair", l, "f0", event);
+  }
+  w.edge("fair", "f1", "f2", "lost");
+
+  std::string const l0 = (property == 1 ? "pp0" : "l0"), l1 = (property == 1 ? "pp1" : "l1");
+  os << std::endl << "process:" << prop << std::endl;
+  os << "location:" << prop << ":" << l0 << "{initial:}" << std::endl;
+  os << "location:" << prop << ":" << l1 << "{labels:green}" << std::endl << std::endl;
+  for (std::string const & o : observed)
+    w.edge(prop, l0, l0, e + o);
+  if (property == 1)
+    w.edge(prop, l0, l1, e + "send0", e + "ack0_p-" + e + "send1_p<0");
+  else
+    w.edge(prop, l0, l1, e + "ack0", e + "send0_h>" + timeout);
+  for (std::string const & o : observed)
+    w.edge(prop, l1, l1, e + o);
+
+  auto observer = [&](std::string const & event) {
+    for (std::string const & o : observed)
+      if (o == event)
+        return ":" + prop + "@" + e + o;
+    return std::string{};
+  };
+  os << std::endl;
+  for (char const * event : {"send0", "send1", "ack0", "ack1"})
+    os << "sync:sender@" << event << ":channel@" << event << ":fair@" << event << observer(event) << std::endl;
+  os << std::endl;
+  for (char const * event : {"rpkt0", "rpkt1", "rack0", "rack1"})
+    os << "sync:receiver@" << event << ":channel@" << event << ":fair@" << event << std::endl;
+  os << std::endl << "sync:fair@lost:channel@lost" << std::endl;
+}
+
+/*!
+ \brief Generator of the dining philosophers
+ \param w : model writer
+ \param params : PHILOSOPHERS [ACQ] [EAT] [prophecy|normal]
+ \post the dining philosophers with PHILOSOPHERS philosophers has been output to
+ w. Philosopher i takes its left fork, then its right fork within ACQ time units
+ (or releases its left fork), and eats for EAT time units. With prophecy clocks,
+ the eating duration is enforced by the prophecy clock of event releasei when
+ the right fork is taken, instead of a guard and an invariant on clock xi
+ */
+static void dining(model_writer_t & w, parameters_t const & params)
+{
+  check_parameters(params, 4);
+  long const n = integer_parameter(params, 0, "PHILOSOPHERS");
+  std::string const acq = std::to_string(integer_parameter(params, 1, "ACQ", 3));
+  std::string const eat = std::to_string(integer_parameter(params, 2, "EAT", 10));
+  bool const prophecy = (choice_parameter(params, 3, "clocks", {"prophecy", "normal"}) == "prophecy");
+  std::ostream & os = w.os();
+
+  std::vector<std::string> clocks;
+  for (long i = 1; i <= n; ++i)
+    clocks.push_back("x" + std::to_string(i));
+  w.diagonal_clocks(clocks, std::stol(eat));
+
+  os << labels("eating", n) << std::endl;
+  os << "system:dining_philosophers" << (prophecy ? "_prophecy_" : "_") << n << "_" << acq << "_" << eat << "_0"
+     << std::endl
+     << std::endl;
+  os << "# events" << std::endl << "event:tau" << std::endl;
+  for (long i = 1; i <= n; ++i)
+    os << "event:take" << i << std::endl << "event:release" << i << (prophecy ? ":0:1" : "") << std::endl;
+
+  for (long i = 1; i <= n; ++i) {
+    std::string const s = std::to_string(i), p = "P" + s, x = " x" + s;
+    std::string const left = std::to_string(i == 1 ? n : i - 1);
+    os << std::endl << "# Philosopher " << i << std::endl;
+    os << "process:" << p << std::endl;
+    os << "clock:normal:x" << i << std::endl;
+    os << "location:" << p << ":idle{initial:}" << std::endl;
+    os << "location:" << p << ":acq{invariant:" << x << "<=" << acq << "}" << std::endl;
+    if (prophecy)
+      os << "location:" << p << ":eat{labels: eating" << i << "}" << std::endl;
+    else
+      os << "location:" << p << ":eat{invariant:" << x << "<=" << eat << " : labels: eating" << i << "}" << std::endl;
+    os << "location:" << p << ":rel{invariant:" << x << "<=0}" << std::endl << std::endl;
+    w.edge(p, "idle", "acq", "take" + left, "", x);
+    w.edge(p, "acq", "idle", "release" + left, x + ">=" + acq);
+    w.edge(p, "acq", "eat", "take" + s, x + "<=" + acq + (prophecy ? "&&release" + s + "_p==-" + eat : ""), x);
+    w.edge(p, "eat", "rel", "release" + s, (prophecy ? "" : x + ">=" + eat), x);
+    w.edge(p, "rel", "idle", "release" + left);
+  }
+
+  for (long i = 1; i <= n; ++i) {
+    std::string const s = std::to_string(i), f = "F" + s;
+    os << std::endl << "# Fork " << i << std::endl;
+    os << "process:" << f << std::endl;
+    os << "location:" << f << ":free{initial:}" << std::endl << "location:" << f << ":taken{}" << std::endl;
+    w.edge(f, "free", "taken", "take" + s);
+    w.edge(f, "taken", "free", "release" + s);
+  }
+
+  os << std::endl << "# Synchronizations" << std::endl;
+  for (long i = 1; i <= n; ++i) {
+    std::string const s = std::to_string(i), left = std::to_string(i == 1 ? n : i - 1);
+    os << "sync:P" << s << "@take" << left << ":F" << left << "@take" << left << std::endl;
+    os << "sync:P" << s << "@take" << s << ":F" << s << "@take" << s << std::endl;
+    os << "sync:P" << s << "@release" << left << ":F" << left << "@release" << left << std::endl;
+    os << "sync:P" << s << "@release" << s << ":F" << s << "@release" << s << std::endl;
+  }
+}
+
+/*!
+ \brief Families of models
+ */
+static std::map<std::string, std::function<void(model_writer_t &, parameters_t const &)>> const families{
+    {"abp", abp}, {"csmacd", csmacd}, {"dining", dining}, {"fddi", fddi}, {"fischer", fischer}, {"toyeca", toyeca}};
+
+int main(int argc, char * argv[])
+{
+  try {
+    int optindex = parse_command_line(argc, argv);
+
+    if (help) {
+      usage(argv[0]);
+      return EXIT_SUCCESS;
+    }
+
+    if (optindex == argc)
+      throw std::runtime_error("No family");
+
+    auto it = families.find(argv[optindex]);
+    if (it == families.end())
+      throw std::runtime_error("Unknown family: " + std::string(argv[optindex]));
+    parameters_t const params(argv + optindex + 1, argv + argc);
+
+    std::ofstream ofs;
+    if (!output_file.empty()) {
+      ofs.open(output_file);
+      if (!ofs.good())
+        throw std::runtime_error("Cannot write " + output_file);
+    }
+    model_writer_t w(output_file.empty() ? std::cout : ofs, density);
+    it->second(w, params);
+  }
+  catch (std::exception & e) {
+    std::cerr << tchecker::log_error << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
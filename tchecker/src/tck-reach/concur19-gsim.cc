@@ -0,0 +1,194 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <stdexcept>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include "concur19-gsim.hh"
+#include "tchecker/algorithms/search_order.hh"
+#include "tchecker/ta/state.hh"
+
+namespace tchecker {
+
+namespace tck_reach {
+
+namespace concur19_gsim {
+
+/* node_t */
+
+node_t::node_t(tchecker::refzg::state_sptr_t const & s) : _state(s) {}
+
+node_t::node_t(tchecker::refzg::const_state_sptr_t const & s) : _state(s) {}
+
+/* node_hash_t */
+
+std::size_t node_hash_t::operator()(tchecker::tck_reach::concur19_gsim::node_t const & n) const
+{
+  // NB: we hash on the discrete part of the state in n to check all nodes
+  // with same discrete part for covering
+  return tchecker::ta::hash_value(n.state());
+}
+
+/* node_le_t */
+
+node_le_t::node_le_t(std::shared_ptr<tchecker::amap::a_map_t const> const & amap)
+    : _amap(amap), _G(new std::vector<tchecker::typed_diagonal_clkconstr_expression_t const *>()),
+      _Gdf(new std::vector<tchecker::typed_simple_clkconstr_expression_t const *>())
+{
+}
+
+node_le_t::node_le_t(tchecker::tck_reach::concur19_gsim::node_le_t const & node_le) = default;
+
+node_le_t::node_le_t(tchecker::tck_reach::concur19_gsim::node_le_t && node_le) = default;
+
+node_le_t::~node_le_t() = default;
+
+tchecker::tck_reach::concur19_gsim::node_le_t & node_le_t::operator=(tchecker::tck_reach::concur19_gsim::node_le_t const & node_le) = default;
+
+tchecker::tck_reach::concur19_gsim::node_le_t & node_le_t::operator=(tchecker::tck_reach::concur19_gsim::node_le_t && node_le) = default;
+
+bool node_le_t::operator()(tchecker::tck_reach::concur19_gsim::node_t const & n1,
+                           tchecker::tck_reach::concur19_gsim::node_t const & n2) const
+{
+  _amap->bounds(n2.state().vloc(), *_G, *_Gdf);
+  return tchecker::refzg::sync_g_le(n1.state(), n2.state(), *_G, *_Gdf);
+}
+
+/* edge_t */
+
+edge_t::edge_t(tchecker::refzg::transition_t const & t) : _vedge(t.vedge_ptr()) {}
+
+/* graph_t */
+
+graph_t::graph_t(std::shared_ptr<tchecker::refzg::refzg_t> const & refzg,
+                 std::shared_ptr<tchecker::amap::a_map_t const> const & amap, std::size_t block_size, std::size_t table_size)
+    : tchecker::graph::subsumption::graph_t<tchecker::tck_reach::concur19_gsim::node_t, tchecker::tck_reach::concur19_gsim::edge_t,
+                                            tchecker::tck_reach::concur19_gsim::node_hash_t,
+                                            tchecker::tck_reach::concur19_gsim::node_le_t>(
+          block_size, table_size, tchecker::tck_reach::concur19_gsim::node_hash_t(),
+          tchecker::tck_reach::concur19_gsim::node_le_t(amap)),
+      _refzg(refzg), _amap(amap)
+{
+}
+
+graph_t::~graph_t()
+{
+  tchecker::graph::subsumption::graph_t<tchecker::tck_reach::concur19_gsim::node_t, tchecker::tck_reach::concur19_gsim::edge_t,
+                                        tchecker::tck_reach::concur19_gsim::node_hash_t,
+                                        tchecker::tck_reach::concur19_gsim::node_le_t>::clear();
+}
+
+void graph_t::attributes(tchecker::tck_reach::concur19_gsim::node_t const & n, std::map<std::string, std::string> & m) const
+{
+  _refzg->attributes(n.state_ptr(), m);
+}
+
+void graph_t::attributes(tchecker::tck_reach::concur19_gsim::edge_t const & e, std::map<std::string, std::string> & m) const
+{
+  m["vedge"] = tchecker::to_string(e.vedge(), _refzg->system().as_system_system());
+}
+
+/* dot_output */
+
+/*!
+ \class node_lexical_less_t
+ \brief Less-than order on nodes based on lexical ordering
+*/
+class node_lexical_less_t {
+public:
+  /*!
+   \brief Less-than order on nodes based on lexical ordering
+   \param n1 : a node
+   \param n2 : a node
+   \return true if n1 is less-than n2 w.r.t. lexical ordering over the states in
+   the nodes
+  */
+  bool operator()(tchecker::tck_reach::concur19_gsim::graph_t::node_sptr_t const & n1,
+                  tchecker::tck_reach::concur19_gsim::graph_t::node_sptr_t const & n2) const
+  {
+    return tchecker::refzg::lexical_cmp(n1->state(), n2->state()) < 0;
+  }
+};
+
+/*!
+ \class edge_lexical_less_t
+ \brief Less-than ordering on edges based on lexical ordering
+ */
+class edge_lexical_less_t {
+public:
+  /*!
+   \brief Less-than ordering on edges based on lexical ordering
+   \param e1 : an edge
+   \param e2 : an edge
+   \return true if e1 is less-than  e2 w.r.t. the tuple of edges in e1 and e2
+  */
+  bool operator()(tchecker::tck_reach::concur19_gsim::graph_t::edge_sptr_t const & e1,
+                  tchecker::tck_reach::concur19_gsim::graph_t::edge_sptr_t const & e2) const
+  {
+    return tchecker::lexical_cmp(e1->vedge(), e2->vedge()) < 0;
+  }
+};
+
+std::ostream & dot_output(std::ostream & os, tchecker::tck_reach::concur19_gsim::graph_t const & g, std::string const & name)
+{
+  return tchecker::graph::subsumption::dot_output<tchecker::tck_reach::concur19_gsim::graph_t,
+                                                  tchecker::tck_reach::concur19_gsim::node_lexical_less_t,
+                                                  tchecker::tck_reach::concur19_gsim::edge_lexical_less_t>(os, g, name);
+}
+
+/* run */
+
+std::tuple<tchecker::algorithms::covreach::stats_t, std::shared_ptr<tchecker::tck_reach::concur19_gsim::graph_t>>
+run(std::shared_ptr<tchecker::ta::system_t const> const & system, std::string const & labels,
+    std::string const & search_order, std::size_t block_size, std::size_t table_size, unsigned int amap_threads,
+    std::shared_ptr<tchecker::clockbounds::cache_t const> const & cache,
+    std::shared_ptr<tchecker::profiler_t> const & profiler,
+    std::shared_ptr<tchecker::algorithms::progress_t> const & progress)
+{
+  tchecker::profiler_t::phase_t zone_graph_phase{profiler.get(), "ZONE_GRAPH"};
+  std::shared_ptr<tchecker::refzg::refzg_t> refzg{tchecker::refzg::factory(system, tchecker::refzg::PROCESS_REFERENCE_CLOCKS,
+                                                                           tchecker::refzg::ELAPSED_SEMANTICS,
+                                                                           tchecker::refdbm::UNBOUNDED_SPREAD, block_size)};
+  zone_graph_phase.stop();
+
+  tchecker::profiler_t::phase_t amap_phase{profiler.get(), "AMAP"};
+  std::shared_ptr<tchecker::amap::a_map_t const> amap{cache != nullptr ? cache->load_amap(*system) : nullptr};
+  if (amap == nullptr) {
+    std::shared_ptr<tchecker::amap::a_map_t const> computed{tchecker::amap::compute_amap(*system, amap_threads)};
+    if (computed == nullptr)
+      throw std::runtime_error("reduced A-map computation failed");
+    if (cache != nullptr)
+      cache->store_amap(*system, *computed);
+    amap = computed;
+  }
+  amap_phase.stop();
+
+  tchecker::profiler_t::phase_t graph_phase{profiler.get(), "GRAPH"};
+  std::shared_ptr<tchecker::tck_reach::concur19_gsim::graph_t> graph{
+      new tchecker::tck_reach::concur19_gsim::graph_t{refzg, amap, block_size, table_size}};
+
+  boost::dynamic_bitset<> accepting_labels = system->as_syncprod_system().labels(labels);
+
+  tchecker::tck_reach::concur19_gsim::algorithm_t algorithm;
+  algorithm.set_progress(progress);
+
+  enum tchecker::waiting::policy_t policy = tchecker::algorithms::fast_remove_waiting_policy(search_order);
+  graph_phase.stop();
+
+  tchecker::profiler_t::phase_t exploration_phase{profiler.get(), "EXPLORATION"};
+  tchecker::algorithms::covreach::stats_t stats = algorithm.run(*refzg, *graph, accepting_labels, policy);
+  exploration_phase.stop();
+
+  return std::make_tuple(stats, graph);
+}
+
+} // end of namespace concur19_gsim
+
+} // end of namespace tck_reach
+
+} // end of namespace tchecker
\ No newline at end of file
@@ -34,65 +34,34 @@ std::size_t node_hash_t::operator()(tchecker::tck_reach::concur19::node_t const
 
 /* node_le_t */
 
-node_le_t::node_le_t(std::shared_ptr<tchecker::clockbounds::clockbounds_t> const & clockbounds) : _clockbounds(clockbounds)
+node_le_t::node_le_t(std::shared_ptr<tchecker::clockbounds::clockbounds_t> const & clockbounds)
+    : _clockbounds(clockbounds), _lu_table(new tchecker::clockbounds::local_lu_table_t(_clockbounds->local_lu_map()))
 {
-  _l = tchecker::clockbounds::allocate_map(_clockbounds->clock_number());
-  _u = tchecker::clockbounds::allocate_map(_clockbounds->clock_number());
 }
 
-node_le_t::node_le_t(tchecker::ta::system_t const & system) : _clockbounds(tchecker::clockbounds::compute_clockbounds(system))
+node_le_t::node_le_t(tchecker::ta::system_t const & system)
+    : _clockbounds(tchecker::clockbounds::compute_clockbounds(system)),
+      _lu_table(new tchecker::clockbounds::local_lu_table_t(_clockbounds->local_lu_map()))
 {
-  _l = tchecker::clockbounds::allocate_map(_clockbounds->clock_number());
-  _u = tchecker::clockbounds::allocate_map(_clockbounds->clock_number());
 }
 
-node_le_t::node_le_t(tchecker::tck_reach::concur19::node_le_t const & node_le) : _clockbounds(node_le._clockbounds)
-{
-  _l = tchecker::clockbounds::clone_map(*node_le._l);
-  _u = tchecker::clockbounds::clone_map(*node_le._u);
-}
+node_le_t::node_le_t(tchecker::tck_reach::concur19::node_le_t const & node_le) = default;
 
-node_le_t::node_le_t(tchecker::tck_reach::concur19::node_le_t && node_le) : _clockbounds(std::move(node_le._clockbounds))
-{
-  _l = node_le._l;
-  node_le._l = nullptr;
-  _u = node_le._u;
-  node_le._u = nullptr;
-}
+node_le_t::node_le_t(tchecker::tck_reach::concur19::node_le_t && node_le) = default;
 
-node_le_t::~node_le_t()
-{
-  tchecker::clockbounds::deallocate_map(_l);
-  tchecker::clockbounds::deallocate_map(_u);
-}
+node_le_t::~node_le_t() = default;
 
-tchecker::tck_reach::concur19::node_le_t & node_le_t::operator=(tchecker::tck_reach::concur19::node_le_t const & node_le)
-{
-  if (this != &node_le) {
-    _clockbounds = node_le._clockbounds;
-    _l = tchecker::clockbounds::clone_map(*node_le._l);
-    _u = tchecker::clockbounds::clone_map(*node_le._u);
-  }
-  return *this;
-}
+tchecker::tck_reach::concur19::node_le_t & node_le_t::operator=(tchecker::tck_reach::concur19::node_le_t const & node_le) = default;
 
-tchecker::tck_reach::concur19::node_le_t & node_le_t::operator=(tchecker::tck_reach::concur19::node_le_t && node_le)
-{
-  if (this != &node_le) {
-    _clockbounds = std::move(node_le._clockbounds);
-    _l = node_le._l;
-    node_le._l = nullptr;
-    _u = node_le._u;
-    node_le._u = nullptr;
-  }
-  return *this;
-}
+tchecker::tck_reach::concur19::node_le_t & node_le_t::operator=(tchecker::tck_reach::concur19::node_le_t && node_le) = default;
 
 bool node_le_t::operator()(tchecker::tck_reach::concur19::node_t const & n1,
                            tchecker::tck_reach::concur19::node_t const & n2) const
 {
-  _clockbounds->local_lu(n2.state().vloc(), *_l, *_u);
-  return tchecker::refzg::sync_alu_le(n1.state(), n2.state(), *_l, *_u);
+  tchecker::clockbounds::map_t const * l = nullptr;
+  tchecker::clockbounds::map_t const * u = nullptr;
+  _lu_table->bounds(n2.state().vloc(), l, u);
+  return tchecker::refzg::sync_alu_le(n1.state(), n2.state(), *l, *u);
 }
 
 /* edge_t */
@@ -179,25 +148,32 @@ std::ostream & dot_output(std::ostream & os, tchecker::tck_reach::concur19::grap
 /* run */
 
 std::tuple<tchecker::algorithms::covreach::stats_t, std::shared_ptr<tchecker::tck_reach::concur19::graph_t>>
-run(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, std::string const & labels,
-    std::string const & search_order, std::size_t block_size, std::size_t table_size)
+run(std::shared_ptr<tchecker::ta::system_t const> const & system, std::string const & labels,
+    std::string const & search_order, std::size_t block_size, std::size_t table_size,
+    std::shared_ptr<tchecker::profiler_t> const & profiler,
+    std::shared_ptr<tchecker::algorithms::progress_t> const & progress)
 {
-  std::shared_ptr<tchecker::ta::system_t const> system{new tchecker::ta::system_t{*sysdecl}};
-
+  tchecker::profiler_t::phase_t zone_graph_phase{profiler.get(), "ZONE_GRAPH"};
   std::shared_ptr<tchecker::refzg::refzg_t> refzg{tchecker::refzg::factory(system, tchecker::refzg::PROCESS_REFERENCE_CLOCKS,
                                                                            tchecker::refzg::ELAPSED_SEMANTICS,
                                                                            tchecker::refdbm::UNBOUNDED_SPREAD, block_size)};
+  zone_graph_phase.stop();
 
+  tchecker::profiler_t::phase_t graph_phase{profiler.get(), "GRAPH"};
   std::shared_ptr<tchecker::tck_reach::concur19::graph_t> graph{
       new tchecker::tck_reach::concur19::graph_t{refzg, block_size, table_size}};
 
   boost::dynamic_bitset<> accepting_labels = system->as_syncprod_system().labels(labels);
 
   tchecker::tck_reach::concur19::algorithm_t algorithm;
+  algorithm.set_progress(progress);
 
   enum tchecker::waiting::policy_t policy = tchecker::algorithms::fast_remove_waiting_policy(search_order);
+  graph_phase.stop();
 
+  tchecker::profiler_t::phase_t exploration_phase{profiler.get(), "EXPLORATION"};
   tchecker::algorithms::covreach::stats_t stats = algorithm.run(*refzg, *graph, accepting_labels, policy);
+  exploration_phase.stop();
 
   return std::make_tuple(stats, graph);
 }
@@ -13,6 +13,7 @@
 
 #include "tchecker/algorithms/covreach/algorithm.hh"
 #include "tchecker/algorithms/covreach/stats.hh"
+#include "tchecker/algorithms/progress.hh"
 #include "tchecker/clockbounds/clockbounds.hh"
 #include "tchecker/clockbounds/solver.hh"
 #include "tchecker/graph/output.hh"
@@ -21,6 +22,7 @@
 #include "tchecker/refzg/state.hh"
 #include "tchecker/refzg/transition.hh"
 #include "tchecker/ta/system.hh"
+#include "tchecker/utils/profiler.hh"
 #include "tchecker/waiting/waiting.hh"
 
 /*!
@@ -113,6 +115,7 @@ public:
 
   /*!
   \brief Copy constructor
+  \note the copy shares the memoised local LU maps of node_le
   */
   node_le_t(tchecker::tck_reach::concur19::node_le_t const & node_le);
 
@@ -146,9 +149,8 @@ public:
   bool operator()(tchecker::tck_reach::concur19::node_t const & n1, tchecker::tck_reach::concur19::node_t const & n2) const;
 
 private:
-  std::shared_ptr<tchecker::clockbounds::clockbounds_t> _clockbounds; /*!< Clock bounds */
-  tchecker::clockbounds::map_t * _l;                                  /*!< Clock lower bounds */
-  tchecker::clockbounds::map_t * _u;                                  /*!< Clock upper bounds */
+  std::shared_ptr<tchecker::clockbounds::clockbounds_t> _clockbounds;   /*!< Clock bounds */
+  std::shared_ptr<tchecker::clockbounds::local_lu_table_t> _lu_table; /*!< Local LU maps memoised per tuple of locations */
 };
 
 /*!
@@ -251,17 +253,21 @@ public:
 /*!
  \brief Run covering reachability algorithm on the local-time zone graph of a
  system
- \param sysdecl : system declaration
+ \param system : system of timed processes
  \param labels : comma-separated string of labels
  \param search_order : search order
  \param block_size : number of elements allocated in one block
- \pre labels must appear as node attributes in sysdecl
+ \param profiler : profiler of the phases of the run (nullptr if the run should not be profiled)
+ \param progress : progress reports of the exploration (nullptr if progress should not be reported)
+ \pre labels must appear as node attributes in system
  search_order must be either "dfs" or "bfs"
  \return statistics on the run and the covering reachability graph
  */
 std::tuple<tchecker::algorithms::covreach::stats_t, std::shared_ptr<tchecker::tck_reach::concur19::graph_t>>
-run(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, std::string const & labels = "",
-    std::string const & search_order = "bfs", std::size_t block_size = 10000, std::size_t table_size = 65536);
+run(std::shared_ptr<tchecker::ta::system_t const> const & system, std::string const & labels = "",
+    std::string const & search_order = "bfs", std::size_t block_size = 10000, std::size_t table_size = 65536,
+    std::shared_ptr<tchecker::profiler_t> const & profiler = nullptr,
+    std::shared_ptr<tchecker::algorithms::progress_t> const & progress = nullptr);
 
 } // end of namespace concur19
 
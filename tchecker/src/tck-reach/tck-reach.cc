@@ -10,12 +10,18 @@
 #include <iostream>
 #include <map>
 #include <memory>
+#include <sstream>
 #include <string>
 
+#include "concur19-gsim.hh"
 #include "concur19.hh"
+#include "tchecker/algorithms/progress.hh"
 #include "tchecker/algorithms/reach/algorithm.hh"
+#include "tchecker/clockbounds/cache.hh"
 #include "tchecker/parsing/parsing.hh"
+#include "tchecker/ta/compiled_system.hh"
 #include "tchecker/utils/log.hh"
+#include "tchecker/utils/profiler.hh"
 #include "zg-covreach.hh"
 #include "zg-reach.hh"
 #include "zg-gsim.hh"
@@ -36,6 +42,17 @@ static struct option long_options[] = {{"algorithm", required_argument, 0, 'a'},
                                        {"search-order", no_argument, 0, 's'},
                                        {"block-size", required_argument, 0, 0},
                                        {"table-size", required_argument, 0, 0},
+                                       {"por", no_argument, 0, 0},
+                                       {"symmetry", no_argument, 0, 0},
+                                       {"clock-liveness", no_argument, 0, 0},
+                                       {"extrapolation", no_argument, 0, 0},
+                                       {"amap-threads", required_argument, 0, 0},
+                                       {"cache-dir", required_argument, 0, 0},
+                                       {"compiled", no_argument, 0, 0},
+                                       {"profile", no_argument, 0, 0},
+                                       {"json", no_argument, 0, 0},
+                                       {"progress", required_argument, 0, 0},
+                                       {"zone-storage", required_argument, 0, 0},
                                        {0, 0, 0, 0}};
 
 static char const * const options = (char *)"a:C:hl:s:";
@@ -50,28 +67,59 @@ void usage(char * progname)
   std::cerr << "   -a algorithm  reachability algorithm" << std::endl;
   std::cerr << "          reach:     standard reachability algorithm over the zone graph" << std::endl;
   std::cerr << "          concur19:  reachability algorithm with covering over the local-time zone graph" << std::endl;
+  std::cerr << "          concur19_gsim:  reachability algorithm with G-simulation over the local-time zone graph"
+            << std::endl;
   std::cerr << "          covreach:  reachability algorithm with covering over the zone graph" << std::endl;
   std::cerr << "          alu:       reachability algorithm with LU-simulation over the zone graph" << std::endl;
   std::cerr << "          gsim:      reachability algorithm with g-simulation over the zone graph" << std::endl;
   std::cerr << "          gta_gsim:      reachability algorithm for General Timed Automata with G-simulation over the zone graph" << std::endl; 
+  std::cerr << "          gta_reach:     standard reachability algorithm for General Timed Automata over the zone graph"
+            << " extrapolated w.r.t. the reduced A-map (prophecy clocks and diagonal constraints are kept exact, so"
+            << " such systems are rejected as exploration may not terminate, use gta_gsim instead)" << std::endl;
   std::cerr << "   -C out_file   output a certificate (as a graph) in out_file" << std::endl;
   std::cerr << "   -h            help" << std::endl;
   std::cerr << "   -l l1,l2,...  comma-separated list of searched labels" << std::endl;
   std::cerr << "   -s bfs|dfs    search order" << std::endl;
   std::cerr << "   --block-size  size of allocation blocks" << std::endl;
   std::cerr << "   --table-size  size of hash tables" << std::endl;
+  std::cerr << "   --por         partial-order reduction (covreach, alu, gsim and gta_gsim only)" << std::endl;
+  std::cerr << "   --symmetry    symmetry reduction (covreach, alu, gsim and gta_gsim only)" << std::endl;
+  std::cerr << "   --clock-liveness  normalise inactive history clocks (gta_gsim and gta_reach only)" << std::endl;
+  std::cerr << "   --extrapolation   extrapolate zones w.r.t. the reduced A-map before G-simulation checks (gta_gsim only)"
+            << std::endl;
+  std::cerr << "   --amap-threads N  number of threads used to compute reduced A-maps (gsim, gta_gsim, gta_reach and"
+            << " concur19_gsim only)" << std::endl;
+  std::cerr << "   --cache-dir DIR   load/store clock bounds and reduced A-maps in DIR (alu, gsim, gta_gsim, gta_reach and"
+            << " concur19_gsim only)"
+            << std::endl;
+  std::cerr << "   --compiled    file is a compiled model (see tck-compile)" << std::endl;
+  std::cerr << "   --profile     output wall time, CPU time (seconds) and growth of the peak memory (kilobytes) of each phase,"
+            << " and the peak memory of the run" << std::endl;
+  std::cerr << "   --json        output statistics as a JSON object" << std::endl;
+  std::cerr << "   --progress SECONDS  report progress of the exploration every SECONDS seconds on standard error"
+            << std::endl;
+  std::cerr << "   --zone-storage full|compact|reduced  storage of the zones of visited nodes (all algorithms but concur19 and concur19_gsim),"
+            << " statistics on the storage of zones are output when this option or --profile is given"
+            << std::endl;
+  std::cerr << "          full:      DBMs" << std::endl;
+  std::cerr << "          compact:   DBMs with 16-bit bounds when constants are small enough, full otherwise (default)"
+            << std::endl;
+  std::cerr << "          reduced:   minimal constraint graphs, expanded to DBMs when needed (saves memory, costs time)"
+            << std::endl;
   std::cerr << "reads from standard input if file is not provided" << std::endl;
 }
 
 enum algorithm_t {
   ALGO_REACH,    /*!< Reachability algorithm */
   ALGO_CONCUR19, /*!< Covering reachability algorithm over the local-time zone graph */
+  ALGO_CONCUR19_GSIM, /*!< Covering reachability algorithm with G-simulation over the local-time zone graph */
   ALGO_COVREACH, /*!< Covering reachability algorithm */
   ALGO_LU,       /*!< Covering reachability algorithm with LU-simulation */
   ALGO_GSIM,     /*!< Covering reachability algorithm with G-simulation */
   ALGO_ECA_GSIM,     /*!< Covering reachability algorithm on ECA with G-simulation */ 
   ALGO_ECA_GSIM_GEN,     /*!< Covering reachability algorithm on ECA with G-simulation */ 
   ALGO_ECA_NEW,     /*!< Covering reachability algorithm on ECA with G-simulation */ 
+  ALGO_ECA_REACH,   /*!< Reachability algorithm on ECA with extrapolation */
   ALGO_NONE,     /*!< No algorithm */
 };
 
@@ -82,14 +130,28 @@ static std::string search_order = "bfs";       /*!< Search order */
 static std::string labels = "";                /*!< Searched labels */
 static std::size_t block_size = 10000;         /*!< Size of allocated blocks */
 static std::size_t table_size = 65536;         /*!< Size of hash tables */
+static bool por = false;                       /*!< Partial-order reduction flag */
+static bool symmetry = false;                  /*!< Symmetry reduction flag */
+static bool clock_liveness = false;            /*!< Inactive clocks normalisation flag */
+static bool extrapolation = false;             /*!< Extrapolation flag (gta_gsim) */
+static unsigned int amap_threads = 1;          /*!< Number of threads for reduced A-maps */
+static std::string cache_dir = "";             /*!< Cache directory */
+static std::shared_ptr<tchecker::clockbounds::cache_t const> cache{nullptr}; /*!< Cache of clock bounds */
+static bool compiled = false;                  /*!< Compiled model flag */
+static bool json = false;                      /*!< JSON output flag */
+static std::shared_ptr<tchecker::profiler_t> profiler{nullptr}; /*!< Profiler of the phases of the run */
+static std::shared_ptr<tchecker::algorithms::progress_t> progress{nullptr}; /*!< Progress reports of the exploration */
+static enum tchecker::zg::zone_storage_t zone_storage = tchecker::zg::ZONE_COMPACT; /*!< Storage of zones */
+static bool zone_storage_set = false;          /*!< Flag: zone storage given on the command line */
 
 /*!
  \brief Parse command-line arguments
  \param argc : number of arguments
  \param argv : array of arguments
  \pre argv[0] up to argv[argc-1] are valid accesses
- \post global variables help, output_file, search_order and labels have been set
- from argv
+ \post global variables help, output_file, search_order, labels, por, symmetry,
+ clock_liveness, extrapolation, amap_threads, cache_dir, compiled, json, profiler, progress and
+ zone_storage (and zone_storage_set) have been set from argv
 */
 int parse_command_line(int argc, char * argv[])
 {
@@ -111,6 +173,8 @@ int parse_command_line(int argc, char * argv[])
           algorithm = ALGO_REACH;
         else if (strcmp(optarg, "concur19") == 0)
           algorithm = ALGO_CONCUR19;
+        else if (strcmp(optarg, "concur19_gsim") == 0)
+          algorithm = ALGO_CONCUR19_GSIM;
         else if (strcmp(optarg, "covreach") == 0)
           algorithm = ALGO_COVREACH;
         else if (strcmp(optarg, "alu") == 0)
@@ -119,6 +183,8 @@ int parse_command_line(int argc, char * argv[])
           algorithm = ALGO_GSIM;
         else if (strcmp(optarg, "gta_gsim") == 0) 
           algorithm = ALGO_ECA_GSIM_GEN;  
+        else if (strcmp(optarg, "gta_reach") == 0)
+          algorithm = ALGO_ECA_REACH;
         else
           throw std::runtime_error("Unknown algorithm: " + std::string(optarg));
         break;
@@ -144,6 +210,44 @@ int parse_command_line(int argc, char * argv[])
         block_size = std::strtoull(optarg, nullptr, 10);
       else if (strcmp(long_options[long_option_index].name, "table-size") == 0)
         table_size = std::strtoull(optarg, nullptr, 10);
+      else if (strcmp(long_options[long_option_index].name, "por") == 0)
+        por = true;
+      else if (strcmp(long_options[long_option_index].name, "symmetry") == 0)
+        symmetry = true;
+      else if (strcmp(long_options[long_option_index].name, "clock-liveness") == 0)
+        clock_liveness = true;
+      else if (strcmp(long_options[long_option_index].name, "extrapolation") == 0)
+        extrapolation = true;
+      else if (strcmp(long_options[long_option_index].name, "amap-threads") == 0) {
+        amap_threads = static_cast<unsigned int>(std::strtoul(optarg, nullptr, 10));
+        if (amap_threads == 0)
+          throw std::runtime_error("Invalid number of threads: " + std::string(optarg));
+      }
+      else if (strcmp(long_options[long_option_index].name, "cache-dir") == 0)
+        cache_dir = optarg;
+      else if (strcmp(long_options[long_option_index].name, "compiled") == 0)
+        compiled = true;
+      else if (strcmp(long_options[long_option_index].name, "profile") == 0)
+        profiler = std::make_shared<tchecker::profiler_t>();
+      else if (strcmp(long_options[long_option_index].name, "json") == 0)
+        json = true;
+      else if (strcmp(long_options[long_option_index].name, "progress") == 0) {
+        double period = std::strtod(optarg, nullptr);
+        if (period <= 0)
+          throw std::runtime_error("Invalid progress period: " + std::string(optarg));
+        progress = std::make_shared<tchecker::algorithms::progress_t>(std::cerr, period);
+      }
+      else if (strcmp(long_options[long_option_index].name, "zone-storage") == 0) {
+        zone_storage_set = true;
+        if (strcmp(optarg, "full") == 0)
+          zone_storage = tchecker::zg::ZONE_FULL;
+        else if (strcmp(optarg, "compact") == 0)
+          zone_storage = tchecker::zg::ZONE_COMPACT;
+        else if (strcmp(optarg, "reduced") == 0)
+          zone_storage = tchecker::zg::ZONE_REDUCED;
+        else
+          throw std::runtime_error("Unknown zone storage: " + std::string(optarg));
+      }
       else
         throw std::runtime_error("This also should never be executed");
     }
@@ -173,130 +277,272 @@ tchecker::parsing::system_declaration_t * load_system_declaration(std::string co
   return sysdecl;
 }
 
+/*!
+ \brief Load a system of timed processes from a file
+ \param filename : file name
+ \return pointer to the system of timed processes in filename, which is a
+ compiled model if compiled is set and a system declaration otherwise, nullptr
+ in case of errors
+ \post all errors have been reported to std::cerr
+*/
+tchecker::ta::system_t * load_system(std::string const & filename)
+{
+  if (!compiled) {
+    tchecker::profiler_t::phase_t parse_phase{profiler.get(), "PARSE"};
+    std::unique_ptr<tchecker::parsing::system_declaration_t> sysdecl{load_system_declaration(filename)};
+    parse_phase.stop();
+    if (sysdecl == nullptr || tchecker::log_error_count() > 0)
+      return nullptr;
+    tchecker::profiler_t::phase_t system_phase{profiler.get(), "SYSTEM"};
+    return new tchecker::ta::system_t{*sysdecl};
+  }
+
+  tchecker::profiler_t::phase_t load_phase{profiler.get(), "LOAD"};
+  tchecker::ta::system_t * system = nullptr;
+  try {
+    system = tchecker::ta::load_compiled_system(filename);
+  }
+  catch (std::exception const & e) {
+    std::cerr << tchecker::log_error << e.what() << std::endl;
+  }
+  return system;
+}
+
+/*!
+ \brief Output a string as a JSON string
+ \param os : output stream
+ \param str : a string
+ \post str has been output to os between double quotes, with special characters
+ escaped
+ */
+static void output_json_string(std::ostream & os, std::string const & str)
+{
+  os << '"';
+  for (char c : str) {
+    if (c == '"' || c == '\\')
+      os << '\\' << c;
+    else if (c == '\n')
+      os << "\\n";
+    else if (c == '\t')
+      os << "\\t";
+    else
+      os << c;
+  }
+  os << '"';
+}
+
+/*!
+ \brief Output statistics
+ \param m : statistics (key, value)
+ \post the profile of the run, if any, has been added to m, and m has been
+ output to standard output: one "key value" line per statistic, or a JSON
+ object if json is set
+ */
+static void output_stats(std::map<std::string, std::string> & m)
+{
+  if (profiler != nullptr)
+    profiler->attributes(m);
+
+  if (!json) {
+    for (auto && [key, value] : m)
+      std::cout << key << " " << value << std::endl;
+    return;
+  }
+
+  std::cout << "{";
+  for (auto it = m.begin(); it != m.end(); ++it) {
+    if (it != m.begin())
+      std::cout << ",";
+    std::cout << std::endl << "  ";
+    output_json_string(std::cout, it->first);
+    std::cout << ": ";
+    output_json_string(std::cout, it->second);
+  }
+  std::cout << std::endl << "}" << std::endl;
+}
+
+/*!
+ \brief Extract statistics on the storage of zones
+ \param zg : zone graph
+ \param m : statistics (key, value)
+ \post the storage of zones used by zg, and the statistics on the storage of the
+ zones computed by zg have been added to m if --zone-storage or --profile has
+ been given on the command line, m is unchanged otherwise
+ \note the sizes of the zones depend on the allocator, hence they are not output
+ by default to keep outputs comparable across runs
+ */
+static void zone_storage_attributes(tchecker::zg::zg_t const & zg, std::map<std::string, std::string> & m)
+{
+  if (!zone_storage_set && profiler == nullptr)
+    return;
+  m["ZONE_STORAGE"] = tchecker::zg::to_string(zg.zone_storage());
+  zg.zone_storage_stats().attributes(m);
+}
+
 /*!
  \brief Perform reachability analysis
- \param sysdecl : system declaration
+ \param system : system of timed processes
  \post statistics on reachability analysis of command-line specified labels in
- the system declared by sysdecl have been output to standard output.
+ system have been output to standard output.
  A certification has been output if required.
 */
-void reach(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl)
+void reach(std::shared_ptr<tchecker::ta::system_t const> const & system)
 {
-  auto && [stats, graph] = tchecker::tck_reach::zg_reach::run(sysdecl, labels, search_order, block_size, table_size);
+  auto && [stats, graph] = tchecker::tck_reach::zg_reach::run(system, labels, search_order, block_size, table_size, zone_storage,
+                                                                profiler, progress);
 
   // stats
   std::map<std::string, std::string> m;
   stats.attributes(m);
-  for (auto && [key, value] : m)
-    std::cout << key << " " << value << std::endl;
+  zone_storage_attributes(graph->zg(), m);
+  output_stats(m);
 
   // graph
   if (output_file != "") {
     std::ofstream ofs{output_file};
-    tchecker::tck_reach::zg_reach::dot_output(ofs, *graph, sysdecl->name());
+    tchecker::tck_reach::zg_reach::dot_output(ofs, *graph, system->name());
     ofs.close();
   }
 }
 
 /*!
  \brief Perform covering reachability analysis over the local-time zone graph
- \param sysdecl : system declaration
+ \param system : system of timed processes
  \post statistics on covering reachability analysis of command-line specified
- labels in the system declared by sysdecl have been output to standard output.
+ labels in system have been output to standard output.
  A certification has been output if required.
  \note This is the algorithm presented in R. Govind, Frédéric Herbreteau, B.
  Srivathsan, Igor Walukiewicz: "Revisiting Local Time Semantics for Networks of
  Timed Automata". CONCUR 2019: 16:1-16:15
 */
-void concur19(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl)
+void concur19(std::shared_ptr<tchecker::ta::system_t const> const & system)
 {
-  auto && [stats, graph] = tchecker::tck_reach::concur19::run(sysdecl, labels, search_order, block_size, table_size);
+  auto && [stats, graph] = tchecker::tck_reach::concur19::run(system, labels, search_order, block_size, table_size, profiler, progress);
 
   // stats
   std::map<std::string, std::string> m;
   stats.attributes(m);
-  for (auto && [key, value] : m)
-    std::cout << key << " " << value << std::endl;
+  output_stats(m);
 
   // graph
   if (output_file != "") {
     std::ofstream ofs{output_file};
-    tchecker::tck_reach::concur19::dot_output(ofs, *graph, sysdecl->name());
+    tchecker::tck_reach::concur19::dot_output(ofs, *graph, system->name());
+    ofs.close();
+  }
+}
+
+/*!
+ \brief Perform covering reachability analysis with G-simulation over the
+ local-time zone graph
+ \param system : system of timed processes
+ \post statistics on covering reachability analysis of command-line specified
+ labels in system have been output to standard output.
+ A certification has been output if required.
+ \note This is the algorithm of concur19 where sync-subsumption is checked
+ w.r.t. the G-simulation induced by the reduced A-map instead of aLU
+*/
+void concur19_gsim(std::shared_ptr<tchecker::ta::system_t const> const & system)
+{
+  auto && [stats, graph] = tchecker::tck_reach::concur19_gsim::run(system, labels, search_order, block_size, table_size,
+                                                                   amap_threads, cache, profiler, progress);
+
+  // stats
+  std::map<std::string, std::string> m;
+  stats.attributes(m);
+  graph->amap().fixpoint_stats().attributes(m);
+  if (cache != nullptr)
+    cache->attributes(m);
+  output_stats(m);
+
+  // graph
+  if (output_file != "") {
+    std::ofstream ofs{output_file};
+    tchecker::tck_reach::concur19_gsim::dot_output(ofs, *graph, system->name());
     ofs.close();
   }
 }
 
 /*!
  \brief Perform covering reachability analysis
- \param sysdecl : system declaration
+ \param system : system of timed processes
  \post statistics on covering reachability analysis of command-line specified
- labels in the system declared by sysdecl have been output to standard output.
+ labels in system have been output to standard output.
  A certification has been output if required.
 */
-void covreach(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl)
+void covreach(std::shared_ptr<tchecker::ta::system_t const> const & system)
 {
-  auto && [stats, graph] = tchecker::tck_reach::zg_covreach::run(sysdecl, labels, search_order, block_size, table_size);
+  auto && [stats, graph] = tchecker::tck_reach::zg_covreach::run(system, labels, search_order, block_size, table_size, por,
+                                                                     symmetry, zone_storage, profiler, progress);
 
   // stats
   std::map<std::string, std::string> m;
   stats.attributes(m);
-  for (auto && [key, value] : m)
-    std::cout << key << " " << value << std::endl;
+  zone_storage_attributes(graph->zg(), m);
+  output_stats(m);
 
   // graph
   if (output_file != "") {
     std::ofstream ofs{output_file};
-    tchecker::tck_reach::zg_covreach::dot_output(ofs, *graph, sysdecl->name());
+    tchecker::tck_reach::zg_covreach::dot_output(ofs, *graph, system->name());
     ofs.close();
   }
 }
 
 /*!
  \brief Perform covering reachability analysis with LU-simulation
- \param sysdecl : system declaration
+ \param system : system of timed processes
  \post statistics on covering reachability analysis of command-line specified
- labels in the system declared by sysdecl have been output to standard output.
+ labels in system have been output to standard output.
  A certification has been output if required.
 */
-void alu(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl)
+void alu(std::shared_ptr<tchecker::ta::system_t const> const & system)
 {
-  auto && [stats, graph] = tchecker::tck_reach::zg_lu::run(sysdecl, labels, search_order, block_size, table_size);
+  auto && [stats, graph] = tchecker::tck_reach::zg_lu::run(system, labels, search_order, block_size, table_size, por,
+                                                                     symmetry, zone_storage, cache, profiler, progress);
 
   // stats
   std::map<std::string, std::string> m;
   stats.attributes(m);
-  for (auto && [key, value] : m)
-    std::cout << key << " " << value << std::endl;
+  zone_storage_attributes(graph->zg(), m);
+  if (cache != nullptr)
+    cache->attributes(m);
+  output_stats(m);
 
   // graph
   if (output_file != "") {
     std::ofstream ofs{output_file};
-    tchecker::tck_reach::zg_lu::dot_output(ofs, *graph, sysdecl->name());
+    tchecker::tck_reach::zg_lu::dot_output(ofs, *graph, system->name());
     ofs.close();
   }
 }
 
 /*!
  \brief Perform covering reachability analysis with G-simulation
- \param sysdecl : system declaration
+ \param system : system of timed processes
  \post statistics on covering reachability analysis of command-line specified
- labels in the system declared by sysdecl have been output to standard output.
+ labels in system have been output to standard output.
  A certification has been output if required.
 */
-void gsim(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl)
+void gsim(std::shared_ptr<tchecker::ta::system_t const> const & system)
 {
-  auto && [stats, graph] = tchecker::tck_reach::zg_gsim::run(sysdecl, labels, search_order, block_size, table_size);
+  auto && [stats, graph] = tchecker::tck_reach::zg_gsim::run(system, labels, search_order, block_size, table_size, por,
+                                                                     symmetry, zone_storage, amap_threads, cache, profiler,
+                                                                     progress);
 
   // stats
   std::map<std::string, std::string> m;
   stats.attributes(m);
-  for (auto && [key, value] : m)
-    std::cout << key << " " << value << std::endl;
+  zone_storage_attributes(graph->zg(), m);
+  graph->amap().fixpoint_stats().attributes(m);
+  if (cache != nullptr)
+    cache->attributes(m);
+  output_stats(m);
 
   // graph
   if (output_file != "") {
     std::ofstream ofs{output_file};
-    tchecker::tck_reach::zg_gsim::dot_output(ofs, *graph, sysdecl->name());
+    tchecker::tck_reach::zg_gsim::dot_output(ofs, *graph, system->name());
     ofs.close();
   }
 }
@@ -304,26 +550,62 @@ void gsim(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysde
 
 /*!
  \brief Perform covering reachability analysis with G-simulation for GENERAL MODEL ECA
- \param sysdecl : system declaration
+ \param system : system of timed processes
  \post statistics on covering reachability analysis of command-line specified
- labels in the system declared by sysdecl have been output to standard output.
+ labels in system have been output to standard output.
  A certification has been output if required.
 */
-void eca_gsim_gen(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl)
+void eca_gsim_gen(std::shared_ptr<tchecker::ta::system_t const> const & system)
 {
   
-  auto && [stats, graph] = tchecker::tck_reach::zg_eca_gsim_gen::run(sysdecl, labels, search_order, block_size, table_size);
+  auto && [stats, graph] = tchecker::tck_reach::zg_eca_gsim_gen::run(system, labels, search_order, block_size, table_size, por,
+                                                                     symmetry, zone_storage, clock_liveness, extrapolation,
+                                                                     amap_threads, cache,
+                                                                     profiler, progress);
   
   // stats
   std::map<std::string, std::string> m;
   stats.attributes(m);
-  for (auto && [key, value] : m)
-    std::cout << key << " " << value << std::endl;
+  zone_storage_attributes(graph->zg(), m);
+  graph->amap().fixpoint_stats().attributes(m);
+  if (cache != nullptr)
+    cache->attributes(m);
+  output_stats(m);
+
+  // graph
+  if (output_file != "") {
+    std::ofstream ofs{output_file};
+    tchecker::tck_reach::zg_eca_gsim_gen::dot_output(ofs, *graph, system->name());
+    ofs.close();
+  }
+}
+
+/*!
+ \brief Perform reachability analysis over the zone graph of General Timed
+ Automata extrapolated w.r.t. the reduced A-map
+ \param system : system of timed processes
+ \post statistics on reachability analysis of command-line specified labels in
+ system have been output to standard output.
+ A certification has been output if required.
+*/
+void eca_reach(std::shared_ptr<tchecker::ta::system_t const> const & system)
+{
+  auto && [stats, graph] = tchecker::tck_reach::zg_reach::run_gta(system, labels, search_order, block_size, table_size,
+                                                                  zone_storage, clock_liveness, amap_threads, cache,
+                                                                  profiler, progress);
+
+  // stats
+  std::map<std::string, std::string> m;
+  stats.attributes(m);
+  zone_storage_attributes(graph->zg(), m);
+  if (cache != nullptr)
+    cache->attributes(m);
+  output_stats(m);
 
   // graph
   if (output_file != "") {
     std::ofstream ofs{output_file};
-    tchecker::tck_reach::zg_eca_gsim_gen::dot_output(ofs, *graph, sysdecl->name());
+    tchecker::tck_reach::zg_reach::dot_output(ofs, *graph, system->name());
     ofs.close();
   }
 }
@@ -349,30 +631,63 @@ int main(int argc, char * argv[])
 
     std::string input_file = (optindex == argc ? "" : argv[optindex]);
 
-    std::shared_ptr<tchecker::parsing::system_declaration_t> sysdecl{load_system_declaration(input_file)};
-    // std::cout << "system parsed: \n" << *sysdecl  << std::endl << "System parsing error count: "<< tchecker::log_error_count() << std::endl;
-    // exit(1);
-    if (tchecker::log_error_count() > 0)
+    if (compiled && input_file == "")
+      throw std::runtime_error("Compiled models must be read from a file");
+
+    std::shared_ptr<tchecker::ta::system_t const> system{load_system(input_file)};
+    if (system == nullptr || tchecker::log_error_count() > 0)
       return EXIT_FAILURE;
 
+    if (por && (algorithm == ALGO_REACH || algorithm == ALGO_CONCUR19 || algorithm == ALGO_CONCUR19_GSIM ||
+                algorithm == ALGO_ECA_REACH))
+      throw std::runtime_error("Partial-order reduction is not supported by this algorithm");
+
+    if (symmetry && (algorithm == ALGO_REACH || algorithm == ALGO_CONCUR19 || algorithm == ALGO_CONCUR19_GSIM ||
+                     algorithm == ALGO_ECA_REACH))
+      throw std::runtime_error("Symmetry reduction is not supported by this algorithm");
+
+    if (clock_liveness && algorithm != ALGO_ECA_GSIM_GEN && algorithm != ALGO_ECA_REACH)
+      throw std::runtime_error("Normalisation of inactive clocks is only supported by algorithms gta_gsim and gta_reach");
+
+    if (extrapolation && algorithm != ALGO_ECA_GSIM_GEN)
+      throw std::runtime_error("Extrapolation is only an option of algorithm gta_gsim");
+
+    if (cache_dir != "") {
+      if (algorithm != ALGO_LU && algorithm != ALGO_GSIM && algorithm != ALGO_ECA_GSIM_GEN &&
+          algorithm != ALGO_ECA_REACH && algorithm != ALGO_CONCUR19_GSIM)
+        throw std::runtime_error("Caching is only supported by algorithms alu, gsim, gta_gsim, gta_reach and concur19_gsim");
+      if (input_file == "")
+        throw std::runtime_error("Caching requires an input file");
+      std::ifstream ifs{input_file, std::ios::binary};
+      std::stringstream model;
+      model << ifs.rdbuf();
+      cache = std::make_shared<tchecker::clockbounds::cache_t const>(cache_dir, model.str());
+    }
+
     switch (algorithm) {
     case ALGO_REACH:
-      reach(sysdecl);
+      reach(system);
       break;
     case ALGO_CONCUR19:
-      concur19(sysdecl);
+      concur19(system);
+      break;
+    case ALGO_CONCUR19_GSIM:
+      concur19_gsim(system);
       break;
     case ALGO_COVREACH:
-      covreach(sysdecl);
+      covreach(system);
       break;
     case ALGO_LU:
-      alu(sysdecl);
+      alu(system);
       break;
     case ALGO_GSIM:
-      gsim(sysdecl);
+      gsim(system);
       break;
     case ALGO_ECA_GSIM_GEN:
-      eca_gsim_gen(sysdecl);
+      eca_gsim_gen(system);
+      break;
+    case ALGO_ECA_REACH:
+      eca_reach(system);
       break;
     default:
       throw std::runtime_error("No algorithm specified");
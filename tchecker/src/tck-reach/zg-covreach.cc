@@ -124,24 +124,39 @@ std::ostream & dot_output(std::ostream & os, tchecker::tck_reach::zg_covreach::g
 /* run */
 
 std::tuple<tchecker::algorithms::covreach::stats_t, std::shared_ptr<tchecker::tck_reach::zg_covreach::graph_t>>
-run(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, std::string const & labels,
-    std::string const & search_order, std::size_t block_size, std::size_t table_size)
+run(std::shared_ptr<tchecker::ta::system_t const> const & system, std::string const & labels,
+    std::string const & search_order, std::size_t block_size, std::size_t table_size, bool por,
+    bool symmetry, enum tchecker::zg::zone_storage_t zone_storage,
+    std::shared_ptr<tchecker::profiler_t> const & profiler,
+    std::shared_ptr<tchecker::algorithms::progress_t> const & progress)
 {
-  std::shared_ptr<tchecker::ta::system_t const> system{new tchecker::ta::system_t{*sysdecl}};
-
+  tchecker::profiler_t::phase_t zone_graph_phase{profiler.get(), "ZONE_GRAPH"};
   std::shared_ptr<tchecker::zg::zg_t> zg{
       tchecker::zg::factory(system, tchecker::zg::ELAPSED_SEMANTICS, tchecker::zg::EXTRA_LU_PLUS_LOCAL, block_size)};
+  if (!symmetry && (zone_storage != tchecker::zg::ZONE_COMPACT || tchecker::zg::compact_zones_allowed(*system)))
+    zg->set_zone_storage(zone_storage);
+  zone_graph_phase.stop();
 
+  tchecker::profiler_t::phase_t graph_phase{profiler.get(), "GRAPH"};
   std::shared_ptr<tchecker::tck_reach::zg_covreach::graph_t> graph{
       new tchecker::tck_reach::zg_covreach::graph_t{zg, block_size, table_size}};
 
   boost::dynamic_bitset<> accepting_labels = system->as_syncprod_system().labels(labels);
 
-  tchecker::tck_reach::zg_covreach::algorithm_t algorithm;
+  std::shared_ptr<tchecker::ta::independence_t const> independence{
+      por ? new tchecker::ta::independence_t{*system} : nullptr};
+
+  std::shared_ptr<tchecker::ta::symmetry_t const> symmetries{symmetry ? new tchecker::ta::symmetry_t{*system} : nullptr};
+
+  tchecker::tck_reach::zg_covreach::algorithm_t algorithm{independence, symmetries};
+  algorithm.set_progress(progress);
 
   enum tchecker::waiting::policy_t policy = tchecker::algorithms::fast_remove_waiting_policy(search_order);
+  graph_phase.stop();
 
+  tchecker::profiler_t::phase_t exploration_phase{profiler.get(), "EXPLORATION"};
   tchecker::algorithms::covreach::stats_t stats = algorithm.run(*zg, *graph, accepting_labels, policy);
+  exploration_phase.stop();
 
   return std::make_tuple(stats, graph);
 }
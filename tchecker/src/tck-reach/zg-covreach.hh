@@ -14,8 +14,11 @@
 */
 
 #include "tchecker/algorithms/covreach/algorithm.hh"
+#include "tchecker/algorithms/progress.hh"
 #include "tchecker/graph/subsumption_graph.hh"
 #include "tchecker/syncprod/vedge.hh"
+#include "tchecker/ta/system.hh"
+#include "tchecker/utils/profiler.hh"
 #include "tchecker/utils/shared_objects.hh"
 #include "tchecker/waiting/waiting.hh"
 #include "tchecker/zg/state.hh"
@@ -148,6 +151,12 @@ public:
   */
   virtual ~graph_t();
 
+  /*!
+   \brief Accessor
+   \return zone graph
+  */
+  inline tchecker::zg::zg_t const & zg() const { return *_zg; }
+
   using tchecker::graph::subsumption::graph_t<
       tchecker::tck_reach::zg_covreach::node_t, tchecker::tck_reach::zg_covreach::edge_t,
       tchecker::tck_reach::zg_covreach::node_hash_t, tchecker::tck_reach::zg_covreach::node_le_t>::attributes;
@@ -194,17 +203,29 @@ public:
 
 /*!
  \brief Run covering reachability algorithm on the zone graph of a system
- \param sysdecl : system declaration
+ \param system : system of timed processes
  \param labels : comma-separated string of labels
  \param search_order : search order
  \param block_size : number of elements allocated in one block
- \pre labels must appear as node attributes in sysdecl
+ \param table_size : size of hash tables
+ \param por : true if partial-order reduction should be used, false otherwise
+ \param symmetry : true if symmetry reduction should be used, false otherwise
+ \param zone_storage : storage of the zones of computed states (compact zones
+ are only used if the clock bounds of system are small enough, and zones are full
+ with symmetry reduction)
+ \param profiler : profiler of the phases of the run (nullptr if the run should not be profiled)
+ \param progress : progress reports of the exploration (nullptr if progress should not be reported)
+ \pre labels must appear as node attributes in system
  search_order must be either "dfs" or "bfs"
  \return statistics on the run and the covering reachability graph
  */
 std::tuple<tchecker::algorithms::covreach::stats_t, std::shared_ptr<tchecker::tck_reach::zg_covreach::graph_t>>
-run(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, std::string const & labels = "",
-    std::string const & search_order = "bfs", std::size_t block_size = 10000, std::size_t table_size = 65536);
+run(std::shared_ptr<tchecker::ta::system_t const> const & system, std::string const & labels = "",
+    std::string const & search_order = "bfs", std::size_t block_size = 10000, std::size_t table_size = 65536,
+    bool por = false, bool symmetry = false,
+    enum tchecker::zg::zone_storage_t zone_storage = tchecker::zg::ZONE_COMPACT,
+    std::shared_ptr<tchecker::profiler_t> const & profiler = nullptr,
+    std::shared_ptr<tchecker::algorithms::progress_t> const & progress = nullptr);
 
 } // end of namespace zg_covreach
 
@@ -5,6 +5,8 @@
  *
  */
 
+#include <stdexcept>
+
 #include <boost/dynamic_bitset.hpp>
 
 #include "tchecker/algorithms/search_order.hh"
@@ -43,6 +45,14 @@ node_le_t::node_le_t(tchecker::eca_amap_gen2::eca_a_map_t const & amap) : _amap(
 {}//ani:-100
 
 
+node_le_t::node_le_t(tchecker::eca_amap_gen2::eca_a_map_t const & amap, tchecker::ta::system_t const & system)
+    : _amap(amap), _G(new std::vector<tchecker::typed_diagonal_clkconstr_expression_t const *>()),
+      _Gdf(new std::vector<tchecker::typed_simple_clkconstr_expression_t const *>()),
+      _history_clock_ids(system.history_clock_id_map), _prophecy_clock_ids(system.prophecy_clock_id_map),
+      _normal_clock_ids(system.normal_clock_id_map)
+{
+}
+
 node_le_t::node_le_t(tchecker::ta::system_t const & system) : _amap(*tchecker::eca_amap_gen2::compute_eca_amap(system)),
                                                               _G(new std::vector<tchecker::typed_diagonal_clkconstr_expression_t const *>()),
                                                               _Gdf(new std::vector<tchecker::typed_simple_clkconstr_expression_t const *>()),
@@ -102,13 +112,14 @@ bool node_le_t::operator()(tchecker::tck_reach::zg_eca_gsim_gen::node_t const &
 edge_t::edge_t(tchecker::zg::transition_t const & t) : _vedge(t.vedge_ptr()) {}
 
 /* graph_t */
-graph_t::graph_t(std::shared_ptr<tchecker::zg::zg_t> const & zg, std::size_t block_size, std::size_t table_size)
+graph_t::graph_t(std::shared_ptr<tchecker::zg::zg_t> const & zg, std::shared_ptr<tchecker::eca_amap_gen2::eca_a_map_t const> const & amap,
+                 std::size_t block_size, std::size_t table_size)
     : tchecker::graph::subsumption::graph_t<tchecker::tck_reach::zg_eca_gsim_gen::node_t, tchecker::tck_reach::zg_eca_gsim_gen::edge_t,
                                             tchecker::tck_reach::zg_eca_gsim_gen::node_hash_t,
                                             tchecker::tck_reach::zg_eca_gsim_gen::node_le_t>(
                                                 block_size, table_size, tchecker::tck_reach::zg_eca_gsim_gen::node_hash_t(),
-                                                tchecker::tck_reach::zg_eca_gsim_gen::node_le_t(zg->system())),
-                                            _zg(zg)
+                                                tchecker::tck_reach::zg_eca_gsim_gen::node_le_t(*amap, zg->system())),
+                                            _zg(zg), _amap(amap)
 {}
 
 graph_t::~graph_t()
@@ -180,21 +191,49 @@ std::ostream & dot_output(std::ostream & os, tchecker::tck_reach::zg_eca_gsim_ge
 /* run */
 //ani:-100
 std::tuple<tchecker::algorithms::covreach::stats_t, std::shared_ptr<tchecker::tck_reach::zg_eca_gsim_gen::graph_t>>
-run(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, std::string const & labels,
-    std::string const & search_order, std::size_t block_size, std::size_t table_size)
+run(std::shared_ptr<tchecker::ta::system_t const> const & system, std::string const & labels,
+    std::string const & search_order, std::size_t block_size, std::size_t table_size, bool por,
+    bool symmetry, enum tchecker::zg::zone_storage_t zone_storage, bool clock_liveness, bool extrapolation,
+    unsigned int amap_threads,
+    std::shared_ptr<tchecker::clockbounds::cache_t const> const & cache,
+    std::shared_ptr<tchecker::profiler_t> const & profiler,
+    std::shared_ptr<tchecker::algorithms::progress_t> const & progress)
 {
-  // std::cout << "ani:---10007 constructing system\n"; 
-  std::shared_ptr<tchecker::ta::system_t const> system{new tchecker::ta::system_t{*sysdecl}};
-  
   // exit(0);
   // std::cout << "ani:---10008 constructing zone-graph\n";
-  std::shared_ptr<tchecker::zg::zg_t> zg{
-      tchecker::zg::factory(system, tchecker::zg::eca_gen2_SEMANTICS, tchecker::zg::NO_EXTRAPOLATION, block_size)};
-  
   // std::cout << "ani:---10009 constructing zg_eca_g_sim\n";
   //ani:4 this is the point where lu-bounds G-SIM are computed!
+  tchecker::profiler_t::phase_t amap_phase{profiler.get(), "AMAP"};
+  std::shared_ptr<tchecker::eca_amap_gen2::eca_a_map_t const> amap{cache != nullptr ? cache->load_eca_amap(*system) : nullptr};
+  if (amap == nullptr) {
+    std::shared_ptr<tchecker::eca_amap_gen2::eca_a_map_t const> computed{tchecker::eca_amap_gen2::compute_eca_amap(*system, amap_threads)};
+    if (computed == nullptr)
+      throw std::runtime_error("reduced A-map computation failed");
+    if (cache != nullptr)
+      cache->store_eca_amap(*system, *computed);
+    amap = computed;
+  }
+  amap_phase.stop();
+
+  // NB: the zone graph is built after the reduced A-map since the extrapolation
+  // is computed from the bounds in the reduced A-map
+  tchecker::profiler_t::phase_t zone_graph_phase{profiler.get(), "ZONE_GRAPH"};
+  std::shared_ptr<tchecker::ta::clock_liveness_t const> liveness{
+      clock_liveness ? new tchecker::ta::clock_liveness_t{*system} : nullptr};
+
+  std::shared_ptr<tchecker::zg::zg_t> zg{tchecker::zg::factory(
+      system, tchecker::zg::eca_gen2_SEMANTICS,
+      (extrapolation ? tchecker::zg::EXTRA_LU_PLUS_LOCAL_ECA : tchecker::zg::NO_EXTRAPOLATION), *amap, block_size,
+      liveness)};
+  zone_graph_phase.stop();
+
+  if (!symmetry && (zone_storage != tchecker::zg::ZONE_COMPACT ||
+                    tchecker::zg::compact_zones_allowed(tchecker::eca_amap_gen2::max_constant(*amap))))
+    zg->set_zone_storage(zone_storage);
+
+  tchecker::profiler_t::phase_t graph_phase{profiler.get(), "GRAPH"};
   std::shared_ptr<tchecker::tck_reach::zg_eca_gsim_gen::graph_t> graph{
-      new tchecker::tck_reach::zg_eca_gsim_gen::graph_t{zg, block_size, table_size}};
+      new tchecker::tck_reach::zg_eca_gsim_gen::graph_t{zg, amap, block_size, table_size}};
   
   // std::cout << "ani:-44444 ending amap computation\n";
   // for(auto tmp:system->used_history_clocks_ids){
@@ -203,11 +242,20 @@ run(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, st
   // exit(0);
   boost::dynamic_bitset<> accepting_labels = system->as_syncprod_system().labels(labels);
 
-  tchecker::tck_reach::zg_eca_gsim_gen::algorithm_t algorithm;
+  std::shared_ptr<tchecker::ta::independence_t const> independence{
+      por ? new tchecker::ta::independence_t{*system} : nullptr};
+
+  std::shared_ptr<tchecker::ta::symmetry_t const> symmetries{symmetry ? new tchecker::ta::symmetry_t{*system} : nullptr};
+
+  tchecker::tck_reach::zg_eca_gsim_gen::algorithm_t algorithm{independence, symmetries};
+  algorithm.set_progress(progress);
 
   enum tchecker::waiting::policy_t policy = tchecker::algorithms::fast_remove_waiting_policy(search_order);
+  graph_phase.stop();
 
+  tchecker::profiler_t::phase_t exploration_phase{profiler.get(), "EXPLORATION"};
   tchecker::algorithms::covreach::stats_t stats = algorithm.run(*zg, *graph, accepting_labels, policy);
+  exploration_phase.stop();
 
   return std::make_tuple(stats, graph);
 }
@@ -5,6 +5,8 @@
  *
  */
 
+#include <stdexcept>
+
 #include <boost/dynamic_bitset.hpp>
 
 #include "tchecker/algorithms/search_order.hh"
@@ -68,14 +70,15 @@ edge_t::edge_t(tchecker::zg::transition_t const & t) : _vedge(t.vedge_ptr()) {}
 
 /* graph_t */
 
-graph_t::graph_t(std::shared_ptr<tchecker::zg::zg_t> const & zg, std::size_t block_size, std::size_t table_size)
+graph_t::graph_t(std::shared_ptr<tchecker::zg::zg_t> const & zg, std::shared_ptr<tchecker::amap::a_map_t const> const & amap,
+                 std::size_t block_size, std::size_t table_size)
     : tchecker::graph::subsumption::graph_t<tchecker::tck_reach::zg_gsim::node_t, tchecker::tck_reach::zg_gsim::edge_t,
                                             tchecker::tck_reach::zg_gsim::node_hash_t,
                                             tchecker::tck_reach::zg_gsim::node_le_t>(
                                                 block_size, table_size, 
                                                 tchecker::tck_reach::zg_gsim::node_hash_t(),
-                                                tchecker::tck_reach::zg_gsim::node_le_t(zg->system())),
-                                            _zg(zg)
+                                                tchecker::tck_reach::zg_gsim::node_le_t(*amap)),
+                                            _zg(zg), _amap(amap)
 {}
 
 graph_t::~graph_t()
@@ -146,25 +149,54 @@ std::ostream & dot_output(std::ostream & os, tchecker::tck_reach::zg_gsim::graph
 /* run */
 
 std::tuple<tchecker::algorithms::covreach::stats_t, std::shared_ptr<tchecker::tck_reach::zg_gsim::graph_t>>
-run(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, std::string const & labels,
-    std::string const & search_order, std::size_t block_size, std::size_t table_size)
+run(std::shared_ptr<tchecker::ta::system_t const> const & system, std::string const & labels,
+    std::string const & search_order, std::size_t block_size, std::size_t table_size, bool por,
+    bool symmetry, enum tchecker::zg::zone_storage_t zone_storage, unsigned int amap_threads,
+    std::shared_ptr<tchecker::clockbounds::cache_t const> const & cache,
+    std::shared_ptr<tchecker::profiler_t> const & profiler,
+    std::shared_ptr<tchecker::algorithms::progress_t> const & progress)
 {
-  std::shared_ptr<tchecker::ta::system_t const> system{new tchecker::ta::system_t{*sysdecl}};
-
+  tchecker::profiler_t::phase_t zone_graph_phase{profiler.get(), "ZONE_GRAPH"};
   std::shared_ptr<tchecker::zg::zg_t> zg{
       tchecker::zg::factory(system, tchecker::zg::ELAPSED_SEMANTICS, tchecker::zg::NO_EXTRAPOLATION, block_size)};
+  zone_graph_phase.stop();
 
   //ani:4 this is the point where bounds are computed!
+  tchecker::profiler_t::phase_t amap_phase{profiler.get(), "AMAP"};
+  std::shared_ptr<tchecker::amap::a_map_t const> amap{cache != nullptr ? cache->load_amap(*system) : nullptr};
+  if (amap == nullptr) {
+    std::shared_ptr<tchecker::amap::a_map_t const> computed{tchecker::amap::compute_amap(*system, amap_threads)};
+    if (computed == nullptr)
+      throw std::runtime_error("reduced A-map computation failed");
+    if (cache != nullptr)
+      cache->store_amap(*system, *computed);
+    amap = computed;
+  }
+  amap_phase.stop();
+  if (!symmetry && (zone_storage != tchecker::zg::ZONE_COMPACT ||
+                    tchecker::zg::compact_zones_allowed(tchecker::amap::max_constant(*amap))))
+    zg->set_zone_storage(zone_storage);
+
+  tchecker::profiler_t::phase_t graph_phase{profiler.get(), "GRAPH"};
   std::shared_ptr<tchecker::tck_reach::zg_gsim::graph_t> graph{
-      new tchecker::tck_reach::zg_gsim::graph_t{zg, block_size, table_size}};
+      new tchecker::tck_reach::zg_gsim::graph_t{zg, amap, block_size, table_size}};
 
   boost::dynamic_bitset<> accepting_labels = system->as_syncprod_system().labels(labels);
 
-  tchecker::tck_reach::zg_gsim::algorithm_t algorithm;
+  std::shared_ptr<tchecker::ta::independence_t const> independence{
+      por ? new tchecker::ta::independence_t{*system} : nullptr};
+
+  std::shared_ptr<tchecker::ta::symmetry_t const> symmetries{symmetry ? new tchecker::ta::symmetry_t{*system} : nullptr};
+
+  tchecker::tck_reach::zg_gsim::algorithm_t algorithm{independence, symmetries};
+  algorithm.set_progress(progress);
 
   enum tchecker::waiting::policy_t policy = tchecker::algorithms::fast_remove_waiting_policy(search_order);
+  graph_phase.stop();
 
+  tchecker::profiler_t::phase_t exploration_phase{profiler.get(), "EXPLORATION"};
   tchecker::algorithms::covreach::stats_t stats = algorithm.run(*zg, *graph, accepting_labels, policy);
+  exploration_phase.stop();
 
   return std::make_tuple(stats, graph);
 }
@@ -14,13 +14,17 @@
 */
 
 #include "tchecker/algorithms/covreach/algorithm.hh"
+#include "tchecker/algorithms/progress.hh"
 #include "tchecker/graph/subsumption_graph.hh"
 #include "tchecker/syncprod/vedge.hh"
+#include "tchecker/ta/system.hh"
+#include "tchecker/utils/profiler.hh"
 #include "tchecker/utils/shared_objects.hh"
 #include "tchecker/waiting/waiting.hh"
 #include "tchecker/zg/state.hh"
 #include "tchecker/zg/transition.hh"
 #include "tchecker/zg/zg.hh"
+#include "tchecker/clockbounds/cache.hh"
 #include "tchecker/clockbounds/clockbounds.hh"
 #include "tchecker/clockbounds/solver.hh"
 
@@ -182,17 +186,31 @@ public:
   /*!
    \brief Constructor
    \param zg : zone graph
+   \param amap : reduced A-map of the system of zg
    \param block_size : number of objects allocated in a block
    \param table_size : size of hash table
-   \note this keeps a pointer on zg
+   \note this keeps a pointer on zg and on amap
   */
-  graph_t(std::shared_ptr<tchecker::zg::zg_t> const & zg, std::size_t block_size, std::size_t table_size);
+  graph_t(std::shared_ptr<tchecker::zg::zg_t> const & zg, std::shared_ptr<tchecker::amap::a_map_t const> const & amap,
+          std::size_t block_size, std::size_t table_size);
 
   /*!
    \brief Destructor
   */
   virtual ~graph_t();
 
+  /*!
+   \brief Accessor
+   \return zone graph
+  */
+  inline tchecker::zg::zg_t const & zg() const { return *_zg; }
+
+  /*!
+   \brief Accessor
+   \return reduced A-map used for covering
+  */
+  inline tchecker::amap::a_map_t const & amap() const { return *_amap; }
+
   using tchecker::graph::subsumption::graph_t<
       tchecker::tck_reach::zg_gsim::node_t, tchecker::tck_reach::zg_gsim::edge_t,
       tchecker::tck_reach::zg_gsim::node_hash_t, tchecker::tck_reach::zg_gsim::node_le_t>::attributes;
@@ -216,6 +234,7 @@ protected:
 
 private:
   std::shared_ptr<tchecker::zg::zg_t> _zg; /*!< Zone graph */
+  std::shared_ptr<tchecker::amap::a_map_t const> _amap; /*!< Reduced A-map */
 };
 
 /*!
@@ -239,17 +258,34 @@ public:
 
 /*!
  \brief Run covering reachability algorithm on the zone graph of a system
- \param sysdecl : system declaration
+ \param system : system of timed processes
  \param labels : comma-separated string of labels
  \param search_order : search order
  \param block_size : number of elements allocated in one block
- \pre labels must appear as node attributes in sysdecl
+ \param table_size : size of hash tables
+ \param por : true if partial-order reduction should be used, false otherwise
+ \param symmetry : true if symmetry reduction should be used, false otherwise
+ \param zone_storage : storage of the zones of computed states (compact zones
+ are only used if the constants in the reduced A-map are small enough, and zones are full
+ with symmetry reduction)
+ \param amap_threads : number of threads used to compute the reduced A-map
+ \param cache : cache of reduced A-maps (nullptr if reduced A-maps should not be cached)
+ \param profiler : profiler of the phases of the run (nullptr if the run should not be profiled)
+ \param progress : progress reports of the exploration (nullptr if progress should not be reported)
+ \pre labels must appear as node attributes in system
  search_order must be either "dfs" or "bfs"
+ \post the reduced A-map has been loaded from cache if possible, computed and
+ stored in cache otherwise
  \return statistics on the run and the covering reachability graph
  */
 std::tuple<tchecker::algorithms::covreach::stats_t, std::shared_ptr<tchecker::tck_reach::zg_gsim::graph_t>>
-run(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, std::string const & labels = "",
-    std::string const & search_order = "bfs", std::size_t block_size = 10000, std::size_t table_size = 65536);
+run(std::shared_ptr<tchecker::ta::system_t const> const & system, std::string const & labels = "",
+    std::string const & search_order = "bfs", std::size_t block_size = 10000, std::size_t table_size = 65536,
+    bool por = false, bool symmetry = false,
+    enum tchecker::zg::zone_storage_t zone_storage = tchecker::zg::ZONE_COMPACT, unsigned int amap_threads = 1,
+    std::shared_ptr<tchecker::clockbounds::cache_t const> const & cache = nullptr,
+    std::shared_ptr<tchecker::profiler_t> const & profiler = nullptr,
+    std::shared_ptr<tchecker::algorithms::progress_t> const & progress = nullptr);
 
 } // end of namespace zg_gsim
 
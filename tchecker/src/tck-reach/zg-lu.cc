@@ -34,65 +34,34 @@ std::size_t node_hash_t::operator()(tchecker::tck_reach::zg_lu::node_t const & n
 
 /* node_le_t */
 
-node_le_t::node_le_t(std::shared_ptr<tchecker::clockbounds::clockbounds_t> const & clockbounds) : _clockbounds(clockbounds)
+node_le_t::node_le_t(std::shared_ptr<tchecker::clockbounds::clockbounds_t> const & clockbounds)
+    : _clockbounds(clockbounds), _lu_table(new tchecker::clockbounds::local_lu_table_t(_clockbounds->local_lu_map()))
 {
-  _l = tchecker::clockbounds::allocate_map(_clockbounds->clock_number());
-  _u = tchecker::clockbounds::allocate_map(_clockbounds->clock_number());
 }
 
-node_le_t::node_le_t(tchecker::ta::system_t const & system) : _clockbounds(tchecker::clockbounds::compute_clockbounds(system))
+node_le_t::node_le_t(tchecker::ta::system_t const & system)
+    : _clockbounds(tchecker::clockbounds::compute_clockbounds(system)),
+      _lu_table(new tchecker::clockbounds::local_lu_table_t(_clockbounds->local_lu_map()))
 {
-  _l = tchecker::clockbounds::allocate_map(_clockbounds->clock_number());
-  _u = tchecker::clockbounds::allocate_map(_clockbounds->clock_number());
 }
 
-node_le_t::node_le_t(tchecker::tck_reach::zg_lu::node_le_t const & node_le) : _clockbounds(node_le._clockbounds)
-{
-  _l = tchecker::clockbounds::clone_map(*node_le._l);
-  _u = tchecker::clockbounds::clone_map(*node_le._u);
-}
+node_le_t::node_le_t(tchecker::tck_reach::zg_lu::node_le_t const & node_le) = default;
 
-node_le_t::node_le_t(tchecker::tck_reach::zg_lu::node_le_t && node_le) : _clockbounds(std::move(node_le._clockbounds))
-{
-  _l = node_le._l;
-  node_le._l = nullptr;
-  _u = node_le._u;
-  node_le._u = nullptr;
-}
+node_le_t::node_le_t(tchecker::tck_reach::zg_lu::node_le_t && node_le) = default;
 
-node_le_t::~node_le_t()
-{
-  tchecker::clockbounds::deallocate_map(_l);
-  tchecker::clockbounds::deallocate_map(_u);
-}
+node_le_t::~node_le_t() = default;
 
-tchecker::tck_reach::zg_lu::node_le_t & node_le_t::operator=(tchecker::tck_reach::zg_lu::node_le_t const & node_le)
-{
-  if (this != &node_le) {
-    _clockbounds = node_le._clockbounds;
-    _l = tchecker::clockbounds::clone_map(*node_le._l);
-    _u = tchecker::clockbounds::clone_map(*node_le._u);
-  }
-  return *this;
-}
+tchecker::tck_reach::zg_lu::node_le_t & node_le_t::operator=(tchecker::tck_reach::zg_lu::node_le_t const & node_le) = default;
 
-tchecker::tck_reach::zg_lu::node_le_t & node_le_t::operator=(tchecker::tck_reach::zg_lu::node_le_t && node_le)
-{
-  if (this != &node_le) {
-    _clockbounds = std::move(node_le._clockbounds);
-    _l = node_le._l;
-    node_le._l = nullptr;
-    _u = node_le._u;
-    node_le._u = nullptr;
-  }
-  return *this;
-}
+tchecker::tck_reach::zg_lu::node_le_t & node_le_t::operator=(tchecker::tck_reach::zg_lu::node_le_t && node_le) = default;
 
 bool node_le_t::operator()(tchecker::tck_reach::zg_lu::node_t const & n1,
                            tchecker::tck_reach::zg_lu::node_t const & n2) const
 {
-  _clockbounds->local_lu(n2.state().vloc(), *_l, *_u);
-  return tchecker::zg::alu_le(n1.state(), n2.state(), *_l, *_u);
+  tchecker::clockbounds::map_t const * l = nullptr;
+  tchecker::clockbounds::map_t const * u = nullptr;
+  _lu_table->bounds(n2.state().vloc(), l, u);
+  return tchecker::zg::alu_le(n1.state(), n2.state(), *l, *u);
 }
 
 /* edge_t */
@@ -111,6 +80,18 @@ graph_t::graph_t(std::shared_ptr<tchecker::zg::zg_t> const & zg, std::size_t blo
 {
 }
 
+graph_t::graph_t(std::shared_ptr<tchecker::zg::zg_t> const & zg,
+                 std::shared_ptr<tchecker::clockbounds::clockbounds_t> const & clockbounds, std::size_t block_size,
+                 std::size_t table_size)
+    : tchecker::graph::subsumption::graph_t<tchecker::tck_reach::zg_lu::node_t, tchecker::tck_reach::zg_lu::edge_t,
+                                            tchecker::tck_reach::zg_lu::node_hash_t,
+                                            tchecker::tck_reach::zg_lu::node_le_t>(
+          block_size, table_size, tchecker::tck_reach::zg_lu::node_hash_t(),
+          tchecker::tck_reach::zg_lu::node_le_t(clockbounds)),
+      _zg(zg)
+{
+}
+
 graph_t::~graph_t()
 {
   tchecker::graph::subsumption::graph_t<tchecker::tck_reach::zg_lu::node_t, tchecker::tck_reach::zg_lu::edge_t,
@@ -179,24 +160,51 @@ std::ostream & dot_output(std::ostream & os, tchecker::tck_reach::zg_lu::graph_t
 /* run */
 
 std::tuple<tchecker::algorithms::covreach::stats_t, std::shared_ptr<tchecker::tck_reach::zg_lu::graph_t>>
-run(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, std::string const & labels,
-    std::string const & search_order, std::size_t block_size, std::size_t table_size)
+run(std::shared_ptr<tchecker::ta::system_t const> const & system, std::string const & labels,
+    std::string const & search_order, std::size_t block_size, std::size_t table_size, bool por,
+    bool symmetry, enum tchecker::zg::zone_storage_t zone_storage, std::shared_ptr<tchecker::clockbounds::cache_t const> const & cache,
+    std::shared_ptr<tchecker::profiler_t> const & profiler,
+    std::shared_ptr<tchecker::algorithms::progress_t> const & progress)
 {
-  std::shared_ptr<tchecker::ta::system_t const> system{new tchecker::ta::system_t{*sysdecl}};
-
+  tchecker::profiler_t::phase_t zone_graph_phase{profiler.get(), "ZONE_GRAPH"};
   std::shared_ptr<tchecker::zg::zg_t> zg{
       tchecker::zg::factory(system, tchecker::zg::ELAPSED_SEMANTICS, tchecker::zg::NO_EXTRAPOLATION, block_size)};
+  if (!symmetry && (zone_storage != tchecker::zg::ZONE_COMPACT || tchecker::zg::compact_zones_allowed(*system)))
+    zg->set_zone_storage(zone_storage);
+  zone_graph_phase.stop();
+
+  tchecker::profiler_t::phase_t clockbounds_phase{profiler.get(), "CLOCKBOUNDS"};
+  std::shared_ptr<tchecker::clockbounds::clockbounds_t> clockbounds{
+      cache != nullptr ? cache->load_clockbounds(*system) : nullptr};
+  if (clockbounds == nullptr) {
+    clockbounds.reset(tchecker::clockbounds::compute_clockbounds(*system));
+    if (clockbounds == nullptr)
+      throw std::runtime_error("clock bounds computation failed");
+    if (cache != nullptr)
+      cache->store_clockbounds(*system, *clockbounds);
+  }
+  clockbounds_phase.stop();
 
+  tchecker::profiler_t::phase_t graph_phase{profiler.get(), "GRAPH"};
   std::shared_ptr<tchecker::tck_reach::zg_lu::graph_t> graph{
-      new tchecker::tck_reach::zg_lu::graph_t{zg, block_size, table_size}};
+      new tchecker::tck_reach::zg_lu::graph_t{zg, clockbounds, block_size, table_size}};
 
   boost::dynamic_bitset<> accepting_labels = system->as_syncprod_system().labels(labels);
 
-  tchecker::tck_reach::zg_lu::algorithm_t algorithm;
+  std::shared_ptr<tchecker::ta::independence_t const> independence{
+      por ? new tchecker::ta::independence_t{*system} : nullptr};
+
+  std::shared_ptr<tchecker::ta::symmetry_t const> symmetries{symmetry ? new tchecker::ta::symmetry_t{*system} : nullptr};
+
+  tchecker::tck_reach::zg_lu::algorithm_t algorithm{independence, symmetries};
+  algorithm.set_progress(progress);
 
   enum tchecker::waiting::policy_t policy = tchecker::algorithms::fast_remove_waiting_policy(search_order);
+  graph_phase.stop();
 
+  tchecker::profiler_t::phase_t exploration_phase{profiler.get(), "EXPLORATION"};
   tchecker::algorithms::covreach::stats_t stats = algorithm.run(*zg, *graph, accepting_labels, policy);
+  exploration_phase.stop();
 
   return std::make_tuple(stats, graph);
 }
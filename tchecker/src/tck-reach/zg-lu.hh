@@ -15,11 +15,14 @@
 
 #include "tchecker/algorithms/covreach/algorithm.hh"
 #include "tchecker/algorithms/covreach/stats.hh"
+#include "tchecker/algorithms/progress.hh"
+#include "tchecker/clockbounds/cache.hh"
 #include "tchecker/clockbounds/clockbounds.hh"
 #include "tchecker/clockbounds/solver.hh"
 #include "tchecker/graph/output.hh"
 #include "tchecker/graph/subsumption_graph.hh"
 #include "tchecker/syncprod/vedge.hh"
+#include "tchecker/utils/profiler.hh"
 #include "tchecker/utils/shared_objects.hh"
 #include "tchecker/ta/system.hh"
 #include "tchecker/waiting/waiting.hh"
@@ -107,6 +110,7 @@ public:
 
   /*!
   \brief Copy constructor
+  \note the copy shares the memoised local LU maps of node_le
   */
   node_le_t(tchecker::tck_reach::zg_lu::node_le_t const & node_le);
 
@@ -140,9 +144,8 @@ public:
   bool operator()(tchecker::tck_reach::zg_lu::node_t const & n1, tchecker::tck_reach::zg_lu::node_t const & n2) const;
 
 private:
-  std::shared_ptr<tchecker::clockbounds::clockbounds_t> _clockbounds; /*!< Clock bounds */
-  tchecker::clockbounds::map_t * _l;                                  /*!< Clock lower bounds */
-  tchecker::clockbounds::map_t * _u;                                  /*!< Clock upper bounds */
+  std::shared_ptr<tchecker::clockbounds::clockbounds_t> _clockbounds;   /*!< Clock bounds */
+  std::shared_ptr<tchecker::clockbounds::local_lu_table_t> _lu_table; /*!< Local LU maps memoised per tuple of locations */
 };
 
 /*!
@@ -191,11 +194,29 @@ public:
   */
   graph_t(std::shared_ptr<tchecker::zg::zg_t> const & zg, std::size_t block_size, std::size_t table_size);
 
+  /*!
+   \brief Constructor
+   \param zg : zone graph
+   \param clockbounds : clock bounds of the system of zg
+   \param block_size : number of objects allocated in a block
+   \param table_size : size of hash table
+   \note this keeps a pointer on zg and a shared pointer on clockbounds
+  */
+  graph_t(std::shared_ptr<tchecker::zg::zg_t> const & zg,
+          std::shared_ptr<tchecker::clockbounds::clockbounds_t> const & clockbounds, std::size_t block_size,
+          std::size_t table_size);
+
   /*!
    \brief Destructor
   */
   virtual ~graph_t();
 
+  /*!
+   \brief Accessor
+   \return zone graph
+  */
+  inline tchecker::zg::zg_t const & zg() const { return *_zg; }
+
   using tchecker::graph::subsumption::graph_t<
       tchecker::tck_reach::zg_lu::node_t, tchecker::tck_reach::zg_lu::edge_t,
       tchecker::tck_reach::zg_lu::node_hash_t, tchecker::tck_reach::zg_lu::node_le_t>::attributes;
@@ -242,17 +263,33 @@ public:
 
 /*!
  \brief Run covering reachability algorithm on the zone graph of a system
- \param sysdecl : system declaration
+ \param system : system of timed processes
  \param labels : comma-separated string of labels
  \param search_order : search order
  \param block_size : number of elements allocated in one block
- \pre labels must appear as node attributes in sysdecl
+ \param table_size : size of hash tables
+ \param por : true if partial-order reduction should be used, false otherwise
+ \param symmetry : true if symmetry reduction should be used, false otherwise
+ \param zone_storage : storage of the zones of computed states (compact zones
+ are only used if the clock bounds of system are small enough, and zones are full
+ with symmetry reduction)
+ \param cache : cache of clock bounds (nullptr if clock bounds should not be cached)
+ \param profiler : profiler of the phases of the run (nullptr if the run should not be profiled)
+ \param progress : progress reports of the exploration (nullptr if progress should not be reported)
+ \pre labels must appear as node attributes in system
  search_order must be either "dfs" or "bfs"
+ \post clock bounds have been loaded from cache if possible, computed and stored
+ in cache otherwise
  \return statistics on the run and the covering reachability graph
  */
 std::tuple<tchecker::algorithms::covreach::stats_t, std::shared_ptr<tchecker::tck_reach::zg_lu::graph_t>>
-run(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, std::string const & labels = "",
-    std::string const & search_order = "bfs", std::size_t block_size = 10000, std::size_t table_size = 65536);
+run(std::shared_ptr<tchecker::ta::system_t const> const & system, std::string const & labels = "",
+    std::string const & search_order = "bfs", std::size_t block_size = 10000, std::size_t table_size = 65536,
+    bool por = false, bool symmetry = false,
+    enum tchecker::zg::zone_storage_t zone_storage = tchecker::zg::ZONE_COMPACT,
+    std::shared_ptr<tchecker::clockbounds::cache_t const> const & cache = nullptr,
+    std::shared_ptr<tchecker::profiler_t> const & profiler = nullptr,
+    std::shared_ptr<tchecker::algorithms::progress_t> const & progress = nullptr);
 
 } // end of namespace zg_lu
 
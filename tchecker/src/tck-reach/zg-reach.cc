@@ -5,9 +5,14 @@
  *
  */
 
+#include <stdexcept>
+
 #include <boost/dynamic_bitset.hpp>
 
 #include "tchecker/algorithms/search_order.hh"
+#include "tchecker/clockbounds/solver.hh"
+#include "tchecker/expression/static_analysis.hh"
+#include "tchecker/ta/clock_liveness.hh"
 #include "tchecker/ta/system.hh"
 #include "zg-reach.hh"
 
@@ -117,24 +122,112 @@ std::ostream & dot_output(std::ostream & os, tchecker::tck_reach::zg_reach::grap
 /* run */
 
 std::tuple<tchecker::algorithms::reach::stats_t, std::shared_ptr<tchecker::tck_reach::zg_reach::graph_t>>
-run(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, std::string const & labels,
-    std::string const & search_order, std::size_t block_size, std::size_t table_size)
+run(std::shared_ptr<tchecker::ta::system_t const> const & system, std::string const & labels,
+    std::string const & search_order, std::size_t block_size, std::size_t table_size,
+    enum tchecker::zg::zone_storage_t zone_storage, std::shared_ptr<tchecker::profiler_t> const & profiler,
+    std::shared_ptr<tchecker::algorithms::progress_t> const & progress)
 {
-  std::shared_ptr<tchecker::ta::system_t const> system{new tchecker::ta::system_t{*sysdecl}};
-
+  tchecker::profiler_t::phase_t zone_graph_phase{profiler.get(), "ZONE_GRAPH"};
   std::shared_ptr<tchecker::zg::zg_t> zg{
       tchecker::zg::factory(system, tchecker::zg::ELAPSED_SEMANTICS, tchecker::zg::EXTRA_LU_PLUS_LOCAL, block_size)};
+  if (zone_storage != tchecker::zg::ZONE_COMPACT || tchecker::zg::compact_zones_allowed(*system))
+    zg->set_zone_storage(zone_storage);
+  zone_graph_phase.stop();
+
+  tchecker::profiler_t::phase_t graph_phase{profiler.get(), "GRAPH"};
+  std::shared_ptr<tchecker::tck_reach::zg_reach::graph_t> graph{
+      new tchecker::tck_reach::zg_reach::graph_t{zg, block_size, table_size}};
+
+  boost::dynamic_bitset<> accepting_labels = system->as_syncprod_system().labels(labels);
+
+  tchecker::tck_reach::zg_reach::algorithm_t algorithm;
+  algorithm.set_progress(progress);
+
+  enum tchecker::waiting::policy_t policy = tchecker::algorithms::waiting_policy(search_order);
+  graph_phase.stop();
+
+  tchecker::profiler_t::phase_t exploration_phase{profiler.get(), "EXPLORATION"};
+  tchecker::algorithms::reach::stats_t stats = algorithm.run(*zg, *graph, accepting_labels, policy);
+  exploration_phase.stop();
+
+  return std::make_tuple(stats, graph);
+}
+
+/*!
+ \brief Check that the zone graph extrapolated w.r.t. a reduced A-map is finite
+ \param system : system of timed processes
+ \param amap : reduced A-map of system
+ \throw std::invalid_argument : if some prophecy clock or some diagonal
+ constraint appears in amap. The corresponding difference bounds are kept exact
+ by tchecker::zg::local_eca_extra_lu_plus_t, hence the zone graph may be infinite
+ */
+static void check_gta_finite(tchecker::ta::system_t const & system, tchecker::eca_amap_gen2::eca_a_map_t const & amap)
+{
+  for (tchecker::loc_id_t l = 0; l < amap.loc_number(); ++l) {
+    if (!amap.G(l).empty())
+      throw std::invalid_argument("gta_reach does not support diagonal constraints (found " + amap.G(l).front()->to_string() +
+                                  "), use gta_gsim instead");
+
+    for (tchecker::typed_simple_clkconstr_expression_t const * c : amap.Gdf(l)) {
+      tchecker::clock_id_t const x = tchecker::extract_lvalue_variable_ids(c->clock()).begin();
+      if (system.prophecy_clock_id_map.find(x + 1) != system.prophecy_clock_id_map.end())
+        throw std::invalid_argument("gta_reach does not support constraints on prophecy clocks (found " + c->to_string() +
+                                    "), use gta_gsim instead");
+    }
+  }
+}
+
+std::tuple<tchecker::algorithms::reach::stats_t, std::shared_ptr<tchecker::tck_reach::zg_reach::graph_t>>
+run_gta(std::shared_ptr<tchecker::ta::system_t const> const & system, std::string const & labels,
+        std::string const & search_order, std::size_t block_size, std::size_t table_size,
+        enum tchecker::zg::zone_storage_t zone_storage, bool clock_liveness, unsigned int amap_threads,
+        std::shared_ptr<tchecker::clockbounds::cache_t const> const & cache,
+        std::shared_ptr<tchecker::profiler_t> const & profiler,
+        std::shared_ptr<tchecker::algorithms::progress_t> const & progress)
+{
+  tchecker::profiler_t::phase_t amap_phase{profiler.get(), "AMAP"};
+  std::shared_ptr<tchecker::eca_amap_gen2::eca_a_map_t const> amap{cache != nullptr ? cache->load_eca_amap(*system)
+                                                                                    : nullptr};
+  if (amap == nullptr) {
+    std::shared_ptr<tchecker::eca_amap_gen2::eca_a_map_t const> computed{
+        tchecker::eca_amap_gen2::compute_eca_amap(*system, amap_threads)};
+    if (computed == nullptr)
+      throw std::runtime_error("reduced A-map computation failed");
+    if (cache != nullptr)
+      cache->store_eca_amap(*system, *computed);
+    amap = computed;
+  }
+  amap_phase.stop();
+
+  check_gta_finite(*system, *amap);
+
+  tchecker::profiler_t::phase_t zone_graph_phase{profiler.get(), "ZONE_GRAPH"};
+  std::shared_ptr<tchecker::ta::clock_liveness_t const> liveness{
+      clock_liveness ? new tchecker::ta::clock_liveness_t{*system} : nullptr};
+
+  std::shared_ptr<tchecker::zg::zg_t> zg{tchecker::zg::factory(system, tchecker::zg::eca_gen2_SEMANTICS,
+                                                               tchecker::zg::EXTRA_LU_PLUS_LOCAL_ECA, *amap, block_size,
+                                                               liveness)};
+  if (zone_storage != tchecker::zg::ZONE_COMPACT ||
+      tchecker::zg::compact_zones_allowed(tchecker::eca_amap_gen2::max_constant(*amap)))
+    zg->set_zone_storage(zone_storage);
+  zone_graph_phase.stop();
 
+  tchecker::profiler_t::phase_t graph_phase{profiler.get(), "GRAPH"};
   std::shared_ptr<tchecker::tck_reach::zg_reach::graph_t> graph{
       new tchecker::tck_reach::zg_reach::graph_t{zg, block_size, table_size}};
 
   boost::dynamic_bitset<> accepting_labels = system->as_syncprod_system().labels(labels);
 
   tchecker::tck_reach::zg_reach::algorithm_t algorithm;
+  algorithm.set_progress(progress);
 
   enum tchecker::waiting::policy_t policy = tchecker::algorithms::waiting_policy(search_order);
+  graph_phase.stop();
 
+  tchecker::profiler_t::phase_t exploration_phase{profiler.get(), "EXPLORATION"};
   tchecker::algorithms::reach::stats_t stats = algorithm.run(*zg, *graph, accepting_labels, policy);
+  exploration_phase.stop();
 
   return std::make_tuple(stats, graph);
 }
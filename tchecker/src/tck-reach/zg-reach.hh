@@ -13,11 +13,14 @@
 #include <string>
 #include <tuple>
 
+#include "tchecker/algorithms/progress.hh"
 #include "tchecker/algorithms/reach/algorithm.hh"
 #include "tchecker/algorithms/reach/stats.hh"
+#include "tchecker/clockbounds/cache.hh"
 #include "tchecker/graph/reachability_graph.hh"
-#include "tchecker/parsing/declaration.hh"
 #include "tchecker/syncprod/vedge.hh"
+#include "tchecker/ta/system.hh"
+#include "tchecker/utils/profiler.hh"
 #include "tchecker/utils/shared_objects.hh"
 #include "tchecker/waiting/waiting.hh"
 #include "tchecker/zg/state.hh"
@@ -147,6 +150,12 @@ public:
   */
   virtual ~graph_t();
 
+  /*!
+   \brief Accessor
+   \return zone graph
+  */
+  inline tchecker::zg::zg_t const & zg() const { return *_zg; }
+
   using tchecker::graph::reachability::graph_t<tchecker::tck_reach::zg_reach::node_t, tchecker::tck_reach::zg_reach::edge_t,
                                                tchecker::tck_reach::zg_reach::node_hash_t,
                                                tchecker::tck_reach::zg_reach::node_equal_to_t>::attributes;
@@ -193,17 +202,62 @@ public:
 
 /*!
  \brief Run reachability algorithm on the zone graph of a system
- \param sysdecl : system declaration
+ \param system : system of timed processes
+ \param labels : comma-separated string of labels
+ \param search_order : search order
+ \param block_size : number of elements allocated in one block
+ \param table_size : size of hash tables
+ \param zone_storage : storage of the zones of computed states (compact zones
+ are only used if the clock bounds of system are small enough)
+ \param profiler : profiler of the phases of the run (nullptr if the run should not be profiled)
+ \param progress : progress reports of the exploration (nullptr if progress should not be reported)
+ \pre labels must appear as node attributes in system
+ search_order must be either "dfs" or "bfs"
+ \return statistics on the run and the reachability graph
+ */
+std::tuple<tchecker::algorithms::reach::stats_t, std::shared_ptr<tchecker::tck_reach::zg_reach::graph_t>>
+run(std::shared_ptr<tchecker::ta::system_t const> const & system, std::string const & labels = "",
+    std::string const & search_order = "bfs", std::size_t block_size = 10000, std::size_t table_size = 65536,
+    enum tchecker::zg::zone_storage_t zone_storage = tchecker::zg::ZONE_COMPACT,
+    std::shared_ptr<tchecker::profiler_t> const & profiler = nullptr,
+    std::shared_ptr<tchecker::algorithms::progress_t> const & progress = nullptr);
+
+/*!
+ \brief Run reachability algorithm on the zone graph of a system of General
+ Timed Automata
+ \param system : system of timed processes
  \param labels : comma-separated string of labels
  \param search_order : search order
  \param block_size : number of elements allocated in one block
- \pre labels must appear as node attributes in sysdecl
+ \param table_size : size of hash tables
+ \param zone_storage : storage of the zones of computed states (compact zones
+ are only used if the constants in the reduced A-map are small enough)
+ \param clock_liveness : true if inactive history clocks should be normalised,
+ false otherwise
+ \param amap_threads : number of threads used to compute the reduced A-map
+ \param cache : cache of reduced A-maps (nullptr if reduced A-maps should not be cached)
+ \param profiler : profiler of the phases of the run (nullptr if the run should not be profiled)
+ \param progress : progress reports of the exploration (nullptr if progress should not be reported)
+ \pre labels must appear as node attributes in system
  search_order must be either "dfs" or "bfs"
+ \post the reduced A-map has been loaded from cache if possible, computed and
+ stored in cache otherwise
  \return statistics on the run and the reachability graph
+ \note zones are extrapolated w.r.t. the bounds in the reduced A-map (see
+ tchecker::zg::local_eca_extra_lu_plus_t). The difference bounds on prophecy
+ clocks and on clocks in diagonal constraints are kept exact, hence systems
+ with such constraints are rejected as their zone graph may be infinite
+ \throw std::runtime_error : if the reduced A-map cannot be computed
+ \throw std::invalid_argument : if the reduced A-map contains a diagonal
+ constraint or a constraint on a prophecy clock
  */
 std::tuple<tchecker::algorithms::reach::stats_t, std::shared_ptr<tchecker::tck_reach::zg_reach::graph_t>>
-run(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, std::string const & labels = "",
-    std::string const & search_order = "bfs", std::size_t block_size = 10000, std::size_t table_size = 65536);
+run_gta(std::shared_ptr<tchecker::ta::system_t const> const & system, std::string const & labels = "",
+        std::string const & search_order = "bfs", std::size_t block_size = 10000, std::size_t table_size = 65536,
+        enum tchecker::zg::zone_storage_t zone_storage = tchecker::zg::ZONE_COMPACT, bool clock_liveness = false,
+        unsigned int amap_threads = 1, std::shared_ptr<tchecker::clockbounds::cache_t const> const & cache = nullptr,
+        std::shared_ptr<tchecker::profiler_t> const & profiler = nullptr,
+        std::shared_ptr<tchecker::algorithms::progress_t> const & progress = nullptr);
 
 } // end of namespace zg_reach
 
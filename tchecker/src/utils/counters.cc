@@ -0,0 +1,96 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <sstream>
+
+#include "tchecker/utils/counters.hh"
+
+namespace tchecker {
+
+namespace counters {
+
+tchecker::counters::storage_t storage;
+
+/*!
+ \brief Names of counters (indexed by tchecker::counters::counter_t)
+ */
+static char const * const counter_names[tchecker::counters::COUNTERS_COUNT] = {
+    "COVERING_CHECKS", "COVERING_CHECKS_SUCCEEDED", "COVERED_NODES_CHECKS", "BUCKET_NODES_SCANNED",
+    "GSIM_SPLITS",     "ECA_TIGHTEN_CALLS",         "DBM_DIMENSION",        "ZONE_EXPANSIONS"};
+
+/*!
+ \brief Names of statuses of states (indexed by the position of the status bit)
+ */
+static char const * const status_names[tchecker::counters::STATUSES_COUNT] = {"OK",
+                                                                              "INCOMPATIBLE_EDGE",
+                                                                              "INTVARS_GUARD_VIOLATED",
+                                                                              "INTVARS_SRC_INVARIANT_VIOLATED",
+                                                                              "INTVARS_TGT_INVARIANT_VIOLATED",
+                                                                              "INTVARS_STATEMENT_FAILED",
+                                                                              "CLOCKS_GUARD_VIOLATED",
+                                                                              "CLOCKS_SRC_INVARIANT_VIOLATED",
+                                                                              "CLOCKS_TGT_INVARIANT_VIOLATED",
+                                                                              "CLOCKS_EMPTY_SYNC",
+                                                                              "CLOCKS_EMPTY_SPREAD",
+                                                                              "ZONE_EMPTY",
+                                                                              "ZONE_EMPTY_SYNC",
+                                                                              "ECA_PROPHECY_CLOCK_VIOLATED"};
+
+/*!
+ \brief Names of timers (indexed by tchecker::counters::timer_t)
+ */
+static char const * const timer_names[tchecker::counters::TIMERS_COUNT] = {"NEXT", "IS_COVERED", "COVERED_NODES",
+                                                                           "ZONE_EXPANSION"};
+
+void count_status(tchecker::state_status_t status)
+{
+  for (unsigned int i = 0; i < tchecker::counters::STATUSES_COUNT; ++i)
+    if (status & (1U << i))
+      tchecker::counters::storage.statuses[i].fetch_add(1, std::memory_order_relaxed);
+}
+
+void reset()
+{
+  for (auto & c : tchecker::counters::storage.counters)
+    c.store(0, std::memory_order_relaxed);
+  for (auto & c : tchecker::counters::storage.statuses)
+    c.store(0, std::memory_order_relaxed);
+  for (unsigned int i = 0; i < tchecker::counters::TIMERS_COUNT; ++i) {
+    tchecker::counters::storage.timer_calls[i].store(0, std::memory_order_relaxed);
+    tchecker::counters::storage.timer_samples[i].store(0, std::memory_order_relaxed);
+    tchecker::counters::storage.timer_nanoseconds[i].store(0, std::memory_order_relaxed);
+  }
+}
+
+void attributes(std::map<std::string, std::string> & m)
+{
+  for (unsigned int i = 0; i < tchecker::counters::COUNTERS_COUNT; ++i)
+    m[counter_names[i]] = std::to_string(tchecker::counters::storage.counters[i].load(std::memory_order_relaxed));
+
+  for (unsigned int i = 0; i < tchecker::counters::STATUSES_COUNT; ++i) {
+    unsigned long const count = tchecker::counters::storage.statuses[i].load(std::memory_order_relaxed);
+    if (count != 0)
+      m[std::string("SUCCESSORS_") + status_names[i]] = std::to_string(count);
+  }
+
+  std::stringstream sstream;
+  for (unsigned int i = 0; i < tchecker::counters::TIMERS_COUNT; ++i) {
+    unsigned long const calls = tchecker::counters::storage.timer_calls[i].load(std::memory_order_relaxed);
+    unsigned long const samples = tchecker::counters::storage.timer_samples[i].load(std::memory_order_relaxed);
+    unsigned long long const nanoseconds = tchecker::counters::storage.timer_nanoseconds[i].load(std::memory_order_relaxed);
+
+    m[std::string("TIMER_") + timer_names[i] + "_CALLS"] = std::to_string(calls);
+
+    sstream.str("");
+    sstream << (samples == 0 ? 0.0 : static_cast<double>(nanoseconds) * 1e-9 * calls / samples);
+    m[std::string("TIMER_") + timer_names[i] + "_SECONDS"] = sstream.str();
+  }
+}
+
+} // end of namespace counters
+
+} // end of namespace tchecker
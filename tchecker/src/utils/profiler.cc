@@ -0,0 +1,80 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <algorithm>
+#include <sstream>
+
+#include <sys/resource.h>
+
+#include "tchecker/utils/profiler.hh"
+
+namespace tchecker {
+
+long peak_memory_kb()
+{
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0)
+    return 0;
+#if defined(__APPLE__)
+  return usage.ru_maxrss / 1024; // bytes on macOS
+#else
+  return usage.ru_maxrss;
+#endif
+}
+
+/* profiler_t::phase_t */
+
+profiler_t::phase_t::phase_t(tchecker::profiler_t * profiler, std::string const & name)
+    : _profiler(profiler), _name(name), _start_time(std::chrono::steady_clock::now()), _start_cpu_time(std::clock()),
+      _start_peak_memory_kb(profiler != nullptr ? tchecker::peak_memory_kb() : 0)
+{
+}
+
+profiler_t::phase_t::~phase_t() { stop(); }
+
+void profiler_t::phase_t::stop()
+{
+  if (_profiler == nullptr)
+    return;
+  std::chrono::duration<double> const time = std::chrono::steady_clock::now() - _start_time;
+  double const cpu_time = static_cast<double>(std::clock() - _start_cpu_time) / CLOCKS_PER_SEC;
+  _profiler->record(_name, time.count(), cpu_time, tchecker::peak_memory_kb() - _start_peak_memory_kb);
+  _profiler = nullptr;
+}
+
+/* profiler_t */
+
+void profiler_t::record(std::string const & name, double time, double cpu_time, long peak_memory_growth_kb)
+{
+  auto it = std::find_if(_records.begin(), _records.end(), [&](record_t const & r) { return r._name == name; });
+  if (it == _records.end())
+    _records.push_back(record_t{name, time, cpu_time, peak_memory_growth_kb});
+  else {
+    it->_time += time;
+    it->_cpu_time += cpu_time;
+    it->_peak_memory_growth_kb += peak_memory_growth_kb;
+  }
+}
+
+void profiler_t::attributes(std::map<std::string, std::string> & m) const
+{
+  std::stringstream sstream;
+  for (record_t const & r : _records) {
+    sstream.str("");
+    sstream << r._time;
+    m["TIME_" + r._name] = sstream.str();
+
+    sstream.str("");
+    sstream << r._cpu_time;
+    m["CPU_TIME_" + r._name] = sstream.str();
+
+    m["MEMORY_PEAK_GROWTH_" + r._name] = std::to_string(r._peak_memory_growth_kb);
+  }
+  m["MEMORY_PEAK"] = std::to_string(tchecker::peak_memory_kb());
+}
+
+} // end of namespace tchecker
@@ -24,6 +24,51 @@ std::ostream & output(std::ostream & os, tchecker::bytecode_t const * bytecode)
   return os;
 }
 
+/*!
+ \brief Size of an instruction
+ \param bytecode : sequence of bytecode intructions
+ \return the number of tchecker::bytecode_t of the instruction pointed by
+ bytecode (including its parameters)
+ */
+static std::size_t instruction_size(tchecker::bytecode_t const * bytecode)
+{
+  switch (*bytecode) {
+  case VM_FAILNOTIN:
+    return 3;
+  case VM_JMP:
+  case VM_JMPZ:
+  case VM_PUSH:
+  case VM_CLKCONSTR:
+    return 2;
+  default:
+    return 1;
+  }
+}
+
+std::size_t bytecode_size(tchecker::bytecode_t const * bytecode)
+{
+  std::size_t size = 0;
+  bool stop = false;
+  while (!stop) {
+    stop = (bytecode[size] == VM_RET);
+    size += instruction_size(bytecode + size);
+  }
+  return size;
+}
+
+bool is_bytecode(tchecker::bytecode_t const * bytecode, std::size_t size)
+{
+  std::size_t i = 0;
+  while (i < size) {
+    if (bytecode[i] < VM_RET || bytecode[i] > VM_NOP)
+      return false;
+    if (bytecode[i] == VM_RET)
+      return (i + 1 == size);
+    i += instruction_size(bytecode + i);
+  }
+  return false;
+}
+
 size_t output_instruction(std::ostream & os, tchecker::bytecode_t const * bytecode)
 {
   size_t res = 1;
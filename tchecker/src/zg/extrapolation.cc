@@ -122,6 +122,16 @@ void local_extra_lu_plus_t::extrapolate(tchecker::dbm::db_t * dbm, tchecker::clo
   tchecker::dbm::extra_lu_plus(dbm, dim, _l->ptr(), _u->ptr());
 }
 
+/* local_eca_extra_lu_plus_t */
+
+void local_eca_extra_lu_plus_t::extrapolate(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim,
+                                            tchecker::vloc_t const & vloc)
+{
+  assert(dim == _clock_bounds->clock_number() + 1);
+  _clock_bounds->bounds(vloc, *_l, *_u);
+  tchecker::dbm::eca_extra_lu_plus(dbm, dim, _l->ptr(), _u->ptr());
+}
+
 /* global_m_extrapolation_t */
 
 namespace details {
@@ -259,6 +269,23 @@ tchecker::zg::extrapolation_t * extrapolation_factory(enum extrapolation_type_t
   }
 }
 
+tchecker::zg::extrapolation_t * extrapolation_factory(enum extrapolation_type_t extrapolation_type,
+                                                      tchecker::ta::system_t const & system,
+                                                      tchecker::eca_amap_gen2::eca_a_map_t const & amap)
+{
+  switch (extrapolation_type) {
+  case tchecker::zg::NO_EXTRAPOLATION:
+    return new tchecker::zg::no_extrapolation_t;
+  case tchecker::zg::EXTRA_LU_PLUS_LOCAL_ECA: {
+    std::shared_ptr<tchecker::clockbounds::local_lu_map_t const> clock_bounds{
+        tchecker::eca_amap_gen2::compute_local_lu_map(system, amap)};
+    return new tchecker::zg::local_eca_extra_lu_plus_t{clock_bounds};
+  }
+  default:
+    throw std::invalid_argument("Unknown zone extrapolation");
+  }
+}
+
 } // end of namespace zg
 
 } // end of namespace tchecker
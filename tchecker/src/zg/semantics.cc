@@ -19,7 +19,8 @@ tchecker::state_status_t standard_semantics_t::initial(tchecker::dbm::db_t * dbm
                                                        tchecker::clock_constraint_container_t const & invariant,
                                                       const std::unordered_set<int> & history_clock_ids,
                                                       const std::unordered_set<int> & prophecy_clock_ids,
-                                                      const std::unordered_set<int> & normal_clock_ids)
+                                                      const std::unordered_set<int> & normal_clock_ids,
+                                                      tchecker::dbm::clock_layout_t const * layout)
 {
   tchecker::dbm::zero(dbm, dim);
 
@@ -36,7 +37,8 @@ tchecker::state_status_t standard_semantics_t::next(tchecker::dbm::db_t * dbm, t
                                                     tchecker::clock_constraint_container_t const & tgt_invariant,
                                                     const std::unordered_set<int> & history_clock_ids,
                                                     const std::unordered_set<int> & prophecy_clock_ids,
-                                                    const std::unordered_set<int> & normal_clock_ids)
+                                                    const std::unordered_set<int> & normal_clock_ids,
+                                                    tchecker::dbm::clock_layout_t const * layout)
 {
   if (src_delay_allowed) {
     tchecker::dbm::open_up(dbm, dim);
@@ -60,7 +62,8 @@ tchecker::state_status_t standard_semantics_t::next(tchecker::dbm::db_t * dbm, t
 bool standard_semantics_t::is_final_dbm(tchecker::dbm::db_t const* dbm, tchecker::clock_id_t dim,
                                     const std::unordered_set<int> & history_clock_ids,
                                     const std::unordered_set<int> & prophecy_clock_ids,
-                                    const std::unordered_set<int> & normal_clock_ids)
+                                    const std::unordered_set<int> & normal_clock_ids,
+                                    tchecker::dbm::clock_layout_t const * layout)
                                     {
                                       return true;
                                     }
@@ -71,7 +74,8 @@ tchecker::state_status_t elapsed_semantics_t::initial(tchecker::dbm::db_t * dbm,
                                                       tchecker::clock_constraint_container_t const & invariant,
                                                       const std::unordered_set<int> & history_clock_ids,
                                                       const std::unordered_set<int> & prophecy_clock_ids,
-                                                      const std::unordered_set<int> & normal_clock_ids)
+                                                      const std::unordered_set<int> & normal_clock_ids,
+                                                      tchecker::dbm::clock_layout_t const * layout)
 {
   tchecker::dbm::zero(dbm, dim);
 
@@ -95,7 +99,8 @@ tchecker::state_status_t elapsed_semantics_t::next(tchecker::dbm::db_t * dbm, tc
                                                    tchecker::clock_constraint_container_t const & tgt_invariant,
                                                    const std::unordered_set<int> & history_clock_ids,
                                                    const std::unordered_set<int> & prophecy_clock_ids,
-                                                   const std::unordered_set<int> & normal_clock_ids)//ani:-100
+                                                   const std::unordered_set<int> & normal_clock_ids,
+                                                   tchecker::dbm::clock_layout_t const * layout)//ani:-100
 {
   if (tchecker::dbm::constrain(dbm, dim, src_invariant) == tchecker::dbm::EMPTY)
     return tchecker::STATE_CLOCKS_SRC_INVARIANT_VIOLATED;
@@ -121,7 +126,8 @@ tchecker::state_status_t elapsed_semantics_t::next(tchecker::dbm::db_t * dbm, tc
 bool elapsed_semantics_t::is_final_dbm(tchecker::dbm::db_t const* dbm, tchecker::clock_id_t dim,
                                     const std::unordered_set<int> & history_clock_ids,
                                     const std::unordered_set<int> & prophecy_clock_ids,
-                                    const std::unordered_set<int> & normal_clock_ids)
+                                    const std::unordered_set<int> & normal_clock_ids,
+                                    tchecker::dbm::clock_layout_t const * layout)
                                     {
                                       return true;
                                     }
@@ -134,14 +140,21 @@ tchecker::state_status_t eca_gen2_semantics_t::initial(tchecker::dbm::db_t * dbm
                                                       tchecker::clock_constraint_container_t const & invariant,
                                                       const std::unordered_set<int> & history_clock_id_map,
                                                       const std::unordered_set<int> & prophecy_clock_id_map,
-                                                      const std::unordered_set<int> & normal_clock_id_map)
+                                                      const std::unordered_set<int> & normal_clock_id_map,
+                                                      tchecker::dbm::clock_layout_t const * layout)
 {
 
-  tchecker::dbm::eca_zero(dbm, dim, history_clock_id_map, prophecy_clock_id_map, normal_clock_id_map);
+  if (layout != nullptr)
+    tchecker::dbm::eca_zero(dbm, dim, *layout);
+  else
+    tchecker::dbm::eca_zero(dbm, dim, history_clock_id_map, prophecy_clock_id_map, normal_clock_id_map);
   
 
   if (delay_allowed) {
-    tchecker::dbm::eca_open_up(dbm, dim, history_clock_id_map, prophecy_clock_id_map, normal_clock_id_map);
+    if (layout != nullptr)
+      tchecker::dbm::eca_open_up(dbm, dim, *layout);
+    else
+      tchecker::dbm::eca_open_up(dbm, dim, history_clock_id_map, prophecy_clock_id_map, normal_clock_id_map);
   }
   for(auto invar:invariant)
     if (tchecker::dbm::eca_constrain_single(dbm, dim, invar, history_clock_id_map, prophecy_clock_id_map, normal_clock_id_map) == tchecker::dbm::EMPTY)
@@ -159,7 +172,8 @@ tchecker::state_status_t eca_gen2_semantics_t::next(tchecker::dbm::db_t * dbm,
                                                    tchecker::clock_constraint_container_t const & tgt_invariant,
                                                    const std::unordered_set<int> & history_clock_id_map,
                                                    const std::unordered_set<int> & prophecy_clock_id_map,
-                                                   const std::unordered_set<int> & normal_clock_id_map)
+                                                   const std::unordered_set<int> & normal_clock_id_map,
+                                                   tchecker::dbm::clock_layout_t const * layout)
 {
 
   assert(tchecker::dbm::eca_is_consistent(dbm, dim, history_clock_id_map, prophecy_clock_id_map, normal_clock_id_map));
@@ -207,7 +221,10 @@ tchecker::state_status_t eca_gen2_semantics_t::next(tchecker::dbm::db_t * dbm,
 
   //time elapse
   if (tgt_delay_allowed) {
-    tchecker::dbm::eca_open_up(dbm, dim, history_clock_id_map, prophecy_clock_id_map, normal_clock_id_map);
+    if (layout != nullptr)
+      tchecker::dbm::eca_open_up(dbm, dim, *layout);
+    else
+      tchecker::dbm::eca_open_up(dbm, dim, history_clock_id_map, prophecy_clock_id_map, normal_clock_id_map);
   }
   
   for(auto tgt_inv:tgt_invariant)  
@@ -223,15 +240,29 @@ tchecker::state_status_t eca_gen2_semantics_t::next(tchecker::dbm::db_t * dbm,
 bool eca_gen2_semantics_t::is_final_dbm(tchecker::dbm::db_t const* dbm, tchecker::clock_id_t dim,
                                     const std::unordered_set<int> & history_clock_id_map,
                                     const std::unordered_set<int> & prophecy_clock_id_map,
-                                    const std::unordered_set<int> & normal_clock_id_map)
+                                    const std::unordered_set<int> & normal_clock_id_map,
+                                    tchecker::dbm::clock_layout_t const * layout)
                                     {
   
   
 
 
+  if (layout != nullptr)
+    return tchecker::dbm::eca_is_final_dbm(dbm, dim, *layout);
   return tchecker::dbm::eca_is_final_dbm(dbm,dim,history_clock_id_map,prophecy_clock_id_map,normal_clock_id_map);
 }
 
+void eca_gen2_semantics_t::normalize(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim,
+                                     boost::dynamic_bitset<> const & inactive_clocks,
+                                     const std::unordered_set<int> & history_clock_id_map,
+                                     const std::unordered_set<int> & prophecy_clock_id_map,
+                                     const std::unordered_set<int> & normal_clock_id_map)
+{
+  for(auto i:history_clock_id_map) //i is the index of clock i-1 in dbm
+    if(inactive_clocks[i-1])
+      tchecker::dbm::eca_unbound_history(dbm, dim, i, history_clock_id_map, prophecy_clock_id_map, normal_clock_id_map);
+}
+
 
 
 
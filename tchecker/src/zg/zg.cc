@@ -5,13 +5,108 @@
  *
  */
 
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
 #include "tchecker/zg/zg.hh"
+#include "tchecker/clockbounds/solver.hh"
+#include "tchecker/dbm/compact.hh"
 #include "tchecker/dbm/db.hh"
+#include "tchecker/dbm/dbm.hh"
+#include "tchecker/utils/counters.hh"
 
 namespace tchecker {
 
 namespace zg {
 
+/*!
+ \brief Add the clocks of clock constraints to a set of clocks
+ \param c : clock constraints
+ \param clocks : set of clock identifiers
+ \post the clocks in c have been added to clocks
+ */
+static void add_clocks(tchecker::clock_constraint_container_t const & c, boost::dynamic_bitset<> & clocks)
+{
+  for (tchecker::clock_constraint_t const & cc : c) {
+    if (cc.id1() != tchecker::REFCLOCK_ID)
+      clocks.set(cc.id1());
+    if (cc.id2() != tchecker::REFCLOCK_ID)
+      clocks.set(cc.id2());
+  }
+}
+
+/*!
+ \brief Add the clocks of clock resets to a set of clocks
+ \param r : clock resets
+ \param clocks : set of clock identifiers
+ \post the clocks in r have been added to clocks
+ */
+static void add_clocks(tchecker::clock_reset_container_t const & r, boost::dynamic_bitset<> & clocks)
+{
+  for (tchecker::clock_reset_t const & cr : r) {
+    clocks.set(cr.left_id());
+    if (cr.right_id() != tchecker::REFCLOCK_ID)
+      clocks.set(cr.right_id());
+  }
+}
+
+/*!
+ \brief Compute next zone on the DBM projected on a subset of clocks
+ \param system : a system of timed processes
+ \param projection : a projection of DBMs
+ \param dbm : a DBM
+ \param dim : dimension of dbm
+ \param inactive_clocks : inactive clocks in the target state
+ \pre the clocks that are not kept by projection are unbounded history clocks in
+ dbm that do not appear in the invariants, guard and reset
+ \post see tchecker::zg::semantics_t::next and tchecker::zg::semantics_t::normalize
+ \return see tchecker::zg::semantics_t::next
+ \note the zone operations only involve the clocks kept by projection, the other
+ clocks are restored by tchecker::dbm::eca_expand
+ */
+static tchecker::state_status_t projected_next(tchecker::ta::clock_projection_t const & projection,
+                                               tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, bool src_delay_allowed,
+                                               tchecker::clock_constraint_container_t const & src_invariant,
+                                               tchecker::clock_constraint_container_t const & guard,
+                                               tchecker::clock_reset_container_t const & reset, bool tgt_delay_allowed,
+                                               tchecker::clock_constraint_container_t const & tgt_invariant,
+                                               boost::dynamic_bitset<> const & inactive_clocks,
+                                               tchecker::zg::semantics_t & semantics)
+{
+  tchecker::clock_id_t const pdim = projection.dim();
+  std::vector<tchecker::dbm::db_t> pdbm(pdim * pdim);
+  tchecker::dbm::project(dbm, dim, projection.index().data(), pdim, pdbm.data());
+
+  tchecker::clock_constraint_container_t psrc_invariant, pguard, ptgt_invariant;
+  tchecker::clock_reset_container_t preset;
+  for (tchecker::clock_constraint_t const & c : src_invariant)
+    psrc_invariant.push_back(projection.project(c));
+  for (tchecker::clock_constraint_t const & c : guard)
+    pguard.push_back(projection.project(c));
+  for (tchecker::clock_reset_t const & r : reset)
+    preset.push_back(projection.project(r));
+  for (tchecker::clock_constraint_t const & c : tgt_invariant)
+    ptgt_invariant.push_back(projection.project(c));
+
+  tchecker::state_status_t status =
+      semantics.next(pdbm.data(), pdim, src_delay_allowed, psrc_invariant, pguard, preset, tgt_delay_allowed, ptgt_invariant,
+                     projection.history_clock_ids(), projection.prophecy_clock_ids(), projection.normal_clock_ids(),
+                     projection.clock_layout());
+  if (status != tchecker::STATE_OK)
+    return status;
+
+  boost::dynamic_bitset<> pinactive_clocks(pdim - 1);
+  for (tchecker::clock_id_t i = 2; i < pdim; ++i)
+    pinactive_clocks[i - 1] = inactive_clocks[projection.index()[i] - 1];
+  semantics.normalize(pdbm.data(), pdim, pinactive_clocks, projection.history_clock_ids(), projection.prophecy_clock_ids(),
+                      projection.normal_clock_ids());
+
+  tchecker::dbm::eca_expand(dbm, dim, pdbm.data(), projection.index().data(), pdim);
+  return tchecker::STATE_OK;
+}
+
 /* Semantics functions */
 
 tchecker::state_status_t initial(tchecker::ta::system_t const & system,
@@ -22,7 +117,8 @@ tchecker::state_status_t initial(tchecker::ta::system_t const & system,
                                  tchecker::clock_constraint_container_t & invariant, 
                                  tchecker::zg::semantics_t & semantics,
                                  tchecker::zg::extrapolation_t & extrapolation,
-                                 tchecker::zg::initial_value_t const & initial_range)
+                                 tchecker::zg::initial_value_t const & initial_range,
+                                 tchecker::ta::clock_liveness_t const * liveness)
 {
   tchecker::state_status_t status = tchecker::ta::initial(system, vloc, intval, vedge, invariant, initial_range);
   if (status != tchecker::STATE_OK)
@@ -32,11 +128,17 @@ tchecker::state_status_t initial(tchecker::ta::system_t const & system,
   tchecker::clock_id_t dim = zone->dim();
   bool delay_allowed = tchecker::ta::delay_allowed(system, *vloc);
 
-  status = semantics.initial(dbm, dim, delay_allowed, invariant, system.history_clock_id_map, system.prophecy_clock_id_map, system.normal_clock_id_map);
+  status = semantics.initial(dbm, dim, delay_allowed, invariant, system.history_clock_id_map, system.prophecy_clock_id_map, system.normal_clock_id_map, system.clock_layout());
 
   if (status != tchecker::STATE_OK)
     return status;
 
+  if (liveness != nullptr) {
+    boost::dynamic_bitset<> inactive_clocks;
+    liveness->inactive_clocks(*vloc, inactive_clocks);
+    semantics.normalize(dbm, dim, inactive_clocks, system.history_clock_id_map, system.prophecy_clock_id_map, system.normal_clock_id_map);
+  }
+
   extrapolation.extrapolate(dbm, dim, *vloc);
 
   return tchecker::STATE_OK;
@@ -53,9 +155,18 @@ tchecker::state_status_t next(tchecker::ta::system_t const & system,
                               tchecker::clock_constraint_container_t & tgt_invariant, 
                               tchecker::zg::semantics_t & semantics,
                               tchecker::zg::extrapolation_t & extrapolation, 
-                              tchecker::zg::outgoing_edges_value_t const & edges)
+                              tchecker::zg::outgoing_edges_value_t const & edges,
+                              tchecker::ta::clock_liveness_t const * liveness)
 {
   bool src_delay_allowed = tchecker::ta::delay_allowed(system, *vloc);
+
+  // clocks that are not active in the source state are unbounded (normalised)
+  boost::dynamic_bitset<> clocks;
+  if (liveness != nullptr && !liveness->trivial()) {
+    liveness->inactive_clocks(*vloc, clocks);
+    clocks.flip();
+  }
+
   tchecker::state_status_t status =
       tchecker::ta::next(system, vloc, intval, vedge, src_invariant, guard, reset, tgt_invariant, edges);
   if (status != tchecker::STATE_OK)
@@ -66,15 +177,40 @@ tchecker::state_status_t next(tchecker::ta::system_t const & system,
   tchecker::clock_id_t dim = zone->dim();
   bool tgt_delay_allowed = tchecker::ta::delay_allowed(system, *vloc);
 
+  // Only the clocks that are active in the source state or that appear in the
+  // transition may be bounded in the target state: the zone operations are
+  // applied to the DBM projected on these clocks
+  if (!clocks.empty()) {
+    add_clocks(src_invariant, clocks);
+    add_clocks(guard, clocks);
+    add_clocks(reset, clocks);
+    add_clocks(tgt_invariant, clocks);
+    if (!clocks.all()) {
+      boost::dynamic_bitset<> inactive_clocks;
+      liveness->inactive_clocks(*vloc, inactive_clocks);
+      status = projected_next(*liveness->projection(clocks), dbm, dim, src_delay_allowed, src_invariant, guard, reset,
+                              tgt_delay_allowed, tgt_invariant, inactive_clocks, semantics);
+      if (status != tchecker::STATE_OK)
+        return status;
+      extrapolation.extrapolate(dbm, dim, *vloc);
+      return tchecker::STATE_OK;
+    }
+  }
+
   tchecker::system::edge_const_shared_ptr_t tmp_edge; 
   for (tchecker::system::edge_const_shared_ptr_t const & edge : edges){
     tmp_edge = edge;
   }
-  status = semantics.next(dbm, dim, src_delay_allowed, src_invariant, guard, reset, tgt_delay_allowed, tgt_invariant,system.history_clock_id_map,system.prophecy_clock_id_map,system.normal_clock_id_map);
+  status = semantics.next(dbm, dim, src_delay_allowed, src_invariant, guard, reset, tgt_delay_allowed, tgt_invariant,system.history_clock_id_map,system.prophecy_clock_id_map,system.normal_clock_id_map,system.clock_layout());
   
   if (status != tchecker::STATE_OK)
     return status;
 
+  if (liveness != nullptr) {
+    boost::dynamic_bitset<> inactive_clocks;
+    liveness->inactive_clocks(*vloc, inactive_clocks);
+    semantics.normalize(dbm, dim, inactive_clocks, system.history_clock_id_map, system.prophecy_clock_id_map, system.normal_clock_id_map);
+  }
   
   extrapolation.extrapolate(dbm, dim, *vloc);
   
@@ -104,16 +240,58 @@ void attributes(tchecker::ta::system_t const & system, tchecker::zg::transition_
   tchecker::ta::attributes(system, t, m);
 }
 
+/* zone_storage_stats_t */
+
+std::string to_string(enum tchecker::zg::zone_storage_t storage)
+{
+  switch (storage) {
+  case tchecker::zg::ZONE_FULL:
+    return "full";
+  case tchecker::zg::ZONE_COMPACT:
+    return "compact";
+  case tchecker::zg::ZONE_REDUCED:
+    return "reduced";
+  default:
+    throw std::invalid_argument("Unknown zone storage");
+  }
+}
+
+zone_storage_stats_t::zone_storage_stats_t() : _zones{0, 0, 0}, _bytes(0), _full_bytes(0) {}
+
+void zone_storage_stats_t::count(enum tchecker::zg::zone_storage_t storage, std::size_t bytes, std::size_t full_bytes)
+{
+  ++_zones[storage];
+  _bytes += bytes;
+  _full_bytes += full_bytes;
+}
+
+unsigned long zone_storage_stats_t::zones(enum tchecker::zg::zone_storage_t storage) const { return _zones[storage]; }
+
+unsigned long long zone_storage_stats_t::bytes() const { return _bytes; }
+
+unsigned long long zone_storage_stats_t::full_bytes() const { return _full_bytes; }
+
+void zone_storage_stats_t::attributes(std::map<std::string, std::string> & m) const
+{
+  m["ZONES_FULL"] = std::to_string(_zones[tchecker::zg::ZONE_FULL]);
+  m["ZONES_COMPACT"] = std::to_string(_zones[tchecker::zg::ZONE_COMPACT]);
+  m["ZONES_REDUCED"] = std::to_string(_zones[tchecker::zg::ZONE_REDUCED]);
+  m["ZONES_BYTES"] = std::to_string(_bytes);
+  m["ZONES_FULL_BYTES"] = std::to_string(_full_bytes);
+}
+
 /* zg_t */
 
 zg_t::zg_t(std::shared_ptr<tchecker::ta::system_t const> const & system,
            std::unique_ptr<tchecker::zg::semantics_t> && semantics,
-           std::unique_ptr<tchecker::zg::extrapolation_t> && extrapolation, std::size_t block_size)
+           std::unique_ptr<tchecker::zg::extrapolation_t> && extrapolation, std::size_t block_size,
+           std::shared_ptr<tchecker::ta::clock_liveness_t const> const & liveness)
     : _system(system), _semantics(std::move(semantics)), _extrapolation(std::move(extrapolation)),
       _state_allocator(block_size, block_size, _system->processes_count(), block_size,
                        _system->intvars_count(tchecker::VK_FLATTENED), block_size,
                        _system->clocks_count(tchecker::VK_FLATTENED) + 1),
-      _transition_allocator(block_size, block_size, _system->processes_count())
+      _transition_allocator(block_size, block_size, _system->processes_count()), _liveness(liveness),
+      _zone_storage(tchecker::zg::ZONE_FULL)
 {
 }
 
@@ -125,7 +303,9 @@ void zg_t::initial(tchecker::zg::initial_value_t const & init_edge, std::vector<
   tchecker::zg::state_sptr_t s = _state_allocator.construct();
   tchecker::zg::transition_sptr_t t = _transition_allocator.construct();
   
-  tchecker::state_status_t status = tchecker::zg::initial(*_system, *s, *t, *_semantics, *_extrapolation, init_edge);
+  tchecker::state_status_t status =
+      tchecker::zg::initial(*_system, *s, *t, *_semantics, *_extrapolation, init_edge, _liveness.get());
+  store(status, s);
   v.push_back(std::make_tuple(status, s, t));
 }
 
@@ -137,16 +317,28 @@ tchecker::zg::outgoing_edges_range_t zg_t::outgoing_edges(tchecker::zg::const_st
 void zg_t::next(tchecker::zg::const_state_sptr_t const & s, tchecker::zg::outgoing_edges_value_t const & out_edge,
                 std::vector<sst_t> & v)
 {
+  TCHECKER_TIME(TIMER_NEXT);
   tchecker::zg::state_sptr_t nexts = _state_allocator.clone(*s);
   tchecker::zg::transition_sptr_t t = _transition_allocator.construct();
 
-  tchecker::state_status_t status = tchecker::zg::next(*_system, *nexts, *t, *_semantics, *_extrapolation, out_edge);
+  tchecker::state_status_t status =
+      tchecker::zg::next(*_system, *nexts, *t, *_semantics, *_extrapolation, out_edge, _liveness.get());
+  TCHECKER_COUNT_STATUS(status);
+  TCHECKER_COUNT_MAX(DBM_DIMENSION, nexts->zone().dim());
+  store(status, nexts);
   v.push_back(std::make_tuple(status, nexts, t));
 }
 
 bool zg_t::satisfies(tchecker::zg::const_state_sptr_t const & s, boost::dynamic_bitset<> const & labels)
 {
-  return tchecker::zg::satisfies(*_system, *s, labels) && _semantics->is_final_dbm(s->zone().dbm(),s->zone().dim(),_system->history_clock_id_map,_system->prophecy_clock_id_map,_system->normal_clock_id_map);
+  if (!tchecker::zg::satisfies(*_system, *s, labels))
+    return false;
+  tchecker::zg::zone_t const & zone = s->zone();
+  if (zone.is_full())
+    return _semantics->is_final_dbm(zone.dbm(),zone.dim(),_system->history_clock_id_map,_system->prophecy_clock_id_map,_system->normal_clock_id_map,_system->clock_layout());
+  std::vector<tchecker::dbm::db_t> dbm(zone.dim() * zone.dim());
+  zone.to_dbm(dbm.data());
+  return _semantics->is_final_dbm(dbm.data(),zone.dim(),_system->history_clock_id_map,_system->prophecy_clock_id_map,_system->normal_clock_id_map,_system->clock_layout());
 }
 
 void zg_t::attributes(tchecker::zg::const_state_sptr_t const & s, std::map<std::string, std::string> & m)
@@ -161,18 +353,43 @@ void zg_t::attributes(tchecker::zg::const_transition_sptr_t const & t, std::map<
 
 tchecker::ta::system_t const & zg_t::system() const { return *_system; }
 
+std::size_t zg_t::memsize() const { return _state_allocator.memsize() + _transition_allocator.memsize(); }
+
+void zg_t::set_zone_storage(enum tchecker::zg::zone_storage_t storage) { _zone_storage = storage; }
+
+enum tchecker::zg::zone_storage_t zg_t::zone_storage() const { return _zone_storage; }
+
+tchecker::zg::zone_storage_stats_t const & zg_t::zone_storage_stats() const { return _zone_storage_stats; }
+
+void zg_t::store(tchecker::state_status_t status, tchecker::zg::state_sptr_t & s)
+{
+  if (status != tchecker::STATE_OK)
+    return;
+
+  if (_zone_storage == tchecker::zg::ZONE_COMPACT)
+    _state_allocator.compact(s);
+  else if (_zone_storage == tchecker::zg::ZONE_REDUCED)
+    _state_allocator.reduce(s);
+
+  tchecker::zg::zone_t const & zone = s->zone();
+  _zone_storage_stats.count(zone.storage(), _state_allocator.zone_memsize(zone),
+                            tchecker::allocation_size_t<tchecker::zg::shared_zone_t>::alloc_size(
+                                static_cast<tchecker::clock_id_t>(zone.dim())));
+}
+
 /* factory */
 
 tchecker::zg::zg_t * factory(std::shared_ptr<tchecker::ta::system_t const> const & system,
                              enum tchecker::zg::semantics_type_t semantics_type,
-                             enum tchecker::zg::extrapolation_type_t extrapolation_type, std::size_t block_size)
+                             enum tchecker::zg::extrapolation_type_t extrapolation_type, std::size_t block_size,
+                             std::shared_ptr<tchecker::ta::clock_liveness_t const> const & liveness)
 {
   std::unique_ptr<tchecker::zg::extrapolation_t> extrapolation{
       tchecker::zg::extrapolation_factory(extrapolation_type, *system)};
   if (extrapolation.get() == nullptr)
     return nullptr;
   std::unique_ptr<tchecker::zg::semantics_t> semantics{tchecker::zg::semantics_factory(semantics_type)};
-  return new tchecker::zg::zg_t(system, std::move(semantics), std::move(extrapolation), block_size);
+  return new tchecker::zg::zg_t(system, std::move(semantics), std::move(extrapolation), block_size, liveness);
 }
 
 tchecker::zg::zg_t * factory(std::shared_ptr<tchecker::ta::system_t const> const & system,
@@ -188,6 +405,47 @@ tchecker::zg::zg_t * factory(std::shared_ptr<tchecker::ta::system_t const> const
   return new tchecker::zg::zg_t(system, std::move(semantics), std::move(extrapolation), block_size);
 }
 
+tchecker::zg::zg_t * factory(std::shared_ptr<tchecker::ta::system_t const> const & system,
+                             enum tchecker::zg::semantics_type_t semantics_type,
+                             enum tchecker::zg::extrapolation_type_t extrapolation_type,
+                             tchecker::eca_amap_gen2::eca_a_map_t const & amap, std::size_t block_size,
+                             std::shared_ptr<tchecker::ta::clock_liveness_t const> const & liveness)
+{
+  std::unique_ptr<tchecker::zg::extrapolation_t> extrapolation{
+      tchecker::zg::extrapolation_factory(extrapolation_type, *system, amap)};
+  std::unique_ptr<tchecker::zg::semantics_t> semantics{tchecker::zg::semantics_factory(semantics_type)};
+  return new tchecker::zg::zg_t(system, std::move(semantics), std::move(extrapolation), block_size, liveness);
+}
+
+bool compact_zones_allowed(tchecker::integer_t max_constant)
+{
+  // Differences of clocks are bounded by twice the maximal constant in
+  // extrapolated zones
+  return (max_constant <= tchecker::dbm::COMPACT_MAX_VALUE / 2);
+}
+
+bool compact_zones_allowed(tchecker::ta::system_t const & system)
+{
+  if (system.clocks_count(tchecker::VK_FLATTENED) == 0)
+    return true;
+
+  std::unique_ptr<tchecker::clockbounds::clockbounds_t> clock_bounds;
+  try {
+    clock_bounds.reset(tchecker::clockbounds::compute_clockbounds(system));
+  }
+  catch (std::runtime_error const &) {
+    // diagonal constraints are not supported by the clock bounds solver
+  }
+  if (clock_bounds.get() == nullptr)
+    return false;
+
+  tchecker::clockbounds::map_t const & M = clock_bounds->global_m_map()->M();
+  tchecker::integer_t max_constant = 0;
+  for (tchecker::clock_id_t x = 0; x < M.capacity(); ++x)
+    max_constant = std::max(max_constant, M[x]);
+  return tchecker::zg::compact_zones_allowed(max_constant);
+}
+
 } // end of namespace zg
 
 } // end of namespace tchecker
@@ -5,31 +5,59 @@
  *
  */
 
+#include <cassert>
 #include <sstream>
+#include <stdexcept>
 #include <string>
+#include <vector>
 
+#include "tchecker/dbm/compact.hh"
 #include "tchecker/dbm/dbm.hh"
+#include "tchecker/dbm/reduced.hh"
+#include "tchecker/utils/counters.hh"
 #include "tchecker/zg/zone.hh"
 
 namespace tchecker {
 
 namespace zg {
 
+/*!
+ \brief Scratch DBMs for the expansion of compact and reduced zones
+ */
+static thread_local std::vector<tchecker::dbm::db_t> scratch_dbms[2];
+
+/*!
+ \brief Zones expanded in scratch DBMs (nullptr if none)
+ */
+static thread_local tchecker::zg::zone_t const * scratch_zones[2] = {nullptr, nullptr};
+
 tchecker::zg::zone_t & zone_t::operator=(tchecker::zg::zone_t const & zone)
 {
   if (_dim != zone._dim)
     throw std::invalid_argument("Zone dimension mismatch");
+  if (!is_full())
+    throw std::invalid_argument("Compact and reduced zones cannot be assigned");
 
   if (this != &zone)
-    memcpy(dbm_ptr(), zone.dbm_ptr(), _dim * _dim * sizeof(tchecker::dbm::db_t));
+    zone.to_dbm(dbm_ptr());
 
   return *this;
 }
 
-bool zone_t::is_empty() const { return tchecker::dbm::is_empty_0(dbm_ptr(), _dim); }
-
+bool zone_t::is_empty() const
+{
+  if (is_compact())
+    return (tchecker::dbm::widen(compact_dbm_ptr()[0]) < tchecker::dbm::LE_ZERO);
+  if (is_reduced()) {
+    // (0,0) is the first constraint of a reduced DBM if it is not <=0
+    tchecker::dbm::reduced_header_t const * header = reduced_header_ptr();
+    tchecker::dbm::reduced_constraint_t const * constraints = reduced_constraints_ptr();
+    return (header->count > 0 && constraints[0].index == 0 && constraints[0].db < tchecker::dbm::LE_ZERO);
+  }
+  return tchecker::dbm::is_empty_0(dbm_ptr(), _dim);
+}
 
-bool zone_t::is_universal_positive() const { return tchecker::dbm::is_universal_positive(dbm_ptr(), _dim); }
+bool zone_t::is_universal_positive() const { return tchecker::dbm::is_universal_positive(full_dbm(0), _dim); }
 
 bool zone_t::operator==(tchecker::zg::zone_t const & zone) const
 {
@@ -38,7 +66,7 @@ bool zone_t::operator==(tchecker::zg::zone_t const & zone) const
   bool empty1 = this->is_empty(), empty2 = zone.is_empty();
   if (empty1 || empty2)
     return (empty1 && empty2);
-  return tchecker::dbm::is_equal(dbm_ptr(), zone.dbm_ptr(), _dim);
+  return tchecker::dbm::is_equal(full_dbm(0), zone.full_dbm(1), _dim);
 }
 
 bool zone_t::operator!=(tchecker::zg::zone_t const & zone) const { return !(*this == zone); }
@@ -51,7 +79,7 @@ bool zone_t::operator<=(tchecker::zg::zone_t const & zone) const
     return true;
   if (zone.is_empty())
     return false;
-  return tchecker::dbm::is_le(dbm_ptr(), zone.dbm_ptr(), _dim);
+  return tchecker::dbm::is_le(full_dbm(0), zone.full_dbm(1), _dim);
 }
 
 bool zone_t::am_le(tchecker::zg::zone_t const & zone, tchecker::clockbounds::map_t const & m) const
@@ -60,7 +88,7 @@ bool zone_t::am_le(tchecker::zg::zone_t const & zone, tchecker::clockbounds::map
     return true;
   if (zone.is_empty())
     return false;
-  return tchecker::dbm::is_am_le(dbm_ptr(), zone.dbm_ptr(), _dim, m.ptr());
+  return tchecker::dbm::is_am_le(full_dbm(0), zone.full_dbm(1), _dim, m.ptr());
 }
 
 bool zone_t::alu_le(tchecker::zg::zone_t const & zone, tchecker::clockbounds::map_t const & l,
@@ -70,7 +98,7 @@ bool zone_t::alu_le(tchecker::zg::zone_t const & zone, tchecker::clockbounds::ma
     return true;
   if (zone.is_empty())
     return false;
-  return tchecker::dbm::is_alu_le(dbm_ptr(), zone.dbm_ptr(), _dim, l.ptr(), u.ptr());
+  return tchecker::dbm::is_alu_le(full_dbm(0), zone.full_dbm(1), _dim, l.ptr(), u.ptr());
 }
 
 bool zone_t::g_le(tchecker::zg::zone_t const & zone, 
@@ -81,7 +109,7 @@ bool zone_t::g_le(tchecker::zg::zone_t const & zone,
     return true;
   if (zone.is_empty())
     return false;
-  return tchecker::dbm::is_g_le(dbm_ptr(), zone.dbm_ptr(), _dim, G, Gdf);
+  return tchecker::dbm::is_g_le(full_dbm(0), zone.full_dbm(1), _dim, G, Gdf);
 }
 
 bool zone_t::eca_g_le(tchecker::zg::zone_t const & zone, 
@@ -96,36 +124,108 @@ bool zone_t::eca_g_le(tchecker::zg::zone_t const & zone,
   if (zone.is_empty())
     return false;
 
-  return tchecker::dbm::is_eca_g_le(dbm_ptr(), zone.dbm_ptr(), _dim, G, Gdf, history_clock_id_map, prophecy_clock_id_map, normal_clock_id_map);
+  return tchecker::dbm::is_eca_g_le(full_dbm(0), zone.full_dbm(1), _dim, G, Gdf, history_clock_id_map, prophecy_clock_id_map, normal_clock_id_map);
 }
 
 int zone_t::lexical_cmp(tchecker::zg::zone_t const & zone) const
 {
-  return tchecker::dbm::lexical_cmp(dbm_ptr(), _dim, zone.dbm_ptr(), zone._dim);
+  return tchecker::dbm::lexical_cmp(full_dbm(0), _dim, zone.full_dbm(1), zone._dim);
 }
 
-std::size_t zone_t::hash() const { return tchecker::dbm::hash(dbm_ptr(), _dim); }
+std::size_t zone_t::hash() const { return tchecker::dbm::hash(full_dbm(0), _dim); }
 
 std::ostream & zone_t::output(std::ostream & os, tchecker::clock_index_t const & index) const
 {
-  return tchecker::dbm::output(os, dbm_ptr(), _dim,
+  return tchecker::dbm::output(os, full_dbm(0), _dim,
                                [&](tchecker::clock_id_t id) { return (id == 0 ? "0" : index.value(id - 1)); });
 }
 
-tchecker::dbm::db_t * zone_t::dbm() { return dbm_ptr(); }
+tchecker::dbm::db_t * zone_t::dbm()
+{
+  assert(is_full());
+  return dbm_ptr();
+}
 
-tchecker::dbm::db_t const * zone_t::dbm() const { return dbm_ptr(); }
+tchecker::dbm::db_t const * zone_t::dbm() const
+{
+  assert(is_full());
+  return dbm_ptr();
+}
 
-void zone_t::to_dbm(tchecker::dbm::db_t * dbm) const { std::memcpy(dbm, dbm_ptr(), _dim * _dim * sizeof(*dbm)); }
+void zone_t::to_dbm(tchecker::dbm::db_t * dbm) const
+{
+  if (is_full())
+    std::memcpy(dbm, dbm_ptr(), _dim * _dim * sizeof(*dbm));
+  else
+    std::memcpy(dbm, full_dbm(0), _dim * _dim * sizeof(*dbm));
+}
 
-zone_t::zone_t(tchecker::clock_id_t dim) : _dim(dim) { tchecker::dbm::universal_positive(dbm_ptr(), _dim); }
+tchecker::dbm::db_t const * zone_t::full_dbm(unsigned int scratch) const
+{
+  assert(scratch < 2);
+  if (is_full())
+    return dbm_ptr();
+  std::vector<tchecker::dbm::db_t> & scratch_dbm = scratch_dbms[scratch];
+  if (scratch_zones[scratch] == this)
+    return scratch_dbm.data();
+
+  TCHECKER_COUNT(ZONE_EXPANSIONS);
+  TCHECKER_TIME(TIMER_ZONE_EXPANSION);
+  scratch_dbm.resize(_dim * _dim);
+  if (is_compact())
+    tchecker::dbm::widen(scratch_dbm.data(), compact_dbm_ptr(), _dim);
+  else
+    tchecker::dbm::expand(scratch_dbm.data(), _dim, *reduced_header_ptr(), reduced_constraints_ptr());
+  scratch_zones[scratch] = this;
+  return scratch_dbm.data();
+}
 
-zone_t::zone_t(tchecker::zg::zone_t const & zone) : _dim(zone._dim)
+zone_t::zone_t(tchecker::clock_id_t dim) : _dim(dim), _storage(tchecker::zg::ZONE_FULL)
 {
-  memcpy(dbm_ptr(), zone.dbm_ptr(), _dim * _dim * sizeof(tchecker::dbm::db_t));
+  tchecker::dbm::universal_positive(dbm_ptr(), _dim);
 }
 
-zone_t::~zone_t() = default;
+zone_t::zone_t(tchecker::zg::zone_t const & zone) : _dim(zone._dim), _storage(tchecker::zg::ZONE_FULL)
+{
+  zone.to_dbm(dbm_ptr());
+}
+
+zone_t::zone_t(tchecker::zg::zone_t const & zone, enum tchecker::zg::zone_storage_t storage)
+    : _dim(zone._dim), _storage(storage)
+{
+  if (is_reduced())
+    throw std::invalid_argument("Reduced zones are constructed from reduced DBMs");
+  if (is_full())
+    zone.to_dbm(dbm_ptr());
+  else if (zone.is_compact())
+    std::memcpy(compact_dbm_ptr(), zone.compact_dbm_ptr(), _dim * _dim * sizeof(tchecker::dbm::compact_db_t));
+  else if (!tchecker::dbm::compact(compact_dbm_ptr(), zone.full_dbm(0), _dim))
+    throw std::invalid_argument("Zone has no compact encoding");
+}
+
+zone_t::zone_t(tchecker::clock_id_t dim, tchecker::dbm::reduced_header_t const & header,
+               tchecker::dbm::reduced_constraint_t const * constraints)
+    : _dim(dim), _storage(tchecker::zg::ZONE_REDUCED)
+{
+  *reduced_header_ptr() = header;
+  std::memcpy(reduced_constraints_ptr(), constraints, header.count * sizeof(tchecker::dbm::reduced_constraint_t));
+}
+
+zone_t::~zone_t()
+{
+  for (tchecker::zg::zone_t const *& scratch_zone : scratch_zones)
+    if (scratch_zone == this)
+      scratch_zone = nullptr;
+}
+
+bool is_compactable(tchecker::zg::zone_t const & zone)
+{
+  if (zone.is_compact())
+    return true;
+  if (zone.is_reduced())
+    return false;
+  return tchecker::dbm::is_compactable(zone.dbm(), static_cast<tchecker::clock_id_t>(zone.dim()));
+}
 
 // Allocation and deallocation
 
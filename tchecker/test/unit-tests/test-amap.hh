@@ -5,6 +5,10 @@
  *
  */
 
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <memory>
 #include <string>
 #include <unordered_set>
 
@@ -20,7 +24,12 @@
 #include "tchecker/statement/typed_statement.hh"
 #include "tchecker/variables/clocks.hh"
 #include "tchecker/variables/intvars.hh"
+#include "tchecker/clockbounds/cache.hh"
 #include "tchecker/clockbounds/solver.hh"
+#include "tchecker/parsing/declaration.hh"
+#include "tchecker/ta/system.hh"
+
+#include "testutils/utils.hh"
 
 TEST_CASE("extracting constants from expressions", "[extract_constant]")
 {
@@ -876,4 +885,369 @@ TEST_CASE("guard based optimization", "[guard_based_optimization]")
 
         REQUIRE(typed_upinv->to_string() == "x-y>2");
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("worklist fixpoint of the reduced A-map", "[compute_eca_amap]")
+{
+  std::string model = "system:amap_fixpoint \n\
+  event:a \n\
+  event:b \n\
+  event:c \n\
+  clock:history:x \n\
+  clock:history:y \n\
+  \n\
+  process:P \n\
+  location:P:l0{initial:} \n\
+  location:P:l1{} \n\
+  location:P:l2{} \n\
+  edge:P:l0:l1:a{{}} \n\
+  edge:P:l1:l2:b{{provided:x<=3;}} \n\
+  edge:P:l2:l2:c{{provided:y>=1; do:y;}} \n\
+  ";
+
+  std::unique_ptr<tchecker::parsing::system_declaration_t const> sysdecl{tchecker::test::parse(model)};
+  REQUIRE(sysdecl != nullptr);
+
+  tchecker::ta::system_t system{*sysdecl};
+
+  std::unique_ptr<tchecker::eca_amap_gen2::eca_a_map_t> amap{tchecker::eca_amap_gen2::compute_eca_amap(system)};
+  REQUIRE(amap != nullptr);
+
+  tchecker::process_id_t const P = system.process_id("P");
+  tchecker::loc_id_t const l0 = system.location(P, "l0")->id();
+  tchecker::loc_id_t const l1 = system.location(P, "l1")->id();
+
+  // x<=3 is propagated backward along a (no update on x)
+  REQUIRE_FALSE(amap->Gdf(l1).empty());
+  REQUIRE_FALSE(amap->Gdf(l0).empty());
+
+  // every edge is processed at least once
+  tchecker::amap::fixpoint_stats_t const & stats = amap->fixpoint_stats();
+  REQUIRE(stats.iterations() >= system.edges_count());
+  REQUIRE(stats.propagations() > 0);
+  REQUIRE(stats.running_time() >= 0.0);
+}
+
+/*!
+ \brief Build a non-diagonal constraint on clock x
+ \param op : operator
+ \param c : bound
+ \return x op c, allocated
+ */
+static tchecker::typed_simple_clkconstr_expression_t const * x_constraint(tchecker::binary_operator_t op, tchecker::integer_t c)
+{
+  return new tchecker::typed_simple_clkconstr_expression_t(tchecker::EXPR_TYPE_CLKCONSTR_SIMPLE, op,
+                                                           new tchecker::typed_var_expression_t(tchecker::EXPR_TYPE_CLKVAR, "x", 0, 1),
+                                                           new tchecker::typed_int_expression_t(tchecker::EXPR_TYPE_INTTERM, c));
+}
+
+TEST_CASE("index of dominant constraints", "[constraint_index]")
+{
+  std::vector<tchecker::typed_diagonal_clkconstr_expression_t const *> G;
+  std::vector<tchecker::typed_simple_clkconstr_expression_t const *> Gdf;
+  std::vector<std::unique_ptr<tchecker::typed_simple_clkconstr_expression_t const>> constraints;
+  tchecker::amap::constraint_factory_t factory;
+
+  auto add = [&](tchecker::amap::constraint_index_t & index, tchecker::binary_operator_t op, tchecker::integer_t c) {
+    constraints.emplace_back(x_constraint(op, c));
+    return index.add(Gdf, *constraints.back());
+  };
+
+  SECTION("finite bounds")
+  {
+    tchecker::amap::constraint_index_t index{false, factory};
+
+    REQUIRE(add(index, tchecker::EXPR_OP_LE, 3));
+    REQUIRE(add(index, tchecker::EXPR_OP_GT, 1));
+    REQUIRE(Gdf.size() == 2);
+
+    REQUIRE(add(index, tchecker::EXPR_OP_LT, 5)); // x<5 replaces x<=3 in place
+    REQUIRE(Gdf.size() == 2);
+    REQUIRE(Gdf[0] == factory.intern(*constraints[2]));
+
+    REQUIRE_FALSE(add(index, tchecker::EXPR_OP_LT, 4));
+    REQUIRE_FALSE(add(index, tchecker::EXPR_OP_LT, 5));
+    REQUIRE(add(index, tchecker::EXPR_OP_LE, 5));
+    REQUIRE(Gdf[0] == factory.intern(*constraints.back()));
+
+    REQUIRE_FALSE(add(index, tchecker::EXPR_OP_GE, 1)); // x>1 dominates x>=1
+    REQUIRE(add(index, tchecker::EXPR_OP_GE, 2));
+    REQUIRE(Gdf.size() == 2);
+    REQUIRE(Gdf[1] == factory.intern(*constraints.back()));
+  }
+
+  SECTION("infinite bounds")
+  {
+    tchecker::amap::constraint_index_t index{true, factory};
+
+    REQUIRE(add(index, tchecker::EXPR_OP_LE, 3));
+    REQUIRE(add(index, tchecker::EXPR_OP_LT, tchecker::dbm::INF_VALUE));
+    REQUIRE(add(index, tchecker::EXPR_OP_LE, tchecker::dbm::INF_VALUE));
+    REQUIRE_FALSE(add(index, tchecker::EXPR_OP_LT, tchecker::dbm::INF_VALUE));
+    REQUIRE(add(index, tchecker::EXPR_OP_LE, tchecker::dbm::MINUS_INF_VALUE));
+    REQUIRE(add(index, tchecker::EXPR_OP_LE, 4));
+    REQUIRE(Gdf.size() == 4);
+    REQUIRE(Gdf[0] == factory.intern(*constraints.back()));
+  }
+
+  SECTION("building the index")
+  {
+    tchecker::amap::constraint_index_t index{false, factory};
+    REQUIRE(add(index, tchecker::EXPR_OP_LE, 3));
+
+    tchecker::amap::constraint_index_t rebuilt{false, factory};
+    rebuilt.build(G, Gdf);
+    REQUIRE_FALSE(add(rebuilt, tchecker::EXPR_OP_LE, 2));
+    REQUIRE(add(rebuilt, tchecker::EXPR_OP_LE, 7));
+    REQUIRE(Gdf.size() == 1);
+  }
+}
+
+TEST_CASE("interned clock constraints", "[constraint_factory]")
+{
+  tchecker::amap::constraint_factory_t factory;
+  tchecker::typed_var_expression_t const x{tchecker::EXPR_TYPE_CLKVAR, "x", 0, 1};
+  tchecker::typed_var_expression_t const y{tchecker::EXPR_TYPE_CLKVAR, "y", 1, 1};
+
+  SECTION("non-diagonal constraints")
+  {
+    tchecker::typed_simple_clkconstr_expression_t const * x_le_3 = factory.simple(x, tchecker::EXPR_OP_LE, 3);
+    REQUIRE(factory.simple(x, tchecker::EXPR_OP_LE, 3) == x_le_3);
+    REQUIRE(factory.simple(x, tchecker::EXPR_OP_LT, 3) != x_le_3);
+    REQUIRE(factory.simple(x, tchecker::EXPR_OP_LE, 4) != x_le_3);
+    REQUIRE(factory.simple(y, tchecker::EXPR_OP_LE, 3) != x_le_3);
+    REQUIRE(factory.size() == 4);
+
+    std::unique_ptr<tchecker::typed_simple_clkconstr_expression_t const> c{x_constraint(tchecker::EXPR_OP_LE, 3)};
+    REQUIRE(factory.intern(*c) == x_le_3);
+    REQUIRE(factory.size() == 4);
+    REQUIRE(x_le_3->to_string() == c->to_string());
+  }
+
+  SECTION("diagonal constraints")
+  {
+    tchecker::typed_diagonal_clkconstr_expression_t const * d = factory.diagonal(x, y, tchecker::EXPR_OP_LT, -2);
+    REQUIRE(factory.diagonal(x, y, tchecker::EXPR_OP_LT, -2) == d);
+    REQUIRE(factory.diagonal(y, x, tchecker::EXPR_OP_LT, -2) != d);
+    REQUIRE(factory.intern(*d) == d);
+    REQUIRE(factory.size() == 2);
+    REQUIRE(tchecker::const_evaluate(d->bound()) == -2);
+  }
+
+  SECTION("index of interned constraints")
+  {
+    std::vector<tchecker::typed_diagonal_clkconstr_expression_t const *> G;
+    std::vector<tchecker::typed_simple_clkconstr_expression_t const *> Gdf;
+    tchecker::amap::constraint_index_t index{false, factory};
+
+    std::unique_ptr<tchecker::typed_simple_clkconstr_expression_t const> c{x_constraint(tchecker::EXPR_OP_LE, 3)};
+    REQUIRE(index.add(Gdf, *c));
+    REQUIRE(Gdf.size() == 1);
+    REQUIRE(Gdf[0] != c.get()); // c is not owned by the factory
+    REQUIRE(Gdf[0] == factory.simple(x, tchecker::EXPR_OP_LE, 3));
+
+    tchecker::typed_diagonal_clkconstr_expression_t const * d = factory.diagonal(x, y, tchecker::EXPR_OP_LE, 1);
+    REQUIRE(index.add(G, *d));
+    REQUIRE_FALSE(index.add(G, *factory.diagonal(x, y, tchecker::EXPR_OP_LE, 1)));
+    REQUIRE(G.size() == 1);
+  }
+}
+
+TEST_CASE("reduced A-map computed over strongly connected components", "[compute_eca_amap]")
+{
+  std::string model = "system:amap_sccs \n\
+  event:a \n\
+  event:b \n\
+  event:c \n\
+  clock:history:x \n\
+  clock:history:y \n\
+  clock:history:z \n\
+  \n\
+  process:P \n\
+  location:P:l0{initial:} \n\
+  location:P:l1{} \n\
+  location:P:l2{} \n\
+  edge:P:l0:l1:a{{provided:x>=1;}} \n\
+  edge:P:l1:l0:b{{provided:; do:x;}} \n\
+  edge:P:l1:l2:c{{provided:y<=4;}} \n\
+  \n\
+  process:Q \n\
+  location:Q:m0{initial:} \n\
+  location:Q:m1{} \n\
+  edge:Q:m0:m1:a{{}} \n\
+  edge:Q:m1:m1:c{{provided:z<2; do:z;}} \n\
+  ";
+
+  std::unique_ptr<tchecker::parsing::system_declaration_t const> sysdecl{tchecker::test::parse(model)};
+  REQUIRE(sysdecl != nullptr);
+
+  tchecker::ta::system_t system{*sysdecl};
+
+  std::unique_ptr<tchecker::eca_amap_gen2::eca_a_map_t> sequential{tchecker::eca_amap_gen2::compute_eca_amap(system, 1)};
+  std::unique_ptr<tchecker::eca_amap_gen2::eca_a_map_t> parallel{tchecker::eca_amap_gen2::compute_eca_amap(system, 4)};
+  REQUIRE(sequential != nullptr);
+  REQUIRE(parallel != nullptr);
+
+  // {l0, l1}, {l2}, {m0}, {m1}
+  REQUIRE(sequential->fixpoint_stats().sccs() == 4);
+  REQUIRE(parallel->fixpoint_stats().sccs() == 4);
+  REQUIRE(parallel->fixpoint_stats().threads() == 4);
+
+  // same constraints in every location, regardless of the number of threads
+  auto constraints = [](tchecker::eca_amap_gen2::eca_a_map_t const & amap, tchecker::loc_id_t id) {
+    std::unordered_set<std::string> s;
+    for (tchecker::typed_diagonal_clkconstr_expression_t const * diag : amap.G(id))
+      s.insert(diag->to_string());
+    for (tchecker::typed_simple_clkconstr_expression_t const * nondiag : amap.Gdf(id))
+      s.insert(nondiag->to_string());
+    return s;
+  };
+
+  for (tchecker::system::loc_const_shared_ptr_t const & loc : system.locations())
+    REQUIRE(constraints(*sequential, loc->id()) == constraints(*parallel, loc->id()));
+
+  // y<=4 is propagated from l1 to l0 inside the SCC {l0, l1}
+  tchecker::loc_id_t const l0 = system.location(system.process_id("P"), "l0")->id();
+  REQUIRE(constraints(*sequential, l0).count("y<=4") == 1);
+}
+
+TEST_CASE("cache of reduced A-maps and clock bounds", "[clockbounds_cache]")
+{
+  std::string model = "system:amap_cache \n\
+  event:a \n\
+  event:b \n\
+  clock:history:x \n\
+  clock:history:y \n\
+  \n\
+  process:P \n\
+  location:P:l0{initial:} \n\
+  location:P:l1{} \n\
+  edge:P:l0:l1:a{{provided:x>=1;}} \n\
+  edge:P:l1:l0:b{{provided:y<=4; do:x;}} \n\
+  ";
+
+  std::string ta_model = "system:bounds_cache \n\
+  event:a \n\
+  clock:1:x \n\
+  clock:1:y \n\
+  \n\
+  process:P \n\
+  location:P:l0{initial: : invariant:x<=3} \n\
+  location:P:l1{} \n\
+  edge:P:l0:l1:a{provided:y>5 : do:x=0} \n\
+  ";
+
+  std::filesystem::path const dir = std::filesystem::temp_directory_path() / "tchecker-unittest-clockbounds-cache";
+  std::filesystem::remove_all(dir);
+
+  auto constraints = [](tchecker::eca_amap_gen2::eca_a_map_t const & amap, tchecker::loc_id_t id) {
+    std::unordered_set<std::string> s;
+    for (tchecker::typed_diagonal_clkconstr_expression_t const * diag : amap.G(id))
+      s.insert(diag->to_string());
+    for (tchecker::typed_simple_clkconstr_expression_t const * nondiag : amap.Gdf(id))
+      s.insert(nondiag->to_string());
+    return s;
+  };
+
+  SECTION("reduced A-maps are loaded from the cache")
+  {
+    std::unique_ptr<tchecker::parsing::system_declaration_t const> sysdecl{tchecker::test::parse(model)};
+    REQUIRE(sysdecl != nullptr);
+    tchecker::ta::system_t system{*sysdecl};
+
+    tchecker::clockbounds::cache_t cache{dir.string(), model};
+    REQUIRE(cache.load_eca_amap(system) == nullptr);
+
+    std::unique_ptr<tchecker::eca_amap_gen2::eca_a_map_t> computed{tchecker::eca_amap_gen2::compute_eca_amap(system)};
+    REQUIRE(computed != nullptr);
+    REQUIRE(cache.store_eca_amap(system, *computed));
+
+    std::unique_ptr<tchecker::eca_amap_gen2::eca_a_map_t> loaded{cache.load_eca_amap(system)};
+    REQUIRE(loaded != nullptr);
+    for (tchecker::system::loc_const_shared_ptr_t const & loc : system.locations())
+      REQUIRE(constraints(*loaded, loc->id()) == constraints(*computed, loc->id()));
+
+    // entries of one kind are not loaded as another kind
+    REQUIRE(cache.load_amap(system) == nullptr);
+
+    std::map<std::string, std::string> m;
+    cache.attributes(m);
+    REQUIRE(m["CACHE_HITS"] == "1");
+    REQUIRE(m["CACHE_MISSES"] == "2");
+    REQUIRE(m["CACHE_STORES"] == "1");
+  }
+
+  SECTION("clock bounds are loaded from the cache")
+  {
+    std::unique_ptr<tchecker::parsing::system_declaration_t const> sysdecl{tchecker::test::parse(ta_model)};
+    REQUIRE(sysdecl != nullptr);
+    tchecker::ta::system_t system{*sysdecl};
+
+    tchecker::clockbounds::cache_t cache{dir.string(), ta_model};
+    std::unique_ptr<tchecker::clockbounds::clockbounds_t> computed{tchecker::clockbounds::compute_clockbounds(system)};
+    REQUIRE(computed != nullptr);
+    REQUIRE(cache.store_clockbounds(system, *computed));
+
+    std::unique_ptr<tchecker::clockbounds::clockbounds_t> loaded{cache.load_clockbounds(system)};
+    REQUIRE(loaded != nullptr);
+
+    tchecker::clock_id_t const clock_nb = computed->clock_number();
+    REQUIRE(loaded->clock_number() == clock_nb);
+    for (tchecker::clock_id_t i = 0; i < clock_nb; ++i) {
+      REQUIRE(loaded->global_lu_map()->L()[i] == computed->global_lu_map()->L()[i]);
+      REQUIRE(loaded->global_lu_map()->U()[i] == computed->global_lu_map()->U()[i]);
+      REQUIRE(loaded->global_m_map()->M()[i] == computed->global_m_map()->M()[i]);
+      for (tchecker::system::loc_const_shared_ptr_t const & loc : system.locations()) {
+        REQUIRE(loaded->local_lu_map()->L(loc->id())[i] == computed->local_lu_map()->L(loc->id())[i]);
+        REQUIRE(loaded->local_lu_map()->U(loc->id())[i] == computed->local_lu_map()->U(loc->id())[i]);
+        REQUIRE(loaded->local_m_map()->M(loc->id())[i] == computed->local_m_map()->M(loc->id())[i]);
+      }
+    }
+  }
+
+  SECTION("mismatching entries are not loaded")
+  {
+    std::unique_ptr<tchecker::parsing::system_declaration_t const> sysdecl{tchecker::test::parse(model)};
+    REQUIRE(sysdecl != nullptr);
+    tchecker::ta::system_t system{*sysdecl};
+
+    tchecker::clockbounds::cache_t cache{dir.string(), model};
+    std::unique_ptr<tchecker::eca_amap_gen2::eca_a_map_t> computed{tchecker::eca_amap_gen2::compute_eca_amap(system)};
+    REQUIRE(computed != nullptr);
+    REQUIRE(cache.store_eca_amap(system, *computed));
+
+    std::string const path = cache.path(tchecker::clockbounds::cache_t::KIND_ECA_AMAP);
+    std::string contents;
+    {
+      std::ifstream ifs{path, std::ios::binary};
+      contents.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+    }
+    REQUIRE(contents.size() > 12);
+
+    // another model
+    tchecker::clockbounds::cache_t other{dir.string(), model + " "};
+    REQUIRE(other.path(tchecker::clockbounds::cache_t::KIND_ECA_AMAP) != path);
+    REQUIRE(other.load_eca_amap(system) == nullptr);
+
+    // another format version
+    std::string patched = contents;
+    patched[8] = static_cast<char>(patched[8] + 1);
+    std::ofstream{path, std::ios::binary | std::ios::trunc} << patched;
+    REQUIRE(cache.load_eca_amap(system) == nullptr);
+
+    // truncated entry
+    std::ofstream{path, std::ios::binary | std::ios::trunc} << contents.substr(0, contents.size() - 1);
+    REQUIRE(cache.load_eca_amap(system) == nullptr);
+
+    // trailing bytes
+    std::ofstream{path, std::ios::binary | std::ios::trunc} << contents << "x";
+    REQUIRE(cache.load_eca_amap(system) == nullptr);
+
+    // original entry
+    std::ofstream{path, std::ios::binary | std::ios::trunc} << contents;
+    std::unique_ptr<tchecker::eca_amap_gen2::eca_a_map_t> loaded{cache.load_eca_amap(system)};
+    REQUIRE(loaded != nullptr);
+  }
+
+  std::filesystem::remove_all(dir);
+}
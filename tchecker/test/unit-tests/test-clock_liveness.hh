@@ -0,0 +1,123 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <memory>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include "tchecker/basictypes.hh"
+#include "tchecker/parsing/declaration.hh"
+#include "tchecker/syncprod/vloc.hh"
+#include "tchecker/ta/clock_liveness.hh"
+#include "tchecker/ta/system.hh"
+
+#include "testutils/utils.hh"
+
+TEST_CASE("live clocks and inactive history clocks", "[clock_liveness]")
+{
+  std::string model = "system:clock_liveness \n\
+  event:a \n\
+  event:b \n\
+  event:c \n\
+  clock:history:x \n\
+  clock:history:y \n\
+  clock:history:z \n\
+  \n\
+  process:P1 \n\
+  location:P1:l0{initial:} \n\
+  location:P1:l1{} \n\
+  location:P1:l2{} \n\
+  edge:P1:l0:l1:a{{provided:x<=2; do:y;}} \n\
+  edge:P1:l1:l2:b{{provided:y<=1; do:x;}} \n\
+  \n\
+  process:P2 \n\
+  location:P2:l0{initial:} \n\
+  location:P2:l1{} \n\
+  edge:P2:l0:l1:c{{provided:z>=1;}} \n\
+  ";
+
+  std::unique_ptr<tchecker::parsing::system_declaration_t const> sysdecl{tchecker::test::parse(model)};
+  REQUIRE(sysdecl != nullptr);
+
+  tchecker::ta::system_t system{*sysdecl};
+  tchecker::ta::clock_liveness_t liveness{system};
+
+  tchecker::process_id_t const P1 = system.process_id("P1");
+  tchecker::process_id_t const P2 = system.process_id("P2");
+
+  tchecker::loc_id_t const P1_l0 = system.location(P1, "l0")->id();
+  tchecker::loc_id_t const P1_l1 = system.location(P1, "l1")->id();
+  tchecker::loc_id_t const P1_l2 = system.location(P1, "l2")->id();
+  tchecker::loc_id_t const P2_l0 = system.location(P2, "l0")->id();
+  tchecker::loc_id_t const P2_l1 = system.location(P2, "l1")->id();
+
+  tchecker::clock_id_t const x = system.clock_id("x");
+  tchecker::clock_id_t const y = system.clock_id("y");
+  tchecker::clock_id_t const z = system.clock_id("z");
+
+  SECTION("Live clocks")
+  {
+    REQUIRE_FALSE(liveness.trivial());
+
+    REQUIRE(liveness.live_clocks(P1_l0)[x]);
+    REQUIRE_FALSE(liveness.live_clocks(P1_l0)[y]); // y is reset before it is read
+    REQUIRE_FALSE(liveness.live_clocks(P1_l0)[z]);
+
+    REQUIRE_FALSE(liveness.live_clocks(P1_l1)[x]);
+    REQUIRE(liveness.live_clocks(P1_l1)[y]);
+
+    REQUIRE(liveness.live_clocks(P1_l2).none());
+
+    REQUIRE(liveness.live_clocks(P2_l0)[z]);
+    REQUIRE(liveness.live_clocks(P2_l1).none());
+  }
+
+  SECTION("Inactive clocks")
+  {
+    tchecker::vloc_t * vloc = tchecker::vloc_allocate_and_construct(system.processes_count(), system.processes_count());
+    boost::dynamic_bitset<> inactive;
+
+    (*vloc)[P1] = P1_l0;
+    (*vloc)[P2] = P2_l0;
+    liveness.inactive_clocks(*vloc, inactive);
+    REQUIRE_FALSE(inactive[x]);
+    REQUIRE(inactive[y]);
+    REQUIRE_FALSE(inactive[z]);
+
+    (*vloc)[P1] = P1_l2;
+    (*vloc)[P2] = P2_l1;
+    liveness.inactive_clocks(*vloc, inactive);
+    REQUIRE(inactive[x]);
+    REQUIRE(inactive[y]);
+    REQUIRE(inactive[z]);
+
+    tchecker::vloc_destruct_and_deallocate(vloc);
+  }
+
+  SECTION("Projections")
+  {
+    boost::dynamic_bitset<> clocks(system.clocks_count(tchecker::VK_FLATTENED));
+    clocks.set(x);
+    clocks.set(z);
+
+    std::shared_ptr<tchecker::ta::clock_projection_t const> projection = liveness.projection(clocks);
+    REQUIRE(projection.get() == liveness.projection(clocks).get()); // memoised
+
+    REQUIRE(projection->dim() == 4); // reference clock, "tmp" clock, x and z
+    REQUIRE(projection->index()[0] == 0);
+    REQUIRE(projection->index()[1] == 1);
+    REQUIRE(projection->position(x + 1) == 2);
+    REQUIRE(projection->position(y + 1) == tchecker::ta::clock_projection_t::NO_POSITION);
+    REQUIRE(projection->position(z + 1) == 3);
+    REQUIRE(projection->history_clock_ids() == std::unordered_set<int>{2, 3});
+
+    tchecker::clock_constraint_t c = projection->project(
+        tchecker::clock_constraint_t{z, tchecker::REFCLOCK_ID, tchecker::clock_constraint_t::LE, 1});
+    REQUIRE(c.id1() == 2);
+    REQUIRE(c.id2() == tchecker::REFCLOCK_ID);
+  }
+}
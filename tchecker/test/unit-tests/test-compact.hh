@@ -0,0 +1,121 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <vector>
+
+#include "tchecker/dbm/compact.hh"
+#include "tchecker/dbm/dbm.hh"
+#include "tchecker/zg/zone.hh"
+
+TEST_CASE("Compaction of difference bounds", "[compact]")
+{
+  std::vector<tchecker::dbm::db_t> const dbs = {tchecker::dbm::LE_ZERO,
+                                                tchecker::dbm::LT_ZERO,
+                                                tchecker::dbm::LT_INFINITY,
+                                                tchecker::dbm::LE_INFINITY,
+                                                tchecker::dbm::LE_MINUS_INFINITY,
+                                                tchecker::dbm::db(tchecker::dbm::LE, 1),
+                                                tchecker::dbm::db(tchecker::dbm::LT, -7),
+                                                tchecker::dbm::db(tchecker::dbm::LE, tchecker::dbm::COMPACT_MAX_VALUE),
+                                                tchecker::dbm::db(tchecker::dbm::LT, tchecker::dbm::COMPACT_MIN_VALUE)};
+
+  SECTION("Compaction is exact")
+  {
+    for (tchecker::dbm::db_t db : dbs) {
+      tchecker::dbm::compact_db_t cdb;
+      REQUIRE(tchecker::dbm::compact(db, cdb));
+      REQUIRE(tchecker::dbm::widen(cdb) == db);
+    }
+  }
+
+  SECTION("Compaction preserves the ordering")
+  {
+    for (tchecker::dbm::db_t db1 : dbs)
+      for (tchecker::dbm::db_t db2 : dbs) {
+        tchecker::dbm::compact_db_t cdb1, cdb2;
+        tchecker::dbm::compact(db1, cdb1);
+        tchecker::dbm::compact(db2, cdb2);
+        REQUIRE((cdb1 < cdb2) == (db1 < db2));
+      }
+  }
+
+#if (INTEGER_T_SIZE > 16)
+  SECTION("Large values have no compact encoding")
+  {
+    tchecker::dbm::compact_db_t cdb;
+    REQUIRE_FALSE(tchecker::dbm::compact(tchecker::dbm::db(tchecker::dbm::LE, tchecker::dbm::COMPACT_MAX_VALUE + 1), cdb));
+    REQUIRE_FALSE(tchecker::dbm::compact(tchecker::dbm::db(tchecker::dbm::LT, tchecker::dbm::COMPACT_MIN_VALUE - 1), cdb));
+  }
+#endif
+}
+
+TEST_CASE("Compact zones", "[compact]")
+{
+  tchecker::clock_id_t const dim = 3;
+
+  tchecker::zg::zone_t * z1 = tchecker::zg::zone_allocate_and_construct(dim, dim);
+  tchecker::dbm::db_t * dbm1 = z1->dbm();
+  dbm1[0 * dim + 1] = tchecker::dbm::db(tchecker::dbm::LE, -2);
+  dbm1[2 * dim + 0] = tchecker::dbm::db(tchecker::dbm::LT, 5);
+  tchecker::dbm::tighten(dbm1, dim);
+
+  tchecker::zg::zone_t * z2 = tchecker::zg::zone_allocate_and_construct(dim, dim);
+
+  tchecker::zg::zone_t * c1 = tchecker::zg::zone_allocate_and_construct(dim, *z1, tchecker::zg::ZONE_COMPACT);
+  tchecker::zg::zone_t * c2 = tchecker::zg::zone_allocate_and_construct(dim, *z2, tchecker::zg::ZONE_COMPACT);
+
+  SECTION("Compact zones are compact")
+  {
+    REQUIRE(c1->is_compact());
+    REQUIRE(c2->is_compact());
+    REQUIRE_FALSE(z1->is_compact());
+    REQUIRE(tchecker::allocation_size_t<tchecker::zg::zone_t>::alloc_size(dim, tchecker::zg::ZONE_COMPACT) <
+            tchecker::allocation_size_t<tchecker::zg::zone_t>::alloc_size(dim));
+  }
+
+  SECTION("Compact zones are equal to full zones")
+  {
+    REQUIRE(*c1 == *z1);
+    REQUIRE(*z1 == *c1);
+    REQUIRE(*c2 == *z2);
+    REQUIRE(*c1 != *c2);
+    REQUIRE(c1->hash() == z1->hash());
+    REQUIRE(c1->lexical_cmp(*z1) == 0);
+    REQUIRE(c1->lexical_cmp(*c2) == z1->lexical_cmp(*z2));
+  }
+
+  SECTION("Inclusion of compact zones")
+  {
+    REQUIRE(*c1 <= *c2);
+    REQUIRE(*c1 <= *z2);
+    REQUIRE(*z1 <= *c2);
+    REQUIRE_FALSE(*c2 <= *c1);
+    REQUIRE_FALSE(c1->is_empty());
+    REQUIRE(c2->is_universal_positive());
+  }
+
+  SECTION("Compact zones are widened by copy")
+  {
+    tchecker::zg::zone_t * w1 = tchecker::zg::zone_allocate_and_construct(dim, *c1);
+    REQUIRE_FALSE(w1->is_compact());
+    REQUIRE(tchecker::dbm::is_equal(w1->dbm(), z1->dbm(), dim));
+    tchecker::zg::zone_destruct_and_deallocate(w1);
+  }
+
+#if (INTEGER_T_SIZE > 16)
+  SECTION("Zones with large constants are not compactable")
+  {
+    dbm1[2 * dim + 0] = tchecker::dbm::db(tchecker::dbm::LT, tchecker::dbm::COMPACT_MAX_VALUE + 1);
+    REQUIRE_FALSE(tchecker::zg::is_compactable(*z1));
+  }
+#endif
+
+  tchecker::zg::zone_destruct_and_deallocate(c2);
+  tchecker::zg::zone_destruct_and_deallocate(c1);
+  tchecker::zg::zone_destruct_and_deallocate(z2);
+  tchecker::zg::zone_destruct_and_deallocate(z1);
+}
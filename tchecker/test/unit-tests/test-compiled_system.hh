@@ -0,0 +1,156 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+
+#include "tchecker/parsing/declaration.hh"
+#include "tchecker/ta/compiled_system.hh"
+#include "tchecker/ta/system.hh"
+#include "tchecker/vm/vm.hh"
+
+#include "testutils/utils.hh"
+
+TEST_CASE("compiled systems", "[compiled_system]")
+{
+  std::string model = "system:compiled_system \n\
+  event:a:1:1 \n\
+  event:b:1:0 \n\
+  event:tau \n\
+  int:1:1:5:1:j \n\
+  clock:normal:y \n\
+  \n\
+  process:P \n\
+  location:P:q0{initial:} \n\
+  location:P:q1{invariant:y<26} \n\
+  location:P:q2{} \n\
+  edge:P:q0:q1:a{{provided:a_p==-1; do:y;}} \n\
+  edge:P:q1:q1:b{{provided:b_h==-1 && j<5; do:j=j+1;}} \n\
+  edge:P:q1:q2:tau{{provided:y<26 && j==5;}} \n\
+  \n\
+  process:Q \n\
+  location:Q:m0{initial:} \n\
+  location:Q:m1{} \n\
+  edge:Q:m0:m1:a{{}} \n\
+  \n\
+  sync:P@a:Q@a \n\
+  ";
+
+  std::unique_ptr<tchecker::parsing::system_declaration_t const> sysdecl{tchecker::test::parse(model)};
+  REQUIRE(sysdecl != nullptr);
+
+  tchecker::ta::system_t system{*sysdecl};
+
+  std::filesystem::path const path = std::filesystem::temp_directory_path() / "tchecker-unittest-compiled_system.tckc";
+  tchecker::ta::write_compiled_system(path.string(), system);
+
+  SECTION("Loaded system is the compiled system")
+  {
+    std::unique_ptr<tchecker::ta::system_t> loaded{tchecker::ta::load_compiled_system(path.string())};
+    REQUIRE(loaded != nullptr);
+
+    REQUIRE(loaded->name() == system.name());
+    REQUIRE(loaded->processes_count() == system.processes_count());
+    REQUIRE(loaded->events_count() == system.events_count());
+    REQUIRE(loaded->locations_count() == system.locations_count());
+    REQUIRE(loaded->edges_count() == system.edges_count());
+    REQUIRE(loaded->synchronizations_count() == system.synchronizations_count());
+    REQUIRE(loaded->clocks_count(tchecker::VK_FLATTENED) == system.clocks_count(tchecker::VK_FLATTENED));
+    REQUIRE(loaded->intvars_count(tchecker::VK_FLATTENED) == system.intvars_count(tchecker::VK_FLATTENED));
+
+    for (tchecker::clock_id_t id = 0; id < system.clocks_count(tchecker::VK_FLATTENED); ++id)
+      REQUIRE(loaded->clock_name(id) == system.clock_name(id));
+
+    REQUIRE(loaded->history_clock_id_map == system.history_clock_id_map);
+    REQUIRE(loaded->prophecy_clock_id_map == system.prophecy_clock_id_map);
+    REQUIRE(loaded->normal_clock_id_map == system.normal_clock_id_map);
+    REQUIRE((loaded->clock_layout() == nullptr) == (system.clock_layout() == nullptr));
+
+    for (tchecker::loc_id_t id = 0; id < system.locations_count(); ++id) {
+      REQUIRE(loaded->location(id)->name() == system.location(id)->name());
+      REQUIRE(loaded->location(id)->pid() == system.location(id)->pid());
+      REQUIRE(loaded->is_initial_location(id) == system.is_initial_location(id));
+      REQUIRE(loaded->invariant(id).to_string() == system.invariant(id).to_string());
+
+      std::size_t const size = tchecker::bytecode_size(system.invariant_bytecode(id));
+      REQUIRE(tchecker::bytecode_size(loaded->invariant_bytecode(id)) == size);
+      REQUIRE(std::equal(system.invariant_bytecode(id), system.invariant_bytecode(id) + size,
+                         loaded->invariant_bytecode(id)));
+    }
+
+    for (tchecker::edge_id_t id = 0; id < system.edges_count(); ++id) {
+      REQUIRE(loaded->edge(id)->src() == system.edge(id)->src());
+      REQUIRE(loaded->edge(id)->tgt() == system.edge(id)->tgt());
+      REQUIRE(loaded->edge(id)->event_id() == system.edge(id)->event_id());
+      REQUIRE(loaded->guard(id).to_string() == system.guard(id).to_string());
+      REQUIRE(loaded->guard(id).type() == system.guard(id).type());
+      REQUIRE(loaded->statement(id).to_string() == system.statement(id).to_string());
+      REQUIRE(loaded->statement(id).type() == system.statement(id).type());
+
+      std::size_t const guard_size = tchecker::bytecode_size(system.guard_bytecode(id));
+      REQUIRE(tchecker::bytecode_size(loaded->guard_bytecode(id)) == guard_size);
+      REQUIRE(std::equal(system.guard_bytecode(id), system.guard_bytecode(id) + guard_size, loaded->guard_bytecode(id)));
+
+      std::size_t const stmt_size = tchecker::bytecode_size(system.statement_bytecode(id));
+      REQUIRE(tchecker::bytecode_size(loaded->statement_bytecode(id)) == stmt_size);
+      REQUIRE(std::equal(system.statement_bytecode(id), system.statement_bytecode(id) + stmt_size,
+                         loaded->statement_bytecode(id)));
+    }
+  }
+
+  SECTION("Attributes are preserved")
+  {
+    std::unique_ptr<tchecker::ta::system_t> loaded{tchecker::ta::load_compiled_system(path.string())};
+    REQUIRE(loaded != nullptr);
+
+    for (tchecker::loc_id_t id = 0; id < system.locations_count(); ++id) {
+      auto const & attr = system.location(id)->attributes();
+      auto const & loaded_attr = loaded->location(id)->attributes();
+      REQUIRE(std::distance(loaded_attr.attributes().begin(), loaded_attr.attributes().end()) ==
+              std::distance(attr.attributes().begin(), attr.attributes().end()));
+      for (auto && [key, value] : attr.attributes()) {
+        auto range = loaded_attr.values(key);
+        REQUIRE(std::find_if(range.begin(), range.end(), [&](auto const & kv) { return kv.second == value; }) !=
+                range.end());
+      }
+    }
+  }
+
+  SECTION("Invalid files are rejected")
+  {
+    std::string contents;
+    {
+      std::ifstream ifs{path, std::ios::binary};
+      contents.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+    }
+    REQUIRE(contents.size() > 16);
+
+    std::string patched = contents;
+    patched[0] ^= 1; // magic number
+    std::ofstream{path, std::ios::binary | std::ios::trunc} << patched;
+    REQUIRE_THROWS_AS(tchecker::ta::load_compiled_system(path.string()), std::runtime_error);
+
+    patched = contents;
+    patched[8] ^= 1; // version
+    std::ofstream{path, std::ios::binary | std::ios::trunc} << patched;
+    REQUIRE_THROWS_AS(tchecker::ta::load_compiled_system(path.string()), std::runtime_error);
+
+    std::ofstream{path, std::ios::binary | std::ios::trunc} << contents.substr(0, contents.size() / 2);
+    REQUIRE_THROWS_AS(tchecker::ta::load_compiled_system(path.string()), std::runtime_error);
+
+    std::ofstream{path, std::ios::binary | std::ios::trunc} << contents << "x";
+    REQUIRE_THROWS_AS(tchecker::ta::load_compiled_system(path.string()), std::runtime_error);
+
+    REQUIRE_THROWS_AS(tchecker::ta::load_compiled_system(path.string() + ".missing"), std::runtime_error);
+  }
+
+  std::filesystem::remove(path);
+}
@@ -0,0 +1,60 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <map>
+#include <string>
+
+#include "tchecker/basictypes.hh"
+#include "tchecker/utils/counters.hh"
+
+TEST_CASE("hot-path counters", "[counters]")
+{
+  tchecker::counters::reset();
+
+  SECTION("Counters are exported as attributes")
+  {
+    tchecker::counters::increment(tchecker::counters::COVERING_CHECKS);
+    tchecker::counters::increment(tchecker::counters::BUCKET_NODES_SCANNED, 5);
+    tchecker::counters::maximize(tchecker::counters::DBM_DIMENSION, 7);
+    tchecker::counters::maximize(tchecker::counters::DBM_DIMENSION, 3);
+    tchecker::counters::count_status(tchecker::STATE_OK);
+    tchecker::counters::count_status(tchecker::STATE_CLOCKS_GUARD_VIOLATED);
+    tchecker::counters::count_status(tchecker::STATE_CLOCKS_GUARD_VIOLATED);
+
+    std::map<std::string, std::string> m;
+    tchecker::counters::attributes(m);
+    REQUIRE(m["COVERING_CHECKS"] == "1");
+    REQUIRE(m["BUCKET_NODES_SCANNED"] == "5");
+    REQUIRE(m["DBM_DIMENSION"] == "7");
+    REQUIRE(m["GSIM_SPLITS"] == "0");
+    REQUIRE(m["SUCCESSORS_OK"] == "1");
+    REQUIRE(m["SUCCESSORS_CLOCKS_GUARD_VIOLATED"] == "2");
+    REQUIRE(m.find("SUCCESSORS_ZONE_EMPTY") == m.end());
+  }
+
+  SECTION("Timers count all calls and time sampled calls")
+  {
+    for (unsigned long i = 0; i < 2 * tchecker::counters::TIMER_SAMPLING_PERIOD; ++i)
+      tchecker::counters::sampled_timer_t timer{tchecker::counters::TIMER_NEXT};
+
+    std::map<std::string, std::string> m;
+    tchecker::counters::attributes(m);
+    REQUIRE(m["TIMER_NEXT_CALLS"] == std::to_string(2 * tchecker::counters::TIMER_SAMPLING_PERIOD));
+    REQUIRE(tchecker::counters::storage.timer_samples[tchecker::counters::TIMER_NEXT] == 2);
+    REQUIRE(m["TIMER_IS_COVERED_CALLS"] == "0");
+  }
+
+  SECTION("Counters are reset")
+  {
+    tchecker::counters::increment(tchecker::counters::GSIM_SPLITS);
+    tchecker::counters::reset();
+
+    std::map<std::string, std::string> m;
+    tchecker::counters::attributes(m);
+    REQUIRE(m["GSIM_SPLITS"] == "0");
+  }
+}
@@ -5,6 +5,11 @@
  *
  */
 
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "tchecker/dbm/closure.hh"
 #include "tchecker/dbm/dbm.hh"
 
 #define DBM(i, j)  dbm[(i)*dim + (j)]
@@ -2000,4 +2005,408 @@ TEST_CASE("G simulation implies G simulation for normal clocks", "[dbm]")
   delete history_clock_ids;
   delete prophecy_clock_ids;
   delete normal_clock_ids;
-}
\ No newline at end of file
+}
+
+TEST_CASE("Unbounding a history clock", "[dbm]")
+{
+  // index 1 is the "tmp" clock, 2 and 3 are history clocks, 4 is a prophecy clock
+  tchecker::clock_id_t const dim = 5;
+  std::unordered_set<int> history_clock_ids{2, 3};
+  std::unordered_set<int> prophecy_clock_ids{4};
+  std::unordered_set<int> normal_clock_ids{};
+
+  tchecker::dbm::db_t dbm[dim * dim];
+  tchecker::dbm::eca_zero(dbm, dim, history_clock_ids, prophecy_clock_ids, normal_clock_ids);
+  tchecker::dbm::eca_reset(dbm, dim, 2, history_clock_ids, prophecy_clock_ids, normal_clock_ids);
+  tchecker::dbm::eca_open_up(dbm, dim, history_clock_ids, prophecy_clock_ids, normal_clock_ids);
+  tchecker::dbm::eca_reset(dbm, dim, 3, history_clock_ids, prophecy_clock_ids, normal_clock_ids);
+  tchecker::dbm::eca_open_up(dbm, dim, history_clock_ids, prophecy_clock_ids, normal_clock_ids);
+
+  tchecker::dbm::db_t dbm2[dim * dim];
+  for (tchecker::clock_id_t i = 0; i < dim * dim; ++i)
+    dbm2[i] = dbm[i];
+
+  tchecker::dbm::eca_unbound_history(dbm, dim, 2, history_clock_ids, prophecy_clock_ids, normal_clock_ids);
+
+  REQUIRE(DBM(2, 0) == tchecker::dbm::LE_INFINITY);
+  REQUIRE(DBM(0, 2) == tchecker::dbm::LE_ZERO);
+  REQUIRE(DBM(2, 3) == tchecker::dbm::LE_INFINITY);
+  REQUIRE(DBM(3, 2) == DBM(3, 0));
+
+  // the other clocks are unchanged
+  for (tchecker::clock_id_t i = 0; i < dim; ++i)
+    for (tchecker::clock_id_t j = 0; j < dim; ++j)
+      if (i != 2 && j != 2)
+        REQUIRE(DBM(i, j) == DBM2(i, j));
+
+  // the result is tight
+  for (tchecker::clock_id_t i = 0; i < dim * dim; ++i)
+    dbm2[i] = dbm[i];
+  tchecker::dbm::eca_tighten(dbm2, dim, history_clock_ids, prophecy_clock_ids, normal_clock_ids);
+  REQUIRE(tchecker::dbm::is_equal(dbm, dbm2, dim));
+}
+
+TEST_CASE("Projection and expansion of a DBM over unbounded history clocks", "[dbm]")
+{
+  // index 1 is the "tmp" clock, 2 and 3 are history clocks, 4 is a prophecy clock
+  tchecker::clock_id_t const dim = 5;
+  std::unordered_set<int> history_clock_ids{2, 3};
+  std::unordered_set<int> prophecy_clock_ids{4};
+  std::unordered_set<int> normal_clock_ids{};
+
+  tchecker::dbm::db_t dbm[dim * dim];
+  tchecker::dbm::eca_zero(dbm, dim, history_clock_ids, prophecy_clock_ids, normal_clock_ids);
+  tchecker::dbm::eca_reset(dbm, dim, 2, history_clock_ids, prophecy_clock_ids, normal_clock_ids);
+  tchecker::dbm::eca_open_up(dbm, dim, history_clock_ids, prophecy_clock_ids, normal_clock_ids);
+  tchecker::dbm::eca_reset(dbm, dim, 3, history_clock_ids, prophecy_clock_ids, normal_clock_ids);
+  tchecker::dbm::eca_open_up(dbm, dim, history_clock_ids, prophecy_clock_ids, normal_clock_ids);
+  tchecker::dbm::eca_unbound_history(dbm, dim, 2, history_clock_ids, prophecy_clock_ids, normal_clock_ids);
+
+  // projection on clocks 0, 1, 3 and 4
+  tchecker::clock_id_t const pdim = 4;
+  tchecker::clock_id_t const index[pdim] = {0, 1, 3, 4};
+  std::unordered_set<int> phistory_clock_ids{2};
+  std::unordered_set<int> pprophecy_clock_ids{3};
+
+  tchecker::dbm::db_t pdbm[pdim * pdim];
+  tchecker::dbm::project(dbm, dim, index, pdim, pdbm);
+
+  for (tchecker::clock_id_t i = 0; i < pdim; ++i)
+    for (tchecker::clock_id_t j = 0; j < pdim; ++j)
+      REQUIRE(pdbm[i * pdim + j] == DBM(index[i], index[j]));
+
+  SECTION("Expansion of the projection is the identity")
+  {
+    tchecker::dbm::db_t dbm2[dim * dim];
+    for (tchecker::clock_id_t i = 0; i < dim * dim; ++i)
+      dbm2[i] = dbm[i];
+    tchecker::dbm::eca_expand(dbm2, dim, pdbm, index, pdim);
+    REQUIRE(tchecker::dbm::is_equal(dbm, dbm2, dim));
+  }
+
+  SECTION("Operations on the projection")
+  {
+    tchecker::dbm::db_t dbm2[dim * dim];
+    for (tchecker::clock_id_t i = 0; i < dim * dim; ++i)
+      dbm2[i] = dbm[i];
+
+    // operations may constrain clock 2 w.r.t. the other clocks (e.g. 3 <= 2 after
+    // reset of 3), hence clock 2 is unbounded again
+    tchecker::dbm::eca_reset(dbm, dim, 3, history_clock_ids, prophecy_clock_ids, normal_clock_ids);
+    tchecker::dbm::eca_open_up(dbm, dim, history_clock_ids, prophecy_clock_ids, normal_clock_ids);
+    tchecker::dbm::eca_unbound_history(dbm, dim, 2, history_clock_ids, prophecy_clock_ids, normal_clock_ids);
+
+    tchecker::dbm::eca_reset(pdbm, pdim, 2, phistory_clock_ids, pprophecy_clock_ids, normal_clock_ids);
+    tchecker::dbm::eca_open_up(pdbm, pdim, phistory_clock_ids, pprophecy_clock_ids, normal_clock_ids);
+    tchecker::dbm::eca_expand(dbm2, dim, pdbm, index, pdim);
+
+    REQUIRE(tchecker::dbm::is_equal(dbm, dbm2, dim));
+  }
+}
+
+TEST_CASE("ECA operations over a grouped clock layout", "[dbm]")
+{
+  // index 1 is the "tmp" clock, 2 is a normal clock, 3 and 4 are history clocks,
+  // 5 and 6 are prophecy clocks
+  tchecker::clock_id_t const dim = 7;
+  std::unordered_set<int> history_clock_ids{3, 4};
+  std::unordered_set<int> prophecy_clock_ids{5, 6};
+  std::unordered_set<int> normal_clock_ids{2};
+
+  tchecker::dbm::clock_layout_t layout;
+  REQUIRE(tchecker::dbm::eca_clock_layout(dim, history_clock_ids, prophecy_clock_ids, normal_clock_ids, layout));
+  REQUIRE(layout.normal_begin == 2);
+  REQUIRE(layout.history_begin == 3);
+  REQUIRE(layout.prophecy_begin == 5);
+  REQUIRE(layout.end == dim);
+
+  SECTION("Interleaved clocks have no layout")
+  {
+    std::unordered_set<int> interleaved_history_clock_ids{3, 5};
+    std::unordered_set<int> interleaved_prophecy_clock_ids{4, 6};
+    REQUIRE_FALSE(tchecker::dbm::eca_clock_layout(dim, interleaved_history_clock_ids, interleaved_prophecy_clock_ids,
+                                                  normal_clock_ids, layout));
+  }
+
+  SECTION("Operations over the layout and over sets of clocks coincide")
+  {
+    tchecker::dbm::db_t dbm[dim * dim], dbm2[dim * dim];
+    for (tchecker::clock_id_t i = 0; i < dim * dim; ++i)
+      dbm[i] = dbm2[i] = tchecker::dbm::LE_ZERO;
+
+    tchecker::dbm::eca_zero(dbm, dim, history_clock_ids, prophecy_clock_ids, normal_clock_ids);
+    tchecker::dbm::eca_zero(dbm2, dim, layout);
+    REQUIRE(tchecker::dbm::is_equal(dbm, dbm2, dim));
+
+    tchecker::dbm::eca_open_up(dbm, dim, history_clock_ids, prophecy_clock_ids, normal_clock_ids);
+    tchecker::dbm::eca_open_up(dbm2, dim, layout);
+    REQUIRE(tchecker::dbm::is_equal(dbm, dbm2, dim));
+
+    tchecker::dbm::eca_reset(dbm, dim, 3, history_clock_ids, prophecy_clock_ids, normal_clock_ids);
+    tchecker::dbm::eca_reset(dbm2, dim, 3, history_clock_ids, prophecy_clock_ids, normal_clock_ids);
+    tchecker::dbm::eca_open_up(dbm, dim, history_clock_ids, prophecy_clock_ids, normal_clock_ids);
+    tchecker::dbm::eca_open_up(dbm2, dim, layout);
+    REQUIRE(tchecker::dbm::is_equal(dbm, dbm2, dim));
+
+    REQUIRE(tchecker::dbm::eca_is_final_dbm(dbm2, dim, layout) ==
+            tchecker::dbm::eca_is_final_dbm(dbm, dim, history_clock_ids, prophecy_clock_ids, normal_clock_ids));
+
+    tchecker::dbm::eca_release(dbm2, dim, 5, history_clock_ids, prophecy_clock_ids, normal_clock_ids);
+    tchecker::dbm::eca_release(dbm2, dim, 6, history_clock_ids, prophecy_clock_ids, normal_clock_ids);
+    REQUIRE(tchecker::dbm::eca_is_final_dbm(dbm2, dim, layout));
+  }
+}
+
+TEST_CASE("ExtraLU+ extrapolation of ECA DBMs", "[dbm]")
+{
+  // index 1 is the "tmp" clock, 2 is a normal clock, 3 and 4 are history clocks,
+  // 5 is a prophecy clock
+  tchecker::clock_id_t const dim = 6;
+  std::unordered_set<int> history_clock_ids{3, 4};
+  std::unordered_set<int> prophecy_clock_ids{5};
+  std::unordered_set<int> normal_clock_ids{2};
+
+  // 10 <= x2 <= 12 and x3 = x2, x4 is undefined
+  tchecker::dbm::db_t dbm[dim * dim];
+  tchecker::dbm::eca_zero(dbm, dim, history_clock_ids, prophecy_clock_ids, normal_clock_ids);
+  tchecker::dbm::eca_reset(dbm, dim, 3, history_clock_ids, prophecy_clock_ids, normal_clock_ids);
+  tchecker::dbm::eca_open_up(dbm, dim, history_clock_ids, prophecy_clock_ids, normal_clock_ids);
+  tchecker::dbm::eca_constrain(dbm, dim, 0, 2, tchecker::dbm::LE, -10, history_clock_ids, prophecy_clock_ids,
+                               normal_clock_ids);
+  tchecker::dbm::eca_constrain(dbm, dim, 2, 0, tchecker::dbm::LE, 12, history_clock_ids, prophecy_clock_ids,
+                               normal_clock_ids);
+
+  tchecker::dbm::db_t dbm2[dim * dim];
+  for (tchecker::clock_id_t i = 0; i < dim * dim; ++i)
+    dbm2[i] = dbm[i];
+
+  tchecker::integer_t const M = tchecker::dbm::MAX_VALUE;
+
+  SECTION("Clocks with maximal bounds are kept unchanged")
+  {
+    tchecker::integer_t const l[dim - 1] = {M, M, M, M, M};
+    tchecker::integer_t const u[dim - 1] = {M, M, M, M, M};
+    tchecker::dbm::eca_extra_lu_plus(dbm, dim, l, u);
+    REQUIRE(tchecker::dbm::is_equal(dbm, dbm2, dim));
+  }
+
+  SECTION("Normal and history clocks above their bounds are abstracted")
+  {
+    tchecker::integer_t const l[dim - 1] = {M, 5, 3, 3, M};
+    tchecker::integer_t const u[dim - 1] = {M, 5, 3, 3, M};
+    tchecker::dbm::eca_extra_lu_plus(dbm, dim, l, u);
+
+    REQUIRE(DBM(0, 2) == tchecker::dbm::db(tchecker::dbm::LT, -5));
+    REQUIRE(DBM(0, 3) == tchecker::dbm::db(tchecker::dbm::LT, -3));
+    REQUIRE(DBM(2, 0) == tchecker::dbm::LT_INFINITY);
+    REQUIRE(DBM(3, 0) == tchecker::dbm::LT_INFINITY);
+    REQUIRE(DBM(2, 3) == tchecker::dbm::LT_INFINITY);
+    REQUIRE(DBM(3, 2) == tchecker::dbm::LT_INFINITY);
+
+    // the "tmp" clock, the undefined history clock and the prophecy clock are
+    // unchanged
+    for (tchecker::clock_id_t k : {1, 4, 5})
+      for (tchecker::clock_id_t j = 0; j < dim; ++j) {
+        REQUIRE(DBM(k, j) == DBM2(k, j));
+        REQUIRE(DBM(j, k) == DBM2(j, k));
+      }
+
+    // the result is tight
+    for (tchecker::clock_id_t i = 0; i < dim * dim; ++i)
+      dbm2[i] = dbm[i];
+    tchecker::dbm::eca_tighten(dbm2, dim);
+    REQUIRE(tchecker::dbm::is_equal(dbm, dbm2, dim));
+  }
+
+  SECTION("Clocks below their bounds are kept unchanged")
+  {
+    tchecker::integer_t const l[dim - 1] = {M, 12, 12, 3, M};
+    tchecker::integer_t const u[dim - 1] = {M, 10, 10, 3, M};
+    tchecker::dbm::eca_extra_lu_plus(dbm, dim, l, u);
+    REQUIRE(tchecker::dbm::is_equal(dbm, dbm2, dim));
+  }
+
+  SECTION("Possibly undefined history clocks are kept unchanged")
+  {
+    // 10 <= x3 <= inf: x3 is either defined and above 10, or undefined
+    for (tchecker::clock_id_t j = 0; j < dim; ++j)
+      if (j != 3)
+        DBM(3, j) = tchecker::dbm::LE_INFINITY;
+    tchecker::dbm::eca_tighten(dbm, dim);
+    REQUIRE(DBM(3, 0) == tchecker::dbm::LE_INFINITY);
+    REQUIRE(DBM(0, 3) == tchecker::dbm::db(tchecker::dbm::LE, -10));
+
+    for (tchecker::clock_id_t i = 0; i < dim * dim; ++i)
+      dbm2[i] = dbm[i];
+
+    tchecker::integer_t const l[dim - 1] = {M, 5, 3, 3, M};
+    tchecker::integer_t const u[dim - 1] = {M, 5, 3, 3, M};
+    tchecker::dbm::eca_extra_lu_plus(dbm, dim, l, u);
+
+    REQUIRE(DBM(0, 2) == tchecker::dbm::db(tchecker::dbm::LT, -5));
+    REQUIRE(DBM(2, 0) == tchecker::dbm::LT_INFINITY);
+    for (tchecker::clock_id_t j = 0; j < dim; ++j) {
+      REQUIRE(DBM(3, j) == DBM2(3, j));
+      REQUIRE(DBM(j, 3) == DBM2(j, 3));
+    }
+  }
+}
+
+TEST_CASE("Closure kernels coincide with the scalar kernel", "[dbm]")
+{
+  std::mt19937 gen(1234);
+  std::uniform_int_distribution<int> value(-50, 50);
+  std::uniform_int_distribution<int> kind(0, 9);
+
+  // random difference bound, with infinity sentinels
+  auto random_db = [&](bool eca) {
+    switch (kind(gen)) {
+    case 0:
+    case 1:
+      return tchecker::dbm::LT_INFINITY;
+    case 2:
+      return (eca ? tchecker::dbm::LE_INFINITY : tchecker::dbm::LT_INFINITY);
+    case 3:
+      return (eca ? tchecker::dbm::LE_MINUS_INFINITY : tchecker::dbm::LE_ZERO);
+    default:
+      return tchecker::dbm::db((kind(gen) < 5 ? tchecker::dbm::LT : tchecker::dbm::LE), value(gen));
+    }
+  };
+
+  auto random_dbm = [&](std::vector<tchecker::dbm::db_t> & dbm, tchecker::clock_id_t dim, bool eca) {
+    dbm.resize(dim * dim);
+    for (tchecker::clock_id_t i = 0; i < dim; ++i)
+      for (tchecker::clock_id_t j = 0; j < dim; ++j)
+        dbm[i * dim + j] = (i == j ? tchecker::dbm::LE_ZERO : random_db(eca));
+  };
+
+  enum tchecker::dbm::closure_kernel_t const kernels[] = {tchecker::dbm::CLOSURE_SSE41, tchecker::dbm::CLOSURE_AVX2};
+  enum tchecker::dbm::closure_kernel_t const default_kernel = tchecker::dbm::closure_kernel();
+
+  for (enum tchecker::dbm::closure_kernel_t kernel : kernels) {
+    if (!tchecker::dbm::closure_kernel_supported(kernel))
+      continue;
+
+    SECTION(std::string("Rows, kernel ") + tchecker::dbm::closure_kernel_name(kernel))
+    {
+      std::vector<tchecker::dbm::db_t> dbm, expected;
+      for (unsigned int n = 0; n < 2000; ++n) {
+        bool const eca = (n % 2 == 0);
+        tchecker::clock_id_t const dim = 1 + n % 37;
+        random_dbm(dbm, dim, eca);
+        // diagonal entries other than <=0 exercise updates of (i,k) along the row
+        if (n % 5 == 0)
+          dbm[(n % dim) * dim + (n % dim)] = random_db(eca);
+        expected = dbm;
+
+        tchecker::clock_id_t const i = n % dim, k = (n / 3) % dim, begin = (n % 7 == 0 ? 2 % dim : 0);
+
+        tchecker::dbm::set_closure_kernel(tchecker::dbm::CLOSURE_SCALAR);
+        if (eca)
+          tchecker::dbm::eca_tighten_row(expected.data(), dim, i, k, begin, dim);
+        else
+          tchecker::dbm::tighten_row(expected.data(), dim, i, k, begin, dim);
+
+        tchecker::dbm::set_closure_kernel(kernel);
+        if (eca)
+          tchecker::dbm::eca_tighten_row(dbm.data(), dim, i, k, begin, dim);
+        else
+          tchecker::dbm::tighten_row(dbm.data(), dim, i, k, begin, dim);
+
+        REQUIRE(dbm == expected);
+      }
+    }
+
+    SECTION(std::string("Tighten, kernel ") + tchecker::dbm::closure_kernel_name(kernel))
+    {
+      std::vector<tchecker::dbm::db_t> dbm, expected;
+      for (tchecker::clock_id_t dim = 1; dim < 40; ++dim) {
+        for (unsigned int n = 0; n < 20; ++n) {
+          random_dbm(dbm, dim, false);
+          expected = dbm;
+
+          tchecker::dbm::set_closure_kernel(tchecker::dbm::CLOSURE_SCALAR);
+          enum tchecker::dbm::status_t expected_status = tchecker::dbm::tighten(expected.data(), dim);
+
+          tchecker::dbm::set_closure_kernel(kernel);
+          REQUIRE(tchecker::dbm::tighten(dbm.data(), dim) == expected_status);
+          REQUIRE(dbm == expected);
+        }
+      }
+    }
+
+    SECTION(std::string("Overflows, kernel ") + tchecker::dbm::closure_kernel_name(kernel))
+    {
+      tchecker::clock_id_t const dim = 19;
+      std::vector<tchecker::dbm::db_t> dbm, expected;
+      random_dbm(dbm, dim, false);
+      // the sum overflows from column 11: columns 0 to 10 are updated before
+      for (tchecker::clock_id_t j = 0; j < dim; ++j)
+        if (j != 1)
+          dbm[1 * dim + j] = (j < 11 ? tchecker::dbm::db(tchecker::dbm::LT, -tchecker::dbm::MAX_VALUE)
+                                     : tchecker::dbm::db(tchecker::dbm::LE, tchecker::dbm::MAX_VALUE));
+      dbm[0 * dim + 1] = tchecker::dbm::db(tchecker::dbm::LE, tchecker::dbm::MAX_VALUE);
+      expected = dbm;
+
+      tchecker::dbm::set_closure_kernel(tchecker::dbm::CLOSURE_SCALAR);
+      REQUIRE_THROWS_AS(tchecker::dbm::tighten_row(expected.data(), dim, 0, 1, 0, dim), std::invalid_argument);
+
+      tchecker::dbm::set_closure_kernel(kernel);
+      REQUIRE_THROWS_AS(tchecker::dbm::tighten_row(dbm.data(), dim, 0, 1, 0, dim), std::invalid_argument);
+      REQUIRE(dbm == expected);
+    }
+
+    SECTION(std::string("aLU, kernel ") + tchecker::dbm::closure_kernel_name(kernel))
+    {
+      std::uniform_int_distribution<int> bound(-1, 20);
+      std::vector<tchecker::dbm::db_t> dbm1, dbm2;
+      std::vector<tchecker::integer_t> l, u;
+      for (tchecker::clock_id_t dim = 1; dim < 40; ++dim) {
+        std::uniform_int_distribution<tchecker::clock_id_t> clock(0, dim - 1);
+        for (unsigned int n = 0; n < 20; ++n) {
+          // dbm1 is constrained by all the constraints, and dbm2 by a prefix of
+          // them, hence dbm1 is often included in dbm2
+          dbm1.resize(dim * dim);
+          dbm2.resize(dim * dim);
+          tchecker::dbm::universal_positive(dbm1.data(), dim);
+          tchecker::dbm::universal_positive(dbm2.data(), dim);
+          for (unsigned int c = 0; c < dim; ++c) {
+            tchecker::clock_id_t const x = clock(gen), y = clock(gen);
+            if (x == y)
+              continue;
+            enum tchecker::dbm::comparator_t const cmp = (kind(gen) < 5 ? tchecker::dbm::LT : tchecker::dbm::LE);
+            tchecker::integer_t const v = value(gen) / 2;
+            std::vector<tchecker::dbm::db_t> backup = dbm1;
+            if (tchecker::dbm::constrain(dbm1.data(), dim, x, y, cmp, v) == tchecker::dbm::EMPTY) {
+              dbm1 = backup;
+              continue;
+            }
+            if (c < dim / 2)
+              tchecker::dbm::constrain(dbm2.data(), dim, x, y, cmp, v);
+          }
+          if (n % 2 == 0)
+            std::swap(dbm1, dbm2);
+
+          l.resize(dim - 1);
+          u.resize(dim - 1);
+          for (tchecker::clock_id_t x = 0; x < dim - 1; ++x) {
+            l[x] = bound(gen);
+            u[x] = bound(gen);
+            if (l[x] < 0)
+              l[x] = -tchecker::dbm::INF_VALUE;
+            if (u[x] < 0)
+              u[x] = -tchecker::dbm::INF_VALUE;
+          }
+
+          tchecker::dbm::set_closure_kernel(tchecker::dbm::CLOSURE_SCALAR);
+          bool const expected = tchecker::dbm::is_alu_le(dbm1.data(), dbm2.data(), dim, l.data(), u.data());
+
+          tchecker::dbm::set_closure_kernel(kernel);
+          REQUIRE(tchecker::dbm::is_alu_le(dbm1.data(), dbm2.data(), dim, l.data(), u.data()) == expected);
+        }
+      }
+    }
+  }
+
+  tchecker::dbm::set_closure_kernel(default_kernel);
+}
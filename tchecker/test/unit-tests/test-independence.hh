@@ -0,0 +1,131 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <memory>
+
+#include "tchecker/basictypes.hh"
+#include "tchecker/parsing/declaration.hh"
+#include "tchecker/syncprod/vloc.hh"
+#include "tchecker/ta/independence.hh"
+#include "tchecker/ta/system.hh"
+
+#include "testutils/utils.hh"
+
+TEST_CASE("static independence and ample locations", "[independence]")
+{
+  std::string model = "system:independence \n\
+  event:a \n\
+  event:b \n\
+  event:c \n\
+  event:d \n\
+  event:e \n\
+  clock:history:x \n\
+  int:1:0:1:0:i \n\
+  int:1:0:1:0:j \n\
+  \n\
+  process:P1 \n\
+  location:P1:l0{initial:} \n\
+  location:P1:l1{} \n\
+  edge:P1:l0:l1:a{{provided:i==0; do:i=1;}} \n\
+  \n\
+  process:P2 \n\
+  location:P2:l0{initial:} \n\
+  location:P2:l1{} \n\
+  edge:P2:l0:l1:b{{provided:x<=5; do:x;}} \n\
+  \n\
+  process:P3 \n\
+  location:P3:l0{initial:} \n\
+  location:P3:l1{} \n\
+  edge:P3:l0:l1:c{{provided:j==0;}} \n\
+  \n\
+  process:P4 \n\
+  location:P4:l0{initial:} \n\
+  location:P4:l1{} \n\
+  edge:P4:l0:l1:d{{provided:; do:j=1;}} \n\
+  edge:P4:l1:l0:e{{}} \n\
+  \n\
+  process:P5 \n\
+  location:P5:l0{initial:} \n\
+  location:P5:l1{} \n\
+  edge:P5:l0:l1:e{{}} \n\
+  \n\
+  sync:P4@e:P5@e \n\
+  ";
+
+  std::unique_ptr<tchecker::parsing::system_declaration_t const> sysdecl{tchecker::test::parse(model)};
+  REQUIRE(sysdecl != nullptr);
+
+  tchecker::ta::system_t system{*sysdecl};
+  tchecker::ta::independence_t independence{system};
+
+  tchecker::process_id_t const P1 = system.process_id("P1");
+  tchecker::process_id_t const P2 = system.process_id("P2");
+  tchecker::process_id_t const P3 = system.process_id("P3");
+  tchecker::process_id_t const P4 = system.process_id("P4");
+  tchecker::process_id_t const P5 = system.process_id("P5");
+
+  tchecker::loc_id_t const P1_l0 = system.location(P1, "l0")->id();
+  tchecker::loc_id_t const P1_l1 = system.location(P1, "l1")->id();
+  tchecker::loc_id_t const P2_l0 = system.location(P2, "l0")->id();
+  tchecker::loc_id_t const P3_l0 = system.location(P3, "l0")->id();
+  tchecker::loc_id_t const P4_l0 = system.location(P4, "l0")->id();
+  tchecker::loc_id_t const P4_l1 = system.location(P4, "l1")->id();
+  tchecker::loc_id_t const P5_l0 = system.location(P5, "l0")->id();
+
+  tchecker::edge_id_t const P1_a = (*system.outgoing_edges(P1_l0).begin())->id();
+  tchecker::edge_id_t const P2_b = (*system.outgoing_edges(P2_l0).begin())->id();
+  tchecker::edge_id_t const P3_c = (*system.outgoing_edges(P3_l0).begin())->id();
+  tchecker::edge_id_t const P4_d = (*system.outgoing_edges(P4_l0).begin())->id();
+  tchecker::edge_id_t const P4_e = (*system.outgoing_edges(P4_l1).begin())->id();
+
+  SECTION("Asynchronous and clock-free edges")
+  {
+    REQUIRE(independence.is_asynchronous(P1_a));
+    REQUIRE(independence.is_clock_free(P1_a));
+    REQUIRE(independence.is_asynchronous(P2_b));
+    REQUIRE_FALSE(independence.is_clock_free(P2_b));
+    REQUIRE_FALSE(independence.is_asynchronous(P4_e));
+  }
+
+  SECTION("Independent edges")
+  {
+    REQUIRE(independence.independent(P1_a, P2_b));
+    REQUIRE(independence.independent(P1_a, P3_c));
+    REQUIRE(independence.independent(P2_b, P4_d));
+    REQUIRE_FALSE(independence.independent(P3_c, P4_d)); // P4 writes j that is read by P3
+    REQUIRE_FALSE(independence.independent(P1_a, P4_e)); // synchronized event
+    REQUIRE_FALSE(independence.independent(P1_a, P1_a)); // same process
+  }
+
+  SECTION("Ample locations")
+  {
+    REQUIRE(independence.is_ample_location(P1_l0));
+    REQUIRE_FALSE(independence.is_ample_location(P1_l1)); // no outgoing edge
+    REQUIRE_FALSE(independence.is_ample_location(P2_l0)); // clock guard
+    REQUIRE_FALSE(independence.is_ample_location(P3_l0)); // j is written by P4
+    REQUIRE_FALSE(independence.is_ample_location(P4_l0)); // j is read by P3
+    REQUIRE_FALSE(independence.is_ample_location(P4_l1)); // synchronized edge
+    REQUIRE_FALSE(independence.is_ample_location(P5_l0)); // synchronized edge
+  }
+
+  SECTION("Ample process")
+  {
+    tchecker::vloc_t * vloc = tchecker::vloc_allocate_and_construct(system.processes_count(), system.processes_count());
+    (*vloc)[P1] = P1_l0;
+    (*vloc)[P2] = P2_l0;
+    (*vloc)[P3] = P3_l0;
+    (*vloc)[P4] = P4_l0;
+    (*vloc)[P5] = P5_l0;
+
+    REQUIRE(independence.ample_process(*vloc) == P1);
+
+    (*vloc)[P1] = P1_l1;
+    REQUIRE(independence.ample_process(*vloc) == tchecker::ta::independence_t::NO_PROCESS);
+
+    tchecker::vloc_destruct_and_deallocate(vloc);
+  }
+}
@@ -0,0 +1,58 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <map>
+#include <string>
+
+#include "tchecker/utils/profiler.hh"
+
+TEST_CASE("profiler", "[profiler]")
+{
+  SECTION("Phases are recorded when stopped")
+  {
+    tchecker::profiler_t profiler;
+    {
+      tchecker::profiler_t::phase_t parse{&profiler, "PARSE"};
+      parse.stop();
+      parse.stop();
+      tchecker::profiler_t::phase_t exploration{&profiler, "EXPLORATION"};
+    }
+
+    std::map<std::string, std::string> m;
+    profiler.attributes(m);
+    REQUIRE(m.size() == 7);
+    REQUIRE(m.find("TIME_PARSE") != m.end());
+    REQUIRE(m.find("CPU_TIME_PARSE") != m.end());
+    REQUIRE(m.find("MEMORY_PEAK_GROWTH_PARSE") != m.end());
+    REQUIRE(m.find("TIME_EXPLORATION") != m.end());
+    REQUIRE(m.find("CPU_TIME_EXPLORATION") != m.end());
+    REQUIRE(m.find("MEMORY_PEAK_GROWTH_EXPLORATION") != m.end());
+    REQUIRE(m.find("MEMORY_PEAK") != m.end());
+    REQUIRE(std::stol(m["MEMORY_PEAK_GROWTH_PARSE"]) >= 0);
+    REQUIRE(std::stol(m["MEMORY_PEAK"]) >= std::stol(m["MEMORY_PEAK_GROWTH_PARSE"]));
+  }
+
+  SECTION("Phases with the same name are accumulated")
+  {
+    tchecker::profiler_t profiler;
+    profiler.record("AMAP", 1.0, 2.0, 100);
+    profiler.record("AMAP", 0.5, 0.25, 20);
+
+    std::map<std::string, std::string> m;
+    profiler.attributes(m);
+    REQUIRE(m.size() == 4);
+    REQUIRE(std::stod(m["TIME_AMAP"]) == 1.5);
+    REQUIRE(std::stod(m["CPU_TIME_AMAP"]) == 2.25);
+    REQUIRE(std::stol(m["MEMORY_PEAK_GROWTH_AMAP"]) == 120);
+  }
+
+  SECTION("Nothing is recorded without a profiler")
+  {
+    tchecker::profiler_t::phase_t phase{nullptr, "PARSE"};
+    phase.stop();
+  }
+}
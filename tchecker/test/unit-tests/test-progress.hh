@@ -0,0 +1,61 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include "tchecker/algorithms/progress.hh"
+
+TEST_CASE("progress reports", "[progress]")
+{
+  SECTION("Reports are single lines of key=value pairs")
+  {
+    std::stringstream ss;
+    tchecker::algorithms::progress_t progress{ss, 1.0};
+    progress.report(10, 8, 2, 5, 1024);
+
+    std::string line;
+    std::getline(ss, line);
+    REQUIRE(line.rfind("PROGRESS ", 0) == 0);
+    REQUIRE(line.find(" VISITED_STATES=10 ") != std::string::npos);
+    REQUIRE(line.find(" STORED_STATES=8 ") != std::string::npos);
+    REQUIRE(line.find(" COVERED_STATES=2 ") != std::string::npos);
+    REQUIRE(line.find(" WAITING_STATES=5 ") != std::string::npos);
+    REQUIRE(line.find(" MEMORY_BYTES=1024 ") != std::string::npos);
+    REQUIRE(line.find(" STATES_PER_SECOND=") != std::string::npos);
+    REQUIRE(ss.peek() == std::char_traits<char>::eof());
+  }
+
+  SECTION("Depth of visited nodes is tracked")
+  {
+    std::stringstream ss;
+    tchecker::algorithms::progress_t progress{ss, 1.0};
+    int n0, n1, n2, n3;
+
+    progress.waiting_inserted(&n0, true);
+    progress.visit(&n0);
+    progress.waiting_inserted(&n1, false);
+    progress.waiting_inserted(&n2, false);
+    progress.visit(&n1);
+    progress.waiting_inserted(&n3, false);
+    progress.waiting_removed(&n3);
+    progress.visit(&n2);
+    progress.report(3, 4, 1, 0, 0);
+
+    std::string line;
+    std::getline(ss, line);
+    REQUIRE(line.find(" DEPTH=1 ") != std::string::npos);
+    REQUIRE(line.find(" MAX_DEPTH=1") != std::string::npos);
+  }
+
+  SECTION("Period should be positive")
+  {
+    std::stringstream ss;
+    REQUIRE_THROWS_AS((tchecker::algorithms::progress_t{ss, 0.0}), std::invalid_argument);
+  }
+}
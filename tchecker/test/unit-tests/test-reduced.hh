@@ -0,0 +1,179 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "tchecker/dbm/dbm.hh"
+#include "tchecker/dbm/reduced.hh"
+#include "tchecker/zg/zone.hh"
+
+TEST_CASE("Reduction of DBMs", "[reduced]")
+{
+  std::vector<tchecker::dbm::reduced_constraint_t> constraints;
+  tchecker::dbm::reduced_header_t header;
+
+  SECTION("Clocks with zero cycles are reduced to a cycle")
+  {
+    // x==y && x<=5
+    tchecker::clock_id_t const dim = 3;
+    tchecker::dbm::db_t dbm[dim * dim], expanded[dim * dim];
+    tchecker::dbm::universal_positive(dbm, dim);
+    dbm[1 * dim + 2] = tchecker::dbm::LE_ZERO;
+    dbm[2 * dim + 1] = tchecker::dbm::LE_ZERO;
+    dbm[1 * dim + 0] = tchecker::dbm::db(tchecker::dbm::LE, 5);
+    tchecker::dbm::tighten(dbm, dim);
+
+    tchecker::dbm::reduce(dbm, dim, header, constraints);
+    REQUIRE(header.reduction == tchecker::dbm::REDUCTION_MINIMAL_GRAPH);
+    REQUIRE(header.count == 4);
+    REQUIRE(constraints.size() == 4);
+
+    tchecker::dbm::expand(expanded, dim, header, constraints.data());
+    REQUIRE(std::equal(expanded, expanded + dim * dim, dbm));
+  }
+
+  SECTION("Random tight DBMs are reduced to their minimal constraint graph")
+  {
+    std::mt19937 gen(0);
+    std::uniform_int_distribution<tchecker::integer_t> value(0, 20), slack(0, 3), unbounded(0, 4);
+    for (tchecker::clock_id_t dim = 1; dim <= 12; ++dim)
+      for (unsigned int n = 0; n < 20; ++n) {
+        std::vector<tchecker::dbm::db_t> dbm(dim * dim), expanded(dim * dim);
+        std::vector<tchecker::integer_t> v(dim, 0);
+        for (tchecker::clock_id_t i = 1; i < dim; ++i)
+          v[i] = value(gen);
+        for (tchecker::clock_id_t i = 0; i < dim; ++i)
+          for (tchecker::clock_id_t j = 0; j < dim; ++j) {
+            if (i == j)
+              dbm[i * dim + j] = tchecker::dbm::LE_ZERO;
+            else if (unbounded(gen) == 0)
+              dbm[i * dim + j] = tchecker::dbm::LT_INFINITY;
+            else {
+              tchecker::integer_t const s = slack(gen);
+              dbm[i * dim + j] = tchecker::dbm::db((s == 0 ? tchecker::dbm::LE : tchecker::dbm::LT), v[i] - v[j] + s);
+            }
+          }
+        REQUIRE(tchecker::dbm::tighten(dbm.data(), dim) == tchecker::dbm::NON_EMPTY);
+
+        tchecker::dbm::reduce(dbm.data(), dim, header, constraints);
+        REQUIRE(header.reduction == tchecker::dbm::REDUCTION_MINIMAL_GRAPH);
+        REQUIRE(header.count <= dim * (dim - 1));
+
+        tchecker::dbm::expand(expanded.data(), dim, header, constraints.data());
+        REQUIRE(expanded == dbm);
+      }
+  }
+
+  SECTION("DBMs with <= infinity bounds are sparse")
+  {
+    tchecker::clock_id_t const dim = 3;
+    tchecker::dbm::db_t dbm[dim * dim], expanded[dim * dim];
+    for (tchecker::clock_id_t i = 0; i < dim; ++i)
+      for (tchecker::clock_id_t j = 0; j < dim; ++j)
+        dbm[i * dim + j] = (i == j ? tchecker::dbm::LE_ZERO : tchecker::dbm::LE_INFINITY);
+    dbm[0 * dim + 1] = tchecker::dbm::db(tchecker::dbm::LT, -3);
+    dbm[2 * dim + 0] = tchecker::dbm::LE_MINUS_INFINITY;
+
+    tchecker::dbm::reduce(dbm, dim, header, constraints);
+    REQUIRE(header.reduction == tchecker::dbm::REDUCTION_SPARSE);
+    REQUIRE(header.unbounded == tchecker::dbm::LE_INFINITY);
+    REQUIRE(header.count == 2);
+
+    tchecker::dbm::expand(expanded, dim, header, constraints.data());
+    REQUIRE(std::equal(expanded, expanded + dim * dim, dbm));
+  }
+
+  SECTION("Empty DBMs are sparse")
+  {
+    tchecker::clock_id_t const dim = 3;
+    tchecker::dbm::db_t dbm[dim * dim], expanded[dim * dim];
+    tchecker::dbm::empty(dbm, dim);
+
+    tchecker::dbm::reduce(dbm, dim, header, constraints);
+    REQUIRE(header.reduction == tchecker::dbm::REDUCTION_SPARSE);
+    REQUIRE(constraints[0].index == 0);
+
+    tchecker::dbm::expand(expanded, dim, header, constraints.data());
+    REQUIRE(std::equal(expanded, expanded + dim * dim, dbm));
+  }
+}
+
+TEST_CASE("Reduced zones", "[reduced]")
+{
+  tchecker::clock_id_t const dim = 3;
+  std::vector<tchecker::dbm::reduced_constraint_t> constraints;
+  tchecker::dbm::reduced_header_t header;
+
+  tchecker::zg::zone_t * z1 = tchecker::zg::zone_allocate_and_construct(dim, dim);
+  tchecker::dbm::db_t * dbm1 = z1->dbm();
+  dbm1[0 * dim + 1] = tchecker::dbm::db(tchecker::dbm::LE, -2);
+  dbm1[2 * dim + 0] = tchecker::dbm::db(tchecker::dbm::LT, 5);
+  tchecker::dbm::tighten(dbm1, dim);
+
+  tchecker::zg::zone_t * z2 = tchecker::zg::zone_allocate_and_construct(dim, dim);
+
+  tchecker::dbm::reduce(z1->dbm(), dim, header, constraints);
+  tchecker::zg::zone_t * r1 = tchecker::zg::zone_allocate_and_construct(dim, dim, header, constraints.data());
+  tchecker::dbm::reduce(z2->dbm(), dim, header, constraints);
+  tchecker::zg::zone_t * r2 = tchecker::zg::zone_allocate_and_construct(dim, dim, header, constraints.data());
+
+  SECTION("Reduced zones are reduced")
+  {
+    REQUIRE(r1->is_reduced());
+    REQUIRE_FALSE(r1->is_full());
+    REQUIRE(r2->reduced_count() == 2);
+    REQUIRE(tchecker::allocation_size_t<tchecker::zg::zone_t>::reduced_alloc_size(r2->reduced_count()) <
+            tchecker::allocation_size_t<tchecker::zg::zone_t>::alloc_size(dim));
+    REQUIRE_FALSE(tchecker::zg::is_compactable(*r1));
+  }
+
+  SECTION("Reduced zones are equal to full zones")
+  {
+    REQUIRE(*r1 == *z1);
+    REQUIRE(*z1 == *r1);
+    REQUIRE(*r2 == *z2);
+    REQUIRE(*r1 != *r2);
+    REQUIRE(r1->hash() == z1->hash());
+    REQUIRE(r1->lexical_cmp(*z1) == 0);
+  }
+
+  SECTION("Inclusion of reduced zones")
+  {
+    REQUIRE(*r1 <= *r2);
+    REQUIRE(*r1 <= *z2);
+    REQUIRE(*z1 <= *r2);
+    REQUIRE_FALSE(*r2 <= *r1);
+    REQUIRE_FALSE(r1->is_empty());
+    REQUIRE(r2->is_universal_positive());
+  }
+
+  SECTION("Reduced zones are expanded by copy")
+  {
+    tchecker::zg::zone_t * e1 = tchecker::zg::zone_allocate_and_construct(dim, *r1);
+    REQUIRE(e1->is_full());
+    REQUIRE(tchecker::dbm::is_equal(e1->dbm(), z1->dbm(), dim));
+    tchecker::zg::zone_destruct_and_deallocate(e1);
+  }
+
+  SECTION("Empty reduced zones are empty")
+  {
+    tchecker::dbm::empty(z2->dbm(), dim);
+    tchecker::dbm::reduce(z2->dbm(), dim, header, constraints);
+    tchecker::zg::zone_t * e = tchecker::zg::zone_allocate_and_construct(dim, dim, header, constraints.data());
+    REQUIRE(e->is_empty());
+    REQUIRE(*e <= *r1);
+    REQUIRE(*e == *z2);
+    tchecker::zg::zone_destruct_and_deallocate(e);
+  }
+
+  tchecker::zg::zone_destruct_and_deallocate(r2);
+  tchecker::zg::zone_destruct_and_deallocate(r1);
+  tchecker::zg::zone_destruct_and_deallocate(z2);
+  tchecker::zg::zone_destruct_and_deallocate(z1);
+}
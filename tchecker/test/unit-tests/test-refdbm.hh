@@ -5,11 +5,17 @@
  *
  */
 
+#include <memory>
+#include <random>
 #include <string>
 #include <vector>
 
 #include "tchecker/clockbounds/clockbounds.hh"
+#include "tchecker/clockbounds/solver.hh"
+#include "tchecker/dbm/closure.hh"
 #include "tchecker/dbm/refdbm.hh"
+#include "tchecker/expression/typechecking.hh"
+#include "tchecker/parsing/parsing.hh"
 
 /* Tests are provided for functions over DBMs with reference clocks. We do not
  * test functions that are only call the corresponding function over DBMs.
@@ -829,6 +835,73 @@ TEST_CASE("is_sync_alu_le", "[refdbm]")
   }
 }
 
+TEST_CASE("is_sync_alu_le with vectorised kernels", "[refdbm]")
+{
+  std::mt19937 gen(1234);
+  std::uniform_int_distribution<int> value(-20, 20);
+  std::uniform_int_distribution<int> bound(-1, 20);
+
+  std::vector<std::string> refclocks{"$0", "$1", "$2"};
+  enum tchecker::dbm::closure_kernel_t const default_kernel = tchecker::dbm::closure_kernel();
+
+  for (tchecker::clock_id_t clocks = 1; clocks < 30; ++clocks) {
+    tchecker::reference_clock_variables_t r(refclocks);
+    for (tchecker::clock_id_t x = 0; x < clocks; ++x)
+      r.declare("x" + std::to_string(x), refclocks[x % refclocks.size()]);
+
+    tchecker::clock_id_t const rdim = r.size();
+    tchecker::clock_id_t const refcount = r.refcount();
+    std::uniform_int_distribution<tchecker::clock_id_t> clock(0, rdim - 1);
+
+    std::vector<tchecker::dbm::db_t> rdbm1(rdim * rdim), rdbm2(rdim * rdim), backup;
+    std::vector<tchecker::integer_t> l(rdim - refcount), u(rdim - refcount);
+
+    for (unsigned int n = 0; n < 20; ++n) {
+      // rdbm1 is constrained by all the constraints, and rdbm2 by a prefix of
+      // them, hence rdbm1 is often included in rdbm2
+      tchecker::refdbm::universal_positive(rdbm1.data(), r);
+      tchecker::refdbm::universal_positive(rdbm2.data(), r);
+      for (unsigned int c = 0; c < rdim; ++c) {
+        tchecker::clock_id_t const x = clock(gen), y = clock(gen);
+        if (x == y)
+          continue;
+        enum tchecker::dbm::comparator_t const cmp = (n % 3 == 0 ? tchecker::dbm::LT : tchecker::dbm::LE);
+        tchecker::integer_t const v = value(gen);
+        backup = rdbm1;
+        if (tchecker::refdbm::constrain(rdbm1.data(), r, x, y, cmp, v) == tchecker::dbm::EMPTY) {
+          rdbm1 = backup;
+          continue;
+        }
+        if (c < rdim / 2)
+          tchecker::refdbm::constrain(rdbm2.data(), r, x, y, cmp, v);
+      }
+      if (n % 2 == 0)
+        std::swap(rdbm1, rdbm2);
+
+      for (tchecker::clock_id_t x = 0; x < rdim - refcount; ++x) {
+        l[x] = bound(gen);
+        u[x] = bound(gen);
+        if (l[x] < 0)
+          l[x] = tchecker::clockbounds::NO_BOUND;
+        if (u[x] < 0)
+          u[x] = tchecker::clockbounds::NO_BOUND;
+      }
+
+      tchecker::dbm::set_closure_kernel(tchecker::dbm::CLOSURE_SCALAR);
+      bool const expected = tchecker::refdbm::is_sync_alu_le(rdbm1.data(), rdbm2.data(), r, l.data(), u.data());
+
+      for (enum tchecker::dbm::closure_kernel_t kernel : {tchecker::dbm::CLOSURE_SSE41, tchecker::dbm::CLOSURE_AVX2}) {
+        if (!tchecker::dbm::closure_kernel_supported(kernel))
+          continue;
+        tchecker::dbm::set_closure_kernel(kernel);
+        REQUIRE(tchecker::refdbm::is_sync_alu_le(rdbm1.data(), rdbm2.data(), r, l.data(), u.data()) == expected);
+      }
+    }
+  }
+
+  tchecker::dbm::set_closure_kernel(default_kernel);
+}
+
 TEST_CASE("hash", "[refdbm]")
 {
   std::vector<std::string> refclocks{"$0", "$1", "$2"};
@@ -1288,6 +1361,57 @@ TEST_CASE("Spread bounding DBMs with reference clocks", "[refdbm]")
   }
 }
 
+TEST_CASE("Incremental spread-bounding of DBMs with reference clocks", "[refdbm]")
+{
+  std::mt19937 gen(1234);
+  std::uniform_int_distribution<int> value(0, 20);
+  std::uniform_int_distribution<int> coin(0, 1);
+
+  for (tchecker::clock_id_t refcount = 1; refcount < 7; ++refcount) {
+    std::vector<std::string> refclocks;
+    for (tchecker::clock_id_t t = 0; t < refcount; ++t)
+      refclocks.push_back("$" + std::to_string(t));
+    tchecker::reference_clock_variables_t r(refclocks);
+    for (tchecker::clock_id_t x = 0; x < 2 * refcount; ++x)
+      r.declare("x" + std::to_string(x), refclocks[x % refcount]);
+
+    tchecker::clock_id_t const rdim = r.size();
+    std::uniform_int_distribution<tchecker::clock_id_t> clock(0, rdim - 1);
+    std::vector<tchecker::dbm::db_t> rdbm1(rdim * rdim), rdbm2(rdim * rdim), backup;
+    boost::dynamic_bitset<> all{refcount}, opened{refcount};
+    all.set();
+
+    for (unsigned int n = 0; n < 50; ++n) {
+      tchecker::integer_t const spread = n % 4;
+
+      // spread-bounded zone reached by letting time elapse, then bounding clocks
+      tchecker::refdbm::zero(rdbm1.data(), r);
+      tchecker::refdbm::asynchronous_open_up(rdbm1.data(), r, all);
+      for (tchecker::clock_id_t x = refcount; x < rdim; ++x)
+        tchecker::refdbm::constrain(rdbm1.data(), r, r.refmap()[x], x, tchecker::dbm::LE, value(gen));
+      REQUIRE(tchecker::refdbm::bound_spread(rdbm1.data(), r, spread) == tchecker::dbm::NON_EMPTY);
+
+      // open up some reference clocks, then constrain
+      for (tchecker::clock_id_t t = 0; t < refcount; ++t)
+        opened[t] = (coin(gen) == 0);
+      tchecker::refdbm::asynchronous_open_up(rdbm1.data(), r, opened);
+      for (unsigned int c = 0; c < 3; ++c) {
+        tchecker::clock_id_t const x = clock(gen), y = clock(gen);
+        backup = rdbm1;
+        if (x != y && tchecker::refdbm::constrain(rdbm1.data(), r, x, y, tchecker::dbm::LE, value(gen) - 10) ==
+                          tchecker::dbm::EMPTY)
+          rdbm1 = backup;
+      }
+      rdbm2 = rdbm1;
+
+      enum tchecker::dbm::status_t status = tchecker::refdbm::bound_spread(rdbm1.data(), r, spread);
+      REQUIRE(tchecker::refdbm::incremental_bound_spread(rdbm2.data(), r, spread, opened) == status);
+      if (status == tchecker::dbm::NON_EMPTY)
+        REQUIRE(rdbm1 == rdbm2);
+    }
+  }
+}
+
 TEST_CASE("Reset to reference clock on DBMs with reference clocks", "[refdbm]")
 {
   std::vector<std::string> refclocks{"$0", "$1", "$2"};
@@ -1619,3 +1743,92 @@ TEST_CASE("to_dbm on DBMs with reference clocks", "[refdbm]")
     REQUIRE(tchecker::dbm::is_equal(dbm, dbm2, dim));
   }
 }
+
+TEST_CASE("is_sync_g_le on DBMs with reference clocks", "[refdbm]")
+{
+  std::vector<std::string> refclocks{"$0", "$1"};
+  tchecker::reference_clock_variables_t r(refclocks);
+  r.declare("x", "$0");
+  r.declare("y", "$1");
+
+  tchecker::clock_id_t const t0 = r.id("$0");
+  tchecker::clock_id_t const t1 = r.id("$1");
+  tchecker::clock_id_t const x = r.id("x");
+  tchecker::clock_id_t const y = r.id("y");
+  tchecker::clock_id_t const rdim = r.size();
+
+  // G and Gdf are over system clocks x and y
+  tchecker::clock_variables_t clocks;
+  clocks.declare("x", 1);
+  clocks.declare("y", 1);
+  tchecker::integer_variables_t intvars, lvars;
+  std::vector<std::shared_ptr<tchecker::typed_expression_t>> typed_exprs; // owns the constraints in G and Gdf
+
+  auto constraints = [&](std::string const & guard, std::vector<tchecker::typed_diagonal_clkconstr_expression_t const *> & G,
+                         std::vector<tchecker::typed_simple_clkconstr_expression_t const *> & Gdf) {
+    std::shared_ptr<tchecker::expression_t> expr{tchecker::parsing::parse_expression("", guard)};
+    REQUIRE(expr != nullptr);
+    typed_exprs.emplace_back(tchecker::typecheck(*expr, lvars, intvars, clocks));
+    REQUIRE(typed_exprs.back() != nullptr);
+    tchecker::amap::add_constraint(*typed_exprs.back(), G, Gdf);
+  };
+
+  std::vector<tchecker::typed_diagonal_clkconstr_expression_t const *> G;
+  std::vector<tchecker::typed_simple_clkconstr_expression_t const *> Gdf;
+
+  tchecker::dbm::db_t positive[rdim * rdim];
+  tchecker::refdbm::universal_positive(positive, r);
+
+  // y >= 3
+  tchecker::dbm::db_t rdbm[rdim * rdim];
+  tchecker::refdbm::universal_positive(rdbm, r);
+  RDBM(t1, y) = tchecker::dbm::db(tchecker::dbm::LE, -3);
+  tchecker::refdbm::tighten(rdbm, r);
+
+  SECTION("no constraint")
+  {
+    REQUIRE(tchecker::refdbm::is_sync_g_le(positive, rdbm, r, G, Gdf));
+    REQUIRE(tchecker::refdbm::is_sync_g_le(rdbm, positive, r, G, Gdf));
+  }
+
+  SECTION("constraints on x only do not distinguish values of y")
+  {
+    constraints("x>=1", G, Gdf);
+    REQUIRE(tchecker::refdbm::is_sync_g_le(rdbm, positive, r, G, Gdf));
+    REQUIRE(tchecker::refdbm::is_sync_g_le(positive, rdbm, r, G, Gdf));
+    REQUIRE_FALSE(tchecker::refdbm::is_le(positive, rdbm, r));
+  }
+
+  SECTION("constraints on y distinguish values of y")
+  {
+    constraints("x>=1 && y<3", G, Gdf);
+    REQUIRE(tchecker::refdbm::is_sync_g_le(rdbm, rdbm, r, G, Gdf));
+    REQUIRE(tchecker::refdbm::is_sync_g_le(rdbm, positive, r, G, Gdf));
+    REQUIRE_FALSE(tchecker::refdbm::is_sync_g_le(positive, rdbm, r, G, Gdf));
+  }
+
+  SECTION("synchronization relates offset clocks with distinct reference clocks")
+  {
+    // x - y <= 0 over offset clocks, hence x <= y over synchronized valuations
+    tchecker::dbm::db_t rdbm2[rdim * rdim];
+    tchecker::refdbm::universal_positive(rdbm2, r);
+    RDBM2(x, y) = tchecker::dbm::LE_ZERO;
+    tchecker::refdbm::tighten(rdbm2, r);
+
+    constraints("x>=1 && y<3", G, Gdf);
+    REQUIRE(tchecker::refdbm::is_sync_g_le(rdbm2, positive, r, G, Gdf));
+    REQUIRE_FALSE(tchecker::refdbm::is_sync_g_le(positive, rdbm2, r, G, Gdf));
+  }
+
+  SECTION("local time-elapse is applied before synchronization")
+  {
+    // x <= 2 before local time-elapse
+    tchecker::dbm::db_t rdbm2[rdim * rdim];
+    tchecker::refdbm::universal_positive(rdbm2, r);
+    RDBM2(x, t0) = tchecker::dbm::db(tchecker::dbm::LE, 2);
+    tchecker::refdbm::tighten(rdbm2, r);
+
+    constraints("x>=1 && y<3", G, Gdf);
+    REQUIRE(tchecker::refdbm::is_sync_g_le(positive, rdbm2, r, G, Gdf));
+  }
+}
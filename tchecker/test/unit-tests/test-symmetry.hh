@@ -0,0 +1,91 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <memory>
+#include <vector>
+
+#include "tchecker/basictypes.hh"
+#include "tchecker/dbm/db.hh"
+#include "tchecker/dbm/dbm.hh"
+#include "tchecker/parsing/declaration.hh"
+#include "tchecker/syncprod/vloc.hh"
+#include "tchecker/ta/symmetry.hh"
+#include "tchecker/ta/system.hh"
+
+#include "testutils/utils.hh"
+
+TEST_CASE("symmetry classes and canonical states", "[symmetry]")
+{
+  std::string model = "system:symmetry \n\
+  event:a \n\
+  event:b \n\
+  clock:history:x1 \n\
+  clock:history:x2 \n\
+  clock:history:y \n\
+  \n\
+  process:P1 \n\
+  location:P1:l0{initial:} \n\
+  location:P1:l1{labels:done} \n\
+  edge:P1:l0:l1:a{{provided:x1<=2; do:x1;}} \n\
+  \n\
+  process:P2 \n\
+  location:P2:l0{initial:} \n\
+  location:P2:l1{labels:done} \n\
+  edge:P2:l0:l1:a{{provided:x2<=2; do:x2;}} \n\
+  \n\
+  process:P3 \n\
+  location:P3:l0{initial:} \n\
+  location:P3:l1{labels:done} \n\
+  edge:P3:l0:l1:b{{provided:y<=3; do:y;}} \n\
+  ";
+
+  std::unique_ptr<tchecker::parsing::system_declaration_t const> sysdecl{tchecker::test::parse(model)};
+  REQUIRE(sysdecl != nullptr);
+
+  tchecker::ta::system_t system{*sysdecl};
+  tchecker::ta::symmetry_t symmetry{system};
+
+  tchecker::process_id_t const P1 = system.process_id("P1");
+  tchecker::process_id_t const P2 = system.process_id("P2");
+  tchecker::process_id_t const P3 = system.process_id("P3");
+
+  SECTION("Symmetry classes")
+  {
+    REQUIRE_FALSE(symmetry.trivial());
+    REQUIRE(symmetry.classes().size() == 1);
+    REQUIRE(symmetry.classes()[0] == std::vector<tchecker::process_id_t>{P1, P2});
+  }
+
+  SECTION("Canonical states")
+  {
+    tchecker::clock_id_t const dim = system.clocks_count(tchecker::VK_FLATTENED) + 1;
+    tchecker::clock_id_t const x1 = system.clock_id("x1") + 1;
+    tchecker::clock_id_t const x2 = system.clock_id("x2") + 1;
+
+    tchecker::vloc_t * vloc = tchecker::vloc_allocate_and_construct(system.processes_count(), system.processes_count());
+    (*vloc)[P1] = system.location(P1, "l1")->id();
+    (*vloc)[P2] = system.location(P2, "l0")->id();
+    (*vloc)[P3] = system.location(P3, "l0")->id();
+
+    std::vector<tchecker::dbm::db_t> v(dim * dim);
+    tchecker::dbm::db_t * dbm = v.data();
+    tchecker::dbm::universal_positive(dbm, dim);
+    tchecker::dbm::constrain(dbm, dim, x1, 0, tchecker::dbm::LE, 1);
+    tchecker::dbm::constrain(dbm, dim, x2, 0, tchecker::dbm::LE, 5);
+
+    REQUIRE(symmetry.canonicalize(*vloc, dbm, dim));
+    REQUIRE((*vloc)[P1] == system.location(P1, "l0")->id());
+    REQUIRE((*vloc)[P2] == system.location(P2, "l1")->id());
+    REQUIRE((*vloc)[P3] == system.location(P3, "l0")->id());
+    REQUIRE(dbm[x1 * dim] == tchecker::dbm::db(tchecker::dbm::LE, 5));
+    REQUIRE(dbm[x2 * dim] == tchecker::dbm::db(tchecker::dbm::LE, 1));
+
+    REQUIRE_FALSE(symmetry.canonicalize(*vloc, dbm, dim));
+
+    tchecker::vloc_destruct_and_deallocate(vloc);
+  }
+}
@@ -37,6 +37,14 @@ TEST_CASE("waiting queue", "[waiting]")
     REQUIRE_FALSE(non_empty_queue.empty());
   }
 
+  SECTION("size")
+  {
+    REQUIRE(empty_queue.size() == 0);
+    REQUIRE(non_empty_queue.size() == 3);
+    non_empty_queue.remove_first();
+    REQUIRE(non_empty_queue.size() == 2);
+  }
+
   SECTION("insert in empty queue")
   {
     empty_queue.insert(2);
@@ -176,6 +184,16 @@ TEST_CASE("fast remove waiting queue", "[waiting]")
     REQUIRE_FALSE(non_empty_queue.empty());
   }
 
+  SECTION("size")
+  {
+    REQUIRE(empty_queue.size() == 0);
+    REQUIRE(non_empty_queue.size() == 4);
+    non_empty_queue.remove(v[0]);
+    REQUIRE(non_empty_queue.size() == 3);
+    non_empty_queue.remove(v[2]);
+    REQUIRE(non_empty_queue.size() >= 2);
+  }
+
   SECTION("insert in empty queue")
   {
     int_sptr_t x{new int_element_t{290}};
@@ -332,6 +350,14 @@ TEST_CASE("waiting stack", "[waiting]")
     REQUIRE_FALSE(non_empty_stack.empty());
   }
 
+  SECTION("size")
+  {
+    REQUIRE(empty_stack.size() == 0);
+    REQUIRE(non_empty_stack.size() == 4);
+    non_empty_stack.remove_first();
+    REQUIRE(non_empty_stack.size() == 3);
+  }
+
   SECTION("insert in empty stack")
   {
     empty_stack.insert(16);
@@ -10,14 +10,23 @@
 
 #include "test-amap.hh"
 #include "test-cache.hh"
+#include "test-clock_liveness.hh"
+#include "test-compact.hh"
+#include "test-compiled_system.hh"
+#include "test-counters.hh"
 #include "test-db.hh"
 #include "test-dbm.hh"
 #include "test-delay_allowed.hh"
 #include "test-extract_variables.hh"
 #include "test-guard_weak_sync.hh"
+#include "test-independence.hh"
 #include "test-labels.hh"
 #include "test-ordering.hh"
+#include "test-profiler.hh"
+#include "test-progress.hh"
+#include "test-reduced.hh"
 #include "test-refdbm.hh"
 #include "test-reference_clock_variables.hh"
+#include "test-symmetry.hh"
 #include "test-variables-access.hh"
 #include "test-waiting.hh"